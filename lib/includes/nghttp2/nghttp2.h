@@ -691,7 +691,12 @@ typedef enum {
      * SETTINGS_ENABLE_CONNECT_PROTOCOL
      * (`RFC 8441 <https://tools.ietf.org/html/rfc8441>`_)
      */
-    NGHTTP2_SETTINGS_ENABLE_CONNECT_PROTOCOL = 0x08
+    NGHTTP2_SETTINGS_ENABLE_CONNECT_PROTOCOL = 0x08,
+    /**
+     * SETTINGS_NO_RFC7540_PRIORITIES
+     * (`RFC 9218 <https://tools.ietf.org/html/rfc9218>`_)
+     */
+    NGHTTP2_SETTINGS_NO_RFC7540_PRIORITIES = 0x09
 } nghttp2_settings_id;
 /* Note: If we add SETTINGS, update the capacity of
    NGHTTP2_INBOUND_NUM_IV as well */
@@ -2648,6 +2653,23 @@ nghttp2_option_set_max_deflate_dynamic_table_size(nghttp2_option *option,
 NGHTTP2_EXTERN void nghttp2_option_set_no_closed_streams(nghttp2_option *option,
                                                          int val);
 
+/**
+ * @function
+ *
+ * This option makes the session schedule outgoing DATA frames in
+ * round robin order of the streams, instead of maintaining the
+ * RFC 7540 dependency tree.  If this option is set to nonzero,
+ * PRIORITY frames and priority information in HEADERS are ignored,
+ * and `nghttp2_session_change_stream_priority()` and
+ * `nghttp2_session_create_idle_stream()` do nothing.  The option only
+ * changes the local scheduler; application should tell the remote
+ * endpoint by sending :enum:`NGHTTP2_SETTINGS_NO_RFC7540_PRIORITIES`
+ * = 1 in its first SETTINGS frame.  By default, this option is set to
+ * zero.
+ */
+NGHTTP2_EXTERN void
+nghttp2_option_set_no_rfc7540_priorities(nghttp2_option *option, int val);
+
 /**
  * @function
  *
@@ -3827,6 +3849,36 @@ NGHTTP2_EXTERN int32_t nghttp2_submit_request(
     const nghttp2_nv *nva, size_t nvlen, const nghttp2_data_provider *data_prd,
     void *stream_user_data);
 
+/**
+ * @function
+ *
+ * Submits HEADERS frame and optionally one or more DATA frames, just
+ * like `nghttp2_submit_request()`, but sends the header block |hd| of
+ * length |hdlen| as it is instead of deflating |nva|.  The |hd| must
+ * be the encoding of |nva| which does not refer to, nor change, the
+ * dynamic table, e.g., one produced by `nghttp2_hd_deflate_static()`.
+ * Since only the frame header differs between requests, this saves
+ * the header compression work for every request.
+ *
+ * This function does not copy |hd|.  The application must keep it
+ * valid until :type:`nghttp2_on_frame_send_callback` or
+ * :type:`nghttp2_on_frame_not_send_callback` is called for this
+ * frame.  The |nva| is still copied as `nghttp2_submit_request()`
+ * does.  It is deflated instead of |hd| when the library must signal
+ * a dynamic table size update in this header block, and it is passed
+ * to the callbacks.
+ *
+ * If |hd| is ``NULL``, this function is equivalent to
+ * `nghttp2_submit_request()`.
+ *
+ * This function returns assigned stream ID if it succeeds, or one of
+ * the error codes `nghttp2_submit_request()` returns.
+ */
+NGHTTP2_EXTERN int32_t nghttp2_submit_request_hd(
+    nghttp2_session *session, const nghttp2_priority_spec *pri_spec,
+    const nghttp2_nv *nva, size_t nvlen, const uint8_t *hd, size_t hdlen,
+    const nghttp2_data_provider *data_prd, void *stream_user_data);
+
 /**
  * @function
  *
@@ -4908,6 +4960,39 @@ NGHTTP2_EXTERN ssize_t nghttp2_hd_deflate_hd_vec(nghttp2_hd_deflater *deflater,
                                                  const nghttp2_nv *nva,
                                                  size_t nvlen);
 
+/**
+ * @function
+ *
+ * Deflates the |nva|, which has the |nvlen| name/value pairs, into
+ * the |buf| of length |buflen| without any deflater.  Only the static
+ * table and literal representations which do not add an entry to the
+ * dynamic table are used, so the resulting header block does not
+ * depend on, nor change, the state of any decoder.  It can be cached
+ * and sent any number of times on any connection, e.g., with
+ * `nghttp2_submit_request_hd()`.
+ *
+ * Header fields which `nghttp2_hd_deflate_hd()` never indexes are
+ * encoded as literal never indexed.  Strings are Huffman encoded if
+ * it makes them shorter.
+ *
+ * The caller should use `nghttp2_hd_deflate_bound()` to know the
+ * upper bound of buffer size required.  The |deflater| argument of
+ * that function may be ``NULL``.
+ *
+ * This function returns the number of bytes written to |buf| if it
+ * succeeds, or one of the following negative error codes:
+ *
+ * :enum:`NGHTTP2_ERR_NOMEM`
+ *     Out of memory.
+ * :enum:`NGHTTP2_ERR_HEADER_COMP`
+ *     Deflation process has failed.
+ * :enum:`NGHTTP2_ERR_INSUFF_BUFSIZE`
+ *     The provided |buflen| size is too small to hold the output.
+ */
+NGHTTP2_EXTERN ssize_t nghttp2_hd_deflate_static(uint8_t *buf, size_t buflen,
+                                                 const nghttp2_nv *nva,
+                                                 size_t nvlen);
+
 /**
  * @function
  *
@@ -138,6 +138,23 @@ size_t nghttp2_frame_headers_payload_nv_offset(nghttp2_headers *frame);
 int nghttp2_frame_pack_headers(nghttp2_bufs *bufs, nghttp2_headers *frame,
                                nghttp2_hd_deflater *deflater);
 
+/*
+ * Packs HEADERS frame |frame| in wire format and store it in |bufs|,
+ * just like nghttp2_frame_pack_headers(), but uses the header block
+ * |hd| of length |hdlen| which was encoded in advance, instead of
+ * deflating frame->nva.
+ *
+ * This function returns 0 if it succeeds, or returns one of the
+ * following negative error codes:
+ *
+ * NGHTTP2_ERR_HEADER_COMP
+ *     The header block does not fit in |bufs|.
+ * NGHTTP2_ERR_NOMEM
+ *     Out of memory.
+ */
+int nghttp2_frame_pack_headers_hd(nghttp2_bufs *bufs, nghttp2_headers *frame,
+                                  const uint8_t *hd, size_t hdlen);
+
 /*
  * Unpacks HEADERS frame byte sequence into |frame|.  This function
  * only unapcks bytes that come before name/value header block and
@@ -1547,6 +1547,69 @@ ssize_t nghttp2_hd_deflate_hd_vec(nghttp2_hd_deflater *deflater,
   return (ssize_t)buflen;
 }
 
+static int deflate_nv_static(nghttp2_bufs *bufs, const nghttp2_nv *nv) {
+  search_result res;
+  int indexing_mode;
+  int32_t token;
+
+  token = lookup_token(nv->name, nv->namelen);
+
+  /* Same never-index criteria as deflate_nv() */
+  indexing_mode =
+      token == NGHTTP2_TOKEN_AUTHORIZATION ||
+              (token == NGHTTP2_TOKEN_COOKIE && nv->valuelen < 20) ||
+              (nv->flags & NGHTTP2_NV_FLAG_NO_INDEX)
+          ? NGHTTP2_HD_NEVER_INDEXING
+          : NGHTTP2_HD_WITHOUT_INDEXING;
+
+  if (token < 0 || token > NGHTTP2_TOKEN_WWW_AUTHENTICATE) {
+    return emit_newname_block(bufs, nv, indexing_mode);
+  }
+
+  res = search_static_table(nv, token,
+                            indexing_mode == NGHTTP2_HD_NEVER_INDEXING);
+
+  if (res.name_value_match) {
+    return emit_indexed_block(bufs, (size_t)res.index);
+  }
+
+  return emit_indname_block(bufs, (size_t)res.index, nv, indexing_mode);
+}
+
+ssize_t nghttp2_hd_deflate_static(uint8_t *buf, size_t buflen,
+                                  const nghttp2_nv *nva, size_t nvlen) {
+  nghttp2_bufs bufs;
+  int rv;
+  size_t i;
+
+  rv = nghttp2_bufs_wrap_init(&bufs, buf, buflen, nghttp2_mem_default());
+
+  if (rv != 0) {
+    return rv;
+  }
+
+  for (i = 0; i < nvlen; ++i) {
+    rv = deflate_nv_static(&bufs, &nva[i]);
+    if (rv != 0) {
+      break;
+    }
+  }
+
+  buflen = nghttp2_bufs_len(&bufs);
+
+  nghttp2_bufs_wrap_free(&bufs);
+
+  if (rv == NGHTTP2_ERR_BUFFER_ERROR) {
+    return NGHTTP2_ERR_INSUFF_BUFSIZE;
+  }
+
+  if (rv != 0) {
+    return rv;
+  }
+
+  return (ssize_t)buflen;
+}
+
 size_t nghttp2_hd_deflate_bound(nghttp2_hd_deflater *deflater,
                                 const nghttp2_nv *nva, size_t nvlen) {
   size_t n = 0;
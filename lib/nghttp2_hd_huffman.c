@@ -191,41 +191,96 @@ int nghttp2_hd_huff_encode(nghttp2_bufs *bufs, const uint8_t *src,
 }
 
 void nghttp2_hd_huff_decode_context_init(nghttp2_hd_huff_decode_context *ctx) {
-  ctx->state = 0;
-  ctx->accept = 1;
+  ctx->bits = 0;
+  ctx->nbits = 0;
+}
+
+/*
+ * Decodes the symbol whose code starts at MSB of |w|, and stores the
+ * length of the code in |*pnbits|.  The codes in huff_sym_table are
+ * canonical, that is, the codes of the same length are consecutive,
+ * and are smaller than the prefixes of the longer codes.  The bits
+ * after the code do not matter, so the caller can pad |w| with
+ * anything if the input is short, and then see whether |*pnbits| is
+ * not more than the bits it has.
+ */
+static uint32_t huff_decode_sym1(uint64_t w, size_t *pnbits) {
+  const nghttp2_huff_decode *t;
+  uint32_t w32;
+  size_t n;
+
+  t = &huff_decode_table[w >> (64 - NGHTTP2_HUFF_DECODE_TABLE_BITS)];
+  if (t->nbits) {
+    *pnbits = t->nbits;
+    return t->sym;
+  }
+
+  w32 = (uint32_t)(w >> 32);
+
+  for (n = NGHTTP2_HUFF_DECODE_TABLE_BITS + 1; w32 >= huff_decode_limit[n];
+       ++n)
+    ;
+
+  *pnbits = n;
+  return huff_decode_sym[huff_decode_offset[n] + (int32_t)(w32 >> (32 - n))];
 }
 
 ssize_t nghttp2_hd_huff_decode(nghttp2_hd_huff_decode_context *ctx,
                                nghttp2_buf *buf, const uint8_t *src,
                                size_t srclen, int final) {
-  size_t i;
-
-  /* We use the decoding algorithm described in
-     http://graphics.ics.uci.edu/pub/Prefix.pdf */
-  for (i = 0; i < srclen; ++i) {
-    const nghttp2_huff_decode *t;
+  const uint8_t *end = src + srclen;
+  uint8_t *out = buf->last;
+  uint64_t bits = ctx->bits;
+  size_t nbits = ctx->nbits;
+  size_t n;
+  uint32_t sym;
 
-    t = &huff_decode_table[ctx->state][src[i] >> 4];
-    if (t->flags & NGHTTP2_HUFF_FAIL) {
-      return NGHTTP2_ERR_HEADER_COMP;
-    }
-    if (t->flags & NGHTTP2_HUFF_SYM) {
-      *buf->last++ = t->sym;
+  /* Keep at least NGHTTP2_HUFF_MAX_NBITS bits in |bits| while the
+     input lasts, so that every lookup yields a complete code. */
+  for (;;) {
+    for (; nbits <= 56 && src != end; ++src) {
+      bits = (bits << 8) | *src;
+      nbits += 8;
     }
 
-    t = &huff_decode_table[t->state][src[i] & 0xf];
-    if (t->flags & NGHTTP2_HUFF_FAIL) {
-      return NGHTTP2_ERR_HEADER_COMP;
-    }
-    if (t->flags & NGHTTP2_HUFF_SYM) {
-      *buf->last++ = t->sym;
+    if (nbits < NGHTTP2_HUFF_MAX_NBITS) {
+      break;
     }
 
-    ctx->state = t->state;
-    ctx->accept = (t->flags & NGHTTP2_HUFF_ACCEPTED) != 0;
+    do {
+      sym = huff_decode_sym1(bits << (64 - nbits), &n);
+      if (sym == NGHTTP2_HUFF_EOS) {
+        return NGHTTP2_ERR_HEADER_COMP;
+      }
+      *out++ = (uint8_t)sym;
+      nbits -= n;
+    } while (nbits >= NGHTTP2_HUFF_MAX_NBITS);
+  }
+
+  /* The input ran out.  Decode what makes complete codes, and keep
+     the rest for the next call.  EOS cannot be complete here, since
+     it is the longest code. */
+  while (nbits) {
+    sym = huff_decode_sym1(bits << (64 - nbits), &n);
+    if (n > nbits) {
+      break;
+    }
+    *out++ = (uint8_t)sym;
+    nbits -= n;
   }
-  if (final && !ctx->accept) {
+
+  buf->last = out;
+
+  bits &= ((uint64_t)1 << nbits) - 1;
+
+  /* The padding must be the most significant bits of EOS, which are
+     all 1, and must be shorter than 8 bits. */
+  if (final && (nbits > 7 || bits != ((uint64_t)1 << nbits) - 1)) {
     return NGHTTP2_ERR_HEADER_COMP;
   }
-  return (ssize_t)i;
+
+  ctx->bits = bits;
+  ctx->nbits = nbits;
+
+  return (ssize_t)srclen;
 }
@@ -31,37 +31,28 @@
 
 #include <nghttp2/nghttp2.h>
 
-typedef enum {
-    /* FSA accepts this state as the end of huffman encoding
-       sequence. */
-    NGHTTP2_HUFF_ACCEPTED = 1,
-    /* This state emits symbol */
-    NGHTTP2_HUFF_SYM = (1 << 1),
-    /* If state machine reaches this state, decoding fails. */
-    NGHTTP2_HUFF_FAIL = (1 << 2)
-} nghttp2_huff_decode_flag;
+/* The number of bits huff_decode_table is indexed by */
+#define NGHTTP2_HUFF_DECODE_TABLE_BITS 11
+/* The length of the longest code, which is EOS */
+#define NGHTTP2_HUFF_MAX_NBITS 30
+#define NGHTTP2_HUFF_EOS 256
 
 typedef struct {
-    /* huffman decoding state, which is actually the node ID of internal
-       huffman tree.  We have 257 leaf nodes, but they are identical to
-       root node other than emitting a symbol, so we have 256 internal
-       nodes [1..255], inclusive. */
-    uint8_t state;
-    /* bitwise OR of zero or more of the nghttp2_huff_decode_flag */
-    uint8_t flags;
-    /* symbol if NGHTTP2_HUFF_SYM flag set */
+    /* symbol whose code is a prefix of the table index, if nbits is
+       not 0 */
     uint8_t sym;
+    /* The number of bits in the code of sym, or 0 if the table index
+       is a prefix of longer codes */
+    uint8_t nbits;
 } nghttp2_huff_decode;
 
-typedef nghttp2_huff_decode huff_decode_table_type[16];
-
 typedef struct {
-    /* Current huffman decoding state. We stripped leaf nodes, so the
-       value range is [0..255], inclusive. */
-    uint8_t state;
-    /* nonzero if we can say that the decoding process succeeds at this
-       state */
-    uint8_t accept;
+    /* Input bits which have not made a complete code yet, aligned to
+       LSB.  Only the lowest |nbits| bits are meaningful. */
+    uint64_t bits;
+    /* The number of bits in |bits|, which is less than
+       NGHTTP2_HUFF_MAX_NBITS between calls. */
+    size_t nbits;
 } nghttp2_hd_huff_decode_context;
 
 typedef struct {
@@ -72,6 +63,9 @@ typedef struct {
 } nghttp2_huff_sym;
 
 extern const nghttp2_huff_sym huff_sym_table[];
-extern const nghttp2_huff_decode huff_decode_table[][16];
+extern const nghttp2_huff_decode huff_decode_table[];
+extern const uint64_t huff_decode_limit[];
+extern const int32_t huff_decode_offset[];
+extern const uint16_t huff_decode_sym[];
 
 #endif /* NGHTTP2_HD_HUFFMAN_H */
@@ -26,17 +26,12 @@
 
 #include <string.h>
 
-#define INITIAL_TABLE_LENGTH 256
+#define INITIAL_TABLE_LENGTH 16
 
 int nghttp2_map_init(nghttp2_map *map, nghttp2_mem *mem) {
   map->mem = mem;
-  map->tablelen = INITIAL_TABLE_LENGTH;
-  map->table =
-      nghttp2_mem_calloc(mem, map->tablelen, sizeof(nghttp2_map_entry *));
-  if (map->table == NULL) {
-    return NGHTTP2_ERR_NOMEM;
-  }
-
+  map->table = NULL;
+  map->tablelen = 0;
   map->size = 0;
 
   return 0;
@@ -50,15 +45,19 @@ void nghttp2_map_each_free(nghttp2_map *map,
                            int (*func)(nghttp2_map_entry *entry, void *ptr),
                            void *ptr) {
   uint32_t i;
+  nghttp2_map_bucket *bkt;
+
   for (i = 0; i < map->tablelen; ++i) {
-    nghttp2_map_entry *entry;
-    for (entry = map->table[i]; entry;) {
-      nghttp2_map_entry *next = entry->next;
-      func(entry, ptr);
-      entry = next;
+    bkt = &map->table[i];
+    if (bkt->psl == 0) {
+      continue;
     }
-    map->table[i] = NULL;
+    func(bkt->entry, ptr);
+    bkt->psl = 0;
+    bkt->entry = NULL;
   }
+
+  map->size = 0;
 }
 
 int nghttp2_map_each(nghttp2_map *map,
@@ -66,13 +65,16 @@ int nghttp2_map_each(nghttp2_map *map,
                      void *ptr) {
   int rv;
   uint32_t i;
+  nghttp2_map_bucket *bkt;
+
   for (i = 0; i < map->tablelen; ++i) {
-    nghttp2_map_entry *entry;
-    for (entry = map->table[i]; entry; entry = entry->next) {
-      rv = func(entry, ptr);
-      if (rv != 0) {
-        return rv;
-      }
+    bkt = &map->table[i];
+    if (bkt->psl == 0) {
+      continue;
+    }
+    rv = func(bkt->entry, ptr);
+    if (rv != 0) {
+      return rv;
     }
   }
   return 0;
@@ -80,58 +82,78 @@ int nghttp2_map_each(nghttp2_map *map,
 
 void nghttp2_map_entry_init(nghttp2_map_entry *entry, key_type key) {
   entry->key = key;
-  entry->next = NULL;
 }
 
-/* Same hash function in android HashMap source code. */
-/* The |mod| must be power of 2 */
-static uint32_t hash(int32_t key, uint32_t mod) {
-  uint32_t h = (uint32_t)key;
-  h ^= (h >> 20) ^ (h >> 12);
-  h ^= (h >> 7) ^ (h >> 4);
-  return h & (mod - 1);
+/* Stream IDs of a connection are sequential and of one parity, so
+   dropping the parity bit maps those in flight to adjacent slots, and
+   they rarely collide. */
+static uint32_t hash(key_type key, uint32_t tablelen) {
+  return ((uint32_t)key >> 1) & (tablelen - 1);
 }
 
-static int insert(nghttp2_map_entry **table, uint32_t tablelen,
-                  nghttp2_map_entry *entry) {
-  uint32_t h = hash(entry->key, tablelen);
-  if (table[h] == NULL) {
-    table[h] = entry;
-  } else {
-    nghttp2_map_entry *p;
-    /* We won't allow duplicated key, so check it out. */
-    for (p = table[h]; p; p = p->next) {
-      if (p->key == entry->key) {
-        return NGHTTP2_ERR_INVALID_ARGUMENT;
-      }
+static int insert(nghttp2_map_bucket *table, uint32_t tablelen,
+                  key_type key, nghttp2_map_entry *entry) {
+  uint32_t idx = hash(key, tablelen);
+  uint32_t psl = 1;
+  nghttp2_map_bucket *bkt;
+  nghttp2_map_bucket t;
+
+  for (;;) {
+    bkt = &table[idx];
+
+    if (bkt->psl == 0) {
+      bkt->psl = psl;
+      bkt->key = key;
+      bkt->entry = entry;
+      return 0;
+    }
+
+    /* We won't allow duplicated key.  If |key| is in the table, it is
+       met before any swap below, where a lookup of it would stop. */
+    if (bkt->key == key) {
+      return NGHTTP2_ERR_INVALID_ARGUMENT;
     }
-    entry->next = table[h];
-    table[h] = entry;
+
+    /* Robin Hood: the key further from its slot takes this one, and
+       the displaced key goes on probing. */
+    if (psl > bkt->psl) {
+      t = *bkt;
+
+      bkt->psl = psl;
+      bkt->key = key;
+      bkt->entry = entry;
+
+      psl = t.psl;
+      key = t.key;
+      entry = t.entry;
+    }
+
+    ++psl;
+    idx = (idx + 1) & (tablelen - 1);
   }
-  return 0;
 }
 
 /* new_tablelen must be power of 2 */
 static int resize(nghttp2_map *map, uint32_t new_tablelen) {
   uint32_t i;
-  nghttp2_map_entry **new_table;
+  nghttp2_map_bucket *new_table;
+  nghttp2_map_bucket *bkt;
 
   new_table =
-      nghttp2_mem_calloc(map->mem, new_tablelen, sizeof(nghttp2_map_entry *));
+      nghttp2_mem_calloc(map->mem, new_tablelen, sizeof(nghttp2_map_bucket));
   if (new_table == NULL) {
     return NGHTTP2_ERR_NOMEM;
   }
 
   for (i = 0; i < map->tablelen; ++i) {
-    nghttp2_map_entry *entry;
-    for (entry = map->table[i]; entry;) {
-      nghttp2_map_entry *next = entry->next;
-      entry->next = NULL;
-      /* This function must succeed */
-      insert(new_table, new_tablelen, entry);
-      entry = next;
+    bkt = &map->table[i];
+    if (bkt->psl == 0) {
+      continue;
     }
+    /* This function must succeed */
+    insert(new_table, new_tablelen, bkt->key, bkt->entry);
   }
+
   nghttp2_mem_free(map->mem, map->table);
   map->tablelen = new_tablelen;
   map->table = new_table;
@@ -139,16 +161,48 @@ static int resize(nghttp2_map *map, uint32_t new_tablelen) {
   return 0;
 }
 
+/* Returns the slot of |key|, or NULL if there is none. */
+static nghttp2_map_bucket *find_bucket(nghttp2_map *map, key_type key) {
+  uint32_t idx;
+  uint32_t psl = 1;
+  nghttp2_map_bucket *bkt;
+
+  if (map->size == 0) {
+    return NULL;
+  }
+
+  idx = hash(key, map->tablelen);
+
+  for (;;) {
+    bkt = &map->table[idx];
+
+    /* An empty slot, or one richer than |key| would be here, ends the
+       probe sequence of |key|. */
+    if (psl > bkt->psl) {
+      return NULL;
+    }
+
+    if (bkt->key == key) {
+      return bkt;
+    }
+
+    ++psl;
+    idx = (idx + 1) & (map->tablelen - 1);
+  }
+}
+
 int nghttp2_map_insert(nghttp2_map *map, nghttp2_map_entry *new_entry) {
   int rv;
-  /* Load factor is 0.75 */
-  if ((map->size + 1) * 4 > map->tablelen * 3) {
-    rv = resize(map, map->tablelen * 2);
+
+  /* Load factor is 7/8 */
+  if ((map->size + 1) * 8 > (size_t)map->tablelen * 7) {
+    rv = resize(map, map->tablelen ? map->tablelen * 2 : INITIAL_TABLE_LENGTH);
     if (rv != 0) {
       return rv;
     }
   }
-  rv = insert(map->table, map->tablelen, new_entry);
+
+  rv = insert(map->table, map->tablelen, new_entry->key, new_entry);
   if (rv != 0) {
     return rv;
   }
@@ -157,33 +211,45 @@ int nghttp2_map_insert(nghttp2_map *map, nghttp2_map_entry *new_entry) {
 }
 
 nghttp2_map_entry *nghttp2_map_find(nghttp2_map *map, key_type key) {
-  uint32_t h;
-  nghttp2_map_entry *entry;
-  h = hash(key, map->tablelen);
-  for (entry = map->table[h]; entry; entry = entry->next) {
-    if (entry->key == key) {
-      return entry;
-    }
+  nghttp2_map_bucket *bkt = find_bucket(map, key);
+
+  if (bkt == NULL) {
+    return NULL;
   }
-  return NULL;
+  return bkt->entry;
 }
 
 int nghttp2_map_remove(nghttp2_map *map, key_type key) {
-  uint32_t h;
-  nghttp2_map_entry **dst;
+  nghttp2_map_bucket *bkt = find_bucket(map, key);
+  nghttp2_map_bucket *next;
+  uint32_t idx;
 
-  h = hash(key, map->tablelen);
+  if (bkt == NULL) {
+    return NGHTTP2_ERR_INVALID_ARGUMENT;
+  }
 
-  for (dst = &map->table[h]; *dst; dst = &(*dst)->next) {
-    if ((*dst)->key != key) {
-      continue;
+  /* Backward shift deletion: the keys after the slot move one slot
+     closer to home, up to an empty slot or a key already at home. */
+  idx = (uint32_t)(bkt - map->table);
+  for (;;) {
+    idx = (idx + 1) & (map->tablelen - 1);
+    next = &map->table[idx];
+
+    if (next->psl <= 1) {
+      bkt->psl = 0;
+      bkt->entry = NULL;
+      break;
     }
 
-    *dst = (*dst)->next;
-    --map->size;
-    return 0;
+    bkt->psl = next->psl - 1;
+    bkt->key = next->key;
+    bkt->entry = next->entry;
+
+    bkt = next;
   }
-  return NGHTTP2_ERR_INVALID_ARGUMENT;
+
+  --map->size;
+  return 0;
 }
 
 size_t nghttp2_map_size(nghttp2_map *map) { return map->size; }
@@ -38,7 +38,6 @@
 typedef int32_t key_type;
 
 typedef struct nghttp2_map_entry {
-    struct nghttp2_map_entry *next;
     key_type key;
 #if SIZEOF_INT_P == 4
     /* we requires 8 bytes aligment */
@@ -46,21 +45,33 @@ typedef struct nghttp2_map_entry {
 #endif
 } nghttp2_map_entry;
 
+/*
+ * A slot of the open addressing table.  The key is copied next to the
+ * entry, so that probing does not touch the entries themselves.
+ */
+typedef struct {
+    /* The distance from the slot the key hashes to plus one, or 0 if
+       the slot is empty */
+    uint32_t psl;
+    key_type key;
+    nghttp2_map_entry *entry;
+} nghttp2_map_bucket;
+
+/*
+ * The table is open addressed with linear probing and Robin Hood
+ * hashing, which keeps probe sequences short up to a high load factor.
+ * The table is allocated by the first insertion.
+ */
 typedef struct {
-    nghttp2_map_entry **table;
+    nghttp2_map_bucket *table;
     nghttp2_mem *mem;
     size_t size;
     uint32_t tablelen;
 } nghttp2_map;
 
 /*
- * Initializes the map |map|.
- *
- * This function returns 0 if it succeeds, or one of the following
- * negative error codes:
- *
- * NGHTTP2_ERR_NOMEM
- *   Out of memory
+ * Initializes the map |map|.  The table is allocated when the first
+ * entry is inserted, so this function always returns 0.
  */
 int nghttp2_map_init(nghttp2_map *map, nghttp2_mem *mem);
 
@@ -66,6 +66,7 @@ typedef enum {
     NGHTTP2_OPT_MAX_SEND_HEADER_BLOCK_LENGTH = 1 << 8,
     NGHTTP2_OPT_MAX_DEFLATE_DYNAMIC_TABLE_SIZE = 1 << 9,
     NGHTTP2_OPT_NO_CLOSED_STREAMS = 1 << 10,
+    NGHTTP2_OPT_NO_RFC7540_PRIORITIES = 1 << 11,
 } nghttp2_option_flag;
 
 /**
@@ -117,6 +118,10 @@ struct nghttp2_option {
      * NGHTTP2_OPT_NO_CLOSED_STREAMS
      */
     int no_closed_streams;
+    /**
+     * NGHTTP2_OPT_NO_RFC7540_PRIORITIES
+     */
+    int no_rfc7540_priorities;
     /**
      * NGHTTP2_OPT_USER_RECV_EXT_TYPES
      */
@@ -43,6 +43,10 @@ typedef struct {
     /* nonzero if request HEADERS is canceled.  The error code is stored
        in |error_code|. */
     uint8_t canceled;
+    /* pre-encoded header block of frame->headers.nva, or NULL.  This
+       is not owned by the item. */
+    const uint8_t *hd;
+    size_t hdlen;
 } nghttp2_headers_aux_data;
 
 /* struct used for DATA frame */
@@ -143,6 +143,140 @@ static int session_detect_idle_stream(nghttp2_session *session,
   return 0;
 }
 
+/*
+ * Returns nonzero if |session| schedules DATA in round robin order
+ * rather than maintaining the RFC 7540 dependency tree.
+ */
+static int session_no_rfc7540_pri(nghttp2_session *session) {
+  return (session->opt_flags & NGHTTP2_OPTMASK_NO_RFC7540_PRIORITIES) != 0;
+}
+
+/*
+ * Appends |stream| to the round robin queue unless it is queued
+ * already.
+ */
+static void session_sched_push(nghttp2_session *session,
+                               nghttp2_stream *stream) {
+  if (stream->queued) {
+    return;
+  }
+
+  stream->sched_prev = session->sched_tail;
+  stream->sched_next = NULL;
+
+  if (session->sched_tail) {
+    session->sched_tail->sched_next = stream;
+  } else {
+    session->sched_head = stream;
+  }
+
+  session->sched_tail = stream;
+  stream->queued = 1;
+}
+
+/*
+ * Removes |stream| from the round robin queue if it is queued.
+ */
+static void session_sched_remove(nghttp2_session *session,
+                                 nghttp2_stream *stream) {
+  if (!stream->queued) {
+    return;
+  }
+
+  if (stream->sched_prev) {
+    stream->sched_prev->sched_next = stream->sched_next;
+  } else {
+    session->sched_head = stream->sched_next;
+  }
+
+  if (stream->sched_next) {
+    stream->sched_next->sched_prev = stream->sched_prev;
+  } else {
+    session->sched_tail = stream->sched_prev;
+  }
+
+  stream->sched_prev = NULL;
+  stream->sched_next = NULL;
+  stream->queued = 0;
+}
+
+/*
+ * The following functions attach, detach, defer and resume the item
+ * of |stream| like their nghttp2_stream_* counterparts, and keep the
+ * round robin queue in sync if |session| does not maintain the
+ * dependency tree.  The stream is then outside the tree, so the
+ * nghttp2_stream_* functions only update its item and flags.
+ */
+static int session_attach_stream_item(nghttp2_session *session,
+                                      nghttp2_stream *stream,
+                                      nghttp2_outbound_item *item) {
+  int rv;
+
+  rv = nghttp2_stream_attach_item(stream, item);
+  if (rv != 0) {
+    return rv;
+  }
+
+  if (session_no_rfc7540_pri(session)) {
+    session_sched_push(session, stream);
+  }
+
+  return 0;
+}
+
+static int session_detach_stream_item(nghttp2_session *session,
+                                      nghttp2_stream *stream) {
+  if (session_no_rfc7540_pri(session)) {
+    session_sched_remove(session, stream);
+  }
+
+  return nghttp2_stream_detach_item(stream);
+}
+
+static int session_defer_stream_item(nghttp2_session *session,
+                                     nghttp2_stream *stream, uint8_t flags) {
+  if (session_no_rfc7540_pri(session)) {
+    session_sched_remove(session, stream);
+  }
+
+  return nghttp2_stream_defer_item(stream, flags);
+}
+
+static int session_resume_deferred_stream_item(nghttp2_session *session,
+                                               nghttp2_stream *stream,
+                                               uint8_t flags) {
+  int rv;
+
+  rv = nghttp2_stream_resume_deferred_item(stream, flags);
+  if (rv != 0) {
+    return rv;
+  }
+
+  if (session_no_rfc7540_pri(session) &&
+      (stream->flags & NGHTTP2_STREAM_FLAG_DEFERRED_ALL) == 0) {
+    session_sched_push(session, stream);
+  }
+
+  return 0;
+}
+
+static nghttp2_outbound_item *
+session_sched_get_next_outbound_item(nghttp2_session *session) {
+  if (session_no_rfc7540_pri(session)) {
+    return session->sched_head ? session->sched_head->item : NULL;
+  }
+
+  return nghttp2_stream_next_outbound_item(&session->root);
+}
+
+static int session_sched_empty(nghttp2_session *session) {
+  if (session_no_rfc7540_pri(session)) {
+    return session->sched_head == NULL;
+  }
+
+  return nghttp2_pq_empty(&session->root.obq);
+}
+
 static int check_ext_type_set(const uint8_t *ext_types, uint8_t type) {
   return (ext_types[type / 8] & (1 << (type & 0x7))) > 0;
 }
@@ -516,6 +650,11 @@ static int session_new(nghttp2_session **session_ptr,
         option->no_closed_streams) {
       (*session_ptr)->opt_flags |= NGHTTP2_OPTMASK_NO_CLOSED_STREAMS;
     }
+
+    if ((option->opt_set_mask & NGHTTP2_OPT_NO_RFC7540_PRIORITIES) &&
+        option->no_rfc7540_priorities) {
+      (*session_ptr)->opt_flags |= NGHTTP2_OPTMASK_NO_RFC7540_PRIORITIES;
+    }
   }
 
   rv = nghttp2_hd_deflate_init2(&(*session_ptr)->hd_deflater,
@@ -852,7 +991,7 @@ int nghttp2_session_add_item(nghttp2_session *session,
       return NGHTTP2_ERR_DATA_EXIST;
     }
 
-    rv = nghttp2_stream_attach_item(stream, item);
+    rv = session_attach_stream_item(session, stream, item);
 
     if (rv != 0) {
       return rv;
@@ -1034,7 +1173,12 @@ nghttp2_stream *nghttp2_session_open_stream(nghttp2_session *session,
     stream_alloc = 1;
   }
 
-  if (pri_spec->stream_id != 0) {
+  if (session_no_rfc7540_pri(session)) {
+    /* The stream stays out of the dependency tree, so the priority
+       given by the remote endpoint does not matter. */
+    nghttp2_priority_spec_default_init(&pri_spec_default);
+    pri_spec = &pri_spec_default;
+  } else if (pri_spec->stream_id != 0) {
     dep_stream = nghttp2_session_get_stream_raw(session, pri_spec->stream_id);
 
     if (!dep_stream &&
@@ -1119,6 +1263,10 @@ nghttp2_stream *nghttp2_session_open_stream(nghttp2_session *session,
     }
   }
 
+  if (session_no_rfc7540_pri(session)) {
+    return stream;
+  }
+
   if (pri_spec->stream_id == 0) {
     dep_stream = &session->root;
   }
@@ -1158,7 +1306,7 @@ int nghttp2_session_close_stream(nghttp2_session *session, int32_t stream_id,
 
     item = stream->item;
 
-    rv = nghttp2_stream_detach_item(stream);
+    rv = session_detach_stream_item(session, stream);
 
     if (rv != 0) {
       return rv;
@@ -1991,7 +2139,7 @@ static int session_prep_frame(nghttp2_session *session,
       if (stream) {
         int rv2;
 
-        rv2 = nghttp2_stream_detach_item(stream);
+        rv2 = session_detach_stream_item(session, stream);
 
         if (nghttp2_is_fatal(rv2)) {
           return rv2;
@@ -2010,7 +2158,7 @@ static int session_prep_frame(nghttp2_session *session,
          queue when session->remote_window_size > 0 */
       assert(session->remote_window_size > 0);
 
-      rv = nghttp2_stream_defer_item(stream,
+      rv = session_defer_stream_item(session, stream,
                                      NGHTTP2_STREAM_FLAG_DEFERRED_FLOW_CONTROL);
 
       if (nghttp2_is_fatal(rv)) {
@@ -2029,7 +2177,8 @@ static int session_prep_frame(nghttp2_session *session,
       return rv;
     }
     if (rv == NGHTTP2_ERR_DEFERRED) {
-      rv = nghttp2_stream_defer_item(stream, NGHTTP2_STREAM_FLAG_DEFERRED_USER);
+      rv = session_defer_stream_item(session, stream,
+                                     NGHTTP2_STREAM_FLAG_DEFERRED_USER);
 
       if (nghttp2_is_fatal(rv)) {
         return rv;
@@ -2040,7 +2189,7 @@ static int session_prep_frame(nghttp2_session *session,
       return NGHTTP2_ERR_DEFERRED;
     }
     if (rv == NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE) {
-      rv = nghttp2_stream_detach_item(stream);
+      rv = session_detach_stream_item(session, stream);
 
       if (nghttp2_is_fatal(rv)) {
         return rv;
@@ -2056,7 +2205,7 @@ static int session_prep_frame(nghttp2_session *session,
     if (rv != 0) {
       int rv2;
 
-      rv2 = nghttp2_stream_detach_item(stream);
+      rv2 = session_detach_stream_item(session, stream);
 
       if (nghttp2_is_fatal(rv2)) {
         return rv2;
@@ -2133,8 +2282,19 @@ static int session_prep_frame(nghttp2_session *session,
       return NGHTTP2_ERR_FRAME_SIZE_ERROR;
     }
 
-    rv = nghttp2_frame_pack_headers(&session->aob.framebufs, &frame->headers,
-                                    &session->hd_deflater);
+    /* Pending dynamic table size update must be signaled at the
+       beginning of the header block, which a pre-encoded one does not
+       have. */
+    if (item->aux_data.headers.hd &&
+        !session->hd_deflater.notify_table_size_change) {
+      rv = nghttp2_frame_pack_headers_hd(&session->aob.framebufs,
+                                         &frame->headers,
+                                         item->aux_data.headers.hd,
+                                         item->aux_data.headers.hdlen);
+    } else {
+      rv = nghttp2_frame_pack_headers(&session->aob.framebufs,
+                                      &frame->headers, &session->hd_deflater);
+    }
 
     if (rv != 0) {
       return rv;
@@ -2332,7 +2492,7 @@ nghttp2_session_get_next_ob_item(nghttp2_session *session) {
   }
 
   if (session->remote_window_size > 0) {
-    return nghttp2_stream_next_outbound_item(&session->root);
+    return session_sched_get_next_outbound_item(session);
   }
 
   return NULL;
@@ -2366,7 +2526,7 @@ nghttp2_session_pop_next_ob_item(nghttp2_session *session) {
   }
 
   if (session->remote_window_size > 0) {
-    return nghttp2_stream_next_outbound_item(&session->root);
+    return session_sched_get_next_outbound_item(session);
   }
 
   return NULL;
@@ -2476,9 +2636,17 @@ static int session_close_stream_on_goaway(nghttp2_session *session,
   return 0;
 }
 
-static void reschedule_stream(nghttp2_stream *stream) {
+static void reschedule_stream(nghttp2_session *session,
+                              nghttp2_stream *stream) {
   stream->last_writelen = stream->item->frame.hd.length;
 
+  if (session_no_rfc7540_pri(session)) {
+    /* Round robin: the stream goes behind the others */
+    session_sched_remove(session, stream);
+    session_sched_push(session, stream);
+    return;
+  }
+
   nghttp2_stream_reschedule(stream);
 }
 
@@ -2536,13 +2704,13 @@ static int session_after_frame_sent1(nghttp2_session *session) {
     }
 
     if (stream && aux_data->eof) {
-      rv = nghttp2_stream_detach_item(stream);
+      rv = session_detach_stream_item(session, stream);
       if (nghttp2_is_fatal(rv)) {
         return rv;
       }
 
       /* Call on_frame_send_callback after
-         nghttp2_stream_detach_item(), so that application can issue
+         session_detach_stream_item(), so that application can issue
          nghttp2_submit_data() in the callback. */
       if (session->callbacks.on_frame_send_callback) {
         rv = session_call_on_frame_send(session, frame);
@@ -2661,7 +2829,7 @@ static int session_after_frame_sent1(nghttp2_session *session) {
     }
   }
   case NGHTTP2_PRIORITY:
-    if (session->server) {
+    if (session->server || session_no_rfc7540_pri(session)) {
       return 0;
       ;
     }
@@ -2837,7 +3005,7 @@ static int session_after_frame_sent2(nghttp2_session *session) {
      further data. */
   if (nghttp2_session_predicate_data_send(session, stream) != 0) {
     if (stream) {
-      rv = nghttp2_stream_detach_item(stream);
+      rv = session_detach_stream_item(session, stream);
 
       if (nghttp2_is_fatal(rv)) {
         return rv;
@@ -3135,7 +3303,7 @@ static ssize_t nghttp2_session_mem_send_internal(nghttp2_session *session,
       }
 
       if (rv == NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE) {
-        rv = nghttp2_stream_detach_item(stream);
+        rv = session_detach_stream_item(session, stream);
 
         if (nghttp2_is_fatal(rv)) {
           return rv;
@@ -4083,8 +4251,9 @@ int nghttp2_session_on_priority_received(nghttp2_session *session,
         session, NGHTTP2_PROTOCOL_ERROR, "depend on itself");
   }
 
-  if (!session->server) {
-    /* Re-prioritization works only in server */
+  if (!session->server || session_no_rfc7540_pri(session)) {
+    /* Re-prioritization works only in server, and only if it
+       maintains the dependency tree */
     return session_call_on_frame_received(session, frame);
   }
 
@@ -4197,8 +4366,8 @@ static int update_remote_initial_window_size_func(nghttp2_map_entry *entry,
   if (stream->remote_window_size > 0 &&
       nghttp2_stream_check_deferred_by_flow_control(stream)) {
 
-    rv = nghttp2_stream_resume_deferred_item(
-        stream, NGHTTP2_STREAM_FLAG_DEFERRED_FLOW_CONTROL);
+    rv = session_resume_deferred_stream_item(
+        arg->session, stream, NGHTTP2_STREAM_FLAG_DEFERRED_FLOW_CONTROL);
 
     if (nghttp2_is_fatal(rv)) {
       return rv;
@@ -4366,6 +4535,9 @@ int nghttp2_session_update_local_settings(nghttp2_session *session,
     case NGHTTP2_SETTINGS_ENABLE_CONNECT_PROTOCOL:
       session->local_settings.enable_connect_protocol = iv[i].value;
       break;
+    case NGHTTP2_SETTINGS_NO_RFC7540_PRIORITIES:
+      session->local_settings.no_rfc7540_priorities = iv[i].value;
+      break;
     }
   }
 
@@ -4378,6 +4550,7 @@ int nghttp2_session_on_settings_received(nghttp2_session *session,
   size_t i;
   nghttp2_mem *mem;
   nghttp2_inflight_settings *settings;
+  int first_settings;
 
   mem = &session->mem;
 
@@ -4415,6 +4588,8 @@ int nghttp2_session_on_settings_received(nghttp2_session *session,
     return session_call_on_frame_received(session, frame);
   }
 
+  first_settings = !session->remote_settings_received;
+
   if (!session->remote_settings_received) {
     session->remote_settings.max_concurrent_streams =
         NGHTTP2_DEFAULT_MAX_CONCURRENT_STREAMS;
@@ -4524,6 +4699,24 @@ int nghttp2_session_on_settings_received(nghttp2_session *session,
 
       session->remote_settings.enable_connect_protocol = entry->value;
 
+      break;
+    case NGHTTP2_SETTINGS_NO_RFC7540_PRIORITIES:
+
+      if (entry->value != 0 && entry->value != 1) {
+        return session_handle_invalid_connection(
+            session, frame, NGHTTP2_ERR_PROTO,
+            "SETTINGS: invalid SETTINGS_NO_RFC7540_PRIORITIES");
+      }
+
+      if (!first_settings &&
+          session->remote_settings.no_rfc7540_priorities != entry->value) {
+        return session_handle_invalid_connection(
+            session, frame, NGHTTP2_ERR_PROTO,
+            "SETTINGS: SETTINGS_NO_RFC7540_PRIORITIES cannot be changed");
+      }
+
+      session->remote_settings.no_rfc7540_priorities = entry->value;
+
       break;
     }
   }
@@ -4810,8 +5003,8 @@ static int session_on_stream_window_update_received(nghttp2_session *session,
   if (stream->remote_window_size > 0 &&
       nghttp2_stream_check_deferred_by_flow_control(stream)) {
 
-    rv = nghttp2_stream_resume_deferred_item(
-        stream, NGHTTP2_STREAM_FLAG_DEFERRED_FLOW_CONTROL);
+    rv = session_resume_deferred_stream_item(
+        session, stream, NGHTTP2_STREAM_FLAG_DEFERRED_FLOW_CONTROL);
 
     if (nghttp2_is_fatal(rv)) {
       return rv;
@@ -5276,6 +5469,7 @@ static void inbound_frame_set_settings_entry(nghttp2_inbound_frame *iframe) {
   case NGHTTP2_SETTINGS_MAX_FRAME_SIZE:
   case NGHTTP2_SETTINGS_MAX_HEADER_LIST_SIZE:
   case NGHTTP2_SETTINGS_ENABLE_CONNECT_PROTOCOL:
+  case NGHTTP2_SETTINGS_NO_RFC7540_PRIORITIES:
     break;
   default:
     DEBUGF("recv: unknown settings id=0x%02x\n", iv.settings_id);
@@ -6841,7 +7035,7 @@ int nghttp2_session_want_write(nghttp2_session *session) {
    */
   return session->aob.item || nghttp2_outbound_queue_top(&session->ob_urgent) ||
          nghttp2_outbound_queue_top(&session->ob_reg) ||
-         (!nghttp2_pq_empty(&session->root.obq) &&
+         (!session_sched_empty(session) &&
           session->remote_window_size > 0) ||
          (nghttp2_outbound_queue_top(&session->ob_syn) &&
           !session_is_outgoing_concurrent_streams_max(session));
@@ -7213,7 +7407,7 @@ int nghttp2_session_pack_data(nghttp2_session *session, nghttp2_bufs *bufs,
     return rv;
   }
 
-  reschedule_stream(stream);
+  reschedule_stream(session, stream);
 
   if (frame->hd.length == 0 && (data_flags & NGHTTP2_DATA_FLAG_EOF) &&
       (data_flags & NGHTTP2_DATA_FLAG_NO_END_STREAM)) {
@@ -7287,7 +7481,7 @@ int nghttp2_session_resume_data(nghttp2_session *session, int32_t stream_id) {
     return NGHTTP2_ERR_INVALID_ARGUMENT;
   }
 
-  rv = nghttp2_stream_resume_deferred_item(stream,
+  rv = session_resume_deferred_stream_item(session, stream,
                                            NGHTTP2_STREAM_FLAG_DEFERRED_USER);
 
   if (nghttp2_is_fatal(rv)) {
@@ -7395,6 +7589,8 @@ uint32_t nghttp2_session_get_remote_settings(nghttp2_session *session,
     return session->remote_settings.max_header_list_size;
   case NGHTTP2_SETTINGS_ENABLE_CONNECT_PROTOCOL:
     return session->remote_settings.enable_connect_protocol;
+  case NGHTTP2_SETTINGS_NO_RFC7540_PRIORITIES:
+    return session->remote_settings.no_rfc7540_priorities;
   }
 
   assert(0);
@@ -7418,6 +7614,8 @@ uint32_t nghttp2_session_get_local_settings(nghttp2_session *session,
     return session->local_settings.max_header_list_size;
   case NGHTTP2_SETTINGS_ENABLE_CONNECT_PROTOCOL:
     return session->local_settings.enable_connect_protocol;
+  case NGHTTP2_SETTINGS_NO_RFC7540_PRIORITIES:
+    return session->local_settings.no_rfc7540_priorities;
   }
 
   assert(0);
@@ -7738,6 +7936,11 @@ int nghttp2_session_create_idle_stream(nghttp2_session *session,
     return NGHTTP2_ERR_INVALID_ARGUMENT;
   }
 
+  if (session_no_rfc7540_pri(session)) {
+    /* Idle streams only serve as anchors in the dependency tree */
+    return 0;
+  }
+
   pri_spec_copy = *pri_spec;
   nghttp2_priority_spec_normalize_weight(&pri_spec_copy);
 
@@ -52,7 +52,8 @@ typedef enum {
     NGHTTP2_OPTMASK_NO_RECV_CLIENT_MAGIC = 1 << 1,
     NGHTTP2_OPTMASK_NO_HTTP_MESSAGING = 1 << 2,
     NGHTTP2_OPTMASK_NO_AUTO_PING_ACK = 1 << 3,
-    NGHTTP2_OPTMASK_NO_CLOSED_STREAMS = 1 << 4
+    NGHTTP2_OPTMASK_NO_CLOSED_STREAMS = 1 << 4,
+    NGHTTP2_OPTMASK_NO_RFC7540_PRIORITIES = 1 << 5
 } nghttp2_optmask;
 
 /*
@@ -165,6 +166,7 @@ typedef struct {
     uint32_t max_frame_size;
     uint32_t max_header_list_size;
     uint32_t enable_connect_protocol;
+    uint32_t no_rfc7540_priorities;
 } nghttp2_settings_storage;
 
 typedef enum {
@@ -224,6 +226,12 @@ struct nghttp2_session {
     /* Points to the oldest idle stream.  NULL if there is no idle
        stream.  Only used when session is initialized as erver. */
     nghttp2_stream *idle_stream_tail;
+    /* Round robin queue of the streams which have an active DATA item,
+       linked by sched_prev and sched_next.  The head is sent next, and
+       goes to the tail after each DATA frame.  Only used with
+       NGHTTP2_OPTMASK_NO_RFC7540_PRIORITIES, in place of root.obq. */
+    nghttp2_stream *sched_head;
+    nghttp2_stream *sched_tail;
     /* Queue of In-flight SETTINGS values.  SETTINGS bearing ACK is not
        considered as in-flight. */
     nghttp2_inflight_settings *inflight_settings_head;
@@ -86,6 +86,9 @@ void nghttp2_stream_init(nghttp2_stream *stream, int32_t stream_id,
   stream->closed_prev = NULL;
   stream->closed_next = NULL;
 
+  stream->sched_prev = NULL;
+  stream->sched_next = NULL;
+
   stream->weight = weight;
   stream->sum_dep_weight = 0;
 
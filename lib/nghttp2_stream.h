@@ -170,6 +170,12 @@ struct nghttp2_stream {
        closed_next points to the next stream object if it is the element
        of the list. */
     nghttp2_stream *closed_prev, *closed_next;
+    /* When the session does not maintain the dependency tree (see
+       NGHTTP2_OPTMASK_NO_RFC7540_PRIORITIES), the stream is linked in
+       the round robin queue pointed by nghttp2_session sched_head
+       while it has an active item, instead of being pushed to obq of
+       its parent.  queued is nonzero while it is in the queue. */
+    nghttp2_stream *sched_prev, *sched_next;
     /* The arbitrary data provided by user for this stream. */
     void *stream_user_data;
     /* Item to send */
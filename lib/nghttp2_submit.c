@@ -68,6 +68,7 @@ static int32_t submit_headers_shared(nghttp2_session *session, uint8_t flags,
                                      int32_t stream_id,
                                      const nghttp2_priority_spec *pri_spec,
                                      nghttp2_nv *nva_copy, size_t nvlen,
+                                     const uint8_t *hd, size_t hdlen,
                                      const nghttp2_data_provider *data_prd,
                                      void *stream_user_data) {
   int rv;
@@ -92,6 +93,8 @@ static int32_t submit_headers_shared(nghttp2_session *session, uint8_t flags,
   }
 
   item->aux_data.headers.stream_user_data = stream_user_data;
+  item->aux_data.headers.hd = hd;
+  item->aux_data.headers.hdlen = hdlen;
 
   flags_copy =
       (uint8_t)((flags & (NGHTTP2_FLAG_END_STREAM | NGHTTP2_FLAG_PRIORITY)) |
@@ -143,6 +146,7 @@ static int32_t submit_headers_shared_nva(nghttp2_session *session,
                                          uint8_t flags, int32_t stream_id,
                                          const nghttp2_priority_spec *pri_spec,
                                          const nghttp2_nv *nva, size_t nvlen,
+                                         const uint8_t *hd, size_t hdlen,
                                          const nghttp2_data_provider *data_prd,
                                          void *stream_user_data) {
   int rv;
@@ -165,7 +169,8 @@ static int32_t submit_headers_shared_nva(nghttp2_session *session,
   }
 
   return submit_headers_shared(session, flags, stream_id, &copy_pri_spec,
-                               nva_copy, nvlen, data_prd, stream_user_data);
+                               nva_copy, nvlen, hd, hdlen, data_prd,
+                               stream_user_data);
 }
 
 int nghttp2_submit_trailer(nghttp2_session *session, int32_t stream_id,
@@ -175,8 +180,8 @@ int nghttp2_submit_trailer(nghttp2_session *session, int32_t stream_id,
   }
 
   return (int)submit_headers_shared_nva(session, NGHTTP2_FLAG_END_STREAM,
-                                        stream_id, NULL, nva, nvlen, NULL,
-                                        NULL);
+                                        stream_id, NULL, nva, nvlen, NULL, 0,
+                                        NULL, NULL);
 }
 
 int32_t nghttp2_submit_headers(nghttp2_session *session, uint8_t flags,
@@ -208,7 +213,7 @@ int32_t nghttp2_submit_headers(nghttp2_session *session, uint8_t flags,
   }
 
   return submit_headers_shared_nva(session, flags, stream_id, pri_spec, nva,
-                                   nvlen, NULL, stream_user_data);
+                                   nvlen, NULL, 0, NULL, stream_user_data);
 }
 
 int nghttp2_submit_ping(nghttp2_session *session, uint8_t flags,
@@ -673,6 +678,16 @@ int32_t nghttp2_submit_request(nghttp2_session *session,
                                const nghttp2_nv *nva, size_t nvlen,
                                const nghttp2_data_provider *data_prd,
                                void *stream_user_data) {
+  return nghttp2_submit_request_hd(session, pri_spec, nva, nvlen, NULL, 0,
+                                   data_prd, stream_user_data);
+}
+
+int32_t nghttp2_submit_request_hd(nghttp2_session *session,
+                                  const nghttp2_priority_spec *pri_spec,
+                                  const nghttp2_nv *nva, size_t nvlen,
+                                  const uint8_t *hd, size_t hdlen,
+                                  const nghttp2_data_provider *data_prd,
+                                  void *stream_user_data) {
   uint8_t flags;
   int rv;
 
@@ -692,7 +707,7 @@ int32_t nghttp2_submit_request(nghttp2_session *session,
   flags = set_request_flags(pri_spec, data_prd);
 
   return submit_headers_shared_nva(session, flags, -1, pri_spec, nva, nvlen,
-                                   data_prd, stream_user_data);
+                                   hd, hdlen, data_prd, stream_user_data);
 }
 
 static uint8_t set_response_flags(const nghttp2_data_provider *data_prd) {
@@ -718,7 +733,7 @@ int nghttp2_submit_response(nghttp2_session *session, int32_t stream_id,
 
   flags = set_response_flags(data_prd);
   return submit_headers_shared_nva(session, flags, stream_id, NULL, nva, nvlen,
-                                   data_prd, NULL);
+                                   NULL, 0, data_prd, NULL);
 }
 
 int nghttp2_submit_data(nghttp2_session *session, uint8_t flags,
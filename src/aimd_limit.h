@@ -0,0 +1,108 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef AIMD_LIMIT_H
+#define AIMD_LIMIT_H
+
+#include "nghttp2_config.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace h2load {
+
+// AimdLimit is a concurrency limit which adapts to the server by
+// additive increase and multiplicative decrease.  Each answered
+// request grows the limit by 1/limit, that is by one per round trip
+// of a full window, and a request the server pushed back on shrinks
+// it by the backoff ratio.  A push back only shrinks the limit if the
+// request was sent after the limit shrank last, so that a burst of
+// rejections of the requests already in flight counts as one.
+class AimdLimit {
+  public:
+    AimdLimit() : AimdLimit(1., 1., 1., 0.5) {}
+    // The limit starts at |initial| and stays in [|min|, |max|].
+    // |backoff| must be in (0, 1).
+    AimdLimit(double min, double max, double initial, double backoff)
+        : min_(min), max_(max), limit_(std::min(std::max(initial, min), max)),
+          backoff_(backoff), inflight_(0), next_seq_(0), recovery_seq_(0),
+          backoffs_(0) {}
+    // Returns true if the limit allows one more request in flight.
+    bool can_send() const { return inflight_ < limit(); }
+    // Call this function when a request is sent.  It returns the
+    // sequence number of the request, which is passed to on_done().
+    uint64_t on_send() {
+        ++inflight_;
+        return next_seq_++;
+    }
+    // Call this function when the request |seq| is answered.
+    // |overload| tells whether the server pushed back.  It returns
+    // true if the limit shrank.
+    bool on_done(uint64_t seq, bool overload) {
+        if (inflight_ > 0) {
+            --inflight_;
+        }
+        if (overload) {
+            if (seq < recovery_seq_) {
+                return false;
+            }
+            limit_ = std::max(min_, limit_ * backoff_);
+            recovery_seq_ = next_seq_;
+            ++backoffs_;
+            return true;
+        }
+        // Only grow while the limit is what holds requests back, or it
+        // would climb without bound when the load is light.
+        if (2 * (inflight_ + 1) >= limit_) {
+            limit_ = std::min(max_, limit_ + 1. / limit_);
+        }
+        return false;
+    }
+    // Call this function when |n| requests in flight are dropped
+    // without an answer, as a connection closed.
+    void on_abandon(size_t n) { inflight_ -= std::min(n, inflight_); }
+    // Returns the number of requests allowed in flight.
+    size_t limit() const { return static_cast<size_t>(limit_); }
+    // Returns the limit before it is rounded down.
+    double value() const { return limit_; }
+    size_t inflight() const { return inflight_; }
+    // Returns the number of times the limit shrank.
+    uint64_t backoffs() const { return backoffs_; }
+
+  private:
+    double min_, max_;
+    double limit_;
+    double backoff_;
+    size_t inflight_;
+    // The sequence number of the next request, and that of the first
+    // request sent after the limit shrank last
+    uint64_t next_seq_;
+    uint64_t recovery_seq_;
+    uint64_t backoffs_;
+};
+
+} // namespace h2load
+
+#endif // AIMD_LIMIT_H
@@ -0,0 +1,101 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "aimd_limit_test.h"
+
+#include <deque>
+
+#include <CUnit/CUnit.h>
+
+#include "aimd_limit.h"
+
+namespace h2load {
+
+void test_aimd_limit(void) {
+    AimdLimit lim(1., 100., 4., 0.5);
+
+    CU_ASSERT(4 == lim.limit());
+
+    std::deque<uint64_t> window;
+    while (lim.can_send()) {
+        window.push_back(lim.on_send());
+    }
+    CU_ASSERT(4 == window.size());
+    CU_ASSERT(4 == lim.inflight());
+
+    // Answers to a window kept full grow the limit by about one per
+    // window.
+    size_t n = 0;
+    while (lim.limit() < 5) {
+        CU_ASSERT(!lim.on_done(window.front(), false));
+        window.pop_front();
+        ++n;
+        while (lim.can_send()) {
+            window.push_back(lim.on_send());
+        }
+    }
+    CU_ASSERT(5 == n);
+    CU_ASSERT(5 == window.size());
+
+    // Only the first push back of the window shrinks the limit.
+    CU_ASSERT(lim.on_done(window[0], true));
+    auto limit = lim.value();
+    CU_ASSERT(limit > 2.5 && limit < 2.7);
+    CU_ASSERT(!lim.on_done(window[1], true));
+    CU_ASSERT(limit == lim.value());
+    CU_ASSERT(1 == lim.backoffs());
+
+    // A request sent after the limit shrank can shrink it again.
+    CU_ASSERT(!lim.can_send());
+    lim.on_abandon(3);
+    CU_ASSERT(0 == lim.inflight());
+    auto seq = lim.on_send();
+    CU_ASSERT(lim.on_done(seq, true));
+    CU_ASSERT(2 == lim.backoffs());
+    CU_ASSERT(1 == lim.limit());
+
+    // The limit stays in its bounds.
+    for (auto i = 0; i < 8; ++i) {
+        CU_ASSERT(lim.on_done(lim.on_send(), true));
+    }
+    CU_ASSERT(1. == lim.value());
+
+    AimdLimit small(1., 2., 2., 0.5);
+    for (auto i = 0; i < 100; ++i) {
+        auto a = small.on_send();
+        auto b = small.on_send();
+        small.on_done(a, false);
+        small.on_done(b, false);
+    }
+    CU_ASSERT(2. == small.value());
+
+    // A light load does not grow the limit.
+    AimdLimit light(1., 100., 10., 0.5);
+    for (auto i = 0; i < 100; ++i) {
+        light.on_done(light.on_send(), false);
+    }
+    CU_ASSERT(10. == light.value());
+}
+
+} // namespace h2load
@@ -0,0 +1,127 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef ALIAS_TABLE_H
+#define ALIAS_TABLE_H
+
+#include "nghttp2_config.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nghttp2 {
+
+// AliasTable draws an index with probability in proportion to its
+// weight in constant time, by Vose's alias method.  Each index owns a
+// column of equal probability, which is split between it and one
+// other index, its alias.  A draw picks a column and a point in it
+// from one 64 bit random number, so it costs a multiplication and a
+// comparison, however many weights there are.
+class AliasTable {
+  public:
+    AliasTable() {}
+    // |weights| must have at least one positive weight.
+    explicit AliasTable(const std::vector<uint32_t> &weights) {
+        auto n = weights.size();
+        uint64_t total = 0;
+        for (auto w : weights) {
+            total += w;
+        }
+        assert(total > 0);
+
+        threshold_.resize(n);
+        alias_.resize(n);
+
+        // The weight of each index scaled so that a column holds
+        // |total|, in integers, so that the table is exact.
+        std::vector<uint64_t> scaled(n);
+        std::vector<uint32_t> small, large;
+        for (size_t i = 0; i < n; ++i) {
+            scaled[i] = static_cast<uint64_t>(weights[i]) * n;
+            alias_[i] = i;
+            (scaled[i] < total ? small : large).push_back(i);
+        }
+
+        while (!small.empty() && !large.empty()) {
+            auto s = small.back();
+            small.pop_back();
+            auto l = large.back();
+            threshold_[s] = to_threshold(scaled[s], total);
+            alias_[s] = l;
+            scaled[l] -= total - scaled[s];
+            if (scaled[l] < total) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+        // What is left fills its column by itself.
+        for (auto i : large) {
+            threshold_[i] = FULL;
+        }
+        for (auto i : small) {
+            threshold_[i] = FULL;
+        }
+    }
+
+    // Returns an index drawn by the uniformly distributed random
+    // number |r|.  The high 32 bits pick the column, and the low 32
+    // bits the point in it.
+    size_t draw(uint64_t r) const {
+        auto col = static_cast<size_t>(((r >> 32) * threshold_.size()) >> 32);
+        return (r & 0xffffffffu) < threshold_[col] ? col : alias_[col];
+    }
+
+    size_t size() const { return threshold_.size(); }
+    bool empty() const { return threshold_.empty(); }
+
+  private:
+    // The threshold of a column which its own index fills
+    static constexpr uint64_t FULL = static_cast<uint64_t>(1) << 32;
+
+    static uint64_t to_threshold(uint64_t part, uint64_t total) {
+        return static_cast<uint64_t>(
+            (static_cast<unsigned __int128>(part) << 32) / total);
+    }
+
+    // A draw in column i whose low 32 bits are less than threshold_[i]
+    // gives i, and alias_[i] otherwise.
+    std::vector<uint64_t> threshold_;
+    std::vector<uint32_t> alias_;
+};
+
+// Returns the next number of the SplitMix64 generator whose state is
+// |state|.  It is good enough to draw from AliasTable, and costs a
+// handful of instructions.
+inline uint64_t splitmix64(uint64_t &state) {
+    auto z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+} // namespace nghttp2
+
+#endif // ALIAS_TABLE_H
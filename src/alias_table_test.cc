@@ -0,0 +1,100 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "alias_table_test.h"
+
+#include <vector>
+
+#include <CUnit/CUnit.h>
+
+#include "alias_table.h"
+
+namespace nghttp2 {
+
+namespace {
+// Draws from |table| at |steps| evenly spaced points of each column,
+// and returns the number of times each index came out.
+std::vector<uint64_t> draw_evenly(const AliasTable &table, uint64_t steps) {
+    std::vector<uint64_t> counts(table.size());
+    auto n = static_cast<uint64_t>(table.size());
+    for (uint64_t col = 0; col < n; ++col) {
+        // The smallest high half which picks |col|
+        auto hi = ((col << 32) + n - 1) / n;
+        for (uint64_t k = 0; k < steps; ++k) {
+            auto lo = (k << 32) / steps;
+            ++counts[table.draw((hi << 32) | lo)];
+        }
+    }
+    return counts;
+}
+} // namespace
+
+void test_alias_table(void) {
+    {
+        AliasTable table({70, 25, 5});
+        CU_ASSERT(3 == table.size());
+        auto counts = draw_evenly(table, 1000);
+        // Each column has 1000 points, so the shares are exact to
+        // within a point per column.
+        CU_ASSERT(counts[0] >= 2097 && counts[0] <= 2103);
+        CU_ASSERT(counts[1] >= 747 && counts[1] <= 753);
+        CU_ASSERT(counts[2] >= 147 && counts[2] <= 153);
+    }
+    {
+        // An index of weight 0 is never drawn.
+        AliasTable table({0, 1, 0, 3});
+        auto counts = draw_evenly(table, 1000);
+        CU_ASSERT(0 == counts[0]);
+        CU_ASSERT(0 == counts[2]);
+        CU_ASSERT(counts[1] >= 996 && counts[1] <= 1004);
+        CU_ASSERT(counts[3] >= 2996 && counts[3] <= 3004);
+    }
+    {
+        AliasTable table({7});
+        CU_ASSERT(0 == table.draw(0));
+        CU_ASSERT(0 == table.draw(~static_cast<uint64_t>(0)));
+    }
+    {
+        // Equal weights give each index its own column.
+        AliasTable table({2, 2, 2, 2, 2});
+        for (uint64_t col = 0; col < 5; ++col) {
+            auto hi = ((col << 32) + 4) / 5;
+            CU_ASSERT(col == table.draw(hi << 32));
+            CU_ASSERT(col == table.draw((hi << 32) | 0xffffffffu));
+        }
+    }
+    {
+        uint64_t state = 0;
+        std::vector<uint64_t> counts(3);
+        AliasTable table({70, 25, 5});
+        for (size_t i = 0; i < 100000; ++i) {
+            ++counts[table.draw(splitmix64(state))];
+        }
+        CU_ASSERT(counts[0] > 69000 && counts[0] < 71000);
+        CU_ASSERT(counts[1] > 24000 && counts[1] < 26000);
+        CU_ASSERT(counts[2] > 4500 && counts[2] < 5500);
+    }
+}
+
+} // namespace nghttp2
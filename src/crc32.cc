@@ -0,0 +1,201 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "crc32.h"
+
+#include <zlib.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define CRC32_PCLMUL 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define CRC32_ARM 1
+#include <arm_acle.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+namespace nghttp2 {
+
+namespace {
+uint32_t crc32_zlib(uint32_t crc, const uint8_t *data, size_t len) {
+    // zlib takes uInt lengths.
+    while (len > 0) {
+        auto n = static_cast<uInt>(std::min(len, static_cast<size_t>(1 << 30)));
+        crc = ::crc32(crc, data, n);
+        data += n;
+        len -= n;
+    }
+    return crc;
+}
+} // namespace
+
+#ifdef CRC32_PCLMUL
+namespace {
+__attribute__((target("pclmul,sse4.1"))) inline __m128i
+load128(const uint8_t *p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+// Returns |x| multiplied by the constants in |k|, folded onto |y|.
+__attribute__((target("pclmul,sse4.1"))) inline __m128i
+fold128(__m128i x, __m128i k, __m128i y) {
+    auto lo = _mm_clmulepi64_si128(x, k, 0x00);
+    auto hi = _mm_clmulepi64_si128(x, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(hi, y), lo);
+}
+
+// Folds |len| bytes at |data|, which must be a multiple of 16 and at
+// least 64, into the bit-reflected, pre-inverted CRC state |crc| with
+// carry-less multiplication.  The constants are those of "Fast CRC
+// Computation for Generic Polynomials Using PCLMULQDQ Instruction" by
+// Gopal et al. for the CRC-32 polynomial.
+__attribute__((target("pclmul,sse4.1"))) uint32_t
+crc32_pclmul(uint32_t crc, const uint8_t *data, size_t len) {
+    alignas(16) static const uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+    alignas(16) static const uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+    alignas(16) static const uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+    alignas(16) static const uint64_t poly[] = {0x01db710641, 0x01f7011641};
+
+    auto x1 = load128(data);
+    auto x2 = load128(data + 16);
+    auto x3 = load128(data + 32);
+    auto x4 = load128(data + 48);
+
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+
+    auto x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k1k2));
+
+    data += 64;
+    len -= 64;
+
+    // Fold 4 lanes of 16 bytes in parallel.
+    for (; len >= 64; data += 64, len -= 64) {
+        auto x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        auto x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        auto x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        auto x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), load128(data));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), load128(data + 16));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), load128(data + 32));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), load128(data + 48));
+    }
+
+    // Fold the 4 lanes into one.
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(k3k4));
+
+    x1 = fold128(x1, x0, x2);
+    x1 = fold128(x1, x0, x3);
+    x1 = fold128(x1, x0, x4);
+
+    for (; len >= 16; data += 16, len -= 16) {
+        x1 = fold128(x1, x0, load128(data));
+    }
+
+    // Fold 128 bits into 64 bits.
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+    x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(k5k0));
+
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i *>(poly));
+
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+bool have_pclmul() {
+    static const bool rv =
+        __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+    return rv;
+}
+} // namespace
+#endif // CRC32_PCLMUL
+
+#ifdef CRC32_ARM
+namespace {
+uint32_t crc32_arm(uint32_t crc, const uint8_t *data, size_t len) {
+    crc = ~crc;
+    for (; len >= 8; data += 8, len -= 8) {
+        uint64_t v;
+        memcpy(&v, data, sizeof(v));
+        crc = __crc32d(crc, v);
+    }
+    for (; len > 0; ++data, --len) {
+        crc = __crc32b(crc, *data);
+    }
+    return ~crc;
+}
+} // namespace
+#endif // CRC32_ARM
+
+uint32_t update_crc32(uint32_t crc, const uint8_t *data, size_t len) {
+#if defined(CRC32_PCLMUL)
+    if (len >= 64 && have_pclmul()) {
+        auto n = len & ~static_cast<size_t>(15);
+        crc = ~crc32_pclmul(~crc, data, n);
+        data += n;
+        len -= n;
+    }
+#elif defined(CRC32_ARM)
+    return crc32_arm(crc, data, len);
+#endif
+
+    if (len == 0) {
+        return crc;
+    }
+
+    return crc32_zlib(crc, data, len);
+}
+
+bool crc32_accelerated() {
+#if defined(CRC32_PCLMUL)
+    return have_pclmul();
+#elif defined(CRC32_ARM)
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace nghttp2
@@ -0,0 +1,47 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef CRC32_H
+#define CRC32_H
+
+#include "nghttp2_config.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nghttp2 {
+
+// Returns the CRC-32 (ISO-HDLC, as in zlib and java.util.zip.CRC32)
+// of |len| bytes at |data|, continuing from |crc|, which is the CRC of
+// the bytes before them, or 0 to start a new one.  PCLMULQDQ on x86-64,
+// or the ARMv8 CRC32 instructions when the compiler targets them, are
+// used when available.  Otherwise, this falls back to zlib.
+uint32_t update_crc32(uint32_t crc, const uint8_t *data, size_t len);
+
+// Returns true if update_crc32() uses hardware instructions.
+bool crc32_accelerated();
+
+} // namespace nghttp2
+
+#endif // CRC32_H
@@ -0,0 +1,67 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "crc32_test.h"
+
+#include <vector>
+
+#include <CUnit/CUnit.h>
+
+#include <zlib.h>
+
+#include "crc32.h"
+
+namespace nghttp2 {
+
+void test_crc32(void) {
+    const uint8_t check[] = "123456789";
+
+    CU_ASSERT(0 == update_crc32(0, check, 0));
+    CU_ASSERT(0xcbf43926 == update_crc32(0, check, 9));
+    CU_ASSERT(0xcbf43926 == update_crc32(update_crc32(0, check, 4), check + 4, 5));
+
+    std::vector<uint8_t> data(4096 + 15);
+    uint32_t x = 1;
+    for (auto &c : data) {
+        x = x * 1103515245 + 12345;
+        c = static_cast<uint8_t>(x >> 16);
+    }
+
+    // Every length and alignment around the 16 and 64 byte blocks of
+    // the folding code agrees with zlib.
+    for (size_t off = 0; off < 16; ++off) {
+        for (size_t len = 0; len < 300; ++len) {
+            CU_ASSERT(::crc32(0, data.data() + off, len) ==
+                      update_crc32(0, data.data() + off, len));
+        }
+    }
+
+    CU_ASSERT(::crc32(0, data.data(), 4096) ==
+              update_crc32(0, data.data(), 4096));
+    CU_ASSERT(::crc32(0, data.data(), 4096) ==
+              update_crc32(update_crc32(0, data.data(), 1000),
+                           data.data() + 1000, 3096));
+}
+
+} // namespace nghttp2
@@ -0,0 +1,163 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef DEADLINE_WHEEL_H
+#define DEADLINE_WHEEL_H
+
+#include "nghttp2_config.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace h2load {
+
+// DeadlineNode is the entry of a request in DeadlineWheel.  It lives
+// in the request, which must unlink it before it goes away.
+struct DeadlineNode {
+    DeadlineNode()
+        : prev(nullptr), next(nullptr), data(nullptr), id(0), tick(0) {}
+    bool linked() const { return next != nullptr; }
+    void unlink() {
+        if (!next) {
+            return;
+        }
+        prev->next = next;
+        next->prev = prev;
+        prev = next = nullptr;
+    }
+    DeadlineNode *prev, *next;
+    // What the owner of the wheel needs to find the request
+    void *data;
+    int32_t id;
+    // The tick the request expires at
+    uint64_t tick;
+};
+
+// DeadlineWheel is a hashed timer wheel of request deadlines, which
+// all are the same timeout away from when they are scheduled.  A
+// deadline goes to the slot of its tick in a ring, so that scheduling,
+// cancelling and expiring one take constant time however many are
+// pending.  The tick is 1/|TIMEOUT_TICKS| of the timeout, so a
+// deadline expires at most that much late, and the ring is larger
+// than the timeout, so that a slot only holds deadlines due when it
+// is reached, unless the wheel fell behind.  Deadlines of other
+// lengths may be scheduled with schedule_after(), which takes a lap
+// of the ring for each NSLOTS ticks.
+class DeadlineWheel {
+  public:
+    static constexpr size_t TIMEOUT_TICKS = 512;
+    static constexpr size_t NSLOTS = 1024;
+    // The shortest tick in seconds, which keeps the wheel from waking
+    // up more often than the clock is worth
+    static constexpr double MIN_TICK = 0.001;
+
+    DeadlineWheel() : tick_(0.), timeout_ticks_(0), now_(0), target_(0) {}
+    DeadlineWheel(const DeadlineWheel &) = delete;
+    DeadlineWheel &operator=(const DeadlineWheel &) = delete;
+    // Sets up the wheel for deadlines of |timeout| seconds.
+    void init(double timeout) {
+        tick_ = std::max(MIN_TICK, timeout / TIMEOUT_TICKS);
+        timeout_ticks_ = std::max(
+            static_cast<uint64_t>(1),
+            static_cast<uint64_t>(std::ceil(timeout / tick_)));
+        // The slots are linked to themselves, so they must not move.
+        slots_ = std::vector<DeadlineNode>(NSLOTS);
+        for (auto &slot : slots_) {
+            slot.prev = slot.next = &slot;
+        }
+    }
+    // Returns the length of a tick in seconds.
+    double tick() const { return tick_; }
+    // Returns the number of ticks the wheel has reached.
+    uint64_t now() const { return now_; }
+    // Schedules |node|, which must not be linked, to expire a timeout
+    // from now.  It expires one tick later, so that it is never
+    // early, whenever in the current tick it is scheduled.
+    void schedule(DeadlineNode *node) {
+        node->tick = target_ + timeout_ticks_ + 1;
+        push_back(&slots_[node->tick % NSLOTS], node);
+    }
+    // Schedules |node|, which must not be linked, to expire |delay|
+    // seconds from now, rounded up to ticks, as schedule() does.
+    void schedule_after(DeadlineNode *node, double delay) {
+        node->tick =
+            target_ + static_cast<uint64_t>(std::ceil(delay / tick_)) + 1;
+        push_back(&slots_[node->tick % NSLOTS], node);
+    }
+    // Moves the wheel to |tick|, and calls |f| with each node expired
+    // on the way, after unlinking it.  |f| may schedule and unlink
+    // nodes.
+    template <typename F> void advance(uint64_t tick, F f) {
+        if (tick <= now_) {
+            return;
+        }
+        // Nodes scheduled by |f| are as of |tick|.
+        target_ = tick;
+        // A lap visits all slots.
+        now_ = std::max(now_, tick - std::min<uint64_t>(tick, NSLOTS));
+        while (now_ < tick) {
+            ++now_;
+            auto &slot = slots_[now_ % NSLOTS];
+            // |f| may unlink any node, so the expired ones are taken
+            // out of the slot before it is called.
+            DeadlineNode expired;
+            expired.prev = expired.next = &expired;
+            for (auto node = slot.next; node != &slot;) {
+                auto next = node->next;
+                if (node->tick <= now_) {
+                    node->unlink();
+                    push_back(&expired, node);
+                }
+                node = next;
+            }
+            while (expired.next != &expired) {
+                auto node = expired.next;
+                node->unlink();
+                f(node);
+            }
+        }
+    }
+
+  private:
+    static void push_back(DeadlineNode *head, DeadlineNode *node) {
+        node->prev = head->prev;
+        node->next = head;
+        head->prev->next = node;
+        head->prev = node;
+    }
+
+    std::vector<DeadlineNode> slots_;
+    double tick_;
+    uint64_t timeout_ticks_;
+    // The tick the wheel has reached, and the one it is moving to
+    uint64_t now_;
+    uint64_t target_;
+};
+
+} // namespace h2load
+
+#endif // DEADLINE_WHEEL_H
@@ -0,0 +1,118 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "deadline_wheel_test.h"
+
+#include <array>
+#include <vector>
+
+#include <CUnit/CUnit.h>
+
+#include "deadline_wheel.h"
+
+namespace h2load {
+
+void test_deadline_wheel(void) {
+    DeadlineWheel wheel;
+    // 1 second is 512 ticks of about 2ms.
+    wheel.init(1.);
+    CU_ASSERT(1. / 512 == wheel.tick());
+
+    std::array<DeadlineNode, 4> nodes;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].id = i;
+    }
+    std::vector<int32_t> expired;
+    auto collect = [&expired](DeadlineNode *node) {
+        CU_ASSERT(!node->linked());
+        expired.push_back(node->id);
+    };
+
+    wheel.schedule(&nodes[0]);
+    wheel.schedule(&nodes[1]);
+    wheel.schedule(&nodes[2]);
+    CU_ASSERT(nodes[0].linked());
+
+    // A cancelled deadline does not expire.
+    nodes[1].unlink();
+    CU_ASSERT(!nodes[1].linked());
+
+    // Never early
+    wheel.advance(512, collect);
+    CU_ASSERT(expired.empty());
+    wheel.advance(513, collect);
+    CU_ASSERT((std::vector<int32_t>{0, 2}) == expired);
+
+    // A deadline scheduled while the wheel moves is as of where it
+    // moves to, and a wheel which fell behind by more than a lap
+    // catches up.
+    expired.clear();
+    wheel.schedule(&nodes[0]);
+    wheel.advance(513 + 5000, [&](DeadlineNode *node) {
+        expired.push_back(node->id);
+        wheel.schedule(&nodes[3]);
+    });
+    CU_ASSERT((std::vector<int32_t>{0}) == expired);
+    CU_ASSERT(nodes[3].linked());
+
+    // The expiring deadline may cancel the others of its tick.
+    expired.clear();
+    wheel.schedule(&nodes[1]);
+    wheel.advance(513 + 5000 + 513, [&](DeadlineNode *node) {
+        expired.push_back(node->id);
+        nodes[1].unlink();
+    });
+    CU_ASSERT((std::vector<int32_t>{3}) == expired);
+    CU_ASSERT(!nodes[1].linked());
+
+    // Short timeouts tick every millisecond.
+    DeadlineWheel short_wheel;
+    short_wheel.init(0.0105);
+    CU_ASSERT(DeadlineWheel::MIN_TICK == short_wheel.tick());
+    DeadlineNode node;
+    short_wheel.schedule(&node);
+    expired.clear();
+    short_wheel.advance(11, collect);
+    CU_ASSERT(expired.empty());
+    short_wheel.advance(12, collect);
+    CU_ASSERT(1 == expired.size());
+
+    // Other delays may take laps of the ring.
+    DeadlineWheel lap_wheel;
+    lap_wheel.init(1.);
+    std::array<DeadlineNode, 2> laps;
+    laps[0].id = 0;
+    laps[1].id = 1;
+    lap_wheel.schedule_after(&laps[0], 5.);
+    lap_wheel.schedule_after(&laps[1], 0.);
+    expired.clear();
+    lap_wheel.advance(1, collect);
+    CU_ASSERT((std::vector<int32_t>{1}) == expired);
+    lap_wheel.advance(2560, collect);
+    CU_ASSERT((std::vector<int32_t>{1}) == expired);
+    lap_wheel.advance(2561, collect);
+    CU_ASSERT((std::vector<int32_t>{1, 0}) == expired);
+}
+
+} // namespace h2load
@@ -29,7 +29,20 @@
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <signal.h>
+#include <dirent.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#ifdef HAVE_LINUX_NET_TSTAMP_H
+#  include <linux/errqueue.h>
+#  include <linux/net_tstamp.h>
+#endif // HAVE_LINUX_NET_TSTAMP_H
+#ifdef HAVE_LINUX_TLS_H
+#  include <linux/tls.h>
+#endif // HAVE_LINUX_TLS_H
+#include <sys/socket.h>
 #include <sys/stat.h>
+#include <sys/wait.h>
 
 #include <cassert>
 #include <chrono>
@@ -37,18 +50,27 @@
 #include <cstdlib>
 #include <fstream>
 #include <future>
+#include <initializer_list>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
 #include <random>
+#include <sstream>
 #include <thread>
 
 #include <openssl/err.h>
 
 #include "url-parser/url_parser.h"
 
+#include "h2load_compare.h"
+#include "h2load_dist.h"
+#include "h2load_heatmap.h"
 #include "h2load_http1_session.h"
 #include "h2load_http2_session.h"
+#include "h2load_imbalance.h"
+#include "h2load_metrics.h"
 #include "h2load_sofarpc_session.h"
+#include "h2load_sofarpc_spec.h"
 #include "http2.h"
 #include "template.h"
 #include "tls.h"
@@ -71,17 +93,77 @@ namespace {
 bool recorded(const std::chrono::steady_clock::time_point &t) {
     return std::chrono::steady_clock::duration::zero() != t.time_since_epoch();
 }
+
+// Returns |d| in nanoseconds, the unit of latency histograms.
+uint64_t to_latency(std::chrono::steady_clock::duration d) {
+    return std::max(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(d).count(),
+        static_cast<std::chrono::nanoseconds::rep>(0));
+}
+
+// Calls |f| with |session| cast to its concrete class.  The session
+// classes are final, so the calls |f| makes are direct, and can be
+// inlined, rather than going through the vtable on every request and
+// every read.
+template <typename F> decltype(auto) visit_session(Session &session, F &&f) {
+    switch (session.kind) {
+    case SessionKind::SOFARPC:
+        return f(static_cast<SofaRpcSession &>(session));
+    case SessionKind::HTTP2:
+        return f(static_cast<Http2Session &>(session));
+    default:
+        return f(static_cast<Http1Session &>(session));
+    }
+}
 } // namespace
 
 Config::Config()
-    : ciphers(tls::DEFAULT_CIPHER_LIST), data_length(-1), addrs(nullptr),
+    : think_model(ThinkModel::NONE), think_time(0.),
+      ciphers(tls::DEFAULT_CIPHER_LIST), data_length(-1), addrs(nullptr),
+      endpoint_policy(EndpointPolicy::ROUND_ROBIN), ab(false),
       nreqs(1), nclients(1), nthreads(1), max_concurrent_streams(1),
+      connections_per_client(1),
       window_bits(30), connection_window_bits(30), rate(0), rate_period(1.0),
-      duration(0.0), warm_up_time(0.0), conn_active_timeout(0.),
-      conn_inactivity_timeout(0.), no_tls_proto(PROTO_HTTP2),
+      ready(0), ready_timeout(30.),
+      duration(0.0), warm_up_time(0.0), drain_time(0.), warm_up_auto(0.),
+      warm_up_window(5),
+      warm_up_tolerance(10.), conn_active_timeout(0.),
+      conn_inactivity_timeout(0.), request_timeout(0.), churn_requests(0),
+      churn_lifetime(0.), reconnect_max(0), reconnect_base(0.1),
+      reconnect_cap(10.), linger(-1), sndbuf(0), rcvbuf(0),
+      tcp_info_interval(0.), hedge_delay(0.), hedge_percentile(0.),
+      hedge_cancel(false), retry(0), slow_read_rate(0), slow_read_pause(0.),
+      slow_read_period(0.), slow_readers(10), slow_rcvbuf(0),
+      clock_source(ClockSource::STEADY), tsc_ns_per_tick(0.),
+      tcp_nodelay(true),
+      no_tls_proto(PROTO_HTTP2),
+      bolt_version(1), bolt_crc(false), oneway(false), stream_messages(0),
+      aimd(false), aimd_backoff(0.5), replay_speed(1.),
       header_table_size(4_k), encoder_header_table_size(4_k), data_fd(-1),
+      data_map(nullptr),
       port(0), default_port(0), verbose(false),
-      base_uri_unix(false), unix_addr{}, qps(0) {}
+      base_uri_unix(false), unix_addr{}, unix_addrlen(0), qps(0),
+      qps_arrival(ArrivalProcess::PERIODIC), qps_burst(0), slo_min_qps(0), slo_max_qps(0),
+      slo_latency(0.), slo_percentile(99.), slo_error_rate(1.), slo_step(10.),
+      slo_max_steps(10), sweep_step(10.), sweep_settle(2.),
+      latency_precision(7),
+      percentiles{50., 75., 90., 95., 99.}, slowest(0), imbalance(0),
+      trace_records(1 << 20),
+      request_log_sample(0), request_log_failures(false),
+      request_log_slow(0.), response_sizes(false), decode(false), grpc(false),
+      perf_counters(false), io_uring(false), batch_writes(false),
+      cpu_affinity_auto(false), nthreads_auto(false), timestamping(false),
+      timestamping_hw(false), window_auto_tune(false),
+      no_rfc7540_priorities(false), h1_fast_parse(false),
+      ping_interval(0.), local_port_lo(0),
+      local_port_hi(0),
+      tls_resume(0), handshake_bench(HandshakeBench::NONE), ktls(false),
+      chunk_size(16_k), chunk_backing(SlabBacking::PAGES),
+      pre_encode_headers(false), busy_poll(false),
+      busy_poll_usec(0), timeline_interval(1.), heatmap_slice(0.),
+      heatmap_precision(3), heatmap_slices(3600),
+      output_format(OutputFormat::JSON), max_rps_drop(5.),
+      max_latency_rise(10.), metrics_port(0), statsd_port(0), stop_window(3) {}
 
 Config::~Config() {
     if (addrs) {
@@ -91,28 +173,208 @@ Config::~Config() {
         }
     }
 
+    for (auto &ep : endpoints) {
+        if (ep.addrs && ep.addrs != addrs) {
+            freeaddrinfo(ep.addrs);
+        }
+    }
+
+    if (data_map) {
+        munmap(const_cast<uint8_t *>(data_map), data_length);
+    }
+
     if (data_fd != -1) {
         close(data_fd);
     }
 }
 
 bool Config::is_qps_mode() const { return (this->qps != 0); }
+bool Config::has_think_time() const { return think_time > 0.; }
+bool Config::is_stream_mode() const {
+    return stream_messages != 0 || !stream_end_header.empty();
+}
+bool Config::is_replay_mode() const { return replay.size() != 0; }
+bool Config::is_slow_read() const {
+    return slow_read_rate || slow_read_pause > 0.;
+}
+bool Config::is_hedging() const {
+    return hedge_delay > 0. || hedge_percentile > 0.;
+}
+bool Config::has_calls() const { return is_hedging() || retry; }
+bool Config::is_timeline_enabled() const {
+    return !timeline_file.empty() || !output_file.empty() ||
+           !compare_file.empty() || metrics_port || statsd_port ||
+           !stop_conditions.empty() || !heatmap_file.empty();
+}
+bool Config::is_slo_search_mode() const { return (this->slo_max_qps != 0); }
+bool Config::is_sweep_mode() const { return !sweep.empty(); }
+bool Config::count_codings() const {
+    return !accept_encoding.empty() || decode;
+}
+bool Config::is_dynamic_qps() const {
+    return !qps_profile.empty() || is_slo_search_mode();
+}
+
+size_t Config::qps_phase_at(double t) const {
+    size_t i = 0;
+    for (; i + 1 < qps_profile.size(); ++i) {
+        if (t < qps_profile[i].duration) {
+            break;
+        }
+        t -= qps_profile[i].duration;
+    }
+    return i;
+}
+
+double Config::qps_at(double t) const {
+    if (qps_profile.empty()) {
+        return qps;
+    }
+    size_t i = 0;
+    for (; i + 1 < qps_profile.size(); ++i) {
+        if (t < qps_profile[i].duration) {
+            break;
+        }
+        t -= qps_profile[i].duration;
+    }
+    auto &phase = qps_profile[i];
+    if (phase.duration <= 0. || t >= phase.duration) {
+        return phase.end_qps;
+    }
+    return phase.start_qps +
+           (phase.end_qps - phase.start_qps) * t / phase.duration;
+}
 bool Config::is_rate_mode() const { return (this->rate != 0); }
 bool Config::is_timing_based_mode() const { return (this->duration > 0); }
 bool Config::has_base_uri() const { return (!this->base_uri.empty()); }
 
 Config config;
+// The number of requests which no worker has taken yet.  Workers take
+// them in batches; see Worker::take_request().
 std::atomic_size_t total_req_left(0);
-std::atomic_size_t total_req_send(0);
+SloSearch slo_search;
+AutoWarmUp auto_warm_up;
+// The time it took to resolve the host
+std::chrono::steady_clock::duration resolve_time;
+// The resident set size before the workers started, and its peak
+uint64_t rss_start, rss_peak;
+QpsPool qps_pool;
+
+namespace {
+// Times are recorded in the histogram of RunningStat in nanoseconds,
+// and req/s in 1/1000 of request.
+constexpr double TIME_STAT_SCALE = 1e9;
+constexpr double RPS_STAT_SCALE = 1e3;
+} // namespace
 
-Stats::Stats()
+Stats::Stats(size_t precision)
     : req_started(0), req_done(0), req_success(0), req_status_success(0),
       req_failed(0), req_error(0), req_timedout(0), bytes_total(0),
       bytes_head(0), bytes_head_decomp(0), bytes_body(0), status(),
-      sofarpcStatus() {}
+      sofarpcStatus(), grpcStatus(),
+      request_times(TIME_STAT_SCALE, precision),
+      connect_times(TIME_STAT_SCALE, precision),
+      ttfb_times(TIME_STAT_SCALE, precision),
+      rps_values(RPS_STAT_SCALE, precision), stream_stalls(0),
+      stream_stall_time(0), conn_stalls(0), conn_stall_time(0),
+      max_stream_window(0), max_conn_window(0), stream_messages(0),
+      bytes_sent(0),
+      write_blocks(0), write_block_time(0), churn_closes(0), churn_lost(0),
+      calls_done(0), calls_success(0), hedges_sent(0), hedges_won(0),
+      hedges_cancelled(0), retries(0) {}
+
+SidePhaseStat::SidePhaseStat(size_t precision)
+    : stats(precision), rtt_hist(precision) {}
+
+EndpointStat::EndpointStat(size_t precision)
+    : clients(0), req_done(0), req_status_success(0), rtt_hist(precision) {}
+
+ReaderStat::ReaderStat(size_t precision)
+    : clients(0), req_done(0), req_status_success(0), bytes(0),
+      rtt_hist(precision) {}
+
+TemplateStat::TemplateStat(size_t precision)
+    : req_done(0), req_status_success(0), status{}, sofarpcStatus{},
+      rtt_hist(precision) {}
+
+ScenarioStat::ScenarioStat(size_t precision)
+    : done(0), failed(0), hist(precision) {}
+
+void ScenarioStat::merge(const ScenarioStat &other) {
+    done += other.done;
+    failed += other.failed;
+    hist.merge(other.hist);
+}
+
+ResponseSizeStat::ResponseSizeStat(size_t precision)
+    : total(precision), header(precision), classname(precision),
+      content(precision) {}
+
+void ResponseSizeStat::merge(const ResponseSizeStat &other) {
+    total.merge(other.total);
+    header.merge(other.header);
+    classname.merge(other.classname);
+    content.merge(other.content);
+}
+
+DecodeStat::DecodeStat(size_t precision)
+    : responses{}, body_bytes{}, decoded(0), errors(0), decoded_bytes(0),
+      decode_time(0), decode_hist(precision) {}
+
+void DecodeStat::merge(const DecodeStat &other) {
+    for (size_t i = 0; i < responses.size(); ++i) {
+        responses[i] += other.responses[i];
+        body_bytes[i] += other.body_bytes[i];
+    }
+    decoded += other.decoded;
+    errors += other.errors;
+    decoded_bytes += other.decoded_bytes;
+    decode_time += other.decode_time;
+    decode_hist.merge(other.decode_hist);
+}
 
-Stream::Stream() : req_stat{}, status_success(-1) {}
+void TemplateStat::merge(const TemplateStat &other) {
+    req_done += other.req_done;
+    req_status_success += other.req_status_success;
+    for (size_t i = 0; i < status.size(); ++i) {
+        status[i] += other.status[i];
+    }
+    for (size_t i = 0; i < sofarpcStatus.size(); ++i) {
+        sofarpcStatus[i] += other.sofarpcStatus[i];
+    }
+    rtt_hist.merge(other.rtt_hist);
+}
+
+ConnectionStat::ConnectionStat(size_t precision)
+    : attempts(0), established(0), tcp_connect(precision),
+      tls_handshake(precision), tls_full_handshake(precision),
+      tls_resumed_handshake(precision), first_response(precision),
+      failures{}, reconnects(0), gave_up(0), recovery(precision) {}
+
+void ConnectionStat::merge(const ConnectionStat &other) {
+    attempts += other.attempts;
+    established += other.established;
+    tcp_connect.merge(other.tcp_connect);
+    tls_handshake.merge(other.tls_handshake);
+    tls_full_handshake.merge(other.tls_full_handshake);
+    tls_resumed_handshake.merge(other.tls_resumed_handshake);
+    first_response.merge(other.first_response);
+    for (size_t i = 0; i < failures.size(); ++i) {
+        failures[i] += other.failures[i];
+    }
+    reconnects += other.reconnects;
+    gave_up += other.gave_up;
+    recovery.merge(other.recovery);
+}
+
+LoopStat::LoopStat(size_t precision)
+    : lag(precision), busy_time(0), run_time(0), unsent_max(0), unsent_sum(0),
+      nsamples(0), user_time(-1.), system_time(-1.), wakeup(precision),
+      wakeup_sum(0) {}
 
+PhaseStat::PhaseStat(size_t precision)
+    : req_done(0), req_status_success(0), rtt_hist(precision),
+      corrected_rtt_hist(precision) {}
 
 namespace {
 void writecb(struct ev_loop *loop, ev_io *w, int revents) {
@@ -132,7 +394,10 @@ void writecb(struct ev_loop *loop, ev_io *w, int revents) {
         return;
     }
     if (rv != 0) {
-        client->fail();
+        // --handshake-bench asks for a new connection from here.
+        if (client->try_again_or_fail() == 0) {
+            return;
+        }
         client->worker->free_client(client);
     }
 }
@@ -149,49 +414,362 @@ void readcb(struct ev_loop *loop, ev_io *w, int revents) {
         client->worker->free_client(client);
         return;
     }
-    writecb(loop, &client->wev, revents);
+    // With --batch-writes, what on_read() queued is written with the
+    // writes of the other connections at the end of this loop
+    // iteration.
+    if (!client->worker->config->batch_writes ||
+        client->state != CLIENT_CONNECTED) {
+        writecb(loop, &client->wev, revents);
+    }
     // client->disconnect() and client->fail() may be called
 }
 } // namespace
 
+namespace {
+// Called when a slow reader may read again
+void read_resume_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+    auto client = static_cast<Client *>(w->data);
+    ev_io_start(loop, &client->rev);
+    // TLS may hold what it read before the pause, which the socket
+    // would not tell about.
+    readcb(loop, &client->rev, 0);
+}
+} // namespace
+
 namespace {
 // Called when the duration for infinite number of requests are over
 void duration_timeout_cb(struct ev_loop *loop, ev_timer *w, int revents) {
     auto worker = static_cast<Worker *>(w->data);
+    worker->stop_measurement();
+}
+} // namespace
+
+namespace {
+// Called at the end of --drain-time
+void drain_timeout_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    worker->stop_drain();
+}
+} // namespace
 
-    total_req_left.store(0);
-    worker->current_phase = Phase::DURATION_OVER;
+namespace {
+// Called when the connections --ready waits for are not all made
+// within --ready-timeout
+void ready_timeout_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    std::cerr << "--ready: worker " << worker->id << " made only "
+              << worker->nconns_ready << " of "
+              << worker->nclients * worker->config->connections_per_client
+              << " connections within --ready-timeout; starting the warm-up "
+                 "anyway"
+              << std::endl;
+    ev_ref(loop);
+    worker->start_warm_up();
+}
+} // namespace
 
-    ev_periodic_stop(worker->loop, &worker->qpsUpdater);
+namespace {
+// Makes the next connections of -r every --rate-period.
+void rate_period_timeout_cb(struct ev_loop *loop, ev_timer *w,
+                            int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    worker->make_clients(worker->rate);
+}
+} // namespace
 
-    worker->stop_all_clients();
-    ev_break(loop, EVBREAK_ALL);
+namespace {
+// Called when another thread asks to end the measurement
+void stop_cb(struct ev_loop *loop, ev_async *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    if (worker->current_phase == Phase::MAIN_DURATION) {
+        if (ev_is_active(&worker->duration_watcher)) {
+            worker->main_duration =
+                worker->config->duration -
+                ev_timer_remaining(loop, &worker->duration_watcher);
+        }
+        worker->stop_measurement();
+    }
 }
 } // namespace
 
 namespace {
-// Called when the warmup duration for infinite number of requests are over
-void warmup_timeout_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+// The sub-bucket bits of the per-connection latency histograms of
+// --imbalance.  They are kept for every client, so they are coarse:
+// values are within 12.5% of the truth, in 4KiB each.
+constexpr size_t CONN_SKETCH_PRECISION = 3;
+} // namespace
+
+namespace {
+// The number of --timeline samples a worker can have in flight to the
+// reporter thread
+constexpr size_t TIMELINE_QUEUE_SIZE = 256;
+} // namespace
+
+namespace {
+// The number of --request-log records a worker can have in flight to
+// the writer thread
+constexpr size_t REQLOG_QUEUE_SIZE = 64 * 1024;
+} // namespace
+
+namespace {
+// The operation of a UringConn a completion is for, kept in the low
+// bits of its user_data
+constexpr uint64_t URING_OP_RECV = 0;
+constexpr uint64_t URING_OP_WRITE = 1;
+constexpr uint64_t URING_OP_CANCEL = 2;
+constexpr uint64_t URING_OP_MASK = 3;
+// The number of submission queue entries of Worker::uring
+constexpr uint32_t URING_ENTRIES = 1024;
+// The number of buffers Worker::uring reads into.  A buffer is only
+// held from the kernel filling it until its completion is processed.
+constexpr size_t URING_NBUFS = 256;
+
+uint64_t uring_user_data(UringConn *conn, uint64_t op) {
+    return reinterpret_cast<uintptr_t>(conn) | op;
+}
+
+// Frees |conn| once its connection is closed and nothing refers to
+// it anymore.
+void release_uring_conn(UringConn *conn) {
+    if (!conn->client && conn->nops == 0 && !conn->flush_pending) {
+        delete conn;
+    }
+}
+} // namespace
+
+namespace {
+void uring_cb(struct ev_loop *loop, ev_io *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    uint64_t user_data;
+    int32_t res;
+    uint32_t flags;
+    while (worker->uring->next_completion(user_data, res, flags)) {
+        worker->uring_complete(user_data, res, flags);
+    }
+}
+} // namespace
+
+namespace {
+void uring_prepare_cb(struct ev_loop *loop, ev_prepare *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    worker->uring_flush_writes();
+}
+} // namespace
+
+namespace {
+void write_flush_cb(struct ev_loop *loop, ev_prepare *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    worker->flush_writes();
+}
+} // namespace
+
+namespace {
+void uring_idle_cb(struct ev_loop *loop, ev_idle *w, int revents) {
+    ev_idle_stop(loop, w);
+}
+} // namespace
+
+namespace {
+// The interval of the loop probe in seconds
+constexpr double LOOP_PROBE_INTERVAL = 0.01;
+} // namespace
+
+namespace {
+// Measures how late this timer fired, and how many bytes wait for
+// being written.
+void loop_probe_cb(struct ev_loop *loop, ev_timer *w, int revents) {
     auto worker = static_cast<Worker *>(w->data);
-    assert(worker->stats.req_started == 0);
-    assert(worker->stats.req_done == 0);
+    auto &stat = worker->loop_stat;
+    auto now = std::chrono::steady_clock::now();
 
+    stat.lag.record(to_latency(now - worker->loop_probe_due));
+    // libev schedules the next one in the same way.
+    worker->loop_probe_due +=
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(LOOP_PROBE_INTERVAL));
+    worker->loop_probe_due = std::max(worker->loop_probe_due, now);
+
+    uint64_t unsent = 0;
     for (auto client : worker->clients) {
         if (client) {
-            assert(client->req_inflight == 0);
-            assert(client->req_started == 0);
-            assert(client->req_done == 0);
+            unsent += client->wb.rleft() + client->wq.rleft();
+        }
+    }
+    stat.unsent_max = std::max(stat.unsent_max, unsent);
+    stat.unsent_sum += unsent;
+    ++stat.nsamples;
+}
+} // namespace
 
-            client->record_client_start_time();
-            client->clear_connect_times();
-            client->record_connect_start_time();
+namespace {
+// The most ticks of Worker::tcp_info_watcher in a --tcp-info
+// interval.  Each tick samples a slice of the clients, rather than all
+// of them at once, which would stall the loop with many connections.
+constexpr size_t TCP_INFO_SLICES = 10;
+} // namespace
+
+namespace {
+void tcp_info_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    auto &clients = worker->clients;
+    if (clients.empty()) {
+        return;
+    }
+    auto n = (clients.size() + worker->tcp_info_slices - 1) /
+             worker->tcp_info_slices;
+    for (size_t i = 0; i < n; ++i) {
+        if (worker->tcp_info_next >= clients.size()) {
+            worker->tcp_info_next = 0;
+        }
+        auto client = clients[worker->tcp_info_next++];
+        if (client && client->state == CLIENT_CONNECTED) {
+            worker->sample_tcp_info(client);
+        }
+    }
+}
+} // namespace
+
+namespace {
+// Called before the loop waits for events
+void loop_prepare_cb(struct ev_loop *loop, ev_prepare *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    if (recorded(worker->loop_wake_time)) {
+        worker->loop_stat.busy_time +=
+            to_latency(std::chrono::steady_clock::now() - worker->loop_wake_time);
+    }
+}
+} // namespace
+
+namespace {
+// Called after the loop waited for events
+void loop_check_cb(struct ev_loop *loop, ev_check *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    worker->loop_wake_time = std::chrono::steady_clock::now();
+    if (worker->config->clock_source == ClockSource::TSC) {
+        // Anchoring each iteration keeps the error of the calibrated
+        // rate to the time since the wake-up.
+        worker->tsc_clock.anchor(read_tsc(), worker->loop_wake_time);
+    }
+}
+} // namespace
+
+namespace {
+// Called every tick of Worker::deadlines
+void deadline_timeout_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    worker->expire_deadlines();
+}
+} // namespace
+
+namespace {
+// Called every tick of Worker::thinks
+void think_timeout_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    worker->expire_thinks();
+}
+} // namespace
+
+namespace {
+// Called every tick of Worker::hedges
+void hedge_timeout_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    worker->expire_hedges();
+}
+} // namespace
+
+namespace {
+// Called every tick of Worker::reconnects
+void reconnect_timeout_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    worker->expire_reconnects();
+}
+} // namespace
+
+namespace {
+// Called at the end of each --timeline interval
+void timeline_timeout_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    worker->push_timeline_sample(false);
+}
+} // namespace
+
+namespace {
+// Called at the end of each step of --slo-search.  Hands statistics
+// of the step over to the main thread.
+void step_timeout_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    {
+        std::lock_guard<std::mutex> lg(slo_search.mu);
+        auto &report = slo_search.report;
+        auto &stat = worker->step_stat;
+        if (!report) {
+            report = std::make_unique<PhaseStat>(worker->config->latency_precision);
         }
+        report->req_done += stat.req_done;
+        report->req_status_success += stat.req_status_success;
+        report->rtt_hist.merge(stat.rtt_hist);
+        report->corrected_rtt_hist.merge(stat.corrected_rtt_hist);
+        ++slo_search.nreported;
+    }
+    slo_search.cv.notify_all();
+    worker->step_stat = PhaseStat(worker->config->latency_precision);
+    // Quota left unsent by an overloaded step would otherwise flood
+    // the next one.
+    worker->qpsLeft = 0;
+    worker->qps_due.clear();
+    qps_pool.clear(worker->id);
+}
+} // namespace
+
+namespace {
+// Called at the end of each cell of --sweep
+void sweep_timeout_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    if (worker->sweep_cell + 1 < worker->config->sweep.size()) {
+        worker->set_sweep_cell(worker->sweep_cell + 1);
+    } else {
+        ev_timer_stop(loop, w);
     }
+}
+} // namespace
+
+namespace {
+// Called when the warmup duration for infinite number of requests are over
+void warmup_timeout_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    worker->end_warm_up();
+}
+} // namespace
 
-    worker->current_phase = Phase::MAIN_DURATION;
+namespace {
+// Called at the end of each interval of --warm-up-auto.  Hands
+// statistics of the interval over to the main thread.
+void warmup_sample_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    {
+        std::lock_guard<std::mutex> lg(auto_warm_up.mu);
+        auto &report = auto_warm_up.report;
+        auto &stat = worker->warmup_stat;
+        if (!report) {
+            report = std::make_unique<PhaseStat>(worker->config->latency_precision);
+        }
+        report->req_done += stat.req_done;
+        report->req_status_success += stat.req_status_success;
+        report->rtt_hist.merge(stat.rtt_hist);
+        ++auto_warm_up.nreported;
+    }
+    auto_warm_up.cv.notify_all();
+    worker->warmup_stat = PhaseStat(worker->config->latency_precision);
+}
+} // namespace
 
-    ev_timer_start(worker->loop, &worker->duration_watcher);
-    ev_periodic_start(worker->loop, &worker->qpsUpdater);
+namespace {
+// Called when the main thread found --warm-up-auto stable
+void warmup_end_cb(struct ev_loop *loop, ev_async *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    if (worker->current_phase == Phase::WARM_UP) {
+        worker->end_warm_up();
+    }
 }
 } // namespace
 
@@ -206,71 +784,75 @@ void conn_timeout_cb(EV_P_ ev_timer *w, int revents) {
     ev_timer_stop(client->worker->loop, &client->conn_active_watcher);
 
     if (util::check_socket_connected(client->fd)) {
+        if (w == &client->conn_inactivity_watcher) {
+            client->conn_error = CONN_ERROR_TIMEOUT;
+        }
         client->timeout();
     }
 }
 } // namespace
 
 namespace {
-bool check_stop_client_request_timeout(Client *client, ev_timer *w) {
-    if (total_req_left.load() <= 0) {
-        // no more requests to make, stop timer
-        ev_timer_stop(client->worker->loop, w);
-        return true;
-    }
-
-    return false;
+void ping_timeout_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+    auto client = static_cast<Client *>(w->data);
+    client->submit_ping();
 }
 } // namespace
 
 namespace {
-void client_request_timeout_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+void churn_timeout_cb(struct ev_loop *loop, ev_timer *w, int revents) {
     auto client = static_cast<Client *>(w->data);
+    client->on_churn_timeout();
+}
+} // namespace
 
-    if (client->streams.size() >= (size_t)config.max_concurrent_streams) {
-        ev_timer_stop(client->worker->loop, w);
-        return;
-    }
-
-    if (client->submit_request() != 0) {
-        ev_timer_stop(client->worker->loop, w);
-        client->process_request_failure();
-        return;
-    }
-    client->signal_write();
-
-    if (check_stop_client_request_timeout(client, w)) {
-        return;
-    }
-
-    ev_tstamp duration =
-        config.timings[client->reqidx] - config.timings[client->reqidx - 1];
-
-    while (duration < 1e-9) {
-        if (client->submit_request() != 0) {
-            ev_timer_stop(client->worker->loop, w);
-            client->process_request_failure();
-            return;
-        }
-        client->signal_write();
-        if (check_stop_client_request_timeout(client, w)) {
-            return;
-        }
-
-        duration =
-            config.timings[client->reqidx] - config.timings[client->reqidx - 1];
-    }
+namespace {
+// splitmix64 finalizer, which spreads consecutive keys over the hash
+// ring
+uint64_t mix_hash(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+} // namespace
 
-    client->request_timeout_watcher.repeat = duration;
-    ev_timer_again(client->worker->loop, &client->request_timeout_watcher);
+namespace {
+// Returns the index of Config::endpoints for the client numbered
+// |key|.
+uint32_t select_endpoint(uint64_t key) {
+    switch (config.endpoint_policy) {
+    case EndpointPolicy::ROUND_ROBIN:
+        break;
+    case EndpointPolicy::WEIGHTED:
+        return config.endpoint_schedule[key %
+                                        config.endpoint_schedule.size()];
+    case EndpointPolicy::HASH: {
+        auto &ring = config.endpoint_ring;
+        auto it = std::lower_bound(
+            std::begin(ring), std::end(ring),
+            std::make_pair(mix_hash(key), static_cast<uint32_t>(0)));
+        return it == std::end(ring) ? ring.front().second : it->second;
+    }
+    }
+    return key % config.endpoints.size();
 }
 } // namespace
 
 Client::Client(uint32_t id, Worker *worker)
-    : wb(&worker->mcpool), cstat{}, worker(worker), ssl(nullptr),
-      next_addr(config.addrs), current_addr(nullptr), reqidx(0),
-      state(CLIENT_IDLE), req_inflight(0), req_started(0), req_done(0), id(id),
-      fd(-1), new_connection_requested(false), final(false) {
+    : wb(&worker->mcpool), cstat{}, readfn(nullptr), writefn(nullptr),
+      worker(worker), ssl(nullptr),
+      next_addr(nullptr), current_addr(nullptr), reqidx(0),
+      state(CLIENT_IDLE), req_inflight(0), req_started(0), req_done(0),
+      conn_reqs(0), id(id),
+      conn_id(0), uring_conn(nullptr), pool(nullptr), fd(-1), new_connection_requested(false),
+      has_tcp_info(false), attempt_call(0), attempt_hedge(false),
+      slow_reader(false), read_budget(0.),
+      write_pending(false), final(false), tx_bytes(0), write_block_time{}, rx_stamp{},
+      tx_timestamping(false), tls_session_received(false), ktls_tx(false),
+      ktls_rx(false), scenario_step(0), step_left(0), step_failed(false),
+      transaction_active(false), conn_error(CONN_ERROR_NONE),
+      closing(false), reconnect_attempts(0) {
 
     ev_io_init(&wev, writecb, 0, EV_WRITE);
     ev_io_init(&rev, readcb, 0, EV_READ);
@@ -286,8 +868,53 @@ Client::Client(uint32_t id, Worker *worker)
                   worker->config->conn_active_timeout, 0.);
     conn_active_watcher.data = this;
 
-    ev_timer_init(&request_timeout_watcher, client_request_timeout_cb, 0., 0.);
-    request_timeout_watcher.data = this;
+    ev_timer_init(&ping_watcher, ping_timeout_cb, 0.,
+                  worker->config->ping_interval);
+    ping_watcher.data = this;
+
+    ev_timer_init(&churn_watcher, churn_timeout_cb,
+                  worker->config->churn_lifetime, 0.);
+    churn_watcher.data = this;
+
+    ev_timer_init(&read_resume_watcher, read_resume_cb, 0., 0.);
+    read_resume_watcher.data = this;
+
+    reconnect_node.data = this;
+
+    if (worker->config->imbalance) {
+        cstat.rtt_sketch = std::make_unique<Histogram>(CONN_SKETCH_PRECISION);
+    }
+
+    if (worker->config->has_think_time()) {
+        think_nodes.resize(worker->config->scenario.empty()
+                               ? worker->config->max_concurrent_streams
+                               : 1);
+        for (auto &node : think_nodes) {
+            node.data = this;
+            idle_users.push_back(&node);
+        }
+    }
+
+    streams.init(2 * worker->config->max_concurrent_streams, worker->balloc);
+
+    // Number clients across workers, so that the assignment does not
+    // depend on how they are split over workers.  With --ab, each
+    // worker takes the endpoints in turn, so that all of them share
+    // each loop alike.
+    endpoint = select_endpoint(
+        config.ab ? id : static_cast<uint64_t>(id) * config.nthreads +
+                             worker->id);
+    next_addr = config.endpoints[endpoint].addrs;
+    ++worker->endpoint_stats[endpoint].clients;
+
+    if (config.is_slow_read()) {
+        // Spread the slow readers evenly over the clients, numbered as
+        // above.
+        auto n = static_cast<uint64_t>(id) * config.nthreads + worker->id;
+        slow_reader = (n + 1) * config.slow_readers / 100 >
+                      n * config.slow_readers / 100;
+        ++worker->reader_stats[slow_reader].clients;
+    }
 }
 
 Client::~Client() {
@@ -300,32 +927,87 @@ Client::~Client() {
     worker->process_client_stat(&cstat);
 }
 
-int Client::do_read() { return readfn(*this); }
-int Client::do_write() { return writefn(*this); }
+int Client::do_read() { return (this->*readfn)(); }
+int Client::do_write() { return (this->*writefn)(); }
 
 int Client::make_socket(addrinfo *addr) {
     fd = util::create_nonblock_socket(addr->ai_family);
     if (fd == -1) {
         return -1;
     }
+#ifdef SO_BUSY_POLL
+    if (worker->config->busy_poll_usec) {
+        auto val = worker->config->busy_poll_usec;
+        setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &val, sizeof(val));
+    }
+#endif // SO_BUSY_POLL
+    if (worker->config->linger >= 0) {
+        // With 0, close(2) resets the connection, which then skips
+        // TIME_WAIT.
+        linger val{1, worker->config->linger};
+        setsockopt(fd, SOL_SOCKET, SO_LINGER, &val, sizeof(val));
+    }
+    if (!worker->config->tcp_nodelay && addr->ai_family != AF_UNIX) {
+        int val = 0;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &val, sizeof(val));
+    }
+    // Before connect(2), so that TCP scales its window to them.
+    if (worker->config->sndbuf) {
+        auto val = worker->config->sndbuf;
+        setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &val, sizeof(val));
+    }
+    if (auto val = slow_reader && worker->config->slow_rcvbuf
+                       ? worker->config->slow_rcvbuf
+                       : worker->config->rcvbuf) {
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &val, sizeof(val));
+    }
+    if (worker->bind_local(fd, addr->ai_family) != 0) {
+        close(fd);
+        fd = -1;
+        return -1;
+    }
     if (config.scheme == "https") {
         if (!ssl) {
             ssl = SSL_new(worker->ssl_ctx);
+            SSL_set_app_data(ssl, this);
         }
 
         auto config = worker->config;
 
+        if (config->tls_resume) {
+            // A reused |ssl| still holds the session of its last
+            // connection, which must not be resumed unless it is our
+            // turn.
+            SSL_SESSION *sess = nullptr;
+            if (worker->tls_session) {
+                worker->tls_resume_credit += config->tls_resume;
+                if (worker->tls_resume_credit >= 100) {
+                    worker->tls_resume_credit -= 100;
+                    sess = worker->tls_session;
+                }
+            }
+            SSL_set_session(ssl, sess);
+        }
+
         if (!util::numeric_host(config->host.c_str())) {
             SSL_set_tlsext_host_name(ssl, config->host.c_str());
         }
 
         SSL_set_fd(ssl, fd);
         SSL_set_connect_state(ssl);
+    } else {
+#ifdef SO_TIMESTAMPNS
+        // read_clear() takes the time the kernel received the data
+        // from this.
+        int val = 1;
+        setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &val, sizeof(val));
+#endif // SO_TIMESTAMPNS
     }
 
     auto rv = ::connect(fd, addr->ai_addr, addr->ai_addrlen);
 
     if (rv != 0 && errno != EINPROGRESS) {
+        set_conn_error(errno);
         if (ssl) {
             SSL_free(ssl);
             ssl = nullptr;
@@ -345,15 +1027,25 @@ int Client::connect() {
         record_client_start_time();
         clear_connect_times();
         record_connect_start_time();
+        ++worker->conn_stat.attempts;
     } else if (worker->current_phase == Phase::INITIAL_IDLE) {
         worker->current_phase = Phase::WARM_UP;
-        ev_timer_start(worker->loop, &worker->warmup_watcher);
+        if (worker->config->ready) {
+            // Requests made meanwhile are part of the warm-up.
+            ev_timer_start(worker->loop, &worker->ready_watcher);
+            ev_unref(worker->loop);
+        } else {
+            worker->start_warm_up();
+        }
     }
 
     if (worker->config->conn_inactivity_timeout > 0.) {
         ev_timer_again(worker->loop, &conn_inactivity_watcher);
     }
 
+    conn_id = worker->next_conn_id++;
+    closing = false;
+
     if (current_addr) {
         rv = make_socket(current_addr);
         if (rv == -1) {
@@ -393,6 +1085,11 @@ void Client::timeout() {
     process_timedout_streams();
 
     disconnect();
+
+    // Unlike -T, -N closes the connection because it failed.
+    if (conn_error == CONN_ERROR_TIMEOUT) {
+        reconnect_after_failure();
+    }
 }
 
 void Client::restart_timeout() {
@@ -407,7 +1104,7 @@ int Client::try_again_or_fail() {
     if (new_connection_requested) {
         new_connection_requested = false;
 
-        if (total_req_left.load() > 0) {
+        if (!worker->requests_exhausted()) {
             if (worker->current_phase == Phase::MAIN_DURATION) {
                 // At the moment, we don't have a facility to re-start request
                 // already in in-flight.  Make them fail.
@@ -427,22 +1124,173 @@ int Client::try_again_or_fail() {
 
     process_abandoned_streams();
 
-    return -1;
+    return reconnect_after_failure();
 }
 
 void Client::fail() {
     disconnect();
     process_abandoned_streams();
+    reconnect_after_failure();
+}
+
+int Client::reconnect_after_failure() {
+    auto error = conn_error;
+    conn_error = CONN_ERROR_NONE;
+
+    if (closing || worker->current_phase == Phase::DURATION_OVER ||
+        worker->requests_exhausted()) {
+        // The connection just ended.
+        return -1;
+    }
+
+    auto measured = !worker->config->is_timing_based_mode() ||
+                    worker->current_phase == Phase::MAIN_DURATION;
+
+    if (measured) {
+        ++worker->conn_stat
+              .failures[error == CONN_ERROR_NONE ? CONN_ERROR_OTHER : error];
+    }
+
+    if (reconnect_attempts >= worker->config->reconnect_max) {
+        if (reconnect_attempts && measured) {
+            ++worker->conn_stat.gave_up;
+        }
+        return -1;
+    }
+
+    if (reconnect_attempts == 0) {
+        outage_start = std::chrono::steady_clock::now();
+    }
+
+    worker->schedule_reconnect(this, worker->draw_backoff(reconnect_attempts));
+    ++reconnect_attempts;
+
+    return 0;
+}
+
+void Client::on_reconnect_due() {
+    if (worker->current_phase == Phase::DURATION_OVER ||
+        worker->requests_exhausted()) {
+        return;
+    }
+
+    if (!worker->config->is_timing_based_mode() ||
+        worker->current_phase == Phase::MAIN_DURATION) {
+        ++worker->conn_stat.reconnects;
+    }
+
+    // Start over from the first address.
+    current_addr = nullptr;
+    next_addr = config.endpoints[endpoint].addrs;
+
+    if (connect() != 0) {
+        fail();
+    }
+}
+
+void Client::set_conn_error(int err) {
+    switch (err) {
+    case ECONNREFUSED:
+        conn_error = CONN_ERROR_REFUSED;
+        break;
+    case ECONNRESET:
+    case EPIPE:
+        conn_error = CONN_ERROR_RESET;
+        break;
+    case ETIMEDOUT:
+        conn_error = CONN_ERROR_TIMEOUT;
+        break;
+    case 0:
+        conn_error = CONN_ERROR_CLOSED;
+        break;
+    default:
+        conn_error = CONN_ERROR_OTHER;
+        break;
+    }
+}
+
+void Client::set_tls_error(int ssl_err) {
+    switch (ssl_err) {
+    case SSL_ERROR_ZERO_RETURN:
+        conn_error = CONN_ERROR_CLOSED;
+        break;
+    case SSL_ERROR_SYSCALL:
+        // The socket failed under TLS.
+        set_conn_error(errno);
+        break;
+    default:
+        conn_error = CONN_ERROR_TLS;
+        break;
+    }
 }
 
 void Client::disconnect() {
     record_client_end_time();
 
+    if (state == CLIENT_CONNECTED && ev_is_active(&worker->ready_watcher)) {
+        --worker->nconns_ready;
+    }
+
+    // Counts what happened since the last sample.
+    if (config.tcp_info_interval > 0. && state == CLIENT_CONNECTED) {
+        worker->sample_tcp_info(this);
+    }
+    has_tcp_info = false;
+
     ev_timer_stop(worker->loop, &conn_inactivity_watcher);
     ev_timer_stop(worker->loop, &conn_active_watcher);
-    ev_timer_stop(worker->loop, &request_timeout_watcher);
+    ev_timer_stop(worker->loop, &ping_watcher);
+    ev_timer_stop(worker->loop, &churn_watcher);
+    ev_timer_stop(worker->loop, &read_resume_watcher);
+    if (reconnect_node.linked()) {
+        reconnect_node.unlink();
+        --worker->nreconnects;
+    }
+    // The users start over on the next connection.
+    for (auto &node : think_nodes) {
+        if (node.linked()) {
+            node.unlink();
+            idle_users.push_back(&node);
+        }
+    }
+    ping_time = {};
+    conn_reqs = 0;
+    if (config.aimd) {
+        worker->aimd.on_abandon(streams.size());
+    }
+    if (config.decode) {
+        streams.for_each([this](int32_t, Stream &stream) {
+            if (stream.inflater) {
+                worker->put_inflater(stream.inflater);
+            }
+        });
+    }
+    // The users of the calls whose attempts are lost here go on once
+    // the connection is gone.
+    std::vector<Client *> users;
+    if (config.has_calls()) {
+        worker->orphan_calls(this);
+        streams.for_each([this, &users](int32_t stream_id, Stream &stream) {
+            if (!stream.call) {
+                return;
+            }
+            auto origin = worker->end_attempt(stream.call - 1, this,
+                                              stream_id, false, false, false);
+            if (origin) {
+                users.push_back(origin);
+            }
+        });
+    }
     streams.clear();
+    wq.reset();
     session.reset();
+    tx_timestamping = false;
+    tx_unmarked.clear();
+    tx_marks.clear();
+    write_block_time = {};
+    tls_session_received = false;
+    ktls_tx = false;
+    ktls_rx = false;
     state = CLIENT_IDLE;
     ev_io_stop(worker->loop, &wev);
     ev_io_stop(worker->loop, &rev);
@@ -455,6 +1303,10 @@ void Client::disconnect() {
             ssl = nullptr;
         }
     }
+    if (uring_conn) {
+        worker->uring_detach(uring_conn);
+        uring_conn = nullptr;
+    }
     if (fd != -1) {
         shutdown(fd, SHUT_WR);
         close(fd);
@@ -462,44 +1314,120 @@ void Client::disconnect() {
     }
 
     final = false;
+
+    for (auto c : users) {
+        if (!c->closing) {
+            c->on_request_done(c->final, false);
+            c->signal_write();
+        }
+    }
 }
 
 int Client::submit_request() {
+    if (pool) {
+        auto c = pool->select();
+        if (c == nullptr) {
+            return 0;
+        }
+        if (c != this) {
+            auto rv = c->submit_request();
+            c->signal_write();
+            return rv;
+        }
+    }
+
+    if (config.is_sweep_mode() && !worker->sweep_allows(*this)) {
+        // The next cell which lets the client send fills it up.
+        return 0;
+    }
+
+    if (churn_due()) {
+        // The connection is made again once the requests in flight
+        // are answered, and sends the next one then.
+        return 0;
+    }
+
+    if (config.aimd && !worker->aimd.can_send()) {
+        worker->clientsBlockedByLimit.push(this);
+        return 0;
+    }
+
     if (config.is_qps_mode()) {
-        if (worker->qpsLeft == 0) {
-            worker->clientsBlockedDueToQps.push_back(this);
+        if (worker->qpsLeft == 0 && worker->take_qps_quota(1, false) == 0) {
+            worker->clientsBlockedDueToQps.push(this);
+            worker->set_qps_hungry(true);
             return 0;
-        } else {
-            --worker->qpsLeft;
         }
-    } else {
-        if (total_req_left.load() <= 0) {
-            return -1;
+        --worker->qpsLeft;
+        intended_time = worker->pop_qps_due();
+    } else if (config.is_replay_mode()) {
+        if (worker->replay_due.empty()) {
+            if (worker->requests_exhausted()) {
+                return -1;
+            }
+            worker->clientsWaitingForReplay.push(this);
+            return 0;
         }
-        size_t req_left = total_req_left--;
-        if (req_left <= 0) {
-            return -1;
+        auto &due = worker->replay_due.front();
+        intended_time = due.first;
+        worker->replay_tmpl = due.second.tmpl;
+        worker->subst.set_param(due.second.param, due.second.paramlen);
+        worker->replay_due.pop_front();
+        if (worker->requests_exhausted()) {
+            // Nothing else would close the connections waiting for
+            // more.
+            worker->close_replay_clients(this);
         }
+    } else if (!worker->take_request()) {
+        return -1;
     }
-    total_req_send++;
+    ++worker->req_sent;
 
-    if (session && session->submit_request() != 0) {
+    if (session && visit_session(*session, [](auto &s) {
+                       return s.submit_request();
+                   }) != 0) {
         return -1;
     }
+    on_request_submitted();
+
+    return 0;
+}
+
+int Client::submit_attempt(uint32_t idx, bool hedge) {
+    attempt_call = idx + 1;
+    attempt_hedge = hedge;
+    auto rv = visit_session(*session,
+                            [](auto &s) { return s.submit_request(); });
+    attempt_call = 0;
+    if (rv != 0) {
+        return -1;
+    }
+    on_request_submitted();
+    signal_write();
+
+    return 0;
+}
+
+void Client::on_request_submitted() {
+    ++conn_reqs;
 
     if (worker->current_phase != Phase::MAIN_DURATION) {
-        return 0;
+        if (auto side = worker->side_phase()) {
+            ++side->stats.req_started;
+        }
+        return;
     }
 
     ++worker->stats.req_started;
     ++req_started;
-    ++req_inflight;
+    // A oneway request is done as soon as it is queued.
+    if (!config.oneway) {
+        ++req_inflight;
+    }
 
     if (worker->config->conn_active_timeout > 0.) {
         ev_timer_start(worker->loop, &conn_active_watcher);
     }
-
-    return 0;
 }
 
 void Client::process_timedout_streams() {
@@ -507,12 +1435,13 @@ void Client::process_timedout_streams() {
         return;
     }
 
-    for (auto &p : streams) {
-        auto &req_stat = p.second.req_stat;
+    auto now = worker->clock_now();
+    streams.for_each([now](int32_t, Stream &stream) {
+        auto &req_stat = stream.req_stat;
         if (!req_stat.completed) {
-            req_stat.stream_close_time = std::chrono::steady_clock::now();
+            req_stat.stream_close_time = now;
         }
-    }
+    });
 
     worker->stats.req_timedout += req_inflight;
 
@@ -534,7 +1463,7 @@ void Client::process_abandoned_streams() {
 
 void Client::process_request_failure() {
     if (worker->current_phase != Phase::MAIN_DURATION) {
-        ev_break (worker->loop, EVBREAK_ONE);
+        worker->break_loop(EVBREAK_ONE);
         return;
     }
 }
@@ -590,6 +1519,11 @@ void Client::report_tls_info() {
         std::cout << "TLS Protocol: " << tls::get_tls_protocol(ssl) << "\n"
                   << "Cipher: " << SSL_CIPHER_get_name(cipher) << std::endl;
         print_server_tmp_key(ssl);
+        if (config.ktls) {
+            std::cout << "kTLS: send " << (ktls_tx ? "on" : "off")
+                      << ", receive " << (ktls_rx ? "on" : "off")
+                      << std::endl;
+        }
     }
 }
 
@@ -601,25 +1535,99 @@ void Client::report_app_info() {
 }
 
 void Client::terminate_session() {
+    closing = true;
     session->terminate();
     // http1 session needs writecb to tear down session.
     signal_write();
 }
 
-void Client::on_request(int32_t stream_id) { streams[stream_id] = Stream(); }
+size_t Client::next_template(size_t n) {
+    if (attempt_call) {
+        // Hedges and retries send the request of their call again.
+        return worker->calls[attempt_call - 1].tmpl % n;
+    }
+    if (!config.scenario.empty()) {
+        return config.scenario[scenario_step].tmpl % n;
+    }
+    if (config.is_sweep_mode()) {
+        auto tmpl = config.sweep[worker->sweep_cell].tmpl;
+        if (tmpl != SWEEP_ANY_REQUEST) {
+            return tmpl % n;
+        }
+    }
+    if (config.is_replay_mode()) {
+        // The templates of the capture are those of the protocol given
+        // by -p, which TLS may not have negotiated.
+        return worker->replay_tmpl % n;
+    }
+    // So are the weights.
+    if (config.mix.size() == n) {
+        return worker->draw_template();
+    }
+    auto tmpl = reqidx++;
+    if (reqidx == n) {
+        reqidx = 0;
+    }
+    return tmpl;
+}
+
+void Client::on_request(int32_t stream_id, size_t tmpl) {
+    auto stream = streams.emplace(stream_id);
+    stream->req_stat.tmpl = tmpl;
+    if (config.aimd) {
+        stream->req_stat.aimd_seq = worker->aimd.on_send();
+    }
+    if (config.is_qps_mode() || config.is_replay_mode()) {
+        stream->req_stat.intended_time = intended_time;
+    }
+    if (tx_timestamping) {
+        tx_unmarked.push_back(stream_id);
+    }
+    if (config.request_timeout > 0.) {
+        stream->deadline.data = this;
+        stream->deadline.id = stream_id;
+        worker->deadlines.schedule(&stream->deadline);
+    }
+    if (config.has_calls()) {
+        auto idx = attempt_call ? attempt_call - 1
+                                : worker->start_call(this, tmpl);
+        worker->add_attempt(idx, this, stream_id,
+                            attempt_call && attempt_hedge);
+        stream->call = idx + 1;
+    }
+}
+
+void Client::on_oneway_request(size_t tmpl) {
+    if (worker->current_phase != Phase::MAIN_DURATION) {
+        return;
+    }
+    ++worker->stats.req_done;
+    ++worker->stats.req_success;
+    ++worker->stats.req_status_success;
+    ++req_done;
+    ++cstat.req_success;
+
+    auto &ep_stat = worker->endpoint_stats[endpoint];
+    ++ep_stat.req_done;
+    ++ep_stat.req_status_success;
+    if (tmpl < worker->template_stats.size()) {
+        auto &stat = worker->template_stats[tmpl];
+        ++stat.req_done;
+        ++stat.req_status_success;
+    }
+}
 
 void Client::on_header(int32_t stream_id, const uint8_t *name, size_t namelen,
                        const uint8_t *value, size_t valuelen) {
-    auto itr = streams.find(stream_id);
-    if (itr == std::end(streams)) {
+    auto strm = streams.find(stream_id);
+    if (!strm) {
         return;
     }
-    auto &stream = (*itr).second;
+    auto &stream = *strm;
 
-    if (worker->current_phase != Phase::MAIN_DURATION) {
-        // If the stream is for warm-up phase, then mark as a success
-        // But we do not update the count for 2xx, 3xx, etc status codes
-        // Same has been done in on_status_code function
+    // The warm-up and the drain count status codes of their own.
+    auto stats = worker->current_stats();
+    if (!stats) {
         stream.status_success = 1;
         return;
     }
@@ -642,13 +1650,13 @@ void Client::on_header(int32_t stream_id, const uint8_t *name, size_t namelen,
 
         stream.req_stat.status = status;
         if (status >= 200 && status < 300) {
-            ++worker->stats.status[2];
+            ++stats->status[2];
             stream.status_success = 1;
         } else if (status < 400) {
-            ++worker->stats.status[3];
+            ++stats->status[3];
             stream.status_success = 1;
         } else if (status < 600) {
-            ++worker->stats.status[status / 100];
+            ++stats->status[status / 100];
             stream.status_success = 0;
         } else {
             stream.status_success = 0;
@@ -656,27 +1664,80 @@ void Client::on_header(int32_t stream_id, const uint8_t *name, size_t namelen,
     }
 }
 
+void Client::on_response_bytes(int32_t stream_id, size_t wire,
+                               size_t header, size_t classname,
+                               size_t content) {
+    auto stream = streams.find(stream_id);
+    if (!stream) {
+        return;
+    }
+    auto &req_stat = stream->req_stat;
+    req_stat.resp_bytes += wire;
+    req_stat.resp_header_bytes += header;
+    req_stat.resp_class_bytes += classname;
+    req_stat.resp_content_bytes += content;
+}
+
+void Client::on_content_encoding(int32_t stream_id, const uint8_t *value,
+                                 size_t len) {
+    auto stream = streams.find(stream_id);
+    if (!stream) {
+        return;
+    }
+    stream->coding = parse_content_coding(value, len);
+}
+
+void Client::on_body(int32_t stream_id, const uint8_t *data, size_t len) {
+    auto stream = streams.find(stream_id);
+    if (!stream) {
+        return;
+    }
+    stream->body_bytes += len;
+    if (!config.decode || !data || stream->decode_error ||
+        (stream->coding != CODING_GZIP && stream->coding != CODING_DEFLATE)) {
+        return;
+    }
+    if (!stream->inflater) {
+        stream->inflater = worker->get_inflater();
+        if (!stream->inflater) {
+            stream->decode_error = true;
+            return;
+        }
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto rv = stream->inflater->feed(data, len, worker->decode_buf,
+                                     stream->decoded_bytes);
+    stream->decode_time +=
+        to_latency(std::chrono::steady_clock::now() - start);
+    if (rv != 0) {
+        stream->decode_error = true;
+    }
+}
+
 void Client::on_status_code(int32_t stream_id, uint16_t status) {
-    auto itr = streams.find(stream_id);
-    if (itr == std::end(streams)) {
+    auto strm = streams.find(stream_id);
+    if (!strm) {
         return;
     }
-    auto &stream = (*itr).second;
+    auto &stream = *strm;
 
-    if (worker->current_phase != Phase::MAIN_DURATION) {
+    // --aimd looks at the status in all phases.
+    stream.req_stat.status = status;
+
+    auto stats = worker->current_stats();
+    if (!stats) {
         stream.status_success = 1;
         return;
     }
 
-    stream.req_stat.status = status;
     if (status >= 200 && status < 300) {
-        ++worker->stats.status[2];
+        ++stats->status[2];
         stream.status_success = 1;
     } else if (status < 400) {
-        ++worker->stats.status[3];
+        ++stats->status[3];
         stream.status_success = 1;
     } else if (status < 600) {
-        ++worker->stats.status[status / 100];
+        ++stats->status[status / 100];
         stream.status_success = 0;
     } else {
         stream.status_success = 0;
@@ -684,92 +1745,687 @@ void Client::on_status_code(int32_t stream_id, uint16_t status) {
 }
 
 void Client::on_sofarpc_status(int32_t stream_id, uint16_t status) {
-    auto itr = streams.find(stream_id);
-    if (itr == std::end(streams)) {
+    auto strm = streams.find(stream_id);
+    if (!strm) {
         return;
     }
-    auto &stream = (*itr).second;
+    auto &stream = *strm;
 
-    if (worker->current_phase != Phase::MAIN_DURATION) {
+    // --aimd looks at the status in all phases.
+    stream.req_stat.status = status;
+
+    auto stats = worker->current_stats();
+    if (!stats) {
         stream.status_success = 1;
         return;
     }
 
-    stream.req_stat.status = status;
     stream.status_success = (status == RESPONSE_STATUS_SUCCESS);
 
-    ++worker->stats.sofarpcStatus[status];
+    ++stats->sofarpcStatus[status];
 }
 
-void Client::on_stream_close(int32_t stream_id, bool success, bool final) {
+void Client::on_grpc_status(int32_t stream_id, const uint8_t *value,
+                            size_t len) {
+    auto stream = streams.find(stream_id);
+    if (!stream) {
+        return;
+    }
+    stream->grpc_status = parse_grpc_status(value, len);
+}
+
+void Client::on_request_deadline(int32_t stream_id) {
+    auto stream = streams.find(stream_id);
+    if (!stream) {
+        return;
+    }
+    auto &req_stat = stream->req_stat;
+
+    req_stat.timedout = true;
+    if (worker->current_phase == Phase::MAIN_DURATION &&
+        recorded(req_stat.request_time)) {
+        worker->timeout_hist.record(to_latency(
+            std::chrono::steady_clock::now() - req_stat.request_time));
+    }
+
+    if (session->cancel_stream(stream_id) == 0) {
+        signal_write();
+        return;
+    }
+
+    // The connection goes, and the requests behind this one with it.
+    process_timedout_streams();
+    try_new_connection();
+    if (try_again_or_fail() != 0) {
+        worker->free_client(this);
+    }
+}
+
+bool Client::churn_due() const {
+    return config.churn_requests && conn_reqs >= config.churn_requests;
+}
+
+void Client::on_churn_timeout() {
+    if (worker->requests_exhausted()) {
+        // The connection is closed once the requests in flight are
+        // answered anyway.
+        return;
+    }
+
     if (worker->current_phase == Phase::MAIN_DURATION) {
-        if (req_inflight > 0) {
-            --req_inflight;
-        }
-        auto req_stat = get_req_stat(stream_id);
-        if (!req_stat) {
-            return;
+        ++worker->stats.churn_closes;
+        worker->stats.churn_lost += req_inflight;
+    }
+
+    // The requests in flight fail with the connection.
+    try_new_connection();
+    if (try_again_or_fail() != 0) {
+        worker->free_client(this);
+    }
+}
+
+void Client::start_transaction() {
+    if (transaction_active &&
+        worker->current_phase == Phase::MAIN_DURATION) {
+        // The connection was lost in the middle of it.
+        ++worker->transaction_stat.done;
+        ++worker->transaction_stat.failed;
+    }
+    transaction_active = true;
+    transaction_start = std::chrono::steady_clock::now();
+    scenario_step = 0;
+    start_step();
+}
+
+void Client::start_step() {
+    step_start = std::chrono::steady_clock::now();
+    step_left = 0;
+    step_failed = false;
+    auto &step = config.scenario[scenario_step];
+    for (size_t i = 0; i < step.count; ++i) {
+        if (submit_request() != 0) {
+            process_request_failure();
+            break;
         }
+        ++step_left;
+    }
+    if (step_left == 0) {
+        // The requests are exhausted.
+        transaction_active = false;
+    }
+}
 
-        req_stat->stream_close_time = std::chrono::steady_clock::now();
-        if (success) {
-            req_stat->completed = true;
-            ++worker->stats.req_success;
-            ++cstat.req_success;
+void Client::on_step_request_done(bool ok) {
+    if (!ok) {
+        step_failed = true;
+    }
+    if (step_left == 0 || --step_left > 0) {
+        return;
+    }
 
-            if (streams[stream_id].status_success == 1) {
-                ++worker->stats.req_status_success;
+    auto now = std::chrono::steady_clock::now();
+    auto &step = config.scenario[scenario_step];
+    auto measured = worker->current_phase == Phase::MAIN_DURATION;
+    if (measured) {
+        auto &stat = worker->step_stats[scenario_step];
+        ++stat.done;
+        if (step_failed) {
+            ++stat.failed;
+        } else {
+            stat.hist.record(to_latency(now - step_start));
+        }
+    }
+
+    // The steps after a failed one depend on it, so that the
+    // transaction fails, and another one starts.
+    if (step_failed || scenario_step + 1 == config.scenario.size()) {
+        if (measured) {
+            auto &stat = worker->transaction_stat;
+            ++stat.done;
+            if (step_failed) {
+                ++stat.failed;
             } else {
-                ++worker->stats.req_failed;
+                stat.hist.record(to_latency(now - transaction_start));
             }
+        }
+        transaction_active = false;
+    } else {
+        ++scenario_step;
+    }
 
-            worker->process_req_stat(req_stat);
+    if (step.think > 0.) {
+        start_think(step.think);
+        return;
+    }
+
+    next_step();
+}
+
+void Client::next_step() {
+    if (!worker->requests_exhausted()) {
+        if (transaction_active) {
+            start_step();
         } else {
-            ++worker->stats.req_failed;
-            ++worker->stats.req_error;
+            start_transaction();
         }
-        ++worker->stats.req_done;
-        ++req_done;
+    }
 
-        uint64_t rtt =
-            std::chrono::duration_cast<std::chrono::duration<double>>(
-                req_stat->stream_close_time - req_stat->request_time)
-                .count() *
-            1000000;
-        worker->record_rtt(rtt);
+    if (streams.empty() && worker->requests_exhausted()) {
+        // Nothing would close this connection otherwise.
+        terminate_session();
+        return;
     }
 
-    streams.erase(stream_id);
+    signal_write();
+}
 
-    if (total_req_left.load() <= 0) {
-        terminate_session();
+void Client::start_think(double t) {
+    if (idle_users.empty()) {
+        // Unreachable, since a user only thinks after its request.
+        return;
+    }
+    auto node = idle_users.back();
+    idle_users.pop_back();
+    worker->thinks.schedule_after(node, t);
+}
+
+void Client::on_think_over(DeadlineNode *node) {
+    idle_users.push_back(node);
+
+    if (!config.scenario.empty()) {
+        next_step();
         return;
     }
 
-    if (!final) {
+    if (!worker->requests_exhausted()) {
         if (submit_request() != 0) {
             process_request_failure();
         }
     }
-}
 
-RequestStat *Client::get_req_stat(int32_t stream_id) {
-    auto it = streams.find(stream_id);
-    if (it == std::end(streams)) {
-        return nullptr;
+    if (streams.empty() && worker->requests_exhausted()) {
+        // Nothing would close this connection otherwise.
+        terminate_session();
+        return;
     }
 
-    return &(*it).second.req_stat;
+    signal_write();
 }
 
-int Client::connection_made() {
-    if (ssl) {
-        report_tls_info();
+uint32_t Client::on_stream_message(int32_t stream_id) {
+    auto strm = streams.find(stream_id);
+    if (!strm) {
+        return 0;
+    }
+    auto &stream = *strm;
 
-        const unsigned char *next_proto = nullptr;
-        unsigned int next_proto_len;
+    auto now = std::chrono::steady_clock::now();
+    if (worker->current_phase == Phase::MAIN_DURATION) {
+        ++worker->stats.stream_messages;
+        if (stream.messages == 0) {
+            worker->first_message_hist.record(
+                to_latency(now - stream.req_stat.request_time));
+        } else {
+            worker->message_gap_hist.record(
+                to_latency(now - stream.message_time));
+        }
+    }
+    stream.message_time = now;
 
-#ifndef OPENSSL_NO_NEXTPROTONEG
+    return ++stream.messages;
+}
+
+namespace {
+// Records the request on |stream|, which took |rtt| nanoseconds, to
+// |stat| of its request template.
+void record_template_stat(TemplateStat &stat, const Stream &stream,
+                          bool success, uint64_t rtt) {
+    ++stat.req_done;
+    if (success && stream.status_success == 1) {
+        ++stat.req_status_success;
+    }
+    stat.rtt_hist.record(rtt);
+    if (stream.status_success == -1) {
+        return;
+    }
+    auto status = stream.req_stat.status;
+    if (config.no_tls_proto == Config::PROTO_SOFARPC) {
+        if (static_cast<size_t>(status) < stat.sofarpcStatus.size()) {
+            ++stat.sofarpcStatus[status];
+        }
+    } else if (status >= 200 && status < 600) {
+        ++stat.status[status / 100];
+    }
+}
+} // namespace
+
+namespace {
+// Returns true if the server pushed back on the request on |stream|,
+// which closed with |success|, by refusing it for overload, timing it
+// out, or not answering it at all.
+bool is_overload(const Stream &stream, bool success) {
+    auto status = stream.req_stat.status;
+    if (config.no_tls_proto == Config::PROTO_SOFARPC) {
+        return !success && (stream.status_success == -1 ||
+                            status == RESPONSE_STATUS_SERVER_THREADPOOL_BUSY ||
+                            status == RESPONSE_STATUS_TIMEOUT);
+    }
+    if (config.grpc && success &&
+        (stream.grpc_status == 8 || stream.grpc_status == 14)) {
+        // RESOURCE_EXHAUSTED and UNAVAILABLE
+        return true;
+    }
+    return !success || status == 429 || status == 503;
+}
+} // namespace
+
+void Client::on_stream_close(int32_t stream_id, bool success, bool final) {
+    if (config.grpc && success) {
+        // A call fails unless its trailers say OK, even if the HTTP
+        // status does.
+        if (auto stream = streams.find(stream_id)) {
+            if (auto stats = worker->current_stats()) {
+                ++stats->grpcStatus[stream->grpc_status];
+                if (stream->grpc_status != 0) {
+                    stream->status_success = 0;
+                }
+            }
+        }
+    }
+
+    if (config.aimd) {
+        if (auto stream = streams.find(stream_id)) {
+            worker->aimd.on_done(stream->req_stat.aimd_seq,
+                                 is_overload(*stream, success));
+            if (worker->current_phase == Phase::MAIN_DURATION) {
+                worker->aimd_limit_sum += worker->aimd.value();
+                ++worker->aimd_samples;
+            }
+        }
+    }
+
+    if (worker->current_phase == Phase::MAIN_DURATION) {
+        if (req_inflight > 0) {
+            --req_inflight;
+        }
+        auto stream = streams.find(stream_id);
+        if (!stream) {
+            return;
+        }
+        auto req_stat = &stream->req_stat;
+
+        req_stat->stream_close_time = worker->clock_now();
+        if (success) {
+            req_stat->completed = true;
+            ++worker->stats.req_success;
+            ++cstat.req_success;
+
+            if (stream->status_success == 1) {
+                ++worker->stats.req_status_success;
+            } else {
+                ++worker->stats.req_failed;
+            }
+
+            worker->process_req_stat(req_stat);
+        }
+        if (worker->config->is_dynamic_qps()) {
+            worker->process_phase_stat(req_stat,
+                                       success && stream->status_success == 1);
+        }
+        if (worker->config->is_sweep_mode()) {
+            worker->process_sweep_stat(req_stat,
+                                       success && stream->status_success == 1);
+        }
+        if (!success) {
+            ++worker->stats.req_failed;
+            ++worker->stats.req_error;
+        }
+        if (req_stat->timedout) {
+            ++worker->stats.req_timedout;
+        }
+        ++worker->stats.req_done;
+        ++req_done;
+
+        auto rtt =
+            to_latency(req_stat->stream_close_time - req_stat->request_time);
+        // Timed out requests have a latency of their own, in
+        // Worker::timeout_hist.
+        if (!req_stat->timedout) {
+            worker->record_rtt(rtt);
+        }
+        if (config.response_sizes && success) {
+            worker->record_response_size(*req_stat, rtt);
+        }
+        if (config.count_codings() && success) {
+            worker->record_decode(*stream);
+        }
+        auto &ep_stat = worker->endpoint_stats[endpoint];
+        ++ep_stat.req_done;
+        if (success && stream->status_success == 1) {
+            ++ep_stat.req_status_success;
+        }
+        ep_stat.rtt_hist.record(rtt);
+        if (!worker->reader_stats.empty()) {
+            auto &reader_stat = worker->reader_stats[slow_reader];
+            ++reader_stat.req_done;
+            if (success && stream->status_success == 1) {
+                ++reader_stat.req_status_success;
+            }
+            reader_stat.rtt_hist.record(rtt);
+        }
+        if (cstat.rtt_sketch) {
+            if (!success || stream->status_success != 1) {
+                ++cstat.req_failed;
+            }
+            cstat.rtt_sum += rtt;
+            cstat.rtt_sketch->record(rtt);
+        }
+        if (req_stat->tmpl < worker->template_stats.size()) {
+            record_template_stat(worker->template_stats[req_stat->tmpl],
+                                 *stream, success, rtt);
+        }
+        if (success && req_stat->tx_stamp.ns && rx_stamp.ns &&
+            req_stat->tx_stamp.hw == rx_stamp.hw &&
+            rx_stamp.ns > req_stat->tx_stamp.ns) {
+            worker->record_wire_rtt(rx_stamp.ns - req_stat->tx_stamp.ns, rtt);
+        }
+        worker->record_slow_request(
+            rtt, this, stream_id, *req_stat,
+            stream->status_success == -1 ? -1 : req_stat->status);
+        if (worker->trace) {
+            trace_request(stream_id, *stream, rtt);
+        }
+        if (worker->reqlog_queue) {
+            log_request(stream_id, *stream, rtt);
+        }
+
+        if (recorded(req_stat->intended_time) && !req_stat->timedout) {
+            worker->record_corrected_rtt(to_latency(
+                req_stat->stream_close_time - req_stat->intended_time));
+        }
+    } else if (auto side = worker->side_phase()) {
+        if (auto stream = streams.find(stream_id)) {
+            auto &stats = side->stats;
+            auto ok = success && stream->status_success == 1;
+            auto rtt = to_latency(std::chrono::steady_clock::now() -
+                                  stream->req_stat.request_time);
+            if (success) {
+                ++stats.req_success;
+                if (ok) {
+                    ++stats.req_status_success;
+                } else {
+                    ++stats.req_failed;
+                }
+            } else {
+                ++stats.req_failed;
+                ++stats.req_error;
+            }
+            if (stream->req_stat.timedout) {
+                ++stats.req_timedout;
+            }
+            ++stats.req_done;
+            if (!stream->req_stat.timedout) {
+                side->rtt_hist.record(rtt);
+            }
+
+            if (worker->current_phase == Phase::WARM_UP &&
+                config.warm_up_auto > 0.) {
+                auto &stat = worker->warmup_stat;
+                ++stat.req_done;
+                if (ok) {
+                    ++stat.req_status_success;
+                    stat.rtt_hist.record(rtt);
+                }
+            }
+        }
+    }
+
+    auto step_ok = false;
+    if (!config.scenario.empty()) {
+        if (auto stream = streams.find(stream_id)) {
+            step_ok = success && stream->status_success == 1;
+        }
+    }
+
+    // The call the request is an attempt of, and how it went
+    uint32_t call = 0;
+    auto call_ok = false;
+    auto overload = false;
+    if (config.has_calls()) {
+        if (auto stream = streams.find(stream_id)) {
+            call = stream->call;
+            call_ok = success && stream->status_success == 1;
+            overload = is_overload(*stream, success);
+        }
+    }
+
+    if (config.decode) {
+        auto stream = streams.find(stream_id);
+        if (stream && stream->inflater) {
+            worker->put_inflater(stream->inflater);
+        }
+    }
+
+    streams.erase(stream_id);
+
+    if (config.aimd) {
+        worker->release_limited_clients();
+    }
+
+    if (config.handshake_bench == HandshakeBench::REQUEST) {
+        // The connection is done with its request.
+        if (streams.empty()) {
+            try_new_connection();
+            terminate_session();
+        }
+        return;
+    }
+
+    if (call) {
+        auto origin =
+            worker->end_attempt(call - 1, this, stream_id, call_ok, overload,
+                                true);
+        if (origin != this) {
+            // No user goes on here, but the connection may be done.
+            on_request_done(true, false);
+            if (origin && !origin->closing) {
+                origin->on_request_done(origin->final, false);
+                origin->signal_write();
+            }
+            return;
+        }
+    }
+
+    on_request_done(final, step_ok);
+}
+
+void Client::on_request_done(bool final, bool step_ok) {
+    if (worker->requests_exhausted()) {
+        // Let the responses for the requests still in flight on this
+        // connection arrive before tearing it down.
+        if (streams.empty()) {
+            terminate_session();
+        }
+        if (pool) {
+            // The other connections may have nothing in flight, and
+            // nothing else would close them.
+            pool->terminate_idle();
+        }
+        return;
+    }
+
+    if (churn_due()) {
+        // The connection is done with its --churn-requests.
+        if (streams.empty()) {
+            if (worker->current_phase == Phase::MAIN_DURATION) {
+                ++worker->stats.churn_closes;
+            }
+            try_new_connection();
+            terminate_session();
+        }
+        if (!pool) {
+            return;
+        }
+    }
+
+    if (!config.scenario.empty()) {
+        // A final connection is made again, and starts another
+        // transaction.
+        if (!final) {
+            on_step_request_done(step_ok);
+        }
+        return;
+    }
+
+    if (config.think_model != ThinkModel::NONE) {
+        // The user of the request thinks before its next one.
+        if (!final || pool) {
+            start_think(worker->draw_think_time(false));
+        }
+        return;
+    }
+
+    // The pool sends the next request on another connection if this
+    // one is final.
+    if (!final || pool) {
+        if (submit_request() != 0) {
+            process_request_failure();
+        }
+    }
+}
+
+void Client::fill_streams() {
+    // A --scenario step sends a fixed number of requests, and users
+    // with --think-time send theirs when they are done thinking.
+    if (config.handshake_bench != HandshakeBench::NONE ||
+        !config.scenario.empty() ||
+        config.think_model != ThinkModel::NONE ||
+        worker->requests_exhausted()) {
+        return;
+    }
+
+    auto n = session->max_concurrent_streams();
+    for (auto i = streams.size(); i < n; ++i) {
+        if (submit_request() != 0) {
+            process_request_failure();
+            break;
+        }
+    }
+
+    signal_write();
+}
+
+Client *ClientPool::select() const {
+    Client *best = nullptr;
+    size_t inflight = 0;
+    for (auto c : conns) {
+        inflight += c->streams.size();
+        if (c->state != CLIENT_CONNECTED || !c->session || c->final ||
+            c->churn_due() ||
+            c->streams.size() >= visit_session(*c->session, [](auto &s) {
+                return s.max_concurrent_streams();
+            })) {
+            continue;
+        }
+        if (best == nullptr || c->streams.size() < best->streams.size()) {
+            best = c;
+        }
+    }
+    if (inflight >= static_cast<size_t>(config.max_concurrent_streams)) {
+        return nullptr;
+    }
+    return best;
+}
+
+void ClientPool::terminate_idle() {
+    for (auto c : conns) {
+        if (c->state == CLIENT_CONNECTED && c->session && c->streams.empty()) {
+            c->terminate_session();
+        }
+    }
+}
+
+void Client::trace_request(int32_t stream_id, const Stream &stream,
+                           uint64_t rtt_in_ns) {
+    auto &req_stat = stream.req_stat;
+    TraceRecord rec{};
+    rec.send_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        req_stat.request_wall_time.time_since_epoch())
+                        .count();
+    rec.rtt = rtt_in_ns;
+    if (recorded(req_stat.intended_time)) {
+        rec.send_delay =
+            to_latency(req_stat.request_time - req_stat.intended_time);
+    }
+    rec.conn_id = conn_id;
+    rec.stream_id = stream_id;
+    rec.status = stream.status_success == -1 ? -1 : req_stat.status;
+    if (req_stat.completed) {
+        rec.flags |= TRACE_FLAG_COMPLETED;
+    }
+    if (stream.status_success == 1) {
+        rec.flags |= TRACE_FLAG_STATUS_SUCCESS;
+    }
+    worker->trace->write(rec);
+}
+
+void Client::log_request(int32_t stream_id, const Stream &stream,
+                         uint64_t rtt_in_ns) {
+    auto config = worker->config;
+    auto &req_stat = stream.req_stat;
+    auto failed = !req_stat.completed || stream.status_success != 1;
+    auto sampled = config->request_log_sample &&
+                   worker->reqlog_seq++ % config->request_log_sample == 0;
+    if (!sampled && !(config->request_log_failures && failed) &&
+        !(config->request_log_slow > 0. &&
+          rtt_in_ns >= config->request_log_slow * 1e9)) {
+        return;
+    }
+
+    ReqLogRecord rec{};
+    rec.send_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        req_stat.request_wall_time.time_since_epoch())
+                        .count();
+    rec.rtt = rtt_in_ns;
+    rec.worker_id = worker->id;
+    rec.conn_id = conn_id;
+    rec.stream_id = stream_id;
+    rec.tmpl = req_stat.tmpl;
+    rec.status = stream.status_success == -1 ? -1 : req_stat.status;
+    rec.completed = req_stat.completed;
+    rec.status_success = stream.status_success == 1;
+    rec.timedout = req_stat.timedout;
+    if (session && session->kind == SessionKind::SOFARPC) {
+        // The stream closes while its response header is the last one
+        // read, unless it was reset.
+        auto sofarpc = static_cast<SofaRpcSession *>(session.get());
+        if (req_stat.completed && sofarpc->last_stream_id_ == stream_id) {
+            rec.has_bolt = true;
+            rec.bolt = sofarpc->last_header_;
+        }
+    }
+    if (!worker->reqlog_queue->push(rec)) {
+        ++worker->reqlog_dropped;
+    }
+}
+
+RequestStat *Client::get_req_stat(int32_t stream_id) {
+    auto stream = streams.find(stream_id);
+    if (!stream) {
+        return nullptr;
+    }
+
+    return &stream->req_stat;
+}
+
+int Client::connection_made() {
+    if (ssl) {
+        report_tls_info();
+
+        const unsigned char *next_proto = nullptr;
+        unsigned int next_proto_len;
+
+#ifndef OPENSSL_NO_NEXTPROTONEG
         SSL_get0_next_proto_negotiated(ssl, &next_proto, &next_proto_len);
 #endif // !OPENSSL_NO_NEXTPROTONEG
 #if OPENSSL_VERSION_NUMBER >= 0x10002000L
@@ -822,6 +2478,13 @@ int Client::connection_made() {
             disconnect();
             return -1;
         }
+
+        if (config.grpc && session->kind != SessionKind::HTTP2) {
+            std::cerr << "--grpc: " << selected_proto
+                      << " was negotiated, but gRPC needs h2" << std::endl;
+            disconnect();
+            return -1;
+        }
     } else {
         switch (config.no_tls_proto) {
         case Config::PROTO_HTTP2:
@@ -846,81 +2509,286 @@ int Client::connection_made() {
 
     state = CLIENT_CONNECTED;
 
+    if (ev_is_active(&worker->ready_watcher)) {
+        worker->on_conn_ready();
+    }
+
+    conn_error = CONN_ERROR_NONE;
+    if (reconnect_attempts) {
+        if (!worker->config->is_timing_based_mode() ||
+            worker->current_phase == Phase::MAIN_DURATION) {
+            worker->conn_stat.recovery.record(
+                to_latency(std::chrono::steady_clock::now() - outage_start));
+        }
+        reconnect_attempts = 0;
+    }
+
+    if (config.handshake_bench == HandshakeBench::HANDSHAKE) {
+        record_connect_time();
+        on_handshake_done();
+#ifdef TLS1_3_VERSION
+        if (ssl && config.tls_resume && !tls_session_received &&
+            SSL_version(ssl) >= TLS1_3_VERSION) {
+            // TLS 1.3 sends sessions in tickets after the handshake,
+            // and a ticket is used only once, so that the next
+            // connections need the ticket of this one.  Read until it
+            // arrives, and send nothing meanwhile.
+            session.reset();
+            return 0;
+        }
+#endif // TLS1_3_VERSION
+        // Returning an error closes the connection, and connects again
+        // unless the requests are exhausted.
+        try_new_connection();
+        return -1;
+    }
+
     session->on_connect();
 
     record_connect_time();
 
-    auto nreq = session->max_concurrent_streams();
-    for (; nreq > 0; --nreq) {
-        if (submit_request() != 0) {
-            process_request_failure();
-            break;
+    if (config.ping_interval > 0.) {
+        ev_timer_again(worker->loop, &ping_watcher);
+    }
+
+    if (config.churn_lifetime > 0.) {
+        // Stopping the timer leaves the time it had left in it.
+        ev_timer_set(&churn_watcher, config.churn_lifetime, 0.);
+        ev_timer_start(worker->loop, &churn_watcher);
+    }
+
+    if (!config.scenario.empty()) {
+        start_transaction();
+    } else if (config.think_model != ThinkModel::NONE) {
+        for (auto n = idle_users.size(); n > 0; --n) {
+            start_think(worker->draw_think_time(true));
+        }
+    } else {
+        auto nreq = config.handshake_bench == HandshakeBench::REQUEST
+                        ? 1
+                        : session->max_concurrent_streams();
+        for (; nreq > 0; --nreq) {
+            if (submit_request() != 0) {
+                process_request_failure();
+                break;
+            }
         }
     }
 
+    if (streams.empty() && worker->requests_exhausted()) {
+        // Other clients took all requests.  Nothing would close this
+        // connection otherwise.
+        terminate_session();
+    }
+
     signal_write();
 
     return 0;
 }
 
 int Client::on_read(const uint8_t *data, size_t len) {
-    auto rv = session->on_read(data, len);
+    auto rv = visit_session(
+        *session, [data, len](auto &s) { return s.on_read(data, len); });
     if (rv != 0) {
         return -1;
     }
     if (worker->current_phase == Phase::MAIN_DURATION) {
         worker->stats.bytes_total += len;
+        if (!worker->reader_stats.empty()) {
+            worker->reader_stats[slow_reader].bytes += len;
+        }
+    } else if (auto side = worker->side_phase()) {
+        side->stats.bytes_total += len;
     }
     signal_write();
     return 0;
 }
 
 int Client::on_write() {
-    if (wb.rleft() >= BACKOFF_WRITE_BUFFER_THRES) {
+    if (wb.rleft() + wq.rleft() >= BACKOFF_WRITE_BUFFER_THRES) {
         return 0;
     }
 
-    if (session && session->on_write() != 0) {
+    if (session &&
+        visit_session(*session, [](auto &s) { return s.on_write(); }) != 0) {
         return -1;
     }
     return 0;
 }
 
+namespace {
+// Returns the type of the TLS record read into |msg| from a kTLS
+// socket.
+uint8_t ktls_record_type(msghdr &msg) {
+#ifdef TLS_GET_RECORD_TYPE
+    for (auto cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_TLS &&
+            cmsg->cmsg_type == TLS_GET_RECORD_TYPE) {
+            return *CMSG_DATA(cmsg);
+        }
+    }
+#endif // TLS_GET_RECORD_TYPE
+    return SSL3_RT_APPLICATION_DATA;
+}
+} // namespace
+
 int Client::read_clear() {
-    uint8_t buf[8_k];
+    std::array<struct iovec, MAX_READ_CHUNKS> iov;
+    // Room for SCM_TIMESTAMPNS, SCM_TIMESTAMPING and
+    // TLS_GET_RECORD_TYPE
+    alignas(cmsghdr) uint8_t
+        cmsgbuf[CMSG_SPACE(sizeof(timespec)) +
+                CMSG_SPACE(3 * sizeof(timespec)) + CMSG_SPACE(sizeof(uint8_t))];
+
+    if (tx_timestamping) {
+        // The kernel tells that the error queue has something with
+        // POLLERR, which also makes the fd readable.
+        read_tx_timestamps();
+    }
 
     for (;;) {
+        auto allowance = read_allowance();
+        if (allowance == 0) {
+            return 0;
+        }
+
+        auto iovcnt = worker->read_iovec(iov.data());
+        auto buflen = iovcnt * worker->mcpool.chunk_size;
+        if (allowance < buflen) {
+            auto chunk_size = worker->mcpool.chunk_size;
+            iovcnt = (allowance + chunk_size - 1) / chunk_size;
+            iov[iovcnt - 1].iov_len = allowance - (iovcnt - 1) * chunk_size;
+            buflen = allowance;
+        }
+
+        msghdr msg{};
+        msg.msg_iov = iov.data();
+        msg.msg_iovlen = iovcnt;
+        msg.msg_control = cmsgbuf;
+        msg.msg_controllen = sizeof(cmsgbuf);
+
         ssize_t nread;
-        while ((nread = read(fd, buf, sizeof(buf))) == -1 && errno == EINTR)
+        while ((nread = recvmsg(fd, &msg, 0)) == -1 && errno == EINTR)
             ;
         if (nread == -1) {
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
                 return 0;
             }
+            set_conn_error(errno);
             return -1;
         }
 
         if (nread == 0) {
+            set_conn_error(0);
             return -1;
         }
 
-        if (on_read(buf, nread) != 0) {
+        if (ktls_rx && ktls_record_type(msg) != SSL3_RT_APPLICATION_DATA) {
+            // The kernel gives a record other than application data
+            // alone.  A session ticket is of no use here, and we
+            // cannot follow key updates or alerts.
+            if (ktls_record_type(msg) == SSL3_RT_HANDSHAKE &&
+                worker->read_chunks[0]->begin[0] ==
+                    SSL3_MT_NEWSESSION_TICKET) {
+                continue;
+            }
             return -1;
         }
+
+        worker->update_read_size(nread);
+        rx_stamp = worker->record_rx_timestamp(msg);
+        read_budget -= nread;
+
+        for (size_t left = nread, i = 0; left; ++i) {
+            auto n = std::min(left, worker->mcpool.chunk_size);
+            if (on_read(worker->read_chunks[i]->begin, n) != 0) {
+                return -1;
+            }
+            left -= n;
+        }
+
+        // A short read drained the socket.  Reading again would just
+        // fail with EAGAIN, and the loop tells when more data arrives.
+        if (static_cast<size_t>(nread) < buflen) {
+            return 0;
+        }
+    }
+
+    return 0;
+}
+
+size_t Client::read_allowance() {
+    if (!slow_reader) {
+        return std::numeric_limits<size_t>::max();
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    auto &config = *worker->config;
+    double wait = 0.;
+
+    if (config.slow_read_pause > 0.) {
+        // Reads stop for the last |slow_read_pause| seconds of each
+        // period.
+        auto phase = std::fmod(
+            std::chrono::duration<double>(now - read_epoch).count(),
+            config.slow_read_period);
+        if (phase >= config.slow_read_period - config.slow_read_pause) {
+            wait = config.slow_read_period - phase;
+        }
+    }
+
+    if (wait == 0. && config.slow_read_rate) {
+        // The rate is spread in 10ms slices, so that the reads are
+        // neither tiny nor bursty.
+        auto rate = static_cast<double>(config.slow_read_rate);
+        auto slice = std::max(1., rate * 0.01);
+        read_budget = std::min(
+            slice,
+            read_budget +
+                rate * std::chrono::duration<double>(now - read_refill).count());
+        read_refill = now;
+        if (read_budget >= slice) {
+            return static_cast<size_t>(read_budget);
+        }
+        wait = (slice - read_budget) / rate;
+    }
+
+    if (wait == 0.) {
+        return std::numeric_limits<size_t>::max();
     }
 
+    // The socket stays unread, and the server's writes back up.
+    ev_io_stop(worker->loop, &rev);
+    ev_timer_stop(worker->loop, &read_resume_watcher);
+    ev_timer_set(&read_resume_watcher, wait, 0.);
+    ev_timer_start(worker->loop, &read_resume_watcher);
     return 0;
 }
 
 int Client::write_clear() {
-    std::array<struct iovec, 2> iov;
+    std::array<struct iovec, MAX_WR_IOVCNT> iov;
 
     for (;;) {
         if (on_write() != 0) {
             return -1;
         }
 
-        auto iovcnt = wb.riovec(iov.data(), iov.size());
+        if (!tx_unmarked.empty()) {
+            // The requests submitted so far end somewhere in what is
+            // queued now.
+            auto end = tx_bytes + wb.rleft() + wq.rleft();
+            for (auto stream_id : tx_unmarked) {
+                tx_marks.emplace_back(end, stream_id);
+            }
+            tx_unmarked.clear();
+        }
+
+        // wq is only used by SofaRPC request template mode, and wb stays
+        // empty then.
+        auto use_wq = wb.rleft() == 0;
+        auto iovcnt = use_wq ? wq.riovec(iov.data(), iov.size())
+                             : wb.riovec(iov.data(), iov.size());
 
         if (iovcnt == 0) {
             break;
@@ -933,27 +2801,217 @@ int Client::write_clear() {
 
         if (nwrite == -1) {
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                ev_io_start(worker->loop, &wev);
+                on_write_blocked();
                 return 0;
             }
+            set_conn_error(errno);
             return -1;
         }
 
-        wb.drain(nwrite);
-    }
+        tx_bytes += nwrite;
+        on_written(nwrite);
+
+        if (use_wq) {
+            wq.drain(nwrite);
+        } else {
+            wb.drain(nwrite);
+        }
+    }
 
     ev_io_stop(worker->loop, &wev);
 
     return 0;
 }
 
+void Client::on_write_blocked() {
+    ev_io_start(worker->loop, &wev);
+    if (recorded(write_block_time)) {
+        return;
+    }
+    write_block_time = std::chrono::steady_clock::now();
+    if (worker->current_phase == Phase::MAIN_DURATION) {
+        ++worker->stats.write_blocks;
+    }
+}
+
+void Client::on_written(size_t nwrite) {
+    if (worker->current_phase != Phase::MAIN_DURATION) {
+        if (auto side = worker->side_phase()) {
+            side->stats.bytes_sent += nwrite;
+        }
+        write_block_time = {};
+        return;
+    }
+    worker->stats.bytes_sent += nwrite;
+    if (recorded(write_block_time)) {
+        worker->stats.write_block_time +=
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - write_block_time)
+                .count();
+        write_block_time = {};
+    }
+}
+
+void Client::submit_ping() {
+    if (recorded(ping_time)) {
+        // The last PING is still unanswered, which is itself a round
+        // trip time longer than the interval.  Sending another one
+        // would only measure the queue of PINGs.
+        return;
+    }
+
+    if (session->submit_ping() != 0) {
+        ev_timer_stop(worker->loop, &ping_watcher);
+        return;
+    }
+
+    ping_time = std::chrono::steady_clock::now();
+    signal_write();
+}
+
+void Client::on_ping_ack() {
+    if (!recorded(ping_time)) {
+        return;
+    }
+
+    auto rtt = to_latency(std::chrono::steady_clock::now() - ping_time);
+    ping_time = {};
+
+    if (worker->current_phase == Phase::MAIN_DURATION) {
+        worker->ping_rtt_hist.record(rtt);
+    }
+}
+
+void Client::enable_timestamping() {
+#ifdef HAVE_LINUX_NET_TSTAMP_H
+    // With SOF_TIMESTAMPING_OPT_ID, the transmit timestamp of a write
+    // tells the offset of its last byte from the snd_una at this
+    // point.  Nothing has been written yet, so it is the number of
+    // bytes written so far minus 1.
+    int flags = SOF_TIMESTAMPING_SOFTWARE | SOF_TIMESTAMPING_RX_SOFTWARE |
+                SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_OPT_ID |
+                SOF_TIMESTAMPING_OPT_TSONLY;
+    if (worker->config->timestamping_hw) {
+        flags |= SOF_TIMESTAMPING_RAW_HARDWARE |
+                 SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_TX_HARDWARE;
+    }
+    if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) !=
+        0) {
+        return;
+    }
+    tx_timestamping = true;
+    tx_bytes = 0;
+    rx_stamp = {};
+#endif // HAVE_LINUX_NET_TSTAMP_H
+}
+
+void Client::read_tx_timestamps() {
+#ifdef HAVE_LINUX_NET_TSTAMP_H
+    for (;;) {
+        alignas(cmsghdr) uint8_t
+            cmsgbuf[CMSG_SPACE(sizeof(scm_timestamping)) +
+                    CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+        msghdr msg{};
+        msg.msg_control = cmsgbuf;
+        msg.msg_controllen = sizeof(cmsgbuf);
+
+        ssize_t rv;
+        while ((rv = recvmsg(fd, &msg, MSG_ERRQUEUE)) == -1 && errno == EINTR)
+            ;
+        if (rv == -1) {
+            return;
+        }
+
+        const scm_timestamping *tss = nullptr;
+        const sock_extended_err *serr = nullptr;
+        for (auto cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+             cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET &&
+                cmsg->cmsg_type == SCM_TIMESTAMPING) {
+                tss = reinterpret_cast<const scm_timestamping *>(
+                    CMSG_DATA(cmsg));
+            } else if ((cmsg->cmsg_level == SOL_IP &&
+                        cmsg->cmsg_type == IP_RECVERR) ||
+                       (cmsg->cmsg_level == SOL_IPV6 &&
+                        cmsg->cmsg_type == IPV6_RECVERR)) {
+                serr = reinterpret_cast<const sock_extended_err *>(
+                    CMSG_DATA(cmsg));
+            }
+        }
+        if (!tss || !serr || serr->ee_errno != ENOMSG ||
+            serr->ee_origin != SO_EE_ORIGIN_TIMESTAMPING) {
+            continue;
+        }
+
+        KernelTimestamp stamp{};
+        auto &ts = tss->ts[2].tv_sec || tss->ts[2].tv_nsec ? tss->ts[2]
+                                                           : tss->ts[0];
+        stamp.ns = ts.tv_sec * 1000000000LL + ts.tv_nsec;
+        stamp.hw = &ts == &tss->ts[2];
+
+        // ee_data is 32 bits wide, and wraps around.
+        uint32_t key = serr->ee_data;
+        while (!tx_marks.empty()) {
+            auto &mark = tx_marks.front();
+            if (static_cast<int32_t>(key -
+                                     static_cast<uint32_t>(mark.first - 1)) <
+                0) {
+                break;
+            }
+            auto stream = streams.find(mark.second);
+            if (stream && !stream->req_stat.tx_stamp.ns) {
+                stream->req_stat.tx_stamp = stamp;
+            }
+            tx_marks.pop_front();
+        }
+    }
+#endif // HAVE_LINUX_NET_TSTAMP_H
+}
+
+int Client::write_uring() {
+    auto conn = uring_conn;
+
+    // The completion of the write in flight calls this again.
+    if (conn->writing) {
+        return 0;
+    }
+
+    if (on_write() != 0) {
+        return -1;
+    }
+
+    auto use_wq = wb.rleft() == 0;
+    auto iovcnt = use_wq ? wq.riovec(conn->iov.data(), conn->iov.size())
+                         : wb.riovec(conn->iov.data(), conn->iov.size());
+
+    if (iovcnt == 0) {
+        return 0;
+    }
+
+    conn->use_wq = use_wq;
+    worker->uring_write(conn, iovcnt);
+
+    return 0;
+}
+
 int Client::connected() {
-    if (!util::check_socket_connected(fd)) {
+    auto err = util::get_socket_error(fd);
+    if (err != 0) {
+        set_conn_error(err);
         return ERR_CONNECT_FAIL;
     }
     ev_io_start(worker->loop, &rev);
     ev_io_stop(worker->loop, &wev);
 
+    record_tcp_connect_time();
+
+    read_budget = 0.;
+    read_refill = read_epoch = std::chrono::steady_clock::now();
+
+    if (cstat.rtt_sketch) {
+        record_local_port();
+    }
+
     if (ssl) {
         readfn = &Client::tls_handshake;
         writefn = &Client::tls_handshake;
@@ -964,6 +3022,13 @@ int Client::connected() {
     readfn = &Client::read_clear;
     writefn = &Client::write_clear;
 
+    if (worker->uring) {
+        worker->uring_attach(this);
+        writefn = &Client::write_uring;
+    } else if (worker->config->timestamping) {
+        enable_timestamping();
+    }
+
     if (connection_made() != 0) {
         return -1;
     }
@@ -986,6 +3051,7 @@ int Client::tls_handshake() {
             ev_io_start(worker->loop, &wev);
             return 0;
         default:
+            set_tls_error(err);
             return -1;
         }
     }
@@ -995,6 +3061,10 @@ int Client::tls_handshake() {
     readfn = &Client::read_tls;
     writefn = &Client::write_tls;
 
+    if (config.ktls) {
+        enable_ktls();
+    }
+
     if (connection_made() != 0) {
         return -1;
     }
@@ -1003,27 +3073,46 @@ int Client::tls_handshake() {
 }
 
 int Client::read_tls() {
-    uint8_t buf[8_k];
+    // A TLS record holds at most 16KiB, which SSL_read() returns at
+    // once if the chunk is large enough.
+    auto buf = worker->read_chunks[0]->begin;
+    auto buflen = static_cast<int>(
+        std::min(worker->mcpool.chunk_size, static_cast<size_t>(16_k)));
 
     ERR_clear_error();
 
     for (;;) {
-        auto rv = SSL_read(ssl, buf, sizeof(buf));
+        auto allowance = read_allowance();
+        if (allowance == 0) {
+            return 0;
+        }
+
+        auto rv = SSL_read(
+            ssl, buf,
+            static_cast<int>(std::min(static_cast<size_t>(buflen), allowance)));
 
         if (rv <= 0) {
             auto err = SSL_get_error(ssl, rv);
             switch (err) {
             case SSL_ERROR_WANT_READ:
+                if (!session && tls_session_received) {
+                    // --handshake-bench got the ticket it waited for.
+                    try_new_connection();
+                    return -1;
+                }
                 return 0;
             case SSL_ERROR_WANT_WRITE:
                 // renegotiation started
                 return -1;
             default:
+                set_tls_error(err);
                 return -1;
             }
         }
 
-        if (on_read(buf, rv) != 0) {
+        read_budget -= rv;
+
+        if (!session || on_read(buf, rv) != 0) {
             return -1;
         }
     }
@@ -1054,13 +3143,15 @@ int Client::write_tls() {
                 // renegotiation started
                 return -1;
             case SSL_ERROR_WANT_WRITE:
-                ev_io_start(worker->loop, &wev);
+                on_write_blocked();
                 return 0;
             default:
+                set_tls_error(err);
                 return -1;
             }
         }
 
+        on_written(rv);
         wb.drain(rv);
     }
 
@@ -1069,17 +3160,69 @@ int Client::write_tls() {
     return 0;
 }
 
+void Client::append_subst(const uint8_t *data, size_t len,
+                          const std::vector<SubstSlot> &slots) {
+    size_t pos = 0;
+    for (auto &slot : slots) {
+        wb.append(data + pos, slot.offset - pos);
+        worker->subst.fill(wb.append_slot(slot.width), slot);
+        pos = slot.offset + slot.width;
+    }
+    wb.append(data + pos, len - pos);
+}
+
 void Client::record_request_time(RequestStat *req_stat) {
-    req_stat->request_time = std::chrono::steady_clock::now();
-    req_stat->request_wall_time = std::chrono::system_clock::now();
+    req_stat->request_time = worker->clock_now();
+    req_stat->request_wall_time = worker->wall_time(req_stat->request_time);
 }
 
 void Client::record_connect_start_time() {
     cstat.connect_start_time = std::chrono::steady_clock::now();
 }
 
+void Client::record_local_port() {
+    sockaddr_storage ss;
+    socklen_t len = sizeof(ss);
+    cstat.local_port = 0;
+    cstat.addr = current_addr;
+    if (getsockname(fd, reinterpret_cast<sockaddr *>(&ss), &len) != 0) {
+        return;
+    }
+    switch (ss.ss_family) {
+    case AF_INET:
+        cstat.local_port =
+            ntohs(reinterpret_cast<sockaddr_in *>(&ss)->sin_port);
+        break;
+    case AF_INET6:
+        cstat.local_port =
+            ntohs(reinterpret_cast<sockaddr_in6 *>(&ss)->sin6_port);
+        break;
+    }
+}
+
+void Client::record_tcp_connect_time() {
+    cstat.tcp_connect_time = std::chrono::steady_clock::now();
+    if (recorded(cstat.connect_start_time)) {
+        worker->conn_stat.tcp_connect.record(
+            to_latency(cstat.tcp_connect_time - cstat.connect_start_time));
+    }
+}
+
 void Client::record_connect_time() {
     cstat.connect_time = std::chrono::steady_clock::now();
+    if (!recorded(cstat.connect_start_time)) {
+        return;
+    }
+    ++worker->conn_stat.established;
+    if (ssl && recorded(cstat.tcp_connect_time)) {
+        auto t = to_latency(cstat.connect_time - cstat.tcp_connect_time);
+        worker->conn_stat.tls_handshake.record(t);
+        if (SSL_session_reused(ssl)) {
+            worker->conn_stat.tls_resumed_handshake.record(t);
+        } else {
+            worker->conn_stat.tls_full_handshake.record(t);
+        }
+    }
 }
 
 void Client::record_ttfb() {
@@ -1088,10 +3231,15 @@ void Client::record_ttfb() {
     }
 
     cstat.ttfb = std::chrono::steady_clock::now();
+    if (recorded(cstat.connect_start_time) && recorded(cstat.connect_time)) {
+        worker->conn_stat.first_response.record(
+            to_latency(cstat.ttfb - cstat.connect_time));
+    }
 }
 
 void Client::clear_connect_times() {
     cstat.connect_start_time = std::chrono::steady_clock::time_point();
+    cstat.tcp_connect_time = std::chrono::steady_clock::time_point();
     cstat.connect_time = std::chrono::steady_clock::time_point();
     cstat.ttfb = std::chrono::steady_clock::time_point();
 }
@@ -1112,10 +3260,68 @@ void Client::record_client_end_time() {
     cstat.client_end_time = std::chrono::steady_clock::now();
 }
 
-void Client::signal_write() { ev_io_start(worker->loop, &wev); }
+void Client::signal_write() {
+    if (uring_conn) {
+        worker->uring_schedule_write(uring_conn);
+        return;
+    }
+    // Until the connection is made, the write watcher also tells when
+    // the connection or TLS handshake progresses.
+    if (worker->config->batch_writes && state == CLIENT_CONNECTED) {
+        if (!write_pending) {
+            write_pending = true;
+            worker->pending_writes.push_back(this);
+        }
+        return;
+    }
+    ev_io_start(worker->loop, &wev);
+}
 
 void Client::try_new_connection() { new_connection_requested = true; }
 
+void Client::enable_ktls() {
+    // A kTLS socket sends and receives plaintext, so that writev() and
+    // recvmsg() can move several buffers at once instead of a record
+    // per SSL_write() or SSL_read().
+    if (BIO_get_ktls_send(SSL_get_wbio(ssl))) {
+        writefn = &Client::write_clear;
+        ktls_tx = true;
+    }
+    // Sessions in tickets are dropped by read_clear().  Also, whatever
+    // OpenSSL has read ahead must be taken through SSL_read().
+    if (!config.tls_resume && !SSL_has_pending(ssl) &&
+        BIO_get_ktls_recv(SSL_get_rbio(ssl))) {
+        readfn = &Client::read_clear;
+        ktls_rx = true;
+    }
+}
+
+void Client::on_handshake_done() {
+    if (!worker->take_request()) {
+        return;
+    }
+    if (worker->current_phase != Phase::MAIN_DURATION) {
+        return;
+    }
+
+    RequestStat req_stat{};
+    req_stat.request_time = cstat.connect_start_time;
+    req_stat.stream_close_time = cstat.connect_time;
+    req_stat.completed = true;
+
+    ++worker->stats.req_started;
+    ++worker->stats.req_done;
+    ++worker->stats.req_success;
+    ++worker->stats.req_status_success;
+    ++req_started;
+    ++req_done;
+    ++cstat.req_success;
+
+    worker->process_req_stat(&req_stat);
+    worker->record_rtt(
+        to_latency(req_stat.stream_close_time - req_stat.request_time));
+}
+
 namespace {
 int get_ev_loop_flags() {
     if (ev_supported_backends() & ~ev_recommended_backends() &
@@ -1130,48 +3336,386 @@ int get_ev_loop_flags() {
 namespace {
 void update_worker_qpsLeft(struct ev_loop *loop, ev_periodic *w, int revents) {
     auto worker = static_cast<Worker *>(w->data);
-    if (!worker->qps_counts_.empty()) {
-        worker->qpsLeft += worker->qps_counts_[worker->qps_count_index_];
+    if (worker->config->is_dynamic_qps()) {
+        worker->update_qps_rate(std::chrono::steady_clock::now());
+        worker->qps_credit += worker->qps_rate * w->interval;
+        auto n = static_cast<size_t>(worker->qps_credit);
+        worker->qps_credit -= n;
+        worker->add_qps_quota(std::chrono::steady_clock::now(), n);
+    } else if (!worker->qps_counts_.empty()) {
+        auto n = worker->qps_counts_[worker->qps_count_index_];
+        if (n) {
+            // The quota was due when this watcher was scheduled to
+            // fire, not when the loop got around to calling us.
+            auto lag = ev_now(loop) - (ev_periodic_at(w) - w->interval);
+            auto due = std::chrono::steady_clock::now();
+            if (lag > 0.) {
+                due -= std::chrono::duration_cast<
+                    std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(lag));
+            }
+            worker->add_qps_quota(due, n);
+        }
         worker->qps_count_index_ = (worker->qps_count_index_ + 1) % worker->qps_counts_.size();
     } else {
         worker->qpsLeft = std::numeric_limits<int>::max();
     }
-    while (worker->qpsLeft && !worker->clientsBlockedDueToQps.empty()) {
-        Client *c = worker->clientsBlockedDueToQps.back();
-        worker->clientsBlockedDueToQps.pop_back();
-        if (c->submit_request() != 0) {
-            c->process_request_failure();
+    worker->release_blocked_clients();
+}
+} // namespace
+
+namespace {
+// Event loop timers have millisecond resolution.  When next request
+// is due sooner than this, spin the loop instead of sleeping.
+constexpr auto ARRIVAL_TIMER_SLACK = std::chrono::milliseconds(1);
+} // namespace
+
+namespace {
+// Arranges for the pacer to run again when Worker::next_arrival is
+// due.
+void schedule_arrival(Worker *worker) {
+    auto loop = worker->loop;
+    auto wait = worker->next_arrival - std::chrono::steady_clock::now();
+    if (wait < ARRIVAL_TIMER_SLACK) {
+        ev_timer_stop(loop, &worker->arrival_watcher);
+        ev_idle_start(loop, &worker->arrival_spinner);
+        return;
+    }
+
+    ev_idle_stop(loop, &worker->arrival_spinner);
+    ev_now_update(loop);
+    // Wake up a bit early, and spin for the rest.
+    worker->arrival_watcher.repeat =
+        std::chrono::duration_cast<std::chrono::duration<double>>(
+            wait - ARRIVAL_TIMER_SLACK)
+            .count();
+    ev_timer_again(loop, &worker->arrival_watcher);
+}
+} // namespace
+
+namespace {
+// Hands out quota for the requests which are due by now, each with
+// its own due time, and arranges to be called again when next one is
+// due.
+void dispatch_arrivals(Worker *worker) {
+    auto now = std::chrono::steady_clock::now();
+
+    for (; worker->next_arrival <= now;
+         worker->next_arrival += worker->next_arrival_interval()) {
+        if (!worker->accept_arrival(worker->next_arrival)) {
+            continue;
         }
-        c->signal_write();
+        worker->add_qps_quota(worker->next_arrival, 1);
+    }
+
+    worker->release_blocked_clients();
+
+    schedule_arrival(worker);
+}
+} // namespace
+
+namespace {
+// Hands the records of --replay which are due by now to the clients,
+// and arranges to be called again when next one is due.
+void dispatch_replay(Worker *worker) {
+    auto now = std::chrono::steady_clock::now();
+
+    for (; !worker->replay.done(); worker->replay.advance()) {
+        auto &rec = worker->replay.next();
+        auto due = worker->replay_due_time(rec);
+        if (due > now) {
+            worker->next_arrival = due;
+            break;
+        }
+        worker->replay_due.emplace_back(due, rec);
+    }
+
+    worker->release_replay_clients();
+
+    if (worker->replay.done()) {
+        ev_timer_stop(worker->loop, &worker->arrival_watcher);
+        ev_idle_stop(worker->loop, &worker->arrival_spinner);
+        return;
+    }
+
+    schedule_arrival(worker);
+}
+} // namespace
+
+namespace {
+// Runs the pacer of --replay or --qps, whichever is in use.
+void dispatch_next(Worker *worker) {
+    if (worker->config->is_replay_mode()) {
+        dispatch_replay(worker);
+    } else {
+        dispatch_arrivals(worker);
+    }
+}
+} // namespace
+
+namespace {
+void arrival_timeout_cb(struct ev_loop *loop, ev_timer *w, int revents) {
+    dispatch_next(static_cast<Worker *>(w->data));
+}
+} // namespace
+
+namespace {
+void arrival_spin_cb(struct ev_loop *loop, ev_idle *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    if (std::chrono::steady_clock::now() < worker->next_arrival) {
+        return;
     }
+    dispatch_next(worker);
 }
 } // namespace
 
+namespace {
+// Worker::balloc takes a few hundred Clients per block.  Larger
+// stream tables get a block of their own.
+constexpr size_t CLIENT_BLOCK_SIZE = 256 * 1024;
+// BlockAllocator only aligns to size_t.
+static_assert(alignof(Client) <= alignof(size_t), "Client is overaligned");
+} // namespace
+
 namespace {
 constexpr size_t qps_update_period_ms = 5;
 constexpr size_t qps_update_per_second = 1000 / qps_update_period_ms;
 } // namespace
 
+namespace {
+// The upper bounds in bytes of the classes of response sizes which
+// latency is reported by with --response-sizes.  Larger responses
+// fall into a class of their own.
+constexpr std::array<uint64_t, 7> RESPONSE_SIZE_BOUNDS{
+    256, 1_k, 4_k, 16_k, 64_k, 256_k, 1_m};
+
+// Returns the class of responses of |n| bytes.
+size_t response_size_class(uint64_t n) {
+    return std::lower_bound(std::begin(RESPONSE_SIZE_BOUNDS),
+                            std::end(RESPONSE_SIZE_BOUNDS), n) -
+           std::begin(RESPONSE_SIZE_BOUNDS);
+}
+} // namespace
+
 Worker::Worker(uint32_t id, SSL_CTX *ssl_ctx, size_t nclients, size_t rate,
                Config *config)
-    : stats(), loop(ev_loop_new(get_ev_loop_flags())), ssl_ctx(ssl_ctx),
-      config(config), id(id), tls_info_report_done(false),
-      app_info_report_done(false), nconns_made(0), nclients(nclients),
-      rate(rate), next_client_id(0), rtts(),
-      rtt_min(std::numeric_limits<uint64_t>::max()),
-      rtt_max(std::numeric_limits<uint64_t>::min()), qpsLeft(0),
-      qps_count_index_(0) {
+    : mcpool(config->chunk_size, config->chunk_backing), read_chunks{},
+      read_nchunks(1), cpu(-1),
+      stats(config->latency_precision), loop(ev_loop_new(get_ev_loop_flags())), ssl_ctx(ssl_ctx),
+      tls_session(nullptr), tls_resume_credit(0), config(config), id(id), tls_info_report_done(false),
+      app_info_report_done(false), nconns_made(0), nconns_ready(0),
+      nclients(nclients),
+      rate(rate), next_client_id(0),
+      balloc(CLIENT_BLOCK_SIZE, CLIENT_BLOCK_SIZE),
+      rtt_hist(config->latency_precision),
+      corrected_rtt_hist(config->latency_precision),
+      wire_rtt_hist(config->latency_precision), wire_rtt_sum(0),
+      wire_app_rtt_sum(0), tcp_info_slices(1), tcp_info_next(0),
+      tcp_rtt_hist(config->latency_precision),
+      ping_rtt_hist(config->latency_precision),
+      first_message_hist(config->latency_precision),
+      message_gap_hist(config->latency_precision),
+      think_gen(std::random_device{}() + id), nreconnects(0),
+      reconnect_gen(std::random_device{}() + id),
+      timeout_hist(config->latency_precision), hedge_delay(0.),
+      hedge_hist(config->latency_precision),
+      call_hist(config->latency_precision),
+      conn_stat(config->latency_precision),
+      loop_stat(config->latency_precision), loop_done(false),
+      plugin_ctx(nullptr), reqlog_seq(0), reqlog_dropped(0), uring_nops(0),
+      next_conn_id(0), next_local(0),
+      transaction_stat(config->latency_precision),
+      decode_stat(config->latency_precision),
+      mix_state(std::random_device{}() + id),
+      req_lease(0),
+      req_sent(0),
+      qpsLeft(0), qps_dropped(0), qps_given(0), qps_taken(0),
+      qps_hungry(false), aimd_limit_sum(0.), aimd_samples(0),
+      qps_count_index_(0), qps_rate(0.), qps_share(0.), qps_credit(0.),
+      step_stat(config->latency_precision),
+      warmup_stat(config->latency_precision),
+      warmup_phase(config->latency_precision),
+      drain_phase(config->latency_precision), timeline_seq(0),
+      timeline_rtt_hist(config->latency_precision), timeline_dropped(0),
+      timeline_main(false), arrival_gen(std::random_device{}() + id),
+      replay_tmpl(0) {
 
     ev_timer_init(&duration_watcher, duration_timeout_cb, config->duration, 0.);
     duration_watcher.data = this;
 
-    ev_timer_init(&warmup_watcher, warmup_timeout_cb, config->warm_up_time, 0.);
+    if (config->warm_up_auto > 0.) {
+        ev_timer_init(&warmup_watcher, warmup_sample_cb,
+                      config->timeline_interval, config->timeline_interval);
+    } else {
+        ev_timer_init(&warmup_watcher, warmup_timeout_cb, config->warm_up_time,
+                      0.);
+    }
     warmup_watcher.data = this;
 
+    ev_timer_init(&drain_watcher, drain_timeout_cb, config->drain_time, 0.);
+    drain_watcher.data = this;
+
+    ev_timer_init(&ready_watcher, ready_timeout_cb, config->ready_timeout, 0.);
+    ready_watcher.data = this;
+
+    ev_timer_init(&timeout_watcher, rate_period_timeout_cb, config->rate_period,
+                  config->rate_period);
+    timeout_watcher.data = this;
+
+    ev_async_init(&warmup_end_watcher, warmup_end_cb);
+    warmup_end_watcher.data = this;
+    if (config->warm_up_auto > 0.) {
+        ev_async_start(loop, &warmup_end_watcher);
+        // The main thread must not keep the loop running after all
+        // clients are done.
+        ev_unref(loop);
+    }
+
     ev_periodic_init(&qpsUpdater, update_worker_qpsLeft, 0.,
                      (double)qps_update_period_ms / 1000.0, 0);
     qpsUpdater.data = this;
 
+    ev_init(&arrival_watcher, arrival_timeout_cb);
+    arrival_watcher.data = this;
+
+    endpoint_stats.assign(config->endpoints.size(),
+                          EndpointStat(config->latency_precision));
+    if (config->is_slow_read()) {
+        reader_stats.assign(2, ReaderStat(config->latency_precision));
+    }
+    template_stats.assign(config->mix.size(),
+                          TemplateStat(config->latency_precision));
+    step_stats.assign(config->scenario.size(),
+                      ScenarioStat(config->latency_precision));
+    if (config->response_sizes) {
+        // Wide enough for the classes of HTTP status codes as well
+        response_size_stats.assign(stats.sofarpcStatus.size(),
+                                   ResponseSizeStat(config->latency_precision));
+        size_rtt_hists.assign(RESPONSE_SIZE_BOUNDS.size() + 1,
+                              Histogram(config->latency_precision));
+    }
+    // Each worker takes every nthreads-th sequence number.
+    subst.init(id, config->nthreads, std::random_device{}() + id,
+               &config->subst_keys);
+
+    if (config->is_replay_mode()) {
+        // Each worker takes every nthreads-th record.
+        replay.init(config->replay, id, config->nthreads);
+    }
+
+    if (config->aimd) {
+        // Start from a request per connection, and go as far as -m
+        // lets all of them.
+        auto max = std::max(static_cast<size_t>(1),
+                            nclients * config->max_concurrent_streams);
+        aimd = AimdLimit(1., max, std::min(nclients, max),
+                         config->aimd_backoff);
+    }
+
+    ev_idle_init(&arrival_spinner, arrival_spin_cb);
+    arrival_spinner.data = this;
+
+    ev_init(&step_watcher, step_timeout_cb);
+    step_watcher.repeat = config->slo_step;
+    step_watcher.data = this;
+
+    ev_async_init(&stop_watcher, stop_cb);
+    stop_watcher.data = this;
+    main_duration = 0.;
+    if (config->is_slo_search_mode()) {
+        ev_async_start(loop, &stop_watcher);
+    } else if (!config->stop_conditions.empty()) {
+        ev_async_start(loop, &stop_watcher);
+        // --stop-on may never fire, and must not keep the loop alive.
+        ev_unref(loop);
+    }
+
+    ev_timer_init(&sweep_watcher, sweep_timeout_cb, config->sweep_step,
+                  config->sweep_step);
+    sweep_watcher.data = this;
+    sweep_cell = 0;
+    sweep_clients = nclients;
+    if (config->is_sweep_mode()) {
+        sweep_stats.assign(config->sweep.size(),
+                           PhaseStat(config->latency_precision));
+        // The warm-up runs the first cell.
+        sweep_clients =
+            sweep_share(config->sweep[0].nclients, config->nthreads, id);
+    }
+
+    ev_init(&uring_watcher, uring_cb);
+    uring_watcher.data = this;
+
+    ev_prepare_init(&uring_prepare, uring_prepare_cb);
+    uring_prepare.data = this;
+
+    ev_idle_init(&uring_idle, uring_idle_cb);
+    uring_idle.data = this;
+
+    ev_prepare_init(&write_flusher, write_flush_cb);
+    write_flusher.data = this;
+
+    if (config->request_timeout > 0.) {
+        deadlines.init(config->request_timeout);
+        ev_timer_init(&deadline_watcher, deadline_timeout_cb, deadlines.tick(),
+                      deadlines.tick());
+        deadline_watcher.data = this;
+    }
+
+    if (config->has_think_time()) {
+        thinks.init(config->think_time);
+        ev_timer_init(&think_watcher, think_timeout_cb, thinks.tick(),
+                      thinks.tick());
+        think_watcher.data = this;
+    }
+
+    if (config->is_hedging()) {
+        // --hedge=p<N> starts with the shortest tick, as its delay is
+        // not known yet.
+        hedges.init(config->hedge_delay);
+        ev_timer_init(&hedge_watcher, hedge_timeout_cb, hedges.tick(),
+                      hedges.tick());
+        hedge_watcher.data = this;
+        hedge_delay = config->hedge_delay;
+    }
+
+    if (config->reconnect_max) {
+        reconnects.init(config->reconnect_cap);
+        ev_timer_init(&reconnect_watcher, reconnect_timeout_cb,
+                      reconnects.tick(), reconnects.tick());
+        reconnect_watcher.data = this;
+        reconnect_start = std::chrono::steady_clock::now();
+    }
+
+    ev_timer_init(&loop_probe, loop_probe_cb, LOOP_PROBE_INTERVAL,
+                  LOOP_PROBE_INTERVAL);
+    loop_probe.data = this;
+
+    // No more ticks than clients, so that none is sampled more often.
+    tcp_info_slices = std::max<size_t>(
+        1, std::min<size_t>(TCP_INFO_SLICES, nclients));
+    ev_timer_init(&tcp_info_watcher, tcp_info_cb,
+                  config->tcp_info_interval / tcp_info_slices,
+                  config->tcp_info_interval / tcp_info_slices);
+    tcp_info_watcher.data = this;
+
+    ev_prepare_init(&loop_prepare, loop_prepare_cb);
+    loop_prepare.data = this;
+
+    ev_check_init(&loop_check, loop_check_cb);
+    loop_check.data = this;
+
+    tsc_clock.ns_per_tick = config->tsc_ns_per_tick;
+    wall_offset = std::chrono::system_clock::duration::zero();
+
+    ev_timer_init(&timeline_watcher, timeline_timeout_cb,
+                  config->timeline_interval, config->timeline_interval);
+    timeline_watcher.data = this;
+    if (config->is_timeline_enabled()) {
+        timeline_queue = std::make_unique<SpscQueue<TimelineSample>>(
+            TIMELINE_QUEUE_SIZE);
+    }
+
     if (config->is_timing_based_mode()) {
         current_phase = Phase::INITIAL_IDLE;
     } else {
@@ -1180,560 +3724,7057 @@ Worker::Worker(uint32_t id, SSL_CTX *ssl_ctx, size_t nclients, size_t rate,
 }
 
 Worker::~Worker() {
+    if (tls_session) {
+        SSL_SESSION_free(tls_session);
+    }
     ev_loop_destroy(loop);
 }
 
-void Worker::stop_all_clients() {
-    for (auto client : clients) {
-        if (!client)
-            continue;
-        client->record_client_end_time();
-        if (client->session) {
-            client->terminate_session();
-            client->disconnect();
-        }
-        process_client_stat(&client->cstat);
-    }
-}
+void Worker::make_clients(size_t n) {
+    auto nconns = nclients * config->connections_per_client;
 
-void Worker::free_client(Client *deleted_client) {
-}
+    n = std::min(n, nconns - nconns_made);
 
-void Worker::run() {
-    for (size_t i = 0; i < nclients; ++i) {
+    for (size_t i = 0; i < n; ++i) {
+        // Clients are never deleted, see free_client().
+        auto client = new (balloc.alloc(sizeof(Client)))
+            Client(next_client_id++, this);
 
-        auto client = new Client(next_client_id++, this);
+        if (!pools.empty()) {
+            auto &pool = pools[nconns_made / config->connections_per_client];
+            pool.conns.push_back(client);
+            client->pool = &pool;
+        }
 
         ++nconns_made;
 
         if (client->connect() != 0) {
             std::cerr << "client could not connect to host" << std::endl;
             client->fail();
-        } else {
+        }
+        // A client waiting to reconnect is still one.
+        if (client->fd != -1 || client->reconnect_node.linked()) {
             clients.push_back(client);
         }
     }
-    ev_run(loop, 0);
-}
 
-void Worker::process_req_stat(RequestStat *req_stat) {
-    stats.req_stats.push_back(*req_stat);
+    if (nconns_made == nconns) {
+        ev_timer_stop(loop, &timeout_watcher);
+    }
 }
 
-void Worker::process_client_stat(ClientStat *cstat) {
-    stats.client_stats.push_back(*cstat);
+void Worker::start_warm_up() {
+    ev_timer_start(loop, &warmup_watcher);
+    if (config->warm_up_auto > 0. && config->is_qps_mode()) {
+        // A server is warmed up at the rate it is measured at.
+        start_qps_pacer();
+    }
 }
 
-void Worker::record_rtt(uint64_t rtt_in_us) {
-    rtts.push_back(rtt_in_us);
-    rtt_min = std::min(rtt_min, rtt_in_us);
-    rtt_max = std::max(rtt_max, rtt_in_us);
+void Worker::on_conn_ready() {
+    auto nconns = nclients * config->connections_per_client;
+    if (++nconns_ready * 100 < nconns * config->ready) {
+        return;
+    }
+    ev_ref(loop);
+    ev_timer_stop(loop, &ready_watcher);
+    start_warm_up();
 }
 
-void Worker::set_qps_counts(std::vector<size_t> qps_count) {
-    qps_counts_ = qps_count;
-}
+void Worker::end_warm_up() {
+    assert(stats.req_started == 0);
+    assert(stats.req_done == 0);
 
-namespace {
-// Returns percentage of number of samples within mean +/- sd.
-double within_sd(const std::vector<double> &samples, double mean, double sd) {
-    if (samples.size() == 0) {
-        return 0.0;
+    ev_timer_stop(loop, &warmup_watcher);
+    if (ev_is_active(&warmup_end_watcher)) {
+        ev_ref(loop);
+        ev_async_stop(loop, &warmup_end_watcher);
     }
-    auto lower = mean - sd;
-    auto upper = mean + sd;
-    auto m = std::count_if(
-        std::begin(samples), std::end(samples),
-        [&lower, &upper](double t) { return lower <= t && t <= upper; });
-    return (m / static_cast<double>(samples.size())) * 100;
-}
-} // namespace
 
-namespace {
-// Computes statistics using |samples|. The min, max, mean, sd, and
-// percentage of number of samples within mean +/- sd are computed.
-// If |sampling| is true, this computes sample variance.  Otherwise,
-// population variance.
-SDStat compute_time_stat(const std::vector<double> &samples,
-                         bool sampling = false) {
-    if (samples.empty()) {
-        return {0.0, 0.0, 0.0, 0.0, 0.0};
+    for (auto client : clients) {
+        if (client) {
+            assert(client->req_inflight == 0);
+            assert(client->req_started == 0);
+            assert(client->req_done == 0);
+
+            client->record_client_start_time();
+            client->clear_connect_times();
+            client->record_connect_start_time();
+            // A connection still being made is established in the
+            // main measurement, so that it is an attempt of it, too.
+            if (client->fd != -1 && client->state != CLIENT_CONNECTED) {
+                ++conn_stat.attempts;
+            }
+        }
     }
-    // standard deviation calculated using Rapid calculation method:
-    // https://en.wikipedia.org/wiki/Standard_deviation#Rapid_calculation_methods
-    double a = 0, q = 0;
-    size_t n = 0;
-    double sum = 0;
-    auto res = SDStat{std::numeric_limits<double>::max(),
-                      std::numeric_limits<double>::min()};
-    for (const auto &t : samples) {
-        ++n;
-        res.min = std::min(res.min, t);
-        res.max = std::max(res.max, t);
-        sum += t;
-
-        auto na = a + (t - a) / n;
-        q += (t - a) * (t - na);
-        a = na;
-    }
-
-    assert(n > 0);
-    res.mean = sum / n;
-    res.sd = sqrt(q / (sampling && n > 1 ? n - 1 : n));
-    res.within_sd = within_sd(samples, res.mean, res.sd);
 
-    return res;
+    current_phase = Phase::MAIN_DURATION;
+
+    ev_timer_start(loop, &duration_watcher);
+    if (config->warm_up_auto == 0. || !config->is_qps_mode()) {
+        // Otherwise, the pacer runs since the warm-up started.
+        start_qps_pacer();
+    }
+    if (config->is_replay_mode()) {
+        start_replay();
+    }
+    if (config->is_sweep_mode()) {
+        sweep_start = std::chrono::steady_clock::now();
+        ev_timer_start(loop, &sweep_watcher);
+    }
 }
-} // namespace
 
-namespace {
-SDStats
-process_time_stats(const std::vector<Worker*> &workers) {
+std::chrono::steady_clock::time_point Worker::clock_now() const {
+    switch (config->clock_source) {
+    case ClockSource::TSC:
+        return tsc_clock.now();
+    case ClockSource::LOOP:
+        return loop_wake_time;
+    default:
+        return std::chrono::steady_clock::now();
+    }
+}
 
-    std::vector<double> request_times, connect_times, ttfb_times, rps_values;
+std::chrono::system_clock::time_point
+Worker::wall_time(std::chrono::steady_clock::time_point t) const {
+    if (config->clock_source == ClockSource::STEADY) {
+        return std::chrono::system_clock::now();
+    }
+    // Skips another clock read, at the cost of missing wall clock
+    // steps during the run.
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            t.time_since_epoch()) +
+        wall_offset);
+}
 
-    for (const auto &w : workers) {
-        for (const auto &req_stat : w->stats.req_stats) {
-            if (!req_stat.completed) {
-                continue;
-            }
-            request_times.push_back(
-                std::chrono::duration_cast<std::chrono::duration<double>>(
-                    req_stat.stream_close_time - req_stat.request_time)
-                    .count());
-        }
+void Worker::stop_measurement() {
+    total_req_left.store(0);
+    req_lease = 0;
+    current_phase = Phase::DURATION_OVER;
 
-        const auto &stat = w->stats;
+    stop_qps_pacer();
+    ev_timer_stop(loop, &sweep_watcher);
+    ev_timer_stop(loop, &timeout_watcher);
+    if (config->reconnect_max) {
+        ev_timer_stop(loop, &reconnect_watcher);
+    }
 
-        for (const auto &cstat : stat.client_stats) {
-            if (recorded(cstat.client_start_time) &&
-                recorded(cstat.client_end_time)) {
-                auto t =
-                    std::chrono::duration_cast<std::chrono::duration<double>>(
-                        cstat.client_end_time - cstat.client_start_time)
-                        .count();
-                if (t > 1e-9) {
-                    rps_values.push_back(cstat.req_success / t);
-                }
-            }
+    if (config->drain_time > 0.) {
+        start_drain();
+        return;
+    }
 
-            // We will get connect event before FFTB.
-            if (!recorded(cstat.connect_start_time) ||
-                !recorded(cstat.connect_time)) {
-                continue;
-            }
+    stop_all_clients();
+    break_loop(EVBREAK_ALL);
+}
 
-            connect_times.push_back(
-                std::chrono::duration_cast<std::chrono::duration<double>>(
-                    cstat.connect_time - cstat.connect_start_time)
-                    .count());
+void Worker::start_drain() {
+    // The main measurement ends here, as it does without the drain.
+    for (auto client : clients) {
+        if (client) {
+            client->record_client_end_time();
+            process_client_stat(&client->cstat);
+        }
+    }
 
-            if (!recorded(cstat.ttfb)) {
-                continue;
-            }
+    qpsLeft = 0;
+    qps_due.clear();
 
-            ttfb_times.push_back(
-                std::chrono::duration_cast<std::chrono::duration<double>>(
-                    cstat.ttfb - cstat.connect_start_time)
-                    .count());
+    // The others are closed once their responses arrive, and the loop
+    // ends when all are.
+    for (auto client : clients) {
+        if (client && client->session && client->streams.empty()) {
+            client->terminate_session();
         }
     }
 
-    return {compute_time_stat(request_times), compute_time_stat(connect_times),
-            compute_time_stat(ttfb_times), compute_time_stat(rps_values)};
+    ev_timer_start(loop, &drain_watcher);
+    ev_unref(loop);
 }
-} // namespace
 
-namespace {
-void resolve_host() {
-    if (config.base_uri_unix) {
-        auto res = std::make_unique<addrinfo>();
-        res->ai_family = config.unix_addr.sun_family;
-        res->ai_socktype = SOCK_STREAM;
-        res->ai_addrlen = sizeof(config.unix_addr);
-        res->ai_addr = static_cast<struct sockaddr *>(
-            static_cast<void *>(&config.unix_addr));
+void Worker::stop_drain() {
+    ev_ref(loop);
+    for (auto client : clients) {
+        if (client && client->session) {
+            client->terminate_session();
+            client->disconnect();
+        }
+    }
+    break_loop(EVBREAK_ALL);
+}
 
-        config.addrs = res.release();
-        return;
-    };
+SidePhaseStat *Worker::side_phase() {
+    switch (current_phase) {
+    case Phase::WARM_UP:
+        return &warmup_phase;
+    case Phase::DURATION_OVER:
+        return &drain_phase;
+    default:
+        return nullptr;
+    }
+}
 
-    int rv;
-    addrinfo hints{}, *res;
+Stats *Worker::current_stats() {
+    if (current_phase == Phase::MAIN_DURATION) {
+        return &stats;
+    }
+    auto side = side_phase();
+    return side ? &side->stats : nullptr;
+}
 
-    hints.ai_family = AF_UNSPEC;
-    hints.ai_socktype = SOCK_STREAM;
-    hints.ai_protocol = 0;
-    hints.ai_flags = AI_ADDRCONFIG;
+int Worker::bind_local(int fd, int family) {
+    if ((config->local_addrs.empty() && config->local_port_lo == 0) ||
+        family == AF_UNIX) {
+        return 0;
+    }
 
-    rv = getaddrinfo(config.host.c_str(), util::utos(config.port).c_str(),
-                     &hints, &res);
-    if (rv != 0) {
-        std::cerr << "getaddrinfo() failed: " << gai_strerror(rv) << std::endl;
-        exit(EXIT_FAILURE);
+    // The addresses of |family| to bind to, or the wildcard address if
+    // only ports are given.
+    std::vector<const Address *> addrs;
+    Address any{};
+    if (config->local_addrs.empty()) {
+        any.su.storage.ss_family = family;
+        any.len = family == AF_INET ? sizeof(any.su.in) : sizeof(any.su.in6);
+        if (family == AF_INET6) {
+            any.su.in6.sin6_addr = in6addr_any;
+        }
+        addrs.push_back(&any);
+    } else {
+        for (auto &addr : config->local_addrs) {
+            if (addr.su.storage.ss_family == family) {
+                addrs.push_back(&addr);
+            }
+        }
+        if (addrs.empty()) {
+            errno = EAFNOSUPPORT;
+            return -1;
+        }
     }
-    if (res == nullptr) {
-        std::cerr << "No address returned" << std::endl;
-        exit(EXIT_FAILURE);
+
+    if (config->local_port_lo == 0) {
+        auto local = *addrs[next_local++ % addrs.size()];
+#ifdef IP_BIND_ADDRESS_NO_PORT
+        // Let connect(2) choose the port, so that a port is only
+        // taken per destination, not per source address.
+        int val = 1;
+        setsockopt(fd, IPPROTO_IP, IP_BIND_ADDRESS_NO_PORT, &val, sizeof(val));
+#endif // IP_BIND_ADDRESS_NO_PORT
+        return bind(fd, &local.su.sa, local.len);
     }
-    config.addrs = res;
+
+    // Each worker takes every nthreads-th port of the range, so that
+    // workers do not contend for the same ports.
+    size_t nports = config->local_port_hi - config->local_port_lo + 1;
+    size_t nslots = (nports + config->nthreads - 1 - id) / config->nthreads;
+    if (nslots == 0) {
+        errno = EADDRNOTAVAIL;
+        return -1;
+    }
+
+    int val = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &val, sizeof(val));
+
+    // Skip the ports still taken by other connections.
+    for (size_t i = 0; i < nslots * addrs.size(); ++i) {
+        auto n = next_local++;
+        auto local = *addrs[n % addrs.size()];
+        auto slot = (n / addrs.size()) % nslots;
+        util::set_port(local,
+                       config->local_port_lo + id + slot * config->nthreads);
+        if (bind(fd, &local.su.sa, local.len) == 0) {
+            return 0;
+        }
+        if (errno != EADDRINUSE) {
+            return -1;
+        }
+    }
+
+    return -1;
 }
-} // namespace
 
-namespace {
-std::string get_reqline(const char *uri, const http_parser_url &u) {
-    std::string reqline;
+void Worker::break_loop(int how) {
+    loop_done = true;
+    ev_break(loop, how);
+}
 
-    if (util::has_uri_field(u, UF_PATH)) {
-        reqline = util::get_uri_field(uri, u, UF_PATH).str();
-    } else {
-        reqline = "/";
+KernelTimestamp Worker::record_rx_timestamp(msghdr &msg) {
+    KernelTimestamp stamp{};
+#ifdef SO_TIMESTAMPNS
+    KernelTimestamp sw{};
+    for (auto cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET) {
+            continue;
+        }
+        timespec ts[3];
+        if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            memcpy(ts, CMSG_DATA(cmsg), sizeof(ts[0]));
+        } else if (cmsg->cmsg_type == SCM_TIMESTAMPING) {
+            memcpy(ts, CMSG_DATA(cmsg), sizeof(ts));
+            if (ts[2].tv_sec || ts[2].tv_nsec) {
+                stamp.ns = ts[2].tv_sec * 1000000000LL + ts[2].tv_nsec;
+                stamp.hw = true;
+            }
+        } else {
+            continue;
+        }
+        if (ts[0].tv_sec || ts[0].tv_nsec) {
+            sw.ns = ts[0].tv_sec * 1000000000LL + ts[0].tv_nsec;
+        }
+    }
+    if (!sw.ns) {
+        return stamp;
+    }
+    timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    auto d = now.tv_sec * 1000000000LL + now.tv_nsec - sw.ns;
+    if (d > 0) {
+        loop_stat.wakeup.record(d);
+        loop_stat.wakeup_sum += d;
     }
+    if (!stamp.ns) {
+        return sw;
+    }
+#endif // SO_TIMESTAMPNS
+    return stamp;
+}
 
-    if (util::has_uri_field(u, UF_QUERY)) {
-        reqline += '?';
-        reqline += util::get_uri_field(uri, u, UF_QUERY);
+void Worker::stop_all_clients() {
+    for (auto client : clients) {
+        if (!client)
+            continue;
+        client->record_client_end_time();
+        if (client->session) {
+            client->terminate_session();
+            client->disconnect();
+        }
+        process_client_stat(&client->cstat);
     }
+}
 
-    return reqline;
+void Worker::free_client(Client *deleted_client) {
 }
-} // namespace
 
-#ifndef OPENSSL_NO_NEXTPROTONEG
-namespace {
-int client_select_next_proto_cb(SSL *ssl, unsigned char **out,
-                                unsigned char *outlen, const unsigned char *in,
-                                unsigned int inlen, void *arg) {
-    if (util::select_protocol(const_cast<const unsigned char **>(out), outlen,
-                              in, inlen, config.npn_list)) {
-        return SSL_TLSEXT_ERR_OK;
+int Worker::read_iovec(struct iovec *iov) {
+    for (size_t i = 0; i < read_nchunks; ++i) {
+        iov[i].iov_base = read_chunks[i]->begin;
+        iov[i].iov_len = mcpool.chunk_size;
     }
-
-    // OpenSSL will terminate handshake with fatal alert if we return
-    // NOACK.  So there is no way to fallback.
-    return SSL_TLSEXT_ERR_NOACK;
+    return read_nchunks;
 }
-} // namespace
-#endif // !OPENSSL_NO_NEXTPROTONEG
 
 namespace {
-constexpr char UNIX_PATH_PREFIX[] = "unix:";
+// Replaces the memory of |v| with a copy made by the calling thread.
+template <typename T> void reallocate(T &v) {
+    auto copy = v;
+    v = std::move(copy);
+}
 } // namespace
 
-namespace {
-bool parse_base_uri(const StringRef &base_uri) {
-    http_parser_url u{};
-    if (http_parser_parse_url(base_uri.c_str(), base_uri.size(), 0, &u) != 0 ||
-        !util::has_uri_field(u, UF_SCHEMA) ||
-        !util::has_uri_field(u, UF_HOST)) {
-        return false;
+void Worker::pin_to_cpu() {
+#ifdef CPU_SETSIZE
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &set);
     }
-
-    config.scheme = util::get_uri_field(base_uri.c_str(), u, UF_SCHEMA).str();
-    config.host = util::get_uri_field(base_uri.c_str(), u, UF_HOST).str();
-    config.default_port = util::get_default_port(base_uri.c_str(), u);
-    if (util::has_uri_field(u, UF_PORT)) {
-        config.port = u.port;
-    } else {
-        config.port = config.default_port;
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        std::cerr << "--cpu-affinity: could not pin worker " << id
+                  << " to CPU " << cpu << ": " << strerror(errno)
+                  << std::endl;
+        return;
     }
-
-    return true;
+#endif // CPU_SETSIZE
+
+    // Linux places a page on the NUMA node of the CPU which first
+    // touches it, and malloc serves each thread from its own arena, so
+    // copies made here are local to this worker.
+    reallocate(stats);
+    reallocate(rtt_hist);
+    reallocate(corrected_rtt_hist);
+    reallocate(wire_rtt_hist);
+    reallocate(tcp_rtt_hist);
+    reallocate(ping_rtt_hist);
+    reallocate(first_message_hist);
+    reallocate(message_gap_hist);
+    reallocate(timeout_hist);
+    reallocate(hedge_hist);
+    reallocate(call_hist);
+    reallocate(conn_stat);
+    reallocate(loop_stat);
+    reallocate(step_stat);
+    reallocate(warmup_stat);
+    reallocate(warmup_phase);
+    reallocate(drain_phase);
+    reallocate(phase_stats);
+    reallocate(sweep_stats);
+    reallocate(timeline_rtt_hist);
+    reallocate(endpoint_stats);
+    reallocate(reader_stats);
+    reallocate(template_stats);
+    reallocate(step_stats);
+    reallocate(response_size_stats);
+    reallocate(size_rtt_hists);
+    reallocate(transaction_stat);
+    reallocate(decode_stat);
 }
-} // namespace
-namespace {
-// Use std::vector<std::string>::iterator explicitly, without that,
-// http_parser_url u{} fails with clang-3.4.
-std::vector<std::string> parse_uris(std::vector<std::string>::iterator first,
-                                    std::vector<std::string>::iterator last) {
-    std::vector<std::string> reqlines;
 
-    if (first == last) {
-        std::cerr << "no URI available" << std::endl;
-        exit(EXIT_FAILURE);
+void Worker::update_read_size(size_t nread) {
+    if (nread == read_nchunks * mcpool.chunk_size) {
+        read_nchunks = std::min(read_nchunks * 2, MAX_READ_CHUNKS);
+    } else if (read_nchunks > 1 &&
+               nread <= read_nchunks * mcpool.chunk_size / 4) {
+        read_nchunks /= 2;
     }
+}
 
-    if (!config.has_base_uri()) {
+UringConn::UringConn(Client *client, int fd)
+    : client(client), fd(fd), nops(0), writing(false), use_wq(false),
+      flush_pending(false) {}
 
-        if (!parse_base_uri(StringRef{*first})) {
-            std::cerr << "invalid URI: " << *first << std::endl;
-            exit(EXIT_FAILURE);
-        }
+int Worker::init_uring() {
+    std::vector<uint8_t *> bufs;
+    for (size_t i = 0; i < URING_NBUFS; ++i) {
+        auto m = mcpool.get();
+        uring_bufs.push_back(m);
+        bufs.push_back(m->begin);
+    }
 
-        config.base_uri = *first;
+    uring = std::make_unique<IoUring>();
+    if (uring->init(URING_ENTRIES, bufs, mcpool.chunk_size) != 0) {
+        auto error = errno;
+        uring.reset();
+        for (auto m : uring_bufs) {
+            mcpool.recycle(m);
+        }
+        uring_bufs.clear();
+        errno = error;
+        return -1;
     }
 
-    for (; first != last; ++first) {
-        http_parser_url u{};
+    ev_io_set(&uring_watcher, uring->fd(), EV_READ);
+    // uring_watcher keeps the loop running instead.
+    ev_prepare_start(loop, &uring_prepare);
+    ev_unref(loop);
 
-        auto uri = (*first).c_str();
+    return 0;
+}
 
-        if (http_parser_parse_url(uri, (*first).size(), 0, &u) != 0) {
-            std::cerr << "invalid URI: " << uri << std::endl;
-            exit(EXIT_FAILURE);
-        }
+void Worker::uring_attach(Client *client) {
+    auto conn = new UringConn(client, client->fd);
+    client->uring_conn = conn;
 
-        reqlines.push_back(get_reqline(uri, u));
-    }
+    ev_io_stop(loop, &client->rev);
+    ev_io_stop(loop, &client->wev);
 
-    return reqlines;
+    uring->recv_multishot(conn->fd, uring_user_data(conn, URING_OP_RECV));
+    uring_add_nops(conn, 1);
 }
-} // namespace
 
-namespace {
-std::vector<std::string> read_uri_from_file(std::istream &infile) {
-    std::vector<std::string> uris;
-    std::string line_uri;
-    while (std::getline(infile, line_uri)) {
-        uris.push_back(line_uri);
-    }
+void Worker::uring_detach(UringConn *conn) {
+    conn->client = nullptr;
+    uring->cancel(uring_user_data(conn, URING_OP_RECV),
+                  uring_user_data(conn, URING_OP_CANCEL));
+    uring_add_nops(conn, 1);
+    // The file descriptor is about to be closed, and may be reused by
+    // the next connection right away.  The operations queued for
+    // |conn| must be tied to this connection before that.
+    uring->submit();
+}
 
-    return uris;
+void Worker::uring_write(UringConn *conn, int iovcnt) {
+    conn->writing = true;
+    uring->writev(conn->fd, conn->iov.data(), iovcnt,
+                  uring_user_data(conn, URING_OP_WRITE));
+    uring_add_nops(conn, 1);
 }
-} // namespace
 
-namespace {
-Worker * create_worker(uint32_t id, SSL_CTX *ssl_ctx,
-                                      size_t nclients, size_t rate) {
-    if (config.is_rate_mode()) {
-        return new Worker(id, ssl_ctx, nclients, rate, &config);
-    } else {
-        return new Worker(id, ssl_ctx, nclients, nclients, &config);
+void Worker::uring_schedule_write(UringConn *conn) {
+    if (conn->flush_pending) {
+        return;
     }
+    conn->flush_pending = true;
+    uring_flush.push_back(conn);
 }
-} // namespace
 
-namespace {
-int parse_header_table_size(uint32_t &dst, const char *opt,
-                            const char *optarg) {
-    auto n = util::parse_uint_with_unit(optarg);
-    if (n == -1) {
-        std::cerr << "--" << opt << ": Bad option value: " << optarg
-                  << std::endl;
-        return -1;
-    }
-    if (n > std::numeric_limits<uint32_t>::max()) {
-        std::cerr << "--" << opt
-                  << ": Value too large.  It should be less than or equal to "
-                  << std::numeric_limits<uint32_t>::max() << std::endl;
-        return -1;
+void Worker::uring_flush_writes() {
+    // Writing may make more connections want to write, which are
+    // appended, and flushed in this pass as well.
+    for (size_t i = 0; i < uring_flush.size(); ++i) {
+        auto conn = uring_flush[i];
+        conn->flush_pending = false;
+        auto client = conn->client;
+        if (!client) {
+            release_uring_conn(conn);
+            continue;
+        }
+        client->restart_timeout();
+        if (client->do_write() != 0) {
+            client->fail();
+            free_client(client);
+        }
     }
+    uring_flush.clear();
 
-    dst = n;
+    if (uring->submit() != 0) {
+        // Left queued, and tried again in the next loop iteration.
+        ev_idle_start(loop, &uring_idle);
+    }
+}
 
-    return 0;
+void Worker::flush_writes() {
+    // Writing may make more connections want to write, which are
+    // appended, and written in this pass as well.
+    for (size_t i = 0; i < pending_writes.size(); ++i) {
+        auto client = pending_writes[i];
+        client->write_pending = false;
+        if (client->state != CLIENT_CONNECTED) {
+            continue;
+        }
+        writecb(loop, &client->wev, EV_WRITE);
+    }
+    pending_writes.clear();
 }
-} // namespace
 
-namespace {
-void print_version(std::ostream &out) {
-    out << "h2load nghttp2/" NGHTTP2_VERSION << std::endl;
+void Worker::uring_add_nops(UringConn *conn, int delta) {
+    conn->nops += delta;
+    uring_nops += delta;
+    if (uring_nops) {
+        ev_io_start(loop, &uring_watcher);
+    } else {
+        ev_io_stop(loop, &uring_watcher);
+    }
+    release_uring_conn(conn);
 }
-} // namespace
 
-namespace {
-void print_usage(std::ostream &out) {
-    out << R"(Usage: h2load [OPTIONS]... [URI]...
-benchmarking tool for HTTP/2 server)"
-        << std::endl;
+void Worker::uring_complete(uint64_t user_data, int32_t res, uint32_t flags) {
+    auto conn = reinterpret_cast<UringConn *>(user_data & ~URING_OP_MASK);
+    auto client = conn->client;
+    auto rv = 0;
+
+    switch (user_data & URING_OP_MASK) {
+    case URING_OP_RECV: {
+        auto bid = IoUring::buffer_id(flags);
+        if (client) {
+            if (res > 0) {
+                client->restart_timeout();
+                rv = client->on_read(uring->buffer(bid), res);
+            } else if (res != -ENOBUFS) {
+                // The server closed the connection, or it failed.
+                client->set_conn_error(-res);
+                rv = -1;
+            }
+        }
+        if (bid != -1) {
+            uring->recycle_buffer(bid);
+        }
+        if (!IoUring::more(flags)) {
+            // The kernel ran out of buffers, or gave up for another
+            // reason.  Go on reading if the connection is still open.
+            if (conn->client && rv == 0) {
+                uring->recv_multishot(conn->fd,
+                                      uring_user_data(conn, URING_OP_RECV));
+                uring_add_nops(conn, 1);
+            }
+            uring_add_nops(conn, -1);
+        }
+        if (client && rv != 0) {
+            if (client->try_again_or_fail() == 0) {
+                return;
+            }
+            free_client(client);
+        }
+        return;
+    }
+    case URING_OP_WRITE:
+        conn->writing = false;
+        if (client) {
+            if (res < 0) {
+                client->set_conn_error(-res);
+                rv = -1;
+            } else {
+                client->on_written(res);
+                if (conn->use_wq) {
+                    client->wq.drain(res);
+                } else {
+                    client->wb.drain(res);
+                }
+            }
+        }
+        uring_add_nops(conn, -1);
+        if (!client) {
+            return;
+        }
+        if (rv == 0) {
+            client->restart_timeout();
+            rv = client->do_write();
+        }
+        if (rv != 0) {
+            client->fail();
+            free_client(client);
+        }
+        return;
+    case URING_OP_CANCEL:
+        uring_add_nops(conn, -1);
+        return;
+    }
 }
-} // namespace
 
-namespace {
-constexpr char DEFAULT_NPN_LIST[] = "h2,h2-16,h2-14,http/1.1";
-} // namespace
+void Worker::run() {
+    if (cpu != -1) {
+        pin_to_cpu();
+    }
+
+    for (auto &chunk : read_chunks) {
+        chunk = mcpool.get();
+    }
+
+    if (config->io_uring && init_uring() != 0) {
+        std::cerr << "--io-uring: io_uring is not available for worker " << id
+                  << ", falling back to libev: " << strerror(errno)
+                  << std::endl;
+    }
+
+    if (config->batch_writes) {
+        // The connections keep the loop running.
+        ev_prepare_start(loop, &write_flusher);
+        ev_unref(loop);
+    }
+
+    auto nconns = nclients * config->connections_per_client;
+
+    clients.reserve(nconns);
+
+    if (config->connections_per_client > 1) {
+        // Never reallocated, so that connections can point to them
+        pools.resize(nclients);
+    }
+
+    if (config->is_rate_mode() && rate < nconns) {
+        // The rest are made every --rate-period, so that their
+        // handshakes do not all land at once.
+        ev_timer_start(loop, &timeout_watcher);
+        make_clients(rate);
+    } else {
+        make_clients(nconns);
+    }
+    if (config->request_timeout > 0.) {
+        deadline_start = std::chrono::steady_clock::now();
+        ev_timer_start(loop, &deadline_watcher);
+        // This must not keep the loop running after all clients are
+        // done.
+        ev_unref(loop);
+    }
+    if (config->has_think_time()) {
+        think_start = std::chrono::steady_clock::now();
+        ev_timer_start(loop, &think_watcher);
+        ev_unref(loop);
+    }
+    if (config->is_hedging()) {
+        hedge_start = std::chrono::steady_clock::now();
+        ev_timer_start(loop, &hedge_watcher);
+        ev_unref(loop);
+    }
+    if (timeline_queue) {
+        timeline_start = std::chrono::steady_clock::now();
+        timeline_main = current_phase == Phase::MAIN_DURATION;
+        ev_timer_start(loop, &timeline_watcher);
+        // The timeline must not keep the loop running after all
+        // clients are done.
+        ev_unref(loop);
+    }
+
+    // Neither do the watchers measuring the loop itself.
+    ev_now_update(loop);
+    loop_start_time = std::chrono::steady_clock::now();
+    loop_wake_time = loop_start_time;
+    tsc_clock.anchor(read_tsc(), loop_start_time);
+    wall_offset = std::chrono::system_clock::now().time_since_epoch() -
+                  std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                      loop_start_time.time_since_epoch());
+    loop_probe_due =
+        loop_start_time +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(LOOP_PROBE_INTERVAL));
+    ev_timer_start(loop, &loop_probe);
+    ev_unref(loop);
+    if (config->tcp_info_interval > 0.) {
+        ev_timer_start(loop, &tcp_info_watcher);
+        ev_unref(loop);
+    }
+    ev_prepare_start(loop, &loop_prepare);
+    ev_unref(loop);
+    ev_check_start(loop, &loop_check);
+    ev_unref(loop);
+
+    if (config->perf_counters) {
+        // perf_event_open(2) counts the calling thread, so this must be
+        // done here.
+        perf = std::make_unique<PerfCounters>();
+        if (perf->open() != 0) {
+            std::cerr << "--perf-counters: no counter is available for worker "
+                      << id << ": " << strerror(errno) << std::endl;
+            perf.reset();
+        } else {
+            perf->start();
+        }
+    }
+
+    if (config->is_replay_mode() && current_phase == Phase::MAIN_DURATION) {
+        // Otherwise, the replay starts after the warm-up.
+        start_replay();
+    }
+
+    if (config->busy_poll) {
+        // Spin instead of sleeping in epoll_wait(2), so that responses
+        // are read as soon as they arrive.
+        while (ev_run(loop, EVRUN_NOWAIT) && !loop_done)
+            ;
+    } else {
+        ev_run(loop, 0);
+    }
+
+    if (perf) {
+        perf->stop();
+    }
+
+    auto loop_end_time = std::chrono::steady_clock::now();
+    loop_stat.busy_time += to_latency(loop_end_time - loop_wake_time);
+    loop_stat.run_time = to_latency(loop_end_time - loop_start_time);
+    for (int i = 0; i < 3; ++i) {
+        ev_ref(loop);
+    }
+    ev_timer_stop(loop, &loop_probe);
+    ev_prepare_stop(loop, &loop_prepare);
+    ev_check_stop(loop, &loop_check);
+
+    if (config->tcp_info_interval > 0.) {
+        ev_ref(loop);
+        ev_timer_stop(loop, &tcp_info_watcher);
+    }
+
+    if (config->batch_writes) {
+        ev_ref(loop);
+        ev_prepare_stop(loop, &write_flusher);
+    }
+
+    if (uring) {
+        ev_ref(loop);
+        ev_prepare_stop(loop, &uring_prepare);
+        ev_io_stop(loop, &uring_watcher);
+        ev_idle_stop(loop, &uring_idle);
+    }
+
+#ifdef RUSAGE_THREAD
+    rusage ru;
+    if (getrusage(RUSAGE_THREAD, &ru) == 0) {
+        loop_stat.user_time = ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6;
+        loop_stat.system_time = ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+    }
+#endif // RUSAGE_THREAD
+
+    if (ev_is_active(&ready_watcher)) {
+        // All clients were done before --ready was reached.
+        ev_ref(loop);
+        ev_timer_stop(loop, &ready_watcher);
+    }
+    ev_timer_stop(loop, &timeout_watcher);
+
+    if (ev_is_active(&drain_watcher)) {
+        // All responses arrived before the end of --drain-time.
+        ev_ref(loop);
+        ev_timer_stop(loop, &drain_watcher);
+    }
+
+    if (ev_is_active(&warmup_end_watcher)) {
+        // All clients were done before the warm-up was.
+        ev_ref(loop);
+        ev_async_stop(loop, &warmup_end_watcher);
+    }
+
+    if (timeline_queue) {
+        ev_ref(loop);
+        ev_timer_stop(loop, &timeline_watcher);
+        push_timeline_sample(true);
+    }
+
+    // Clients which could not use up the lease failed.  Let others
+    // have the rest.
+    if (req_lease) {
+        total_req_left += req_lease;
+        req_lease = 0;
+    }
+}
 
 namespace {
-void print_help(std::ostream &out) {
-    print_usage(out);
+// The largest number of requests a worker takes at once
+constexpr size_t MAX_REQ_LEASE = 1024;
+} // namespace
 
-    auto config = Config();
+bool Worker::take_request() {
+    if (req_lease == 0) {
+        // Take a smaller batch as the pool drains, so that workers
+        // finish at around the same time.
+        auto left = total_req_left.load(std::memory_order_relaxed);
+        size_t n;
+        do {
+            if (left == 0) {
+                return false;
+            }
+            n = std::min(MAX_REQ_LEASE,
+                         std::max(static_cast<size_t>(1),
+                                  left / (2 * config->nthreads)));
+            n = std::min(n, left);
+        } while (!total_req_left.compare_exchange_weak(left, left - n));
+        req_lease = n;
+    }
+    --req_lease;
+    return true;
+}
 
-    out << R"(
-  <URI>       Specify URI to access.   Multiple URIs can be specified.
-			  URIs are used  in this order for each  client.  All URIs
-			  are used, then  first URI is used and then  2nd URI, and
-			  so  on.  The  scheme, host  and port  in the  subsequent
-			  URIs, if present,  are ignored.  Those in  the first URI
-			  are used solely.  Definition of a base URI overrides all
-			  scheme, host or port values.
-Options:
-  -n, --requests=<N>
-			  Number of  requests across all  clients.  If it  is used
-			  with --timing-script-file option,  this option specifies
-			  the number of requests  each client performs rather than
-			  the number of requests  across all clients.  This option
-			  is ignored if timing-based  benchmarking is enabled (see
-			  --duration option).
-			  Default: )"
-        << config.nreqs << R"(
-  -c, --clients=<N>
-			  Number  of concurrent  clients.   With  -r option,  this
-			  specifies the maximum number of connections to be made.
-			  Default: )"
-        << config.nclients << R"(
-  -t, --threads=<N>
-			  Number of native threads.
-			  Default: )"
-        << config.nthreads << R"(
-  -m, --max-concurrent-streams=<N>
-			  Max  concurrent  streams  to issue  per  session.   When
-			  http/1.1  is used,  this  specifies the  number of  HTTP
-			  pipelining requests in-flight.
-			  Default: 1
-  -H, --header=<HEADER>
-			  Add/Override a header to the requests.
-  -p, --no-tls-proto=<PROTOID>
-			  Specify ALPN identifier of the  protocol to be used when
-			  accessing http URI without SSL/TLS.
-			  Available protocols: )"
-        << NGHTTP2_CLEARTEXT_PROTO_VERSION_ID << R"( and )" << NGHTTP2_H1_1
-        << R"( and )" << SOFARPC << R"(
-			  Default: )"
-        << NGHTTP2_CLEARTEXT_PROTO_VERSION_ID << R"(
-  -d, --data=<PATH>
-			  Post FILE to  server.  The request method  is changed to
-			  POST.   For  http/1.1 connection,  if  -d  is used,  the
-			  maximum number of in-flight pipelined requests is set to
-			  1.
-  -r, --rate=<N>
-			  Specifies  the  fixed  rate  at  which  connections  are
-			  created.   The   rate  must   be  a   positive  integer,
-			  representing the  number of  connections to be  made per
-			  rate period.   The maximum  number of connections  to be
-			  made  is  given  in  -c   option.   This  rate  will  be
-			  distributed among  threads as  evenly as  possible.  For
-			  example,  with   -t2  and   -r4,  each  thread   gets  2
-			  connections per period.  When the rate is 0, the program
-			  will run  as it  normally does, creating  connections at
-			  whatever variable rate it  wants.  The default value for
-			  this option is 0.  -r and -D are mutually exclusive.
-  --rate-period=<DURATION>
-			  Specifies the time  period between creating connections.
-			  The period  must be a positive  number, representing the
-			  length of the period in time.  This option is ignored if
-			  the rate option is not used.  The default value for this
-			  option is 1s.
-  -D, --duration=<N>
-			  Specifies the main duration for the measurements in case
-			  of timing-based  benchmarking.  -D  and -r  are mutually
-			  exclusive.
-  --warm-up-time=<DURATION>
-			  Specifies the  time  period  before  starting the actual
-			  measurements, in  case  of  timing-based benchmarking.
-			  Needs to provided along with -D option.
-  -T, --connection-active-timeout=<DURATION>
-			  Specifies  the maximum  time that  h2load is  willing to
-			  keep a  connection open,  regardless of the  activity on
-			  said connection.  <DURATION> must be a positive integer,
-			  specifying the amount of time  to wait.  When no timeout
-			  value is  set (either  active or inactive),  h2load will
-			  keep  a  connection  open indefinitely,  waiting  for  a
-			  response.
-  -N, --connection-inactivity-timeout=<DURATION>
-			  Specifies the amount  of time that h2load  is willing to
-			  wait to see activity  on a given connection.  <DURATION>
-			  must  be a  positive integer,  specifying the  amount of
-			  time  to wait.   When no  timeout value  is set  (either
-			  active or inactive), h2load  will keep a connection open
-			  indefinitely, waiting for a response.
-  --h1        Short        hand         for        --npn-list=http/1.1
-			  --no-tls-proto=http/1.1,    which   effectively    force
-			  http/1.1 for both http and https URI.
-  --header-table-size=<SIZE>
-			  Specify decoder header table size.
-			  Default: )"
-        << util::utos_unit(config.header_table_size) << R"(
-  --encoder-header-table-size=<SIZE>
-			  Specify encoder header table size.  The decoder (server)
-			  specifies  the maximum  dynamic table  size it  accepts.
-			  Then the negotiated dynamic table size is the minimum of
-			  this option value and the value which server specified.
-			  Default: )"
-        << util::utos_unit(config.encoder_header_table_size) << R"(
-  -v, --verbose
-			  Output debug information.
-  --version   Display version information and exit.
-  -h, --help  Display this help and exit.
+bool Worker::requests_exhausted() const {
+    if (config->is_replay_mode()) {
+        // Other workers have records of their own.
+        return replay.done() && replay_due.empty();
+    }
+    return req_lease == 0 && total_req_left.load(std::memory_order_relaxed) == 0;
+}
 
---
+void Worker::process_req_stat(RequestStat *req_stat) {
+    if (!req_stat->completed) {
+        return;
+    }
+    stats.request_times.add(
+        std::chrono::duration_cast<std::chrono::duration<double>>(
+            req_stat->stream_close_time - req_stat->request_time)
+            .count());
+}
 
-  The <SIZE> argument is an integer and an optional unit (e.g., 10K is
-  10 * 1024).  Units are K, M and G (powers of 1024).
+void Worker::process_client_stat(ClientStat *cstat) {
+    if (recorded(cstat->client_start_time) &&
+        recorded(cstat->client_end_time)) {
+        auto t = std::chrono::duration_cast<std::chrono::duration<double>>(
+                     cstat->client_end_time - cstat->client_start_time)
+                     .count();
+        if (t > 1e-9) {
+            stats.rps_values.add(cstat->req_success / t);
+        }
+    }
 
-  The <DURATION> argument is an integer and an optional unit (e.g., 1s
-  is 1 second and 500ms is 500 milliseconds).  Units are h, m, s or ms
-  (hours, minutes, seconds and milliseconds, respectively).  If a unit
-  is omitted, a second is used as unit.)"
-        << std::endl;
+    // We will get connect event before FFTB.
+    if (!recorded(cstat->connect_start_time) ||
+        !recorded(cstat->connect_time)) {
+        return;
+    }
+
+    stats.connect_times.add(
+        std::chrono::duration_cast<std::chrono::duration<double>>(
+            cstat->connect_time - cstat->connect_start_time)
+            .count());
+
+    if (!recorded(cstat->ttfb)) {
+        return;
+    }
+
+    stats.ttfb_times.add(
+        std::chrono::duration_cast<std::chrono::duration<double>>(
+            cstat->ttfb - cstat->connect_start_time)
+            .count());
+}
+
+namespace {
+bool slower(const SlowRequest &a, const SlowRequest &b) {
+    return a.rtt > b.rtt;
 }
 } // namespace
 
-int main(int argc, char **argv) {
+void Worker::record_slow_request(uint64_t rtt_in_ns, const Client *client,
+                                 int32_t stream_id,
+                                 const RequestStat &req_stat, int status) {
+    auto n = config->slowest;
+    if (n == 0 || (slowest.size() == n && rtt_in_ns <= slowest[0].rtt)) {
+        return;
+    }
+    if (slowest.size() == n) {
+        std::pop_heap(std::begin(slowest), std::end(slowest), slower);
+        slowest.pop_back();
+    }
+    slowest.push_back(SlowRequest{rtt_in_ns, req_stat.request_wall_time, id,
+                                  client->id, stream_id, client->current_addr,
+                                  status});
+    std::push_heap(std::begin(slowest), std::end(slowest), slower);
+}
 
-    tls::libssl_init();
+void Worker::record_response_size(const RequestStat &req_stat,
+                                  uint64_t rtt_in_ns) {
+    auto i = config->no_tls_proto == Config::PROTO_SOFARPC
+                 ? static_cast<size_t>(req_stat.status)
+                 : static_cast<size_t>(req_stat.status) / 100;
+    auto &stat =
+        response_size_stats[std::min(i, response_size_stats.size() - 1)];
+    stat.total.record(req_stat.resp_bytes);
+    stat.header.record(req_stat.resp_header_bytes);
+    stat.classname.record(req_stat.resp_class_bytes);
+    stat.content.record(req_stat.resp_content_bytes);
+    size_rtt_hists[response_size_class(req_stat.resp_bytes)].record(rtt_in_ns);
+}
 
-    tls::LibsslGlobalLock lock;
+void Worker::record_decode(const Stream &stream) {
+    ++decode_stat.responses[stream.coding];
+    decode_stat.body_bytes[stream.coding] += stream.body_bytes;
+    if (stream.decode_error) {
+        ++decode_stat.errors;
+    } else if (stream.inflater) {
+        ++decode_stat.decoded;
+        decode_stat.decoded_bytes += stream.decoded_bytes;
+        decode_stat.decode_time += stream.decode_time;
+        decode_stat.decode_hist.record(stream.decode_time);
+    }
+}
 
-    std::string datafile;
+Inflater *Worker::get_inflater() {
+    if (free_inflaters.empty()) {
+        inflaters.push_back(std::make_unique<Inflater>());
+        free_inflaters.push_back(inflaters.back().get());
+    }
+    auto inflater = free_inflaters.back();
+    if (inflater->reset() != 0) {
+        return nullptr;
+    }
+    free_inflaters.pop_back();
+    return inflater;
+}
 
-    std::string sofaRpcClassname;
-    std::string sofaRpcHeaderArg;
-    std::string sofaRpcContent;
-    size_t sofaRpcTimeout;
+void Worker::put_inflater(Inflater *inflater) {
+    free_inflaters.push_back(inflater);
+}
 
-    while (1) {
-        static int flag = 0;
-        constexpr static option long_options[] = {
-            {"sofaRpcClassName", required_argument, nullptr, 'e'},
-            {"sofaRpcHeader", required_argument, nullptr, 'a'},
-            {"sofaRpcContent", required_argument, nullptr, 'o'},
-            {"sofaRpcTimeout", required_argument, nullptr, 'k'},
-            {"requests", required_argument, nullptr, 'n'},
-            {"clients", required_argument, nullptr, 'c'},
-            {"data", required_argument, nullptr, 'd'},
-            {"threads", required_argument, nullptr, 't'},
-            {"max-concurrent-streams", required_argument, nullptr, 'm'},
-            {"header", required_argument, nullptr, 'H'},
-            {"no-tls-proto", required_argument, nullptr, 'p'},
-            {"verbose", no_argument, nullptr, 'v'},
-            {"help", no_argument, nullptr, 'h'},
-            {"version", no_argument, &flag, 1},
-            {"rate", required_argument, nullptr, 'r'},
-            {"connection-active-timeout", required_argument, nullptr, 'T'},
-            {"connection-inactivity-timeout", required_argument, nullptr, 'N'},
-            {"duration", required_argument, nullptr, 'D'},
-            {"rate-period", required_argument, &flag, 5},
-            {"h1", no_argument, &flag, 6},
-            {"header-table-size", required_argument, &flag, 7},
-            {"encoder-header-table-size", required_argument, &flag, 8},
-            {"warm-up-time", required_argument, &flag, 9},
-            {"qps", required_argument, &flag, 11},
-            {nullptr, 0, nullptr, 0}};
-        int option_index = 0;
-        auto c =
-            getopt_long(argc, argv, "hv:c:d:m:n:p:t:H:r:T:N:D:e:a:o:k:",
-                        long_options, &option_index);
-        if (c == -1) {
-            break;
+void Worker::record_rtt(uint64_t rtt_in_ns) {
+    rtt_hist.record(rtt_in_ns);
+    if (timeline_queue) {
+        timeline_rtt_hist.record(rtt_in_ns);
+    }
+}
+
+void Worker::sample_tcp_info(Client *client) {
+    TcpInfo info;
+    if (get_tcp_info(client->fd, info) != 0) {
+        return;
+    }
+    auto prev = client->has_tcp_info ? &client->tcp_info : nullptr;
+    tcp_info_stat.add(info, prev);
+    if (timeline_queue) {
+        timeline_tcp_info.add(info, prev);
+    }
+    tcp_rtt_hist.record(static_cast<uint64_t>(info.rtt) * 1000);
+    client->tcp_info = info;
+    client->has_tcp_info = true;
+}
+
+void Worker::push_timeline_sample(bool final) {
+    TimelineSample sample(config->latency_precision);
+    sample.seq = timeline_seq++;
+    sample.time = std::chrono::duration_cast<std::chrono::duration<double>>(
+                      std::chrono::steady_clock::now() - timeline_start)
+                      .count();
+    sample.start = timeline_base.time;
+    sample.req_done = stats.req_done - timeline_base.req_done;
+    sample.req_status_success =
+        stats.req_status_success - timeline_base.req_status_success;
+    sample.req_failed = stats.req_failed - timeline_base.req_failed;
+    sample.req_error = stats.req_error - timeline_base.req_error;
+    sample.bytes_total = stats.bytes_total - timeline_base.bytes_total;
+    sample.bytes_sent = stats.bytes_sent - timeline_base.bytes_sent;
+    for (size_t i = 0; i < sample.sofarpc_status.size(); ++i) {
+        sample.sofarpc_status[i] =
+            stats.sofarpcStatus[i] - timeline_base.sofarpc_status[i];
+    }
+    for (auto client : clients) {
+        if (client) {
+            sample.req_inflight += client->req_inflight;
+            if (client->state == CLIENT_CONNECTED) {
+                ++sample.nconns;
+            }
         }
-        switch (c) {
-        case 'n':
-            config.nreqs = strtoul(optarg, nullptr, 10);
-            break;
-        case 'c':
-            config.nclients = strtoul(optarg, nullptr, 10);
-            break;
-        case 'd':
-            datafile = optarg;
-            break;
-        case 't':
-            config.nthreads = strtoul(optarg, nullptr, 10);
-            break;
-        case 'm':
-            config.max_concurrent_streams = strtoul(optarg, nullptr, 10);
-            break;
-        case 'H': {
+    }
+    sample.busy_time = loop_stat.busy_time;
+    if (sample.time > timeline_base.time) {
+        sample.busy = (sample.busy_time - timeline_base.busy_time) /
+                      ((sample.time - timeline_base.time) * 1e9);
+    }
+    sample.final = final;
+    auto main = current_phase == Phase::MAIN_DURATION;
+    sample.measured = timeline_main && main && !final;
+    timeline_main = main;
+    std::swap(sample.rtt_hist, timeline_rtt_hist);
+    std::swap(sample.tcp_info, timeline_tcp_info);
+
+    timeline_base.req_done = stats.req_done;
+    timeline_base.req_status_success = stats.req_status_success;
+    timeline_base.req_failed = stats.req_failed;
+    timeline_base.req_error = stats.req_error;
+    timeline_base.bytes_total = stats.bytes_total;
+    timeline_base.bytes_sent = stats.bytes_sent;
+    timeline_base.time = sample.time;
+    timeline_base.busy_time = sample.busy_time;
+    std::copy(std::begin(stats.sofarpcStatus), std::end(stats.sofarpcStatus),
+              std::begin(timeline_base.sofarpc_status));
+
+    if (!timeline_queue->push(std::move(sample))) {
+        ++timeline_dropped;
+    }
+}
+
+void Worker::record_corrected_rtt(uint64_t rtt_in_ns) {
+    corrected_rtt_hist.record(rtt_in_ns);
+}
+
+void Worker::record_wire_rtt(uint64_t wire_rtt_in_ns, uint64_t rtt_in_ns) {
+    wire_rtt_hist.record(wire_rtt_in_ns);
+    wire_rtt_sum += wire_rtt_in_ns;
+    wire_app_rtt_sum += rtt_in_ns;
+}
+
+void Worker::add_qps_quota(std::chrono::steady_clock::time_point due,
+                           uint64_t n) {
+    if (n == 0) {
+        return;
+    }
+    if (!qps_due.empty() && qps_due.back().first == due) {
+        qps_due.back().second += n;
+    } else {
+        qps_due.emplace_back(due, n);
+    }
+    qpsLeft += n;
+}
+
+void QpsPool::init(size_t nslots) {
+    slots_ = std::make_unique<Slot[]>(nslots);
+    nslots_ = nslots;
+}
+
+void QpsPool::give(size_t id, std::chrono::steady_clock::time_point due,
+                   uint64_t n) {
+    auto &slot = slots_[id];
+    if (slot.n.fetch_add(n) == 0) {
+        slot.due.store(due.time_since_epoch().count());
+    }
+}
+
+uint64_t QpsPool::take(size_t id, uint64_t n,
+                       std::chrono::steady_clock::time_point &due,
+                       bool own) {
+    auto first = own ? 0 : 1;
+    auto last = own ? 1 : nslots_;
+    for (size_t i = first; i < last; ++i) {
+        auto &slot = slots_[(id + i) % nslots_];
+        auto have = slot.n.load(std::memory_order_relaxed);
+        uint64_t k;
+        do {
+            if (have == 0) {
+                break;
+            }
+            k = std::min(have, n);
+        } while (!slot.n.compare_exchange_weak(have, have - k));
+        if (have == 0) {
+            continue;
+        }
+        // The due time is that of the oldest request in the slot, so
+        // it can only overstate the corrected latency.
+        due = std::chrono::steady_clock::time_point(
+            std::chrono::steady_clock::duration(slot.due.load()));
+        return k;
+    }
+    return 0;
+}
+
+void QpsPool::clear(size_t id) { slots_[id].n.store(0); }
+
+void QpsPool::set_hungry(bool hungry) {
+    if (hungry) {
+        ++nhungry_;
+    } else {
+        --nhungry_;
+    }
+}
+
+bool QpsPool::hungry() const {
+    return nhungry_.load(std::memory_order_relaxed) > 0;
+}
+
+uint64_t Worker::take_qps_quota(uint64_t n, bool own_only) {
+    if (!qps_pool.enabled()) {
+        return 0;
+    }
+    std::chrono::steady_clock::time_point due;
+    auto k = qps_pool.take(id, n, due, true);
+    if (k) {
+        qps_given -= k;
+    } else if (!own_only) {
+        k = qps_pool.take(id, n, due, false);
+        qps_taken += k;
+    }
+    if (k) {
+        add_qps_quota(due, k);
+    }
+    return k;
+}
+
+void Worker::give_qps_quota() {
+    if (qpsLeft == 0) {
+        return;
+    }
+    auto due = qps_due.empty() ? std::chrono::steady_clock::now()
+                               : qps_due.front().first;
+    qps_pool.give(id, due, qpsLeft);
+    qps_given += qpsLeft;
+    qpsLeft = 0;
+    qps_due.clear();
+}
+
+void Worker::set_qps_hungry(bool hungry) {
+    if (!qps_pool.enabled() || qps_hungry == hungry) {
+        return;
+    }
+    qps_hungry = hungry;
+    qps_pool.set_hungry(hungry);
+}
+
+std::chrono::steady_clock::time_point Worker::pop_qps_due() {
+    if (qps_due.empty()) {
+        return std::chrono::steady_clock::now();
+    }
+    auto &front = qps_due.front();
+    auto t = front.first;
+    if (--front.second == 0) {
+        qps_due.pop_front();
+    }
+    return t;
+}
+
+void Worker::set_qps_counts(std::vector<size_t> qps_count) {
+    qps_counts_ = qps_count;
+}
+
+void Worker::set_qps_rate(double rate) { qps_rate = rate; }
+
+void Worker::update_qps_rate(std::chrono::steady_clock::time_point t) {
+    if (config->is_slo_search_mode()) {
+        qps_rate = slo_search.target_qps.load(std::memory_order_relaxed) *
+                   qps_share;
+        return;
+    }
+    if (config->qps_profile.empty()) {
+        return;
+    }
+    qps_rate = config->qps_at(
+                   std::chrono::duration_cast<std::chrono::duration<double>>(
+                       t - qps_start_time)
+                       .count()) *
+               qps_share;
+}
+
+bool Worker::accept_arrival(std::chrono::steady_clock::time_point t) {
+    if (!config->is_dynamic_qps()) {
+        return true;
+    }
+    update_qps_rate(t);
+    if (config->qps_arrival != ArrivalProcess::POISSON) {
+        return true;
+    }
+    return std::uniform_real_distribution<double>(0., config->qps * qps_share)(
+               arrival_gen) < qps_rate;
+}
+
+void Worker::process_phase_stat(const RequestStat *req_stat, bool success) {
+    if (!recorded(req_stat->intended_time)) {
+        return;
+    }
+    auto &phase_stat =
+        config->is_slo_search_mode()
+            ? step_stat
+            : phase_stats[config->qps_phase_at(
+                  std::chrono::duration_cast<std::chrono::duration<double>>(
+                      req_stat->intended_time - qps_start_time)
+                      .count())];
+    ++phase_stat.req_done;
+    if (!success) {
+        return;
+    }
+    ++phase_stat.req_status_success;
+    phase_stat.rtt_hist.record(
+        to_latency(req_stat->stream_close_time - req_stat->request_time));
+    phase_stat.corrected_rtt_hist.record(
+        to_latency(req_stat->stream_close_time - req_stat->intended_time));
+}
+
+void Worker::set_sweep_cell(size_t i) {
+    sweep_cell = i;
+    sweep_clients =
+        sweep_share(config->sweep[i].nclients, config->nthreads, id);
+    for (auto client : clients) {
+        if (client && client->state == CLIENT_CONNECTED && client->session) {
+            client->fill_streams();
+        }
+    }
+}
+
+bool Worker::sweep_allows(const Client &client) const {
+    return client.id < sweep_clients &&
+           client.streams.size() < config->sweep[sweep_cell].nstreams;
+}
+
+void Worker::process_sweep_stat(const RequestStat *req_stat, bool success) {
+    auto t = std::chrono::duration_cast<std::chrono::duration<double>>(
+                 req_stat->request_time - sweep_start)
+                 .count();
+    if (t < 0.) {
+        return;
+    }
+    auto i = std::min(static_cast<size_t>(t / config->sweep_step),
+                      sweep_stats.size() - 1);
+    if (t - i * config->sweep_step < config->sweep_settle) {
+        return;
+    }
+    auto &stat = sweep_stats[i];
+    ++stat.req_done;
+    if (!success) {
+        return;
+    }
+    ++stat.req_status_success;
+    stat.rtt_hist.record(
+        to_latency(req_stat->stream_close_time - req_stat->request_time));
+}
+
+std::chrono::steady_clock::duration Worker::next_arrival_interval() {
+    double t;
+    switch (config->qps_arrival) {
+    case ArrivalProcess::POISSON:
+        // With --qps-profile, draw arrivals at the peak rate, and let
+        // accept_arrival() thin them out to the rate at the time.
+        t = std::exponential_distribution<double>(
+            config->is_dynamic_qps() ? config->qps * qps_share : qps_rate)(
+            arrival_gen);
+        break;
+    case ArrivalProcess::UNIFORM:
+        t = std::uniform_real_distribution<double>(0., 2. / qps_rate)(
+            arrival_gen);
+        break;
+    default:
+        t = 1. / qps_rate;
+        break;
+    }
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(t));
+}
+
+void Worker::start_qps_pacer() {
+    qps_start_time = std::chrono::steady_clock::now();
+    update_qps_rate(qps_start_time);
+
+    if (config->is_slo_search_mode()) {
+        ev_timer_again(loop, &step_watcher);
+    }
+
+    if (config->qps_arrival == ArrivalProcess::PERIODIC) {
+        ev_periodic_start(loop, &qpsUpdater);
+        return;
+    }
+    if (qps_rate <= 0. && !config->is_dynamic_qps()) {
+        return;
+    }
+    next_arrival =
+        std::chrono::steady_clock::now() + next_arrival_interval();
+    dispatch_arrivals(this);
+}
+
+void Worker::stop_qps_pacer() {
+    ev_periodic_stop(loop, &qpsUpdater);
+    ev_timer_stop(loop, &arrival_watcher);
+    ev_idle_stop(loop, &arrival_spinner);
+    ev_timer_stop(loop, &step_watcher);
+}
+
+void Worker::release_limited_clients() {
+    while (aimd.can_send() && !clientsBlockedByLimit.empty()) {
+        auto c = clientsBlockedByLimit.front();
+        clientsBlockedByLimit.pop();
+        // The connection may have closed, or filled up, since.
+        if (c->state != CLIENT_CONNECTED || !c->session ||
+            c->streams.size() >= visit_session(*c->session, [](auto &s) {
+                return s.max_concurrent_streams();
+            })) {
+            continue;
+        }
+        if (c->submit_request() != 0) {
+            c->process_request_failure();
+        }
+        c->signal_write();
+    }
+}
+
+std::chrono::steady_clock::time_point
+Worker::replay_due_time(const ReplayRecord &rec) const {
+    return replay_start +
+           std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+               std::chrono::duration<double, std::micro>(rec.time /
+                                                         config->replay_speed));
+}
+
+void Worker::start_replay() {
+    replay_start = std::chrono::steady_clock::now();
+    dispatch_replay(this);
+}
+
+void Worker::expire_deadlines() {
+    auto elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - deadline_start)
+                       .count();
+    deadlines.advance(elapsed / deadlines.tick(), [](DeadlineNode *node) {
+        static_cast<Client *>(node->data)->on_request_deadline(node->id);
+    });
+}
+
+void Worker::expire_thinks() {
+    auto elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - think_start)
+                       .count();
+    thinks.advance(elapsed / thinks.tick(), [](DeadlineNode *node) {
+        static_cast<Client *>(node->data)->on_think_over(node);
+    });
+}
+
+uint32_t Worker::start_call(Client *client, size_t tmpl) {
+    uint32_t idx;
+    if (free_calls.empty()) {
+        idx = calls.size();
+        calls.emplace_back();
+    } else {
+        idx = free_calls.back();
+        free_calls.pop_back();
+        calls[idx] = Call();
+    }
+    auto &call = calls[idx];
+    call.start = std::chrono::steady_clock::now();
+    call.tmpl = tmpl;
+    call.origin = client;
+    if (hedge_delay > 0.) {
+        // The wheel counts from its last tick, which is behind while
+        // the loop is busy, so the delay counts from now instead.
+        auto elapsed =
+            std::chrono::duration<double>(call.start - hedge_start).count();
+        auto behind = std::max(0., elapsed - hedges.now() * hedges.tick());
+        call.hedge.id = idx;
+        hedges.schedule_after(&call.hedge, hedge_delay + behind);
+    }
+    return idx;
+}
+
+void Worker::add_attempt(uint32_t idx, Client *client, int32_t stream_id,
+                         bool hedge) {
+    auto &call = calls[idx];
+    assert(call.ninflight < call.inflight.size());
+    call.inflight[call.ninflight++] = {client, stream_id, hedge,
+                                       std::chrono::steady_clock::now()};
+    ++call.nattempts;
+}
+
+Client *Worker::end_attempt(uint32_t idx, Client *client, int32_t stream_id,
+                            bool ok, bool overload, bool may_retry) {
+    auto &call = calls[idx];
+    auto first = std::begin(call.inflight);
+    auto last = first + call.ninflight;
+    auto it = std::find_if(first, last, [client, stream_id](const auto &a) {
+        return a.client == client && a.stream_id == stream_id;
+    });
+    if (it == last) {
+        return nullptr;
+    }
+    auto attempt = *it;
+    *it = call.inflight[--call.ninflight];
+
+    auto now = std::chrono::steady_clock::now();
+    if (ok && config->hedge_percentile > 0.) {
+        hedge_hist.record(to_latency(now - attempt.start));
+        // The percentile is taken again every so often, rather than
+        // for each response.
+        if (hedge_hist.count() % 100 == 0) {
+            hedge_delay =
+                hedge_hist.value_at_percentile(config->hedge_percentile) /
+                1e9;
+        }
+    }
+
+    if (call.done) {
+        // The loser of a call which has its response
+        if (call.ninflight == 0) {
+            free_calls.push_back(idx);
+        }
+        return nullptr;
+    }
+
+    if (!ok) {
+        if (overload && may_retry && call.retries < config->retry) {
+            auto c = select_attempt_client(idx, client, false);
+            if (c && c->submit_attempt(idx, false) == 0) {
+                ++call.retries;
+                if (current_phase == Phase::MAIN_DURATION) {
+                    ++stats.retries;
+                }
+                return nullptr;
+            }
+        }
+        if (call.ninflight) {
+            // Another attempt may still succeed.
+            return nullptr;
+        }
+    }
+
+    call.done = true;
+    call.hedge.unlink();
+    if (current_phase == Phase::MAIN_DURATION) {
+        ++stats.calls_done;
+        if (ok) {
+            ++stats.calls_success;
+            if (attempt.hedge) {
+                ++stats.hedges_won;
+            }
+        }
+        call_hist.record(to_latency(now - call.start));
+    }
+
+    auto origin = call.origin;
+    if (call.ninflight == 0) {
+        free_calls.push_back(idx);
+        return origin;
+    }
+    if (!config->hedge_cancel) {
+        // The losers are ignored when they are answered.
+        return origin;
+    }
+    // A cancelled attempt may end at once, and free the call, so the
+    // losers are taken out first.
+    auto losers = call.inflight;
+    auto nlosers = call.ninflight;
+    for (size_t i = 0; i < nlosers; ++i) {
+        auto c = losers[i].client;
+        if (c->session->cancel_stream(losers[i].stream_id) != 0) {
+            // HTTP/1.1 cannot cancel a request, and ignores it.
+            continue;
+        }
+        if (current_phase == Phase::MAIN_DURATION) {
+            ++stats.hedges_cancelled;
+        }
+        c->signal_write();
+    }
+    return origin;
+}
+
+void Worker::expire_hedges() {
+    auto elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - hedge_start)
+                       .count();
+    hedges.advance(elapsed / hedges.tick(),
+                   [this](DeadlineNode *node) { send_hedge(node->id); });
+}
+
+void Worker::send_hedge(uint32_t idx) {
+    auto &call = calls[idx];
+    if (call.done || call.hedged || call.ninflight == 0) {
+        return;
+    }
+    auto c = select_attempt_client(idx, call.inflight[0].client, true);
+    if (!c || c->submit_attempt(idx, true) != 0) {
+        return;
+    }
+    call.hedged = true;
+    if (current_phase == Phase::MAIN_DURATION) {
+        ++stats.hedges_sent;
+    }
+}
+
+namespace {
+// Returns true if |client| can take another attempt of |call|.  It
+// takes hedges and retries until it has twice as many requests in
+// flight as its session allows.
+bool takes_attempt(const Client *client, const Call &call) {
+    if (client->state != CLIENT_CONNECTED || !client->session ||
+        client->final || client->closing || client->churn_due() ||
+        client->streams.size() >=
+            2 * visit_session(*client->session, [](auto &s) {
+                return s.max_concurrent_streams();
+            })) {
+        return false;
+    }
+    auto first = std::begin(call.inflight);
+    auto last = first + call.ninflight;
+    return std::none_of(first, last, [client](const CallAttempt &a) {
+        return a.client == client;
+    });
+}
+} // namespace
+
+Client *Worker::select_attempt_client(uint32_t idx, Client *client,
+                                      bool other) {
+    auto &call = calls[idx];
+    Client *best = nullptr;
+    for (auto c : clients) {
+        if (c == client || !takes_attempt(c, call)) {
+            continue;
+        }
+        if (best == nullptr) {
+            best = c;
+            continue;
+        }
+        // Another endpoint first, and then the fewest requests in
+        // flight.
+        auto away = c->endpoint != client->endpoint;
+        auto best_away = best->endpoint != client->endpoint;
+        if (away != best_away ? away
+                              : c->streams.size() < best->streams.size()) {
+            best = c;
+        }
+    }
+    if (best == nullptr && !other && takes_attempt(client, call)) {
+        return client;
+    }
+    return best;
+}
+
+void Worker::orphan_calls(Client *client) {
+    for (auto &call : calls) {
+        if (call.origin == client) {
+            call.origin = nullptr;
+        }
+    }
+}
+
+void Worker::schedule_reconnect(Client *client, double delay) {
+    if (nreconnects++ == 0) {
+        // The wheel stands still while no client waits.
+        ev_timer_start(loop, &reconnect_watcher);
+    }
+    // The delay counts from now, rather than from the last tick.
+    expire_reconnects();
+    reconnects.schedule_after(&client->reconnect_node, delay);
+}
+
+void Worker::expire_reconnects() {
+    auto elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - reconnect_start)
+                       .count();
+    reconnects.advance(elapsed / reconnects.tick(), [this](DeadlineNode *node) {
+        --nreconnects;
+        static_cast<Client *>(node->data)->on_reconnect_due();
+    });
+    if (nreconnects == 0) {
+        ev_timer_stop(loop, &reconnect_watcher);
+    }
+}
+
+double Worker::draw_backoff(uint32_t attempt) {
+    auto backoff =
+        std::min(config->reconnect_cap,
+                 std::ldexp(config->reconnect_base,
+                            static_cast<int>(std::min(attempt, 62u))));
+    return std::uniform_real_distribution<double>(0., backoff)(reconnect_gen);
+}
+
+double Worker::draw_think_time(bool first) {
+    switch (config->think_model) {
+    case ThinkModel::EXPONENTIAL:
+        return std::exponential_distribution<double>(1. / config->think_time)(
+            think_gen);
+    case ThinkModel::EMPIRICAL:
+        return config->think_samples[std::uniform_int_distribution<size_t>(
+            0, config->think_samples.size() - 1)(think_gen)];
+    default:
+        if (first) {
+            return std::uniform_real_distribution<double>(
+                0., config->think_time)(think_gen);
+        }
+        return config->think_time;
+    }
+}
+
+void Worker::release_replay_clients() {
+    while (!replay_due.empty() && !clientsWaitingForReplay.empty()) {
+        auto c = clientsWaitingForReplay.front();
+        clientsWaitingForReplay.pop();
+        // The connection may have closed, or filled up, since.
+        if (c->state != CLIENT_CONNECTED || !c->session ||
+            c->streams.size() >= visit_session(*c->session, [](auto &s) {
+                return s.max_concurrent_streams();
+            })) {
+            continue;
+        }
+        if (c->submit_request() != 0) {
+            c->process_request_failure();
+        }
+        c->signal_write();
+    }
+}
+
+void Worker::close_replay_clients(const Client *sender) {
+    while (!clientsWaitingForReplay.empty()) {
+        auto c = clientsWaitingForReplay.front();
+        clientsWaitingForReplay.pop();
+        if (c != sender && c->state == CLIENT_CONNECTED && c->session &&
+            c->streams.empty()) {
+            c->terminate_session();
+        }
+    }
+}
+
+void Worker::release_blocked_clients() {
+    for (;;) {
+        while (qpsLeft && !clientsBlockedDueToQps.empty()) {
+            // Serve clients in the order they blocked, so that the
+            // quota is spread evenly over connections.
+            Client *c = clientsBlockedDueToQps.front();
+            clientsBlockedDueToQps.pop();
+            if (c->submit_request() != 0) {
+                c->process_request_failure();
+            }
+            c->signal_write();
+        }
+        if (clientsBlockedDueToQps.empty() ||
+            take_qps_quota(clientsBlockedDueToQps.size(), false) == 0) {
+            break;
+        }
+    }
+
+    set_qps_hungry(!clientsBlockedDueToQps.empty());
+
+    if (qpsLeft == 0) {
+        return;
+    }
+
+    if (config->qps_burst) {
+        // Count the quota this worker gave up, but nobody took, towards
+        // the burst as well.
+        take_qps_quota(std::numeric_limits<uint64_t>::max(), true);
+    }
+
+    if (config->qps_burst == 0 || qpsLeft <= config->qps_burst) {
+        if (qps_pool.hungry()) {
+            give_qps_quota();
+        }
+        return;
+    }
+
+    // No client is waiting for the quota.  Forget the oldest part of
+    // it, so that at most --qps-burst requests go out at once when
+    // clients become available.
+    auto excess = qpsLeft - config->qps_burst;
+    qpsLeft -= excess;
+    qps_dropped += excess;
+    while (excess && !qps_due.empty()) {
+        auto &front = qps_due.front();
+        auto n = std::min(excess, front.second);
+        excess -= n;
+        front.second -= n;
+        if (front.second == 0) {
+            qps_due.pop_front();
+        }
+    }
+
+    if (qps_pool.hungry()) {
+        give_qps_quota();
+    }
+}
+
+namespace {
+// Computes statistics from |stat|.  The min, max, mean, sd, and
+// percentage of number of samples within mean +/- sd are computed.
+// If |sampling| is true, this computes sample variance.  Otherwise,
+// population variance.
+SDStat compute_time_stat(const RunningStat &stat, bool sampling = false) {
+    if (stat.count() == 0) {
+        return {0.0, 0.0, 0.0, 0.0, 0.0};
+    }
+    auto sd = stat.sd(sampling);
+    return {stat.min(), stat.max(), stat.mean(), sd, stat.within_sd(sd)};
+}
+} // namespace
+
+namespace {
+// Adds the counters and time stats of |s| to |dst|.
+void merge_stats(Stats &dst, const Stats &s) {
+    dst.req_started += s.req_started;
+    dst.req_done += s.req_done;
+    dst.req_timedout += s.req_timedout;
+    dst.req_success += s.req_success;
+    dst.req_status_success += s.req_status_success;
+    dst.req_failed += s.req_failed;
+    dst.req_error += s.req_error;
+    dst.bytes_total += s.bytes_total;
+    dst.bytes_head += s.bytes_head;
+    dst.bytes_head_decomp += s.bytes_head_decomp;
+    dst.bytes_body += s.bytes_body;
+
+    for (size_t i = 0; i < dst.status.size(); ++i) {
+        dst.status[i] += s.status[i];
+    }
+    for (size_t i = 0; i < dst.sofarpcStatus.size(); ++i) {
+        dst.sofarpcStatus[i] += s.sofarpcStatus[i];
+    }
+    for (size_t i = 0; i < dst.grpcStatus.size(); ++i) {
+        dst.grpcStatus[i] += s.grpcStatus[i];
+    }
+
+    dst.request_times.merge(s.request_times);
+    dst.connect_times.merge(s.connect_times);
+    dst.ttfb_times.merge(s.ttfb_times);
+    dst.rps_values.merge(s.rps_values);
+
+    dst.stream_stalls += s.stream_stalls;
+    dst.stream_stall_time += s.stream_stall_time;
+    dst.conn_stalls += s.conn_stalls;
+    dst.conn_stall_time += s.conn_stall_time;
+    dst.stream_messages += s.stream_messages;
+    dst.bytes_sent += s.bytes_sent;
+    dst.write_blocks += s.write_blocks;
+    dst.write_block_time += s.write_block_time;
+    dst.churn_closes += s.churn_closes;
+    dst.churn_lost += s.churn_lost;
+    dst.calls_done += s.calls_done;
+    dst.calls_success += s.calls_success;
+    dst.hedges_sent += s.hedges_sent;
+    dst.hedges_won += s.hedges_won;
+    dst.hedges_cancelled += s.hedges_cancelled;
+    dst.retries += s.retries;
+    dst.max_stream_window =
+        std::max(dst.max_stream_window, s.max_stream_window);
+    dst.max_conn_window = std::max(dst.max_conn_window, s.max_conn_window);
+}
+} // namespace
+
+namespace {
+SDStats process_time_stats(const Stats &stats) {
+    return {compute_time_stat(stats.request_times),
+            compute_time_stat(stats.connect_times),
+            compute_time_stat(stats.ttfb_times),
+            compute_time_stat(stats.rps_values)};
+}
+} // namespace
+
+namespace {
+struct RunRates {
+    double rps;
+    int64_t bps;
+    // The bytes written per second, which --oneway reports
+    int64_t sent_bps;
+    // The requests which succeeded per second, which --aimd reports
+    double goodput;
+};
+} // namespace
+
+namespace {
+// Returns the rates of |stats| over |duration|, or over the main
+// duration with -D.
+RunRates compute_rates(const Stats &stats,
+                       std::chrono::microseconds duration) {
+    RunRates r{};
+    if (duration.count() > 0) {
+        if (config.is_timing_based_mode()) {
+            // we only want to consider the main duration if warm-up is given
+            r.rps = stats.req_success / config.duration;
+            r.bps = stats.bytes_total / config.duration;
+            r.sent_bps = stats.bytes_sent / config.duration;
+            r.goodput = stats.req_status_success / config.duration;
+        } else {
+            auto secd = std::chrono::duration_cast<
+                std::chrono::duration<double, std::chrono::seconds::period>>(
+                duration);
+            r.rps = stats.req_success / secd.count();
+            r.bps = stats.bytes_total / secd.count();
+            r.sent_bps = stats.bytes_sent / secd.count();
+            r.goodput = stats.req_status_success / secd.count();
+        }
+    }
+    return r;
+}
+} // namespace
+
+namespace {
+const char *clock_source_name(ClockSource clock) {
+    switch (clock) {
+    case ClockSource::TSC:
+        return "tsc";
+    case ClockSource::LOOP:
+        return "loop";
+    default:
+        return "steady";
+    }
+}
+} // namespace
+
+namespace {
+// Prints the summary of the run, which took |duration| to make
+// |total_req| requests.
+void print_summary(const Stats &stats, const SDStats &ts,
+                   std::chrono::microseconds duration, size_t total_req,
+                   const RunRates &rates) {
+    // UI is heavily inspired by weighttp[1] and wrk[2]
+    //
+    // [1] https://github.com/lighttpd/weighttp
+    // [2] https://github.com/wg/wrk
+    double header_space_savings = 0.;
+    if (stats.bytes_head_decomp > 0) {
+        header_space_savings = 1. - static_cast<double>(stats.bytes_head) /
+                                        stats.bytes_head_decomp;
+    }
+
+    if (config.clock_source == ClockSource::TSC) {
+        std::cout << std::fixed << std::setprecision(2)
+                  << "\nclock: tsc at " << 1. / config.tsc_ns_per_tick
+                  << "GHz, anchored every loop iteration; latencies within "
+                     "a few ppm";
+    } else if (config.clock_source == ClockSource::LOOP) {
+        std::cout << "\nclock: loop; timestamps are taken when the loop "
+                     "woke up, so latencies are off by up to one loop "
+                     "iteration";
+    }
+
+    std::cout << std::fixed << std::setprecision(2) << R"(
+finished in )" << util::format_duration(duration)
+              << ", " << rates.rps << " req/s, "
+              << util::utos_funit(rates.bps) << R"(B/s
+requests: )" << total_req
+              << " total, " << stats.req_started << " started, "
+              << stats.req_done << " done, " << stats.req_status_success
+              << " succeeded, " << stats.req_failed << " failed, "
+              << stats.req_error << " errored, " << stats.req_timedout
+              << " timeout";
+
+    if (config.no_tls_proto == Config::PROTO_SOFARPC) {
+        std::cout
+            << std::fixed << std::setprecision(2) << R"(
+sofaRPC status codes: )"
+            << "\n\t" << stats.sofarpcStatus[RESPONSE_STATUS_SUCCESS]
+            << " success, " << stats.sofarpcStatus[RESPONSE_STATUS_ERROR]
+            << " error, "
+            << stats.sofarpcStatus[RESPONSE_STATUS_SERVER_EXCEPTION]
+            << " server exception, "
+            << stats.sofarpcStatus[RESPONSE_STATUS_UNKNOWN] << " unknown\n\t"
+            << stats.sofarpcStatus[RESPONSE_STATUS_SERVER_THREADPOOL_BUSY]
+            << " server threadpool busy, "
+            << stats.sofarpcStatus[RESPONSE_STATUS_ERROR_COMM]
+            << " error comm, "
+            << stats.sofarpcStatus[RESPONSE_STATUS_NO_PROCESSOR]
+            << " no processor, " << stats.sofarpcStatus[RESPONSE_STATUS_TIMEOUT]
+            << " timeout\n\t"
+            << stats.sofarpcStatus[RESPONSE_STATUS_CLIENT_SEND_ERROR]
+            << " client send error, "
+            << stats.sofarpcStatus[RESPONSE_STATUS_CODEC_EXCEPTION]
+            << " codec exception, "
+            << stats.sofarpcStatus[RESPONSE_STATUS_CONNECTION_CLOSED]
+            << " connection closed, "
+            << stats.sofarpcStatus[RESPONSE_STATUS_SERVER_SERIAL_EXCEPTION]
+            << " server serial exception\n\t"
+            << stats.sofarpcStatus[RESPONSE_STATUS_SERVER_DESERIAL_EXCEPTION]
+            << " server deserial exception";
+    } else {
+        std::cout << std::fixed << std::setprecision(2) << R"(
+status codes: )" << stats.status[2]
+                  << " 2xx, " << stats.status[3] << " 3xx, " << stats.status[4]
+                  << " 4xx, " << stats.status[5] << " 5xx";
+        if (config.grpc) {
+            std::cout << "\ngrpc status codes: ";
+            auto sep = "";
+            for (size_t i = 0; i < stats.grpcStatus.size(); ++i) {
+                if (stats.grpcStatus[i] == 0 && i != 0) {
+                    continue;
+                }
+                std::cout << sep << stats.grpcStatus[i] << " "
+                          << grpc_status_name(i);
+                sep = ", ";
+            }
+        }
+    }
+    std::cout << std::fixed << std::setprecision(2) << R"(
+traffic: )" << util::utos_funit(stats.bytes_total)
+              << "B (" << stats.bytes_total << ") total, "
+              << util::utos_funit(stats.bytes_head) << "B (" << stats.bytes_head
+              << ") headers (space savings " << header_space_savings * 100
+              << "%), " << util::utos_funit(stats.bytes_body) << "B ("
+              << stats.bytes_body << R"() data
+                     min         max         mean         sd        +/- sd
+time for request: )"
+              << std::setw(10) << util::format_duration(ts.request.min) << "  "
+              << std::setw(10) << util::format_duration(ts.request.max) << "  "
+              << std::setw(10) << util::format_duration(ts.request.mean) << "  "
+              << std::setw(10) << util::format_duration(ts.request.sd)
+              << std::setw(9) << util::dtos(ts.request.within_sd) << "%"
+              << "\ntime for connect: " << std::setw(10)
+              << util::format_duration(ts.connect.min) << "  " << std::setw(10)
+              << util::format_duration(ts.connect.max) << "  " << std::setw(10)
+              << util::format_duration(ts.connect.mean) << "  " << std::setw(10)
+              << util::format_duration(ts.connect.sd) << std::setw(9)
+              << util::dtos(ts.connect.within_sd) << "%"
+              << "\nreq/s           : " << std::setw(10) << ts.rps.min << "  "
+              << std::setw(10) << ts.rps.max << "  " << std::setw(10)
+              << ts.rps.mean << "  " << std::setw(10) << ts.rps.sd
+              << std::setw(9) << util::dtos(ts.rps.within_sd) << "%"
+              << std::endl;
+}
+} // namespace
+
+namespace {
+// Formats |ns| nanoseconds of latency.  Unlike
+// util::format_duration, this keeps the fraction of a microsecond.
+std::string format_latency(uint64_t ns) {
+    if (ns < 1000) {
+        return util::utos(ns) + "ns";
+    }
+    if (ns < 1000000) {
+        return util::dtos(ns / 1000.) + "us";
+    }
+    return util::format_duration(ns / 1e9);
+}
+
+// Formats |percentile| with as few digits as needed, like "99.99".
+std::string format_percentile(double percentile) {
+    std::ostringstream oss;
+    oss << std::setprecision(10) << percentile;
+    return oss.str();
+}
+
+std::string format_percentiles(const std::vector<double> &percentiles) {
+    std::string s;
+    for (auto p : percentiles) {
+        if (!s.empty()) {
+            s += ',';
+        }
+        s += format_percentile(p);
+    }
+    return s;
+}
+
+// Parses the comma separated list of percentiles in |s|.  Returns -1
+// if it is malformed.
+int parse_percentiles(std::vector<double> &percentiles, const char *s) {
+    percentiles.clear();
+    for (auto &v : util::split_str(StringRef{s}, ',')) {
+        auto str = v.str();
+        char *end;
+        errno = 0;
+        auto p = strtod(str.c_str(), &end);
+        if (str.empty() || errno != 0 || *end != '\0' || !(p > 0.) ||
+            p > 100.) {
+            return -1;
+        }
+        percentiles.push_back(p);
+    }
+    if (percentiles.empty()) {
+        return -1;
+    }
+    std::sort(std::begin(percentiles), std::end(percentiles));
+    percentiles.erase(std::unique(std::begin(percentiles), std::end(percentiles)),
+                      std::end(percentiles));
+    return 0;
+}
+
+// Prints percentiles of |hist|, which holds round trip times in
+// nanoseconds.
+void print_latency_distribution(const char *title, const Histogram &hist) {
+    std::cout << "\n  " << title << std::endl;
+    for (auto percentile : config.percentiles) {
+        std::cout << std::setw(8) << format_percentile(percentile) + "%"
+                  << std::setw(13)
+                  << format_latency(hist.value_at_percentile(percentile))
+                  << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// Returns the resident set size of this process in bytes, or its peak
+// so far if |peak| is true.  Returns 0 if it is unknown.
+uint64_t get_rss(bool peak) {
+    std::ifstream f("/proc/self/status");
+    auto key = peak ? "VmHWM:" : "VmRSS:";
+    std::string line;
+    while (std::getline(f, line)) {
+        if (util::starts_with(line, StringRef{key})) {
+            // In kB
+            return strtoull(line.c_str() + strlen(key), nullptr, 10) * 1024;
+        }
+    }
+    return 0;
+}
+} // namespace
+
+namespace {
+// Returns the memory the workers took per client at the peak, to size
+// hosts for many connections.
+uint64_t memory_per_client() {
+    if (rss_peak <= rss_start || config.nclients == 0) {
+        return 0;
+    }
+    return (rss_peak - rss_start) / config.nclients;
+}
+} // namespace
+
+namespace {
+// SlabPool statistics summed over workers
+struct PoolStat {
+    uint64_t nget, nmiss;
+    // The sum of the peaks of workers, which may not have been at the
+    // same time
+    size_t peak_used;
+    // The weakest backing any worker got
+    SlabBacking backing;
+};
+} // namespace
+
+namespace {
+PoolStat get_pool_stat(const std::vector<Worker *> &workers) {
+    PoolStat st{0, 0, 0, config.chunk_backing};
+    for (auto worker : workers) {
+        auto &pool = worker->mcpool;
+        st.nget += pool.nget;
+        st.nmiss += pool.nmiss;
+        st.peak_used += pool.peak_used;
+        st.backing = std::min(st.backing, pool.backing);
+    }
+    return st;
+}
+} // namespace
+
+namespace {
+const char *backing_name(SlabBacking backing) {
+    switch (backing) {
+    case SlabBacking::THP:
+        return "thp";
+    case SlabBacking::HUGETLB:
+        return "hugetlb";
+    default:
+        return "pages";
+    }
+}
+} // namespace
+
+namespace {
+// Prints how much memory the workers took.
+void print_memory_stat(const std::vector<Worker *> &workers) {
+    auto st = get_pool_stat(workers);
+    std::cout << "\nbuffer pool: " << util::utos_funit(config.chunk_size)
+              << "B chunks in " << backing_name(st.backing) << ", " << st.nget
+              << " gets, " << std::fixed << std::setprecision(2)
+              << (st.nget ? 100. * (st.nget - st.nmiss) / st.nget : 0.)
+              << "% recycled, peak " << st.peak_used << " chunks ("
+              << util::utos_funit(st.peak_used * config.chunk_size)
+              << "B) in use";
+    if (st.backing != config.chunk_backing) {
+        std::cout << " (asked for " << backing_name(config.chunk_backing)
+                  << ")";
+    }
+    std::cout << std::endl;
+
+    uint64_t h2_alloc = 0, h2_reuse = 0;
+    size_t h2_slabs = 0;
+    for (auto worker : workers) {
+        h2_alloc += worker->h2_mem.nalloc;
+        h2_reuse += worker->h2_mem.nreuse;
+        h2_slabs += worker->h2_mem.slabs.size();
+    }
+    if (h2_alloc) {
+        std::cout << "nghttp2 pool: " << h2_alloc << " allocs, " << std::fixed
+                  << std::setprecision(2) << 100. * h2_reuse / h2_alloc
+                  << "% recycled, " << h2_slabs << " slabs" << std::endl;
+    }
+
+    if (rss_peak == 0) {
+        return;
+    }
+    std::cout << "memory: " << util::utos_funit(rss_peak)
+              << "B peak RSS, " << util::utos_funit(memory_per_client())
+              << "B per client over " << config.nclients
+              << " clients (Client " << sizeof(Client) << "B)" << std::endl;
+}
+} // namespace
+
+namespace {
+// The limits of --aimd summed over the workers
+struct AimdSummary {
+    // The limit at the end, and its mean over the answers in the main
+    // duration
+    double limit, mean_limit;
+    uint64_t backoffs;
+};
+
+AimdSummary get_aimd_summary(const std::vector<Worker *> &workers) {
+    AimdSummary sum{};
+    for (auto worker : workers) {
+        sum.limit += worker->aimd.value();
+        sum.mean_limit += worker->aimd_samples
+                              ? worker->aimd_limit_sum / worker->aimd_samples
+                              : worker->aimd.value();
+        sum.backoffs += worker->aimd.backoffs();
+    }
+    return sum;
+}
+} // namespace
+
+namespace {
+// Prints where --aimd settled, and the rate of requests which
+// succeeded at that concurrency.
+void print_aimd(const std::vector<Worker *> &workers, double goodput) {
+    auto sum = get_aimd_summary(workers);
+    std::cout << "\naimd: " << std::fixed << std::setprecision(2)
+              << sum.limit << " requests in flight at the end, "
+              << sum.mean_limit << " on average, backed off " << sum.backoffs
+              << " times\ngoodput: " << goodput << " req/s" << std::endl;
+}
+} // namespace
+
+namespace {
+// Returns the number of records of --replay the workers sent.
+uint64_t get_replay_sent(const std::vector<Worker *> &workers) {
+    uint64_t sent = 0;
+    for (auto worker : workers) {
+        sent += worker->req_sent;
+    }
+    return sent;
+}
+} // namespace
+
+namespace {
+// Prints how much of the capture of --replay was sent.  How far behind
+// the capture the requests fell is in the corrected latency.
+void print_replay(const std::vector<Worker *> &workers) {
+    std::cout << "\nreplay: sent " << get_replay_sent(workers) << " of "
+              << config.replay.size() << " records, spanning "
+              << util::format_duration(config.replay.duration() / 1e6)
+              << " of capture, at " << std::fixed << std::setprecision(2)
+              << config.replay_speed << "x speed" << std::endl;
+}
+} // namespace
+
+namespace {
+// Prints what --oneway sent.  No response tells how the server fared,
+// so the time the socket buffers were full is the sign of the server
+// falling behind.
+void print_oneway(const Stats &stats, double rps, int64_t sent_bps) {
+    std::cout << "\noneway: sent " << stats.req_done << " requests, "
+              << util::utos_funit(stats.bytes_sent) << "B, " << std::fixed
+              << std::setprecision(2) << rps << " req/s, "
+              << util::utos_funit(sent_bps) << "B/s" << std::endl;
+    std::cout << "writes blocked " << stats.write_blocks << " times for "
+              << util::format_duration(stats.write_block_time / 1e9)
+              << " in total" << std::endl;
+}
+} // namespace
+
+namespace {
+// Prints how long HTTP/2 flow control windows held the server back.
+// If it is a noticeable share of the request time, the run measures
+// the windows rather than the server.
+void print_flow_control(const Stats &stats) {
+    std::cout << "\nflow control: streams blocked " << stats.stream_stalls
+              << " times for "
+              << util::format_duration(stats.stream_stall_time / 1e9)
+              << " in total, connections blocked " << stats.conn_stalls
+              << " times for "
+              << util::format_duration(stats.conn_stall_time / 1e9)
+              << " in total" << std::endl;
+    if (config.window_auto_tune) {
+        std::cout << "windows auto-tuned up to "
+                  << util::utos_funit(stats.max_stream_window)
+                  << "B per stream, "
+                  << util::utos_funit(stats.max_conn_window)
+                  << "B per connection" << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// Prints the round trip times of PINGs, which the server answers
+// without the application.
+void print_ping_latency(const std::vector<Worker *> &workers) {
+    Histogram hist(config.latency_precision);
+    for (auto worker : workers) {
+        hist.merge(worker->ping_rtt_hist);
+    }
+    if (hist.count() == 0) {
+        std::cout << "\nwarning: no PING was answered.  HTTP/1.1 "
+                     "connections send none."
+                  << std::endl;
+        return;
+    }
+    print_latency_distribution("PING Latency  Distribution", hist);
+}
+} // namespace
+
+namespace {
+// Prints how many requests passed --request-timeout, and how long
+// they were in flight until they were given up.
+void print_request_timeouts(const Stats &stats,
+                            const std::vector<Worker *> &workers) {
+    Histogram hist(config.latency_precision);
+    for (auto worker : workers) {
+        hist.merge(worker->timeout_hist);
+    }
+    std::cout << "\nrequest timeouts: " << stats.req_timedout
+              << " requests timed out after "
+              << util::format_duration(config.request_timeout) << std::endl;
+    if (hist.count()) {
+        print_latency_distribution("Timed Out Request  Distribution", hist);
+    }
+}
+} // namespace
+
+namespace {
+// Returns the number of requests sent per call, with --hedge or
+// --retry.
+double get_amplification(const Stats &stats) {
+    return stats.calls_done ? static_cast<double>(stats.req_started) /
+                                  stats.calls_done
+                            : 0.;
+}
+} // namespace
+
+namespace {
+// Prints the calls of --hedge and --retry, and the latency their users
+// saw, which is that of the first successful attempt.  The latency
+// distribution above is that of each attempt.
+void print_calls(const Stats &stats, const std::vector<Worker *> &workers) {
+    Histogram hist(config.latency_precision);
+    for (auto worker : workers) {
+        hist.merge(worker->call_hist);
+    }
+    std::cout << "\ncalls: " << stats.calls_done << " done, "
+              << stats.calls_success << " succeeded, " << stats.req_started
+              << " attempts, " << std::fixed << std::setprecision(2)
+              << get_amplification(stats) << "x amplification\n"
+              << "hedges: " << stats.hedges_sent << " sent, "
+              << stats.hedges_won << " won, " << stats.hedges_cancelled
+              << " cancelled; retries: " << stats.retries << std::endl;
+    print_latency_distribution("User-Visible Latency  Distribution", hist);
+}
+} // namespace
+
+namespace {
+// Prints how the responses of SofaRPC server streams arrived.  The
+// latency of a stream, which is in the latency distribution, is that
+// of its last response.
+void print_stream_latency(const Stats &stats,
+                          const std::vector<Worker *> &workers) {
+    Histogram first(config.latency_precision);
+    Histogram gap(config.latency_precision);
+    for (auto worker : workers) {
+        first.merge(worker->first_message_hist);
+        gap.merge(worker->message_gap_hist);
+    }
+    std::cout << "\nserver streams: " << stats.req_done << " done, "
+              << stats.stream_messages << " responses, " << std::fixed
+              << std::setprecision(2)
+              << (first.count() ? static_cast<double>(stats.stream_messages) /
+                                      first.count()
+                                : 0.)
+              << " per stream" << std::endl;
+    print_latency_distribution("First Response Latency  Distribution",
+                               first);
+    print_latency_distribution("Inter-Response Gap  Distribution", gap);
+}
+} // namespace
+
+namespace {
+// Prints the round trip times taken from kernel timestamps, and how
+// much sofaload added on top of them.
+void print_wire_latency(const std::vector<Worker *> &workers) {
+    Histogram hist(config.latency_precision);
+    uint64_t wire_sum = 0, app_sum = 0;
+    for (auto worker : workers) {
+        hist.merge(worker->wire_rtt_hist);
+        wire_sum += worker->wire_rtt_sum;
+        app_sum += worker->wire_app_rtt_sum;
+    }
+    if (hist.count() == 0) {
+        std::cout << "\nwarning: no request got kernel timestamps for both "
+                     "directions"
+                  << std::endl;
+        return;
+    }
+    print_latency_distribution(
+        "Wire Latency  Distribution (from kernel timestamps)", hist);
+    auto n = static_cast<double>(hist.count());
+    std::cout << "wire time for request: mean "
+              << format_latency(wire_sum / n)
+              << ", added by sofaload: mean "
+              << format_latency((app_sum - std::min(app_sum, wire_sum)) / n)
+              << " (" << hist.count() << " requests)" << std::endl;
+}
+} // namespace
+
+namespace {
+// Prints the TCP_INFO samples of --tcp-info of each worker, so that
+// latency tails can be told apart from retransmits, small congestion
+// windows, or a full receive window or send buffer.
+void print_tcp_info(const std::vector<Worker *> &workers) {
+    std::cout << "\n  TCP Info (sampled every "
+              << util::format_duration(config.tcp_info_interval) << ")\n"
+              << "  worker   samples   srtt p50   srtt p99   srtt max"
+                 "    rttvar   cwnd mean  cwnd min  retrans  rwnd lim"
+                 "  sndbuf lim"
+              << std::endl;
+    auto print_row = [](const std::string &name, const TcpInfoStat &stat,
+                        const Histogram &hist) {
+        auto limited = [&stat](double ratio) -> std::string {
+            if (stat.busy_time == 0) {
+                return "-";
+            }
+            std::ostringstream ss;
+            ss << std::fixed << std::setprecision(1) << ratio * 100 << "%";
+            return ss.str();
+        };
+        std::cout << std::fixed << std::setprecision(1) << std::setw(8)
+                  << name << std::setw(10) << stat.nsamples << std::setw(11)
+                  << format_latency(hist.value_at_percentile(50.))
+                  << std::setw(11)
+                  << format_latency(hist.value_at_percentile(99.))
+                  << std::setw(11)
+                  << format_latency(static_cast<uint64_t>(stat.rtt_max) * 1000)
+                  << std::setw(10)
+                  << format_latency(stat.mean_rttvar() * 1000) << std::setw(12)
+                  << stat.mean_cwnd() << std::setw(10) << stat.cwnd_min
+                  << std::setw(9) << stat.retrans << std::setw(10)
+                  << limited(stat.rwnd_limited_ratio()) << std::setw(12)
+                  << limited(stat.sndbuf_limited_ratio()) << std::endl;
+    };
+    TcpInfoStat total;
+    Histogram hist(config.latency_precision);
+    for (auto worker : workers) {
+        total.merge(worker->tcp_info_stat);
+        hist.merge(worker->tcp_rtt_hist);
+        print_row(util::utos(worker->id), worker->tcp_info_stat,
+                  worker->tcp_rtt_hist);
+    }
+    if (workers.size() > 1) {
+        print_row("all", total, hist);
+    }
+    if (total.nsamples == 0) {
+        std::cout << "warning: no connection reported TCP_INFO; it is only "
+                     "available for TCP on Linux"
+                  << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// Returns the numeric address and port of |addr|, "unix:" followed by
+// the path if it is a UNIX domain socket, or "-" if it is nullptr.
+// An abstract socket name is prefixed with "@".
+std::string format_addr(const addrinfo *addr) {
+    if (!addr) {
+        return "-";
+    }
+    if (addr->ai_family == AF_UNIX) {
+        auto un = reinterpret_cast<const sockaddr_un *>(addr->ai_addr);
+        auto pathlen = addr->ai_addrlen - offsetof(sockaddr_un, sun_path);
+        if (pathlen > 0 && un->sun_path[0] == '\0') {
+            return "unix:@" + std::string(un->sun_path + 1, pathlen - 1);
+        }
+        return std::string("unix:") + un->sun_path;
+    }
+    auto s = util::numeric_name(addr->ai_addr, addr->ai_addrlen);
+    if (addr->ai_family == AF_INET6) {
+        s = "[" + s + "]";
+    }
+    return s + ":" + util::utos(config.port);
+}
+
+// Prints the Config::slowest slowest requests of all workers.
+void print_slowest(const std::vector<Worker *> &workers) {
+    std::vector<SlowRequest> reqs;
+    for (auto worker : workers) {
+        reqs.insert(std::end(reqs), std::begin(worker->slowest),
+                    std::end(worker->slowest));
+    }
+    std::sort(std::begin(reqs), std::end(reqs), slower);
+    if (reqs.size() > config.slowest) {
+        reqs.resize(config.slowest);
+    }
+
+    std::cout << "\n  Slowest Requests\n"
+              << "      latency  sent at                     worker  client"
+                 "    stream  address                  status"
+              << std::endl;
+    for (auto &r : reqs) {
+        auto addr = format_addr(r.addr);
+        std::cout << std::setw(13) << format_latency(r.rtt) << "  "
+                  << std::left << std::setw(26)
+                  << util::format_iso8601(r.request_wall_time) << std::right
+                  << std::setw(6) << r.worker_id << std::setw(8) << r.client_id
+                  << std::setw(10) << r.stream_id << "  " << std::left
+                  << std::setw(23) << addr << std::right << std::setw(8)
+                  << (r.status == -1 ? std::string("-") : util::utos(r.status))
+                  << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// Returns the summary of the connections of each client of |workers|
+// with --imbalance.  Clients which never started are left out.
+std::vector<ConnSummary>
+get_conn_summaries(const std::vector<Worker *> &workers) {
+    std::vector<ConnSummary> conns;
+    for (auto worker : workers) {
+        for (auto client : worker->clients) {
+            if (!client) {
+                continue;
+            }
+            auto &cstat = client->cstat;
+            if (!recorded(cstat.client_start_time) ||
+                !recorded(cstat.client_end_time)) {
+                continue;
+            }
+            auto t = std::chrono::duration_cast<std::chrono::duration<double>>(
+                         cstat.client_end_time - cstat.client_start_time)
+                         .count();
+            auto &sketch = *cstat.rtt_sketch;
+            ConnSummary c{};
+            c.worker_id = worker->id;
+            c.client_id = client->id;
+            c.req_done = sketch.count();
+            c.req_failed = cstat.req_failed;
+            c.rps = t > 1e-9 ? (c.req_done - c.req_failed) / t : 0.;
+            c.mean = c.req_done ? cstat.rtt_sum / c.req_done : 0;
+            c.p99 = sketch.value_at_percentile(99.);
+            c.local_port = cstat.local_port;
+            c.address = format_addr(cstat.addr);
+            conns.push_back(std::move(c));
+        }
+    }
+    return conns;
+}
+} // namespace
+
+namespace {
+// Prints how evenly the requests spread over the connections, and the
+// --imbalance connections which strayed furthest from the median, to
+// tell a hot server thread or backend behind a single address.
+void print_imbalance(const std::vector<ConnSummary> &conns) {
+    auto stat = analyze_imbalance(conns, config.imbalance);
+
+    std::cout << "\n  Connection Imbalance (" << conns.size()
+              << " connections)\n"
+              << std::fixed << std::setprecision(3)
+              << "fairness (Jain's index): req/s " << stat.rps_fairness
+              << ", mean latency " << stat.latency_fairness << "\n"
+              << std::setprecision(2) << "median per connection: "
+              << stat.median_rps << " req/s, mean "
+              << format_latency(static_cast<uint64_t>(stat.median_mean))
+              << "\n"
+              << "  worker  client       done   failed      req/s       mean"
+                 "        p99     skew   local  address"
+              << std::endl;
+    for (auto i : stat.skewed) {
+        auto &c = conns[i];
+        auto skew = conn_skew(c, stat);
+        std::cout << std::setw(8) << c.worker_id << std::setw(8)
+                  << c.client_id << std::setw(11) << c.req_done
+                  << std::setw(9) << c.req_failed << std::setw(11) << c.rps
+                  << std::setw(11) << format_latency(c.mean) << std::setw(11)
+                  << format_latency(c.p99) << std::setw(9)
+                  << (std::isinf(skew) ? std::string("inf")
+                                       : util::dtos(skew) + "x")
+                  << std::setw(8)
+                  << (c.local_port ? util::utos(c.local_port)
+                                   : std::string("-"))
+                  << "  " << c.address << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// Returns the stats of each endpoint, summed over |workers|.
+std::vector<EndpointStat>
+get_endpoint_stats(const std::vector<Worker *> &workers) {
+    std::vector<EndpointStat> stats(config.endpoints.size(),
+                                    EndpointStat(config.latency_precision));
+    for (auto worker : workers) {
+        for (size_t i = 0; i < stats.size(); ++i) {
+            auto &s = worker->endpoint_stats[i];
+            stats[i].clients += s.clients;
+            stats[i].req_done += s.req_done;
+            stats[i].req_status_success += s.req_status_success;
+            stats[i].rtt_hist.merge(s.rtt_hist);
+        }
+    }
+    return stats;
+}
+} // namespace
+
+namespace {
+// Returns the name of |ep| in the report.
+std::string endpoint_name(const Endpoint &ep) {
+    auto name =
+        ep.host.find(':') == std::string::npos ? ep.host : "[" + ep.host + "]";
+    return name + ":" + util::utos(ep.port);
+}
+} // namespace
+
+namespace {
+// Returns the non-empty buckets of |hist|.
+std::vector<ResultBucket> to_buckets(const Histogram &hist) {
+    std::vector<ResultBucket> buckets;
+    for (size_t i = 0; i < hist.nbuckets(); ++i) {
+        if (auto n = hist.bucket_count(i)) {
+            buckets.push_back(
+                ResultBucket{hist.bucket_lowest(i), hist.bucket_highest(i), n});
+        }
+    }
+    return buckets;
+}
+} // namespace
+
+namespace {
+// Compares each endpoint but the first with the first with --ab, as
+// --compare compares results.  Endpoints with no latency to compare
+// are left out.  |duration| is the length of the measurement in
+// seconds.  Returns the comparison of each endpoint, indexed as
+// Config::endpoints.
+std::vector<std::unique_ptr<CompareResult>>
+get_ab_results(const std::vector<Worker *> &workers, double duration) {
+    auto stats = get_endpoint_stats(workers);
+    auto to_result = [duration](const EndpointStat &s) {
+        ResultData r;
+        r.values["rps"] = duration > 0 ? s.req_status_success / duration : 0.;
+        r.histograms["latency"] = to_buckets(s.rtt_hist);
+        return r;
+    };
+    CompareOptions opts{config.percentiles, config.max_rps_drop,
+                        config.max_latency_rise};
+    auto baseline = to_result(stats[0]);
+    std::vector<std::unique_ptr<CompareResult>> results(stats.size());
+    for (size_t i = 1; i < stats.size(); ++i) {
+        if (stats[0].rtt_hist.count() == 0 || stats[i].rtt_hist.count() == 0) {
+            continue;
+        }
+        auto res = std::make_unique<CompareResult>();
+        if (compare_results(*res, baseline, to_result(stats[i]), opts) == 0) {
+            results[i] = std::move(res);
+        }
+    }
+    return results;
+}
+} // namespace
+
+namespace {
+// Prints throughput and latency per endpoint.  |duration| is the
+// length of the measurement in seconds.
+void print_endpoint_stat(const std::vector<Worker *> &workers,
+                         double duration) {
+    auto stats = get_endpoint_stats(workers);
+
+    std::cout << "\n  Endpoints\n"
+              << "  endpoint                      weight  clients       done"
+                 "     failed      req/s        p50        p99        max"
+              << std::endl;
+    size_t slowest = 0;
+    for (size_t i = 0; i < stats.size(); ++i) {
+        auto &ep = config.endpoints[i];
+        auto &s = stats[i];
+        std::cout << "  " << std::left << std::setw(28) << endpoint_name(ep)
+                  << std::right
+                  << std::setw(8) << ep.weight << std::setw(9) << s.clients
+                  << std::setw(11) << s.req_done << std::setw(11)
+                  << s.req_done - s.req_status_success << std::fixed
+                  << std::setprecision(2) << std::setw(11)
+                  << (duration > 0 ? s.req_status_success / duration : 0.)
+                  << std::setw(11)
+                  << format_latency(s.rtt_hist.value_at_percentile(50.))
+                  << std::setw(11)
+                  << format_latency(s.rtt_hist.value_at_percentile(99.))
+                  << std::setw(11) << format_latency(s.rtt_hist.max())
+                  << std::endl;
+        if (s.rtt_hist.value_at_percentile(99.) >
+            stats[slowest].rtt_hist.value_at_percentile(99.)) {
+            slowest = i;
+        }
+    }
+    if (stats[slowest].rtt_hist.count()) {
+        auto &ep = config.endpoints[slowest];
+        std::cout << "slowest endpoint at p99: " << ep.host << ":" << ep.port
+                  << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// Returns the stats of the well-behaved and the slow readers, summed
+// over |workers|.
+std::vector<ReaderStat> get_reader_stats(const std::vector<Worker *> &workers) {
+    std::vector<ReaderStat> stats(2, ReaderStat(config.latency_precision));
+    for (auto worker : workers) {
+        for (size_t i = 0; i < stats.size(); ++i) {
+            auto &s = worker->reader_stats[i];
+            stats[i].clients += s.clients;
+            stats[i].req_done += s.req_done;
+            stats[i].req_status_success += s.req_status_success;
+            stats[i].bytes += s.bytes;
+            stats[i].rtt_hist.merge(s.rtt_hist);
+        }
+    }
+    return stats;
+}
+} // namespace
+
+namespace {
+constexpr const char *READER_NAMES[] = {"well-behaved", "slow"};
+} // namespace
+
+namespace {
+// Prints throughput and latency of the well-behaved and the slow
+// readers with --slow-read or --slow-read-pause.  |duration| is the
+// length of the measurement in seconds.
+void print_reader_stat(const std::vector<Worker *> &workers,
+                       double duration) {
+    auto stats = get_reader_stats(workers);
+
+    std::cout << "\n  Readers\n"
+              << "  reader        clients       done     failed      req/s"
+                 "       MB/s        p50        p99        max"
+              << std::endl;
+    for (size_t i = 0; i < stats.size(); ++i) {
+        auto &s = stats[i];
+        std::cout << "  " << std::left << std::setw(12) << READER_NAMES[i]
+                  << std::right << std::setw(9) << s.clients << std::setw(11)
+                  << s.req_done << std::setw(11)
+                  << s.req_done - s.req_status_success << std::fixed
+                  << std::setprecision(2) << std::setw(11)
+                  << (duration > 0 ? s.req_status_success / duration : 0.)
+                  << std::setw(11)
+                  << (duration > 0 ? s.bytes / duration / 1e6 : 0.)
+                  << std::setw(11)
+                  << format_latency(s.rtt_hist.value_at_percentile(50.))
+                  << std::setw(11)
+                  << format_latency(s.rtt_hist.value_at_percentile(99.))
+                  << std::setw(11) << format_latency(s.rtt_hist.max())
+                  << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// Returns the response sizes of each status with --response-sizes,
+// summed over |workers|, and the latency of each class of sizes in
+// |size_rtt_hists|.
+std::vector<ResponseSizeStat>
+get_response_size_stats(std::vector<Histogram> &size_rtt_hists,
+                        const std::vector<Worker *> &workers) {
+    std::vector<ResponseSizeStat> stats(
+        workers[0]->response_size_stats.size(),
+        ResponseSizeStat(config.latency_precision));
+    size_rtt_hists.assign(RESPONSE_SIZE_BOUNDS.size() + 1,
+                          Histogram(config.latency_precision));
+    for (auto worker : workers) {
+        for (size_t i = 0; i < stats.size(); ++i) {
+            stats[i].merge(worker->response_size_stats[i]);
+        }
+        for (size_t i = 0; i < size_rtt_hists.size(); ++i) {
+            size_rtt_hists[i].merge(worker->size_rtt_hists[i]);
+        }
+    }
+    return stats;
+}
+
+// Returns the name of status |i| of ResponseSizeStat.
+std::string response_status_name(size_t i) {
+    return config.no_tls_proto == Config::PROTO_SOFARPC
+               ? sofarpc_status_name(i)
+               : util::utos(i) + "xx";
+}
+
+// Returns the name of class |i| of response sizes.
+std::string response_size_class_name(size_t i) {
+    if (i < RESPONSE_SIZE_BOUNDS.size()) {
+        return "<= " + util::utos_funit(RESPONSE_SIZE_BOUNDS[i]) + "B";
+    }
+    return "> " + util::utos_funit(RESPONSE_SIZE_BOUNDS.back()) + "B";
+}
+} // namespace
+
+namespace {
+// Prints the distribution of response sizes per status, and the
+// latency per class of sizes, with --response-sizes.  |duration| is
+// the length of the measurement in seconds.
+void print_response_size_stat(const std::vector<Worker *> &workers,
+                              const Stats &stats, double duration) {
+    std::vector<Histogram> size_rtt_hists;
+    auto size_stats = get_response_size_stats(size_rtt_hists, workers);
+    auto sofarpc = config.no_tls_proto == Config::PROTO_SOFARPC;
+
+    std::cout << "\n  Response Sizes (received "
+              << util::utos_funit(static_cast<uint64_t>(
+                     duration > 0 ? stats.bytes_total / duration : 0.))
+              << "B/s, sent "
+              << util::utos_funit(static_cast<uint64_t>(
+                     duration > 0 ? stats.bytes_sent / duration : 0.))
+              << "B/s)\n"
+              << "  status              part           count        min"
+                 "        p50        p99        max"
+              << std::endl;
+    auto print_row = [](const std::string &status, const char *part,
+                        const Histogram &hist) {
+        auto size = [](uint64_t n) { return util::utos_funit(n) + "B"; };
+        std::cout << "  " << std::left << std::setw(20) << status
+                  << std::setw(10) << part << std::right << std::setw(10)
+                  << hist.count() << std::setw(11) << size(hist.min())
+                  << std::setw(11) << size(hist.value_at_percentile(50.))
+                  << std::setw(11) << size(hist.value_at_percentile(99.))
+                  << std::setw(11) << size(hist.max()) << std::endl;
+    };
+    for (size_t i = 0; i < size_stats.size(); ++i) {
+        auto &s = size_stats[i];
+        if (s.total.count() == 0) {
+            continue;
+        }
+        print_row(response_status_name(i), "total", s.total);
+        print_row("", sofarpc ? "header" : "headers", s.header);
+        if (sofarpc) {
+            print_row("", "class", s.classname);
+        }
+        print_row("", sofarpc ? "content" : "body", s.content);
+    }
+
+    std::cout << "\n  Latency by Response Size\n"
+              << "  size                count        p50        p99      p99.9"
+                 "        max"
+              << std::endl;
+    for (size_t i = 0; i < size_rtt_hists.size(); ++i) {
+        auto &h = size_rtt_hists[i];
+        if (h.count() == 0) {
+            continue;
+        }
+        std::cout << "  " << std::left << std::setw(14)
+                  << response_size_class_name(i) << std::right
+                  << std::setw(11) << h.count() << std::setw(11)
+                  << format_latency(h.value_at_percentile(50.))
+                  << std::setw(11)
+                  << format_latency(h.value_at_percentile(99.))
+                  << std::setw(11)
+                  << format_latency(h.value_at_percentile(99.9))
+                  << std::setw(11) << format_latency(h.max()) << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// Returns the stats of content codings with --accept-encoding or
+// --decode, summed over |workers|.
+DecodeStat get_decode_stat(const std::vector<Worker *> &workers) {
+    DecodeStat stat(config.latency_precision);
+    for (auto worker : workers) {
+        stat.merge(worker->decode_stat);
+    }
+    return stat;
+}
+} // namespace
+
+namespace {
+// Prints the responses and body bytes of each content coding, and
+// with --decode, the bytes decoded and the time taken.  |duration| is
+// the length of the measurement in seconds.
+void print_decode_stat(const std::vector<Worker *> &workers,
+                       double duration) {
+    auto stat = get_decode_stat(workers);
+
+    std::cout << "\n  Content Codings\n"
+              << "  coding          responses         body" << std::endl;
+    for (size_t i = 0; i < CODING_MAX; ++i) {
+        if (stat.responses[i] == 0) {
+            continue;
+        }
+        std::cout << "  " << std::left << std::setw(10)
+                  << content_coding_name(static_cast<ContentCoding>(i))
+                  << std::right << std::setw(15) << stat.responses[i]
+                  << std::setw(12)
+                  << util::utos_funit(stat.body_bytes[i]) + "B" << std::endl;
+    }
+
+    if (!config.decode) {
+        return;
+    }
+
+    auto coded = stat.body_bytes[CODING_GZIP] + stat.body_bytes[CODING_DEFLATE];
+    auto decode_secs = static_cast<double>(stat.decode_time) / 1e9;
+    std::cout << "  decoded: " << stat.decoded << " bodies, "
+              << util::utos_funit(coded) << "B on the wire to "
+              << util::utos_funit(stat.decoded_bytes) << "B ("
+              << util::dtos(coded ? static_cast<double>(stat.decoded_bytes) /
+                                        coded
+                                  : 0.)
+              << "x), " << stat.errors << " not valid\n"
+              << "  decode time: total "
+              << format_latency(stat.decode_time) << ", mean "
+              << format_latency(stat.decoded ? stat.decode_time / stat.decoded
+                                             : 0)
+              << ", p99 "
+              << format_latency(stat.decode_hist.value_at_percentile(99.))
+              << ", "
+              << util::utos_funit(static_cast<uint64_t>(
+                     decode_secs > 0 ? stat.decoded_bytes / decode_secs : 0.))
+              << "B/s decoded, "
+              << util::dtos(duration > 0 ? 100. * decode_secs /
+                                               (duration * config.nthreads)
+                                         : 0.)
+              << "% of worker time" << std::endl;
+}
+} // namespace
+
+namespace {
+// Returns the stats of each request template of --mix, summed over
+// |workers|.
+std::vector<TemplateStat> get_template_stats(const std::vector<Worker *> &workers) {
+    std::vector<TemplateStat> stats(config.mix.size(),
+                                    TemplateStat(config.latency_precision));
+    for (auto worker : workers) {
+        for (size_t i = 0; i < stats.size(); ++i) {
+            stats[i].merge(worker->template_stats[i]);
+        }
+    }
+    return stats;
+}
+} // namespace
+
+namespace {
+// Prints throughput, latency and status codes per request template of
+// --mix.  |duration| is the length of the measurement in seconds.
+void print_template_stat(const std::vector<Worker *> &workers,
+                         double duration) {
+    auto stats = get_template_stats(workers);
+    uint64_t total = 0;
+    for (auto w : config.mix) {
+        total += w;
+    }
+
+    std::cout << "\n  Request Mix\n"
+              << "  request                     share       done     failed"
+                 "      req/s        p50        p99      p99.9        max"
+              << std::endl;
+    for (size_t i = 0; i < stats.size(); ++i) {
+        auto &s = stats[i];
+        std::cout << "  " << std::left << std::setw(24) << config.mix_names[i]
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(8) << 100. * config.mix[i] / total << "%"
+                  << std::setw(11) << s.req_done << std::setw(11)
+                  << s.req_done - s.req_status_success << std::setprecision(2)
+                  << std::setw(11)
+                  << (duration > 0 ? s.req_status_success / duration : 0.)
+                  << std::setw(11)
+                  << format_latency(s.rtt_hist.value_at_percentile(50.))
+                  << std::setw(11)
+                  << format_latency(s.rtt_hist.value_at_percentile(99.))
+                  << std::setw(11)
+                  << format_latency(s.rtt_hist.value_at_percentile(99.9))
+                  << std::setw(11) << format_latency(s.rtt_hist.max())
+                  << std::endl;
+    }
+
+    std::cout << "  status codes" << std::endl;
+    for (size_t i = 0; i < stats.size(); ++i) {
+        auto &s = stats[i];
+        std::cout << "  " << std::left << std::setw(24) << config.mix_names[i]
+                  << std::right << "  ";
+        if (config.no_tls_proto == Config::PROTO_SOFARPC) {
+            auto sep = "";
+            for (size_t j = 0; j < s.sofarpcStatus.size(); ++j) {
+                if (s.sofarpcStatus[j] == 0) {
+                    continue;
+                }
+                std::cout << sep << s.sofarpcStatus[j] << " "
+                          << sofarpc_status_name(j);
+                sep = ", ";
+            }
+        } else {
+            std::cout << s.status[2] << " 2xx, " << s.status[3] << " 3xx, "
+                      << s.status[4] << " 4xx, " << s.status[5] << " 5xx";
+        }
+        std::cout << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// Returns the stats of each step of --scenario, followed by those of
+// the transactions, summed over |workers|.
+std::vector<ScenarioStat>
+get_scenario_stats(const std::vector<Worker *> &workers) {
+    std::vector<ScenarioStat> stats(config.scenario.size() + 1,
+                                    ScenarioStat(config.latency_precision));
+    for (auto worker : workers) {
+        for (size_t i = 0; i < config.scenario.size(); ++i) {
+            stats[i].merge(worker->step_stats[i]);
+        }
+        stats.back().merge(worker->transaction_stat);
+    }
+    return stats;
+}
+} // namespace
+
+namespace {
+// Returns the statistics of each cell of --sweep, summed over
+// |workers|.
+std::vector<PhaseStat> get_sweep_stats(const std::vector<Worker *> &workers) {
+    std::vector<PhaseStat> stats(config.sweep.size(),
+                                 PhaseStat(config.latency_precision));
+    for (auto worker : workers) {
+        for (size_t i = 0; i < stats.size(); ++i) {
+            auto &s = worker->sweep_stats[i];
+            stats[i].req_done += s.req_done;
+            stats[i].req_status_success += s.req_status_success;
+            stats[i].rtt_hist.merge(s.rtt_hist);
+        }
+    }
+    return stats;
+}
+} // namespace
+
+namespace {
+// Returns the name of the request of cell |cell| of --sweep in the
+// report.
+std::string sweep_request_name(const SweepCell &cell) {
+    return cell.tmpl == SWEEP_ANY_REQUEST ? "-" : config.mix_names[cell.tmpl];
+}
+} // namespace
+
+namespace {
+// Returns the name of step |i| of --scenario in the report.
+std::string scenario_step_name(size_t i) {
+    auto &step = config.scenario[i];
+    auto name = util::utos(i + 1) + " " + config.mix_names[step.tmpl];
+    if (step.count > 1) {
+        name += " x" + util::utos(step.count);
+    }
+    return name;
+}
+} // namespace
+
+namespace {
+// Prints the latency of each step of --scenario, from its first
+// request to its last response, and of whole transactions.
+// |duration| is the length of the measurement in seconds.
+void print_scenario_stat(const std::vector<Worker *> &workers,
+                         double duration) {
+    auto stats = get_scenario_stats(workers);
+    auto &txn = stats.back();
+
+    std::cout << "\n  Scenario (" << txn.done << " transactions, "
+              << txn.failed << " failed, " << std::fixed
+              << std::setprecision(2)
+              << (duration > 0 ? (txn.done - txn.failed) / duration : 0.)
+              << " transactions/s)\n"
+              << "  step                              done     failed"
+                 "        p50        p99      p99.9        max"
+              << std::endl;
+    for (size_t i = 0; i < stats.size(); ++i) {
+        auto &s = stats[i];
+        auto name =
+            i < config.scenario.size() ? scenario_step_name(i) : "transaction";
+        std::cout << "  " << std::left << std::setw(28) << name << std::right
+                  << std::setw(10) << s.done << std::setw(11) << s.failed
+                  << std::setw(11)
+                  << format_latency(s.hist.value_at_percentile(50.))
+                  << std::setw(11)
+                  << format_latency(s.hist.value_at_percentile(99.))
+                  << std::setw(11)
+                  << format_latency(s.hist.value_at_percentile(99.9))
+                  << std::setw(11) << format_latency(s.hist.max())
+                  << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// Returns the name of ConnError |error|.
+const char *conn_error_name(size_t error) {
+    switch (error) {
+    case CONN_ERROR_REFUSED:
+        return "refused";
+    case CONN_ERROR_RESET:
+        return "reset";
+    case CONN_ERROR_TLS:
+        return "tls";
+    case CONN_ERROR_TIMEOUT:
+        return "timeout";
+    case CONN_ERROR_CLOSED:
+        return "closed";
+    default:
+        return "other";
+    }
+}
+} // namespace
+
+namespace {
+// Prints the time spent in each phase of setting up connections, and
+// the connection failures.
+void print_connection_stat(const ConnectionStat &stat) {
+    std::cout << "\n  Connection Lifecycle (" << stat.attempts << " attempts, "
+              << stat.established << " established)\n"
+              << "  phase               count        min        p50        p90"
+                 "        p99        max\n"
+              << "  " << std::left << std::setw(14) << "resolve" << std::right
+              << std::setw(11) << 1 << std::setw(11)
+              << format_latency(to_latency(resolve_time)) << std::endl;
+    auto print_row = [](const char *name, const Histogram &hist) {
+        std::cout << "  " << std::left << std::setw(14) << name << std::right
+                  << std::setw(11) << hist.count() << std::setw(11)
+                  << format_latency(hist.min()) << std::setw(11)
+                  << format_latency(hist.value_at_percentile(50.))
+                  << std::setw(11)
+                  << format_latency(hist.value_at_percentile(90.))
+                  << std::setw(11)
+                  << format_latency(hist.value_at_percentile(99.))
+                  << std::setw(11) << format_latency(hist.max()) << std::endl;
+    };
+    print_row("tcp connect", stat.tcp_connect);
+    if (config.scheme == "https") {
+        print_row("tls handshake", stat.tls_handshake);
+        if (config.tls_resume) {
+            print_row("  full", stat.tls_full_handshake);
+            print_row("  resumed", stat.tls_resumed_handshake);
+        }
+    }
+    print_row("first response", stat.first_response);
+    if (config.reconnect_max) {
+        print_row("recovery", stat.recovery);
+    }
+
+    auto nfailures = std::accumulate(std::begin(stat.failures),
+                                     std::end(stat.failures), size_t{0});
+    if (nfailures == 0 && !config.reconnect_max) {
+        return;
+    }
+    std::cout << "  failures: ";
+    for (size_t i = CONN_ERROR_REFUSED; i < CONN_ERROR_MAX; ++i) {
+        if (i != CONN_ERROR_REFUSED) {
+            std::cout << ", ";
+        }
+        std::cout << stat.failures[i] << " " << conn_error_name(i);
+    }
+    std::cout << std::endl;
+    if (config.reconnect_max) {
+        std::cout << "  reconnects: " << stat.reconnects << " after backoff, "
+                  << stat.gave_up << " clients gave up" << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// Returns true if the run has a warm-up or a drain, which are counted
+// apart from the main measurement.
+bool has_side_phases() {
+    return config.is_timing_based_mode() &&
+           (config.warm_up_time > 0. || config.warm_up_auto > 0. ||
+            config.drain_time > 0.);
+}
+
+// Returns |phase| of all |workers| merged.
+SidePhaseStat merge_side_phase(const std::vector<Worker *> &workers,
+                               SidePhaseStat Worker::*phase) {
+    SidePhaseStat res(config.latency_precision);
+    for (auto worker : workers) {
+        merge_stats(res.stats, (worker->*phase).stats);
+        res.rtt_hist.merge((worker->*phase).rtt_hist);
+    }
+    return res;
+}
+
+// Prints the requests of the warm-up and the drain next to those of
+// the main measurement, so that cold and warm numbers can be compared.
+void print_phases(const Stats &stats, const Histogram &rtt_hist,
+                  const std::vector<Worker *> &workers) {
+    std::cout << "\n  Phases\n"
+              << "  phase        started       done  succeeded     failed"
+                 "        p50        p99        max"
+              << std::endl;
+    auto print_row = [](const char *name, const Stats &stats,
+                        const Histogram &hist) {
+        std::cout << "  " << std::left << std::setw(9) << name << std::right
+                  << std::setw(11) << stats.req_started << std::setw(11)
+                  << stats.req_done << std::setw(11)
+                  << stats.req_status_success << std::setw(11)
+                  << stats.req_failed << std::setw(11)
+                  << format_latency(hist.value_at_percentile(50.))
+                  << std::setw(11)
+                  << format_latency(hist.value_at_percentile(99.))
+                  << std::setw(11) << format_latency(hist.max()) << std::endl;
+    };
+    if (config.warm_up_time > 0. || config.warm_up_auto > 0.) {
+        auto warmup = merge_side_phase(workers, &Worker::warmup_phase);
+        print_row("warm-up", warmup.stats, warmup.rtt_hist);
+    }
+    print_row("main", stats, rtt_hist);
+    if (config.drain_time > 0.) {
+        auto drain = merge_side_phase(workers, &Worker::drain_phase);
+        print_row("drain", drain.stats, drain.rtt_hist);
+    }
+}
+} // namespace
+
+namespace {
+// Prints how connections were closed and made again by
+// --churn-requests and --churn-lifetime in |duration| seconds.  The
+// connect latency is in the connection lifecycle above.
+void print_churn(const Stats &stats, const ConnectionStat &conn_stat,
+                 double duration) {
+    std::cout << "\nchurn: " << stats.churn_closes
+              << " connections closed, " << conn_stat.established
+              << " established, " << std::fixed << std::setprecision(2)
+              << (duration > 0. ? conn_stat.established / duration : 0.)
+              << " connects/s, " << stats.churn_lost
+              << " requests lost in flight" << std::endl;
+}
+} // namespace
+
+namespace {
+// Prints the rate of --handshake-bench, where every connection does
+// one handshake.
+void print_handshake_rate(const ConnectionStat &stat, double rps) {
+    std::cout << "\nhandshakes/s: " << std::fixed << std::setprecision(2)
+              << rps;
+    if (config.scheme == "https") {
+        auto total = stat.tls_handshake.count();
+        auto resumed = stat.tls_resumed_handshake.count();
+        std::cout << " (" << stat.tls_full_handshake.count() << " full, "
+                  << resumed << " resumed, "
+                  << (total ? 100. * resumed / total : 0.) << "% resumed)";
+    }
+    std::cout << std::endl;
+}
+} // namespace
+
+namespace {
+// A worker whose loop was busy or on CPU for more than this fraction
+// of the time, or whose loop lagged more than LOOP_LAG_LIMIT at p99,
+// was likely unable to keep up.
+constexpr double LOOP_BUSY_LIMIT = 0.9;
+constexpr uint64_t LOOP_LAG_LIMIT = 10000000;
+
+double loop_busy(const LoopStat &stat) {
+    return stat.run_time ? static_cast<double>(stat.busy_time) / stat.run_time
+                         : 0.;
+}
+
+// Returns the fraction of the time the worker thread was on CPU, or
+// -1 if unknown.
+double loop_cpu(const LoopStat &stat) {
+    if (stat.user_time < 0 || stat.run_time == 0) {
+        return -1.;
+    }
+    return (stat.user_time + stat.system_time) * 1e9 / stat.run_time;
+}
+
+bool loop_saturated(const LoopStat &stat) {
+    // With --busy-poll, the worker is on CPU all the time by design.
+    if (!config.busy_poll && (loop_busy(stat) > LOOP_BUSY_LIMIT ||
+                              loop_cpu(stat) > LOOP_BUSY_LIMIT)) {
+        return true;
+    }
+    return stat.lag.value_at_percentile(99.) > LOOP_LAG_LIMIT;
+}
+} // namespace
+
+namespace {
+// Prints how busy the event loop of each worker was, and warns if
+// sofaload itself, rather than the server, may have limited the
+// results.  |request_mean| is the mean time for request in seconds.
+void print_loop_stat(const std::vector<Worker *> &workers,
+                     double request_mean) {
+    std::cout << "\n  Generator Overhead\n"
+              << "  worker    lag p50    lag p99    lag max    busy     cpu"
+                 "   user(s)    sys(s)  unsent max"
+              << std::endl;
+    size_t nsaturated = 0;
+    Histogram wakeup(config.latency_precision);
+    uint64_t wakeup_sum = 0;
+    for (auto worker : workers) {
+        auto &stat = worker->loop_stat;
+        wakeup.merge(stat.wakeup);
+        wakeup_sum += stat.wakeup_sum;
+        auto cpu = loop_cpu(stat);
+        std::cout << std::fixed << std::setprecision(1) << std::setw(8)
+                  << worker->id << std::setw(11)
+                  << format_latency(stat.lag.value_at_percentile(50.))
+                  << std::setw(11)
+                  << format_latency(stat.lag.value_at_percentile(99.))
+                  << std::setw(11) << format_latency(stat.lag.max())
+                  << std::setw(7) << loop_busy(stat) * 100 << "%";
+        if (cpu < 0) {
+            std::cout << std::setw(8) << "-" << std::setw(10) << "-"
+                      << std::setw(10) << "-";
+        } else {
+            std::cout << std::setw(7) << cpu * 100 << "%"
+                      << std::setprecision(2) << std::setw(10)
+                      << stat.user_time << std::setw(10) << stat.system_time;
+        }
+        std::cout << std::setw(12) << stat.unsent_max << std::endl;
+        if (loop_saturated(stat)) {
+            ++nsaturated;
+        }
+    }
+    if (wakeup.count()) {
+        auto mean = static_cast<double>(wakeup_sum) / wakeup.count();
+        std::cout << "wakeup: p50 "
+                  << format_latency(wakeup.value_at_percentile(50.))
+                  << ", p99 "
+                  << format_latency(wakeup.value_at_percentile(99.))
+                  << ", mean " << format_latency(mean);
+        if (request_mean > 0) {
+            std::cout << std::setprecision(1) << " ("
+                      << mean / (request_mean * 1e9) * 100
+                      << "% of mean time for request)";
+        }
+        std::cout << std::endl;
+    }
+    if (config.plugin) {
+        uint64_t calls = 0, time = 0, errors = 0;
+        for (auto worker : workers) {
+            calls += worker->subst.plugin_calls();
+            time += worker->subst.plugin_time();
+            errors += worker->subst.plugin_errors();
+        }
+        std::cout << "plugin: " << calls << " calls, mean "
+                  << format_latency(calls ? static_cast<double>(time) / calls
+                                          : 0.)
+                  << ", " << errors
+                  << " failed (not counted in time for request)" << std::endl;
+    }
+    if (nsaturated) {
+        std::cout << "warning: " << nsaturated << " of " << workers.size()
+                  << " worker(s) were saturated; the results may be limited "
+                     "by sofaload rather than the server.  Consider more "
+                     "threads (-t)."
+                  << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// Prints the hardware events counted by --perf-counters per completed
+// request.
+void print_perf_counters(const std::vector<Worker *> &workers) {
+    std::cout << "\n  Hardware Counters (per request)\n"
+              << "  worker      cycles  instructions     IPC  llc misses"
+                 "  ctx switches"
+              << std::endl;
+    std::array<uint64_t, PERF_NCOUNTERS> total{};
+    std::array<bool, PERF_NCOUNTERS> available{};
+    size_t total_done = 0;
+    auto user_only = false;
+    auto print_row = [](const std::string &name,
+                        const std::array<uint64_t, PERF_NCOUNTERS> &values,
+                        const std::array<bool, PERF_NCOUNTERS> &available,
+                        size_t done) {
+        auto per_req = [&](PerfCounter c) -> std::string {
+            if (!available[c] || done == 0) {
+                return "-";
+            }
+            std::ostringstream ss;
+            ss << std::fixed << std::setprecision(c == PERF_CONTEXT_SWITCHES
+                                                      ? 4
+                                                      : 1)
+               << static_cast<double>(values[c]) / done;
+            return ss.str();
+        };
+        auto ipc = std::string("-");
+        if (available[PERF_CYCLES] && available[PERF_INSTRUCTIONS] &&
+            values[PERF_CYCLES]) {
+            std::ostringstream ss;
+            ss << std::fixed << std::setprecision(2)
+               << static_cast<double>(values[PERF_INSTRUCTIONS]) /
+                      values[PERF_CYCLES];
+            ipc = ss.str();
+        }
+        std::cout << std::setw(8) << name << std::setw(12)
+                  << per_req(PERF_CYCLES) << std::setw(14)
+                  << per_req(PERF_INSTRUCTIONS) << std::setw(8) << ipc
+                  << std::setw(12) << per_req(PERF_LLC_MISSES) << std::setw(14)
+                  << per_req(PERF_CONTEXT_SWITCHES) << std::endl;
+    };
+    for (auto worker : workers) {
+        std::array<uint64_t, PERF_NCOUNTERS> values{};
+        std::array<bool, PERF_NCOUNTERS> avail{};
+        if (worker->perf) {
+            for (size_t i = 0; i < PERF_NCOUNTERS; ++i) {
+                auto c = static_cast<PerfCounter>(i);
+                avail[i] = worker->perf->available(c);
+                values[i] = worker->perf->value(c);
+                available[i] = available[i] || avail[i];
+                total[i] += values[i];
+            }
+            user_only = user_only || worker->perf->user_only();
+        }
+        total_done += worker->stats.req_done;
+        print_row(util::utos(worker->id), values, avail, worker->stats.req_done);
+    }
+    if (workers.size() > 1) {
+        print_row("all", total, available, total_done);
+    }
+    if (user_only) {
+        std::cout << "Events in the kernel were not counted; lower "
+                     "kernel.perf_event_paranoid to count them."
+                  << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// The --timeline intervals which all workers spent in the main
+// measurement, which --compare estimates the variance of req/s and
+// latency from
+struct IntervalStats {
+    // The successful req/s of each interval
+    std::vector<double> rates;
+    // The latency of Config::percentiles, in the same order, of each
+    // interval with any request done
+    std::vector<std::vector<double>> latencies;
+};
+
+// TimelineReporter collects --timeline samples from all workers, and
+// writes a row for each interval to |out|, unless it is nullptr, as
+// soon as every worker still running has reported it.  The rows are
+// published by |metrics|, and added to |heatmap|, too, unless they are
+// nullptr.
+class TimelineReporter {
+  public:
+    TimelineReporter(const std::vector<Worker *> &workers, std::ostream *out,
+                     MetricsExporter *metrics, Heatmap *heatmap)
+        : workers_(workers), final_seq_(workers.size(), -1), out_(out),
+          metrics_(metrics), heatmap_(heatmap),
+          stop_checker_(config.stop_conditions, config.stop_window),
+          next_seq_(0), done_(false) {
+        intervals_.latencies.resize(config.percentiles.size());
+    }
+
+    // Runs until stop() is called, and then writes the rest.
+    void run() {
+        if (out_) {
+            *out_ << "time,done,succeeded,failed,errored,req/s,bytes,min,"
+                     "p50,p90,p99,p99.9,max,bytes_sent";
+            if (config.tcp_info_interval > 0.) {
+                *out_ << ",srtt,rttvar,cwnd,retrans,rwnd_limited,"
+                         "sndbuf_limited";
+            }
+            *out_ << std::endl;
+        }
+        auto wait = std::chrono::duration<double>(
+            std::min(config.timeline_interval / 4, 0.1));
+        while (!done_.load()) {
+            if (metrics_) {
+                metrics_->serve(wait);
+            } else {
+                std::this_thread::sleep_for(wait);
+            }
+            poll();
+            write_rows(false);
+        }
+        poll();
+        write_rows(true);
+    }
+
+    void stop() { done_.store(true); }
+
+    // The intervals of the main measurement, valid after run()
+    // returns
+    const IntervalStats &intervals() const { return intervals_; }
+
+    // The --stop-on condition which ended the measurement, or empty
+    // if none did, valid after run() returns
+    const std::string &stop_reason() const { return stop_reason_; }
+
+  private:
+    struct Row {
+        Row() : sample(config.latency_precision), nreported(0) {}
+        TimelineSample sample;
+        size_t nreported;
+    };
+
+    void poll() {
+        TimelineSample s;
+        for (size_t i = 0; i < workers_.size(); ++i) {
+            auto &q = workers_[i]->timeline_queue;
+            while (q->pop(s)) {
+                if (s.seq < next_seq_) {
+                    continue;
+                }
+                while (rows_.size() <= s.seq - next_seq_) {
+                    rows_.emplace_back();
+                }
+                auto &row = rows_[s.seq - next_seq_];
+                auto &m = row.sample;
+                m.seq = s.seq;
+                m.start = row.nreported == 0 ? s.start
+                                             : std::min(m.start, s.start);
+                m.time = std::max(m.time, s.time);
+                m.req_done += s.req_done;
+                m.req_status_success += s.req_status_success;
+                m.req_failed += s.req_failed;
+                m.req_error += s.req_error;
+                m.bytes_total += s.bytes_total;
+                m.bytes_sent += s.bytes_sent;
+                for (size_t j = 0; j < m.sofarpc_status.size(); ++j) {
+                    m.sofarpc_status[j] += s.sofarpc_status[j];
+                }
+                m.req_inflight += s.req_inflight;
+                m.nconns += s.nconns;
+                m.busy = std::max(m.busy, s.busy);
+                m.rtt_hist.merge(s.rtt_hist);
+                m.tcp_info.merge(s.tcp_info);
+                m.final = row.nreported == 0 ? s.final : m.final && s.final;
+                m.measured =
+                    row.nreported == 0 ? s.measured : m.measured && s.measured;
+                ++row.nreported;
+                if (s.final) {
+                    final_seq_[i] = s.seq;
+                }
+            }
+        }
+    }
+
+    // The number of workers which report interval |seq|, as far as
+    // known now
+    size_t nexpected(size_t seq) const {
+        size_t n = 0;
+        for (auto f : final_seq_) {
+            if (f == -1 || static_cast<size_t>(f) >= seq) {
+                ++n;
+            }
+        }
+        return n;
+    }
+
+    // Writes complete rows in order, or all rows if |all| is true.
+    void write_rows(bool all) {
+        while (!rows_.empty() &&
+               (all || rows_.front().nreported >= nexpected(next_seq_))) {
+            auto &row = rows_.front();
+            // Skip the sliver between the last full interval and the
+            // end of the run if nothing happened in it.
+            if (row.nreported &&
+                !(row.sample.final && row.sample.req_done == 0)) {
+                if (out_) {
+                    write_row(row.sample);
+                }
+                if (metrics_) {
+                    publish(row.sample);
+                }
+                if (heatmap_) {
+                    heatmap_->add((row.sample.seq + 0.5) *
+                                      config.timeline_interval,
+                                  row.sample.rtt_hist);
+                }
+            }
+            if (row.sample.measured &&
+                row.nreported >= nexpected(next_seq_)) {
+                add_interval(row.sample);
+                if (!config.stop_conditions.empty()) {
+                    check_stop(row.sample);
+                }
+            }
+            rows_.pop_front();
+            ++next_seq_;
+        }
+    }
+
+    // Adds the complete interval |s| of the main measurement to
+    // intervals_.
+    void add_interval(const TimelineSample &s) {
+        intervals_.rates.push_back(s.req_status_success /
+                                   config.timeline_interval);
+        if (s.rtt_hist.count() == 0) {
+            return;
+        }
+        for (size_t i = 0; i < config.percentiles.size(); ++i) {
+            intervals_.latencies[i].push_back(
+                s.rtt_hist.value_at_percentile(config.percentiles[i]));
+        }
+    }
+
+    // Checks the complete interval |s| against --stop-on, and ends the
+    // measurement of all workers once a condition has held for
+    // Config::stop_window intervals.
+    void check_stop(const TimelineSample &s) {
+        if (!stop_reason_.empty()) {
+            return;
+        }
+        auto cond = stop_checker_.update(StopInterval{
+            s.req_done, s.req_failed, &s.rtt_hist,
+            !config.busy_poll && s.busy > LOOP_BUSY_LIMIT});
+        if (!cond) {
+            return;
+        }
+        stop_reason_ = stop_condition_str(*cond) + " for " +
+                       util::utos(config.stop_window) + " intervals";
+        for (auto worker : workers_) {
+            ev_async_send(worker->loop, &worker->stop_watcher);
+        }
+    }
+
+    // Returns the length of the interval of |s| in seconds.  The last
+    // interval of a worker may be shorter than the rest.
+    double interval_length(const TimelineSample &s) const {
+        return s.time - s.start;
+    }
+
+    void write_row(const TimelineSample &s) {
+        auto len = interval_length(s);
+        auto &h = s.rtt_hist;
+        *out_ << std::fixed << std::setprecision(3) << s.time << ","
+             << s.req_done << "," << s.req_status_success << ","
+             << s.req_failed << "," << s.req_error << ","
+             << std::setprecision(2)
+             << (len > 0 ? s.req_status_success / len : 0.) << ","
+             << s.bytes_total << "," << h.min() << ","
+             << h.value_at_percentile(50.) << ","
+             << h.value_at_percentile(90.) << ","
+             << h.value_at_percentile(99.) << ","
+             << h.value_at_percentile(99.9) << "," << h.max() << ","
+             << s.bytes_sent;
+        if (config.tcp_info_interval > 0.) {
+            // The means of the samples, in nanoseconds and segments,
+            // and the limited fractions of the time spent sending
+            auto &ti = s.tcp_info;
+            *out_ << "," << static_cast<uint64_t>(ti.mean_rtt() * 1000) << ","
+                  << static_cast<uint64_t>(ti.mean_rttvar() * 1000) << ","
+                  << ti.mean_cwnd() << "," << ti.retrans << ","
+                  << std::setprecision(4) << ti.rwnd_limited_ratio() << ","
+                  << ti.sndbuf_limited_ratio();
+        }
+        *out_ << std::endl;
+    }
+
+    void publish(const TimelineSample &s) {
+        MetricsSample m;
+        m.interval = interval_length(s);
+        m.req_done = s.req_done;
+        m.req_status_success = s.req_status_success;
+        m.req_failed = s.req_failed;
+        m.req_error = s.req_error;
+        m.bytes_total = s.bytes_total;
+        for (size_t i = 0; i < s.sofarpc_status.size(); ++i) {
+            if (s.sofarpc_status[i]) {
+                m.sofarpc_status.emplace_back(sofarpc_status_name(i),
+                                              s.sofarpc_status[i]);
+            }
+        }
+        m.req_inflight = s.req_inflight;
+        m.nconns = s.nconns;
+        if (s.rtt_hist.count()) {
+            for (auto p : {50., 90., 99., 99.9}) {
+                m.latency.emplace_back(p, s.rtt_hist.value_at_percentile(p));
+            }
+        }
+        metrics_->update(m);
+    }
+
+    const std::vector<Worker *> &workers_;
+    // The index of the last interval of each worker, or -1 if the
+    // worker is still running
+    std::vector<ssize_t> final_seq_;
+    std::ostream *out_;
+    MetricsExporter *metrics_;
+    Heatmap *heatmap_;
+    // Rows from interval next_seq_ on, which are not written yet
+    std::deque<Row> rows_;
+    IntervalStats intervals_;
+    StopChecker stop_checker_;
+    std::string stop_reason_;
+    size_t next_seq_;
+    std::atomic<bool> done_;
+};
+} // namespace
+
+namespace {
+// Runs --slo-search in the main thread.  The search begins at the
+// upper end of the qps range, and then bisects it: each step runs at
+// the middle of the range which is still to be decided, and the
+// result tells which half to go on with.  The search ends when the
+// range is narrower than 1% of its lower end, or after
+// Config::slo_max_steps steps.  Returns the results of all steps.
+std::vector<SloStep> run_slo_search(const std::vector<Worker *> &workers) {
+    std::vector<SloStep> steps;
+    // The highest qps known to meet the SLO, and the lowest known not
+    // to.
+    uint64_t lo = 0, hi = config.slo_max_qps + 1;
+    auto qps = config.slo_max_qps;
+
+    slo_search.target_qps.store(qps);
+
+    for (size_t i = 0; i < config.slo_max_steps; ++i) {
+        std::unique_ptr<PhaseStat> report;
+        {
+            std::unique_lock<std::mutex> ulk(slo_search.mu);
+            // A worker which lost all of its clients never reports.
+            if (!slo_search.cv.wait_for(
+                    ulk, std::chrono::duration<double>(config.slo_step * 2),
+                    [&workers] {
+                        return slo_search.nreported == workers.size();
+                    })) {
+                std::cerr << "--slo-search: some workers stopped reporting; "
+                             "search abandoned"
+                          << std::endl;
+                break;
+            }
+            report = std::move(slo_search.report);
+            slo_search.nreported = 0;
+        }
+
+        auto failed = report->req_done - report->req_status_success;
+        auto latency =
+            report->corrected_rtt_hist.value_at_percentile(config.slo_percentile);
+        // Falling much behind the target is not meeting it either,
+        // even if what was sent was served in time.
+        auto ok = report->req_done > 0 &&
+                  report->req_status_success >= 0.9 * qps * config.slo_step &&
+                  failed * 100. <= config.slo_error_rate * report->req_done &&
+                  latency <= config.slo_latency * 1e9;
+
+        steps.push_back(SloStep{qps, std::move(*report), ok});
+
+        if (ok) {
+            lo = qps;
+        } else {
+            hi = qps;
+        }
+
+        if (hi - lo <= std::max<uint64_t>(1, lo / 100) ||
+            (ok && qps == config.slo_max_qps) ||
+            (!ok && qps == config.slo_min_qps)) {
+            break;
+        }
+
+        qps = std::max(lo, config.slo_min_qps - 1) / 2 + hi / 2;
+        if (qps <= std::max(lo, config.slo_min_qps - 1)) {
+            qps = std::max(lo + 1, config.slo_min_qps);
+        }
+        slo_search.target_qps.store(qps);
+    }
+
+    slo_search.done = true;
+    for (auto worker : workers) {
+        ev_async_send(worker->loop, &worker->stop_watcher);
+    }
+
+    return steps;
+}
+} // namespace
+
+namespace {
+// Returns true if req/s and the latency at p99 of the last
+// Config::warm_up_window intervals in |samples| are within
+// Config::warm_up_tolerance percent of their mean.
+bool warm_up_stable(const std::vector<WarmUpSample> &samples) {
+    auto n = config.warm_up_window;
+    if (samples.size() < n) {
+        return false;
+    }
+    auto first = std::end(samples) - n;
+    double rps_lo = std::numeric_limits<double>::max(), rps_hi = 0.,
+           rps_sum = 0.;
+    uint64_t p99_lo = std::numeric_limits<uint64_t>::max(), p99_hi = 0;
+    double p99_sum = 0.;
+    for (auto it = first; it != std::end(samples); ++it) {
+        rps_lo = std::min(rps_lo, it->rps);
+        rps_hi = std::max(rps_hi, it->rps);
+        rps_sum += it->rps;
+        p99_lo = std::min(p99_lo, it->p99);
+        p99_hi = std::max(p99_hi, it->p99);
+        p99_sum += it->p99;
+    }
+    auto tolerance = config.warm_up_tolerance / 100.;
+    // A server which answers nothing is not warm.
+    return rps_lo > 0. && rps_hi - rps_lo <= rps_sum / n * tolerance &&
+           p99_hi - p99_lo <= p99_sum / n * tolerance;
+}
+} // namespace
+
+namespace {
+// Runs --warm-up-auto in the main thread.  The warm-up of all workers
+// ends when the last Config::warm_up_window intervals are stable, or
+// after Config::warm_up_auto seconds.  Returns the samples of all
+// intervals.
+std::vector<WarmUpSample>
+run_auto_warm_up(const std::vector<Worker *> &workers) {
+    std::vector<WarmUpSample> samples;
+    auto interval = config.timeline_interval;
+
+    for (;;) {
+        std::unique_ptr<PhaseStat> report;
+        {
+            std::unique_lock<std::mutex> ulk(auto_warm_up.mu);
+            // A worker which lost all of its clients never reports.
+            if (!auto_warm_up.cv.wait_for(
+                    ulk, std::chrono::duration<double>(interval * 2),
+                    [&workers] {
+                        return auto_warm_up.nreported == workers.size();
+                    })) {
+                std::cerr << "--warm-up-auto: some workers stopped "
+                             "reporting; warm-up ended"
+                          << std::endl;
+                break;
+            }
+            report = std::move(auto_warm_up.report);
+            auto_warm_up.nreported = 0;
+        }
+
+        samples.push_back(
+            WarmUpSample{interval * (samples.size() + 1),
+                         report->req_done / interval,
+                         report->rtt_hist.value_at_percentile(99.)});
+
+        if (warm_up_stable(samples) ||
+            samples.back().time >= config.warm_up_auto) {
+            break;
+        }
+    }
+
+    for (auto worker : workers) {
+        ev_async_send(worker->loop, &worker->warmup_end_watcher);
+    }
+
+    return samples;
+}
+} // namespace
+
+namespace {
+// Prints the curve of --warm-up-auto.
+void print_warm_up(const std::vector<WarmUpSample> &samples) {
+    std::cout << "\n  Warm-up (";
+    if (warm_up_stable(samples)) {
+        std::cout << "stable after "
+                  << util::format_duration(samples.back().time) << ": "
+                  << config.warm_up_window << " intervals within "
+                  << util::dtos(config.warm_up_tolerance) << "%)\n";
+    } else {
+        std::cout << "not stable after "
+                  << util::format_duration(
+                         samples.empty() ? 0. : samples.back().time)
+                  << ", measured anyway)\n";
+    }
+    std::cout << "       time      req/s        p99" << std::endl;
+    for (auto &s : samples) {
+        std::cout << std::setw(11) << util::format_duration(s.time)
+                  << std::setw(11) << std::fixed << std::setprecision(2)
+                  << s.rps << std::setw(11) << format_latency(s.p99)
+                  << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// Prints the results of --slo-search.
+void print_slo_search(const std::vector<SloStep> &steps) {
+    std::cout << "\n  SLO Search (p" << util::dtos(config.slo_percentile)
+              << " <= " << util::format_duration(config.slo_latency)
+              << ", failed <= " << util::dtos(config.slo_error_rate) << "%)\n"
+              << "   step   target qps       done     failed      req/s    "
+                 "latency  result"
+              << std::endl;
+
+    uint64_t knee = 0;
+    for (size_t i = 0; i < steps.size(); ++i) {
+        auto &step = steps[i];
+        auto &stat = step.stat;
+        if (step.ok) {
+            knee = std::max(knee, step.qps);
+        }
+        std::cout << std::setw(7) << i + 1 << std::setw(13) << step.qps
+                  << std::setw(11) << stat.req_done << std::setw(11)
+                  << stat.req_done - stat.req_status_success << std::setw(11)
+                  << std::setprecision(2)
+                  << stat.req_status_success / config.slo_step << std::setw(11)
+                  << format_latency(stat.corrected_rtt_hist.value_at_percentile(
+                         config.slo_percentile))
+                  << (step.ok ? "  ok" : "  violated") << std::endl;
+    }
+
+    if (knee == 0) {
+        std::cout << "No qps in the range met the SLO" << std::endl;
+    } else {
+        std::cout << "Max qps meeting the SLO: " << knee << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// ResultWriter writes the result of a benchmark for --output.  Values
+// are grouped into nested sections.
+class ResultWriter {
+  public:
+    virtual ~ResultWriter() {}
+    virtual void begin(const std::string &name) = 0;
+    virtual void end() = 0;
+    // Writes |v|, which is a number already formatted.
+    virtual void number(const std::string &name, const std::string &v) = 0;
+    virtual void string(const std::string &name, const std::string &v) = 0;
+    // Writes the non-empty buckets of |hist|.
+    virtual void buckets(const std::string &name, const Histogram &hist) = 0;
+    // Called after everything is written.
+    virtual void finish() {}
+
+    void number(const std::string &name, uint64_t v) {
+        number(name, util::utos(v));
+    }
+    void number(const std::string &name, int64_t v) {
+        number(name, std::to_string(v));
+    }
+    void number(const std::string &name, double v) {
+        if (!std::isfinite(v)) {
+            v = 0;
+        }
+        number(name, std::to_string(v));
+    }
+};
+
+class JsonResultWriter : public ResultWriter {
+  public:
+    JsonResultWriter(std::ostream &out) : out_(out), first_(true), depth_(1) {
+        out_ << "{";
+    }
+    void begin(const std::string &name) override {
+        key(name);
+        out_ << "{";
+        first_ = true;
+        ++depth_;
+    }
+    void end() override {
+        --depth_;
+        newline();
+        out_ << "}";
+        first_ = false;
+    }
+    void number(const std::string &name, const std::string &v) override {
+        key(name);
+        out_ << v;
+    }
+    void string(const std::string &name, const std::string &v) override {
+        key(name);
+        out_ << "\"";
+        for (auto c : v) {
+            switch (c) {
+            case '"':
+            case '\\':
+                out_ << '\\' << c;
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out_ << "\\u00" << util::format_hex(
+                                            reinterpret_cast<uint8_t *>(&c), 1);
+                } else {
+                    out_ << c;
+                }
+            }
+        }
+        out_ << "\"";
+    }
+    void buckets(const std::string &name, const Histogram &hist) override {
+        key(name);
+        out_ << "[";
+        auto first = true;
+        for (size_t i = 0; i < hist.nbuckets(); ++i) {
+            auto n = hist.bucket_count(i);
+            if (n == 0) {
+                continue;
+            }
+            if (!first) {
+                out_ << ",";
+            }
+            first = false;
+            out_ << "[" << hist.bucket_lowest(i) << ","
+                 << hist.bucket_highest(i) << "," << n << "]";
+        }
+        out_ << "]";
+    }
+    void finish() override {
+        --depth_;
+        newline();
+        out_ << "}" << std::endl;
+    }
+
+  private:
+    using ResultWriter::number;
+
+    void newline() {
+        out_ << "\n" << std::string(depth_ * 2, ' ');
+    }
+    void key(const std::string &name) {
+        if (!first_) {
+            out_ << ",";
+        }
+        first_ = false;
+        newline();
+        out_ << "\"" << name << "\": ";
+    }
+
+    std::ostream &out_;
+    bool first_;
+    size_t depth_;
+};
+
+// CsvResultWriter writes a "key,value" row for each value.  The key
+// is the dot separated names of the enclosing sections and the value.
+// A histogram bucket is a row keyed by its range, whose value is the
+// number of values in it.
+class CsvResultWriter : public ResultWriter {
+  public:
+    CsvResultWriter(std::ostream &out) : out_(out) { out_ << "key,value\n"; }
+    void begin(const std::string &name) override { path_.push_back(name); }
+    void end() override { path_.pop_back(); }
+    void number(const std::string &name, const std::string &v) override {
+        out_ << key(name) << "," << v << "\n";
+    }
+    void string(const std::string &name, const std::string &v) override {
+        std::string quoted = "\"";
+        for (auto c : v) {
+            if (c == '"') {
+                quoted += '"';
+            }
+            quoted += c;
+        }
+        quoted += '"';
+        out_ << key(name) << "," << quoted << "\n";
+    }
+    void buckets(const std::string &name, const Histogram &hist) override {
+        auto prefix = key(name) + ".";
+        for (size_t i = 0; i < hist.nbuckets(); ++i) {
+            auto n = hist.bucket_count(i);
+            if (n == 0) {
+                continue;
+            }
+            out_ << prefix << hist.bucket_lowest(i) << "-"
+                 << hist.bucket_highest(i) << "," << n << "\n";
+        }
+    }
+    void finish() override { out_.flush(); }
+
+  private:
+    using ResultWriter::number;
+
+    std::string key(const std::string &name) const {
+        std::string k;
+        for (auto &p : path_) {
+            k += p;
+            k += '.';
+        }
+        return k + name;
+    }
+
+    std::ostream &out_;
+    std::vector<std::string> path_;
+};
+
+void write_sd_stat(ResultWriter &w, const std::string &name,
+                   const SDStat &s) {
+    w.begin(name);
+    w.number("min", s.min);
+    w.number("max", s.max);
+    w.number("mean", s.mean);
+    w.number("sd", s.sd);
+    w.number("within_sd", s.within_sd);
+    w.end();
+}
+
+void write_histogram(ResultWriter &w, const std::string &name,
+                     const Histogram &hist, const char *unit = "ns") {
+    w.begin(name);
+    w.string("unit", unit);
+    w.number("count", hist.count());
+    w.number("min", hist.min());
+    w.number("max", hist.max());
+    w.begin("percentiles");
+    for (auto p : config.percentiles) {
+        w.number(format_percentile(p), hist.value_at_percentile(p));
+    }
+    w.end();
+    w.number("precision", static_cast<uint64_t>(hist.precision()));
+    w.buckets("buckets", hist);
+    w.end();
+}
+
+// Writes the result of the benchmark to |w|.
+void write_result(ResultWriter &w, const Stats &stats, const SDStats &ts,
+                  double duration, double rps, int64_t bps, size_t total,
+                  const Histogram &rtt_hist,
+                  const Histogram &corrected_rtt_hist,
+                  const ConnectionStat &conn_stat,
+                  const std::vector<Worker *> &workers,
+                  const std::vector<WarmUpSample> &warm_up,
+                  const IntervalStats &intervals,
+                  const std::string &stop_reason) {
+    w.number("duration", duration);
+    w.string("clock", clock_source_name(config.clock_source));
+    if (!stop_reason.empty()) {
+        w.string("stopped_early", stop_reason);
+    }
+    w.number("rps", rps);
+    w.number("bps", bps);
+
+    w.begin("requests");
+    w.number("total", static_cast<uint64_t>(total));
+    w.number("started", static_cast<uint64_t>(stats.req_started));
+    w.number("done", static_cast<uint64_t>(stats.req_done));
+    w.number("success", static_cast<uint64_t>(stats.req_success));
+    w.number("status_success",
+             static_cast<uint64_t>(stats.req_status_success));
+    w.number("failed", static_cast<uint64_t>(stats.req_failed));
+    w.number("errored", static_cast<uint64_t>(stats.req_error));
+    w.number("timeout", static_cast<uint64_t>(stats.req_timedout));
+    w.end();
+
+    w.begin("bytes");
+    w.number("total", stats.bytes_total);
+    w.number("head", stats.bytes_head);
+    w.number("head_decomp", stats.bytes_head_decomp);
+    w.number("body", stats.bytes_body);
+    w.end();
+
+    if (config.is_replay_mode()) {
+        w.begin("replay");
+        w.number("records", static_cast<uint64_t>(config.replay.size()));
+        w.number("sent", get_replay_sent(workers));
+        w.number("capture_duration", config.replay.duration() / 1e6);
+        w.number("speed", config.replay_speed);
+        w.end();
+    }
+
+    if (config.aimd) {
+        auto sum = get_aimd_summary(workers);
+        w.begin("aimd");
+        w.number("limit", sum.limit);
+        w.number("mean_limit", sum.mean_limit);
+        w.number("backoffs", sum.backoffs);
+        // The share of rps which succeeded
+        w.number("goodput", stats.req_success ? rps * stats.req_status_success /
+                                                    stats.req_success
+                                              : 0.);
+        w.end();
+    }
+
+    // Connections are only known to the agents of --coordinator.
+    if (config.imbalance && !workers.empty()) {
+        auto conns = get_conn_summaries(workers);
+        auto stat = analyze_imbalance(conns, 0);
+        w.begin("imbalance");
+        w.number("connections", static_cast<uint64_t>(conns.size()));
+        w.number("rps_fairness", stat.rps_fairness);
+        w.number("latency_fairness", stat.latency_fairness);
+        w.number("median_rps", stat.median_rps);
+        w.number("median_mean", stat.median_mean);
+        w.end();
+    }
+
+    if (config.oneway) {
+        w.begin("oneway");
+        w.number("requests", static_cast<uint64_t>(stats.req_done));
+        w.number("bytes", stats.bytes_sent);
+        w.number("write_blocks", stats.write_blocks);
+        w.number("write_block_time", stats.write_block_time);
+        w.end();
+    }
+
+    if (!warm_up.empty()) {
+        w.begin("warm_up");
+        w.number("duration", warm_up.back().time);
+        w.number("stable", static_cast<uint64_t>(warm_up_stable(warm_up)));
+        for (size_t i = 0; i < warm_up.size(); ++i) {
+            auto &s = warm_up[i];
+            w.begin(util::utos(i + 1));
+            w.number("time", s.time);
+            w.number("rps", s.rps);
+            w.number("p99", s.p99);
+            w.end();
+        }
+        w.end();
+    }
+
+    if (!intervals.rates.empty()) {
+        w.begin("intervals");
+        w.number("interval", config.timeline_interval);
+        for (size_t i = 0; i < intervals.rates.size(); ++i) {
+            w.number(util::utos(i + 1), intervals.rates[i]);
+        }
+        w.begin("latency");
+        for (size_t i = 0; i < config.percentiles.size(); ++i) {
+            auto &v = intervals.latencies[i];
+            w.begin(format_percentile(config.percentiles[i]));
+            for (size_t j = 0; j < v.size(); ++j) {
+                w.number(util::utos(j + 1), v[j]);
+            }
+            w.end();
+        }
+        w.end();
+        w.end();
+    }
+
+    if (has_side_phases()) {
+        // The main measurement is the rest of the result.
+        w.begin("phases");
+        for (auto &p : {std::make_pair("warm_up", &Worker::warmup_phase),
+                        std::make_pair("drain", &Worker::drain_phase)}) {
+            auto side = merge_side_phase(workers, p.second);
+            w.begin(p.first);
+            w.number("started", static_cast<uint64_t>(side.stats.req_started));
+            w.number("done", static_cast<uint64_t>(side.stats.req_done));
+            w.number("success", static_cast<uint64_t>(side.stats.req_success));
+            w.number("status_success",
+                     static_cast<uint64_t>(side.stats.req_status_success));
+            w.number("failed", static_cast<uint64_t>(side.stats.req_failed));
+            w.number("errored", static_cast<uint64_t>(side.stats.req_error));
+            w.number("timeout", static_cast<uint64_t>(side.stats.req_timedout));
+            w.number("bytes", side.stats.bytes_total);
+            w.number("bytes_sent", side.stats.bytes_sent);
+            write_histogram(w, "latency", side.rtt_hist);
+            w.end();
+        }
+        w.end();
+    }
+
+    if (config.churn_requests || config.churn_lifetime > 0.) {
+        w.begin("churn");
+        w.number("closed", stats.churn_closes);
+        w.number("established", static_cast<uint64_t>(conn_stat.established));
+        w.number("connect_rate",
+                 duration > 0. ? conn_stat.established / duration : 0.);
+        w.number("lost", stats.churn_lost);
+        w.end();
+    }
+
+    w.begin("flow_control");
+    w.number("stream_stalls", stats.stream_stalls);
+    w.number("stream_stall_time", stats.stream_stall_time);
+    w.number("conn_stalls", stats.conn_stalls);
+    w.number("conn_stall_time", stats.conn_stall_time);
+    if (config.window_auto_tune) {
+        w.number("max_stream_window",
+                 static_cast<uint64_t>(stats.max_stream_window));
+        w.number("max_conn_window",
+                 static_cast<uint64_t>(stats.max_conn_window));
+    }
+    w.end();
+
+    w.begin("status");
+    for (size_t i = 1; i < stats.status.size(); ++i) {
+        w.number(util::utos(i) + "xx", static_cast<uint64_t>(stats.status[i]));
+    }
+    w.end();
+
+    w.begin("sofarpc_status");
+    for (size_t i = 0; i < stats.sofarpcStatus.size(); ++i) {
+        w.number(sofarpc_status_name(i),
+                 static_cast<uint64_t>(stats.sofarpcStatus[i]));
+    }
+    w.end();
+
+    if (config.grpc) {
+        w.begin("grpc_status");
+        for (size_t i = 0; i < stats.grpcStatus.size(); ++i) {
+            w.number(grpc_status_name(i),
+                     static_cast<uint64_t>(stats.grpcStatus[i]));
+        }
+        w.end();
+    }
+
+    w.begin("time_stats");
+    write_sd_stat(w, "request", ts.request);
+    write_sd_stat(w, "connect", ts.connect);
+    write_sd_stat(w, "ttfb", ts.ttfb);
+    write_sd_stat(w, "rps", ts.rps);
+    w.end();
+
+    write_histogram(w, "latency", rtt_hist);
+    if (config.is_qps_mode() || config.is_replay_mode()) {
+        write_histogram(w, "corrected_latency", corrected_rtt_hist);
+    }
+    if (config.timestamping) {
+        Histogram wire_rtt_hist(config.latency_precision);
+        for (auto worker : workers) {
+            wire_rtt_hist.merge(worker->wire_rtt_hist);
+        }
+        write_histogram(w, "wire_latency", wire_rtt_hist);
+    }
+    if (config.request_timeout > 0.) {
+        Histogram timeout_hist(config.latency_precision);
+        for (auto worker : workers) {
+            timeout_hist.merge(worker->timeout_hist);
+        }
+        write_histogram(w, "timeout_latency", timeout_hist);
+    }
+    if (config.has_calls()) {
+        Histogram call_hist(config.latency_precision);
+        for (auto worker : workers) {
+            call_hist.merge(worker->call_hist);
+        }
+        w.begin("calls");
+        w.number("done", stats.calls_done);
+        w.number("success", stats.calls_success);
+        w.number("amplification", get_amplification(stats));
+        w.number("hedges", stats.hedges_sent);
+        w.number("hedges_won", stats.hedges_won);
+        w.number("hedges_cancelled", stats.hedges_cancelled);
+        w.number("retries", stats.retries);
+        w.end();
+        write_histogram(w, "user_latency", call_hist);
+    }
+    if (config.ping_interval > 0.) {
+        Histogram ping_rtt_hist(config.latency_precision);
+        for (auto worker : workers) {
+            ping_rtt_hist.merge(worker->ping_rtt_hist);
+        }
+        write_histogram(w, "ping_latency", ping_rtt_hist);
+    }
+    if (config.is_stream_mode()) {
+        Histogram first(config.latency_precision);
+        Histogram gap(config.latency_precision);
+        for (auto worker : workers) {
+            first.merge(worker->first_message_hist);
+            gap.merge(worker->message_gap_hist);
+        }
+        w.begin("streams");
+        w.number("responses", stats.stream_messages);
+        w.end();
+        write_histogram(w, "first_response_latency", first);
+        write_histogram(w, "response_gap", gap);
+    }
+
+    w.begin("connection");
+    w.number("attempts", static_cast<uint64_t>(conn_stat.attempts));
+    w.number("established", static_cast<uint64_t>(conn_stat.established));
+    w.number("resolve", to_latency(resolve_time));
+    write_histogram(w, "tcp_connect", conn_stat.tcp_connect);
+    write_histogram(w, "tls_handshake", conn_stat.tls_handshake);
+    write_histogram(w, "tls_full_handshake", conn_stat.tls_full_handshake);
+    write_histogram(w, "tls_resumed_handshake",
+                    conn_stat.tls_resumed_handshake);
+    write_histogram(w, "first_response", conn_stat.first_response);
+    w.begin("failures");
+    for (size_t i = CONN_ERROR_REFUSED; i < CONN_ERROR_MAX; ++i) {
+        w.number(conn_error_name(i),
+                 static_cast<uint64_t>(conn_stat.failures[i]));
+    }
+    w.end();
+    w.number("reconnects", static_cast<uint64_t>(conn_stat.reconnects));
+    w.number("gave_up", static_cast<uint64_t>(conn_stat.gave_up));
+    write_histogram(w, "recovery", conn_stat.recovery);
+    w.end();
+
+    w.begin("memory");
+    w.number("rss_start", rss_start);
+    w.number("rss_peak", rss_peak);
+    w.number("per_client", memory_per_client());
+    auto pool_stat = get_pool_stat(workers);
+    w.begin("buffer_pool");
+    w.number("chunk_size", static_cast<uint64_t>(config.chunk_size));
+    w.string("backing", backing_name(pool_stat.backing));
+    w.number("gets", pool_stat.nget);
+    w.number("misses", pool_stat.nmiss);
+    w.number("peak_chunks", static_cast<uint64_t>(pool_stat.peak_used));
+    w.end();
+    w.end();
+
+    if (config.endpoints.size() > 1) {
+        auto stats = get_endpoint_stats(workers);
+        w.begin("endpoints");
+        for (size_t i = 0; i < config.endpoints.size(); ++i) {
+            auto &ep = config.endpoints[i];
+            auto &stat = stats[i];
+            w.begin(ep.host + ":" + util::utos(ep.port));
+            w.number("weight", static_cast<uint64_t>(ep.weight));
+            w.number("clients", static_cast<uint64_t>(stat.clients));
+            w.number("done", static_cast<uint64_t>(stat.req_done));
+            w.number("status_success",
+                     static_cast<uint64_t>(stat.req_status_success));
+            write_histogram(w, "latency", stat.rtt_hist);
+            w.end();
+        }
+        w.end();
+    }
+
+    if (config.is_slow_read()) {
+        auto stats = get_reader_stats(workers);
+        w.begin("readers");
+        for (size_t i = 0; i < stats.size(); ++i) {
+            auto &stat = stats[i];
+            w.begin(i ? "slow" : "well_behaved");
+            w.number("clients", static_cast<uint64_t>(stat.clients));
+            w.number("done", static_cast<uint64_t>(stat.req_done));
+            w.number("status_success",
+                     static_cast<uint64_t>(stat.req_status_success));
+            w.number("bytes", stat.bytes);
+            write_histogram(w, "latency", stat.rtt_hist);
+            w.end();
+        }
+        w.end();
+    }
+
+    if (config.response_sizes) {
+        std::vector<Histogram> size_rtt_hists;
+        auto size_stats = get_response_size_stats(size_rtt_hists, workers);
+        w.begin("response_sizes");
+        for (size_t i = 0; i < size_stats.size(); ++i) {
+            auto &s = size_stats[i];
+            if (s.total.count() == 0) {
+                continue;
+            }
+            w.begin(response_status_name(i));
+            write_histogram(w, "total", s.total, "B");
+            write_histogram(w, "header", s.header, "B");
+            write_histogram(w, "class", s.classname, "B");
+            write_histogram(w, "content", s.content, "B");
+            w.end();
+        }
+        // Keyed by the upper bound of each class of sizes
+        w.begin("latency_by_size");
+        for (size_t i = 0; i < size_rtt_hists.size(); ++i) {
+            if (size_rtt_hists[i].count()) {
+                write_histogram(w,
+                                i < RESPONSE_SIZE_BOUNDS.size()
+                                    ? util::utos(RESPONSE_SIZE_BOUNDS[i])
+                                    : "larger",
+                                size_rtt_hists[i]);
+            }
+        }
+        w.end();
+        w.end();
+    }
+
+    if (config.count_codings()) {
+        auto stat = get_decode_stat(workers);
+        w.begin("codings");
+        for (size_t i = 0; i < CODING_MAX; ++i) {
+            if (stat.responses[i] == 0) {
+                continue;
+            }
+            w.begin(content_coding_name(static_cast<ContentCoding>(i)));
+            w.number("responses", stat.responses[i]);
+            w.number("body_bytes", stat.body_bytes[i]);
+            w.end();
+        }
+        if (config.decode) {
+            w.begin("decode");
+            w.number("decoded", stat.decoded);
+            w.number("errors", stat.errors);
+            w.number("decoded_bytes", stat.decoded_bytes);
+            w.number("time", stat.decode_time);
+            write_histogram(w, "time_per_body", stat.decode_hist);
+            w.end();
+        }
+        w.end();
+    }
+
+    if (config.ab) {
+        auto results = get_ab_results(workers, duration);
+        w.begin("ab");
+        for (size_t i = 1; i < results.size(); ++i) {
+            if (!results[i]) {
+                continue;
+            }
+            auto &ep = config.endpoints[i];
+            w.begin(ep.host + ":" + util::utos(ep.port));
+            for (auto &row : results[i]->rows) {
+                w.begin(row.name);
+                w.number("baseline", row.baseline);
+                w.number("current", row.current);
+                w.number("delta", row.delta);
+                if (!std::isnan(row.ci_low)) {
+                    w.number("ci_low", row.ci_low);
+                    w.number("ci_high", row.ci_high);
+                }
+                w.number("regression", static_cast<uint64_t>(row.regression));
+                w.end();
+            }
+            w.number("ks_d", results[i]->ks.d);
+            w.number("ks_p", results[i]->ks.p);
+            w.end();
+        }
+        w.end();
+    }
+
+    if (!config.mix.empty()) {
+        auto stats = get_template_stats(workers);
+        w.begin("mix");
+        for (size_t i = 0; i < stats.size(); ++i) {
+            auto &s = stats[i];
+            w.begin(util::utos(i));
+            w.string("name", config.mix_names[i]);
+            w.number("weight", static_cast<uint64_t>(config.mix[i]));
+            w.number("done", static_cast<uint64_t>(s.req_done));
+            w.number("status_success",
+                     static_cast<uint64_t>(s.req_status_success));
+            w.number("rps", duration > 0 ? s.req_status_success / duration
+                                         : 0.);
+            if (config.no_tls_proto == Config::PROTO_SOFARPC) {
+                w.begin("sofarpc_status");
+                for (size_t j = 0; j < s.sofarpcStatus.size(); ++j) {
+                    w.number(sofarpc_status_name(j),
+                             static_cast<uint64_t>(s.sofarpcStatus[j]));
+                }
+                w.end();
+            } else {
+                w.begin("status");
+                for (size_t j = 1; j < s.status.size(); ++j) {
+                    w.number(util::utos(j) + "xx",
+                             static_cast<uint64_t>(s.status[j]));
+                }
+                w.end();
+            }
+            write_histogram(w, "latency", s.rtt_hist);
+            w.end();
+        }
+        w.end();
+    }
+
+    if (config.is_sweep_mode()) {
+        auto stats = get_sweep_stats(workers);
+        auto measured = config.sweep_step - config.sweep_settle;
+        w.begin("sweep");
+        for (size_t i = 0; i < stats.size(); ++i) {
+            auto &cell = config.sweep[i];
+            auto &s = stats[i];
+            w.begin(util::utos(i + 1));
+            w.number("clients", static_cast<uint64_t>(cell.nclients));
+            w.number("streams", static_cast<uint64_t>(cell.nstreams));
+            if (cell.tmpl != SWEEP_ANY_REQUEST) {
+                w.string("request", config.mix_names[cell.tmpl]);
+            }
+            w.number("done", static_cast<uint64_t>(s.req_done));
+            w.number("failed",
+                     static_cast<uint64_t>(s.req_done - s.req_status_success));
+            w.number("rps", s.req_status_success / measured);
+            write_histogram(w, "latency", s.rtt_hist);
+            w.end();
+        }
+        w.end();
+    }
+
+    if (!config.scenario.empty()) {
+        auto stats = get_scenario_stats(workers);
+        w.begin("scenario");
+        for (size_t i = 0; i < stats.size(); ++i) {
+            auto &s = stats[i];
+            if (i < config.scenario.size()) {
+                w.begin(util::utos(i + 1));
+                w.string("name", config.mix_names[config.scenario[i].tmpl]);
+                w.number("count",
+                         static_cast<uint64_t>(config.scenario[i].count));
+            } else {
+                w.begin("transaction");
+            }
+            w.number("done", static_cast<uint64_t>(s.done));
+            w.number("failed", static_cast<uint64_t>(s.failed));
+            write_histogram(w, "latency", s.hist);
+            w.end();
+        }
+        w.end();
+    }
+
+    w.begin("generator");
+    for (auto worker : workers) {
+        auto &stat = worker->loop_stat;
+        w.begin(util::utos(worker->id));
+        write_histogram(w, "lag", stat.lag);
+        write_histogram(w, "wakeup", stat.wakeup);
+        w.number("busy", loop_busy(stat));
+        w.number("cpu", loop_cpu(stat));
+        w.number("user_time", stat.user_time);
+        w.number("system_time", stat.system_time);
+        w.number("unsent_max", stat.unsent_max);
+        w.number("unsent_mean",
+                 stat.nsamples
+                     ? static_cast<double>(stat.unsent_sum) / stat.nsamples
+                     : 0.);
+        w.number("saturated", loop_saturated(stat) ? "true" : "false");
+        if (worker->perf) {
+            for (size_t i = 0; i < PERF_NCOUNTERS; ++i) {
+                auto c = static_cast<PerfCounter>(i);
+                if (worker->perf->available(c)) {
+                    w.number(PERF_COUNTER_NAMES[i], worker->perf->value(c));
+                }
+            }
+        }
+        if (config.tcp_info_interval > 0.) {
+            auto &ti = worker->tcp_info_stat;
+            w.begin("tcp_info");
+            w.number("samples", ti.nsamples);
+            write_histogram(w, "srtt", worker->tcp_rtt_hist);
+            w.number("rttvar_mean", ti.mean_rttvar() * 1000);
+            w.number("cwnd_mean", ti.mean_cwnd());
+            w.number("cwnd_min", static_cast<uint64_t>(ti.cwnd_min));
+            w.number("retransmits", ti.retrans);
+            w.number("busy_time", ti.busy_time * 1000);
+            w.number("rwnd_limited", ti.rwnd_limited_ratio());
+            w.number("sndbuf_limited", ti.sndbuf_limited_ratio());
+            w.end();
+        }
+        w.end();
+    }
+    w.end();
+
+    w.finish();
+}
+} // namespace
+
+namespace {
+// Prints the comparison |res| under the heading |title|.
+void print_compare(const CompareResult &res, const std::string &title) {
+    auto pct = [](double v) {
+        std::ostringstream os;
+        os << std::fixed << std::setprecision(2) << std::showpos << v << "%";
+        return os.str();
+    };
+    std::cout << "\n  " << title << " (95% confidence intervals)\n"
+              << "  metric        baseline       current     change"
+                 "                    95% CI"
+              << std::endl;
+    for (auto &row : res.rows) {
+        auto latency = row.name != "req/s";
+        auto value = [latency](double v) {
+            if (latency) {
+                return format_latency(static_cast<uint64_t>(v));
+            }
+            std::ostringstream os;
+            os << std::fixed << std::setprecision(2) << v;
+            return os.str();
+        };
+        std::cout << "  " << std::left << std::setw(8) << row.name
+                  << std::right << std::setw(14) << value(row.baseline)
+                  << std::setw(14) << value(row.current) << std::setw(11)
+                  << pct(row.delta) << std::setw(26)
+                  << (std::isnan(row.ci_low)
+                          ? std::string("-")
+                          : "[" + pct(row.ci_low) + ", " + pct(row.ci_high) +
+                                "]")
+                  << (row.regression ? "  REGRESSION" : "") << std::endl;
+    }
+    std::cout << "  latency KS test: D=" << std::fixed << std::setprecision(4)
+              << res.ks.d << ", p=" << res.ks.p << std::defaultfloat
+              << std::endl;
+}
+
+// Compares the result in |current|, written in JSON, with
+// --compare.  Returns 0 if there is no regression, or -1 after
+// printing the error or the regression.
+int compare_with_baseline(const std::string &current) {
+    std::ifstream in(config.compare_file);
+    if (!in) {
+        std::cerr << "--compare: cannot open " << config.compare_file
+                  << std::endl;
+        return -1;
+    }
+    std::stringstream baseline_text;
+    baseline_text << in.rdbuf();
+
+    ResultData baseline, cur;
+    if (parse_result(baseline, baseline_text.str()) != 0 ||
+        parse_result(cur, current) != 0) {
+        std::cerr << "--compare: could not read " << config.compare_file
+                  << std::endl;
+        return -1;
+    }
+
+    CompareOptions opts{config.percentiles, config.max_rps_drop,
+                        config.max_latency_rise};
+    CompareResult res;
+    if (compare_results(res, baseline, cur, opts) != 0) {
+        std::cerr << "--compare: could not compare with "
+                  << config.compare_file << std::endl;
+        return -1;
+    }
+    print_compare(res, "Comparison with " + config.compare_file);
+
+    if (res.regression) {
+        std::cerr << "--compare: regression beyond --max-rps-drop="
+                  << config.max_rps_drop
+                  << "% or --max-latency-rise=" << config.max_latency_rise
+                  << "%" << std::endl;
+        return -1;
+    }
+    return 0;
+}
+} // namespace
+
+namespace {
+// Prints the comparison of each endpoint with the first with --ab.
+// Returns 0 if none regresses, or -1 after printing the regression.
+int print_ab(const std::vector<Worker *> &workers, double duration) {
+    auto results = get_ab_results(workers, duration);
+    auto &base = config.endpoints[0];
+    auto rv = 0;
+    for (size_t i = 1; i < results.size(); ++i) {
+        auto &ep = config.endpoints[i];
+        if (!results[i]) {
+            std::cout << "\n  " << endpoint_name(ep)
+                      << ": no latency to compare with "
+                      << endpoint_name(base) << std::endl;
+            continue;
+        }
+        print_compare(*results[i], endpoint_name(ep) + " compared with " +
+                                       endpoint_name(base));
+        if (results[i]->regression) {
+            std::cerr << "--ab: " << endpoint_name(ep)
+                      << " regresses from " << endpoint_name(base)
+                      << " beyond --max-rps-drop=" << config.max_rps_drop
+                      << "% or --max-latency-rise="
+                      << config.max_latency_rise << "%" << std::endl;
+            rv = -1;
+        }
+    }
+    return rv;
+}
+} // namespace
+
+namespace {
+// Writes the result to --output in --output-format, and compares it
+// with --compare.  Returns 0 if it succeeds, or -1 after printing the
+// error or the regression.
+int write_output(const Stats &stats, const SDStats &ts, double duration,
+                 double rps, int64_t bps, size_t total,
+                 const Histogram &rtt_hist,
+                 const Histogram &corrected_rtt_hist,
+                 const ConnectionStat &conn_stat,
+                 const std::vector<Worker *> &workers,
+                 const std::vector<WarmUpSample> &warm_up,
+                 const IntervalStats &intervals,
+                 const std::string &stop_reason) {
+    if (!config.output_file.empty()) {
+        std::ofstream output_out;
+        std::ostream *out = &std::cout;
+        if (config.output_file != "-") {
+            output_out.open(config.output_file);
+            if (!output_out) {
+                std::cerr << "--output: cannot open " << config.output_file
+                          << std::endl;
+                return -1;
+            }
+            out = &output_out;
+        }
+        std::unique_ptr<ResultWriter> w;
+        if (config.output_format == OutputFormat::JSON) {
+            w = std::make_unique<JsonResultWriter>(*out);
+        } else {
+            w = std::make_unique<CsvResultWriter>(*out);
+        }
+        write_result(*w, stats, ts, duration, rps, bps, total, rtt_hist,
+                     corrected_rtt_hist, conn_stat, workers, warm_up,
+                     intervals, stop_reason);
+    }
+
+    if (!config.compare_file.empty()) {
+        std::ostringstream current;
+        JsonResultWriter w(current);
+        write_result(w, stats, ts, duration, rps, bps, total, rtt_hist,
+                     corrected_rtt_hist, conn_stat, workers, warm_up,
+                     intervals, stop_reason);
+        return compare_with_baseline(current.str());
+    }
+    return 0;
+}
+} // namespace
+
+namespace {
+// Prints the qps each worker was asked for and actually sent, and
+// how much quota it moved through QpsPool.
+void print_worker_qps(const std::vector<Worker *> &workers) {
+    std::cout << "\n  Per-worker QPS\n"
+              << "  worker     target qps     actual qps     given     taken"
+              << std::endl;
+    for (auto worker : workers) {
+        auto target = config.qps_profile.empty()
+                          ? worker->qps_rate
+                          : config.nreqs * worker->qps_share / config.duration;
+        std::cout << std::setw(8) << worker->id << std::setw(15)
+                  << std::setprecision(2) << target << std::setw(15)
+                  << worker->stats.req_started / config.duration
+                  << std::setw(10) << worker->qps_given << std::setw(10)
+                  << worker->qps_taken << std::endl;
+    }
+}
+
+// Prints the statistics of each phase of --qps-profile.
+void print_phase_stats(const std::vector<Worker *> &workers) {
+    std::cout << "\n  QPS Profile\n"
+              << "  phase       target qps   duration       done     failed"
+                 "      req/s        p50        p99  corrected p99"
+              << std::endl;
+    for (size_t i = 0; i < config.qps_profile.size(); ++i) {
+        auto &phase = config.qps_profile[i];
+        PhaseStat stat(config.latency_precision);
+        for (auto worker : workers) {
+            auto &s = worker->phase_stats[i];
+            stat.req_done += s.req_done;
+            stat.req_status_success += s.req_status_success;
+            stat.rtt_hist.merge(s.rtt_hist);
+            stat.corrected_rtt_hist.merge(s.corrected_rtt_hist);
+        }
+        auto target = util::utos(static_cast<uint64_t>(phase.start_qps));
+        if (phase.start_qps != phase.end_qps) {
+            target += "-" + util::utos(static_cast<uint64_t>(phase.end_qps));
+        }
+        std::cout << std::setw(7) << i + 1 << std::setw(17) << target
+                  << std::setw(11) << util::format_duration(phase.duration)
+                  << std::setw(11) << stat.req_done << std::setw(11)
+                  << stat.req_done - stat.req_status_success << std::setw(11)
+                  << std::setprecision(2)
+                  << stat.req_status_success / phase.duration << std::setw(11)
+                  << format_latency(stat.rtt_hist.value_at_percentile(50.))
+                  << std::setw(11)
+                  << format_latency(stat.rtt_hist.value_at_percentile(99.))
+                  << std::setw(15)
+                  << format_latency(
+                         stat.corrected_rtt_hist.value_at_percentile(99.))
+                  << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// Prints the throughput and latency of each cell of --sweep, measured
+// after it settled.
+void print_sweep_stat(const std::vector<Worker *> &workers) {
+    auto stats = get_sweep_stats(workers);
+    auto measured = config.sweep_step - config.sweep_settle;
+    std::cout << "\n  Sweep (" << util::format_duration(measured)
+              << " measured of each " << util::format_duration(config.sweep_step)
+              << ")\n"
+              << "   cell       c       m  request                 done"
+                 "     failed      req/s        p50        p99      p99.9"
+                 "        max"
+              << std::endl;
+    for (size_t i = 0; i < stats.size(); ++i) {
+        auto &cell = config.sweep[i];
+        auto &s = stats[i];
+        std::cout << std::setw(7) << i + 1 << std::setw(8) << cell.nclients
+                  << std::setw(8) << cell.nstreams << "  " << std::left
+                  << std::setw(20) << sweep_request_name(cell) << std::right
+                  << std::setw(7) << s.req_done << std::setw(11)
+                  << s.req_done - s.req_status_success << std::setw(11)
+                  << std::fixed << std::setprecision(2)
+                  << s.req_status_success / measured << std::setw(11)
+                  << format_latency(s.rtt_hist.value_at_percentile(50.))
+                  << std::setw(11)
+                  << format_latency(s.rtt_hist.value_at_percentile(99.))
+                  << std::setw(11)
+                  << format_latency(s.rtt_hist.value_at_percentile(99.9))
+                  << std::setw(11) << format_latency(s.rtt_hist.max())
+                  << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// Resolves the addresses of |ep|.  Returns 0 if it succeeds, or -1.
+int resolve_endpoint(Endpoint &ep) {
+    addrinfo hints{}, *res;
+
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_ADDRCONFIG;
+
+    auto rv = getaddrinfo(ep.host.c_str(), util::utos(ep.port).c_str(),
+                          &hints, &res);
+    if (rv != 0) {
+        std::cerr << "getaddrinfo() failed for " << ep.host << ":" << ep.port
+                  << ": " << gai_strerror(rv) << std::endl;
+        return -1;
+    }
+    ep.addrs = res;
+    return 0;
+}
+} // namespace
+
+namespace {
+// Builds the tables select_endpoint() uses.
+void build_endpoint_tables() {
+    auto &eps = config.endpoints;
+
+    // Smooth weighted round robin, as nginx does: the endpoint with the
+    // largest current weight wins, and pays back the total.
+    uint64_t total = 0;
+    for (auto &ep : eps) {
+        total += ep.weight;
+    }
+    std::vector<int64_t> current(eps.size());
+    config.endpoint_schedule.clear();
+    for (uint64_t n = 0; n < total; ++n) {
+        size_t best = 0;
+        for (size_t i = 0; i < eps.size(); ++i) {
+            current[i] += eps[i].weight;
+            if (current[i] > current[best]) {
+                best = i;
+            }
+        }
+        current[best] -= total;
+        config.endpoint_schedule.push_back(best);
+    }
+
+    // 100 points per unit of weight keep the share of each endpoint
+    // within a few percent of its weight.
+    config.endpoint_ring.clear();
+    for (size_t i = 0; i < eps.size(); ++i) {
+        auto name = eps[i].host + ":" + util::utos(eps[i].port);
+        uint64_t h = 14695981039346656037ULL;
+        for (auto c : name) {
+            h = (h ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+        }
+        for (uint64_t j = 0; j < 100 * eps[i].weight; ++j) {
+            config.endpoint_ring.emplace_back(mix_hash(h + j), i);
+        }
+    }
+    std::sort(std::begin(config.endpoint_ring),
+              std::end(config.endpoint_ring));
+}
+} // namespace
+
+namespace {
+void resolve_host() {
+    auto start = std::chrono::steady_clock::now();
+
+    if (!config.endpoints.empty()) {
+        for (auto &ep : config.endpoints) {
+            if (ep.port == 0) {
+                ep.port = config.port;
+            }
+            if (resolve_endpoint(ep) != 0) {
+                exit(EXIT_FAILURE);
+            }
+        }
+        build_endpoint_tables();
+        resolve_time = std::chrono::steady_clock::now() - start;
+        return;
+    }
+
+    if (config.base_uri_unix) {
+        auto res = std::make_unique<addrinfo>();
+        res->ai_family = config.unix_addr.sun_family;
+        res->ai_socktype = SOCK_STREAM;
+        res->ai_addrlen = config.unix_addrlen;
+        res->ai_addr = static_cast<struct sockaddr *>(
+            static_cast<void *>(&config.unix_addr));
+
+        config.addrs = res.release();
+        config.endpoints.push_back(
+            Endpoint{config.host, config.port, 1, config.addrs});
+        build_endpoint_tables();
+        return;
+    };
+
+    int rv;
+    addrinfo hints{}, *res;
+
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = 0;
+    hints.ai_flags = AI_ADDRCONFIG;
+
+    rv = getaddrinfo(config.host.c_str(), util::utos(config.port).c_str(),
+                     &hints, &res);
+    if (rv != 0) {
+        std::cerr << "getaddrinfo() failed: " << gai_strerror(rv) << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (res == nullptr) {
+        std::cerr << "No address returned" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    config.addrs = res;
+    config.endpoints.push_back(
+        Endpoint{config.host, config.port, 1, config.addrs});
+    build_endpoint_tables();
+    resolve_time = std::chrono::steady_clock::now() - start;
+}
+} // namespace
+
+namespace {
+std::string get_reqline(const char *uri, const http_parser_url &u) {
+    std::string reqline;
+
+    if (util::has_uri_field(u, UF_PATH)) {
+        reqline = util::get_uri_field(uri, u, UF_PATH).str();
+    } else {
+        reqline = "/";
+    }
+
+    if (util::has_uri_field(u, UF_QUERY)) {
+        reqline += '?';
+        reqline += util::get_uri_field(uri, u, UF_QUERY);
+    }
+
+    return reqline;
+}
+} // namespace
+
+namespace {
+// Keeps the new session of a connection as the one the next
+// connections of its worker resume with --tls-resume.
+int new_session_cb(SSL *ssl, SSL_SESSION *session) {
+    auto client = static_cast<Client *>(SSL_get_app_data(ssl));
+    auto worker = client->worker;
+    if (worker->tls_session) {
+        SSL_SESSION_free(worker->tls_session);
+    }
+    worker->tls_session = session;
+    client->tls_session_received = true;
+    // We own |session| now.
+    return 1;
+}
+} // namespace
+
+#ifndef OPENSSL_NO_NEXTPROTONEG
+namespace {
+int client_select_next_proto_cb(SSL *ssl, unsigned char **out,
+                                unsigned char *outlen, const unsigned char *in,
+                                unsigned int inlen, void *arg) {
+    if (util::select_protocol(const_cast<const unsigned char **>(out), outlen,
+                              in, inlen, config.npn_list)) {
+        return SSL_TLSEXT_ERR_OK;
+    }
+
+    // OpenSSL will terminate handshake with fatal alert if we return
+    // NOACK.  So there is no way to fallback.
+    return SSL_TLSEXT_ERR_NOACK;
+}
+} // namespace
+#endif // !OPENSSL_NO_NEXTPROTONEG
+
+namespace {
+constexpr char UNIX_PATH_PREFIX[] = "unix:";
+} // namespace
+
+namespace {
+// Sets the UNIX domain socket address of --base-uri from |path|.  A
+// path which starts with "@" names a socket in the abstract
+// namespace, whose address is the rest of it after a NUL byte.
+// Returns 0 if it succeeds, or -1 after printing the error.
+int parse_unix_path(const char *path) {
+    auto &un = config.unix_addr;
+    auto pathlen = strlen(path);
+    auto abstract = path[0] == '@';
+
+    // The path of a file is NUL terminated, and the name of an
+    // abstract socket is not.
+    if (pathlen == 0 || (abstract && pathlen == 1) ||
+        pathlen + (abstract ? 0 : 1) > sizeof(un.sun_path)) {
+        std::cerr << "--base-uri: invalid UNIX domain socket path: " << path
+                  << std::endl;
+        return -1;
+    }
+
+    un = {};
+    un.sun_family = AF_UNIX;
+    if (abstract) {
+        std::copy_n(path + 1, pathlen - 1, un.sun_path + 1);
+        config.unix_addrlen = offsetof(sockaddr_un, sun_path) + pathlen;
+    } else {
+        std::copy_n(path, pathlen, un.sun_path);
+        config.unix_addrlen = sizeof(un);
+    }
+    config.base_uri_unix = true;
+
+    return 0;
+}
+} // namespace
+
+namespace {
+bool parse_base_uri(const StringRef &base_uri) {
+    http_parser_url u{};
+    if (http_parser_parse_url(base_uri.c_str(), base_uri.size(), 0, &u) != 0 ||
+        !util::has_uri_field(u, UF_SCHEMA) ||
+        !util::has_uri_field(u, UF_HOST)) {
+        return false;
+    }
+
+    config.scheme = util::get_uri_field(base_uri.c_str(), u, UF_SCHEMA).str();
+    config.host = util::get_uri_field(base_uri.c_str(), u, UF_HOST).str();
+    config.default_port = util::get_default_port(base_uri.c_str(), u);
+    if (util::has_uri_field(u, UF_PORT)) {
+        config.port = u.port;
+    } else {
+        config.port = config.default_port;
+    }
+
+    return true;
+}
+} // namespace
+namespace {
+// Returns true if a connection may speak |proto|, one of
+// Config::no_tls_proto: over TLS, if it is offered in ALPN, and
+// otherwise, if cleartext connections speak it.  Request templates
+// are only built for the protocols a connection may speak.
+bool may_speak(int proto) {
+    if (config.scheme != "https") {
+        return config.no_tls_proto == proto;
+    }
+    for (auto &p : config.npn_list) {
+        // The tokens are serialized, with their length in front.
+        auto name = StringRef{p.c_str() + 1, p.size() - 1};
+        switch (proto) {
+        case Config::PROTO_HTTP2:
+            if (util::check_h2_is_selected(name)) {
+                return true;
+            }
+            break;
+        case Config::PROTO_HTTP1_1:
+            if (util::streq(NGHTTP2_H1_1, name)) {
+                return true;
+            }
+            break;
+        case Config::PROTO_SOFARPC:
+            if (util::streq(SOFARPC, name)) {
+                return true;
+            }
+            break;
+        }
+    }
+    return false;
+}
+} // namespace
+
+namespace {
+// Returns the request lines of |uris|, after taking the scheme, host
+// and port from the first one.  SofaRPC requests come from
+// --sofarpc-spec rather than the URIs, so if a connection can speak
+// nothing else, only the first request line is returned, though all
+// URIs are checked.
+std::vector<std::string> parse_uris(const std::vector<StringRef> &uris) {
+    std::vector<std::string> reqlines;
+
+    if (uris.empty()) {
+        std::cerr << "no URI available" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (!config.has_base_uri()) {
+
+        if (!parse_base_uri(uris[0])) {
+            std::cerr << "invalid URI: " << uris[0] << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        config.base_uri = uris[0].str();
+    }
+
+    auto all = !may_speak(Config::PROTO_SOFARPC) ||
+               may_speak(Config::PROTO_HTTP2) ||
+               may_speak(Config::PROTO_HTTP1_1);
+
+    if (all) {
+        reqlines.reserve(uris.size());
+    }
+
+    for (auto &uri : uris) {
+        http_parser_url u{};
+
+        if (http_parser_parse_url(uri.c_str(), uri.size(), 0, &u) != 0) {
+            std::cerr << "invalid URI: " << uri << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        if (all || reqlines.empty()) {
+            reqlines.push_back(get_reqline(uri.c_str(), u));
+        }
+    }
+
+    return reqlines;
+}
+} // namespace
+
+namespace {
+// Appends the lines of |data| of |len| bytes to |uris|, which refer to
+// |data|.
+void index_uris(std::vector<StringRef> &uris, const char *data,
+                size_t len) {
+    auto last = data + len;
+    for (auto p = data; p != last;) {
+        auto eol = static_cast<const char *>(memchr(p, '\n', last - p));
+        if (eol == nullptr) {
+            uris.emplace_back(p, last);
+            break;
+        }
+        uris.emplace_back(p, eol);
+        p = eol + 1;
+    }
+}
+} // namespace
+
+namespace {
+// Reads the URIs of -i from |path|, or from stdin if it is "-", into
+// |uris|.  A file is mapped into memory, which stays mapped, and
+// |uris| refer to it, so that a large file is neither copied nor split
+// into strings.  stdin is read into |buf|.  Returns 0 if it succeeds,
+// or -1 after printing the error.
+int read_uri_file(std::vector<StringRef> &uris, std::string &buf,
+                  const std::string &path) {
+    if (path == "-") {
+        buf.assign(std::istreambuf_iterator<char>(std::cin),
+                   std::istreambuf_iterator<char>());
+        index_uris(uris, buf.data(), buf.size());
+        return 0;
+    }
+
+    auto fd = open(path.c_str(), O_RDONLY | O_BINARY);
+    if (fd == -1) {
+        std::cerr << "cannot read input file: " << path << std::endl;
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        std::cerr << "cannot read input file: " << path << std::endl;
+        close(fd);
+        return -1;
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        return 0;
+    }
+    auto p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        std::cerr << "cannot map input file: " << path << std::endl;
+        return -1;
+    }
+    index_uris(uris, static_cast<const char *>(p), st.st_size);
+    return 0;
+}
+} // namespace
+
+
+namespace {
+// Parses |spec| of --endpoints, and appends the endpoints to |eps|.
+// Endpoints are separated by ',' or white space, and each of them is
+// <HOST>[:<PORT>][=<WEIGHT>].  IPv6 addresses with a port must be
+// enclosed in brackets.  Text after '#' up to the end of line is
+// ignored.  Port 0 means the port of the URI.  Returns 0 if it
+// succeeds, or -1.
+int parse_endpoints(std::vector<Endpoint> &eps, const std::string &spec) {
+    std::string s;
+    for (auto it = std::begin(spec); it != std::end(spec); ++it) {
+        if (*it == '#') {
+            it = std::find(it, std::end(spec), '\n');
+            if (it == std::end(spec)) {
+                break;
+            }
+        }
+        s += *it == ' ' || *it == '\t' || *it == '\r' || *it == '\n' ? ','
+                                                                    : *it;
+    }
+
+    for (auto &ent : util::split_str(StringRef{s}, ',')) {
+        if (ent.empty()) {
+            continue;
+        }
+        Endpoint ep{};
+        ep.weight = 1;
+        auto eq = std::find(std::begin(ent), std::end(ent), '=');
+        if (eq != std::end(ent)) {
+            auto weight = util::parse_uint(StringRef{eq + 1, std::end(ent)});
+            if (weight < 1 || weight > 1000) {
+                std::cerr << "--endpoints: weight must be in [1, 1000] in "
+                          << ent << std::endl;
+                return -1;
+            }
+            ep.weight = weight;
+        }
+        auto hostport = StringRef{std::begin(ent), eq};
+        StringRef port;
+        if (util::starts_with(hostport, StringRef::from_lit("["))) {
+            auto rbracket =
+                std::find(std::begin(hostport), std::end(hostport), ']');
+            if (rbracket == std::end(hostport) ||
+                (rbracket + 1 != std::end(hostport) && rbracket[1] != ':')) {
+                std::cerr << "--endpoints: bad address in " << ent
+                          << std::endl;
+                return -1;
+            }
+            ep.host.assign(std::begin(hostport) + 1, rbracket);
+            if (rbracket + 1 != std::end(hostport)) {
+                port = StringRef{rbracket + 2, std::end(hostport)};
+            }
+        } else if (std::count(std::begin(hostport), std::end(hostport), ':') ==
+                   1) {
+            auto colon =
+                std::find(std::begin(hostport), std::end(hostport), ':');
+            ep.host.assign(std::begin(hostport), colon);
+            port = StringRef{colon + 1, std::end(hostport)};
+        } else {
+            ep.host = hostport.str();
+        }
+        if (!port.empty()) {
+            auto n = util::parse_uint(port);
+            if (n < 1 || n > std::numeric_limits<uint16_t>::max()) {
+                std::cerr << "--endpoints: bad port in " << ent << std::endl;
+                return -1;
+            }
+            ep.port = n;
+        }
+        if (ep.host.empty()) {
+            std::cerr << "--endpoints: missing host in " << ent << std::endl;
+            return -1;
+        }
+        eps.push_back(std::move(ep));
+    }
+
+    if (eps.empty()) {
+        std::cerr << "--endpoints: no endpoint given" << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+} // namespace
+
+namespace {
+// Parses |spec| of --qps-profile, and stores the phases in |phases|.
+// Phases are separated by ',' or a new line, and each of them is
+// <QPS>[-<QPS>]:<DURATION>.  Text after '#' up to the end of line is
+// ignored.  Returns 0 if it succeeds, or -1.
+int parse_qps_profile(std::vector<QpsPhase> &phases, const std::string &spec) {
+    std::string s;
+    for (auto it = std::begin(spec); it != std::end(spec); ++it) {
+        if (*it == '#') {
+            it = std::find(it, std::end(spec), '\n');
+            if (it == std::end(spec)) {
+                break;
+            }
+        }
+        if (*it == ' ' || *it == '\t' || *it == '\r') {
+            continue;
+        }
+        s += *it == '\n' ? ',' : *it;
+    }
+
+    for (auto &phase : util::split_str(StringRef{s}, ',')) {
+        if (phase.empty()) {
+            continue;
+        }
+        auto colon = std::find(std::begin(phase), std::end(phase), ':');
+        if (colon == std::end(phase)) {
+            std::cerr << "--qps-profile: missing duration in " << phase
+                      << std::endl;
+            return -1;
+        }
+        auto qps = StringRef{std::begin(phase), colon};
+        auto dash = std::find(std::begin(qps), std::end(qps), '-');
+        auto start_qps = util::parse_uint(StringRef{std::begin(qps), dash});
+        auto end_qps = dash == std::end(qps)
+                           ? start_qps
+                           : util::parse_uint(StringRef{dash + 1, std::end(qps)});
+        auto duration = util::parse_duration_with_unit(
+            StringRef{colon + 1, std::end(phase)});
+        if (start_qps <= 0 || end_qps <= 0) {
+            std::cerr << "--qps-profile: qps must be positive integer in "
+                      << phase << std::endl;
+            return -1;
+        }
+        if (!std::isfinite(duration) || duration <= 0.) {
+            std::cerr << "--qps-profile: bad duration in " << phase
+                      << std::endl;
+            return -1;
+        }
+        phases.push_back(QpsPhase{static_cast<double>(start_qps),
+                                  static_cast<double>(end_qps), duration});
+    }
+
+    if (phases.empty()) {
+        std::cerr << "--qps-profile: no phase given" << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+} // namespace
+
+namespace {
+// Parses |spec| of --think-time into Config::think_model,
+// Config::think_time and Config::think_samples.  Returns 0 if it
+// succeeds, or -1 after printing the error.
+int parse_think_time(const std::string &spec) {
+    auto bad = [](const std::string &s) {
+        std::cerr << "--think-time: bad duration: " << s << std::endl;
+        return -1;
+    };
+
+    if (spec[0] == '@') {
+        std::ifstream f(spec.substr(1));
+        if (!f) {
+            std::cerr << "--think-time: cannot open " << spec.substr(1)
+                      << std::endl;
+            return -1;
+        }
+        config.think_samples.clear();
+        double sum = 0.;
+        for (std::string line; std::getline(f, line);) {
+            std::string t;
+            if (!(std::istringstream(line) >> t) || t[0] == '#') {
+                continue;
+            }
+            auto d = util::parse_duration_with_unit(t.c_str());
+            if (!std::isfinite(d) || d < 0.) {
+                return bad(t);
+            }
+            config.think_samples.push_back(d);
+            sum += d;
+        }
+        if (config.think_samples.empty() || sum == 0.) {
+            std::cerr << "--think-time: no think time in " << spec.substr(1)
+                      << std::endl;
+            return -1;
+        }
+        config.think_model = ThinkModel::EMPIRICAL;
+        config.think_time = sum / config.think_samples.size();
+        return 0;
+    }
+
+    auto model = ThinkModel::FIXED;
+    auto value = spec;
+    if (util::istarts_with_l(spec, "exp:")) {
+        model = ThinkModel::EXPONENTIAL;
+        value = spec.substr(str_size("exp:"));
+    }
+    auto d = util::parse_duration_with_unit(value.c_str());
+    if (!std::isfinite(d) || d <= 0.) {
+        return bad(value);
+    }
+    config.think_model = model;
+    config.think_time = d;
+    return 0;
+}
+} // namespace
+
+namespace {
+Worker * create_worker(uint32_t id, SSL_CTX *ssl_ctx,
+                                      size_t nclients, size_t rate) {
+    if (config.is_rate_mode()) {
+        return new Worker(id, ssl_ctx, nclients, rate, &config);
+    } else {
+        return new Worker(id, ssl_ctx, nclients, nclients, &config);
+    }
+}
+} // namespace
+
+namespace {
+// Parses the comma separated list of numeric IPv4 and IPv6 addresses
+// in |optarg|, and appends them to |addrs|.  Brackets around IPv6
+// addresses are optional.  Returns 0 if it succeeds, or -1.
+int parse_local_addresses(std::vector<Address> &addrs, const char *optarg) {
+    for (auto &s : util::split_str(StringRef{optarg}, ',')) {
+        auto host = s.str();
+        if (host.size() > 2 && host.front() == '[' && host.back() == ']') {
+            host = host.substr(1, host.size() - 2);
+        }
+        Address addr{};
+        if (inet_pton(AF_INET, host.c_str(), &addr.su.in.sin_addr) == 1) {
+            addr.su.in.sin_family = AF_INET;
+            addr.len = sizeof(addr.su.in);
+        } else if (inet_pton(AF_INET6, host.c_str(),
+                             &addr.su.in6.sin6_addr) == 1) {
+            addr.su.in6.sin6_family = AF_INET6;
+            addr.len = sizeof(addr.su.in6);
+        } else {
+            return -1;
+        }
+        addrs.push_back(addr);
+    }
+    return 0;
+}
+} // namespace
+
+namespace {
+// Raises the limit of open files so that all clients fit, with some
+// room for the rest.  Warns if the hard limit is too low.
+void raise_nofile_limit(size_t nclients) {
+    rlimit rlim;
+    if (getrlimit(RLIMIT_NOFILE, &rlim) != 0) {
+        return;
+    }
+    rlim_t need = nclients + 64;
+    if (rlim.rlim_cur == RLIM_INFINITY || rlim.rlim_cur >= need) {
+        return;
+    }
+    auto cur = rlim.rlim_cur;
+    rlim.rlim_cur = rlim.rlim_max == RLIM_INFINITY
+                        ? need
+                        : std::min(need, rlim.rlim_max);
+    if (setrlimit(RLIMIT_NOFILE, &rlim) != 0) {
+        rlim.rlim_cur = cur;
+    }
+    if (rlim.rlim_cur < need) {
+        std::cerr << "-c: warning: the limit of open files is " << rlim.rlim_cur
+                  << ", which is too low for " << nclients
+                  << " clients.  Raise it with ulimit -n." << std::endl;
+    }
+}
+} // namespace
+
+namespace {
+// Turns SO_BUSY_POLL off with a warning if it cannot be set.  Raising
+// it above net.core.busy_read requires CAP_NET_ADMIN.
+void check_busy_poll() {
+#ifdef SO_BUSY_POLL
+    auto fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd == -1) {
+        return;
+    }
+    auto val = config.busy_poll_usec;
+    auto rv = setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &val, sizeof(val));
+    auto error = errno;
+    close(fd);
+    if (rv == 0) {
+        return;
+    }
+    std::cerr << "--busy-poll: could not set SO_BUSY_POLL: "
+              << strerror(error) << std::endl;
+#else  // !SO_BUSY_POLL
+    std::cerr << "--busy-poll: SO_BUSY_POLL is not supported" << std::endl;
+#endif // !SO_BUSY_POLL
+    config.busy_poll_usec = 0;
+}
+} // namespace
+
+namespace {
+// Returns the CPUs this process may run on.
+std::vector<uint32_t> available_cpus() {
+    std::vector<uint32_t> cpus;
+#ifdef CPU_SETSIZE
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (uint32_t i = 0; i < CPU_SETSIZE; ++i) {
+            if (CPU_ISSET(i, &set)) {
+                cpus.push_back(i);
+            }
+        }
+        return cpus;
+    }
+#endif // CPU_SETSIZE
+    for (uint32_t i = 0; i < std::thread::hardware_concurrency(); ++i) {
+        cpus.push_back(i);
+    }
+    return cpus;
+}
+} // namespace
+
+namespace {
+// Returns the CPUs this process may run on, ordered so that
+// consecutive CPUs are on different NUMA nodes in turn.
+std::vector<uint32_t> spread_cpus() {
+    auto cpus = available_cpus();
+
+    std::vector<std::vector<uint32_t>> nodes;
+    auto dir = opendir("/sys/devices/system/node");
+    if (dir) {
+        while (auto ent = readdir(dir)) {
+            auto name = StringRef{ent->d_name};
+            if (!util::starts_with(name, StringRef::from_lit("node")) ||
+                util::parse_uint(StringRef{std::begin(name) + 4, std::end(name)}) ==
+                    -1) {
+                continue;
+            }
+            std::ifstream f("/sys/devices/system/node/" + name.str() +
+                            "/cpulist");
+            std::string line;
+            if (!std::getline(f, line)) {
+                continue;
+            }
+            std::vector<uint32_t> node;
+            for (auto c : util::parse_uint_ranges(StringRef{line})) {
+                if (std::find(std::begin(cpus), std::end(cpus), c) !=
+                    std::end(cpus)) {
+                    node.push_back(c);
+                }
+            }
+            if (!node.empty()) {
+                nodes.push_back(std::move(node));
+            }
+        }
+        closedir(dir);
+    }
+
+    if (nodes.size() < 2) {
+        return cpus;
+    }
+
+    std::sort(std::begin(nodes), std::end(nodes));
+
+    std::vector<uint32_t> res;
+    for (size_t i = 0; res.size() < cpus.size(); ++i) {
+        for (auto &node : nodes) {
+            if (i < node.size()) {
+                res.push_back(node[i]);
+            }
+        }
+    }
+    return res;
+}
+} // namespace
+
+namespace {
+int parse_header_table_size(uint32_t &dst, const char *opt,
+                            const char *optarg) {
+    auto n = util::parse_uint_with_unit(optarg);
+    if (n == -1) {
+        std::cerr << "--" << opt << ": Bad option value: " << optarg
+                  << std::endl;
+        return -1;
+    }
+    if (n > std::numeric_limits<uint32_t>::max()) {
+        std::cerr << "--" << opt
+                  << ": Value too large.  It should be less than or equal to "
+                  << std::numeric_limits<uint32_t>::max() << std::endl;
+        return -1;
+    }
+
+    dst = n;
+
+    return 0;
+}
+} // namespace
+
+namespace {
+void print_version(std::ostream &out) {
+    out << "h2load nghttp2/" NGHTTP2_VERSION << std::endl;
+}
+} // namespace
+
+namespace {
+void print_usage(std::ostream &out) {
+    out << R"(Usage: h2load [OPTIONS]... [URI]...
+benchmarking tool for HTTP/2 server)"
+        << std::endl;
+}
+} // namespace
+
+namespace {
+constexpr char DEFAULT_NPN_LIST[] = "h2,h2-16,h2-14,http/1.1";
+} // namespace
+
+namespace {
+void print_help(std::ostream &out) {
+    print_usage(out);
+
+    Config config;
+
+    out << R"(
+  <URI>       Specify URI to access.   Multiple URIs can be specified.
+			  URIs are used  in this order for each  client.  All URIs
+			  are used, then  first URI is used and then  2nd URI, and
+			  so  on.  The  scheme, host  and port  in the  subsequent
+			  URIs, if present,  are ignored.  Those in  the first URI
+			  are used solely.  Definition of a base URI overrides all
+			  scheme, host or port values.
+Options:
+  -n, --requests=<N>
+			  Number of  requests across all  clients.  If it  is used
+			  with --timing-script-file option,  this option specifies
+			  the number of requests  each client performs rather than
+			  the number of requests  across all clients.  This option
+			  is ignored if timing-based  benchmarking is enabled (see
+			  --duration option).
+			  Default: )"
+        << config.nreqs << R"(
+  -c, --clients=<N>
+			  Number  of concurrent  clients.   With  -r option,  this
+			  specifies the maximum number of connections to be made.
+			  Default: )"
+        << config.nclients << R"(
+  -t, --threads=<N>
+			  Number of native threads.  If "auto" is given, one
+			  thread  is  run  for  each  CPU this  process  may
+			  run on.
+			  Default: )"
+        << config.nthreads << R"(
+  -m, --max-concurrent-streams=<N>
+			  Max  concurrent  streams  to issue  per  session.   When
+			  http/1.1  is used,  this  specifies the  number of  HTTP
+			  pipelining requests in-flight.   With HTTP/2, it is also
+			  capped by SETTINGS_MAX_CONCURRENT_STREAMS of the server.
+			  With --connections-per-client,  this is the limit per
+			  client.
+			  Default: 1
+  --connections-per-client=<N>
+			  Makes each client keep <N> connections,  like the pool
+			  of an RPC framework, and send each request on the one
+			  with the fewest requests in flight.  -m limits the
+			  requests in flight of the client as a whole.
+			  Default: 1
+  -H, --header=<HEADER>
+			  Add/Override a header to the requests.
+  -i, --input-file=<PATH>
+			  Path of a file with multiple URIs are separated by EOLs.
+			  This option will disable URIs getting from command-line.
+			  If '-' is given as <PATH>, URIs will be read from stdin.
+			  The file is mapped into memory rather than read, and
+			  only the requests of the protocols a connection may
+			  speak are built from it.  With -p sofarpc, only the
+			  first URI is used.
+  -B, --base-uri=(<URI>|unix:<PATH>)
+			  Specify URI from which the scheme, host and port are
+			  taken, instead of the first URI.  With unix:<PATH>,
+			  connections are made to the UNIX domain socket at
+			  <PATH>, and the scheme and host still come from the
+			  first URI.  A <PATH> starting with '@' names a socket
+			  in the abstract namespace.  --local-address and
+			  --local-ports do not apply to such connections.
+  -p, --no-tls-proto=<PROTOID>
+			  Specify ALPN identifier of the  protocol to be used when
+			  accessing http URI without SSL/TLS.
+			  Available protocols: )"
+        << NGHTTP2_CLEARTEXT_PROTO_VERSION_ID << R"( and )" << NGHTTP2_H1_1
+        << R"( and )" << SOFARPC << R"(
+			  Default: )"
+        << NGHTTP2_CLEARTEXT_PROTO_VERSION_ID << R"(
+  --bolt-version=<N>
+			  Specifies the  Bolt protocol version SofaRPC requests
+			  are encoded with.  <N> is 1 or 2.
+			  Default: 1
+  --bolt-crc
+			  Appends  CRC32 of  the  frame to each  Bolt V2 request.
+			  Responses which carry CRC32 are checked,  whether or
+			  not this is given.  CRC32 is computed with PCLMULQDQ
+			  or ARMv8 CRC32 instructions if they are available.
+			  This requires --bolt-version=2.
+  --oneway
+			  Sends  oneway  SofaRPC  requests,  which  the  server
+			  does not answer, to  measure how fast it takes them
+			  in.  A request is done as soon as it is queued, and
+			  requests are  queued as fast as  the socket takes
+			  them,   or  as   --qps  allows,   instead  of   -m
+			  limiting those in flight.  Instead of latencies, the
+			  bytes sent  per second and how  long the socket
+			  buffers were full are reported.  This requires
+			  -p sofarpc.
+  --stream-messages=<N>
+			  Takes each SofaRPC request as a server stream, which
+			  the <N>th response to its request id closes.  An
+			  error status closes a stream at any response.  A
+			  stream is a request in the report, with the latency
+			  of its last response, and the time to the first
+			  response and the gaps between responses are reported
+			  as well.  This requires -p sofarpc.
+  --stream-end-header=<KEY>
+			  Like --stream-messages, but a  response  whose Bolt
+			  header map  has <KEY>  closes its stream.  Only the
+			  header maps of responses are buffered; the contents
+			  are skipped as they arrive.  With --stream-messages,
+			  whichever comes first closes the stream.
+  --aimd
+			  Adapts the number of requests in flight of each worker
+			  to the server,  like an RPC client  with an  AIMD
+			  concurrency limit does, so that an overloaded server
+			  is measured by what it can sustain rather than by
+			  how much it rejects.  The limit starts at a request
+			  per client, and grows by one for each window of
+			  answered requests,  up to -m  requests per client.
+			  It shrinks by --aimd-backoff when the server pushes
+			  back:  with SERVER_THREADPOOL_BUSY  or TIMEOUT  for
+			  SofaRPC, with 429 or 503 for HTTP, or by failing to
+			  answer.  Push backs on the requests in flight when it
+			  shrank do not shrink it again.  The limit at the end,
+			  its mean,  and the goodput,  the requests which
+			  succeeded per second, are reported.
+  --aimd-backoff=<R>
+			  The  ratio  --aimd  multiplies  the  limit  by  when
+			  the server pushes back, in (0, 1).
+			  Default: 0.5
+  --replay=<PATH>
+			  Replays the capture of requests in <PATH>, such as one
+			  exported from access logs, open-loop: each request is
+			  sent when it is due by its time in the capture, however
+			  the earlier ones fare, and the latency corrected from
+			  that time is reported.  A record of the capture picks
+			  the request template, which is a URI, or a request of
+			  --sofarpc-spec  with  -p sofarpc, and its parameter
+			  fills the {{param}} slots of the request.  The capture
+			  is "SLRP" and a version of 4 bytes, 1, followed by the
+			  records, each of the time in microseconds since the
+			  start of the capture in 8 bytes, the template index in
+			  4 bytes, the parameter length in 2 bytes and the
+			  parameter, with integers in network byte order, and
+			  the records in the order of their times.  The capture
+			  is mapped into memory and read as it is replayed, so
+			  it need not fit in memory.  Each thread sends every
+			  -t-th record.   The capture decides the number of
+			  requests, unless -D cuts the replay short, and the
+			  replay starts after --warm-up-time.  This cannot be
+			  used with --qps or --mix.
+  --replay-speed=<X>
+			  Replays the capture of --replay <X> times as fast as it
+			  was captured.
+			  Default: 1
+  --agents=<HOST>:<PORT>[,<HOST>:<PORT>...]
+			  Runs  the  benchmark  on  the  agents  given,  which
+			  run --agent, rather than on this machine, and reports
+			  their  results merged, with latency percentiles over
+			  all  their  requests.   -c,  -n,  --qps  and  -r are
+			  split among the agents, and the other options are
+			  passed on to them.   Agents only run options which
+			  shape the load,  so  options  which  name files, such
+			  as -i, -d or --timeline, are refused.  --plugin is
+			  not passed on,  because an agent never loads code.
+			  --output and --compare are handled here.   Needs
+			  --agent-token.  The agents start together as far as
+			  their clocks agree,  so keep them synchronized, e.g.
+			  by  NTP.    IPv6  addresses  must  be  enclosed  in
+			  brackets.   This  cannot be used  with --qps-profile,
+			  --slo-search or --replay.
+  --agent=<PORT>
+			  Serves as an agent of --agents on <PORT> of
+			  --agent-bind, one run at a time.  An agent only runs
+			  a  coordinator  which  has its  --agent-token,  with
+			  options which shape the load.
+  --agent-bind=<ADDR>
+			  Specifies the address --agent listens on.  Use "::"
+			  to listen on all addresses.
+			  Default: 127.0.0.1
+  --agent-token=<TOKEN>
+			  Specifies the secret which --agents sends and --agent
+			  requires.  If it is not given, the SOFALOAD_AGENT_TOKEN
+			  environment variable is used, which keeps it out of
+			  the process list.
+  --shards=<N>
+			  Runs the benchmark in <N> processes, which share no
+			  heap, counters  or locks,  rather than  in threads of
+			  one, and reports  their results  merged,  with latency
+			  percentiles over all their  requests.  -c, -t, -n,
+			  --qps and -r  are split among the  shards, and the
+			  workers are pinned  to the CPUs they would be pinned
+			  to  by  --cpu-affinity  in one  process.   This cannot
+			  be  used with  --qps-profile,  --slo-search, --replay,
+			  --sweep-*,  --timeline,  --heatmap,  --trace,
+			  --request-log or --metrics-port.
+			  Default: 1
+  --sofarpc-spec=<PATH>
+			  Reads the SofaRPC requests to send from <PATH>, instead
+			  of sending the built-in one.  Each block of lines,
+			  separated by empty lines, defines a request, and they
+			  are used in turn like URIs.  A line is <KEY>=<VALUE>,
+			  or a comment starting with "#".  The keys are:
+			    class         the class name
+			    service       the target service
+			    method        the method name
+			    header        a header map entry, <KEY>:<VALUE>
+			    timeout       the timeout in milliseconds
+			    content       the content as it is
+			    content-hex   the content in hex
+			    content-file  the file the content is in
+			    args          the argument shapes the content is
+			                  generated from, as in --sofarpc-args
+			    weight        the weight of the request, as in --mix
+			  A content file is mapped into memory, and is sent from
+			  there without being copied.  Each request is serialized
+			  once at startup.
+  --sofarpc-args=<SHAPES>
+			  Generates the  Hessian2 content of the built-in SofaRPC
+			  request, which calls  echoStr  of TestService, with the
+			  arguments described by <SHAPES>, so that the cost of
+			  deserializing  them on the server can be swept by the
+			  shape.  <SHAPES> is a comma separated list of:
+			    null, bool, int, long, double
+			    string:<N>        a string of <N> characters
+			    bytes:<N>         a byte array of <N> bytes
+			    list:<N>:<SHAPE>  a list of <N> <SHAPE>s
+			    map:<N>:<SHAPE>   a map of <N> string keys to <SHAPE>s
+			  Lists and maps nest, as in "list:10:map:5:string:16".
+  --grpc
+			  Makes  gRPC calls over HTTP/2,  such as those of SOFARPC
+			  Triple, rather than plain requests, to compare them with
+			  Bolt under the same load.  With --sofarpc-spec,  each
+			  request calls  /<service>/<method>  with its content as
+			  the serialized  protobuf message,  its  header entries
+			  as  metadata  and  its  timeout  as  grpc-timeout.   A
+			  service version after  ':'  is  sent in
+			  tri-service-version.  Otherwise  each URI  names a
+			  method, which takes the message in -d.  A call succeeds
+			  only if grpc-status in its trailers is 0, and the report
+			  counts each status code.
+  --mix=<W1>,<W2>,...
+			  Sends a weighted mix of the requests, instead of using
+			  them in turn.  The template of each request is drawn
+			  with the probability of its weight out of the sum of
+			  the weights, by a per-worker random generator.  There
+			  must be a weight in [0, 1000] for each URI, or for each
+			  request of --sofarpc-spec with -p sofarpc or --grpc.  The weights
+			  can also be given with the weight key of --sofarpc-spec,
+			  where a request without one has the weight 1.  Each
+			  request template gets its own throughput, latency and
+			  status codes in the report.
+  --scenario=<PATH>
+			  Makes each client run the transaction in <PATH> over
+			  and over,  instead of  sending requests  on its own.
+			  Each line  of  <PATH> is  a step "<REQUEST> [x<N>]
+			  [think=<DURATION>]",  which sends <N> requests at once
+			  (default: 1), waits for all of them, and then waits
+			  for the think time before the next step.  <REQUEST>
+			  is a URI,  or a  method of  --sofarpc-spec with -p
+			  sofarpc.   A step  with a failed  request fails the
+			  transaction, and  another one starts.  The  report
+			  gives the latency of each step, from its first request
+			  to its last  response, and of whole  transactions,
+			  with the think times in them.
+  --think-time=<SPEC>
+			  Makes each request a client may have in flight (-m) a
+			  user, who waits  for the think time after  a response
+			  before its next request, instead of sending it at once.
+			  This models  a closed population  of -c x  -m users
+			  rather than a saturating machine.  <SPEC> is one of:
+			    <DURATION>      a fixed think time
+			    exp:<DURATION>  exponentially distributed  think
+			                    times of the mean <DURATION>
+			    @<PATH>         think times drawn from  those in
+			                    <PATH>, one per line
+			  Users start at  random within their  first think time,
+			  so that  they do  not all start  at once.  Each worker
+			  keeps its  thinking users in a timer wheel, so that a
+			  million of them take one timer.
+  --subst-keys=<PATH>
+			  Reads  the keys  for the  key and  randkey substitution
+			  slots from <PATH>, one per line.  The keys must be
+			  printable ASCII, and of the same length.
+			  A URI,  and the header values, content  and args of
+			  --sofarpc-spec, may have substitution slots, which are
+			  filled anew for each request, so that the requests do
+			  not all hit the same cache key.  A slot is written as
+			  "{{<KIND>[:<WIDTH>]}}", where <KIND> is one of:
+			    seq      the sequence number of the request, unique
+			             across threads (width 10)
+			    rand     a random number (width 10)
+			    time     the time in milliseconds since the epoch
+			             (width 13)
+			    key      the key the sequence number selects
+			    randkey  a random key
+			    param    the parameter of the record of --replay
+			             (width 10)
+			    plugin   the bytes --plugin fills (width 16)
+			  A plugin slot may also  have a tag, which is passed to
+			  the plugin, as "{{plugin:<WIDTH>:<TAG>}}".
+			  Numbers are  zero-padded, and  keep their  lowest digits
+			  when  they  do not  fit.   A slot  is at  most 64 bytes
+			  wide.  The slots are reserved at their width when the
+			  requests are serialized  at  startup, so the lengths in
+			  them, such as  Content-Length, the Hessian string lengths
+			  of args and the Bolt contentLen, hold.  Each slot is
+			  then filled in place in the write buffer.  A content
+			  file is sent as it is.
+  --plugin=<PATH>
+			  Loads the shared library at <PATH> with dlopen(3), and
+			  fills the plugin substitution slots with it, for fields
+			  the  other kinds  cannot  generate,  such  as  signed
+			  tokens.  The library implements the C interface of
+			  <sofaload/plugin.h>.   Each worker  gets  a context of
+			  its own,  so that the library needs  no locking.  The
+			  time  it takes  is  not counted  in the  latency of
+			  requests, but is reported on its own.
+  --plugin-arg=<ARG>
+			  Passes <ARG> to the initialization of --plugin.
+  -d, --data=<PATH>
+			  Post FILE to  server.  The request method  is changed to
+			  POST.  The file is mapped  into memory once, and is
+			  sent from there without being copied, when it can be.
+			  For http/1.1  connection,  if the  file  cannot  be
+			  mapped,  the  maximum  number  of in-flight pipelined
+			  requests is set to 1.
+  -r, --rate=<N>
+			  Specifies  the  fixed  rate  at  which  connections  are
+			  created.   The   rate  must   be  a   positive  integer,
+			  representing the  number of  connections to be  made per
+			  rate period.   The maximum  number of connections  to be
+			  made  is  given  in  -c   option.   This  rate  will  be
+			  distributed among  threads as  evenly as  possible.  For
+			  example,  with   -t2  and   -r4,  each  thread   gets  2
+			  connections per period.  When the rate is 0, the program
+			  will run  as it  normally does, creating  connections at
+			  whatever variable rate it  wants.  The default value for
+			  this option is 0.  With -D, connections are made
+			  into the measurement unless --ready holds it.
+  --rate-period=<DURATION>
+			  Specifies the time  period between creating connections.
+			  The period  must be a positive  number, representing the
+			  length of the period in time.  This option is ignored if
+			  the rate option is not used.  The default value for this
+			  option is 1s.
+  -D, --duration=<N>
+			  Specifies the main duration for the measurements in case
+			  of timing-based  benchmarking.
+  --warm-up-time=<DURATION>
+			  Specifies the  time  period  before  starting the actual
+			  measurements, in  case  of  timing-based benchmarking.
+			  Needs to provided along with -D option.
+  --ready=<PERCENT>
+			  Starts the warm-up of  a worker, and so the  main
+			  measurement,  only once  <PERCENT>  of  its
+			  connections are made,  including their TLS
+			  handshakes.  Until then, the requests of the
+			  connections already made count as warm-up.  With -r,
+			  this keeps the ramp-up  of connections out of the
+			  measurement.  Needs -D.
+  --ready-timeout=<DURATION>
+			  Starts the warm-up after <DURATION> even if --ready
+			  is not reached.
+			  Default: )"
+        << util::duration_str(config.ready_timeout) << R"(
+  --warm-up-auto=<MAX>
+			  Warms  up until  the server  is stable,  rather than
+			  for a fixed time, but for at most <MAX>.  The req/s
+			  and the latency at p99  of each --timeline-interval
+			  are  taken  during  the  warm-up,  and  all  workers
+			  start the measurement at once when those of the last
+			  --warm-up-window intervals are  within
+			  --warm-up-tolerance of  their mean.  The warm-up curve
+			  is  printed,  and  written  to  --output.   With
+			  --qps, the warm-up runs at the rate.  Needs -D.
+  --warm-up-window=<N>
+			  The number of intervals --warm-up-auto must find
+			  stable.
+			  Default: )"
+        << config.warm_up_window << R"(
+  --warm-up-tolerance=<PERCENT>
+			  How much req/s and the latency at p99 may vary for
+			  --warm-up-auto to find them stable.
+			  Default: )"
+        << util::dtos(config.warm_up_tolerance) << R"(
+  --drain-time=<DURATION>
+			  Waits for the responses in flight at the end of -D
+			  for at most <DURATION>,  sending no more requests,
+			  rather than dropping them.  They are counted apart,
+			  as the warm-up is, and both are printed next to the
+			  main measurement,  so that a run gives cold, warm and
+			  draining numbers.  Needs -D.
+  -T, --connection-active-timeout=<DURATION>
+			  Specifies  the maximum  time that  h2load is  willing to
+			  keep a  connection open,  regardless of the  activity on
+			  said connection.  <DURATION> must be a positive integer,
+			  specifying the amount of time  to wait.  When no timeout
+			  value is  set (either  active or inactive),  h2load will
+			  keep  a  connection  open indefinitely,  waiting  for  a
+			  response.
+  -N, --connection-inactivity-timeout=<DURATION>
+			  Specifies the amount  of time that h2load  is willing to
+			  wait to see activity  on a given connection.  <DURATION>
+			  must  be a  positive integer,  specifying the  amount of
+			  time  to wait.   When no  timeout value  is set  (either
+			  active or inactive), h2load  will keep a connection open
+			  indefinitely, waiting for a response.
+  --request-timeout=<DURATION>
+			  Gives up on a request which has not been answered in
+			  <DURATION>, and sends another in its place.  The request
+			  counts as timed out, and the time it was in flight goes
+			  to a distribution of its own.  HTTP/1.1 connections are
+			  closed and made again to give up a request.
+  --hedge=(<DURATION>|p<N>)
+			  Sends a request  again on another connection if it
+			  has not been answered in <DURATION>, or in the <N>th
+			  percentile of  the latency of  the successful
+			  requests so far.  The first successful response
+			  answers the user,  whose latency is printed apart
+			  from that of each request sent, with how many
+			  requests were sent per user request.
+  --hedge-cancel
+			  Cancels the requests still in flight once a hedged
+			  request is answered,  rather than ignoring their
+			  responses.
+  --retry=<N>
+			  Sends a request the server pushed back on, such as
+			  with SERVER_THREADPOOL_BUSY, 429 or 503, again on
+			  another connection, up to <N> times.
+  --h1        Short        hand         for        --npn-list=http/1.1
+			  --no-tls-proto=http/1.1,    which   effectively    force
+			  http/1.1 for both http and https URI.
+  --header-table-size=<SIZE>
+			  Specify decoder header table size.
+			  Default: )"
+        << util::utos_unit(config.header_table_size) << R"(
+  --encoder-header-table-size=<SIZE>
+			  Specify encoder header table size.  The decoder (server)
+			  specifies  the maximum  dynamic table  size it  accepts.
+			  Then the negotiated dynamic table size is the minimum of
+			  this option value and the value which server specified.
+			  Default: )"
+        << util::utos_unit(config.encoder_header_table_size) << R"(
+  --qps-arrival=<PROCESS>
+			  Specifies how requests are spread over time in --qps
+			  mode.   "periodic" scatters  each worker's  quota over
+			  5ms periods once, and repeats the  pattern every second.
+			  "poisson" uses  exponentially distributed inter-arrival
+			  times,  "uniform" uses  inter-arrival times  uniformly
+			  distributed in [0, 2/<N>], and "constant" sends requests
+			  exactly 1/<N> apart,  where <N> is the qps of a worker.
+			  Default: periodic
+  --qps-burst=<N>
+			  Limits the qps quota a worker can  save up while all of
+			  its clients  are busy to <N>  requests.  Quota beyond
+			  this is  discarded, and  the number  of the discarded
+			  requests is  reported.  Blocked clients are  served in
+			  the order  they blocked.  0  means no limit, in which
+			  case  every  missed  request  is  sent  once  a client
+			  becomes available.
+			  Default: 0
+  --qps-profile=<SPEC>
+			  Drives the qps target through phases instead of --qps
+			  and -D.   <SPEC> is a list of phases separated by ','
+			  or a new line, each of which is <QPS>[-<QPS>]:<DURATION>.
+			  If two <QPS>  are given,  the  target changes linearly
+			  from the  first to the second  over the phase.  If
+			  <SPEC> starts with '@',  the rest is a file to read the
+			  phases from,  where text after '#' is ignored.  The
+			  results are also reported per phase.   For example,
+			  "1000-50000:60s,50000:5m,80000:30s,200000:5s"  ramps up
+			  to 50000 qps over a minute, holds it  for 5 minutes,
+			  steps to 80000 qps, and then spikes.
+  --slo-search=<MIN>-<MAX>
+			  Searches  for  the  highest qps  in  [<MIN>, <MAX>] at
+			  which the latency  and the failure rate stay within the
+			  SLO   given   by   --slo-latency,   --slo-percentile  and
+			  --slo-error-rate.  The qps target is adjusted between steps
+			  of fixed length by binary search,  while connections are
+			  kept.  Latency is measured from the intended start of
+			  requests, and a step which falls 10% or more behind its
+			  target fails too.   The result of each step, and the
+			  highest qps which met the SLO are reported.  This cannot
+			  be used with --qps, -D or --qps-profile.
+  --slo-latency=<DURATION>
+			  The latency bound of --slo-search.
+  --slo-percentile=<P>
+			  The percentile of requests  which must finish within
+			  --slo-latency.
+			  Default: )"
+        << util::dtos(config.slo_percentile) << R"(
+  --slo-error-rate=<R>
+			  The  largest  percentage of  failed requests  allowed
+			  by --slo-search.
+			  Default: )"
+        << util::dtos(config.slo_error_rate) << R"(
+  --slo-step=<DURATION>
+			  The length of a step of --slo-search.
+			  Default: )"
+        << util::duration_str(config.slo_step) << R"(
+  --slo-max-steps=<N>
+			  The largest number of steps of --slo-search.
+			  Default: )"
+        << config.slo_max_steps << R"(
+  --sweep-clients=<LIST>
+  --sweep-streams=<LIST>
+  --sweep-requests=<LIST>
+			  Runs a  matrix of  cells in one  process, one  after
+			  another for  --sweep-step each,  and reports req/s and
+			  latency per  cell.  The  cells are  all combinations
+			  of  the  numbers of  clients  and  of requests  each
+			  keeps in flight, both lists  of numbers separated by
+			  ',', and of  the requests,  a list of their  names in
+			  the report.  The  number of  clients defaults  to -c,
+			  that  in  flight to  -m,  and  the  requests  to  all.
+			  -c  and -m  must  be  the  largest  of  those  swept.
+			  All -c  clients connect once,  and those not in the
+			  cell stay connected  but idle,  so that cells  reuse
+			  warm connections.  The duration  is the number of cells
+			  times --sweep-step.  To sweep the payload, give requests
+			  of  different  sizes,  such as  URIs of  different
+			  objects,  or  --sofarpc-spec  requests  of  different
+			  content.
+  --sweep-step=<DURATION>
+			  The length of a cell of --sweep-*.
+			  Default: )"
+        << util::duration_str(config.sweep_step) << R"(
+  --sweep-settle=<DURATION>
+			  The time at the start of each cell of --sweep-* which
+			  is not measured, while the load changes.
+			  Default: )"
+        << util::duration_str(config.sweep_settle) << R"(
+  --latency-precision=<N>
+			  Specifies the  precision of the latency  distribution.
+			  Latencies are  reported within 2^-<N>  of their actual
+			  value.  <N> must be in range [)"
+        << Histogram::MIN_PRECISION << ", " << Histogram::MAX_PRECISION
+        << R"(].  Larger value
+			  uses more memory.
+			  Default: )"
+        << config.latency_precision << R"(
+  --percentiles=<LIST>
+			  Specifies  the percentiles of  latency distributions
+			  in the report,  separated by ','.  Each must be in (0,
+			  100], for example 99.99.
+			  Default: )"
+        << format_percentiles(config.percentiles) << R"(
+  --slowest=<N>
+			  Reports the <N> slowest requests with the time they were
+			  sent,  the worker,  client and stream which sent them,
+			  the address and the response status,  to tell which
+			  connection, server or moment the tail latency came from.
+			  0 disables it.
+			  Default: )"
+        << config.slowest << R"(
+  --imbalance=<N>
+			  Reports how evenly the  requests spread over the
+			  connections:  Jain's fairness index of  their req/s
+			  and mean latency, and the <N> connections whose req/s
+			  or mean latency strays  furthest from the median,
+			  with their p99, errors, local port and address.  Each
+			  client keeps a coarse latency histogram of its own
+			  for this.  0 disables it.
+			  Default: )"
+        << config.imbalance << R"(
+  --response-sizes
+			  Reports  the distribution  of response  sizes  per
+			  status, split into the header map,  class name and
+			  content for  SofaRPC,  or the  headers and body for
+			  HTTP, and the latency  of responses per class of size,
+			  to tell small  error responses from full  payloads, and
+			  whether the tail latency comes with large responses.
+  --accept-encoding=<CODINGS>
+			  Sends   accept-encoding:  <CODINGS>   with  every  HTTP
+			  request,  for example "gzip, deflate",  and reports the
+			  responses and  body bytes received per content coding.
+  --decode
+			  Decodes gzip and deflate response bodies as they arrive,
+			  and reports the bytes they decode to and the time spent
+			  decoding, to tell whether compression is limited by the
+			  bandwidth or by the CPU of the client.
+  --trace=<PATH>
+			  Writes a  binary record of every request  to <PATH>.<I>
+			  for each worker <I>.  A record holds the send  time,
+			  round trip time, connection and stream, and response
+			  status.  The files are memory mapped, so recording takes
+			  no system  call.  Each file is a ring which keeps the
+			  last --trace-records requests.  Use sofaload-trace to
+			  decode them.
+  --trace-records=<N>
+			  Specifies the number of records each --trace file holds.
+			  A record takes )"
+        << sizeof(TraceRecord) << R"( bytes.
+			  Default: )"
+        << util::utos_unit(config.trace_records) << R"(
+  --request-log=<PATH>
+			  Writes  the requests picked  by --request-log-sample,
+			  --request-log-failures  and   --request-log-slow  to
+			  <PATH>,  a line  each, with  the  connection, stream,
+			  request, latency and status,  and the decoded header
+			  of the Bolt response with -p sofarpc.  Workers queue
+			  the requests  in lock-free  rings, and a  thread of
+			  its own writes  them, so that  this costs little even
+			  under full load, unlike -v.  If none of the options
+			  is given, all requests are written.
+  --request-log-sample=<N>
+			  Writes 1 in <N> requests to --request-log.
+  --request-log-failures
+			  Writes failed requests to --request-log.
+  --request-log-slow=<DURATION>
+			  Writes requests slower than <DURATION> to
+			  --request-log.
+  --clock=<CLOCK>
+			  The clock requests are timed with.  "steady" reads
+			  the monotonic clock  for each timestamp,  which may
+			  be a system call on  VMs whose clocksource the vDSO
+			  cannot read.   "tsc" reads  the CPU's invariant  TSC,
+			  converted with a rate calibrated at startup and
+			  anchored to the monotonic clock once per loop
+			  iteration, which keeps latencies within a few ppm.
+			  "loop" takes the time each loop iteration woke up,
+			  so that  a timestamp  costs nothing,  but latencies
+			  are off by up to an iteration (see Generator
+			  Overhead);  it suits  throughput-only runs.  With
+			  "tsc" and "loop", wall clock times in logs are
+			  derived from the start of the run.
+			  Default: steady
+  --perf-counters
+			  Counts cycles, instructions, last level cache misses and
+			  context switches  of each  worker thread  with hardware
+			  performance counters, and reports them per request, to
+			  tell how much sofaload itself costs.  Counters which are
+			  not available are left out.  Only supported on Linux.
+  --io-uring
+			  Does the I/O of cleartext connections with io_uring
+			  instead of libev.  Each connection is read by a single
+			  multishot  recv into  buffers  shared  by the  worker,
+			  and the writes of a loop iteration are submitted with
+			  one system call, which  cuts the system calls  made
+			  for many connections.   Falls back to libev  if the
+			  kernel does not support  it, or sofaload was built
+			  with <linux/io_uring.h> older than Linux 5.19.
+  --batch-writes
+			  Instead of writing  each request as soon as  it is
+			  submitted, writes what  each connection queued once
+			  per loop iteration, after all events of the iteration
+			  have been handled.  With -m greater than 1, requests
+			  submitted on completions of the same read then go out
+			  in one write, which cuts packets and system calls per
+			  request.
+  --cpu-affinity=<LIST>
+			  Pins worker threads to the CPUs in <LIST>, which is a
+			  comma separated  list of CPU numbers  and ranges, e.g.,
+			  "0-3,8".  Worker <I> runs on the <I>th CPU of <LIST>,
+			  wrapping  around if  there are  more workers.  If
+			  "auto" is  given, workers are  spread over the NUMA
+			  nodes in turn, one CPU  each.  A pinned worker moves
+			  its buffers,  connections and histograms to the NUMA
+			  node of its CPU, which makes results more repeatable.
+			  Every CPU  in <LIST> must be  in the affinity mask of
+			  the process.
+  --busy-poll[=<USEC>]
+			  Polls the  event loop without ever  blocking, so that
+			  responses are read as soon as they arrive instead of
+			  after the thread is woken up.  Each worker keeps one
+			  CPU busy.   If <USEC> is  given, SO_BUSY_POLL is  set
+			  to it on sockets, so that the kernel also polls the
+			  device queue for that long on reads.  This requires
+			  CAP_NET_ADMIN.  The wakeup line under "Generator
+			  Overhead" tells how long it took to read data after
+			  the kernel received it, which is what --busy-poll
+			  cuts.
+  --endpoints=<LIST>|@<FILE>
+			  Spreads clients over  the servers in <LIST> instead
+			  of  only connecting  to  the host  of the  URI.  The
+			  URI  still gives  the scheme,  path  and authority of
+			  requests.  Servers are separated by ',' or white space,
+			  and each  of them is <HOST>[:<PORT>][=<WEIGHT>], e.g.,
+			  "10.0.0.1:12200=2,10.0.0.2".  <PORT> defaults to that
+			  of the URI, and  <WEIGHT> to 1.  If  <FILE> is given
+			  with '@', the list  is read from it, where text after
+			  '#' is ignored.  Each client sticks to its server, and
+			  reconnects  to it.   Throughput and latency  are also
+			  printed per server, so that a slow one stands out.
+  --endpoint-policy=<POLICY>
+			  How clients are assigned to --endpoints.  "rr" takes
+			  servers in  turn.  "weighted"  gives each  server the
+			  share of clients  its weight tells.  "hash" puts the
+			  servers on a  consistent hash ring in proportion to
+			  their weights, so that adding or removing a server
+			  only moves the clients of that server.
+			  Default: rr
+  --ab
+			  Compares  the --endpoints,  such  as two  builds of a
+			  server,  under  the same  conditions  in  one  run.
+			  Each worker  takes the  servers in turn,  so that they
+			  share  every event loop and the  pacing alike, rather
+			  than drifting apart  in back-to-back runs.  Each server
+			  is compared with the first as --compare does,  and the
+			  run fails if  one regresses beyond --max-rps-drop or
+			  --max-latency-rise.   -c must  be a multiple of  the
+			  number of servers x -t.
+  --local-address=<ADDR>[,<ADDR>...]
+			  Binds connections to the given source IP addresses
+			  in turn,  instead of letting  the kernel choose one.
+			  With IP_BIND_ADDRESS_NO_PORT, the port is chosen on
+			  connect, so each  address offers its own ephemeral
+			  port range per server address.  This lifts the limit
+			  of around 28k connections to one server address.
+  --local-ports=<LO>-<HI>
+			  Binds connections to source  ports in the given range
+			  instead of  ephemeral ones.  Each  worker takes its
+			  share of the range,  and ports still in  use are
+			  skipped.  With  --local-address, every  address gets
+			  the whole range.
+  --timestamping[=<MODE>]
+			  Takes kernel timestamps  with SO_TIMESTAMPING when
+			  the last byte of each request is handed to the NIC,
+			  and when  the last  byte of its  response arrives,
+			  and prints the  wire latency between them next to
+			  the latency sofaload measures.  The difference is the
+			  time spent  in sofaload and  the local network stack.
+			  <MODE> is "sw" for software timestamps, or "hw" to
+			  prefer hardware ones taken by the NIC, which must be
+			  set up to  take them beforehand, e.g., with
+			  hwstamp_ctl.  Only cleartext connections without
+			  --io-uring are timestamped.
+			  Default: sw
+  --ping-interval=<DURATION>
+			  Sends a PING frame every <DURATION> on each HTTP/2
+			  connection, and a HEARTBEAT command on each SofaRPC
+			  connection,  and prints the  distribution  of their
+			  round trip  times next to  the latency.  The server
+			  answers them  without the application, so that they
+			  tell network delay from server delay.  A PING is not
+			  sent while the last one is unanswered.  HTTP/1.1 has
+			  no equivalent.
+  --tcp-info=<DURATION>
+			  Samples TCP_INFO of each TCP connection every
+			  <DURATION>, and prints the smoothed round trip time,
+			  its variation,  the congestion window, retransmits,
+			  and how much of the time spent sending was limited
+			  by the  receive window of the server or  by the send
+			  buffer, per worker next to the latency.  The samples
+			  of a worker are spread over <DURATION>.  With
+			  --timeline, they are also written to each interval.
+			  Linux only.
+  --tls-resume[=<PERCENT>]
+			  Resumes TLS sessions.  Each worker keeps the last
+			  session it got from the server, by session ID or
+			  ticket, and <PERCENT> of its new connections try to
+			  resume it.   The TLS handshake time  is then shown
+			  separately for full and resumed handshakes.
+			  Default: 100
+  --handshake-bench[=<MODE>]
+			  Measures the connection setup rate instead of the
+			  request rate.  With "handshake", each connection is
+			  closed as soon as its TLS handshake, or TCP connect
+			  for cleartext,  is done,  and counts  as a request.
+			  With "request", it sends one request and is closed
+			  after the response.   Clients then connect again
+			  until -n or  -D is reached,  and handshakes/s is
+			  printed.  Use --tls-resume  to measure resumed
+			  handshakes.
+			  Default: handshake
+  --churn-requests=<N>
+			  Closes each connection after <N> requests, once they
+			  are answered, and makes it again, to load the server
+			  with connection setup as well as requests.
+  --churn-lifetime=<DURATION>
+			  Closes each connection <DURATION> after it is made,
+			  and makes it again.  The requests in flight are lost,
+			  and counted as errors.  Reconnects, connects/s and the
+			  requests lost are printed under "churn", and the
+			  connect latency is in the connection lifecycle.
+  --reconnect=<N>
+			  Makes a client whose connection fails connect again
+			  after a backoff, up to <N> times in a row before it
+			  gives up.  The requests in flight are lost, and
+			  counted as errors.  Without this, the client gives
+			  up at once.  Failures by class, reconnects, and the
+			  time from a failure to the next connection, are in
+			  the connection lifecycle.
+			  Default: 0
+  --reconnect-backoff=<BASE>[,<CAP>]
+			  The backoff before the first reconnect of --reconnect,
+			  which doubles with each one in a row up to <CAP>.
+			  The delay is drawn uniformly from 0 to the backoff,
+			  so that clients which lost their connections at once
+			  do not come back at once.
+			  Default: 100ms,10s
+  --linger=<SEC>
+			  Sets SO_LINGER  with <SEC>  on sockets.   With 0,
+			  connections are closed with a reset, and leave no
+			  TIME_WAIT behind.
+  --sndbuf=<SIZE>, --rcvbuf=<SIZE>
+			  Sets SO_SNDBUF  and SO_RCVBUF  with <SIZE>  on sockets
+			  before they connect.  The kernel doubles <SIZE> and caps
+			  it at net.core.wmem_max and net.core.rmem_max.  By
+			  default, the kernel sizes the buffers itself.
+  --slow-read=<RATE>
+			  Makes  a share of  the connections  (see --slow-readers)
+			  read at most <RATE> bytes per second, spread in 10ms
+			  slices.  What they leave unread backs up into the
+			  server's  write buffers, while  the  other connections
+			  keep reading  as fast as they  can.  The Readers table
+			  of the report tells both apart, to show how well the
+			  server keeps the slow ones from holding back the rest.
+  --slow-read-pause=<PAUSE>,<PERIOD>
+			  Makes  the slow readers stop reading for the last
+			  <PAUSE> of every <PERIOD>, e.g. 200ms,1s.  It may be
+			  combined with --slow-read.
+  --slow-readers=<PERCENT>
+			  The  percentage  of connections  which  read  slowly
+			  with --slow-read or --slow-read-pause.
+			  Default: 10
+  --slow-rcvbuf=<SIZE>
+			  Sets SO_RCVBUF  with <SIZE>  on the sockets  of slow
+			  readers instead of  --rcvbuf, so that the kernel
+			  pushes back sooner.
+  --no-tcp-nodelay
+			  Leaves Nagle's algorithm on.  TCP_NODELAY is set on
+			  sockets by default.
+  --ktls      Hands the TLS record layer to the kernel after the
+			  handshake, so that sofaload reads and writes plaintext
+			  with several buffers per system call,  as it does for
+			  cleartext, and the crypto runs in the kernel or
+			  NIC.  It falls  back to  OpenSSL if the  kernel has no
+			  tls module or cipher support.  With --tls-resume,
+			  only sending is offloaded, so that tickets reach
+			  OpenSSL.
+  --chunk-size=<SIZE>
+			  The size of  the buffers connections read  into and
+			  write from.  Small chunks  suit small RPCs with many
+			  connections, large ones big uploads and downloads,
+			  which then take fewer system calls.  The buffer pool
+			  line of the report tells how many chunks were in use
+			  at the peak.
+			  Default: )"
+      << util::utos_unit(config.chunk_size) << R"(
+  --hugepages[=<MODE>]
+			  Backs the buffer pool  with huge pages, which saves
+			  TLB misses when  many buffers are live.  "thp" asks
+			  for transparent huge pages with madvise(2).  "hugetlb"
+			  takes pages reserved in  /proc/sys/vm/nr_hugepages,
+			  and falls back to "thp" if there are none.  The report
+			  tells which one was used.
+			  Default: thp
+  --pre-encode-headers
+			  Encodes the header block of each HTTP/2 request once
+			  at startup, using only the static table and literals
+			  which are not added to the dynamic table, and sends
+			  it as it is on every connection.  This takes header
+			  compression off the  client's CPU profile, at the cost
+			  of   larger  HEADERS  frames   than  the  dynamic
+			  table gives for repeated requests.
+  --window-auto-tune
+			  Starts HTTP/2  stream and  connection windows at the
+			  default 64KiB instead  of 1GiB,  and grows them  to
+			  twice the  bytes received in  a round trip, measured
+			  with PING frames, while doing so raises throughput.
+			  This behaves like clients which  tune their windows
+			  to  the  bandwidth-delay  product.   Either way,  the
+			  time streams and connections spend with their window
+			  used up is reported.
+  --no-rfc7540-priorities
+			  Sends  SETTINGS_NO_RFC7540_PRIORITIES  =  1  on  HTTP/2
+			  connections, and  schedules request bodies  round robin
+			  across streams  instead of maintaining  the RFC 7540
+			  dependency tree  for them.  This takes  the priority
+			  bookkeeping off  the client's CPU  profile at high -m.
+  --h1-fast-parse
+			  Parses  the header  block  of  HTTP/1.1 responses
+			  which  have  Content-Length  with  a  minimal parser,
+			  and  counts  their  bodies  without looking  at them.
+			  Other  responses, such  as chunked ones,  are  parsed
+			  by  llhttp  as usual.   This  takes HTTP parsing off
+			  the client's CPU profile  when the server sends large
+			  bodies.  It has no effect with -v.
+  --timeline=<PATH>
+			  Writes  the throughput and  latency of  each interval
+			  of  --timeline-interval  to <PATH>  in CSV  while the
+			  benchmark runs.  Latencies are in nanoseconds,  and
+			  "bytes"  and  "bytes_sent"  are those  received  and
+			  sent.  If <PATH> is "-", the timeline is written to
+			  stdout.
+  --timeline-interval=<DURATION>
+			  Specifies the length  of an interval of  --timeline,
+			  which is also  how often the  metrics of
+			  --metrics-port and --statsd are updated.
+			  Default: )"
+        << util::duration_str(config.timeline_interval) << R"(
+  --heatmap=<PATH>
+			  Writes  a  latency  heatmap  of the run to <PATH> in
+			  JSON: the number of responses in each latency bucket
+			  of each time slice.   "bounds" has the  lowest value
+			  of  each  bucket in  nanoseconds,  followed  by  the
+			  highest value of the last one plus 1, and "counts"
+			  has a row for each slice.
+  --heatmap-slice=<DURATION>
+			  Specifies  the length of a time slice of --heatmap,
+			  which is rounded to a multiple of
+			  --timeline-interval.
+			  Default: --timeline-interval
+  --heatmap-precision=<N>
+			  Specifies the precision of the latency buckets  of
+			  --heatmap,  as in  --latency-precision,  which it must
+			  not exceed.
+			  Default: )"
+        << config.heatmap_precision << R"(
+  --heatmap-slices=<N>
+			  Specifies the number of  time slices of --heatmap to
+			  keep at most.  Once the run outgrows them,  adjacent
+			  slices are merged pairwise, and the slice  length
+			  doubles.  <N> must be even.
+			  Default: )"
+        << config.heatmap_slices << R"(
+  --output=<PATH>
+			  Writes  the result  to  <PATH> in  the  format  of
+			  --output-format,  in addition  to  the  report.  The
+			  result has all counters,  the time statistics, and the
+			  percentiles and the  non-empty buckets of the latency
+			  histograms,  so  that  histograms of  several runs can
+			  be merged,  and the successful  req/s of  each
+			  --timeline-interval of the main measurement.  If
+			  <PATH> is "-", the result is written to stdout after
+			  the report.
+  --output-format=<FORMAT>
+			  Specifies the format of --output.  <FORMAT> is either
+			  "json" or  "csv".  "csv" writes a  "key,value" row for
+			  each value.
+			  Default: json
+  --compare=<PATH>
+			  Compares  this  run  with  the  baseline  result  in
+			  <PATH>, written  by --output in either  format, and
+			  exits with failure if  it regressed.  req/s and each
+			  latency percentile  are compared with  a confidence
+			  interval  from  their  values  in each
+			  --timeline-interval of both runs.  A metric regresses
+			  if  it  is worse  than  --max-rps-drop  or
+			  --max-latency-rise,  and its  whole 95%  confidence
+			  interval  is  worse  than  no  change.   A
+			  Kolmogorov-Smirnov test of the latency histograms is
+			  printed too.
+  --max-rps-drop=<PERCENT>
+			  The drop of req/s from the baseline of --compare which
+			  is a regression.
+			  Default: )"
+        << util::dtos(config.max_rps_drop) << R"(
+  --max-latency-rise=<PERCENT>
+			  The rise of a latency percentile from the baseline of
+			  --compare which is a regression.
+			  Default: )"
+        << util::dtos(config.max_latency_rise) << R"(
+  --stop-on=<COND>[,<COND>...]
+			  Ends  the  measurement  early  when  one  of  the
+			  conditions has held for --stop-window intervals of
+			  --timeline-interval in a row.  <COND> is
+			  "errors=<PERCENT>", which holds when more than
+			  <PERCENT>  of the  requests done  in the  interval
+			  failed,  "p<PERCENTILE>=<DURATION>",  which  holds
+			  when the latency at <PERCENTILE> is over <DURATION>,
+			  or "saturated", which  holds when the event loop of
+			  a  worker was  busy  for  most of  the interval.  The
+			  report is flagged with the condition, and its rates
+			  are of the measurement which ran.
+			  Example: --stop-on=errors=50,p99=2s
+  --stop-window=<N>
+			  The number of intervals in a row a condition of
+			  --stop-on must hold for.
+			  Default: )"
+        << config.stop_window << R"(
+  --metrics-port=<PORT>
+			  Serves live metrics  at /metrics on <PORT>  in the
+			  Prometheus text format while  the benchmark runs: the
+			  requests  done, succeeded,  failed and  errored,  the
+			  responses of each SofaRPC status, and the bytes so
+			  far, and the req/s, the requests in flight, the
+			  connections  and the  latency percentiles of  the last
+			  --timeline-interval.  The  metrics are  served  by the
+			  thread  which collects  --timeline,  from  lock-free
+			  per-worker queues, so that the workers never wait.
+  --statsd=<HOST>:<PORT>
+			  Pushes the metrics of --metrics-port to StatsD at
+			  <HOST>:<PORT> over UDP  every --timeline-interval, as
+			  counters  of the  interval  and gauges,  named
+			  "sofaload.*".  Latencies  are in milliseconds.  IPv6
+			  addresses must be enclosed in brackets.
+  -v, --verbose
+			  Output debug information.
+  --version   Display version information and exit.
+  -h, --help  Display this help and exit.
+
+--
+
+  The <SIZE> argument is an integer and an optional unit (e.g., 10K is
+  10 * 1024).  Units are K, M and G (powers of 1024).
+
+  The <DURATION> argument is an integer and an optional unit (e.g., 1s
+  is 1 second and 500ms is 500 milliseconds).  Units are h, m, s or ms
+  (hours, minutes, seconds and milliseconds, respectively).  If a unit
+  is omitted, a second is used as unit.)"
+        << std::endl;
+}
+} // namespace
+
+namespace {
+// Returns the share of |total| which the |i|th of |n| agents takes.
+size_t agent_share(size_t total, size_t n, size_t i) {
+    return total / n + (i < total % n);
+}
+} // namespace
+
+namespace {
+// Returns the arguments which the runs of --agents or --shards run
+// with: those of this one, but the options in |own|, which are its
+// own, such as --output and --compare, which are handled here.
+std::vector<std::string>
+make_run_args(int argc, char **argv,
+              std::initializer_list<StringRef> own) {
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--") {
+            args.insert(std::end(args), &argv[i], &argv[argc]);
+            break;
+        }
+        auto skip = false;
+        for (auto &opt : own) {
+            if (arg == opt) {
+                ++i;
+                skip = true;
+                break;
+            }
+            if (util::starts_with(arg, opt) && arg.size() > opt.size() &&
+                arg[opt.size()] == '=') {
+                skip = true;
+                break;
+            }
+        }
+        if (!skip) {
+            args.push_back(std::move(arg));
+        }
+    }
+    return args;
+}
+} // namespace
+
+namespace {
+// Appends to |args| the share of -c, -n, --qps and -r which the |i|th
+// of |n| runs takes.
+void add_share_args(std::vector<std::string> &args, size_t n, size_t i) {
+    args.push_back("--clients=" +
+                   util::utos(agent_share(config.nclients, n, i)));
+    if (!config.is_timing_based_mode()) {
+        args.push_back("--requests=" +
+                       util::utos(agent_share(config.nreqs, n, i)));
+    }
+    if (config.is_qps_mode()) {
+        args.push_back("--qps=" + util::utos(agent_share(config.qps, n, i)));
+    }
+    if (config.is_rate_mode()) {
+        args.push_back("--rate=" + util::utos(agent_share(config.rate, n, i)));
+    }
+}
+} // namespace
+
+namespace {
+// Returns the time in milliseconds since the epoch, |delay| from now,
+// when the runs of --agents or --shards start together.
+int64_t run_start_time(std::chrono::milliseconds delay) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch() + delay)
+        .count();
+}
+} // namespace
+
+namespace {
+// Reads the AgentResult of each run from |fds|, and reports their
+// merged results, followed by a line for each run, named by |names|.
+// |opt| is the option, and |kind| the kind of the runs, in the
+// messages.  |fds| are closed.  If |result_fd| is not -1, the merged
+// result is sent to it too, as by a run of an agent.  Returns the exit
+// status.
+int report_runs(const std::vector<int> &fds,
+                const std::vector<std::string> &names, const char *opt,
+                const char *kind, int result_fd) {
+    Stats stats(config.latency_precision);
+    Histogram rtt_hist(config.latency_precision);
+    Histogram corrected_rtt_hist(config.latency_precision);
+    // The run is as long as the slowest one.
+    double duration = 0.;
+    size_t total_req = 0;
+    std::ostringstream run_lines;
+    auto failed = false;
+    for (size_t i = 0; i < fds.size(); ++i) {
+        std::string msg;
+        AgentResult res(config.latency_precision);
+        Stats s(config.latency_precision);
+        if (read_message(fds[i], msg) != 0 ||
+            decode_agent_result(res, s, msg) != 0) {
+            std::cerr << opt << ": " << kind << " " << names[i]
+                      << " failed to run" << std::endl;
+            close(fds[i]);
+            failed = true;
+            continue;
+        }
+        close(fds[i]);
+
+        merge_stats(stats, s);
+        rtt_hist.merge(res.rtt_hist);
+        corrected_rtt_hist.merge(res.corrected_rtt_hist);
+        duration = std::max(duration, res.duration);
+        total_req += res.total_req;
+
+        auto rates = compute_rates(
+            s, std::chrono::microseconds(
+                   static_cast<int64_t>(res.duration * 1000000)));
+        run_lines << "  " << std::left << std::setw(24) << names[i]
+                  << std::right << std::setw(10) << s.req_status_success
+                  << std::setw(10) << s.req_failed << std::setw(12)
+                  << util::format_duration(res.duration) << std::setw(14)
+                  << std::fixed << std::setprecision(2) << rates.rps << "\n";
+    }
+
+    if (failed) {
+        return EXIT_FAILURE;
+    }
+
+    auto dur =
+        std::chrono::microseconds(static_cast<int64_t>(duration * 1000000));
+    auto ts = process_time_stats(stats);
+    auto rates = compute_rates(stats, dur);
+
+    if (result_fd != -1) {
+        AgentResult res(config.latency_precision);
+        res.total_req = total_req;
+        res.duration = duration;
+        res.rtt_hist.merge(rtt_hist);
+        res.corrected_rtt_hist.merge(corrected_rtt_hist);
+        WireWriter w;
+        encode_agent_result(w, res, stats);
+        if (write_message(result_fd, w.buf()) != 0) {
+            std::cerr << "--agent-fd: cannot send the result" << std::endl;
+        }
+        close(result_fd);
+    }
+
+    print_summary(stats, ts, dur, total_req, rates);
+
+    print_latency_distribution("Latency  Distribution", rtt_hist);
+
+    if (config.oneway) {
+        print_oneway(stats, rates.rps, rates.sent_bps);
+    }
+
+    if (config.is_qps_mode()) {
+        print_latency_distribution(
+            "Corrected Latency  Distribution (from intended start)",
+            corrected_rtt_hist);
+    }
+
+    std::cout << "\n  Per-" << kind << " results\n"
+              << "  " << std::left << std::setw(25) << kind << std::right
+              << "succeeded    failed    duration         req/s\n"
+              << run_lines.str() << std::flush;
+
+    // Connections and workers are only known to the runs.
+    if ((!config.output_file.empty() || !config.compare_file.empty()) &&
+        write_output(stats, ts, duration, rates.rps, rates.bps, total_req,
+                     rtt_hist, corrected_rtt_hist,
+                     ConnectionStat(config.latency_precision), {}, {}, {},
+                     {}) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+} // namespace
+
+namespace {
+// Runs the benchmark on |agents|, splitting -c, -n, --qps and -r
+// among them, and reports their merged results.  The agents start at
+// the same time, as far as their clocks agree.  |token| is the
+// --agent-token they expect.  Returns the exit status.
+int run_coordinator(const std::vector<AgentAddr> &agents,
+                    const std::string &token, int argc, char **argv) {
+    auto n = agents.size();
+
+    auto args = make_run_args(argc, argv,
+                              {StringRef::from_lit("--agents"),
+                               StringRef::from_lit("--agent-token"),
+                               StringRef::from_lit("--output"),
+                               StringRef::from_lit("--compare"),
+                               StringRef::from_lit("--plugin"),
+                               StringRef::from_lit("--plugin-arg")});
+    // Fail here rather than on every agent.
+    if (check_run_args(args, "--agents") != 0) {
+        return EXIT_FAILURE;
+    }
+
+    std::vector<int> fds;
+    std::vector<std::string> names;
+    for (auto &addr : agents) {
+        auto fd = connect_agent(addr);
+        if (fd == -1) {
+            return EXIT_FAILURE;
+        }
+        fds.push_back(fd);
+        names.push_back(format_agent_addr(addr));
+    }
+
+    // Leave the agents time to set up before they start.
+    auto start_time = run_start_time(std::chrono::milliseconds(2000));
+
+    for (size_t i = 0; i < n; ++i) {
+        RunSpec spec;
+        spec.token = token;
+        spec.args = args;
+        add_share_args(spec.args, n, i);
+        spec.start_time = start_time;
+
+        WireWriter w;
+        encode_run_spec(w, spec);
+        if (write_message(fds[i], w.buf()) != 0) {
+            std::cerr << "--agents: cannot send the run to " << names[i]
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::cout << "starting benchmark on " << n << " agents..." << std::endl;
+
+    return report_runs(fds, names, "--agents", "agent", -1);
+}
+} // namespace
+
+namespace {
+// Runs the benchmark in |n| child processes of this executable, which
+// share nothing, splitting -c, -n, --qps, -r and -t among them, and
+// reports their merged results.  The workers are pinned to the CPUs
+// they would be pinned to in a single process.  Each child sends its
+// result over a socket pair, as to an agent.  If this is a run of an
+// agent, |agent_fd| and |start_at| are its --agent-fd and --start-at,
+// or -1 and 0.  Returns the exit status.
+int run_shards(size_t n, int argc, char **argv, int agent_fd,
+               int64_t start_at) {
+    auto args = make_run_args(argc, argv,
+                              {StringRef::from_lit("--shards"),
+                               StringRef::from_lit("--output"),
+                               StringRef::from_lit("--compare"),
+                               StringRef::from_lit("--agent-fd"),
+                               StringRef::from_lit("--start-at")});
+    // Leave the shards time to set up before they start.
+    auto start_time =
+        start_at ? start_at : run_start_time(std::chrono::milliseconds(1000));
+
+    std::vector<int> fds;
+    std::vector<std::string> names;
+    std::vector<pid_t> pids;
+    // The index of the first worker of the shard, across all shards
+    size_t first_worker = 0;
+    for (size_t i = 0; i < n; ++i) {
+        RunSpec spec;
+        spec.args = args;
+        add_share_args(spec.args, n, i);
+        auto nthreads = agent_share(config.nthreads, n, i);
+        spec.args.push_back("--threads=" + util::utos(nthreads));
+        if (!config.worker_cpus.empty()) {
+            std::string cpus;
+            for (size_t j = 0; j < nthreads; ++j) {
+                if (j) {
+                    cpus += ',';
+                }
+                cpus += util::utos(config.worker_cpus[(first_worker + j) %
+                                                      config.worker_cpus.size()]);
+            }
+            spec.args.push_back("--cpu-affinity=" + cpus);
+        }
+        first_worker += nthreads;
+        spec.start_time = start_time;
+
+        int sv[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sv) == -1) {
+            std::cerr << "--shards: cannot create socket pair: "
+                      << strerror(errno) << std::endl;
+            break;
+        }
+        auto pid = spawn_run(spec, sv[1], true);
+        close(sv[1]);
+        if (pid == -1) {
+            close(sv[0]);
+            break;
+        }
+        fds.push_back(sv[0]);
+        names.push_back(util::utos(i));
+        pids.push_back(pid);
+    }
+
+    auto rv = EXIT_FAILURE;
+    if (pids.size() == n) {
+        std::cout << "starting benchmark on " << n << " shards..."
+                  << std::endl;
+        rv = report_runs(fds, names, "--shards", "shard", agent_fd);
+    } else {
+        for (size_t i = 0; i < pids.size(); ++i) {
+            kill(pids[i], SIGKILL);
+            close(fds[i]);
+        }
+    }
+
+    for (auto pid : pids) {
+        int status;
+        while (waitpid(pid, &status, 0) == -1 && errno == EINTR)
+            ;
+    }
+
+    return rv;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+
+    tls::libssl_init();
+
+    tls::LibsslGlobalLock lock;
+
+    std::string datafile;
+
+    std::string sofaRpcClassname;
+    std::string sofaRpcHeaderArg;
+    std::string sofaRpcContent;
+    size_t sofaRpcTimeout = 0;
+    std::string sofarpc_spec_file;
+    std::string replay_file;
+    std::string scenario_file;
+    std::string sweep_clients, sweep_streams, sweep_requests;
+    std::string sofarpc_args;
+    std::string subst_keys_file;
+    std::vector<AgentAddr> agents;
+    uint16_t agent_port = 0;
+    // The address --agent listens on, and the secret shared by --agent
+    // and --agents
+    std::string agent_bind = "127.0.0.1";
+    std::string agent_token;
+    // The connection to the agent which runs this, and when to start
+    // the run
+    int agent_fd = -1;
+    int64_t start_at = 0;
+    // The number of processes of --shards
+    size_t nshards = 1;
+
+    while (1) {
+        static int flag = 0;
+        constexpr static option long_options[] = {
+            {"sofaRpcClassName", required_argument, nullptr, 'e'},
+            {"sofaRpcHeader", required_argument, nullptr, 'a'},
+            {"sofaRpcContent", required_argument, nullptr, 'o'},
+            {"sofaRpcTimeout", required_argument, nullptr, 'k'},
+            {"requests", required_argument, nullptr, 'n'},
+            {"input-file", required_argument, nullptr, 'i'},
+            {"base-uri", required_argument, nullptr, 'B'},
+            {"clients", required_argument, nullptr, 'c'},
+            {"data", required_argument, nullptr, 'd'},
+            {"threads", required_argument, nullptr, 't'},
+            {"max-concurrent-streams", required_argument, nullptr, 'm'},
+            {"header", required_argument, nullptr, 'H'},
+            {"no-tls-proto", required_argument, nullptr, 'p'},
+            {"verbose", no_argument, nullptr, 'v'},
+            {"help", no_argument, nullptr, 'h'},
+            {"version", no_argument, &flag, 1},
+            {"rate", required_argument, nullptr, 'r'},
+            {"connection-active-timeout", required_argument, nullptr, 'T'},
+            {"connection-inactivity-timeout", required_argument, nullptr, 'N'},
+            {"duration", required_argument, nullptr, 'D'},
+            {"rate-period", required_argument, &flag, 5},
+            {"h1", no_argument, &flag, 6},
+            {"header-table-size", required_argument, &flag, 7},
+            {"encoder-header-table-size", required_argument, &flag, 8},
+            {"warm-up-time", required_argument, &flag, 9},
+            {"qps", required_argument, &flag, 11},
+            {"latency-precision", required_argument, &flag, 12},
+            {"qps-arrival", required_argument, &flag, 13},
+            {"qps-profile", required_argument, &flag, 14},
+            {"slo-search", required_argument, &flag, 15},
+            {"slo-latency", required_argument, &flag, 16},
+            {"slo-percentile", required_argument, &flag, 17},
+            {"slo-error-rate", required_argument, &flag, 18},
+            {"slo-step", required_argument, &flag, 19},
+            {"slo-max-steps", required_argument, &flag, 20},
+            {"qps-burst", required_argument, &flag, 21},
+            {"timeline", required_argument, &flag, 22},
+            {"timeline-interval", required_argument, &flag, 23},
+            {"output", required_argument, &flag, 24},
+            {"output-format", required_argument, &flag, 25},
+            {"percentiles", required_argument, &flag, 26},
+            {"slowest", required_argument, &flag, 27},
+            {"trace", required_argument, &flag, 28},
+            {"trace-records", required_argument, &flag, 29},
+            {"perf-counters", no_argument, &flag, 30},
+            {"io-uring", no_argument, &flag, 31},
+            {"batch-writes", no_argument, &flag, 32},
+            {"cpu-affinity", required_argument, &flag, 33},
+            {"busy-poll", optional_argument, &flag, 34},
+            {"timestamping", optional_argument, &flag, 35},
+            {"local-address", required_argument, &flag, 36},
+            {"local-ports", required_argument, &flag, 37},
+            {"endpoints", required_argument, &flag, 38},
+            {"endpoint-policy", required_argument, &flag, 39},
+            {"tls-resume", optional_argument, &flag, 40},
+            {"handshake-bench", optional_argument, &flag, 41},
+            {"ktls", no_argument, &flag, 42},
+            {"chunk-size", required_argument, &flag, 43},
+            {"hugepages", optional_argument, &flag, 44},
+            {"pre-encode-headers", no_argument, &flag, 45},
+            {"ping-interval", required_argument, &flag, 46},
+            {"window-auto-tune", no_argument, &flag, 47},
+            {"connections-per-client", required_argument, &flag, 48},
+            {"h1-fast-parse", no_argument, &flag, 49},
+            {"bolt-version", required_argument, &flag, 50},
+            {"bolt-crc", no_argument, &flag, 51},
+            {"sofarpc-spec", required_argument, &flag, 52},
+            {"sofarpc-args", required_argument, &flag, 53},
+            {"mix", required_argument, &flag, 54},
+            {"subst-keys", required_argument, &flag, 55},
+            {"oneway", no_argument, &flag, 56},
+            {"stream-messages", required_argument, &flag, 57},
+            {"stream-end-header", required_argument, &flag, 58},
+            {"aimd", no_argument, &flag, 59},
+            {"aimd-backoff", required_argument, &flag, 60},
+            {"replay", required_argument, &flag, 61},
+            {"replay-speed", required_argument, &flag, 62},
+            {"agents", required_argument, &flag, 63},
+            {"agent", required_argument, &flag, 64},
+            {"agent-fd", required_argument, &flag, 65},
+            {"start-at", required_argument, &flag, 66},
+            {"request-timeout", required_argument, &flag, 67},
+            {"churn-requests", required_argument, &flag, 68},
+            {"churn-lifetime", required_argument, &flag, 69},
+            {"linger", required_argument, &flag, 70},
+            {"no-tcp-nodelay", no_argument, &flag, 71},
+            {"warm-up-auto", required_argument, &flag, 72},
+            {"warm-up-window", required_argument, &flag, 73},
+            {"warm-up-tolerance", required_argument, &flag, 74},
+            {"drain-time", required_argument, &flag, 75},
+            {"compare", required_argument, &flag, 76},
+            {"max-rps-drop", required_argument, &flag, 77},
+            {"max-latency-rise", required_argument, &flag, 78},
+            {"metrics-port", required_argument, &flag, 79},
+            {"statsd", required_argument, &flag, 80},
+            {"request-log", required_argument, &flag, 81},
+            {"request-log-sample", required_argument, &flag, 82},
+            {"request-log-failures", no_argument, &flag, 83},
+            {"request-log-slow", required_argument, &flag, 84},
+            {"plugin", required_argument, &flag, 85},
+            {"plugin-arg", required_argument, &flag, 86},
+            {"scenario", required_argument, &flag, 87},
+            {"think-time", required_argument, &flag, 88},
+            {"sweep-clients", required_argument, &flag, 89},
+            {"sweep-streams", required_argument, &flag, 90},
+            {"sweep-requests", required_argument, &flag, 91},
+            {"sweep-step", required_argument, &flag, 92},
+            {"sweep-settle", required_argument, &flag, 93},
+            {"ab", no_argument, &flag, 94},
+            {"response-sizes", no_argument, &flag, 95},
+            {"accept-encoding", required_argument, &flag, 96},
+            {"decode", no_argument, &flag, 97},
+            {"grpc", no_argument, &flag, 98},
+            {"reconnect", required_argument, &flag, 99},
+            {"reconnect-backoff", required_argument, &flag, 100},
+            {"stop-on", required_argument, &flag, 101},
+            {"stop-window", required_argument, &flag, 102},
+            {"imbalance", required_argument, &flag, 103},
+            {"sndbuf", required_argument, &flag, 104},
+            {"rcvbuf", required_argument, &flag, 105},
+            {"tcp-info", required_argument, &flag, 106},
+            {"ready", required_argument, &flag, 107},
+            {"ready-timeout", required_argument, &flag, 108},
+            {"hedge", required_argument, &flag, 109},
+            {"hedge-cancel", no_argument, &flag, 110},
+            {"retry", required_argument, &flag, 111},
+            {"slow-read", required_argument, &flag, 112},
+            {"slow-read-pause", required_argument, &flag, 113},
+            {"slow-readers", required_argument, &flag, 114},
+            {"slow-rcvbuf", required_argument, &flag, 115},
+            {"clock", required_argument, &flag, 116},
+            {"no-rfc7540-priorities", no_argument, &flag, 117},
+            {"heatmap", required_argument, &flag, 118},
+            {"heatmap-slice", required_argument, &flag, 119},
+            {"heatmap-precision", required_argument, &flag, 120},
+            {"heatmap-slices", required_argument, &flag, 121},
+            {"shards", required_argument, &flag, 122},
+            {"agent-token", required_argument, &flag, 123},
+            {"agent-bind", required_argument, &flag, 124},
+            {nullptr, 0, nullptr, 0}};
+        int option_index = 0;
+        auto c =
+            getopt_long(argc, argv, "hv:c:d:m:n:p:t:H:i:B:r:T:N:D:e:a:o:k:",
+                        long_options, &option_index);
+        if (c == -1) {
+            break;
+        }
+        switch (c) {
+        case 'n':
+            config.nreqs = strtoul(optarg, nullptr, 10);
+            break;
+        case 'c':
+            config.nclients = strtoul(optarg, nullptr, 10);
+            break;
+        case 'd':
+            datafile = optarg;
+            break;
+        case 't':
+            if (util::strieq_l("auto", StringRef{optarg})) {
+                config.nthreads_auto = true;
+            } else {
+                config.nthreads = strtoul(optarg, nullptr, 10);
+                config.nthreads_auto = false;
+            }
+            break;
+        case 'm':
+            config.max_concurrent_streams = strtoul(optarg, nullptr, 10);
+            break;
+        case 'H': {
             char *header = optarg;
             // Skip first possible ':' in the header name
             char *value = strchr(optarg + 1, ':');
@@ -1741,145 +10782,1227 @@ int main(int argc, char **argv) {
                 std::cerr << "-H: invalid header: " << optarg << std::endl;
                 exit(EXIT_FAILURE);
             }
-            *value = 0;
-            value++;
-            while (isspace(*value)) {
-                value++;
+            *value = 0;
+            value++;
+            while (isspace(*value)) {
+                value++;
+            }
+            if (*value == 0) {
+                // This could also be a valid case for suppressing a header
+                // similar to curl
+                std::cerr << "-H: invalid header - value missing: " << optarg
+                          << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            // Note that there is no processing currently to handle multiple
+            // message-header fields with the same field name
+            config.custom_headers.emplace_back(header, value);
+            util::inp_strlower(config.custom_headers.back().name);
+            break;
+        }
+        case 'i':
+            config.ifile = optarg;
+            break;
+        case 'B': {
+            auto arg = StringRef{optarg};
+            config.base_uri = "";
+            config.base_uri_unix = false;
+
+            if (util::istarts_with_l(arg, UNIX_PATH_PREFIX)) {
+                if (parse_unix_path(optarg + str_size(UNIX_PATH_PREFIX)) !=
+                    0) {
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            }
+
+            if (!parse_base_uri(arg)) {
+                std::cerr << "--base-uri: invalid base URI: " << arg
+                          << std::endl;
+                exit(EXIT_FAILURE);
+            }
+
+            config.base_uri = arg.str();
+            break;
+        }
+        case 'e':
+            sofaRpcClassname = optarg;
+            break;
+        case 'a':
+            sofaRpcHeaderArg = optarg;
+            break;
+        case 'o':
+            sofaRpcContent = optarg;
+            break;
+        case 'k':
+            sofaRpcTimeout = strtoul(optarg, nullptr, 10);
+            break;
+        case 'p': {
+            auto proto = StringRef{optarg};
+            if (util::strieq(
+                    StringRef::from_lit(NGHTTP2_CLEARTEXT_PROTO_VERSION_ID),
+                    proto)) {
+                config.no_tls_proto = Config::PROTO_HTTP2;
+            } else if (util::strieq(NGHTTP2_H1_1, proto)) {
+                config.no_tls_proto = Config::PROTO_HTTP1_1;
+            } else if (util::strieq(SOFARPC, proto)) {
+                config.no_tls_proto = Config::PROTO_SOFARPC;
+            } else {
+                std::cerr << "-p: unsupported protocol " << proto << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            break;
+        }
+        case 'r':
+            config.rate = strtoul(optarg, nullptr, 10);
+            if (config.rate == 0) {
+                std::cerr << "-r: the rate at which connections are made "
+                          << "must be positive." << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            break;
+        case 'T':
+            config.conn_active_timeout = util::parse_duration_with_unit(optarg);
+            if (!std::isfinite(config.conn_active_timeout)) {
+                std::cerr
+                    << "-T: bad value for the conn_active_timeout wait time: "
+                    << optarg << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            break;
+        case 'N':
+            config.conn_inactivity_timeout =
+                util::parse_duration_with_unit(optarg);
+            if (!std::isfinite(config.conn_inactivity_timeout)) {
+                std::cerr << "-N: bad value for the conn_inactivity_timeout "
+                             "wait time: "
+                          << optarg << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            break;
+        case 'D':
+            config.duration = strtoul(optarg, nullptr, 10);
+            if (config.duration == 0) {
+                std::cerr
+                    << "-D: the main duration for timing-based benchmarking "
+                    << "must be positive." << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            break;
+        case 'v':
+            config.verbose = true;
+            break;
+        case 'h':
+            print_help(std::cout);
+            exit(EXIT_SUCCESS);
+        case '?':
+            util::show_candidates(argv[optind - 1], long_options);
+            exit(EXIT_FAILURE);
+        case 0:
+            switch (flag) {
+            case 1:
+                // version option
+                print_version(std::cout);
+                exit(EXIT_SUCCESS);
+            case 5:
+                // rate-period
+                config.rate_period = util::parse_duration_with_unit(optarg);
+                if (!std::isfinite(config.rate_period)) {
+                    std::cerr << "--rate-period: value error " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 6:
+                // --h1
+                config.npn_list = util::parse_config_str_list(
+                    StringRef::from_lit("http/1.1"));
+                config.no_tls_proto = Config::PROTO_HTTP1_1;
+                break;
+            case 7:
+                // --header-table-size
+                if (parse_header_table_size(config.header_table_size,
+                                            "header-table-size", optarg) != 0) {
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 8:
+                // --encoder-header-table-size
+                if (parse_header_table_size(config.encoder_header_table_size,
+                                            "encoder-header-table-size",
+                                            optarg) != 0) {
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 9:
+                // --warm-up-time
+                config.warm_up_time = util::parse_duration_with_unit(optarg);
+                if (!std::isfinite(config.warm_up_time)) {
+                    std::cerr << "--warm-up-time: value error " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 11:
+                // --qps
+                config.qps = strtoul(optarg, nullptr, 10);
+                break;
+            case 12: {
+                // --latency-precision
+                auto n = strtoul(optarg, nullptr, 10);
+                if (n < Histogram::MIN_PRECISION ||
+                    n > Histogram::MAX_PRECISION) {
+                    std::cerr << "--latency-precision: must be in range ["
+                              << Histogram::MIN_PRECISION << ", "
+                              << Histogram::MAX_PRECISION << "]" << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.latency_precision = n;
+                break;
+            }
+            case 13: {
+                // --qps-arrival
+                auto arrival = StringRef{optarg};
+                if (util::strieq_l("periodic", arrival)) {
+                    config.qps_arrival = ArrivalProcess::PERIODIC;
+                } else if (util::strieq_l("poisson", arrival)) {
+                    config.qps_arrival = ArrivalProcess::POISSON;
+                } else if (util::strieq_l("uniform", arrival)) {
+                    config.qps_arrival = ArrivalProcess::UNIFORM;
+                } else if (util::strieq_l("constant", arrival)) {
+                    config.qps_arrival = ArrivalProcess::CONSTANT;
+                } else {
+                    std::cerr << "--qps-arrival: unknown arrival process "
+                              << arrival << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            }
+            case 14: {
+                // --qps-profile
+                std::string spec;
+                if (optarg[0] == '@') {
+                    std::ifstream f(optarg + 1);
+                    if (!f) {
+                        std::cerr << "--qps-profile: cannot open "
+                                  << optarg + 1 << std::endl;
+                        exit(EXIT_FAILURE);
+                    }
+                    spec.assign(std::istreambuf_iterator<char>(f),
+                                std::istreambuf_iterator<char>());
+                } else {
+                    spec = optarg;
+                }
+                config.qps_profile.clear();
+                if (parse_qps_profile(config.qps_profile, spec) != 0) {
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            }
+            case 15: {
+                // --slo-search
+                auto range = StringRef{optarg};
+                auto dash = std::find(std::begin(range), std::end(range), '-');
+                auto min_qps =
+                    util::parse_uint(StringRef{std::begin(range), dash});
+                auto max_qps =
+                    dash == std::end(range)
+                        ? -1
+                        : util::parse_uint(StringRef{dash + 1, std::end(range)});
+                if (min_qps <= 0 || max_qps < min_qps) {
+                    std::cerr << "--slo-search: bad qps range " << range
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.slo_min_qps = min_qps;
+                config.slo_max_qps = max_qps;
+                break;
+            }
+            case 16:
+                // --slo-latency
+                config.slo_latency = util::parse_duration_with_unit(optarg);
+                if (!std::isfinite(config.slo_latency) ||
+                    config.slo_latency <= 0.) {
+                    std::cerr << "--slo-latency: value error " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 17:
+                // --slo-percentile
+                config.slo_percentile = strtod(optarg, nullptr);
+                if (!(config.slo_percentile > 0.) ||
+                    config.slo_percentile > 100.) {
+                    std::cerr << "--slo-percentile: must be in range (0, 100]"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 18:
+                // --slo-error-rate
+                config.slo_error_rate = strtod(optarg, nullptr);
+                if (!(config.slo_error_rate >= 0.) ||
+                    config.slo_error_rate > 100.) {
+                    std::cerr << "--slo-error-rate: must be in range [0, 100]"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 19:
+                // --slo-step
+                config.slo_step = util::parse_duration_with_unit(optarg);
+                if (!std::isfinite(config.slo_step) || config.slo_step <= 0.) {
+                    std::cerr << "--slo-step: value error " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 20:
+                // --slo-max-steps
+                config.slo_max_steps = strtoul(optarg, nullptr, 10);
+                if (config.slo_max_steps == 0) {
+                    std::cerr << "--slo-max-steps: must be positive"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 21: {
+                // --qps-burst
+                char *end;
+                errno = 0;
+                auto n = strtoull(optarg, &end, 10);
+                if (errno != 0 || *end != '\0' || optarg[0] == '-') {
+                    std::cerr << "--qps-burst: value error " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.qps_burst = n;
+                break;
+            }
+            case 22:
+                // --timeline
+                config.timeline_file = optarg;
+                break;
+            case 23:
+                // --timeline-interval
+                config.timeline_interval = util::parse_duration_with_unit(optarg);
+                if (!std::isfinite(config.timeline_interval) ||
+                    config.timeline_interval <= 0.) {
+                    std::cerr << "--timeline-interval: value error " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 24:
+                // --output
+                config.output_file = optarg;
+                break;
+            case 25: {
+                // --output-format
+                auto format = StringRef{optarg};
+                if (util::strieq_l("json", format)) {
+                    config.output_format = OutputFormat::JSON;
+                } else if (util::strieq_l("csv", format)) {
+                    config.output_format = OutputFormat::CSV;
+                } else {
+                    std::cerr << "--output-format: unknown format " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            }
+            case 26:
+                // --percentiles
+                if (parse_percentiles(config.percentiles, optarg) != 0) {
+                    std::cerr << "--percentiles: value error " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 27: {
+                // --slowest
+                char *end;
+                errno = 0;
+                auto n = strtoul(optarg, &end, 10);
+                if (errno != 0 || *end != '\0' || optarg[0] == '-') {
+                    std::cerr << "--slowest: value error " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.slowest = n;
+                break;
+            }
+            case 28:
+                // --trace
+                config.trace_file = optarg;
+                break;
+            case 29: {
+                // --trace-records
+                auto n = util::parse_uint_with_unit(optarg);
+                if (n <= 0) {
+                    std::cerr << "--trace-records: value error " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.trace_records = n;
+                break;
+            }
+            case 30:
+                // --perf-counters
+                config.perf_counters = true;
+                break;
+            case 31:
+                // --io-uring
+                config.io_uring = true;
+                break;
+            case 32:
+                // --batch-writes
+                config.batch_writes = true;
+                break;
+            case 33: {
+                // --cpu-affinity
+                if (util::strieq_l("auto", StringRef{optarg})) {
+                    config.cpu_affinity_auto = true;
+                    break;
+                }
+                auto cpus = util::parse_uint_ranges(StringRef{optarg});
+                if (cpus.empty()) {
+                    std::cerr << "--cpu-affinity: value error " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                auto allowed = available_cpus();
+                for (auto cpu : cpus) {
+                    if (std::find(std::begin(allowed), std::end(allowed),
+                                  cpu) == std::end(allowed)) {
+                        std::cerr << "--cpu-affinity: CPU " << cpu
+                                  << " is not available to this process"
+                                  << std::endl;
+                        exit(EXIT_FAILURE);
+                    }
+                }
+                config.cpu_affinity_auto = false;
+                config.worker_cpus = std::move(cpus);
+                break;
+            }
+            case 34:
+                // --busy-poll
+                config.busy_poll = true;
+                if (optarg) {
+                    auto n = util::parse_uint(optarg);
+                    if (n == -1 || n > std::numeric_limits<int>::max()) {
+                        std::cerr << "--busy-poll: value error " << optarg
+                                  << std::endl;
+                        exit(EXIT_FAILURE);
+                    }
+                    config.busy_poll_usec = n;
+                }
+                break;
+            case 35:
+                // --timestamping
+                config.timestamping = true;
+                if (!optarg || util::strieq_l("sw", StringRef{optarg})) {
+                    config.timestamping_hw = false;
+                } else if (util::strieq_l("hw", StringRef{optarg})) {
+                    config.timestamping_hw = true;
+                } else {
+                    std::cerr << "--timestamping: value error " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 36:
+                // --local-address
+                if (parse_local_addresses(config.local_addrs, optarg) != 0) {
+                    std::cerr << "--local-address: value error " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 37: {
+                // --local-ports
+                auto ports = util::parse_uint_ranges(StringRef{optarg});
+                if (ports.empty() || ports.front() == 0 ||
+                    ports.back() > std::numeric_limits<uint16_t>::max() ||
+                    ports.back() - ports.front() + 1 != ports.size()) {
+                    std::cerr << "--local-ports: value error " << optarg
+                              << ": must be a range of non-zero ports, e.g., "
+                                 "20000-60000"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.local_port_lo = ports.front();
+                config.local_port_hi = ports.back();
+                break;
+            }
+            case 38: {
+                // --endpoints
+                std::string spec;
+                if (optarg[0] == '@') {
+                    std::ifstream f(optarg + 1);
+                    if (!f) {
+                        std::cerr << "--endpoints: cannot open " << optarg + 1
+                                  << std::endl;
+                        exit(EXIT_FAILURE);
+                    }
+                    spec.assign(std::istreambuf_iterator<char>(f),
+                                std::istreambuf_iterator<char>());
+                } else {
+                    spec = optarg;
+                }
+                config.endpoints.clear();
+                if (parse_endpoints(config.endpoints, spec) != 0) {
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            }
+            case 39: {
+                // --endpoint-policy
+                auto policy = StringRef{optarg};
+                if (util::strieq_l("rr", policy)) {
+                    config.endpoint_policy = EndpointPolicy::ROUND_ROBIN;
+                } else if (util::strieq_l("weighted", policy)) {
+                    config.endpoint_policy = EndpointPolicy::WEIGHTED;
+                } else if (util::strieq_l("hash", policy)) {
+                    config.endpoint_policy = EndpointPolicy::HASH;
+                } else {
+                    std::cerr << "--endpoint-policy: unknown policy " << policy
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            }
+            case 40: {
+                // --tls-resume
+                auto n = optarg ? util::parse_uint(optarg) : 100;
+                if (n < 0 || n > 100) {
+                    std::cerr << "--tls-resume: value error " << optarg
+                              << ": must be a percentage in [0, 100]"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.tls_resume = n;
+                break;
+            }
+            case 41:
+                // --handshake-bench
+                if (!optarg ||
+                    util::strieq_l("handshake", StringRef{optarg})) {
+                    config.handshake_bench = HandshakeBench::HANDSHAKE;
+                } else if (util::strieq_l("request", StringRef{optarg})) {
+                    config.handshake_bench = HandshakeBench::REQUEST;
+                } else {
+                    std::cerr << "--handshake-bench: unknown mode " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 42:
+                // --ktls
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+                config.ktls = true;
+#else  // !(defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS))
+                std::cerr << "--ktls: OpenSSL was built without kTLS support"
+                          << std::endl;
+                exit(EXIT_FAILURE);
+#endif // !(defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS))
+                break;
+            case 43: {
+                // --chunk-size
+                auto n = util::parse_uint_with_unit(optarg);
+                if (n < static_cast<int64_t>(1_k) ||
+                    n > static_cast<int64_t>(16_m)) {
+                    std::cerr << "--chunk-size: value error " << optarg
+                              << ": must be in [1K, 16M]" << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.chunk_size = n;
+                break;
+            }
+            case 44:
+                // --hugepages
+                if (!optarg || util::strieq_l("thp", StringRef{optarg})) {
+                    config.chunk_backing = SlabBacking::THP;
+                } else if (util::strieq_l("hugetlb", StringRef{optarg})) {
+                    config.chunk_backing = SlabBacking::HUGETLB;
+                } else {
+                    std::cerr << "--hugepages: unknown mode " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 45:
+                // --pre-encode-headers
+                config.pre_encode_headers = true;
+                break;
+            case 46:
+                // --ping-interval
+                config.ping_interval = util::parse_duration_with_unit(optarg);
+                if (!std::isfinite(config.ping_interval)) {
+                    std::cerr << "--ping-interval: value error " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 47:
+                // --window-auto-tune
+                config.window_auto_tune = true;
+                break;
+            case 48:
+                // --connections-per-client
+                config.connections_per_client = strtoul(optarg, nullptr, 10);
+                if (config.connections_per_client == 0) {
+                    std::cerr << "--connections-per-client: must be positive"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 49:
+                // --h1-fast-parse
+                config.h1_fast_parse = true;
+                break;
+            case 50:
+                // --bolt-version
+                config.bolt_version = strtol(optarg, nullptr, 10);
+                if (config.bolt_version != 1 && config.bolt_version != 2) {
+                    std::cerr << "--bolt-version: must be 1 or 2" << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 51:
+                // --bolt-crc
+                config.bolt_crc = true;
+                break;
+            case 52:
+                // --sofarpc-spec
+                sofarpc_spec_file = optarg;
+                break;
+            case 53:
+                // --sofarpc-args
+                sofarpc_args = optarg;
+                break;
+            case 54:
+                // --mix
+                config.mix.clear();
+                for (auto &w : util::split_str(StringRef{optarg}, ',')) {
+                    auto n = util::parse_uint(w);
+                    if (n < 0 || n > 1000) {
+                        std::cerr << "--mix: weight must be in [0, 1000]: "
+                                  << w << std::endl;
+                        exit(EXIT_FAILURE);
+                    }
+                    config.mix.push_back(n);
+                }
+                break;
+            case 55:
+                // --subst-keys
+                subst_keys_file = optarg;
+                break;
+            case 56:
+                // --oneway
+                config.oneway = true;
+                break;
+            case 57: {
+                // --stream-messages
+                auto n = util::parse_uint(optarg);
+                if (n < 1 || n > std::numeric_limits<uint32_t>::max()) {
+                    std::cerr << "--stream-messages: must be a positive "
+                                 "integer: "
+                              << optarg << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.stream_messages = n;
+                break;
+            }
+            case 58:
+                // --stream-end-header
+                config.stream_end_header = optarg;
+                if (config.stream_end_header.empty()) {
+                    std::cerr << "--stream-end-header: key must not be empty"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 59:
+                // --aimd
+                config.aimd = true;
+                break;
+            case 60:
+                // --aimd-backoff
+                config.aimd_backoff = strtod(optarg, nullptr);
+                if (!(config.aimd_backoff > 0.) || config.aimd_backoff >= 1.) {
+                    std::cerr << "--aimd-backoff: must be in range (0, 1)"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 61:
+                // --replay
+                replay_file = optarg;
+                break;
+            case 62:
+                // --replay-speed
+                config.replay_speed = strtod(optarg, nullptr);
+                if (!(config.replay_speed > 0.)) {
+                    std::cerr << "--replay-speed: must be positive"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 63:
+                // --agents
+                agents.clear();
+                if (parse_agent_addrs(agents, optarg) != 0) {
+                    std::cerr << "--agents: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 64: {
+                // --agent
+                auto n = util::parse_uint(optarg);
+                if (n < 1 || n > std::numeric_limits<uint16_t>::max()) {
+                    std::cerr << "--agent: bad port: " << optarg << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                agent_port = n;
+                break;
+            }
+            case 65:
+                // --agent-fd
+                agent_fd = util::parse_uint(optarg);
+                if (agent_fd == -1) {
+                    std::cerr << "--agent-fd: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 66:
+                // --start-at
+                start_at = util::parse_uint(optarg);
+                if (start_at == -1) {
+                    std::cerr << "--start-at: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 67:
+                // --request-timeout
+                config.request_timeout = util::parse_duration_with_unit(optarg);
+                if (!std::isfinite(config.request_timeout) ||
+                    config.request_timeout <= 0.) {
+                    std::cerr << "--request-timeout: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 68: {
+                // --churn-requests
+                auto n = util::parse_uint(optarg);
+                if (n <= 0) {
+                    std::cerr << "--churn-requests: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.churn_requests = n;
+                break;
+            }
+            case 69:
+                // --churn-lifetime
+                config.churn_lifetime = util::parse_duration_with_unit(optarg);
+                if (!std::isfinite(config.churn_lifetime) ||
+                    config.churn_lifetime <= 0.) {
+                    std::cerr << "--churn-lifetime: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 70: {
+                // --linger
+                auto n = util::parse_uint(optarg);
+                if (n == -1 || n > std::numeric_limits<int>::max()) {
+                    std::cerr << "--linger: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.linger = n;
+                break;
+            }
+            case 71:
+                // --no-tcp-nodelay
+                config.tcp_nodelay = false;
+                break;
+            case 72:
+                // --warm-up-auto
+                config.warm_up_auto = util::parse_duration_with_unit(optarg);
+                if (!std::isfinite(config.warm_up_auto) ||
+                    config.warm_up_auto <= 0.) {
+                    std::cerr << "--warm-up-auto: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 73: {
+                // --warm-up-window
+                auto n = util::parse_uint(optarg);
+                if (n < 2) {
+                    std::cerr << "--warm-up-window: must be at least 2"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.warm_up_window = n;
+                break;
+            }
+            case 74:
+                // --warm-up-tolerance
+                config.warm_up_tolerance = strtod(optarg, nullptr);
+                if (!(config.warm_up_tolerance > 0.) ||
+                    config.warm_up_tolerance > 100.) {
+                    std::cerr << "--warm-up-tolerance: must be in range "
+                                 "(0, 100]"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 75:
+                // --drain-time
+                config.drain_time = util::parse_duration_with_unit(optarg);
+                if (!std::isfinite(config.drain_time) ||
+                    config.drain_time <= 0.) {
+                    std::cerr << "--drain-time: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 76:
+                // --compare
+                config.compare_file = optarg;
+                break;
+            case 77:
+                // --max-rps-drop
+                config.max_rps_drop = strtod(optarg, nullptr);
+                if (!(config.max_rps_drop >= 0.) ||
+                    config.max_rps_drop > 100.) {
+                    std::cerr << "--max-rps-drop: must be in range [0, 100]"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 78:
+                // --max-latency-rise
+                config.max_latency_rise = strtod(optarg, nullptr);
+                if (!(config.max_latency_rise >= 0.) ||
+                    !std::isfinite(config.max_latency_rise)) {
+                    std::cerr << "--max-latency-rise: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 79: {
+                // --metrics-port
+                auto n = util::parse_uint(optarg);
+                if (n < 1 || n > std::numeric_limits<uint16_t>::max()) {
+                    std::cerr << "--metrics-port: bad port: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.metrics_port = n;
+                break;
+            }
+            case 80: {
+                // --statsd
+                std::vector<AgentAddr> addrs;
+                if (parse_agent_addrs(addrs, optarg) != 0 ||
+                    addrs.size() != 1) {
+                    std::cerr << "--statsd: bad address: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.statsd_host = addrs[0].host;
+                config.statsd_port = addrs[0].port;
+                break;
+            }
+            case 81:
+                // --request-log
+                config.request_log_file = optarg;
+                break;
+            case 82: {
+                // --request-log-sample
+                auto n = util::parse_uint_with_unit(optarg);
+                if (n <= 0) {
+                    std::cerr << "--request-log-sample: value error "
+                              << optarg << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.request_log_sample = n;
+                break;
+            }
+            case 83:
+                // --request-log-failures
+                config.request_log_failures = true;
+                break;
+            case 84:
+                // --request-log-slow
+                config.request_log_slow =
+                    util::parse_duration_with_unit(optarg);
+                if (!std::isfinite(config.request_log_slow) ||
+                    config.request_log_slow <= 0.) {
+                    std::cerr << "--request-log-slow: bad duration: "
+                              << optarg << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 85:
+                // --plugin
+                config.plugin_file = optarg;
+                break;
+            case 86:
+                // --plugin-arg
+                config.plugin_arg = optarg;
+                break;
+            case 87:
+                // --scenario
+                scenario_file = optarg;
+                break;
+            case 88:
+                // --think-time
+                if (parse_think_time(optarg) != 0) {
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 89:
+                // --sweep-clients
+                sweep_clients = optarg;
+                break;
+            case 90:
+                // --sweep-streams
+                sweep_streams = optarg;
+                break;
+            case 91:
+                // --sweep-requests
+                sweep_requests = optarg;
+                break;
+            case 92:
+                // --sweep-step
+                config.sweep_step = util::parse_duration_with_unit(optarg);
+                if (!std::isfinite(config.sweep_step) ||
+                    config.sweep_step <= 0.) {
+                    std::cerr << "--sweep-step: value error " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 93:
+                // --sweep-settle
+                config.sweep_settle = util::parse_duration_with_unit(optarg);
+                if (!std::isfinite(config.sweep_settle) ||
+                    config.sweep_settle < 0.) {
+                    std::cerr << "--sweep-settle: value error " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 94:
+                // --ab
+                config.ab = true;
+                break;
+            case 95:
+                // --response-sizes
+                config.response_sizes = true;
+                break;
+            case 96:
+                // --accept-encoding
+                config.accept_encoding = optarg;
+                if (config.accept_encoding.empty()) {
+                    std::cerr << "--accept-encoding: no coding is given"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 97:
+                // --decode
+                config.decode = true;
+                break;
+            case 98:
+                // --grpc
+                config.grpc = true;
+                break;
+            case 99: {
+                // --reconnect
+                auto n = util::parse_uint(optarg);
+                if (n == -1) {
+                    std::cerr << "--reconnect: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.reconnect_max = n;
+                break;
+            }
+            case 100: {
+                // --reconnect-backoff
+                auto v = util::split_str(StringRef{optarg}, ',');
+                if (v.size() > 2) {
+                    std::cerr << "--reconnect-backoff: must be "
+                                 "<BASE>[,<CAP>]"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.reconnect_base = util::parse_duration_with_unit(v[0]);
+                if (v.size() == 2) {
+                    config.reconnect_cap = util::parse_duration_with_unit(v[1]);
+                }
+                if (!std::isfinite(config.reconnect_base) ||
+                    config.reconnect_base <= 0. ||
+                    !std::isfinite(config.reconnect_cap) ||
+                    config.reconnect_cap < config.reconnect_base) {
+                    std::cerr << "--reconnect-backoff: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            }
+            case 101:
+                // --stop-on
+                if (parse_stop_conditions(config.stop_conditions, optarg) !=
+                    0) {
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 102: {
+                // --stop-window
+                auto n = util::parse_uint(optarg);
+                if (n < 1) {
+                    std::cerr << "--stop-window: must be at least 1"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.stop_window = n;
+                break;
+            }
+            case 103: {
+                // --imbalance
+                auto n = util::parse_uint(optarg);
+                if (n == -1) {
+                    std::cerr << "--imbalance: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.imbalance = n;
+                break;
             }
-            if (*value == 0) {
-                // This could also be a valid case for suppressing a header
-                // similar to curl
-                std::cerr << "-H: invalid header - value missing: " << optarg
-                          << std::endl;
-                exit(EXIT_FAILURE);
+            case 104:
+            case 105: {
+                // --sndbuf, --rcvbuf
+                auto name = flag == 104 ? "--sndbuf" : "--rcvbuf";
+                auto n = util::parse_uint_with_unit(optarg);
+                if (n <= 0 || n > std::numeric_limits<int>::max()) {
+                    std::cerr << name << ": bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                (flag == 104 ? config.sndbuf : config.rcvbuf) = n;
+                break;
             }
-            // Note that there is no processing currently to handle multiple
-            // message-header fields with the same field name
-            config.custom_headers.emplace_back(header, value);
-            util::inp_strlower(config.custom_headers.back().name);
-            break;
-        }
-        case 'e':
-            sofaRpcClassname = optarg;
-            break;
-        case 'a':
-            sofaRpcHeaderArg = optarg;
-            break;
-        case 'o':
-            sofaRpcContent = optarg;
-            break;
-        case 'k':
-            sofaRpcTimeout = strtoul(optarg, nullptr, 10);
-            break;
-        case 'p': {
-            auto proto = StringRef{optarg};
-            if (util::strieq(
-                    StringRef::from_lit(NGHTTP2_CLEARTEXT_PROTO_VERSION_ID),
-                    proto)) {
-                config.no_tls_proto = Config::PROTO_HTTP2;
-            } else if (util::strieq(NGHTTP2_H1_1, proto)) {
-                config.no_tls_proto = Config::PROTO_HTTP1_1;
-            } else if (util::strieq(SOFARPC, proto)) {
-                config.no_tls_proto = Config::PROTO_SOFARPC;
-            } else {
-                std::cerr << "-p: unsupported protocol " << proto << std::endl;
-                exit(EXIT_FAILURE);
+            case 107: {
+                // --ready
+                auto n = util::parse_uint(optarg);
+                if (n < 1 || n > 100) {
+                    std::cerr << "--ready: value error " << optarg
+                              << ": must be a percentage in [1, 100]"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.ready = n;
+                break;
             }
-            break;
-        }
-        case 'r':
-            config.rate = strtoul(optarg, nullptr, 10);
-            if (config.rate == 0) {
-                std::cerr << "-r: the rate at which connections are made "
-                          << "must be positive." << std::endl;
-                exit(EXIT_FAILURE);
+            case 109: {
+                // --hedge
+                if (optarg[0] == 'p') {
+                    auto n = util::parse_uint(optarg + 1);
+                    if (n < 1 || n > 99) {
+                        std::cerr << "--hedge: value error " << optarg
+                                  << ": percentile must be in [1, 99]"
+                                  << std::endl;
+                        exit(EXIT_FAILURE);
+                    }
+                    config.hedge_percentile = n;
+                    break;
+                }
+                config.hedge_delay = util::parse_duration_with_unit(optarg);
+                if (!std::isfinite(config.hedge_delay) ||
+                    config.hedge_delay <= 0.) {
+                    std::cerr << "--hedge: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
             }
-            break;
-        case 'T':
-            config.conn_active_timeout = util::parse_duration_with_unit(optarg);
-            if (!std::isfinite(config.conn_active_timeout)) {
-                std::cerr
-                    << "-T: bad value for the conn_active_timeout wait time: "
-                    << optarg << std::endl;
-                exit(EXIT_FAILURE);
+            case 110:
+                // --hedge-cancel
+                config.hedge_cancel = true;
+                break;
+            case 111: {
+                // --retry
+                auto n = util::parse_uint(optarg);
+                if (n <= 0) {
+                    std::cerr << "--retry: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.retry = n;
+                break;
             }
-            break;
-        case 'N':
-            config.conn_inactivity_timeout =
-                util::parse_duration_with_unit(optarg);
-            if (!std::isfinite(config.conn_inactivity_timeout)) {
-                std::cerr << "-N: bad value for the conn_inactivity_timeout "
-                             "wait time: "
-                          << optarg << std::endl;
-                exit(EXIT_FAILURE);
+            case 112: {
+                // --slow-read
+                auto n = util::parse_uint_with_unit(optarg);
+                if (n <= 0) {
+                    std::cerr << "--slow-read: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.slow_read_rate = n;
+                break;
             }
-            break;
-        case 'D':
-            config.duration = strtoul(optarg, nullptr, 10);
-            if (config.duration == 0) {
-                std::cerr
-                    << "-D: the main duration for timing-based benchmarking "
-                    << "must be positive." << std::endl;
-                exit(EXIT_FAILURE);
+            case 113: {
+                // --slow-read-pause
+                auto v = util::split_str(StringRef{optarg}, ',');
+                if (v.size() != 2) {
+                    std::cerr << "--slow-read-pause: must be <PAUSE>,<PERIOD>"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.slow_read_pause = util::parse_duration_with_unit(v[0]);
+                config.slow_read_period = util::parse_duration_with_unit(v[1]);
+                if (!std::isfinite(config.slow_read_period) ||
+                    !(config.slow_read_pause > 0.) ||
+                    config.slow_read_pause >= config.slow_read_period) {
+                    std::cerr << "--slow-read-pause: bad value: " << optarg
+                              << ": <PAUSE> must be shorter than <PERIOD>"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
             }
-            break;
-        case 'v':
-            config.verbose = true;
-            break;
-        case 'h':
-            print_help(std::cout);
-            exit(EXIT_SUCCESS);
-        case '?':
-            util::show_candidates(argv[optind - 1], long_options);
-            exit(EXIT_FAILURE);
-        case 0:
-            switch (flag) {
-            case 1:
-                // version option
-                print_version(std::cout);
-                exit(EXIT_SUCCESS);
-            case 5:
-                // rate-period
-                config.rate_period = util::parse_duration_with_unit(optarg);
-                if (!std::isfinite(config.rate_period)) {
-                    std::cerr << "--rate-period: value error " << optarg
+            case 114: {
+                // --slow-readers
+                auto n = util::parse_uint(optarg);
+                if (n < 1 || n > 100) {
+                    std::cerr << "--slow-readers: value error " << optarg
+                              << ": must be a percentage in [1, 100]"
                               << std::endl;
                     exit(EXIT_FAILURE);
                 }
+                config.slow_readers = n;
                 break;
-            case 6:
-                // --h1
-                config.npn_list = util::parse_config_str_list(
-                    StringRef::from_lit("http/1.1"));
-                config.no_tls_proto = Config::PROTO_HTTP1_1;
+            }
+            case 115: {
+                // --slow-rcvbuf
+                auto n = util::parse_uint_with_unit(optarg);
+                if (n <= 0 || n > std::numeric_limits<int>::max()) {
+                    std::cerr << "--slow-rcvbuf: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.slow_rcvbuf = n;
                 break;
-            case 7:
-                // --header-table-size
-                if (parse_header_table_size(config.header_table_size,
-                                            "header-table-size", optarg) != 0) {
+            }
+            case 116: {
+                // --clock
+                auto clock = StringRef{optarg};
+                if (util::strieq_l("steady", clock)) {
+                    config.clock_source = ClockSource::STEADY;
+                } else if (util::strieq_l("tsc", clock)) {
+                    config.clock_source = ClockSource::TSC;
+                } else if (util::strieq_l("loop", clock)) {
+                    config.clock_source = ClockSource::LOOP;
+                } else {
+                    std::cerr << "--clock: unknown clock " << clock
+                              << std::endl;
                     exit(EXIT_FAILURE);
                 }
                 break;
-            case 8:
-                // --encoder-header-table-size
-                if (parse_header_table_size(config.encoder_header_table_size,
-                                            "encoder-header-table-size",
-                                            optarg) != 0) {
+            }
+            case 117:
+                // --no-rfc7540-priorities
+                config.no_rfc7540_priorities = true;
+                break;
+            case 118:
+                // --heatmap
+                config.heatmap_file = optarg;
+                break;
+            case 119:
+                // --heatmap-slice
+                config.heatmap_slice = util::parse_duration_with_unit(optarg);
+                if (!std::isfinite(config.heatmap_slice) ||
+                    config.heatmap_slice <= 0.) {
+                    std::cerr << "--heatmap-slice: value error " << optarg
+                              << std::endl;
                     exit(EXIT_FAILURE);
                 }
                 break;
-            case 9:
-                // --warm-up-time
-                config.warm_up_time = util::parse_duration_with_unit(optarg);
-                if (!std::isfinite(config.warm_up_time)) {
-                    std::cerr << "--warm-up-time: value error " << optarg
+            case 120: {
+                // --heatmap-precision
+                auto n = strtoul(optarg, nullptr, 10);
+                if (n < Histogram::MIN_PRECISION ||
+                    n > Histogram::MAX_PRECISION) {
+                    std::cerr << "--heatmap-precision: must be in range ["
+                              << Histogram::MIN_PRECISION << ", "
+                              << Histogram::MAX_PRECISION << "]" << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.heatmap_precision = n;
+                break;
+            }
+            case 121: {
+                // --heatmap-slices
+                auto n = util::parse_uint(optarg);
+                if (n < 2 || n % 2) {
+                    std::cerr << "--heatmap-slices: must be an even number "
+                                 "of at least 2"
                               << std::endl;
                     exit(EXIT_FAILURE);
                 }
+                config.heatmap_slices = n;
                 break;
-            case 11:
-                // --qps
-                config.qps = strtoul(optarg, nullptr, 10);
+            }
+            case 122: {
+                // --shards
+                auto n = util::parse_uint(optarg);
+                if (n < 1) {
+                    std::cerr << "--shards: must be at least 1" << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                nshards = n;
+                break;
+            }
+            case 123:
+                // --agent-token
+                agent_token = optarg;
+                break;
+            case 124:
+                // --agent-bind
+                agent_bind = optarg;
+                break;
+            case 108:
+                // --ready-timeout
+                config.ready_timeout = util::parse_duration_with_unit(optarg);
+                if (!std::isfinite(config.ready_timeout) ||
+                    config.ready_timeout <= 0.) {
+                    std::cerr << "--ready-timeout: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 106:
+                // --tcp-info
+                config.tcp_info_interval =
+                    util::parse_duration_with_unit(optarg);
+                if (!std::isfinite(config.tcp_info_interval) ||
+                    config.tcp_info_interval <= 0.) {
+                    std::cerr << "--tcp-info: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
                 break;
             }
             break;
@@ -1888,59 +12011,388 @@ int main(int argc, char **argv) {
         }
     }
 
-    if (argc == optind) {
-        if (config.ifile.empty()) {
-            std::cerr << "no URI or input file given" << std::endl;
-            exit(EXIT_FAILURE);
-        }
+    if (agent_token.empty()) {
+        if (auto token = getenv("SOFALOAD_AGENT_TOKEN")) {
+            agent_token = token;
+        }
+    }
+
+    if (agent_port) {
+        run_agent(agent_bind, agent_port, agent_token);
+        exit(EXIT_FAILURE);
+    }
+
+    if (argc == optind) {
+        if (config.ifile.empty()) {
+            std::cerr << "no URI or input file given" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (config.nclients == 0) {
+        std::cerr
+            << "-c: the number of clients must be strictly greater than 0."
+            << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.npn_list.empty()) {
+        // gRPC has no HTTP/1.1 to fall back to.
+        config.npn_list = util::parse_config_str_list(
+            config.grpc ? StringRef::from_lit("h2")
+                        : StringRef::from_lit(DEFAULT_NPN_LIST));
+    }
+
+    // serialize the APLN tokens
+    for (auto &proto : config.npn_list) {
+        proto.insert(proto.begin(), static_cast<unsigned char>(proto.size()));
+    }
+
+    std::vector<StringRef> uris;
+    // stdin of -i, which |uris| refer to
+    std::string uri_buf;
+
+    if (config.ifile.empty()) {
+        for (auto i = optind; i < argc; ++i) {
+            uris.emplace_back(argv[i]);
+        }
+    } else if (read_uri_file(uris, uri_buf, config.ifile) != 0) {
+        exit(EXIT_FAILURE);
+    }
+
+    auto reqlines = parse_uris(uris);
+
+    if (reqlines.empty()) {
+        std::cerr << "No URI given" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (!config.qps_profile.empty()) {
+        if (config.is_qps_mode() || config.is_timing_based_mode()) {
+            std::cerr << "--qps-profile: cannot be used with --qps or -D"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        double peak = 0.;
+        for (auto &phase : config.qps_profile) {
+            peak = std::max({peak, phase.start_qps, phase.end_qps});
+            config.duration += phase.duration;
+        }
+        config.qps = std::ceil(peak);
+    }
+
+    if (config.is_slo_search_mode()) {
+        if (config.is_qps_mode() || config.is_timing_based_mode() ||
+            !config.qps_profile.empty()) {
+            std::cerr << "--slo-search: cannot be used with --qps, -D or "
+                         "--qps-profile"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if (config.slo_latency == 0.) {
+            std::cerr << "--slo-search: --slo-latency must be given"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        config.qps = config.slo_max_qps;
+        // The last step ends the measurement by itself.  This is only
+        // a safety net.
+        config.duration = config.slo_step * (config.slo_max_steps + 1);
+    }
+
+    std::vector<size_t> sweep_nclients, sweep_nstreams;
+    auto sweep = !sweep_clients.empty() || !sweep_streams.empty() ||
+                 !sweep_requests.empty();
+    if (sweep) {
+        if (config.is_qps_mode() || config.is_timing_based_mode() ||
+            config.is_rate_mode() || !replay_file.empty() ||
+            !scenario_file.empty() ||
+            config.think_model != ThinkModel::NONE || config.aimd ||
+            config.oneway || config.handshake_bench != HandshakeBench::NONE ||
+            config.connections_per_client > 1 || config.churn_requests ||
+            config.churn_lifetime > 0.) {
+            // Each cell sets how many clients send, and how many
+            // requests each keeps in flight, on connections made once.
+            std::cerr << "--sweep-*: cannot be used with --qps, "
+                         "--qps-profile, --slo-search, -D, -r, --replay, "
+                         "--scenario, --think-time, --aimd, --oneway, "
+                         "--handshake-bench, --connections-per-client, "
+                         "--churn-requests or --churn-lifetime"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if (config.sweep_settle >= config.sweep_step) {
+            std::cerr << "--sweep-settle: must be shorter than --sweep-step"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if ((!sweep_clients.empty() &&
+             parse_sweep_counts(sweep_nclients, sweep_clients,
+                                "sweep-clients", config.nclients) != 0) ||
+            (!sweep_streams.empty() &&
+             parse_sweep_counts(
+                 sweep_nstreams, sweep_streams, "sweep-streams",
+                 static_cast<size_t>(config.max_concurrent_streams)) != 0)) {
+            exit(EXIT_FAILURE);
+        }
+        // The requests are resolved once their names are known.
+        auto ncells =
+            std::max(sweep_nclients.size(), static_cast<size_t>(1)) *
+            std::max(sweep_nstreams.size(), static_cast<size_t>(1)) *
+            (sweep_requests.empty()
+                 ? 1
+                 : util::split_str(StringRef{sweep_requests}, ',').size());
+        config.duration = config.sweep_step * ncells;
+    }
+
+    if (config.warm_up_auto > 0.) {
+        if (!config.qps_profile.empty() || config.is_slo_search_mode() ||
+            !replay_file.empty() || config.warm_up_time > 0.) {
+            std::cerr << "--warm-up-auto: cannot be used with --qps-profile, "
+                         "--slo-search, --replay or --warm-up-time"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if (!config.is_timing_based_mode()) {
+            std::cerr << "--warm-up-auto: -D must be given" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (!config.request_log_file.empty() && config.request_log_sample == 0 &&
+        !config.request_log_failures && config.request_log_slow == 0.) {
+        config.request_log_sample = 1;
+    }
+
+    if (config.drain_time > 0. &&
+        (!config.is_timing_based_mode() || !replay_file.empty())) {
+        // With -n, the requests in flight at the end are waited for
+        // anyway.
+        std::cerr << "--drain-time: needs -D, and cannot be used with "
+                     "--replay"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.is_qps_mode() && config.is_rate_mode()) {
+        std::cerr << "-r, --qps: they are mutually exclusive." << std::endl;
+        exit(EXIT_FAILURE);
     }
 
-    if (config.nclients == 0) {
-        std::cerr
-            << "-c: the number of clients must be strictly greater than 0."
-            << std::endl;
+    if (config.is_qps_mode() &&
+        config.handshake_bench != HandshakeBench::NONE) {
+        std::cerr << "--qps, --handshake-bench: they are mutually exclusive."
+                  << std::endl;
         exit(EXIT_FAILURE);
     }
 
-    if (config.npn_list.empty()) {
-        config.npn_list = util::parse_config_str_list(StringRef::from_lit(DEFAULT_NPN_LIST));
+    if (config.connections_per_client > 1 &&
+        config.handshake_bench != HandshakeBench::NONE) {
+        std::cerr << "--connections-per-client, --handshake-bench: they are "
+                     "mutually exclusive."
+                  << std::endl;
+        exit(EXIT_FAILURE);
     }
 
-    // serialize the APLN tokens
-    for (auto &proto : config.npn_list) {
-        proto.insert(proto.begin(), static_cast<unsigned char>(proto.size()));
+    if (!sofarpc_spec_file.empty() && !sofarpc_args.empty()) {
+        std::cerr << "--sofarpc-spec, --sofarpc-args: they are mutually "
+                     "exclusive.  Use args in the spec file."
+                  << std::endl;
+        exit(EXIT_FAILURE);
     }
 
-    std::vector<std::string> reqlines;
+    if (config.bolt_crc && config.bolt_version != 2) {
+        std::cerr << "--bolt-crc: requires --bolt-version=2" << std::endl;
+        exit(EXIT_FAILURE);
+    }
 
-    if (config.ifile.empty()) {
-        std::vector<std::string> uris;
-        std::copy(&argv[optind], &argv[argc], std::back_inserter(uris));
-        reqlines = parse_uris(std::begin(uris), std::end(uris));
+    if (config.oneway && config.no_tls_proto != Config::PROTO_SOFARPC) {
+        std::cerr << "--oneway: requires -p sofarpc" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.oneway && config.handshake_bench != HandshakeBench::NONE) {
+        std::cerr << "--oneway, --handshake-bench: they are mutually "
+                     "exclusive."
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.grpc && config.no_tls_proto != Config::PROTO_HTTP2) {
+        std::cerr << "--grpc: requires HTTP/2" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.grpc && config.pre_encode_headers) {
+        std::cerr << "--grpc, --pre-encode-headers: they are mutually "
+                     "exclusive."
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.grpc && !sofarpc_spec_file.empty() && !datafile.empty()) {
+        std::cerr << "--grpc: the messages are given in --sofarpc-spec, "
+                     "not in -d"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.count_codings() &&
+        config.no_tls_proto == Config::PROTO_SOFARPC) {
+        std::cerr << "--accept-encoding, --decode: SofaRPC has no content "
+                     "coding"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.is_stream_mode() &&
+        config.no_tls_proto != Config::PROTO_SOFARPC) {
+        std::cerr << "--stream-messages, --stream-end-header: require "
+                     "-p sofarpc"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.oneway && config.is_stream_mode()) {
+        std::cerr << "--oneway: oneway requests get no response stream"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.aimd && (config.oneway || config.handshake_bench !=
+                                             HandshakeBench::NONE)) {
+        std::cerr << "--aimd: needs responses to adapt to, which --oneway "
+                     "and --handshake-bench do not wait for"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.has_calls() &&
+        (config.oneway || !scenario_file.empty() || sweep ||
+         config.is_stream_mode() ||
+         config.handshake_bench != HandshakeBench::NONE ||
+         config.connections_per_client > 1)) {
+        // A call is a single request of a user, which is answered by
+        // one response.
+        std::cerr << "--hedge, --retry: cannot be used with --oneway, "
+                     "--scenario, --sweep-*, --stream-messages, "
+                     "--stream-end-header, --handshake-bench or "
+                     "--connections-per-client"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.hedge_cancel && !config.is_hedging()) {
+        std::cerr << "--hedge-cancel: needs --hedge" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (!config.is_slow_read() &&
+        (config.slow_readers != 10 || config.slow_rcvbuf)) {
+        std::cerr << "--slow-readers, --slow-rcvbuf: need --slow-read or "
+                     "--slow-read-pause"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.heatmap_file.empty()) {
+        if (config.heatmap_slice > 0. || config.heatmap_precision != 3 ||
+            config.heatmap_slices != 3600) {
+            std::cerr << "--heatmap-slice, --heatmap-precision, "
+                         "--heatmap-slices: need --heatmap"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
     } else {
-        std::vector<std::string> uris;
-        if (config.ifile == "-") {
-            uris = read_uri_from_file(std::cin);
-        } else {
-            std::ifstream infile(config.ifile);
-            if (!infile) {
-                std::cerr << "cannot read input file: " << config.ifile
-                          << std::endl;
-                exit(EXIT_FAILURE);
-            }
+        if (config.heatmap_precision > config.latency_precision) {
+            std::cerr << "--heatmap-precision: must not exceed "
+                         "--latency-precision"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        // Each slice is made of whole --timeline intervals.
+        auto n = std::max(
+            1., std::round(config.heatmap_slice / config.timeline_interval));
+        config.heatmap_slice = n * config.timeline_interval;
+    }
 
-            uris = read_uri_from_file(infile);
+    if (config.clock_source == ClockSource::TSC) {
+        if (!tsc_available()) {
+            std::cerr << "--clock=tsc: this CPU has no invariant TSC"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        config.tsc_ns_per_tick = calibrate_tsc(std::chrono::milliseconds(50));
+        if (config.tsc_ns_per_tick <= 0.) {
+            std::cerr << "--clock=tsc: the TSC does not tick" << std::endl;
+            exit(EXIT_FAILURE);
         }
-        reqlines = parse_uris(std::begin(uris), std::end(uris));
     }
 
-    if (reqlines.empty()) {
-        std::cerr << "No URI given" << std::endl;
+    if (config.is_slow_read() && config.io_uring) {
+        // io_uring reads each connection with a multishot recv, which
+        // cannot be held back.
+        std::cerr << "--slow-read, --slow-read-pause: cannot be used with "
+                     "--io-uring"
+                  << std::endl;
         exit(EXIT_FAILURE);
     }
 
-    if (config.is_qps_mode() && config.is_rate_mode()) {
-        std::cerr << "-r, --qps: they are mutually exclusive." << std::endl;
+    if ((config.churn_requests || config.churn_lifetime > 0.) &&
+        (config.oneway || config.handshake_bench != HandshakeBench::NONE)) {
+        std::cerr << "--churn-requests, --churn-lifetime: --oneway sends "
+                     "no requests to count, and --handshake-bench closes "
+                     "connections itself"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (!replay_file.empty() &&
+        (config.is_qps_mode() || !config.mix.empty() || config.oneway ||
+         config.handshake_bench != HandshakeBench::NONE)) {
+        // The capture decides when requests are sent, and which.
+        std::cerr << "--replay: cannot be used with --qps, --qps-profile, "
+                     "--slo-search, --mix, --oneway or --handshake-bench"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (!scenario_file.empty() &&
+        (config.is_qps_mode() || !replay_file.empty() || config.aimd ||
+         config.oneway || config.handshake_bench != HandshakeBench::NONE ||
+         config.connections_per_client > 1 || config.churn_requests ||
+         config.churn_lifetime > 0.)) {
+        // Each step sends its requests at once, and waits for all of
+        // them on the same connection.
+        std::cerr << "--scenario: cannot be used with --qps, --qps-profile, "
+                     "--slo-search, --replay, --aimd, --oneway, "
+                     "--handshake-bench, --connections-per-client, "
+                     "--churn-requests or --churn-lifetime"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.think_model != ThinkModel::NONE &&
+        (config.is_qps_mode() || !replay_file.empty() ||
+         !scenario_file.empty() || config.oneway ||
+         config.handshake_bench != HandshakeBench::NONE ||
+         config.connections_per_client > 1)) {
+        // Users send their next requests when they are done thinking,
+        // on the connection they are on.
+        std::cerr << "--think-time: cannot be used with --qps, "
+                     "--qps-profile, --slo-search, --replay, --scenario, "
+                     "--oneway, --handshake-bench or "
+                     "--connections-per-client"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.oneway && config.connections_per_client > 1) {
+        // The connections of a client share requests by those in
+        // flight, and a oneway request is never in flight.
+        std::cerr << "--oneway, --connections-per-client: they are "
+                     "mutually exclusive."
+                  << std::endl;
         exit(EXIT_FAILURE);
     }
 
@@ -1949,8 +12401,8 @@ int main(int argc, char **argv) {
         exit(EXIT_FAILURE);
     }
 
-    if (config.is_timing_based_mode() && config.is_rate_mode()) {
-        std::cerr << "-r, -D: they are mutually exclusive." << std::endl;
+    if (config.ready && !config.is_timing_based_mode()) {
+        std::cerr << "--ready: needs -D" << std::endl;
         exit(EXIT_FAILURE);
     }
 
@@ -1968,6 +12420,21 @@ int main(int argc, char **argv) {
         exit(EXIT_FAILURE);
     }
 
+    if (config.nthreads_auto) {
+        config.nthreads = std::max(static_cast<size_t>(1),
+                                   available_cpus().size());
+    }
+
+    if (config.cpu_affinity_auto) {
+        config.worker_cpus = spread_cpus();
+    }
+
+    if (config.busy_poll_usec) {
+        check_busy_poll();
+    }
+
+    raise_nofile_limit(config.nclients * config.connections_per_client);
+
     if (config.nthreads == 0) {
         std::cerr
             << "-t: the number of threads must be strictly greater than 0."
@@ -1988,6 +12455,23 @@ int main(int argc, char **argv) {
         exit(EXIT_FAILURE);
     }
 
+    if (config.ab) {
+        auto n = config.endpoints.size();
+        if (n < 2 || config.endpoint_policy != EndpointPolicy::ROUND_ROBIN) {
+            std::cerr << "--ab: needs two or more --endpoints, with "
+                         "--endpoint-policy=rr"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if (config.nclients % (n * config.nthreads)) {
+            // Otherwise a worker would run more clients of one endpoint
+            // than of another.
+            std::cerr << "--ab: -c must be a multiple of " << n
+                      << " endpoints x -t " << config.nthreads << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
     if (config.is_timing_based_mode()) {
         config.nreqs = 0;
     }
@@ -2021,6 +12505,14 @@ int main(int argc, char **argv) {
             exit(EXIT_FAILURE);
         }
         config.data_length = data_stat.st_size;
+
+        if (config.data_length > 0) {
+            auto p = mmap(nullptr, config.data_length, PROT_READ, MAP_SHARED,
+                          config.data_fd, 0);
+            if (p != MAP_FAILED) {
+                config.data_map = static_cast<const uint8_t *>(p);
+            }
+        }
     }
 
     if (config.nreqs == 0 && !config.is_timing_based_mode()) {
@@ -2031,7 +12523,13 @@ int main(int argc, char **argv) {
     }
 
     if (config.is_timing_based_mode()) {
-        if (config.is_qps_mode()) {
+        if (!config.qps_profile.empty()) {
+            double nreqs = 0.;
+            for (auto &phase : config.qps_profile) {
+                nreqs += (phase.start_qps + phase.end_qps) / 2 * phase.duration;
+            }
+            config.nreqs = nreqs;
+        } else if (config.is_qps_mode()) {
             config.nreqs = config.duration * config.qps;
         } else {
             config.nreqs = std::numeric_limits<std::size_t>::max();
@@ -2077,6 +12575,23 @@ int main(int argc, char **argv) {
                                      nullptr);
 #endif // !OPENSSL_NO_NEXTPROTONEG
 
+#ifdef SSL_OP_ENABLE_KTLS
+    if (config.ktls) {
+        // OpenSSL falls back to its own record layer if the kernel
+        // lacks the tls module or the cipher.
+        SSL_CTX_set_options(ssl_ctx, SSL_OP_ENABLE_KTLS);
+    }
+#endif // SSL_OP_ENABLE_KTLS
+
+    if (config.tls_resume) {
+        // Sessions are kept per worker by new_session_cb, so that
+        // workers do not share a lock.
+        SSL_CTX_set_session_cache_mode(ssl_ctx,
+                                       SSL_SESS_CACHE_CLIENT |
+                                           SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(ssl_ctx, new_session_cb);
+    }
+
 #if OPENSSL_VERSION_NUMBER >= 0x10002000L
     std::vector<unsigned char> proto_list;
     for (const auto &proto : config.npn_list) {
@@ -2119,6 +12634,19 @@ int main(int argc, char **argv) {
         }
     }
 
+    if (!config.accept_encoding.empty()) {
+        auto it = std::find_if(std::begin(shared_nva), std::end(shared_nva),
+                               [](const Header &nv) {
+                                   return nv.name == "accept-encoding";
+                               });
+        if (it == std::end(shared_nva)) {
+            shared_nva.emplace_back("accept-encoding", config.accept_encoding);
+        } else {
+            // --accept-encoding wins over -H.
+            (*it).value = config.accept_encoding;
+        }
+    }
+
     std::string content_length_str;
     if (config.data_fd != -1) {
         content_length_str = util::utos(config.data_length);
@@ -2129,40 +12657,84 @@ int main(int argc, char **argv) {
                      [](const Header &nv) { return nv.name == ":method"; });
     assert(method_it != std::end(shared_nva));
 
-    config.h1reqs.reserve(reqlines.size());
-    config.nva.reserve(reqlines.size());
-    config.sofarpcreqs.reserve(reqlines.size());
+    if (!subst_keys_file.empty() &&
+        read_subst_keys(config.subst_keys, subst_keys_file) != 0) {
+        exit(EXIT_FAILURE);
+    }
+    auto keylen = config.subst_keys.empty() ? 0 : config.subst_keys[0].size();
+
+    // The report, the request log, --scenario and --sweep-requests
+    // name the requests by their URIs as given.
+    if (!config.mix.empty() || !config.request_log_file.empty() ||
+        !scenario_file.empty() || !sweep_requests.empty()) {
+        config.mix_names = reqlines;
+    }
+
+    // Requests are only built for the protocols a connection may speak.
+    auto need_h1 = may_speak(Config::PROTO_HTTP1_1);
+    auto need_h2 = may_speak(Config::PROTO_HTTP2);
+
+    if (need_h1) {
+        config.h1reqs.reserve(reqlines.size());
+        config.h1req_slots.reserve(reqlines.size());
+    }
+    if (need_h2) {
+        config.nva.reserve(reqlines.size());
+        config.path_slots.reserve(reqlines.size());
+    }
 
     for (auto &req : reqlines) {
+        if (!need_h1 && !need_h2) {
+            break;
+        }
+
+        // The slots are reserved in |req| itself, which :path refers to.
+        std::vector<SubstSlot> slots;
+        if (parse_subst(req, slots, 0, keylen) != 0) {
+            std::cerr << "bad substitution slot in URI: " << req << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
         // For HTTP/1.1
-        auto h1req = (*method_it).value;
-        h1req += ' ';
-        h1req += req;
-        h1req += " HTTP/1.1\r\n";
-        for (auto &nv : shared_nva) {
-            if (nv.name == ":authority") {
-                h1req += "Host: ";
+        if (need_h1) {
+            auto h1req = (*method_it).value;
+            h1req += ' ';
+            auto h1slots = slots;
+            for (auto &slot : h1slots) {
+                slot.offset += h1req.size();
+            }
+            h1req += req;
+            h1req += " HTTP/1.1\r\n";
+            for (auto &nv : shared_nva) {
+                if (nv.name == ":authority") {
+                    h1req += "Host: ";
+                    h1req += nv.value;
+                    h1req += "\r\n";
+                    continue;
+                }
+                if (nv.name[0] == ':') {
+                    continue;
+                }
+                h1req += nv.name;
+                h1req += ": ";
                 h1req += nv.value;
                 h1req += "\r\n";
-                continue;
             }
-            if (nv.name[0] == ':') {
-                continue;
+
+            if (!content_length_str.empty()) {
+                h1req += "Content-Length: ";
+                h1req += content_length_str;
+                h1req += "\r\n";
             }
-            h1req += nv.name;
-            h1req += ": ";
-            h1req += nv.value;
             h1req += "\r\n";
-        }
 
-        if (!content_length_str.empty()) {
-            h1req += "Content-Length: ";
-            h1req += content_length_str;
-            h1req += "\r\n";
+            config.h1reqs.push_back(std::move(h1req));
+            config.h1req_slots.push_back(std::move(h1slots));
         }
-        h1req += "\r\n";
 
-        config.h1reqs.push_back(std::move(h1req));
+        if (!need_h2) {
+            continue;
+        }
 
         // For nghttp2
         std::vector<nghttp2_nv> nva;
@@ -2175,157 +12747,271 @@ int main(int argc, char **argv) {
             nva.push_back(http2::make_nv(nv.name, nv.value, false));
         }
 
-        if (!content_length_str.empty()) {
-            nva.push_back(http2::make_nv(StringRef::from_lit("content-length"),
-                                         StringRef{content_length_str}));
+        if (!content_length_str.empty()) {
+            nva.push_back(http2::make_nv(StringRef::from_lit("content-length"),
+                                         StringRef{content_length_str}));
+        }
+
+        if (config.pre_encode_headers) {
+            if (!slots.empty()) {
+                std::cerr << "--pre-encode-headers: cannot be used with "
+                             "substitution slots in URIs"
+                          << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            std::vector<uint8_t> hd(
+                nghttp2_hd_deflate_bound(nullptr, nva.data(), nva.size()));
+            auto rv = nghttp2_hd_deflate_static(hd.data(), hd.size(),
+                                                nva.data(), nva.size());
+            if (rv < 0) {
+                std::cerr << "--pre-encode-headers: could not encode "
+                          << req << ": " << nghttp2_strerror(rv)
+                          << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            hd.resize(rv);
+            config.nva_hd.push_back(std::move(hd));
+        }
+
+        config.nva.push_back(std::move(nva));
+        config.path_slots.push_back(std::move(slots));
+    }
+
+    std::vector<SofaRpcSpec> sofarpc_specs;
+    if (!sofarpc_spec_file.empty()) {
+        if (read_sofarpc_spec(sofarpc_specs, sofarpc_spec_file) != 0) {
+            exit(EXIT_FAILURE);
+        }
+    } else {
+        // The built-in request, with what is given in the command line
+        SofaRpcSpec spec;
+        if (!sofaRpcClassname.empty()) {
+            spec.classname = sofaRpcClassname;
+        }
+        if (!sofaRpcHeaderArg.empty()) {
+            spec.headers.clear();
+            for (auto &kv : util::split_str(StringRef{sofaRpcHeaderArg}, ';')) {
+                auto colon = std::find(std::begin(kv), std::end(kv), ':');
+                if (colon == std::end(kv)) {
+                    std::cerr << "--sofaRpcHeader: must be "
+                                 "<key>:<value>[;<key>:<value>...]"
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                spec.headers.emplace_back(
+                    std::string{std::begin(kv), colon},
+                    std::string{colon + 1, std::end(kv)});
+            }
+        }
+        if (!sofaRpcContent.empty()) {
+            spec.content = sofaRpcContent;
+        }
+        if (sofaRpcTimeout) {
+            spec.timeout = sofaRpcTimeout;
+        }
+        if (!sofarpc_args.empty()) {
+            spec.content_args = sofarpc_args;
+        }
+        sofarpc_specs.push_back(std::move(spec));
+    }
+
+    if (may_speak(Config::PROTO_SOFARPC)) {
+        config.sofarpcreqs.reserve(sofarpc_specs.size());
+        for (auto &spec : sofarpc_specs) {
+            config.sofarpcreqs.emplace_back();
+            if (make_sofarpc_request(config.sofarpcreqs.back(), spec,
+                                     config.bolt_version, config.bolt_crc,
+                                     config.oneway, keylen) != 0) {
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    if (config.grpc) {
+        if (sofarpc_spec_file.empty()) {
+            // Each URI names a method, which takes the message in -d.
+            for (auto &req : reqlines) {
+                config.grpcreqs.emplace_back();
+                auto &call = config.grpcreqs.back();
+                call.path = req;
+                call.body = make_grpc_message(config.data_map,
+                                              config.data_map
+                                                  ? config.data_length
+                                                  : 0);
+            }
+        } else {
+            config.grpcreqs.reserve(sofarpc_specs.size());
+            for (auto &spec : sofarpc_specs) {
+                config.grpcreqs.emplace_back();
+                if (make_grpc_request(config.grpcreqs.back(), spec) != 0) {
+                    exit(EXIT_FAILURE);
+                }
+            }
+            config.path_slots.assign(config.grpcreqs.size(), {});
+        }
+
+        config.nva.clear();
+        for (auto &call : config.grpcreqs) {
+            std::vector<nghttp2_nv> nva;
+            // :path comes first, as Http2Session fills its slots there.
+            nva.push_back(http2::make_nv_ls(":path", call.path));
+            for (auto &nv : shared_nva) {
+                if (nv.name == ":method") {
+                    nva.push_back(http2::make_nv_ll(":method", "POST"));
+                    continue;
+                }
+                nva.push_back(http2::make_nv(nv.name, nv.value, false));
+            }
+            nva.push_back(
+                http2::make_nv_ll("content-type", "application/grpc"));
+            nva.push_back(http2::make_nv_ll("te", "trailers"));
+            if (!call.timeout.empty()) {
+                nva.push_back(http2::make_nv_ls("grpc-timeout", call.timeout));
+            }
+            for (auto &kv : call.metadata) {
+                nva.push_back(http2::make_nv(kv.first, kv.second, false));
+            }
+            config.nva.push_back(std::move(nva));
+        }
+    }
+
+    if (!config.plugin_file.empty()) {
+        config.plugin = std::make_unique<Plugin>();
+        if (config.plugin->load(config.plugin_file) != 0) {
+            exit(EXIT_FAILURE);
+        }
+    } else {
+        auto has_plugin_slot = [](const std::vector<SubstSlot> &slots) {
+            return std::any_of(std::begin(slots), std::end(slots),
+                               [](const SubstSlot &slot) {
+                                   return slot.kind == SubstSlot::PLUGIN;
+                               });
+        };
+        auto used = config.no_tls_proto == Config::PROTO_SOFARPC
+                        ? std::any_of(std::begin(config.sofarpcreqs),
+                                      std::end(config.sofarpcreqs),
+                                      [&](const SofaRpcRequest &req) {
+                                          return has_plugin_slot(
+                                                     req.head_slots) ||
+                                                 has_plugin_slot(
+                                                     req.content_slots);
+                                      })
+                        : std::any_of(std::begin(config.path_slots),
+                                      std::end(config.path_slots),
+                                      has_plugin_slot) ||
+                              std::any_of(std::begin(config.h1req_slots),
+                                          std::end(config.h1req_slots),
+                                          has_plugin_slot);
+        if (used) {
+            std::cerr << "plugin substitution slots need --plugin"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (config.no_tls_proto == Config::PROTO_SOFARPC ||
+        (config.grpc && !sofarpc_spec_file.empty())) {
+        auto weighted = std::any_of(
+            std::begin(sofarpc_specs), std::end(sofarpc_specs),
+            [](const SofaRpcSpec &spec) { return spec.weight != 0; });
+        if (weighted) {
+            if (!config.mix.empty()) {
+                std::cerr << "--mix: the weights are also given in "
+                             "--sofarpc-spec"
+                          << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            // A request without weight takes the default of 1.
+            for (auto &spec : sofarpc_specs) {
+                config.mix.push_back(spec.weight ? spec.weight : 1);
+            }
+        }
+        config.mix_names.clear();
+        for (auto &spec : sofarpc_specs) {
+            config.mix_names.push_back(spec.method);
+        }
+    }
+
+    if (!config.mix.empty()) {
+        if (config.mix.size() != config.mix_names.size()) {
+            std::cerr << "--mix: " << config.mix.size()
+                      << " weights are given for "
+                      << config.mix_names.size() << " requests" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if (std::all_of(std::begin(config.mix), std::end(config.mix),
+                        [](uint32_t w) { return w == 0; })) {
+            std::cerr << "--mix: at least one weight must be positive"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        config.mix_table = AliasTable(config.mix);
+    }
+
+    if (!scenario_file.empty()) {
+        if (!config.mix.empty()) {
+            std::cerr << "--scenario: the steps decide the requests, which "
+                         "cannot also have weights"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if (read_scenario(config.scenario, scenario_file, config.mix_names) !=
+            0) {
+            exit(EXIT_FAILURE);
+        }
+        for (auto &step : config.scenario) {
+            if (static_cast<ssize_t>(step.count) >
+                config.max_concurrent_streams) {
+                std::cerr << "--scenario: a step of " << step.count
+                          << " requests needs -m " << step.count
+                          << " or more" << std::endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+        size_t nthink = 0;
+        for (auto &step : config.scenario) {
+            if (step.think > 0.) {
+                config.think_time += step.think;
+                ++nthink;
+            }
+        }
+        if (nthink) {
+            config.think_time /= nthink;
+        }
+    }
+
+    if (sweep) {
+        std::vector<size_t> tmpls;
+        if (!sweep_requests.empty()) {
+            if (!config.mix.empty()) {
+                std::cerr << "--sweep-requests: the cells decide the "
+                             "requests, which cannot also have weights"
+                          << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            if (parse_sweep_requests(tmpls, sweep_requests,
+                                     config.mix_names) != 0) {
+                exit(EXIT_FAILURE);
+            }
+        }
+        config.sweep = make_sweep_cells(
+            sweep_nclients, sweep_nstreams, tmpls, config.nclients,
+            static_cast<size_t>(config.max_concurrent_streams));
+    }
+
+    if (!replay_file.empty()) {
+        auto ntemplates = reqlines.size();
+        if (config.no_tls_proto == Config::PROTO_SOFARPC) {
+            ntemplates = config.sofarpcreqs.size();
+        } else if (config.grpc) {
+            ntemplates = config.grpcreqs.size();
+        }
+        if (config.replay.open(replay_file, ntemplates) != 0) {
+            exit(EXIT_FAILURE);
+        }
+        if (!config.is_timing_based_mode()) {
+            config.nreqs = config.replay.size();
         }
-
-        config.nva.push_back(std::move(nva));
-
-        // For sofarpc   hardcode :)
-
-        sofaRpcClassname = "com.alipay.sofa.rpc.core.request.SofaRequest";
-        sofaRpcHeaderArg = "service:com.alipay.test.TestService:1.0";
-        sofaRpcTimeout = 5000;
-
-        std::string sofaRpcHeader = util::convertMap(sofaRpcHeaderArg);
-        char bytes[22];
-        bytes[0] = PROTOCOL_CODE_V1;                                // proto
-        bytes[1] = REQUEST;                                         // type
-        util::putBigEndianI16(&bytes[2], RPC_REQUEST);              // cmdcode
-        bytes[4] = 1;                                               // version
-        bytes[9] = 1;                                               // codec
-        util::putBigEndianI32(&bytes[10], sofaRpcTimeout);          // timeout
-        util::putBigEndianI16(&bytes[14], sofaRpcClassname.size()); // classLen
-        util::putBigEndianI16(&bytes[16], sofaRpcHeader.size());    // headerLen
-        util::putBigEndianI32(&bytes[18], 1314); // contentLen
-        std::string sofaReq(22, 0);
-        std::memcpy(&sofaReq[0], bytes, 22);
-        unsigned char contentbytes[] = {
-            0x4f, 0xbc, 0x63, 0x6f, 0x6d, 0x2e, 0x61, 0x6c, 0x69, 0x70, 0x61,
-            0x79, 0x2e, 0x73, 0x6f, 0x66, 0x61, 0x2e, 0x72, 0x70, 0x63, 0x2e,
-            0x63, 0x6f, 0x72, 0x65, 0x2e, 0x72, 0x65, 0x71, 0x75, 0x65, 0x73,
-            0x74, 0x2e, 0x53, 0x6f, 0x66, 0x61, 0x52, 0x65, 0x71, 0x75, 0x65,
-            0x73, 0x74, 0x95, 0x0d, 0x74, 0x61, 0x72, 0x67, 0x65, 0x74, 0x41,
-            0x70, 0x70, 0x4e, 0x61, 0x6d, 0x65, 0x0a, 0x6d, 0x65, 0x74, 0x68,
-            0x6f, 0x64, 0x4e, 0x61, 0x6d, 0x65, 0x17, 0x74, 0x61, 0x72, 0x67,
-            0x65, 0x74, 0x53, 0x65, 0x72, 0x76, 0x69, 0x63, 0x65, 0x55, 0x6e,
-            0x69, 0x71, 0x75, 0x65, 0x4e, 0x61, 0x6d, 0x65, 0x0c, 0x72, 0x65,
-            0x71, 0x75, 0x65, 0x73, 0x74, 0x50, 0x72, 0x6f, 0x70, 0x73, 0x0d,
-            0x6d, 0x65, 0x74, 0x68, 0x6f, 0x64, 0x41, 0x72, 0x67, 0x53, 0x69,
-            0x67, 0x73, 0x6f, 0x90, 0x4e, 0x07, 0x65, 0x63, 0x68, 0x6f, 0x53,
-            0x74, 0x72, 0x1f, 0x63, 0x6f, 0x6d, 0x2e, 0x61, 0x6c, 0x69, 0x70,
-            0x61, 0x79, 0x2e, 0x74, 0x65, 0x73, 0x74, 0x2e, 0x54, 0x65, 0x73,
-            0x74, 0x53, 0x65, 0x72, 0x76, 0x69, 0x63, 0x65, 0x3a, 0x31, 0x2e,
-            0x30, 0x4d, 0x08, 0x70, 0x72, 0x6f, 0x74, 0x6f, 0x63, 0x6f, 0x6c,
-            0x04, 0x62, 0x6f, 0x6c, 0x74, 0x7a, 0x56, 0x74, 0x00, 0x07, 0x5b,
-            0x73, 0x74, 0x72, 0x69, 0x6e, 0x67, 0x6e, 0x01, 0x10, 0x6a, 0x61,
-            0x76, 0x61, 0x2e, 0x6c, 0x61, 0x6e, 0x67, 0x2e, 0x53, 0x74, 0x72,
-            0x69, 0x6e, 0x67, 0x7a, 0x53, 0x04, 0x4a, 0x31, 0x32, 0x33, 0x34,
-            0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
-            0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
-            0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
-            0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
-            0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
-            0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
-            0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
-            0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
-            0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
-            0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
-            0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
-            0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
-            0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
-            0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
-            0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
-            0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
-            0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
-            0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
-            0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
-            0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
-            0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
-            0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
-            0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
-            0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
-            0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
-            0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
-            0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
-            0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
-            0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
-            0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
-            0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
-            0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
-            0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
-            0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
-            0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
-            0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
-            0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
-            0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
-            0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
-            0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
-            0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
-            0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
-            0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
-            0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
-            0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
-            0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
-            0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
-            0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
-            0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
-            0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
-            0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
-            0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
-            0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
-            0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
-            0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
-            0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
-            0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
-            0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
-            0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
-            0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
-            0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
-            0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
-            0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
-            0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
-            0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
-            0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
-            0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
-            0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
-            0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
-            0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
-            0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
-            0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
-            0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
-            0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
-            0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
-            0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
-            0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
-            0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
-            0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
-            0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
-            0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
-            0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
-            0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
-            0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
-            0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
-            0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
-            0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
-            0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
-            0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
-            0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
-            0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
-            0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
-            0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x31, 0x32, 0x33,
-            0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
-            0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
-            0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
-            0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
-            0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
-            0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
-            0x30, 0x31, 0x32, 0x33, 0x34};
-        std::string contentStr(1314, 0);
-        std::memcpy(&contentStr[0], contentbytes, 1314);
-        sofaReq += sofaRpcClassname + sofaRpcHeader + contentStr;
-        config.sofarpcreqs.push_back(sofaReq);
     }
 
     // Don't DOS our server!
@@ -2335,6 +13021,75 @@ int main(int argc, char **argv) {
         exit(EXIT_FAILURE);
     }
 
+    if (!agents.empty()) {
+        auto n = agents.size();
+        if (!config.qps_profile.empty() || config.is_slo_search_mode() ||
+            config.is_replay_mode() || config.is_sweep_mode()) {
+            std::cerr << "--agents: cannot be used with --qps-profile, "
+                         "--slo-search, --replay or --sweep-*"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if (config.ifile == "-") {
+            std::cerr << "--agents: cannot read URIs from stdin" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if (config.nclients < n ||
+            (!config.is_timing_based_mode() && config.nreqs < n) ||
+            (config.is_qps_mode() && config.qps < n) ||
+            (config.is_rate_mode() && config.rate < n)) {
+            std::cerr << "--agents: -c, -n, --qps and -r must be greater than "
+                         "or equal to the number of agents."
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if (!config.nthreads_auto && !config.is_qps_mode() &&
+            config.nclients / n < config.nthreads) {
+            std::cerr << "--agents, -c, -t: each agent must have at least as "
+                         "many clients as threads."
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if (agent_token.empty()) {
+            std::cerr << "--agents: needs --agent-token" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        return run_coordinator(agents, agent_token, argc, argv);
+    }
+
+    if (nshards > 1) {
+        if (!config.qps_profile.empty() || config.is_slo_search_mode() ||
+            config.is_replay_mode() || config.is_sweep_mode()) {
+            std::cerr << "--shards: cannot be used with --qps-profile, "
+                         "--slo-search, --replay or --sweep-*"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if (config.ifile == "-") {
+            std::cerr << "--shards: cannot read URIs from stdin" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        // Each shard would write or listen on the same ones.
+        if (!config.timeline_file.empty() || !config.heatmap_file.empty() ||
+            !config.trace_file.empty() || !config.request_log_file.empty() ||
+            config.metrics_port) {
+            std::cerr << "--shards: cannot be used with --timeline, "
+                         "--heatmap, --trace, --request-log or --metrics-port"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if (config.nclients < nshards || config.nthreads < nshards ||
+            (!config.is_timing_based_mode() && config.nreqs < nshards) ||
+            (config.is_qps_mode() && config.qps < nshards) ||
+            (config.is_rate_mode() && config.rate < nshards)) {
+            std::cerr << "--shards: -c, -t, -n, --qps and -r must be greater "
+                         "than or equal to the number of shards."
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        return run_shards(nshards, argc, argv, agent_fd, start_at);
+    }
+
     resolve_host();
 
     std::cout << "starting benchmark..." << std::endl;
@@ -2342,12 +13097,25 @@ int main(int argc, char **argv) {
     std::vector<Worker *> workers;
     workers.reserve(config.nthreads);
 
+    if (config.is_qps_mode()) {
+        qps_pool.init(config.nthreads);
+    }
+
     size_t nclients_per_thread = config.nclients / config.nthreads;
     ssize_t nclients_rem = config.nclients % config.nthreads;
 
     size_t rate_per_thread = config.rate / config.nthreads;
     ssize_t rate_per_thread_rem = config.rate % config.nthreads;
 
+    std::unique_ptr<RequestLogWriter> reqlog;
+    if (!config.request_log_file.empty()) {
+        reqlog = std::make_unique<RequestLogWriter>(
+            config.mix_names, config.no_tls_proto == Config::PROTO_SOFARPC);
+        if (reqlog->open(config.request_log_file) != 0) {
+            exit(EXIT_FAILURE);
+        }
+    }
+
     std::mutex mu;
     std::condition_variable cv;
     auto ready = false;
@@ -2367,6 +13135,30 @@ int main(int argc, char **argv) {
 
         workers.push_back(create_worker(i, ssl_ctx, nclients, rate));
         auto &worker = workers.back();
+        if (!config.worker_cpus.empty()) {
+            worker->cpu = config.worker_cpus[i % config.worker_cpus.size()];
+        }
+        if (!config.trace_file.empty()) {
+            worker->trace = std::make_unique<TraceWriter>();
+            if (worker->trace->open(config.trace_file + "." + util::utos(i),
+                                    i, config.trace_records) != 0) {
+                exit(EXIT_FAILURE);
+            }
+        }
+        if (reqlog) {
+            worker->reqlog_queue = std::make_unique<SpscQueue<ReqLogRecord>>(
+                REQLOG_QUEUE_SIZE);
+            reqlog->add_queue(worker->reqlog_queue.get());
+        }
+        if (config.plugin) {
+            worker->plugin_ctx =
+                config.plugin->init(i, config.nthreads, config.plugin_arg);
+            if (worker->plugin_ctx == nullptr) {
+                exit(EXIT_FAILURE);
+            }
+            worker->subst.set_plugin(config.plugin->fill(),
+                                     worker->plugin_ctx);
+        }
         if (config.is_qps_mode()) {
             size_t nqps = config.qps / config.nthreads;
             if (i < config.qps % config.nthreads)
@@ -2376,6 +13168,15 @@ int main(int argc, char **argv) {
                 qps_counts[std::rand() % qps_update_per_second]++;
             }
             worker->set_qps_counts(qps_counts);
+            worker->set_qps_rate(nqps);
+            if (config.is_dynamic_qps()) {
+                worker->qps_share = 1. / config.nthreads;
+            }
+            if (!config.qps_profile.empty()) {
+                worker->phase_stats.assign(
+                    config.qps_profile.size(),
+                    PhaseStat(config.latency_precision));
+            }
         }
         futures.push_back(
             std::async(std::launch::async, [&worker, &mu, &cv, &ready]() {
@@ -2387,6 +13188,63 @@ int main(int argc, char **argv) {
             }));
     }
 
+    std::unique_ptr<TimelineReporter> timeline;
+    std::thread timeline_thread;
+    std::ofstream timeline_out;
+    std::unique_ptr<MetricsExporter> metrics;
+    if (config.metrics_port || config.statsd_port) {
+        metrics = std::make_unique<MetricsExporter>();
+        if ((config.metrics_port && metrics->listen(config.metrics_port) != 0) ||
+            (config.statsd_port &&
+             metrics->connect_statsd(config.statsd_host, config.statsd_port) !=
+                 0)) {
+            exit(EXIT_FAILURE);
+        }
+    }
+    std::ofstream heatmap_out;
+    std::unique_ptr<Heatmap> heatmap;
+    if (!config.heatmap_file.empty()) {
+        heatmap_out.open(config.heatmap_file);
+        if (!heatmap_out) {
+            std::cerr << "--heatmap: cannot open " << config.heatmap_file
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        heatmap = std::make_unique<Heatmap>(config.heatmap_slice,
+                                            config.heatmap_precision,
+                                            config.heatmap_slices);
+    }
+    if (config.is_timeline_enabled()) {
+        std::ostream *out = nullptr;
+        if (config.timeline_file == "-") {
+            out = &std::cout;
+        } else if (!config.timeline_file.empty()) {
+            timeline_out.open(config.timeline_file);
+            if (!timeline_out) {
+                std::cerr << "--timeline: cannot open " << config.timeline_file
+                          << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            out = &timeline_out;
+        }
+        timeline =
+            std::make_unique<TimelineReporter>(workers, out, metrics.get(),
+                                               heatmap.get());
+        timeline_thread = std::thread([&timeline] { timeline->run(); });
+    }
+
+    if (reqlog) {
+        reqlog->start();
+    }
+
+    rss_start = get_rss(false);
+
+    if (start_at) {
+        // Start together with the other agents of the coordinator.
+        std::this_thread::sleep_until(std::chrono::system_clock::time_point(
+            std::chrono::milliseconds(start_at)));
+    }
+
     {
         std::lock_guard<std::mutex> lg(mu);
         ready = true;
@@ -2395,187 +13253,322 @@ int main(int argc, char **argv) {
 
     auto start = std::chrono::steady_clock::now();
 
+    std::vector<WarmUpSample> warm_up;
+    if (config.warm_up_auto > 0.) {
+        warm_up = run_auto_warm_up(workers);
+    }
+
+    std::vector<SloStep> slo_steps;
+    if (config.is_slo_search_mode()) {
+        slo_steps = run_slo_search(workers);
+    }
+
     for (auto &fut : futures) {
         fut.get();
     }
 
     auto end = std::chrono::steady_clock::now();
-    auto duration =
-        std::chrono::duration_cast<std::chrono::microseconds>(end - start);
 
-    Stats stats;
-    for (const auto &w : workers) {
-        const auto &s = w->stats;
+    rss_peak = get_rss(true);
+
+    if (config.plugin) {
+        for (auto worker : workers) {
+            config.plugin->free(worker->plugin_ctx);
+        }
+    }
+
+    if (reqlog) {
+        reqlog->stop();
+
+        size_t dropped = 0;
+        for (auto worker : workers) {
+            dropped += worker->reqlog_dropped;
+        }
+        if (dropped) {
+            std::cerr << "--request-log: " << dropped
+                      << " records were lost because the writer fell behind"
+                      << std::endl;
+        }
+    }
+
+    std::string stop_reason;
+    if (timeline) {
+        timeline->stop();
+        timeline_thread.join();
+
+        if (heatmap) {
+            heatmap->write_json(heatmap_out);
+            heatmap_out.close();
+            if (!heatmap_out) {
+                std::cerr << "--heatmap: cannot write " << config.heatmap_file
+                          << std::endl;
+            }
+        }
 
-        stats.req_started += s.req_started;
-        stats.req_done += s.req_done;
-        stats.req_timedout += s.req_timedout;
-        stats.req_success += s.req_success;
-        stats.req_status_success += s.req_status_success;
-        stats.req_failed += s.req_failed;
-        stats.req_error += s.req_error;
-        stats.bytes_total += s.bytes_total;
-        stats.bytes_head += s.bytes_head;
-        stats.bytes_head_decomp += s.bytes_head_decomp;
-        stats.bytes_body += s.bytes_body;
+        stop_reason = timeline->stop_reason();
+        if (!stop_reason.empty() && config.is_timing_based_mode()) {
+            // The rates are per second of the measurement which ran.
+            double d = 0.;
+            for (auto worker : workers) {
+                d = std::max(d, worker->main_duration);
+            }
+            if (d > 0.) {
+                config.duration = d;
+            }
+        }
 
-        for (size_t i = 0; i < stats.status.size(); ++i) {
-            stats.status[i] += s.status[i];
+        size_t dropped = 0;
+        for (auto worker : workers) {
+            dropped += worker->timeline_dropped;
         }
-        for (size_t i = 0; i < stats.sofarpcStatus.size(); ++i) {
-            stats.sofarpcStatus[i] += s.sofarpcStatus[i];
+        if (dropped) {
+            std::cerr << "--timeline: " << dropped
+                      << " samples were lost because the reporter fell behind"
+                      << std::endl;
         }
     }
+    auto duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    Stats stats(config.latency_precision);
+    for (const auto &w : workers) {
+        merge_stats(stats, w->stats);
+    }
 
-    auto ts = process_time_stats(workers);
+    auto ts = process_time_stats(stats);
 
     // Requests which have not been issued due to connection errors, are
-    // counted towards req_failed and req_error.
-    auto req_not_issued = (config.nreqs - stats.req_status_success - stats.req_failed);
+    // counted towards req_failed and req_error.  With --hedge or
+    // --retry, -n is the number of calls, rather than of attempts.
+    auto req_not_issued =
+        config.has_calls()
+            ? config.nreqs - stats.calls_done
+            : (config.nreqs - stats.req_status_success - stats.req_failed);
     if (config.is_timing_based_mode() || config.is_qps_mode()) {
         req_not_issued = 0;
     }
     stats.req_failed += req_not_issued;
     stats.req_error += req_not_issued;
 
-    // UI is heavily inspired by weighttp[1] and wrk[2]
-    //
-    // [1] https://github.com/lighttpd/weighttp
-    // [2] https://github.com/wg/wrk
-    double rps = 0;
-    int64_t bps = 0;
-    if (duration.count() > 0) {
-        if (config.is_timing_based_mode()) {
-            // we only want to consider the main duration if warm-up is given
-            rps = stats.req_success / config.duration;
-            bps = stats.bytes_total / config.duration;
-        } else {
-            auto secd = std::chrono::duration_cast<
-                std::chrono::duration<double, std::chrono::seconds::period>>(
-                duration);
-            rps = stats.req_success / secd.count();
-            bps = stats.bytes_total / secd.count();
-        }
-    }
-
-    double header_space_savings = 0.;
-    if (stats.bytes_head_decomp > 0) {
-        header_space_savings = 1. - static_cast<double>(stats.bytes_head) /
-                                        stats.bytes_head_decomp;
-    }
+    auto rates = compute_rates(stats, duration);
+    auto rps = rates.rps;
+    auto bps = rates.bps;
 
     auto totalReq = config.nreqs;
     if (config.is_timing_based_mode() && !config.is_qps_mode()) {
-        totalReq = total_req_send.load();
+        totalReq = 0;
+        for (auto worker : workers) {
+            totalReq += worker->req_sent;
+        }
     }
 
-    std::cout << std::fixed << std::setprecision(2) << R"(
-finished in )" << util::format_duration(duration)
-              << ", " << rps << " req/s, " << util::utos_funit(bps) << R"(B/s
-requests: )" << totalReq
-              << " total, " << stats.req_started << " started, "
-              << stats.req_done << " done, " << stats.req_status_success
-              << " succeeded, " << stats.req_failed << " failed, "
-              << stats.req_error << " errored, " << stats.req_timedout
-              << " timeout";
+    print_summary(stats, ts, duration, totalReq, rates);
 
-    if (config.no_tls_proto == Config::PROTO_SOFARPC) {
-        std::cout
-            << std::fixed << std::setprecision(2) << R"(
-sofaRPC status codes: )"
-            << "\n\t" << stats.sofarpcStatus[RESPONSE_STATUS_SUCCESS]
-            << " success, " << stats.sofarpcStatus[RESPONSE_STATUS_ERROR]
-            << " error, "
-            << stats.sofarpcStatus[RESPONSE_STATUS_SERVER_EXCEPTION]
-            << " server exception, "
-            << stats.sofarpcStatus[RESPONSE_STATUS_UNKNOWN] << " unknown\n\t"
-            << stats.sofarpcStatus[RESPONSE_STATUS_SERVER_THREADPOOL_BUSY]
-            << " server threadpool busy, "
-            << stats.sofarpcStatus[RESPONSE_STATUS_ERROR_COMM]
-            << " error comm, "
-            << stats.sofarpcStatus[RESPONSE_STATUS_NO_PROCESSOR]
-            << " no processor, " << stats.sofarpcStatus[RESPONSE_STATUS_TIMEOUT]
-            << " timeout\n\t"
-            << stats.sofarpcStatus[RESPONSE_STATUS_CLIENT_SEND_ERROR]
-            << " client send error, "
-            << stats.sofarpcStatus[RESPONSE_STATUS_CODEC_EXCEPTION]
-            << " codec exception, "
-            << stats.sofarpcStatus[RESPONSE_STATUS_CONNECTION_CLOSED]
-            << " connection closed, "
-            << stats.sofarpcStatus[RESPONSE_STATUS_SERVER_SERIAL_EXCEPTION]
-            << " server serial exception\n\t"
-            << stats.sofarpcStatus[RESPONSE_STATUS_SERVER_DESERIAL_EXCEPTION]
-            << " server deserial exception";
-    } else {
-        std::cout << std::fixed << std::setprecision(2) << R"(
-status codes: )" << stats.status[2]
-                  << " 2xx, " << stats.status[3] << " 3xx, " << stats.status[4]
-                  << " 4xx, " << stats.status[5] << " 5xx";
+    if (!stop_reason.empty()) {
+        std::cout << "stopped early: " << stop_reason << std::endl;
     }
-    std::cout << std::fixed << std::setprecision(2) << R"(
-traffic: )" << util::utos_funit(stats.bytes_total)
-              << "B (" << stats.bytes_total << ") total, "
-              << util::utos_funit(stats.bytes_head) << "B (" << stats.bytes_head
-              << ") headers (space savings " << header_space_savings * 100
-              << "%), " << util::utos_funit(stats.bytes_body) << "B ("
-              << stats.bytes_body << R"() data
-                     min         max         mean         sd        +/- sd
-time for request: )"
-              << std::setw(10) << util::format_duration(ts.request.min) << "  "
-              << std::setw(10) << util::format_duration(ts.request.max) << "  "
-              << std::setw(10) << util::format_duration(ts.request.mean) << "  "
-              << std::setw(10) << util::format_duration(ts.request.sd)
-              << std::setw(9) << util::dtos(ts.request.within_sd) << "%"
-              << "\ntime for connect: " << std::setw(10)
-              << util::format_duration(ts.connect.min) << "  " << std::setw(10)
-              << util::format_duration(ts.connect.max) << "  " << std::setw(10)
-              << util::format_duration(ts.connect.mean) << "  " << std::setw(10)
-              << util::format_duration(ts.connect.sd) << std::setw(9)
-              << util::dtos(ts.connect.within_sd) << "%"
-              << "\nreq/s           : " << std::setw(10) << ts.rps.min << "  "
-              << std::setw(10) << ts.rps.max << "  " << std::setw(10)
-              << ts.rps.mean << "  " << std::setw(10) << ts.rps.sd
-              << std::setw(9) << util::dtos(ts.rps.within_sd) << "%"
-              << std::endl;
 
     SSL_CTX_free(ssl_ctx);
 
-    uint64_t rtt_min = std::numeric_limits<uint64_t>::max();
-    uint64_t rtt_max = std::numeric_limits<uint64_t>::min();
+    Histogram rtt_hist(config.latency_precision);
+    Histogram corrected_rtt_hist(config.latency_precision);
+    ConnectionStat conn_stat(config.latency_precision);
     for (const auto &worker : workers) {
-        rtt_min = std::min(rtt_min, worker->rtt_min);
-        rtt_max = std::max(rtt_max, worker->rtt_max);
+        rtt_hist.merge(worker->rtt_hist);
+        corrected_rtt_hist.merge(worker->corrected_rtt_hist);
+        conn_stat.merge(worker->conn_stat);
+    }
+
+    if (agent_fd != -1) {
+        AgentResult res(config.latency_precision);
+        res.total_req = totalReq;
+        res.duration = std::chrono::duration<double>(duration).count();
+        res.rtt_hist.merge(rtt_hist);
+        res.corrected_rtt_hist.merge(corrected_rtt_hist);
+        WireWriter w;
+        encode_agent_result(w, res, stats);
+        if (write_message(agent_fd, w.buf()) != 0) {
+            std::cerr << "--agent-fd: cannot send the result" << std::endl;
+        }
+        close(agent_fd);
     }
-    bool invalid = false;
-    if (rtt_min > rtt_max) {
-        rtt_min = rtt_max = 0;
-        invalid = true;
+
+    print_latency_distribution("Latency  Distribution", rtt_hist);
+
+    if (config.is_stream_mode()) {
+        print_stream_latency(stats, workers);
     }
-    std::vector<uint64_t> rtts(rtt_max - rtt_min + 1, 0);
-    uint64_t rtt_counts = 0;
-    for (const auto &worker : workers) {
-        rtt_counts += worker->rtts.size();
-        for (auto i : worker->rtts)
-            ++rtts[i - rtt_min];
+
+    if (config.timestamping) {
+        print_wire_latency(workers);
     }
-    std::vector<double> percentiles{50.0, 75.0, 90.0, 95.0, 99.0};
-    std::cout << "\n  Latency  Distribution" << std::endl;
-    for (int i = 0; i < percentiles.size(); i++) {
-        double percentile = percentiles[i];
-        uint64_t rank = std::round((percentile / 100.0) * rtt_counts + 0.5);
-        uint64_t total = 0;
-        uint64_t rtt = 0;
-        for (rtt = rtt_min; rtt <= rtt_max; ++rtt) {
-            total += rtts[rtt - rtt_min];
-            if (total >= rank) {
-                break;
+
+    if (config.tcp_info_interval > 0.) {
+        print_tcp_info(workers);
+    }
+
+    if (config.ping_interval > 0.) {
+        print_ping_latency(workers);
+    }
+
+    if (config.request_timeout > 0.) {
+        print_request_timeouts(stats, workers);
+    }
+
+    if (config.has_calls()) {
+        print_calls(stats, workers);
+    }
+
+    if (config.window_auto_tune || stats.stream_stalls || stats.conn_stalls) {
+        print_flow_control(stats);
+    }
+
+    if (config.oneway) {
+        print_oneway(stats, rps, rates.sent_bps);
+    }
+
+    if (config.aimd) {
+        print_aimd(workers, rates.goodput);
+    }
+
+    if (config.is_replay_mode()) {
+        print_replay(workers);
+    }
+
+    if (config.is_qps_mode() || config.is_replay_mode()) {
+        print_latency_distribution(
+            "Corrected Latency  Distribution (from intended start)",
+            corrected_rtt_hist);
+        if (config.qps_burst) {
+            uint64_t dropped = 0;
+            for (const auto &w : workers) {
+                dropped += w->qps_dropped;
             }
+            std::cout << "qps quota dropped by --qps-burst: " << dropped
+                      << std::endl;
         }
-        std::cout << std::setw(5) << std::setprecision(0) << percentile << "%"
-                  << std::setw(13)
-                  << (invalid ? "0us"
-                              : util::format_duration(double(rtt) / 1000000.0))
-                  << std::endl;
+    }
+
+    if (config.is_qps_mode() && config.nthreads > 1 &&
+        !config.is_slo_search_mode()) {
+        print_worker_qps(workers);
+    }
+
+    if (config.endpoints.size() > 1) {
+        print_endpoint_stat(workers, config.is_timing_based_mode()
+                                         ? config.duration
+                                         : std::chrono::duration<double>(
+                                               duration)
+                                               .count());
+    }
+
+    if (config.is_slow_read()) {
+        print_reader_stat(workers, config.is_timing_based_mode()
+                                       ? config.duration
+                                       : std::chrono::duration<double>(
+                                             duration)
+                                             .count());
+    }
+
+    if (config.response_sizes) {
+        print_response_size_stat(workers, stats,
+                                 config.is_timing_based_mode()
+                                     ? config.duration
+                                     : std::chrono::duration<double>(duration)
+                                           .count());
+    }
+
+    if (config.count_codings()) {
+        print_decode_stat(workers, config.is_timing_based_mode()
+                                       ? config.duration
+                                       : std::chrono::duration<double>(
+                                             duration)
+                                             .count());
+    }
+
+    auto ab_regression =
+        config.ab && print_ab(workers, config.is_timing_based_mode()
+                                           ? config.duration
+                                           : std::chrono::duration<double>(
+                                                 duration)
+                                                 .count()) != 0;
+
+    if (!config.mix.empty()) {
+        print_template_stat(workers, config.is_timing_based_mode()
+                                         ? config.duration
+                                         : std::chrono::duration<double>(
+                                               duration)
+                                               .count());
+    }
+
+    if (!config.scenario.empty()) {
+        print_scenario_stat(workers, config.is_timing_based_mode()
+                                         ? config.duration
+                                         : std::chrono::duration<double>(
+                                               duration)
+                                               .count());
+    }
+
+    if (has_side_phases()) {
+        print_phases(stats, rtt_hist, workers);
+    }
+
+    print_connection_stat(conn_stat);
+
+    if (config.churn_requests || config.churn_lifetime > 0.) {
+        print_churn(stats, conn_stat,
+                    config.is_timing_based_mode()
+                        ? config.duration
+                        : std::chrono::duration<double>(duration).count());
+    }
+
+    if (config.handshake_bench != HandshakeBench::NONE) {
+        print_handshake_rate(conn_stat, rps);
+    }
+
+    print_loop_stat(workers, ts.request.mean);
+
+    print_memory_stat(workers);
+
+    if (config.perf_counters) {
+        print_perf_counters(workers);
+    }
+
+    if (config.slowest) {
+        print_slowest(workers);
+    }
+
+    if (config.imbalance) {
+        print_imbalance(get_conn_summaries(workers));
+    }
+
+    if (!config.qps_profile.empty()) {
+        print_phase_stats(workers);
+    }
+
+    if (config.is_sweep_mode()) {
+        print_sweep_stat(workers);
+    }
+
+    if (config.warm_up_auto > 0.) {
+        print_warm_up(warm_up);
+    }
+
+    if (config.is_slo_search_mode()) {
+        print_slo_search(slo_steps);
+    }
+
+    if ((!config.output_file.empty() || !config.compare_file.empty()) &&
+        write_output(stats, ts, std::chrono::duration<double>(duration).count(),
+                     rps, bps, totalReq, rtt_hist, corrected_rtt_hist,
+                     conn_stat, workers, warm_up,
+                     timeline ? timeline->intervals() : IntervalStats(),
+                     stop_reason) != 0) {
+        return EXIT_FAILURE;
+    }
+
+    if (ab_regression) {
+        return EXIT_FAILURE;
     }
 
     return 0;
@@ -34,8 +34,14 @@
 
 #include <array>
 #include <chrono>
+#include <deque>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <random>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -45,6 +51,28 @@
 
 #include <openssl/ssl.h>
 
+#include "h2load_decode.h"
+#include "h2load_grpc.h"
+#include "h2load_perf.h"
+#include "h2load_plugin.h"
+#include "h2load_reqlog.h"
+#include "h2load_scenario.h"
+#include "h2load_sofarpc_spec.h"
+#include "h2load_stop.h"
+#include "h2load_tcpinfo.h"
+#include "h2load_clock.h"
+#include "h2load_mem.h"
+#include "h2load_sweep.h"
+#include "h2load_trace.h"
+#include "allocator.h"
+#include "aimd_limit.h"
+#include "deadline_wheel.h"
+#include "alias_table.h"
+#include "replay.h"
+#include "subst.h"
+#include "h2load_uring.h"
+#include "histogram.h"
+#include "spsc_queue.h"
 #include "http2.h"
 #include "memchunk.h"
 #include "template.h"
@@ -54,15 +82,159 @@ using namespace nghttp2;
 namespace h2load {
 
 constexpr auto BACKOFF_WRITE_BUFFER_THRES = 16_k;
+// The largest number of chunks a single read fills
+constexpr size_t MAX_READ_CHUNKS = 4;
 
 class Session;
+struct Stream;
 struct Worker;
 
+// Ring is a FIFO queue backed by a power of 2 sized circular buffer,
+// which grows when it is full.
+template <typename T> class Ring {
+  public:
+    Ring() : mask_(0), head_(0), len_(0) {}
+    void push(T v) {
+        if (len_ == buf_.size()) {
+            grow();
+        }
+        buf_[(head_ + len_) & mask_] = std::move(v);
+        ++len_;
+    }
+    T &front() { return buf_[head_]; }
+    void pop() {
+        head_ = (head_ + 1) & mask_;
+        --len_;
+    }
+    bool empty() const { return len_ == 0; }
+    size_t size() const { return len_; }
+
+  private:
+    void grow() {
+        std::vector<T> buf(std::max(buf_.size() * 2, static_cast<size_t>(16)));
+        for (size_t i = 0; i < len_; ++i) {
+            buf[i] = std::move(buf_[(head_ + i) & mask_]);
+        }
+        buf_ = std::move(buf);
+        mask_ = buf_.size() - 1;
+        head_ = 0;
+    }
+
+    std::vector<T> buf_;
+    size_t mask_;
+    size_t head_;
+    size_t len_;
+};
+
+// The way requests are spread over time in --qps mode
+// The format of --output
+enum class OutputFormat {
+    JSON,
+    CSV,
+};
+
+enum class ArrivalProcess {
+    // Each worker's quota is randomly scattered over 5ms periods once,
+    // and the same pattern is repeated every second.
+    PERIODIC,
+    // Exponentially distributed inter-arrival times
+    POISSON,
+    // Inter-arrival times uniformly distributed in [0, 2/qps]
+    UNIFORM,
+    // Fixed inter-arrival time of 1/qps
+    CONSTANT,
+};
+
+// The distribution of --think-time
+enum class ThinkModel {
+    NONE,
+    FIXED,
+    EXPONENTIAL,
+    // Drawn from the samples of a file
+    EMPIRICAL,
+};
+
+// What requests are timed with, by --clock
+enum class ClockSource {
+    // std::chrono::steady_clock, read for each timestamp
+    STEADY,
+    // The invariant TSC, converted with a calibrated rate
+    TSC,
+    // The time the worker's loop woke up, read once per iteration
+    LOOP,
+};
+
+// What a connection does in --handshake-bench
+enum class HandshakeBench {
+    // --handshake-bench is not given
+    NONE,
+    // Connects, handshakes and closes
+    HANDSHAKE,
+    // Connects, handshakes, sends one request and closes after its
+    // response
+    REQUEST,
+};
+
+// How clients are assigned to --endpoints
+enum class EndpointPolicy {
+    // Clients take the endpoints in turn
+    ROUND_ROBIN,
+    // Smooth weighted round robin, so that each endpoint gets the share
+    // of clients its weight tells
+    WEIGHTED,
+    // Clients are hashed onto a ring of the endpoints, so that adding
+    // or removing an endpoint only moves the clients of that endpoint
+    HASH,
+};
+
+// A server the clients are spread over
+struct Endpoint {
+    std::string host;
+    uint16_t port;
+    uint32_t weight;
+    addrinfo *addrs;
+};
+
+// A phase of --qps-profile.  The qps target changes linearly from
+// |start_qps| to |end_qps| over |duration| seconds.
+struct QpsPhase {
+    double start_qps;
+    double end_qps;
+    double duration;
+};
+
 struct Config {
     std::vector<std::vector<nghttp2_nv>> nva;
+    // The header block of each nva which refers only to the static
+    // table, with --pre-encode-headers.  Empty otherwise.
+    std::vector<std::vector<uint8_t>> nva_hd;
     std::vector<std::string> h1reqs;
-    std::vector<std::string> sofarpcreqs;
-    std::vector<ev_tstamp> timings;
+    std::vector<SofaRpcRequest> sofarpcreqs;
+    // The calls of --grpc, which config.nva is made from
+    std::vector<GrpcRequest> grpcreqs;
+    // The substitution slots in the :path of each nva, and in each of
+    // h1reqs
+    std::vector<std::vector<SubstSlot>> path_slots;
+    std::vector<std::vector<SubstSlot>> h1req_slots;
+    // The keys of --subst-keys
+    std::vector<std::string> subst_keys;
+    // The weights of the request templates above with --mix, in their
+    // order, or empty if requests take the templates in turn
+    std::vector<uint32_t> mix;
+    // Draws the template of each request by mix
+    AliasTable mix_table;
+    // The name of each request template in the report with --mix
+    std::vector<std::string> mix_names;
+    // The steps each client runs in turn with --scenario, or empty
+    std::vector<ScenarioStep> scenario;
+    // The time each user waits between a response and its next
+    // request with --think-time, drawn from think_samples with
+    // ThinkModel::EMPIRICAL.  think_time is the mean, which also sets
+    // the tick of Worker::thinks, and that of the think times of
+    // --scenario.
+    ThinkModel think_model;
+    double think_time;
+    std::vector<double> think_samples;
     nghttp2::Headers custom_headers;
     std::string scheme;
     std::string host;
@@ -71,29 +243,139 @@ struct Config {
     // length of upload data
     int64_t data_length;
     addrinfo *addrs;
+    // The servers the clients are spread over.  If --endpoints is not
+    // given, this only has the host of the URI, whose addrs is the
+    // same as the above.
+    std::vector<Endpoint> endpoints;
+    EndpointPolicy endpoint_policy;
+    // true with --ab: each worker takes the endpoints in turn, and the
+    // report compares each of them with the first
+    bool ab;
+    // The order in which clients take endpoints with
+    // EndpointPolicy::WEIGHTED
+    std::vector<uint32_t> endpoint_schedule;
+    // The hash ring of endpoints with EndpointPolicy::HASH, sorted by
+    // the hash
+    std::vector<std::pair<uint64_t, uint32_t>> endpoint_ring;
     size_t nreqs;
     size_t nclients;
     size_t nthreads;
-    // The maximum number of concurrent streams per session.
+    // The maximum number of concurrent streams per session, or per
+    // client with --connections-per-client.
     ssize_t max_concurrent_streams;
+    // The number of connections each client keeps, and spreads its
+    // requests over
+    size_t connections_per_client;
     size_t window_bits;
     size_t connection_window_bits;
     // rate at which connections should be made
     size_t rate;
     ev_tstamp rate_period;
+    // The percentage of the connections of a worker which must be made
+    // before its warm-up starts, or 0 to start it at the first
+    // connection, and how long to wait for them at most
+    size_t ready;
+    ev_tstamp ready_timeout;
     // amount of time for main measurements in timing-based test
     ev_tstamp duration;
     // amount of time to wait before starting measurements in timing-based test
     ev_tstamp warm_up_time;
+    // The time to wait for the responses in flight at the end of -D,
+    // or 0 to drop them
+    ev_tstamp drain_time;
+    // The longest --warm-up-auto may take, or 0 for a fixed warm-up
+    ev_tstamp warm_up_auto;
+    // The number of intervals req/s and latency must be stable for to
+    // end --warm-up-auto, and how much they may vary in percent
+    size_t warm_up_window;
+    double warm_up_tolerance;
     // amount of time to wait for activity on a given connection
     ev_tstamp conn_active_timeout;
     // amount of time to wait after the last request is made on a connection
     ev_tstamp conn_inactivity_timeout;
+    // amount of time to wait for the response to a request, or 0
+    ev_tstamp request_timeout;
+    // The number of requests after which a connection is closed and
+    // made again, or 0
+    size_t churn_requests;
+    // The time after which a connection is closed and made again, even
+    // with requests in flight, or 0
+    ev_tstamp churn_lifetime;
+    // The reconnects a client makes in a row after its connection
+    // fails, before it gives up, or 0 to give up at once
+    size_t reconnect_max;
+    // The backoff before the first reconnect, which doubles with each
+    // one up to |reconnect_cap|, in seconds.  The delay is drawn from
+    // 0 to the backoff.
+    ev_tstamp reconnect_base, reconnect_cap;
+    // SO_LINGER timeout in seconds set on sockets, or -1 to leave it
+    // alone
+    int linger;
+    // SO_SNDBUF and SO_RCVBUF set on sockets in bytes, or 0 to leave
+    // them alone
+    int sndbuf, rcvbuf;
+    // The interval in seconds TCP_INFO of each connection is sampled
+    // at with --tcp-info, or 0
+    double tcp_info_interval;
+    // With --hedge, the delay in seconds after which a request is sent
+    // again on another connection, or 0.  If |hedge_percentile| is not
+    // 0, the delay is that percentile of the latency of successful
+    // attempts so far instead.
+    double hedge_delay;
+    double hedge_percentile;
+    // True to cancel the attempts which lost to the first response
+    // with --hedge-cancel, rather than to ignore them
+    bool hedge_cancel;
+    // The number of times a request the server pushed back on is sent
+    // again on another connection with --retry
+    size_t retry;
+    // The bytes per second a slow reader reads at most with
+    // --slow-read, or 0
+    uint64_t slow_read_rate;
+    // With --slow-read-pause, a slow reader stops reading for the last
+    // |slow_read_pause| seconds of each |slow_read_period|, or 0
+    double slow_read_pause, slow_read_period;
+    // The percentage of the connections which read slowly
+    size_t slow_readers;
+    // SO_RCVBUF set on the sockets of slow readers, or 0 to leave them
+    // as --rcvbuf does
+    int slow_rcvbuf;
+    ClockSource clock_source;
+    // Nanoseconds per TSC tick with --clock=tsc, calibrated at startup
+    double tsc_ns_per_tick;
+    // False to turn Nagle's algorithm on
+    bool tcp_nodelay;
     enum { PROTO_HTTP2, PROTO_HTTP1_1, PROTO_SOFARPC } no_tls_proto;
+    // The Bolt protocol version SofaRPC frames are encoded with, 1 or
+    // 2
+    int bolt_version;
+    // True to append CRC32 to Bolt V2 requests
+    bool bolt_crc;
+    // True to send oneway SofaRPC requests, which get no response
+    bool oneway;
+    // The number of responses which close a SofaRPC server stream, or
+    // 0 if it is not limited
+    uint32_t stream_messages;
+    // The Bolt header map key of the response which closes a SofaRPC
+    // server stream, or empty
+    std::string stream_end_header;
+    // True to adapt the requests in flight of each worker to the
+    // server by AIMD, and the ratio the limit shrinks by when the
+    // server pushes back
+    bool aimd;
+    double aimd_backoff;
+    // The capture of --replay, and how many times as fast as it was
+    // captured it is replayed
+    ReplayFile replay;
+    double replay_speed;
     uint32_t header_table_size;
     uint32_t encoder_header_table_size;
     // file descriptor for upload data
     int data_fd;
+    // upload data mapped read-only, shared by all workers, or nullptr
+    // if the file cannot be mapped, in which case it is read with
+    // pread(2)
+    const uint8_t *data_map;
     uint16_t port;
     uint16_t default_port;
     bool verbose;
@@ -102,7 +384,9 @@ struct Config {
     // not used in usual way.
     bool base_uri_unix;
     // used when UNIX domain socket is used (base_uri_unix is true).
+    // The length of an abstract address covers the name only.
     sockaddr_un unix_addr;
+    socklen_t unix_addrlen;
     // list of supported NPN/ALPN protocol strings in the order of
     // preference.
     std::vector<std::string> npn_list;
@@ -111,27 +395,253 @@ struct Config {
     ~Config();
 
     uint64_t qps;
+    ArrivalProcess qps_arrival;
+    // The largest qps quota a worker can save up while all of its
+    // clients are busy.  0 means no limit.
+    uint64_t qps_burst;
+    // The phases the qps target goes through.  If this is not empty,
+    // qps is the peak of the profile.
+    std::vector<QpsPhase> qps_profile;
+    // --slo-search: the range of qps to search for the highest one
+    // which meets the SLO.  Both are 0 if search is disabled.
+    uint64_t slo_min_qps, slo_max_qps;
+    // The latency bound, in seconds, of slo_percentile of requests
+    // measured from their intended start
+    double slo_latency;
+    double slo_percentile;
+    // The largest percentage of failed requests allowed
+    double slo_error_rate;
+    // The length of a search step in seconds
+    double slo_step;
+    size_t slo_max_steps;
+    // The cells --sweep runs in turn, each for sweep_step seconds, of
+    // which the first sweep_settle seconds are not measured.  Empty
+    // if --sweep-* is not given.
+    std::vector<SweepCell> sweep;
+    double sweep_step;
+    double sweep_settle;
+    // the number of sub-bucket bits of the latency histogram
+    size_t latency_precision;
+    // The percentiles of latency distributions in the report
+    std::vector<double> percentiles;
+    // The number of slowest requests to report
+    size_t slowest;
+    // The number of the most skewed connections to report with
+    // --imbalance, or 0
+    size_t imbalance;
+    // The prefix of --trace files, or empty if tracing is disabled
+    std::string trace_file;
+    // The number of records each --trace file holds
+    uint64_t trace_records;
+    // The file of --request-log, or empty if it is disabled
+    std::string request_log_file;
+    // --request-log logs 1 in request_log_sample requests unless it is
+    // 0, failed requests if request_log_failures is true, and requests
+    // slower than request_log_slow seconds unless it is 0.
+    uint64_t request_log_sample;
+    bool request_log_failures;
+    double request_log_slow;
+    // True to record the sizes of responses with --response-sizes
+    bool response_sizes;
+    // The value of the accept-encoding header sent with
+    // --accept-encoding, or empty
+    std::string accept_encoding;
+    // True to decode gzip and deflate response bodies with --decode
+    bool decode;
+    // True to make gRPC calls over HTTP/2 with --grpc
+    bool grpc;
+    // True to count hardware events of each worker
+    bool perf_counters;
+    // True to do the I/O of cleartext connections with io_uring
+    bool io_uring;
+    // True to write what connections queued once per loop iteration
+    bool batch_writes;
+    // The CPUs workers are pinned to.  Worker i runs on
+    // worker_cpus[i % worker_cpus.size()].  Empty if workers are not
+    // pinned.
+    std::vector<uint32_t> worker_cpus;
+    // True if --cpu-affinity=auto is given
+    bool cpu_affinity_auto;
+    // True if -t auto is given
+    bool nthreads_auto;
+    // True to take kernel timestamps of requests sent and responses
+    // received, and true to ask for hardware timestamps as well
+    bool timestamping, timestamping_hw;
+    // True to grow HTTP/2 windows to the measured bandwidth-delay
+    // product
+    bool window_auto_tune;
+    // True to send SETTINGS_NO_RFC7540_PRIORITIES, and schedule HTTP/2
+    // request bodies round robin instead of by the dependency tree
+    bool no_rfc7540_priorities;
+    // True to count the bodies of HTTP/1.1 responses with
+    // Content-Length without running them through llhttp
+    bool h1_fast_parse;
+    // The interval in seconds between PINGs (Bolt HEARTBEATs for
+    // SofaRPC) sent on each connection to measure the transport round
+    // trip time, or 0 not to send them
+    ev_tstamp ping_interval;
+    // The source addresses which connections are bound to in turn.
+    // If empty, the kernel chooses one.
+    std::vector<Address> local_addrs;
+    // The source port range which connections are bound to.  If
+    // local_port_lo is 0, the kernel chooses one.
+    uint16_t local_port_lo, local_port_hi;
+    // The percentage of TLS connections which try to resume the last
+    // session of their worker, or 0 not to resume sessions
+    uint32_t tls_resume;
+    HandshakeBench handshake_bench;
+    // True to hand the TLS record layer to the kernel after the
+    // handshake
+    bool ktls;
+    // The size of buffers connections read into and write from
+    size_t chunk_size;
+    // The memory the buffers are in
+    SlabBacking chunk_backing;
+    // True to encode the header block of each request once, and send
+    // it as it is on all HTTP/2 connections
+    bool pre_encode_headers;
+    // True to poll the event loop without blocking
+    bool busy_poll;
+    // The value of SO_BUSY_POLL set on sockets in microseconds, or 0 to
+    // leave it alone
+    int busy_poll_usec;
+    // The file to write --timeline to.  "-" means stdout, and empty
+    // disables the timeline.
+    std::string timeline_file;
+    // The length of a --timeline interval in seconds
+    double timeline_interval;
+    // The file to write the --heatmap matrix to, or empty.  A slice
+    // of heatmap_slice seconds, a multiple of timeline_interval, is
+    // divided into the buckets of a histogram of heatmap_precision,
+    // and heatmap_slices slices at most are kept.
+    std::string heatmap_file;
+    double heatmap_slice;
+    size_t heatmap_precision;
+    size_t heatmap_slices;
+    // The file to write the result to in output_format.  "-" means
+    // stdout, and empty disables the output.
+    std::string output_file;
+    OutputFormat output_format;
+    // The result file to compare this run with, or empty
+    std::string compare_file;
+    // The drop of req/s, and the rise of a latency percentile, in
+    // percent, from compare_file which fail the run
+    double max_rps_drop;
+    double max_latency_rise;
+    // The port the metrics are served on to Prometheus, or 0
+    uint16_t metrics_port;
+    // The StatsD server the metrics are pushed to, unless the port is
+    // 0
+    std::string statsd_host;
+    uint16_t statsd_port;
+    // The --stop-on conditions which end the measurement early, and
+    // the number of consecutive intervals each must hold for
+    std::vector<StopCondition> stop_conditions;
+    size_t stop_window;
+    // The --plugin library, or nullptr, and the argument passed to it
+    std::string plugin_file;
+    std::string plugin_arg;
+    std::unique_ptr<Plugin> plugin;
 
     bool is_qps_mode() const;
+    // Returns true if users wait on Worker::thinks, with --think-time
+    // or the think times of --scenario.
+    bool has_think_time() const;
+    bool is_slo_search_mode() const;
+    // Returns true if qps target changes over time, either by
+    // --qps-profile or --slo-search.
+    bool is_dynamic_qps() const;
+    bool is_sweep_mode() const;
+    // Returns true if the content codings of responses are counted,
+    // with --accept-encoding or --decode.
+    bool count_codings() const;
+    // Returns the index of the phase of qps_profile |t| seconds after
+    // the measurement started.  The last phase lasts forever.
+    size_t qps_phase_at(double t) const;
+    // Returns the qps target |t| seconds after the measurement
+    // started.
+    double qps_at(double t) const;
     bool is_rate_mode() const;
     bool is_timing_based_mode() const;
+    // Returns true if a SofaRPC request may get more than one
+    // response.
+    bool is_stream_mode() const;
+    // Returns true if requests replay a capture with --replay.
+    bool is_replay_mode() const;
     bool has_base_uri() const;
+    // Returns true if some connections read slowly, with --slow-read
+    // or --slow-read-pause.
+    bool is_slow_read() const;
+    // Returns true if requests are hedged with --hedge.
+    bool is_hedging() const;
+    // Returns true if requests are tracked as calls, with --hedge or
+    // --retry.
+    bool has_calls() const;
+    // Returns true if workers sample the run every
+    // timeline_interval, for --timeline, for the per-interval rates of
+    // --output and --compare, for the live metrics, for --stop-on, or
+    // for --heatmap.
+    bool is_timeline_enabled() const;
+};
+
+// A timestamp which the kernel or the NIC took for data sent or
+// received, in nanoseconds.  Software timestamps are in
+// CLOCK_REALTIME, and hardware ones are in the clock of the NIC, so
+// only timestamps of the same kind can be compared.
+struct KernelTimestamp {
+    // 0 if there is no timestamp
+    int64_t ns;
+    bool hw;
 };
 
 struct RequestStat {
     // time point when request was sent
     std::chrono::steady_clock::time_point request_time;
+    // time point when request was supposed to be sent according to
+    // the qps schedule or the capture.  This is only recorded in --qps
+    // and --replay mode.
+    std::chrono::steady_clock::time_point intended_time;
     // same, but in wall clock reference frame
     std::chrono::system_clock::time_point request_wall_time;
     // time point when stream was closed
     std::chrono::steady_clock::time_point stream_close_time;
+    // When the last byte of the request was handed to the NIC.  This
+    // is only recorded with --timestamping.
+    KernelTimestamp tx_stamp;
     // upload data length sent so far
     int64_t data_offset;
     // HTTP status code
     int status;
+    // The bytes of the response on the wire, and of its header block
+    // (HTTP) or Bolt header map, Bolt class name, and body or content.
+    // Only counted with --response-sizes.
+    uint64_t resp_bytes;
+    uint64_t resp_header_bytes;
+    uint64_t resp_class_bytes;
+    uint64_t resp_content_bytes;
+    // The index of the request template which was sent
+    uint32_t tmpl;
+    // The sequence number Worker::aimd gave the request
+    uint64_t aimd_seq;
     // true if stream was successfully closed.  This means stream was
     // not reset, but it does not mean HTTP level error (e.g., 404).
     bool completed;
+    // true if the request passed --request-timeout
+    bool timedout;
+};
+
+// The statistics of requests which were due in a phase of
+// --qps-profile
+struct PhaseStat {
+    PhaseStat(size_t precision);
+    // The number of requests finished
+    size_t req_done;
+    // The number of requests marked as success.
+    size_t req_status_success;
+    // round trip times in nanoseconds
+    Histogram rtt_hist;
+    // round trip times in nanoseconds, measured from intended start
+    Histogram corrected_rtt_hist;
 };
 
 struct ClientStat {
@@ -144,15 +654,188 @@ struct ClientStat {
     // means successful HTTP status code.
     size_t req_success;
 
-    // The following 3 numbers are overwritten each time when connection
+    // The following 4 numbers are overwritten each time when connection
     // is made.
 
     // time connect starts
     std::chrono::steady_clock::time_point connect_start_time;
+    // time TCP connection is established
+    std::chrono::steady_clock::time_point tcp_connect_time;
     // time to connect
     std::chrono::steady_clock::time_point connect_time;
     // time to first byte (TTFB)
     std::chrono::steady_clock::time_point ttfb;
+
+    // With --imbalance, the requests done in the main measurement
+    // which failed, the sum of the round trip times of all done in
+    // nanoseconds, and a coarse histogram of them
+    size_t req_failed;
+    uint64_t rtt_sum;
+    std::unique_ptr<Histogram> rtt_sketch;
+    // With --imbalance, the local port of the last connection, or 0,
+    // and the address it was made to
+    uint16_t local_port;
+    const addrinfo *addr;
+};
+
+// A request kept by --slowest
+struct SlowRequest {
+    // round trip time in nanoseconds
+    uint64_t rtt;
+    // The time when the request was sent
+    std::chrono::system_clock::time_point request_wall_time;
+    uint32_t worker_id;
+    uint32_t client_id;
+    int32_t stream_id;
+    // The address the request was sent to
+    const addrinfo *addr;
+    // HTTP status code or SofaRPC response status, or -1 if no
+    // response arrived
+    int status;
+};
+
+// How busy the event loop of a worker was, to tell whether sofaload
+// itself was the bottleneck.
+struct LoopStat {
+    LoopStat(size_t precision);
+    // How late the loop probe timer fired, in nanoseconds
+    Histogram lag;
+    // Nanoseconds spent running callbacks, and in total, since the
+    // loop started
+    uint64_t busy_time, run_time;
+    // The bytes queued on all connections but not written yet, at each
+    // probe.
+    uint64_t unsent_max, unsent_sum;
+    size_t nsamples;
+    // CPU time of the worker thread in seconds, or -1 if unknown
+    double user_time, system_time;
+    // From the kernel receiving data to the worker reading it, in
+    // nanoseconds.  This is the part of the request time spent waking
+    // up the generator.
+    Histogram wakeup;
+    uint64_t wakeup_sum;
+};
+
+// The classes of connection failures
+enum ConnError : uint8_t {
+    CONN_ERROR_NONE,
+    // connect(2) was refused
+    CONN_ERROR_REFUSED,
+    // The connection was reset
+    CONN_ERROR_RESET,
+    // The TLS handshake, or a TLS record, failed
+    CONN_ERROR_TLS,
+    // connect(2) timed out, or the connection was idle for -N
+    CONN_ERROR_TIMEOUT,
+    // The server closed the connection
+    CONN_ERROR_CLOSED,
+    CONN_ERROR_OTHER,
+    CONN_ERROR_MAX,
+};
+
+// The time spent in each phase of setting up connections in
+// nanoseconds.  Unlike ClientStat, every connection attempt counts,
+// including reconnects.
+struct ConnectionStat {
+    ConnectionStat(size_t precision);
+    void merge(const ConnectionStat &other);
+    // The number of connection attempts, and those which were
+    // established
+    size_t attempts, established;
+    // From connect(2) to the socket becoming writable
+    Histogram tcp_connect;
+    // From TCP connection to the end of TLS handshake
+    Histogram tls_handshake;
+    // tls_handshake, split into full and resumed handshakes
+    Histogram tls_full_handshake, tls_resumed_handshake;
+    // From connection established to the first byte of response
+    Histogram first_response;
+    // The connections which failed by ConnError, the reconnects made
+    // after --reconnect backoff, and the clients which gave up
+    std::array<size_t, CONN_ERROR_MAX> failures;
+    size_t reconnects, gave_up;
+    // From a connection failing to the next one of the client being
+    // established after backoff
+    Histogram recovery;
+};
+
+// The requests sent to each of Config::endpoints in the main phase
+struct EndpointStat {
+    EndpointStat(size_t precision);
+    // The number of clients assigned to the endpoint
+    size_t clients;
+    // The number of requests finished, and those succeeded with a
+    // successful status
+    size_t req_done, req_status_success;
+    // round trip times in nanoseconds
+    Histogram rtt_hist;
+};
+
+// The requests of the well-behaved or the slow connections with
+// --slow-read or --slow-read-pause, and the bytes they read, in the
+// main phase
+struct ReaderStat {
+    ReaderStat(size_t precision);
+    size_t clients;
+    size_t req_done, req_status_success;
+    uint64_t bytes;
+    // round trip times in nanoseconds
+    Histogram rtt_hist;
+};
+
+// The requests sent with each request template of --mix in the main
+// phase
+struct TemplateStat {
+    TemplateStat(size_t precision);
+    void merge(const TemplateStat &other);
+    // The number of requests finished, and those succeeded with a
+    // successful status
+    size_t req_done, req_status_success;
+    // The same as Stats::status and Stats::sofarpcStatus
+    std::array<size_t, 6> status;
+    std::array<size_t, 19> sofarpcStatus;
+    // round trip times in nanoseconds
+    Histogram rtt_hist;
+};
+
+// The sizes in bytes of the responses of a status with
+// --response-sizes, in the main phase
+struct ResponseSizeStat {
+    ResponseSizeStat(size_t precision);
+    void merge(const ResponseSizeStat &other);
+    // The whole responses, and their parts as in RequestStat
+    Histogram total, header, classname, content;
+};
+
+// The response bodies of each content coding with --accept-encoding
+// or --decode, in the main phase
+struct DecodeStat {
+    DecodeStat(size_t precision);
+    void merge(const DecodeStat &other);
+    // The number of responses, and the bytes of their bodies as
+    // received, indexed by ContentCoding
+    std::array<uint64_t, CODING_MAX> responses, body_bytes;
+    // The number of bodies decoded, and of those which turned out not
+    // to be valid, with --decode
+    uint64_t decoded, errors;
+    // The bytes the bodies decoded to, and the time taken to decode
+    // them in nanoseconds
+    uint64_t decoded_bytes, decode_time;
+    // The time taken to decode each body in nanoseconds
+    Histogram decode_hist;
+};
+
+// The steps of --scenario, or whole transactions, done in the main
+// phase
+struct ScenarioStat {
+    ScenarioStat(size_t precision);
+    void merge(const ScenarioStat &other);
+    // The number of steps finished, and those which had a failed
+    // request
+    size_t done, failed;
+    // The times from the first request of a successful step to the
+    // last response, in nanoseconds
+    Histogram hist;
 };
 
 struct SDStat {
@@ -174,7 +857,7 @@ struct SDStats {
 };
 
 struct Stats {
-    Stats();
+    Stats(size_t precision);
     // The number of requests issued so far
     size_t req_started;
     // The number of requests finished
@@ -208,10 +891,56 @@ struct Stats {
     std::array<size_t, 6> status;
     // sofarpc response status
     std::array<size_t, 19> sofarpcStatus;
-    // The statistics per request
-    std::vector<RequestStat> req_stats;
-    // THe statistics per client
-    std::vector<ClientStat> client_stats;
+    // grpc-status of --grpc, indexed as parse_grpc_status() returns
+    std::array<size_t, GRPC_STATUS_MAX + 1> grpcStatus;
+    // time for request in seconds, of completed requests
+    RunningStat request_times;
+    // time for connect in seconds
+    RunningStat connect_times;
+    // time to first byte (TTFB) in seconds
+    RunningStat ttfb_times;
+    // request per second for each client
+    RunningStat rps_values;
+    // HTTP/2 only.  The number of times a stream used up the flow
+    // control window granted to the server, and the time in
+    // nanoseconds until its data flowed again.
+    uint64_t stream_stalls, stream_stall_time;
+    // Same as above, but for connection windows
+    uint64_t conn_stalls, conn_stall_time;
+    // The largest stream and connection windows --window-auto-tune
+    // has grown to
+    int32_t max_stream_window, max_conn_window;
+    // The number of responses of SofaRPC server streams
+    uint64_t stream_messages;
+    // The number of bytes written to the sockets
+    int64_t bytes_sent;
+    // The number of times a write found the socket buffer full, and the
+    // time in nanoseconds until it took data again
+    uint64_t write_blocks, write_block_time;
+    // The number of connections closed by --churn-requests or
+    // --churn-lifetime, and the requests in flight which were lost
+    // with them.  The lost requests are also subset of req_error.
+    uint64_t churn_closes, churn_lost;
+    // With --hedge or --retry, the number of calls which ended, and
+    // of those which succeeded.  A call is a request of a user, which
+    // is sent once and again by the hedges and retries.  Each send is
+    // an attempt, which the other request counters count.
+    uint64_t calls_done, calls_success;
+    // The number of hedges sent, of those whose response was the
+    // first one, and of the attempts cancelled after they lost
+    uint64_t hedges_sent, hedges_won, hedges_cancelled;
+    // The number of retries sent
+    uint64_t retries;
+};
+
+// The statistics of the warm-up or the drain, which are kept apart
+// from those of the main measurement.  Only the requests, their
+// status, latency and bytes are counted.
+struct SidePhaseStat {
+    SidePhaseStat(size_t precision);
+    Stats stats;
+    // round trip times in nanoseconds
+    Histogram rtt_hist;
 };
 
 enum ClientState { CLIENT_IDLE, CLIENT_CONNECTED };
@@ -225,34 +954,193 @@ enum class Phase {
     DURATION_OVER  // This phase occurs after the measurements are over
 };
 
+// The statistics of one --timeline interval of a worker
+struct TimelineSample {
+    TimelineSample(size_t precision = Histogram::MIN_PRECISION)
+        : seq(0), start(0.), time(0.), req_done(0), req_status_success(0),
+          req_failed(0), req_error(0), bytes_total(0), bytes_sent(0),
+          sofarpc_status{},
+          req_inflight(0), nconns(0), busy_time(0), busy(0.),
+          rtt_hist(precision), final(false), measured(false) {}
+    // The index of the interval
+    size_t seq;
+    // The start and the end of the interval in seconds since the
+    // worker started.  The start is the end of the previous interval,
+    // rather than seq intervals, because the timer does not fire
+    // exactly on time.
+    double start;
+    double time;
+    uint64_t req_done;
+    uint64_t req_status_success;
+    uint64_t req_failed;
+    uint64_t req_error;
+    // The bytes received and sent in the interval
+    int64_t bytes_total;
+    int64_t bytes_sent;
+    std::array<size_t, 19> sofarpc_status;
+    // The requests in flight, and the connections, at the end of the
+    // interval
+    size_t req_inflight;
+    size_t nconns;
+    // The time the event loop spent busy since the worker started, in
+    // nanoseconds, and the busy fraction of the interval.  Merged
+    // rows take the busiest worker.
+    uint64_t busy_time;
+    double busy;
+    // round trip times in nanoseconds of requests done in the
+    // interval
+    Histogram rtt_hist;
+    // TCP_INFO sampled in the interval with --tcp-info
+    TcpInfoStat tcp_info;
+    // true if this is the last sample of the worker
+    bool final;
+    // true if the worker was in the main measurement for the whole
+    // interval
+    bool measured;
+};
+
 struct Client;
 
+// The connections of a client with --connections-per-client.  Each
+// request goes to the connection with the fewest requests in flight,
+// among those under the limit the server advertised.
+struct ClientPool {
+    // Returns the connection which takes the next request, or nullptr
+    // if none can, or -m requests are in flight already.
+    Client *select() const;
+    // Terminates the connections which have no request in flight.
+    void terminate_idle();
+
+    std::vector<Client *> conns;
+};
+
+// The maximum number of buffers in an io_uring write
+constexpr size_t URING_WR_IOVCNT = 16;
+
+// The io_uring state of a connection.  It outlives the connection
+// until all operations queued for it have completed, so that their
+// completions can be told stale.
+struct UringConn {
+    UringConn(Client *client, int fd);
+    // nullptr once the connection has been closed
+    Client *client;
+    int fd;
+    // The buffers of the write in flight
+    std::array<struct iovec, URING_WR_IOVCNT> iov;
+    // The number of operations in flight
+    size_t nops;
+    // true if a write is in flight
+    bool writing;
+    // true if the write in flight is from Client::wq
+    bool use_wq;
+    // true if this is in Worker::uring_flush
+    bool flush_pending;
+};
+
+// The attempt of a call in flight on |client|'s |stream_id|
+struct CallAttempt {
+    Client *client;
+    int32_t stream_id;
+    // true if this is the hedge of the call
+    bool hedge;
+    // The time the attempt was submitted
+    std::chrono::steady_clock::time_point start;
+};
+
+// A request of a user with --hedge or --retry, which is answered by
+// the first successful response to any of its attempts.  Only the
+// first attempt is sent on the connection of the user; hedges and
+// retries go to other connections.
+struct Call {
+    Call()
+        : tmpl(0), origin(nullptr), nattempts(0), ninflight(0), retries(0),
+          hedged(false), done(false) {}
+    // The time the first attempt was submitted
+    std::chrono::steady_clock::time_point start;
+    size_t tmpl;
+    // The client whose user goes on when the call is done, or nullptr
+    // if its connection went away before that
+    Client *origin;
+    // The entry in Worker::hedges until the hedge is due
+    DeadlineNode hedge;
+    // At most the first attempt or a retry, and a hedge are in flight
+    // at once.
+    std::array<CallAttempt, 2> inflight;
+    size_t nattempts;
+    size_t ninflight;
+    size_t retries;
+    bool hedged;
+    // true once the call has its response, or has failed.  It is
+    // freed when its attempts still in flight are over, too.
+    bool done;
+};
+
 struct Worker {
-    MemchunkPool mcpool;
+    // Chunks of Config::chunk_size for reading and writing
+    SlabPool mcpool;
+    // The buffers connections read into, taken from mcpool in run(),
+    // so that they are local to the CPU the worker runs on.  Sessions
+    // parse them in place, so they are not copied.
+    std::array<SizedMemchunk *, MAX_READ_CHUNKS> read_chunks;
+    // The number of read_chunks a read fills now.  It grows while reads
+    // fill all of them, and shrinks while they return much less, to
+    // follow the size of recent responses.
+    size_t read_nchunks;
+    // Fills |iov| with the buffers the next read fills, and returns
+    // their number.
+    int read_iovec(struct iovec *iov);
+    // Adapts read_nchunks to a read which returned |nread| bytes.
+    void update_read_size(size_t nread);
+    // The CPU this worker is pinned to, or -1
+    int cpu;
+    // Pins the calling thread to cpu, and moves the memory allocated
+    // by the main thread to the NUMA node of cpu.
+    void pin_to_cpu();
     Stats stats;
     struct ev_loop *loop;
     SSL_CTX *ssl_ctx;
+    // The last TLS session a connection of this worker got, which the
+    // next connections resume with --tls-resume
+    SSL_SESSION *tls_session;
+    // Config::tls_resume accumulated over connections, so that exactly
+    // that share of connections resumes
+    uint32_t tls_resume_credit;
     Config *config;
     size_t progress_interval;
     uint32_t id;
     bool tls_info_report_done;
     bool app_info_report_done;
     size_t nconns_made;
+    // The connections made while ready_watcher waits for --ready
+    size_t nconns_ready;
     // number of clients this worker handles
     size_t nclients;
     size_t rate;
+    // Makes the next |rate| connections every Config::rate_period with
+    // -r
     ev_timer timeout_watcher;
     // The next client ID this worker assigns
     uint32_t next_client_id;
     // Keeps track of the current phase (for timing-based experiment) for the
     // worker
     Phase current_phase;
+    // Clients and their stream tables live here as long as the worker,
+    // close to each other, and in memory local to the CPU the worker
+    // is pinned to.
+    BlockAllocator balloc;
+    // What the HTTP/2 sessions of the clients allocate from
+    SizeClassPool h2_mem;
     // We need to keep track of the clients in order to stop them when needed
     std::vector<Client *> clients;
+    // With --connections-per-client, the clients the connections in
+    // clients belong to
+    std::vector<ClientPool> pools;
     // This is only active when there is not a bounded number of requests
     // specified
     ev_timer duration_watcher;
     ev_timer warmup_watcher;
+    // Holds the warm-up until --ready, or --ready-timeout
+    ev_timer ready_watcher;
 
     Worker(uint32_t id, SSL_CTX *ssl_ctx, size_t nclients,
            size_t rate, Config *config);
@@ -266,37 +1154,748 @@ struct Worker {
     // This function frees a client from the list of clients for this Worker.
     void free_client(Client *);
 
-    std::vector<uint64_t> rtts;
-    uint64_t rtt_min;
-    uint64_t rtt_max;
-    void record_rtt(uint64_t rtt_in_us);
+    // round trip times in nanoseconds
+    Histogram rtt_hist;
+    // round trip times in nanoseconds, measured from the time when
+    // request was supposed to be sent in --qps mode.  Unlike rtt_hist,
+    // this includes the time request waited for a client to be free.
+    Histogram corrected_rtt_hist;
+    // round trip times in nanoseconds, from the last byte of request
+    // leaving to the last byte of response arriving, as timestamped by
+    // the kernel.  Only recorded with --timestamping.
+    Histogram wire_rtt_hist;
+    // The sum of wire round trip times, and that of round trip times of
+    // the same requests
+    uint64_t wire_rtt_sum, wire_app_rtt_sum;
+    // Samples TCP_INFO of a slice of the clients on each tick, so that
+    // each of them is sampled once every --tcp-info interval.
+    ev_timer tcp_info_watcher;
+    // The number of ticks in a --tcp-info interval, and the index of
+    // the client the next tick starts with
+    size_t tcp_info_slices;
+    size_t tcp_info_next;
+    // The TCP_INFO samples, and their smoothed round trip times in
+    // nanoseconds
+    TcpInfoStat tcp_info_stat;
+    Histogram tcp_rtt_hist;
+    // Samples TCP_INFO of the connection of |client|.
+    void sample_tcp_info(Client *client);
+    // round trip times of PINGs in nanoseconds.  Only recorded with
+    // --ping-interval.
+    Histogram ping_rtt_hist;
+    // The times in nanoseconds from requests to their first responses,
+    // and between the responses of a stream.  Only recorded with
+    // --stream-messages or --stream-end-header.
+    Histogram first_message_hist;
+    Histogram message_gap_hist;
+    // The deadlines of the requests in flight with --request-timeout,
+    // which deadline_watcher moves along every tick
+    DeadlineWheel deadlines;
+    ev_timer deadline_watcher;
+    std::chrono::steady_clock::time_point deadline_start;
+    // The users thinking before their next request, which
+    // think_watcher moves along every tick
+    DeadlineWheel thinks;
+    ev_timer think_watcher;
+    std::chrono::steady_clock::time_point think_start;
+    std::mt19937_64 think_gen;
+    // The clients waiting for --reconnect backoff, which
+    // reconnect_watcher moves along every tick while any waits
+    DeadlineWheel reconnects;
+    ev_timer reconnect_watcher;
+    std::chrono::steady_clock::time_point reconnect_start;
+    size_t nreconnects;
+    std::mt19937_64 reconnect_gen;
+    // The times in nanoseconds requests were in flight when they
+    // passed --request-timeout
+    Histogram timeout_hist;
+    // The calls of --hedge and --retry.  A deque keeps the nodes in
+    // Worker::hedges where they are.  |free_calls| has the indices of
+    // those not in use.
+    std::deque<Call> calls;
+    std::vector<uint32_t> free_calls;
+    // The hedges due, which hedge_watcher moves along every tick
+    DeadlineWheel hedges;
+    ev_timer hedge_watcher;
+    std::chrono::steady_clock::time_point hedge_start;
+    // The delay of hedges in seconds, or 0 while --hedge=p<N> has too
+    // few samples to tell
+    double hedge_delay;
+    // The latency of successful attempts, which the delay of
+    // --hedge=p<N> is taken from
+    Histogram hedge_hist;
+    // The latency of calls in nanoseconds, from their first attempt to
+    // their first successful response, or to the failure of the last
+    // one
+    Histogram call_hist;
+    ConnectionStat conn_stat;
+    LoopStat loop_stat;
+    // Probes loop lag and unsent bytes periodically.
+    ev_timer loop_probe;
+    // The time loop_probe is due
+    std::chrono::steady_clock::time_point loop_probe_due;
+    // Tell when the loop starts and finishes waiting for events.
+    ev_prepare loop_prepare;
+    ev_check loop_check;
+    std::chrono::steady_clock::time_point loop_start_time, loop_wake_time;
+    // With --clock=tsc, anchored at |loop_wake_time| each iteration
+    TscClock tsc_clock;
+    // What is added to a steady_clock time point to get the wall clock
+    // time, with --clock other than steady
+    std::chrono::system_clock::duration wall_offset;
+    // Returns the time to time requests with, read from --clock.
+    std::chrono::steady_clock::time_point clock_now() const;
+    // Returns the wall clock time at |t| from clock_now().
+    std::chrono::system_clock::time_point
+    wall_time(std::chrono::steady_clock::time_point t) const;
+    // True if the loop was told to stop.  With --busy-poll, ev_run()
+    // returns after each iteration, so ev_break() alone does not stop
+    // it.
+    bool loop_done;
+    // Breaks the loop as ev_break() does.
+    void break_loop(int how);
+    // Returns the receive timestamp which the kernel passed in |msg|,
+    // and records the software one to loop_stat.wakeup.
+    KernelTimestamp record_rx_timestamp(msghdr &msg);
+    // Writes --trace records, or nullptr if tracing is disabled
+    std::unique_ptr<TraceWriter> trace;
+    // The context of the --plugin library for this worker, or nullptr
+    void *plugin_ctx;
+    // The requests --request-log picked, read by the log thread, or
+    // nullptr if it is disabled
+    std::unique_ptr<SpscQueue<ReqLogRecord>> reqlog_queue;
+    // The requests done so far, for Config::request_log_sample
+    uint64_t reqlog_seq;
+    // The number of records lost because the queue was full
+    size_t reqlog_dropped;
+    // Counts hardware events of the worker thread if
+    // Config::perf_counters is true, and the counters are available.
+    std::unique_ptr<PerfCounters> perf;
+    // Does the I/O of cleartext connections if Config::io_uring is
+    // true, and the kernel supports io_uring, or nullptr.
+    std::unique_ptr<IoUring> uring;
+    // The buffers uring reads into, taken from mcpool
+    std::vector<SizedMemchunk *> uring_bufs;
+    // Watches uring for completions while operations are in flight
+    ev_io uring_watcher;
+    // Submits the operations queued in a loop iteration at once
+    ev_prepare uring_prepare;
+    // Keeps the loop from blocking while uring_flush is not empty
+    ev_idle uring_idle;
+    // The connections which want to write, flushed once per loop
+    // iteration
+    std::vector<UringConn *> uring_flush;
+    // The number of operations in flight
+    size_t uring_nops;
+    // The connections which queued something to write in this loop
+    // iteration, if Config::batch_writes is true
+    std::vector<Client *> pending_writes;
+    // Writes pending_writes before the loop waits for events
+    ev_prepare write_flusher;
+    void flush_writes();
+    // Sets up uring.  Returns 0 if it succeeds, or -1.
+    int init_uring();
+    // Starts reading |client| with uring, and does its writes with
+    // uring from now on.
+    void uring_attach(Client *client);
+    // Cancels the operations of |conn|, whose connection is being
+    // closed.
+    void uring_detach(UringConn *conn);
+    // Queues a write of the first |iovcnt| buffers in |conn|->iov.
+    void uring_write(UringConn *conn, int iovcnt);
+    // Makes |conn| write in this loop iteration.
+    void uring_schedule_write(UringConn *conn);
+    void uring_flush_writes();
+    void uring_complete(uint64_t user_data, int32_t res, uint32_t flags);
+    // Updates uring_nops by |delta|, and watches uring only while
+    // operations are in flight, so that it keeps the loop running
+    // exactly as long as the connections do.
+    void uring_add_nops(UringConn *conn, int delta);
+    // The ID given to the next connection
+    uint32_t next_conn_id;
+    // The number of times the connections of this worker bound to
+    // Config::local_addrs or Config::local_port_lo so far
+    size_t next_local;
+    // Binds |fd| of |family| to the next source address and port given
+    // by --local-address and --local-ports.  Returns 0 if it succeeds,
+    // or nothing has to be done.
+    int bind_local(int fd, int family);
+    // The Config::slowest slowest requests, in a min-heap on rtt
+    std::vector<SlowRequest> slowest;
+    // Indexed by the index of Config::endpoints
+    std::vector<EndpointStat> endpoint_stats;
+    // Those of the well-behaved and the slow connections, in this
+    // order, with --slow-read or --slow-read-pause
+    std::vector<ReaderStat> reader_stats;
+    // Indexed by the index of the request template, with --mix
+    std::vector<TemplateStat> template_stats;
+    // Indexed by the SofaRPC response status, or by the class of the
+    // HTTP status code, with --response-sizes
+    std::vector<ResponseSizeStat> response_size_stats;
+    // The round trip times in nanoseconds of the responses in each
+    // class of response_size_class(), with --response-sizes
+    std::vector<Histogram> size_rtt_hists;
+    // All inflaters of --decode, and those not decoding a body at the
+    // moment
+    std::vector<std::unique_ptr<Inflater>> inflaters;
+    std::vector<Inflater *> free_inflaters;
+    // Decoded output is written here and thrown away.
+    std::array<uint8_t, DECODE_BUFFER_SIZE> decode_buf;
+    // Indexed by the index of Config::scenario, and the transactions
+    // of all steps
+    std::vector<ScenarioStat> step_stats;
+    ScenarioStat transaction_stat;
+    // With --accept-encoding or --decode
+    DecodeStat decode_stat;
+    // The state of the generator which draws request templates
+    uint64_t mix_state;
+    // Fills the substitution slots of the requests
+    SubstGen subst;
+    // Returns the index of the request template to send next with
+    // --mix.
+    size_t draw_template() {
+        return config->mix_table.draw(nghttp2::splitmix64(mix_state));
+    }
+    // Keeps the request on |stream_id| of |client|, which got response
+    // |status|, if it is one of the slowest so far.
+    void record_slow_request(uint64_t rtt_in_ns, const Client *client,
+                             int32_t stream_id, const RequestStat &req_stat,
+                             int status);
+    // Records the sizes of the response to |req_stat|, which took
+    // |rtt_in_ns|.
+    void record_response_size(const RequestStat &req_stat,
+                              uint64_t rtt_in_ns);
+    // Records the content coding and decoding of the response on
+    // |stream|.
+    void record_decode(const Stream &stream);
+    // Returns an inflater ready for a new body, or nullptr if zlib
+    // cannot allocate one.
+    Inflater *get_inflater();
+    void put_inflater(Inflater *inflater);
+    void record_rtt(uint64_t rtt_in_ns);
+    void record_corrected_rtt(uint64_t rtt_in_ns);
+    // Records the wire round trip time of a request whose round trip
+    // time is |rtt_in_ns|.
+    void record_wire_rtt(uint64_t wire_rtt_in_ns, uint64_t rtt_in_ns);
+
+    // The number of requests this worker has taken off the global
+    // budget, but not issued yet
+    size_t req_lease;
+    // The number of requests issued by this worker
+    size_t req_sent;
+    // Takes a request off the budget.  It is taken from req_lease, and
+    // req_lease is refilled from the global budget in batches, so that
+    // workers rarely touch the shared counter.  Returns false if no
+    // request is left.
+    bool take_request();
+    // Returns true if no request is left to issue, by this worker or
+    // any other.
+    bool requests_exhausted() const;
 
+    // The qps quota available now.  With --qps-burst, this does not
+    // exceed Config::qps_burst once blocked clients are released.
     uint64_t qpsLeft;
+    // The qps quota discarded because qpsLeft reached --qps-burst
+    uint64_t qps_dropped;
+    // The qps quota this worker gave to QpsPool and nobody took back,
+    // and the quota it took from the other workers
+    uint64_t qps_given, qps_taken;
+    // true if this worker is counted as hungry in QpsPool
+    bool qps_hungry;
+    // Takes at most |n| requests of quota from QpsPool into qpsLeft.
+    // Returns the number of requests taken.
+    uint64_t take_qps_quota(uint64_t n, bool own_only);
+    // Moves all of qpsLeft to QpsPool.
+    void give_qps_quota();
+    void set_qps_hungry(bool hungry);
+    // Adds |n| requests due at |due| to the qps quota.
+    void add_qps_quota(std::chrono::steady_clock::time_point due, uint64_t n);
+    // The time when each batch of the qps quota in qpsLeft became
+    // available, and the number of requests left in the batch.
+    std::deque<std::pair<std::chrono::steady_clock::time_point, uint64_t>>
+        qps_due;
+    // Takes one request off qps_due, and returns the time when it was
+    // due.
+    std::chrono::steady_clock::time_point pop_qps_due();
     ev_periodic qpsUpdater;
-    std::vector<Client *> clientsBlockedDueToQps;
+    // Clients waiting for qps quota, in the order they blocked
+    Ring<Client *> clientsBlockedDueToQps;
+    // The limit of requests in flight with --aimd, and the clients
+    // waiting for it to let them send, in the order they blocked
+    AimdLimit aimd;
+    Ring<Client *> clientsBlockedByLimit;
+    // The sum of the limits when requests were answered in the main
+    // duration, and the number of them
+    double aimd_limit_sum;
+    uint64_t aimd_samples;
 
     size_t qps_count_index_;
     std::vector<size_t> qps_counts_;
     void set_qps_counts(std::vector<size_t> qps_counts);
+
+    // Used instead of qpsUpdater unless ArrivalProcess::PERIODIC is
+    // used.  It fires at the time when next request is due.
+    ev_timer arrival_watcher;
+    // Spins the loop when next request is due sooner than timers can
+    // tell.
+    ev_idle arrival_spinner;
+    // The number of requests per second this worker is responsible
+    // for in --qps mode.
+    double qps_rate;
+    // The share of the qps target of --qps-profile this worker is
+    // responsible for.
+    double qps_share;
+    // The quota of a fraction of a request carried over to the next
+    // period of qpsUpdater with --qps-profile.
+    double qps_credit;
+    // The time when handing out qps quota started
+    std::chrono::steady_clock::time_point qps_start_time;
+    // The statistics per phase of --qps-profile
+    std::vector<PhaseStat> phase_stats;
+    // The statistics of the current step of --slo-search
+    PhaseStat step_stat;
+    // Fires at the end of each step of --slo-search to report
+    // step_stat.
+    ev_timer step_watcher;
+    // Lets other threads end the measurement.
+    ev_async stop_watcher;
+    // The length of the main measurement in seconds, if stop_watcher
+    // ended it before -D was over, or 0
+    double main_duration;
+    // The statistics per cell of --sweep, of the requests sent after
+    // the cell settled
+    std::vector<PhaseStat> sweep_stats;
+    // Moves on to the next cell of --sweep every Config::sweep_step.
+    ev_timer sweep_watcher;
+    std::chrono::steady_clock::time_point sweep_start;
+    // The current cell of --sweep, and the share of its clients this
+    // worker runs.  Clients with id sweep_clients or above stay
+    // connected, but send nothing.
+    size_t sweep_cell;
+    size_t sweep_clients;
+    // The statistics of the current interval of --warm-up-auto, which
+    // warmup_watcher reports every --timeline-interval
+    PhaseStat warmup_stat;
+    // Lets the main thread end --warm-up-auto.
+    ev_async warmup_end_watcher;
+    // Ends the warm-up, and starts the main measurement.
+    void end_warm_up();
+    // Makes |n| more connections, but no more than nclients x
+    // --connections-per-client in all.
+    void make_clients(size_t n);
+    // Starts the warm-up, which is the phase the first connection is
+    // made in, or the one --ready waits for.
+    void start_warm_up();
+    // Counts a connection made while waiting for --ready, and starts
+    // the warm-up once there are enough of them.
+    void on_conn_ready();
+    // The statistics of the warm-up, and of the --drain-time
+    SidePhaseStat warmup_phase, drain_phase;
+    // Returns the statistics of the current phase if it is the warm-up
+    // or the drain, or nullptr
+    SidePhaseStat *side_phase();
+    // Returns the Stats the current phase is counted in, or nullptr
+    // before the warm-up
+    Stats *current_stats();
+    // Fires at the end of --drain-time.
+    ev_timer drain_watcher;
+    // Stops sending requests, and waits for those in flight for
+    // --drain-time.
+    void start_drain();
+    // Ends the drain, and stops the event loop.
+    void stop_drain();
+    // Ends the main measurement, and stops the event loop.
+    void stop_measurement();
+    // Records the result of request with |req_stat| to the phase it
+    // was due in.
+    void process_phase_stat(const RequestStat *req_stat, bool success);
+    // The samples of --timeline, read by the reporter thread
+    std::unique_ptr<SpscQueue<TimelineSample>> timeline_queue;
+    // Fires at the end of each --timeline interval.
+    ev_timer timeline_watcher;
+    std::chrono::steady_clock::time_point timeline_start;
+    // The interval being measured, and its round trip times
+    size_t timeline_seq;
+    Histogram timeline_rtt_hist;
+    // The TCP_INFO samples of the interval
+    TcpInfoStat timeline_tcp_info;
+    // The counters of stats at the start of the interval
+    TimelineSample timeline_base;
+    // The number of samples lost because the queue was full
+    size_t timeline_dropped;
+    // true if the interval being measured started in the main
+    // measurement
+    bool timeline_main;
+    // Sends the statistics of the current interval to the reporter.
+    void push_timeline_sample(bool final);
+    // The time when next request is due
+    std::chrono::steady_clock::time_point next_arrival;
+    std::mt19937_64 arrival_gen;
+    void set_qps_rate(double rate);
+    // Updates qps_rate to the target of --qps-profile at |t|.
+    void update_qps_rate(std::chrono::steady_clock::time_point t);
+    // Returns true if the arrival drawn at |t| should be sent.  This
+    // keeps the arrivals in line with the qps target of --qps-profile
+    // at |t|.
+    bool accept_arrival(std::chrono::steady_clock::time_point t);
+    // Returns the time until the request after next is due.
+    std::chrono::steady_clock::duration next_arrival_interval();
+    // Starts and stops handing out qps quota.
+    void start_qps_pacer();
+    void stop_qps_pacer();
+    // Lets clients waiting for qps quota submit requests as long as
+    // quota lasts.
+    void release_blocked_clients();
+    // Lets clients waiting for --aimd submit requests as long as the
+    // limit allows.
+    void release_limited_clients();
+    // With --replay, the records this worker sends, the time the
+    // replay started, and the records due but not sent yet, in the
+    // order they were due
+    ReplayCursor replay;
+    std::chrono::steady_clock::time_point replay_start;
+    std::deque<std::pair<std::chrono::steady_clock::time_point, ReplayRecord>>
+        replay_due;
+    // Clients waiting for a record to be due, in the order they blocked
+    Ring<Client *> clientsWaitingForReplay;
+    // The template of the record being submitted
+    uint32_t replay_tmpl;
+    // Returns the time when |rec| is due.
+    std::chrono::steady_clock::time_point
+    replay_due_time(const ReplayRecord &rec) const;
+    // Starts handing out the records as they are due.
+    void start_replay();
+    // Lets clients waiting for records submit those due.
+    void release_replay_clients();
+    // Gives up on the requests which passed --request-timeout.
+    void expire_deadlines();
+    // Lets the users whose think time is over go on.
+    void expire_thinks();
+    // Starts a call of |client|'s user with request template |tmpl|,
+    // and returns its index.
+    uint32_t start_call(Client *client, size_t tmpl);
+    // Adds the attempt on |client|'s |stream_id| to call |idx|.
+    void add_attempt(uint32_t idx, Client *client, int32_t stream_id,
+                     bool hedge);
+    // Ends the attempt of call |idx| on |client|'s |stream_id|.  |ok|
+    // is true if it succeeded, and |overload| if the server pushed
+    // back on it.  If |may_retry| is true, a failed attempt may be
+    // retried.  Returns the client whose user goes on, if this ended
+    // the call, or nullptr.
+    Client *end_attempt(uint32_t idx, Client *client, int32_t stream_id,
+                        bool ok, bool overload, bool may_retry);
+    // Sends the hedges due.
+    void expire_hedges();
+    // Sends a hedge of call |idx| if it is still waiting.
+    void send_hedge(uint32_t idx);
+    // Returns the connection another attempt of call |idx| goes to,
+    // or nullptr if there is none.  A connection holding an attempt of
+    // the call is never chosen, and one to another endpoint than
+    // |client| is preferred.  Unless |other| is true, |client| itself
+    // is chosen if no other connection can take the attempt.
+    Client *select_attempt_client(uint32_t idx, Client *client, bool other);
+    // Forgets |client| as the origin of its calls, as its connection
+    // goes away.
+    void orphan_calls(Client *client);
+    // Makes |client| reconnect after |delay| seconds.
+    void schedule_reconnect(Client *client, double delay);
+    // Reconnects the clients whose backoff is over.
+    void expire_reconnects();
+    // Returns the backoff before reconnect |attempt|, counted from 0,
+    // drawn with full jitter.
+    double draw_backoff(uint32_t attempt);
+    // Returns the next think time in seconds with --think-time.  If
+    // |first| is true, it is the time before the first request of a
+    // user, which is spread over the fixed think time, so that users
+    // do not all start at once.
+    double draw_think_time(bool first);
+    // Switches to cell |i| of --sweep, and lets the clients of the
+    // cell fill up to its streams.
+    void set_sweep_cell(size_t i);
+    // Returns true if |client| may send another request in the
+    // current cell of --sweep.
+    bool sweep_allows(const Client &client) const;
+    // Records |req_stat| in the cell of --sweep it was sent in, unless
+    // the cell had not settled yet.
+    void process_sweep_stat(const RequestStat *req_stat, bool success);
+    // Closes the connections waiting for records with no request in
+    // flight, once all records are sent.  |sender| is sending the last
+    // one.
+    void close_replay_clients(const Client *sender);
+};
+
+// The results of a step of --slo-search
+struct SloStep {
+    uint64_t qps;
+    PhaseStat stat;
+    // true if the step met the SLO
+    bool ok;
+};
+
+// The requests done in an interval of --warm-up-auto
+struct WarmUpSample {
+    // The end of the interval in seconds since the warm-up started
+    double time;
+    double rps;
+    // The latency at p99 in nanoseconds
+    uint64_t p99;
+};
+
+// State of --warm-up-auto shared between workers and the main thread.
+// Workers report the statistics of each interval, and the main thread
+// ends the warm-up of all workers at once when they are stable.
+struct AutoWarmUp {
+    AutoWarmUp() : nreported(0) {}
+    std::mutex mu;
+    std::condition_variable cv;
+    // The statistics reported by workers for the current interval,
+    // and the number of workers which reported.  Guarded by mu.
+    std::unique_ptr<PhaseStat> report;
+    size_t nreported;
+};
+
+// State of --slo-search shared between workers and the main thread.
+// Workers report the statistics of each step, and the main thread
+// picks the qps target of the next step from them.
+struct SloSearch {
+    SloSearch() : target_qps(0), done(false), nreported(0) {}
+    std::mutex mu;
+    std::condition_variable cv;
+    // The qps target of the current step, for all workers
+    std::atomic<uint64_t> target_qps;
+    // true if the search is over
+    std::atomic<bool> done;
+    // The statistics reported by workers for the current step, and
+    // the number of workers which reported.  Guarded by mu.
+    std::unique_ptr<PhaseStat> report;
+    size_t nreported;
+};
+
+// QpsPool lets a worker whose clients are all busy hand its qps
+// quota over to workers which have clients waiting for quota, so that
+// one slow worker does not drag the total rate below the target.
+// Each worker owns one slot of the pool, and any worker can take
+// quota from any slot without locking.
+class QpsPool {
+  public:
+    QpsPool() : nslots_(0), nhungry_(0) {}
+    void init(size_t nslots);
+    bool enabled() const { return nslots_ > 1; }
+    // Puts |n| requests, the oldest of which was due at |due|, into
+    // the slot of worker |id|.
+    void give(size_t id, std::chrono::steady_clock::time_point due,
+              uint64_t n);
+    // Takes at most |n| requests from the slot of worker |id| if |own|
+    // is true, or else from the slots of the other workers.  Returns
+    // the number of requests taken, and stores when the oldest of them
+    // was due in |due|.
+    uint64_t take(size_t id, uint64_t n,
+                  std::chrono::steady_clock::time_point &due, bool own);
+    // Drops the quota in the slot of worker |id|.
+    void clear(size_t id);
+    // Tells whether worker |id| has clients waiting for quota.
+    void set_hungry(bool hungry);
+    bool hungry() const;
+
+  private:
+    struct Slot {
+        Slot() : n(0), due(0) {}
+        std::atomic<uint64_t> n;
+        // steady_clock time since epoch in nanoseconds
+        std::atomic<int64_t> due;
+    };
+    std::unique_ptr<Slot[]> slots_;
+    size_t nslots_;
+    // The number of workers which have clients waiting for quota
+    std::atomic<uint32_t> nhungry_;
 };
 
 struct Stream {
     RequestStat req_stat;
+    // HTTP/2 only.  The time the server used up the flow control
+    // window of this stream, or unset if it has not.
+    std::chrono::steady_clock::time_point stall_time;
+    // HTTP/2 only.  The bytes the server may still send on this
+    // stream, as far as the windows sent so far go.
+    int64_t window;
+    // SofaRPC server streams only.  The number of responses received,
+    // and the time the last one completed.
+    uint32_t messages;
+    std::chrono::steady_clock::time_point message_time;
     int status_success;
-    Stream();
+    // The entry in Worker::deadlines with --request-timeout
+    DeadlineNode deadline;
+    // With --accept-encoding or --decode, the content coding of the
+    // response, and the bytes of its body as received
+    ContentCoding coding;
+    uint64_t body_bytes;
+    // With --decode, the inflater decoding the body, the bytes it has
+    // decoded to, and the time taken in nanoseconds.  |decode_error|
+    // is true if the body turned out not to be valid.
+    Inflater *inflater;
+    uint64_t decoded_bytes;
+    uint64_t decode_time;
+    bool decode_error;
+    // With --grpc, the status of the call, as parse_grpc_status()
+    // returns
+    uint8_t grpc_status;
+    // With --hedge or --retry, the index of the call in Worker::calls
+    // this request is an attempt of, plus 1
+    uint32_t call;
+    Stream()
+        : req_stat{}, stall_time{}, window(0), messages(0), message_time{},
+          status_success(-1), coding(CODING_IDENTITY), body_bytes(0),
+          inflater(nullptr), decoded_bytes(0), decode_time(0),
+          decode_error(false), grpc_status(GRPC_STATUS_MAX), call(0) {}
 };
 
+// StreamTable maps stream ID to Stream for the requests in flight on
+// a connection.  Stream IDs are assigned in increasing order, and the
+// number of requests in flight is bounded by the max concurrency, so
+// streams are kept in a power of 2 sized ring indexed by stream ID.
+// A stream whose slot is still taken by an older one goes to a map
+// instead.
+class StreamTable {
+  public:
+    StreamTable() : slots_(nullptr), mask_(0), size_(0) {}
+    // Allocates at least |n| slots from |balloc|, which must outlive
+    // this object.  Both HTTP/1.1 and HTTP/2 use odd stream IDs only,
+    // so |n| should be twice the max concurrency.
+    void init(size_t n, BlockAllocator &balloc) {
+        size_t cap = 1;
+        while (cap < n) {
+            cap <<= 1;
+        }
+        auto slots = static_cast<Slot *>(balloc.alloc(sizeof(Slot) * cap));
+        for (size_t i = 0; i < cap; ++i) {
+            new (&slots[i]) Slot();
+        }
+        slots_ = slots;
+        mask_ = cap - 1;
+        clear();
+    }
+    // Inserts new Stream for |stream_id|, and returns it.
+    Stream *emplace(int32_t stream_id) {
+        auto &slot = slots_[stream_id & mask_];
+        ++size_;
+        if (slot.stream_id == -1 || slot.stream_id == stream_id) {
+            if (slot.stream_id == stream_id) {
+                --size_;
+                slot.stream.deadline.unlink();
+            }
+            slot.stream_id = stream_id;
+            slot.stream = Stream();
+            return &slot.stream;
+        }
+        auto &stream = overflow_[stream_id];
+        stream.deadline.unlink();
+        stream = Stream();
+        return &stream;
+    }
+    // Returns Stream for |stream_id|, or nullptr if there is no such
+    // stream.
+    Stream *find(int32_t stream_id) {
+        auto &slot = slots_[stream_id & mask_];
+        if (slot.stream_id == stream_id) {
+            return &slot.stream;
+        }
+        if (overflow_.empty()) {
+            return nullptr;
+        }
+        auto it = overflow_.find(stream_id);
+        if (it == std::end(overflow_)) {
+            return nullptr;
+        }
+        return &(*it).second;
+    }
+    void erase(int32_t stream_id) {
+        auto &slot = slots_[stream_id & mask_];
+        if (slot.stream_id == stream_id) {
+            slot.stream_id = -1;
+            slot.stream.deadline.unlink();
+            --size_;
+            return;
+        }
+        if (overflow_.empty()) {
+            return;
+        }
+        auto it = overflow_.find(stream_id);
+        if (it != std::end(overflow_)) {
+            (*it).second.deadline.unlink();
+            overflow_.erase(it);
+            --size_;
+        }
+    }
+    // Calls |f| with stream ID and Stream for each stream.
+    template <typename F> void for_each(F f) {
+        if (size_ == 0) {
+            return;
+        }
+        for (size_t i = 0; i <= mask_; ++i) {
+            auto &slot = slots_[i];
+            if (slot.stream_id != -1) {
+                f(slot.stream_id, slot.stream);
+            }
+        }
+        for (auto &p : overflow_) {
+            f(p.first, p.second);
+        }
+    }
+    void clear() {
+        for (size_t i = 0; i <= mask_; ++i) {
+            slots_[i].stream_id = -1;
+            slots_[i].stream.deadline.unlink();
+        }
+        for (auto &p : overflow_) {
+            p.second.deadline.unlink();
+        }
+        overflow_.clear();
+        size_ = 0;
+    }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+  private:
+    struct Slot {
+        Slot() : stream_id(-1) {}
+        // -1 if this slot is not used.
+        int32_t stream_id;
+        Stream stream;
+    };
+    static_assert(std::is_trivially_destructible<Slot>::value,
+                  "Slot is never destroyed");
+    // mask_ + 1 slots in the allocator of the worker
+    Slot *slots_;
+    // Streams which could not get their slot
+    std::unordered_map<int32_t, Stream> overflow_;
+    size_t mask_;
+    size_t size_;
+};
+
+// Per-request slot size of Client::wq.  It must be large enough to
+// hold a SofaRPC request header.
+constexpr size_t WRITE_QUEUE_SLOTLEN = 64;
+
 struct Client {
-    DefaultMemchunks wb;
-    std::unordered_map<int32_t, Stream> streams;
+    SlabMemchunks wb;
+    // Used instead of wb in SofaRPC request template mode.  Each
+    // request is queued as its own header followed by a reference to
+    // the request body shared by all connections.
+    IovecQueue<WRITE_QUEUE_SLOTLEN> wq;
+    StreamTable streams;
     ClientStat cstat;
+    // The last TCP_INFO sample of the connection, if has_tcp_info is
+    // true
+    TcpInfo tcp_info;
     std::unique_ptr<Session> session;
     ev_io wev;
     ev_io rev;
-    std::function<int(Client &)> readfn, writefn;
+    // Plain pointers rather than std::function, which is 4 times as
+    // large
+    int (Client::*readfn)();
+    int (Client::*writefn)();
     Worker *worker;
     SSL *ssl;
-    ev_timer request_timeout_watcher;
     addrinfo *next_addr;
     // Address for the current address.  When try_new_connection() is
     // used and current_addr is not nullptr, it is used instead of
@@ -304,6 +1903,8 @@ struct Client {
     // nullptr to current_addr before calling connect().
     addrinfo *current_addr;
     size_t reqidx;
+    // The index of Config::endpoints this client connects to
+    uint32_t endpoint;
     ClientState state;
     // The number of requests currently have started, but not abandoned
     // or finished.
@@ -312,16 +1913,107 @@ struct Client {
     size_t req_started;
     // The number of requests this client has done so far.
     size_t req_done;
+    // The number of requests submitted on the current connection
+    size_t conn_reqs;
     // The client id per worker
     uint32_t id;
+    // The current connection, unique within the worker
+    uint32_t conn_id;
+    // The io_uring state of the current connection, or nullptr if it
+    // uses libev for I/O
+    UringConn *uring_conn;
+    // The client this connection belongs to with
+    // --connections-per-client, or nullptr
+    ClientPool *pool;
     int fd;
     ev_timer conn_active_watcher;
     ev_timer conn_inactivity_watcher;
+    // Sends a PING every --ping-interval
+    ev_timer ping_watcher;
+    // Closes the connection after --churn-lifetime
+    ev_timer churn_watcher;
+    // The time the unanswered PING was sent, or unset if there is none
+    std::chrono::steady_clock::time_point ping_time;
     std::string selected_proto;
     bool new_connection_requested;
+    bool has_tcp_info;
+    // While a hedge or a retry is submitted, the index of its call in
+    // Worker::calls plus 1, and true if it is a hedge
+    uint32_t attempt_call;
+    bool attempt_hedge;
+    // true if this connection reads slowly with --slow-read or
+    // --slow-read-pause
+    bool slow_reader;
+    // The bytes a slow reader may read with --slow-read, and the time
+    // they were topped up
+    double read_budget;
+    std::chrono::steady_clock::time_point read_refill;
+    // The time the periods of --slow-read-pause count from
+    std::chrono::steady_clock::time_point read_epoch;
+    // Lets a slow reader read again
+    ev_timer read_resume_watcher;
+    // true if this is in Worker::pending_writes
+    bool write_pending;
     // true if the current connection will be closed, and no more new
     // request cannot be processed.
     bool final;
+    // The time when the request being submitted was due in --qps and
+    // --replay mode.
+    std::chrono::steady_clock::time_point intended_time;
+    // With --timestamping, the streams whose request has been
+    // submitted, but not written yet.
+    std::vector<int32_t> tx_unmarked;
+    // With --timestamping, the streams whose request has been written
+    // but whose transmit timestamp has not arrived, with the number of
+    // bytes written on the connection up to the end of the request.
+    // This is ordered by the number of bytes.
+    std::deque<std::pair<uint64_t, int32_t>> tx_marks;
+    // The number of bytes written on the current connection
+    uint64_t tx_bytes;
+    // The time a write found the socket buffer full, or zero if the
+    // socket takes data
+    std::chrono::steady_clock::time_point write_block_time;
+    // The receive timestamp of the last read
+    KernelTimestamp rx_stamp;
+    // True if the current connection takes transmit timestamps
+    bool tx_timestamping;
+    // True if the current connection got a TLS session from the
+    // server
+    bool tls_session_received;
+    // True if the kernel encrypts what the current connection writes
+    // with write_clear()
+    bool ktls_tx;
+    // True if the kernel decrypts what the current connection reads
+    // with read_clear()
+    bool ktls_rx;
+    // The --scenario step the client is in, the number of its
+    // requests not answered yet, and whether one of them failed
+    size_t scenario_step;
+    size_t step_left;
+    bool step_failed;
+    // True while a transaction is running, from its first step until
+    // its last step is answered
+    bool transaction_active;
+    // The time the current step and transaction started
+    std::chrono::steady_clock::time_point step_start;
+    std::chrono::steady_clock::time_point transaction_start;
+    // A node of Worker::thinks for each user of this client, and
+    // those of them not thinking.  With --think-time, each request
+    // the session allows in flight is a user, and with --scenario, the
+    // client is a single user.
+    std::vector<DeadlineNode> think_nodes;
+    std::vector<DeadlineNode *> idle_users;
+    // The class of the error the connection failed with, set where it
+    // is found, or CONN_ERROR_NONE
+    ConnError conn_error;
+    // true once this closes the connection itself
+    bool closing;
+    // The reconnects in a row without a connection established, and
+    // when the connection they replace failed
+    uint32_t reconnect_attempts;
+    std::chrono::steady_clock::time_point outage_start;
+    // The node of this in Worker::reconnects during backoff
+    DeadlineNode reconnect_node;
 
     enum { ERR_CONNECT_FAIL = -100 };
 
@@ -337,9 +2029,37 @@ struct Client {
     // Otherwise, this function returns -1, and this object should be
     // deleted.
     int try_again_or_fail();
+    // Call this function after the connection failed and is gone.  It
+    // counts the failure, and reconnects after backoff if --reconnect
+    // allows another attempt.  If so, this function returns 0, and
+    // this object should be retained.  Otherwise, or if the connection
+    // just ended, this function returns -1.
+    int reconnect_after_failure();
+    // Call this function when the backoff before reconnect is over.
+    void on_reconnect_due();
+    // Sets conn_error to the class of errno |err|, where 0 means the
+    // server closed the connection.
+    void set_conn_error(int err);
+    // Sets conn_error to the class of SSL_get_error() result
+    // |ssl_err|.
+    void set_tls_error(int ssl_err);
     void timeout();
     void restart_timeout();
     int submit_request();
+    // Submits another attempt of call |idx|, a hedge if |hedge| is
+    // true, or a retry.  It is extra load, so the request budget and
+    // the session limit are not applied.
+    int submit_attempt(uint32_t idx, bool hedge);
+    // Counts the request just submitted.
+    void on_request_submitted();
+    // Lets the user go on after its request is done, on a connection
+    // which is |final| unless this is a pool.  |step_ok| is true if
+    // the request of a --scenario step succeeded.
+    void on_request_done(bool final, bool step_ok);
+    // Returns the index of the request template to send next, out of
+    // |n| templates.  Templates are taken in turn, or drawn by their
+    // weights with --mix.
+    size_t next_template(size_t n);
     void process_request_failure();
     void process_timedout_streams();
     void process_abandoned_streams();
@@ -356,34 +2076,130 @@ struct Client {
     int connected();
     int read_clear();
     int write_clear();
+    // Returns the bytes a slow reader may read now, or 0 after it
+    // stopped reading until read_resume_watcher fires.  Other
+    // connections may read without limit.
+    size_t read_allowance();
+    // Called when a write finds the socket buffer full, and when
+    // |nwrite| bytes have been written
+    void on_write_blocked();
+    void on_written(size_t nwrite);
+    // Switches I/O to read_clear() and write_clear() for the
+    // directions the kernel took over with --ktls.
+    void enable_ktls();
+    // Counts the handshake just done as a request in
+    // --handshake-bench=handshake.
+    void on_handshake_done();
+    // Enables --timestamping on the connected socket.
+    void enable_timestamping();
+    // Submits requests until as many are in flight as the session
+    // allows.  This is called when the server raised its limit.
+    void fill_streams();
+    // Sends a PING unless the last one is still unanswered.
+    void submit_ping();
+    // Records the round trip time of the PING which has been answered.
+    void on_ping_ack();
+    // Reads the transmit timestamps queued on the socket, and passes
+    // them to the requests they complete.
+    void read_tx_timestamps();
     int tls_handshake();
     int read_tls();
     int write_tls();
+    int write_uring();
 
     int on_read(const uint8_t *data, size_t len);
     int on_write();
 
     int connection_made();
 
-    void on_request(int32_t stream_id);
+    // Call this function when the request with the request template
+    // |tmpl| is submitted on |stream_id|.
+    void on_request(int32_t stream_id, size_t tmpl);
+    // Call this function when a oneway request with the request
+    // template |tmpl| is queued.  It is done then, as no response
+    // comes.
+    void on_oneway_request(size_t tmpl);
     void on_header(int32_t stream_id, const uint8_t *name, size_t namelen,
                    const uint8_t *value, size_t valuelen);
     void on_status_code(int32_t stream_id, uint16_t status);
+    // Adds the bytes of the parts of the response on |stream_id|, as
+    // in RequestStat, with --response-sizes.  |wire| is the bytes it
+    // took on the wire, including framing.
+    void on_response_bytes(int32_t stream_id, size_t wire, size_t header,
+                           size_t classname, size_t content);
+    // Takes the content coding of the response on |stream_id| from
+    // its Content-Encoding header |value| of |len| bytes, with
+    // --accept-encoding or --decode.
+    void on_content_encoding(int32_t stream_id, const uint8_t *value,
+                             size_t len);
+    // Counts |len| bytes of the body of the response on |stream_id|,
+    // and decodes them at |data| with --decode.  |data| is nullptr if
+    // the body is skipped without being read.
+    void on_body(int32_t stream_id, const uint8_t *data, size_t len);
     // |success| == true means that the request/response was exchanged
     // |successfully, but it does not mean response carried successful
     // |HTTP status code.
     void on_stream_close(int32_t stream_id, bool success, bool final = false);
 
     void on_sofarpc_status(int32_t stream_id, uint16_t status);
+    // Takes the status of the call on |stream_id| from grpc-status
+    // value |value| of |len| bytes, with --grpc.
+    void on_grpc_status(int32_t stream_id, const uint8_t *value, size_t len);
+    // Call this function when the request on |stream_id| passed
+    // --request-timeout.  The session gives it up, and it is counted
+    // as timed out.
+    void on_request_deadline(int32_t stream_id);
+    // Returns true if the current connection has taken
+    // --churn-requests, and takes no more.
+    bool churn_due() const;
+    // Call this function when the current connection reached
+    // --churn-lifetime.  It is closed and made again.
+    void on_churn_timeout();
+    // Starts a --scenario transaction at its first step.  A
+    // transaction still running is counted as failed.
+    void start_transaction();
+    // Sends the requests of the current --scenario step.
+    void start_step();
+    // Call this function when a request of the current --scenario
+    // step is done, successfully if |ok| is true.  The next step
+    // starts once all are done, after the think time of this one.
+    void on_step_request_done(bool ok);
+    // Starts the next --scenario step, or the next transaction after
+    // the last step.
+    void next_step();
+    // Makes a user of this client wait |t| seconds before its next
+    // request, or the next --scenario step.
+    void start_think(double t);
+    // Call this function when the think time of the user at |node| is
+    // over.
+    void on_think_over(DeadlineNode *node);
+    // Call this function when a response of the SofaRPC server stream
+    // |stream_id| is complete.  It returns the number of responses of
+    // the stream so far, or 0 if the stream is unknown.
+    uint32_t on_stream_message(int32_t stream_id);
+    // Writes the --trace record of the request on |stream|.
+    void trace_request(int32_t stream_id, const Stream &stream,
+                       uint64_t rtt_in_ns);
+    // Queues the request on |stream| for --request-log if it is picked.
+    void log_request(int32_t stream_id, const Stream &stream,
+                     uint64_t rtt_in_ns);
 
     // Returns RequestStat for |stream_id|.  This function must be
     // called after on_request(stream_id), and before
     // on_stream_close(stream_id, ...).  Otherwise, this will return
     // nullptr.
     RequestStat *get_req_stat(int32_t stream_id);
+    // Appends |data| of |len| bytes to wb, with |slots| in it filled
+    // right in the chunks by Worker::subst.
+    void append_subst(const uint8_t *data, size_t len,
+                      const std::vector<SubstSlot> &slots);
 
     void record_request_time(RequestStat *req_stat);
     void record_connect_start_time();
+    void record_tcp_connect_time();
+    // Records the local port and the address of the connection just
+    // made, for --imbalance.
+    void record_local_port();
     void record_connect_time();
     void record_ttfb();
     void clear_connect_times();
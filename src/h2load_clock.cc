@@ -0,0 +1,95 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_clock.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif // __x86_64__ || __i386__
+
+#include <thread>
+#include <utility>
+
+namespace h2load {
+
+bool tsc_available() {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 ||
+        eax < 0x80000007) {
+        return false;
+    }
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    // Advanced power management: invariant TSC
+    return (edx & (1 << 8)) != 0;
+#else  // !(__x86_64__ || __i386__)
+    return false;
+#endif // !(__x86_64__ || __i386__)
+}
+
+namespace {
+// Reads steady_clock and the TSC at once.  The TSC is read on either
+// side of steady_clock, and the middle is taken.
+std::pair<std::chrono::steady_clock::time_point, uint64_t> read_pair() {
+    auto a = read_tsc();
+    auto t = std::chrono::steady_clock::now();
+    auto b = read_tsc();
+    return {t, a + (b - a) / 2};
+}
+} // namespace
+
+double calibrate_tsc(std::chrono::milliseconds span) {
+    auto start = read_pair();
+    std::this_thread::sleep_for(span);
+    auto end = read_pair();
+    auto ticks = end.second - start.second;
+    if (ticks == 0) {
+        return 0.;
+    }
+    return static_cast<double>(
+               std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   end.first - start.first)
+                   .count()) /
+           ticks;
+}
+
+TscClock::TscClock() : ns_per_tick(0.), anchor_ticks(0), anchor_time{} {}
+
+void TscClock::anchor(uint64_t ticks,
+                      std::chrono::steady_clock::time_point t) {
+    anchor_ticks = ticks;
+    anchor_time = t;
+}
+
+std::chrono::steady_clock::time_point
+TscClock::to_time_point(uint64_t ticks) const {
+    // Readings on another CPU may be a little behind the anchor.
+    auto d = static_cast<double>(static_cast<int64_t>(ticks - anchor_ticks)) *
+             ns_per_tick;
+    return anchor_time +
+           std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+               std::chrono::nanoseconds(static_cast<int64_t>(d)));
+}
+
+} // namespace h2load
@@ -0,0 +1,81 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_CLOCK_H
+#define H2LOAD_CLOCK_H
+
+#include "nghttp2_config.h"
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif // __x86_64__ || __i386__
+
+namespace h2load {
+
+// Returns true if the CPU has an invariant TSC, which ticks at a
+// constant rate in all power states, and this build can read it.
+bool tsc_available();
+
+// Reads the TSC, or returns 0 where there is none.
+inline uint64_t read_tsc() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else  // !(__x86_64__ || __i386__)
+    return 0;
+#endif // !(__x86_64__ || __i386__)
+}
+
+// Measures the rate of the TSC against steady_clock for |span|, and
+// returns the nanoseconds per tick.  It sleeps for |span|.
+double calibrate_tsc(std::chrono::milliseconds span);
+
+// TscClock converts TSC readings to steady_clock time points.  It is
+// anchored to a pair of readings of the TSC and steady_clock taken at
+// once, so that the error of the calibrated rate only grows with the
+// distance from the anchor.
+struct TscClock {
+    TscClock();
+
+    // Anchors the conversion at |ticks| read at |t|.
+    void anchor(uint64_t ticks, std::chrono::steady_clock::time_point t);
+    // Returns the time point at which the TSC read |ticks|.
+    std::chrono::steady_clock::time_point
+    to_time_point(uint64_t ticks) const;
+
+    std::chrono::steady_clock::time_point now() const {
+        return to_time_point(read_tsc());
+    }
+
+    // Nanoseconds per tick, from calibrate_tsc()
+    double ns_per_tick;
+    uint64_t anchor_ticks;
+    std::chrono::steady_clock::time_point anchor_time;
+};
+
+} // namespace h2load
+
+#endif // H2LOAD_CLOCK_H
@@ -0,0 +1,61 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_clock_test.h"
+
+#include <CUnit/CUnit.h>
+
+#include "h2load_clock.h"
+
+namespace h2load {
+
+void test_clock_tsc_clock(void) {
+    TscClock clock;
+    clock.ns_per_tick = 0.5;
+    auto t = std::chrono::steady_clock::time_point(std::chrono::seconds(100));
+    clock.anchor(1000000, t);
+
+    CU_ASSERT(t == clock.to_time_point(1000000));
+    CU_ASSERT(t + std::chrono::microseconds(1) ==
+              clock.to_time_point(1002000));
+    // A reading a little before the anchor
+    CU_ASSERT(t - std::chrono::nanoseconds(50) == clock.to_time_point(999900));
+
+    // Anchors again further on.
+    auto u = t + std::chrono::seconds(1);
+    clock.anchor(5000000000ULL, u);
+
+    CU_ASSERT(u + std::chrono::milliseconds(2) ==
+              clock.to_time_point(5004000000ULL));
+
+    if (tsc_available()) {
+        auto ns_per_tick = calibrate_tsc(std::chrono::milliseconds(10));
+
+        // From 10MHz to 100GHz
+        CU_ASSERT(ns_per_tick > 0.01);
+        CU_ASSERT(ns_per_tick < 100.);
+    }
+}
+
+} // namespace h2load
@@ -0,0 +1,500 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_compare.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+namespace h2load {
+
+namespace {
+bool ends_with(const std::string &s, const std::string &suffix) {
+    return s.size() >= suffix.size() &&
+           s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+std::string join(const std::string &path, const std::string &name) {
+    return path.empty() ? name : path + "." + name;
+}
+} // namespace
+
+namespace {
+// JsonParser reads JSON into ResultData.  Arrays are skipped, except
+// the "buckets" of histograms.
+class JsonParser {
+  public:
+    JsonParser(ResultData &r, const std::string &text)
+        : r_(r), p_(text.c_str()), end_(text.c_str() + text.size()) {}
+
+    int parse() {
+        if (value("") != 0) {
+            return -1;
+        }
+        skip_ws();
+        return p_ == end_ ? 0 : -1;
+    }
+
+  private:
+    void skip_ws() {
+        while (p_ != end_ && strchr(" \t\r\n", *p_)) {
+            ++p_;
+        }
+    }
+
+    bool consume(char c) {
+        skip_ws();
+        if (p_ != end_ && *p_ == c) {
+            ++p_;
+            return true;
+        }
+        return false;
+    }
+
+    int value(const std::string &path) {
+        skip_ws();
+        if (p_ == end_) {
+            return -1;
+        }
+        switch (*p_) {
+        case '{':
+            return object(path);
+        case '[':
+            if (path == "buckets") {
+                return buckets(r_.histograms[""]);
+            }
+            if (ends_with(path, ".buckets")) {
+                return buckets(r_.histograms[path.substr(
+                    0, path.size() - strlen(".buckets"))]);
+            }
+            return array();
+        case '"': {
+            std::string s;
+            return string(s);
+        }
+        default:
+            break;
+        }
+        for (auto lit : {"true", "false", "null"}) {
+            auto len = strlen(lit);
+            if (static_cast<size_t>(end_ - p_) >= len &&
+                memcmp(p_, lit, len) == 0) {
+                p_ += len;
+                return 0;
+            }
+        }
+        double v;
+        if (number(v) != 0) {
+            return -1;
+        }
+        if (!path.empty()) {
+            r_.values[path] = v;
+        }
+        return 0;
+    }
+
+    int object(const std::string &path) {
+        ++p_;
+        if (consume('}')) {
+            return 0;
+        }
+        for (;;) {
+            skip_ws();
+            std::string name;
+            if (string(name) != 0 || !consume(':') ||
+                value(join(path, name)) != 0) {
+                return -1;
+            }
+            if (consume('}')) {
+                return 0;
+            }
+            if (!consume(',')) {
+                return -1;
+            }
+        }
+    }
+
+    int array() {
+        ++p_;
+        if (consume(']')) {
+            return 0;
+        }
+        for (;;) {
+            if (value("") != 0) {
+                return -1;
+            }
+            if (consume(']')) {
+                return 0;
+            }
+            if (!consume(',')) {
+                return -1;
+            }
+        }
+    }
+
+    // Reads an array of [low, high, count] arrays.
+    int buckets(std::vector<ResultBucket> &out) {
+        ++p_;
+        if (consume(']')) {
+            return 0;
+        }
+        for (;;) {
+            double v[3];
+            if (!consume('[')) {
+                return -1;
+            }
+            for (size_t i = 0; i < 3; ++i) {
+                if ((i > 0 && !consume(',')) || number(v[i]) != 0) {
+                    return -1;
+                }
+            }
+            if (!consume(']')) {
+                return -1;
+            }
+            out.push_back({static_cast<uint64_t>(v[0]),
+                           static_cast<uint64_t>(v[1]),
+                           static_cast<uint64_t>(v[2])});
+            if (consume(']')) {
+                return 0;
+            }
+            if (!consume(',')) {
+                return -1;
+            }
+        }
+    }
+
+    // Reads a string.  Escapes other than \" and \\ are kept as they
+    // are, which is enough for names.
+    int string(std::string &s) {
+        if (p_ == end_ || *p_ != '"') {
+            return -1;
+        }
+        for (++p_; p_ != end_ && *p_ != '"'; ++p_) {
+            if (*p_ == '\\' && p_ + 1 != end_) {
+                ++p_;
+            }
+            s += *p_;
+        }
+        if (p_ == end_) {
+            return -1;
+        }
+        ++p_;
+        return 0;
+    }
+
+    int number(double &v) {
+        skip_ws();
+        char *last;
+        v = strtod(p_, &last);
+        if (last == p_ || last > end_) {
+            return -1;
+        }
+        p_ = last;
+        return 0;
+    }
+
+    ResultData &r_;
+    const char *p_;
+    const char *end_;
+};
+} // namespace
+
+namespace {
+// Parses CSV written by CsvResultWriter.  A bucket row is keyed by
+// the name of its histogram, "buckets" and its range "low-high".
+int parse_csv(ResultData &r, const std::string &text) {
+    std::istringstream in(text);
+    std::string line;
+    std::getline(in, line);
+    if (line != "key,value") {
+        return -1;
+    }
+    while (std::getline(in, line)) {
+        auto comma = line.find(',');
+        if (comma == std::string::npos) {
+            return -1;
+        }
+        auto key = line.substr(0, comma);
+        auto value = line.substr(comma + 1);
+        // Strings and booleans are not compared.
+        if ((!value.empty() && value[0] == '"') || value == "true" ||
+            value == "false") {
+            continue;
+        }
+
+        auto pos = key.rfind(".buckets.");
+        if (pos != std::string::npos || key.compare(0, 8, "buckets.") == 0) {
+            auto name = pos == std::string::npos ? std::string()
+                                                 : key.substr(0, pos);
+            auto range = key.substr(pos == std::string::npos ? 8 : pos + 9);
+            auto dash = range.find('-');
+            if (dash == std::string::npos) {
+                return -1;
+            }
+            r.histograms[name].push_back(
+                {strtoull(range.c_str(), nullptr, 10),
+                 strtoull(range.c_str() + dash + 1, nullptr, 10),
+                 strtoull(value.c_str(), nullptr, 10)});
+            continue;
+        }
+
+        char *last;
+        auto v = strtod(value.c_str(), &last);
+        if (last == value.c_str()) {
+            return -1;
+        }
+        r.values[key] = v;
+    }
+    return 0;
+}
+} // namespace
+
+int parse_result(ResultData &r, const std::string &text) {
+    auto first = text.find_first_not_of(" \t\r\n");
+    if (first != std::string::npos && text[first] == '{') {
+        if (JsonParser(r, text).parse() != 0) {
+            std::cerr << "malformed JSON result" << std::endl;
+            return -1;
+        }
+        return 0;
+    }
+    if (parse_csv(r, text) != 0) {
+        std::cerr << "malformed CSV result" << std::endl;
+        return -1;
+    }
+    return 0;
+}
+
+namespace {
+uint64_t total_count(const std::vector<ResultBucket> &buckets) {
+    uint64_t n = 0;
+    for (auto &b : buckets) {
+        n += b.count;
+    }
+    return n;
+}
+} // namespace
+
+uint64_t bucket_value_at_rank(const std::vector<ResultBucket> &buckets,
+                              uint64_t rank) {
+    uint64_t sum = 0;
+    for (auto &b : buckets) {
+        sum += b.count;
+        if (sum >= rank) {
+            return b.high;
+        }
+    }
+    return buckets.empty() ? 0 : buckets.back().high;
+}
+
+KsResult ks_test(const std::vector<ResultBucket> &a,
+                 const std::vector<ResultBucket> &b) {
+    auto na = total_count(a);
+    auto nb = total_count(b);
+    if (na == 0 || nb == 0) {
+        return {0., 1.};
+    }
+
+    // Walk both histograms in the order of the upper ends of their
+    // buckets, which is as fine as the distribution functions are
+    // known.
+    double d = 0.;
+    uint64_t ca = 0, cb = 0;
+    size_t i = 0, j = 0;
+    while (i < a.size() || j < b.size()) {
+        uint64_t x;
+        if (j == b.size() || (i < a.size() && a[i].high <= b[j].high)) {
+            x = a[i].high;
+        } else {
+            x = b[j].high;
+        }
+        for (; i < a.size() && a[i].high <= x; ++i) {
+            ca += a[i].count;
+        }
+        for (; j < b.size() && b[j].high <= x; ++j) {
+            cb += b[j].count;
+        }
+        d = std::max(d, std::abs(static_cast<double>(ca) / na -
+                                 static_cast<double>(cb) / nb));
+    }
+
+    // The asymptotic distribution of the statistic, with the
+    // correction for small samples from Stephens (1970).
+    auto ne = static_cast<double>(na) * nb / (na + nb);
+    auto lambda = (std::sqrt(ne) + 0.12 + 0.11 / std::sqrt(ne)) * d;
+    double p = 0.;
+    if (lambda < 0.2) {
+        p = 1.;
+    } else {
+        double sign = 1.;
+        for (int k = 1; k <= 100; ++k) {
+            auto term = sign * std::exp(-2. * k * k * lambda * lambda);
+            p += term;
+            if (std::abs(term) < 1e-10) {
+                break;
+            }
+            sign = -sign;
+        }
+        p = std::min(1., std::max(0., 2. * p));
+    }
+    return {d, p};
+}
+
+namespace {
+// z of the two-sided 95% confidence interval
+constexpr double Z95 = 1.96;
+
+// Returns the values of the --timeline intervals in |r| under
+// |prefix|, in order.
+std::vector<double> interval_values(const ResultData &r,
+                                    const std::string &prefix) {
+    std::vector<double> values;
+    for (size_t i = 1;; ++i) {
+        auto it = r.values.find(prefix + std::to_string(i));
+        if (it == std::end(r.values)) {
+            return values;
+        }
+        values.push_back((*it).second);
+    }
+}
+
+void mean_var(const std::vector<double> &v, double &mean, double &var) {
+    mean = 0.;
+    for (auto x : v) {
+        mean += x;
+    }
+    mean /= v.size();
+    var = 0.;
+    for (auto x : v) {
+        var += (x - mean) * (x - mean);
+    }
+    var /= v.size() - 1;
+}
+
+double percent(double delta, double base) {
+    return base > 0. ? delta / base * 100. : 0.;
+}
+
+// Sets the bounds of the 95% confidence interval of |row| from the
+// per-interval values |a| of the baseline and |b| of the current
+// result, if both have at least 2: the standard error of the
+// difference of their means, as in Welch's test, relative to the mean
+// of the baseline.
+void interval_ci(CompareRow &row, const std::vector<double> &a,
+                 const std::vector<double> &b) {
+    if (a.size() < 2 || b.size() < 2) {
+        return;
+    }
+    double ma, va, mb, vb;
+    mean_var(a, ma, va);
+    mean_var(b, mb, vb);
+    auto half = percent(Z95 * std::sqrt(va / a.size() + vb / b.size()), ma);
+    row.ci_low = row.delta - half;
+    row.ci_high = row.delta + half;
+}
+
+// Returns the value of percentile |p| of |buckets|.
+double percentile_value(const std::vector<ResultBucket> &buckets, double p) {
+    auto n = static_cast<double>(total_count(buckets));
+    auto q = std::min(p, 100.) / 100.;
+    return bucket_value_at_rank(
+        buckets, static_cast<uint64_t>(std::max(1., std::ceil(q * n))));
+}
+
+// Returns |p| as --output names it in the latency sections.
+std::string percentile_key(double p) {
+    std::ostringstream os;
+    os << std::setprecision(10) << p;
+    return os.str();
+}
+
+std::string percentile_name(double p) {
+    std::ostringstream os;
+    os << "p" << p;
+    return os.str();
+}
+} // namespace
+
+int compare_results(CompareResult &res, const ResultData &baseline,
+                    const ResultData &current, const CompareOptions &opts) {
+    auto base_rps = baseline.values.find("rps");
+    auto cur_rps = current.values.find("rps");
+    if (base_rps == std::end(baseline.values) ||
+        cur_rps == std::end(current.values)) {
+        std::cerr << "the result has no req/s" << std::endl;
+        return -1;
+    }
+    auto base_hist = baseline.histograms.find("latency");
+    auto cur_hist = current.histograms.find("latency");
+    if (base_hist == std::end(baseline.histograms) ||
+        cur_hist == std::end(current.histograms) ||
+        total_count((*base_hist).second) == 0 ||
+        total_count((*cur_hist).second) == 0) {
+        std::cerr << "the result has no latency histogram" << std::endl;
+        return -1;
+    }
+
+    res.rows.clear();
+    res.regression = false;
+    constexpr auto nan = std::numeric_limits<double>::quiet_NaN();
+
+    {
+        CompareRow row{"req/s", (*base_rps).second, (*cur_rps).second,
+                       percent((*cur_rps).second - (*base_rps).second,
+                               (*base_rps).second),
+                       nan, nan, false};
+        interval_ci(row, interval_values(baseline, "intervals."),
+                    interval_values(current, "intervals."));
+        row.regression = -row.delta > opts.max_rps_drop &&
+                         !(row.ci_high >= 0.);
+        res.rows.push_back(row);
+    }
+
+    for (auto p : opts.percentiles) {
+        auto bv = percentile_value((*base_hist).second, p);
+        auto cv = percentile_value((*cur_hist).second, p);
+        CompareRow row{percentile_name(p), bv, cv, percent(cv - bv, bv),
+                       nan, nan, false};
+        auto prefix = "intervals.latency." + percentile_key(p) + ".";
+        interval_ci(row, interval_values(baseline, prefix),
+                    interval_values(current, prefix));
+        row.regression = row.delta > opts.max_latency_rise &&
+                         !(row.ci_low <= 0.);
+        res.rows.push_back(row);
+    }
+
+    for (auto &row : res.rows) {
+        res.regression = res.regression || row.regression;
+    }
+    res.ks = ks_test((*base_hist).second, (*cur_hist).second);
+    return 0;
+}
+
+} // namespace h2load
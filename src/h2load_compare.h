@@ -0,0 +1,118 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_COMPARE_H
+#define H2LOAD_COMPARE_H
+
+#include "nghttp2_config.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace h2load {
+
+// A histogram bucket of a result file: |count| values in [|low|,
+// |high|]
+struct ResultBucket {
+    uint64_t low;
+    uint64_t high;
+    uint64_t count;
+};
+
+// The numbers of a --output result file, keyed by the dot separated
+// names of their sections, as in CSV output (e.g. "requests.done").
+// The buckets of each histogram are keyed the same way by the name of
+// the histogram (e.g. "latency").
+struct ResultData {
+    std::map<std::string, double> values;
+    std::map<std::string, std::vector<ResultBucket>> histograms;
+};
+
+// Parses the --output result in |text|, written in either JSON or
+// CSV, into |r|.  Returns 0 if it succeeds, or -1 after printing the
+// error.
+int parse_result(ResultData &r, const std::string &text);
+
+// Returns the value at |rank|, counted from 1, of the values in
+// |buckets|: the highest value of the bucket it falls into.
+uint64_t bucket_value_at_rank(const std::vector<ResultBucket> &buckets,
+                              uint64_t rank);
+
+// The two-sample Kolmogorov-Smirnov test of two histograms: the
+// largest distance between their distribution functions, and the
+// probability of a distance at least as large if both were drawn
+// from the same distribution.
+struct KsResult {
+    double d;
+    double p;
+};
+
+KsResult ks_test(const std::vector<ResultBucket> &a,
+                 const std::vector<ResultBucket> &b);
+
+struct CompareOptions {
+    // The percentiles of latency to compare
+    std::vector<double> percentiles;
+    // The drop of req/s, and the rise of a latency percentile, in
+    // percent, which fail the comparison
+    double max_rps_drop;
+    double max_latency_rise;
+};
+
+// The comparison of one metric.  |delta|, |ci_low| and |ci_high| are
+// the relative change from the baseline and the bounds of its 95%
+// confidence interval, in percent.  The bounds are NaN if they
+// cannot be estimated.
+struct CompareRow {
+    std::string name;
+    double baseline;
+    double current;
+    double delta;
+    double ci_low;
+    double ci_high;
+    // true if the change is worse than the threshold, and the whole
+    // confidence interval is on the worse side of no change
+    bool regression;
+};
+
+struct CompareResult {
+    std::vector<CompareRow> rows;
+    // The test of the latency histograms
+    KsResult ks;
+    bool regression;
+};
+
+// Compares |current| with |baseline|.  Throughput is compared by
+// req/s, and latency percentiles from the latency histograms.  The
+// confidence interval of each is estimated from its values in the
+// --timeline intervals, if both results have them.  Returns 0 if it
+// succeeds, or -1 after printing the error.
+int compare_results(CompareResult &res, const ResultData &baseline,
+                    const ResultData &current, const CompareOptions &opts);
+
+} // namespace h2load
+
+#endif // H2LOAD_COMPARE_H
@@ -0,0 +1,190 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_compare_test.h"
+
+#include <cmath>
+#include <string>
+
+#include <CUnit/CUnit.h>
+
+#include "h2load_compare.h"
+
+namespace h2load {
+
+namespace {
+// Returns a JSON result with |rps|, the per-interval |rates|, and a
+// latency histogram of |n| values spread evenly over [|lo|, |hi|].
+// The p50 and p99 of each interval are those of the histogram plus
+// the offset of the interval in |lat|.
+std::string make_result(double rps, const std::vector<double> &rates,
+                        const std::vector<double> &lat, uint64_t lo,
+                        uint64_t hi, uint64_t n) {
+    std::string s = "{\n  \"rps\": " + std::to_string(rps) +
+                    ",\n  \"requests\": {\"done\": 10, \"name\": \"x\\\"y\"}";
+    if (!rates.empty() || !lat.empty()) {
+        s += ",\n  \"intervals\": {\"interval\": 1.0";
+        for (size_t i = 0; i < rates.size(); ++i) {
+            s += ", \"" + std::to_string(i + 1) +
+                 "\": " + std::to_string(rates[i]);
+        }
+        s += ", \"latency\": {";
+        for (auto p : {50, 99}) {
+            s += std::string(p == 50 ? "" : ", ") + "\"" + std::to_string(p) +
+                 "\": {";
+            for (size_t i = 0; i < lat.size(); ++i) {
+                s += std::string(i == 0 ? "" : ", ") + "\"" +
+                     std::to_string(i + 1) + "\": " +
+                     std::to_string(lo + (hi - lo) * p / 100. + lat[i]);
+            }
+            s += "}";
+        }
+        s += "}}";
+    }
+    s += ",\n  \"latency\": {\"unit\": \"ns\", \"buckets\": [";
+    for (uint64_t v = lo; v <= hi; ++v) {
+        s += (v == lo ? "[" : ",[") + std::to_string(v) + "," +
+             std::to_string(v) + "," + std::to_string(n / (hi - lo + 1)) + "]";
+    }
+    s += "]}\n}\n";
+    return s;
+}
+} // namespace
+
+void test_compare_parse_result(void) {
+    {
+        ResultData r;
+        CU_ASSERT(0 == parse_result(r, make_result(100., {99., 101.}, {1.},
+                                                    1, 4, 400)));
+        CU_ASSERT(100. == r.values["rps"]);
+        CU_ASSERT(10. == r.values["requests.done"]);
+        CU_ASSERT(0 == r.values.count("requests.name"));
+        CU_ASSERT(101. == r.values["intervals.2"]);
+        CU_ASSERT(std::abs(r.values["intervals.latency.99.1"] - 4.97) < 1e-9);
+        auto &b = r.histograms["latency"];
+        CU_ASSERT(4 == b.size());
+        CU_ASSERT(3 == b[2].low);
+        CU_ASSERT(3 == b[2].high);
+        CU_ASSERT(100 == b[2].count);
+    }
+    {
+        ResultData r;
+        CU_ASSERT(0 == parse_result(r, "key,value\n"
+                                       "rps,250.5\n"
+                                       "latency.unit,\"ns\"\n"
+                                       "generator.0.saturated,false\n"
+                                       "latency.buckets.8-9,3\n"
+                                       "latency.buckets.10-11,2\n"));
+        CU_ASSERT(250.5 == r.values["rps"]);
+        auto &b = r.histograms["latency"];
+        CU_ASSERT(2 == b.size());
+        CU_ASSERT(10 == b[1].low);
+        CU_ASSERT(11 == b[1].high);
+        CU_ASSERT(2 == b[1].count);
+    }
+    {
+        ResultData r;
+        CU_ASSERT(-1 == parse_result(r, "{\"rps\": 1,"));
+        CU_ASSERT(-1 == parse_result(r, "rps,1\n"));
+    }
+}
+
+void test_compare_ks_test(void) {
+    std::vector<ResultBucket> a{{1, 1, 50}, {2, 2, 50}};
+    auto same = ks_test(a, a);
+    CU_ASSERT(0. == same.d);
+    CU_ASSERT(1. == same.p);
+
+    std::vector<ResultBucket> b{{2, 2, 50}, {3, 3, 50}};
+    auto shifted = ks_test(a, b);
+    CU_ASSERT(std::abs(shifted.d - 0.5) < 1e-9);
+    CU_ASSERT(shifted.p < 0.001);
+
+    CU_ASSERT(2 == bucket_value_at_rank(a, 51));
+    CU_ASSERT(1 == bucket_value_at_rank(a, 50));
+}
+
+void test_compare_results(void) {
+    CompareOptions opts{{50., 99.}, 5., 10.};
+    ResultData base, same, slow, noisy, fewer, whole;
+    CU_ASSERT(0 == parse_result(base, make_result(1000., {990., 1010., 1000.,
+                                                          995., 1005.},
+                                                   {-2., 1., 0., 2., -1.}, 100,
+                                                   199, 10000)));
+    CU_ASSERT(0 == parse_result(same, make_result(1001., {995., 1008., 1000.,
+                                                          1002., 999.},
+                                                   {1., -1., 0., 2., -2.}, 100,
+                                                   199, 10000)));
+    CU_ASSERT(0 == parse_result(slow, make_result(1000., {},
+                                                   {0., 1., -1., 2., -2.}, 150,
+                                                   249, 10000)));
+    CU_ASSERT(0 == parse_result(noisy, make_result(1000., {},
+                                                    {-200., 250., -150., 200.,
+                                                     -100.},
+                                                    130, 229, 10000)));
+    CU_ASSERT(0 == parse_result(fewer, make_result(800., {790., 810., 800.,
+                                                          795., 805.},
+                                                    {1., -1., 0., 2., -2.},
+                                                    100, 199, 10000)));
+    CU_ASSERT(0 == parse_result(whole, make_result(1000., {}, {}, 100, 199,
+                                                    10000)));
+
+    CompareResult res;
+    CU_ASSERT(0 == compare_results(res, base, same, opts));
+    CU_ASSERT(!res.regression);
+    CU_ASSERT(3 == res.rows.size());
+    CU_ASSERT("req/s" == res.rows[0].name);
+    CU_ASSERT(res.rows[0].ci_low < 0. && res.rows[0].ci_high > 0.);
+    CU_ASSERT("p99" == res.rows[2].name);
+
+    CU_ASSERT(0 == compare_results(res, base, slow, opts));
+    CU_ASSERT(res.regression);
+    CU_ASSERT(!res.rows[0].regression);
+    CU_ASSERT(std::isnan(res.rows[0].ci_low));
+    CU_ASSERT(res.rows[1].regression);
+    CU_ASSERT(res.rows[1].ci_low > 0.);
+    CU_ASSERT(res.ks.p < 0.001);
+
+    // The latency of the intervals varies too much to tell.
+    CU_ASSERT(0 == compare_results(res, base, noisy, opts));
+    CU_ASSERT(!res.regression);
+    CU_ASSERT(res.rows[1].delta > opts.max_latency_rise);
+    CU_ASSERT(res.rows[1].ci_low < 0.);
+
+    // Without intervals, only the threshold counts.
+    CU_ASSERT(0 == compare_results(res, whole, slow, opts));
+    CU_ASSERT(res.rows[1].regression);
+    CU_ASSERT(std::isnan(res.rows[1].ci_low));
+
+    CU_ASSERT(0 == compare_results(res, base, fewer, opts));
+    CU_ASSERT(res.regression);
+    CU_ASSERT(res.rows[0].regression);
+    CU_ASSERT(std::abs(res.rows[0].delta + 20.) < 1e-9);
+    CU_ASSERT(!res.rows[1].regression);
+
+    ResultData empty;
+    CU_ASSERT(-1 == compare_results(res, base, empty, opts));
+}
+
+} // namespace h2load
@@ -0,0 +1,124 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_decode.h"
+
+#include <cstring>
+
+#include "util.h"
+
+using namespace nghttp2;
+
+namespace h2load {
+
+ContentCoding parse_content_coding(const uint8_t *value, size_t len) {
+    auto first = reinterpret_cast<const char *>(value);
+    auto last = first + len;
+    for (; first != last && (*first == ' ' || *first == '\t'); ++first)
+        ;
+    for (; last != first && (last[-1] == ' ' || last[-1] == '\t'); --last)
+        ;
+    if (first == last || util::strieq_l("identity", first, last - first)) {
+        return CODING_IDENTITY;
+    }
+    if (util::strieq_l("gzip", first, last - first) ||
+        util::strieq_l("x-gzip", first, last - first)) {
+        return CODING_GZIP;
+    }
+    if (util::strieq_l("deflate", first, last - first)) {
+        return CODING_DEFLATE;
+    }
+    if (util::strieq_l("br", first, last - first)) {
+        return CODING_BR;
+    }
+    if (util::strieq_l("zstd", first, last - first)) {
+        return CODING_ZSTD;
+    }
+    return CODING_OTHER;
+}
+
+const char *content_coding_name(ContentCoding coding) {
+    switch (coding) {
+    case CODING_IDENTITY:
+        return "identity";
+    case CODING_GZIP:
+        return "gzip";
+    case CODING_DEFLATE:
+        return "deflate";
+    case CODING_BR:
+        return "br";
+    case CODING_ZSTD:
+        return "zstd";
+    default:
+        return "other";
+    }
+}
+
+Inflater::Inflater() : zst_{}, init_(false), finished_(false) {}
+
+Inflater::~Inflater() {
+    if (init_) {
+        inflateEnd(&zst_);
+    }
+}
+
+int Inflater::reset() {
+    finished_ = false;
+    if (init_) {
+        return inflateReset(&zst_) == Z_OK ? 0 : -1;
+    }
+    // 32 lets zlib tell a gzip header from a zlib one.
+    if (inflateInit2(&zst_, MAX_WBITS + 32) != Z_OK) {
+        return -1;
+    }
+    init_ = true;
+    return 0;
+}
+
+int Inflater::feed(const uint8_t *data, size_t len,
+                   std::array<uint8_t, DECODE_BUFFER_SIZE> &buf,
+                   uint64_t &decoded) {
+    zst_.next_in = const_cast<uint8_t *>(data);
+    zst_.avail_in = len;
+    // Whatever follows the end of the body is ignored.
+    while (!finished_ && zst_.avail_in > 0) {
+        zst_.next_out = buf.data();
+        zst_.avail_out = buf.size();
+        auto rv = inflate(&zst_, Z_NO_FLUSH);
+        decoded += buf.size() - zst_.avail_out;
+        if (rv == Z_STREAM_END) {
+            finished_ = true;
+        } else if (rv == Z_BUF_ERROR) {
+            // No progress is possible until more of the body arrives.
+            if (zst_.avail_out) {
+                break;
+            }
+        } else if (rv != Z_OK) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+} // namespace h2load
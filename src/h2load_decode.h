@@ -0,0 +1,93 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_DECODE_H
+#define H2LOAD_DECODE_H
+
+#include "nghttp2_config.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <zlib.h>
+
+namespace h2load {
+
+// The content codings of responses told apart by --accept-encoding
+// and --decode.  Only gzip and deflate are decoded; the others are
+// counted as they are received.
+enum ContentCoding : uint8_t {
+    CODING_IDENTITY,
+    CODING_GZIP,
+    CODING_DEFLATE,
+    CODING_BR,
+    CODING_ZSTD,
+    CODING_OTHER,
+    CODING_MAX,
+};
+
+// Returns the content coding of Content-Encoding header value
+// |value| of |len| bytes.  A list of more than one coding is
+// CODING_OTHER.
+ContentCoding parse_content_coding(const uint8_t *value, size_t len);
+
+// Returns the name of content coding |coding|.
+const char *content_coding_name(ContentCoding coding);
+
+// The size of the buffer decoded output is written to and thrown
+// away
+constexpr size_t DECODE_BUFFER_SIZE = 16 * 1024;
+
+// Inflater decodes a gzip or deflate response body as it arrives.
+// It is reset for the next body rather than freed, so that a worker
+// keeps a pool of them for the bodies being received at once.
+class Inflater {
+  public:
+    Inflater();
+    ~Inflater();
+    Inflater(const Inflater &) = delete;
+    Inflater &operator=(const Inflater &) = delete;
+
+    // Prepares to decode a new body.  Returns 0 if it succeeds, or -1
+    // if zlib cannot allocate its state.
+    int reset();
+    // Decodes |len| bytes of the body at |data| into |buf|, and adds
+    // the length of the output to |decoded|.  Returns 0 if it
+    // succeeds, or -1 if the body is not valid.
+    int feed(const uint8_t *data, size_t len,
+             std::array<uint8_t, DECODE_BUFFER_SIZE> &buf,
+             uint64_t &decoded);
+    // Returns true if the end of the body has been decoded.
+    bool finished() const { return finished_; }
+
+  private:
+    z_stream zst_;
+    bool init_;
+    bool finished_;
+};
+
+} // namespace h2load
+
+#endif // H2LOAD_DECODE_H
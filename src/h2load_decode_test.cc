@@ -0,0 +1,107 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_decode_test.h"
+
+#include <algorithm>
+#include <array>
+#include <string>
+
+#include <CUnit/CUnit.h>
+
+#include "h2load_decode.h"
+
+namespace h2load {
+
+namespace {
+ContentCoding coding(const std::string &s) {
+    return parse_content_coding(reinterpret_cast<const uint8_t *>(s.c_str()),
+                                s.size());
+}
+} // namespace
+
+void test_decode_content_coding(void) {
+    CU_ASSERT(CODING_IDENTITY == coding(""));
+    CU_ASSERT(CODING_IDENTITY == coding("identity"));
+    CU_ASSERT(CODING_GZIP == coding(" GZIP "));
+    CU_ASSERT(CODING_GZIP == coding("x-gzip"));
+    CU_ASSERT(CODING_DEFLATE == coding("deflate"));
+    CU_ASSERT(CODING_BR == coding("br"));
+    CU_ASSERT(CODING_ZSTD == coding("zstd"));
+    CU_ASSERT(CODING_OTHER == coding("gzip, br"));
+}
+
+namespace {
+// Returns |s| compressed with zlib |window_bits|.
+std::string compress(const std::string &s, int window_bits) {
+    z_stream zst{};
+    deflateInit2(&zst, Z_DEFAULT_COMPRESSION, Z_DEFLATED, window_bits, 8,
+                 Z_DEFAULT_STRATEGY);
+    std::string out(deflateBound(&zst, s.size()) + 32, '\0');
+    zst.next_in =
+        reinterpret_cast<uint8_t *>(const_cast<char *>(s.c_str()));
+    zst.avail_in = s.size();
+    zst.next_out = reinterpret_cast<uint8_t *>(&out[0]);
+    zst.avail_out = out.size();
+    deflate(&zst, Z_FINISH);
+    out.resize(out.size() - zst.avail_out);
+    deflateEnd(&zst);
+    return out;
+}
+} // namespace
+
+void test_decode_inflate(void) {
+    std::string body;
+    for (size_t i = 0; i < 10000; ++i) {
+        body += "sofaload ";
+        body += std::to_string(i);
+    }
+
+    std::array<uint8_t, DECODE_BUFFER_SIZE> buf;
+    Inflater inflater;
+
+    // gzip, then deflate with the same inflater, fed in small pieces
+    for (auto window_bits : {MAX_WBITS + 16, MAX_WBITS}) {
+        auto z = compress(body, window_bits);
+        CU_ASSERT(0 == inflater.reset());
+        uint64_t decoded = 0;
+        auto p = reinterpret_cast<const uint8_t *>(z.c_str());
+        for (size_t i = 0; i < z.size(); i += 7) {
+            CU_ASSERT(0 == inflater.feed(p + i, std::min<size_t>(7, z.size() - i),
+                                         buf, decoded));
+        }
+        CU_ASSERT(inflater.finished());
+        CU_ASSERT(body.size() == decoded);
+    }
+
+    // A body which is not compressed
+    CU_ASSERT(0 == inflater.reset());
+    uint64_t decoded = 0;
+    CU_ASSERT(-1 == inflater.feed(reinterpret_cast<const uint8_t *>(
+                                      body.c_str()),
+                                  body.size(), buf, decoded));
+    CU_ASSERT(!inflater.finished());
+}
+
+} // namespace h2load
@@ -0,0 +1,750 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_dist.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+#include "h2load.h"
+#include "util.h"
+
+using namespace nghttp2;
+
+namespace h2load {
+
+namespace {
+// The largest message either side accepts
+constexpr uint32_t MAX_MESSAGE_LEN = 64 * 1024 * 1024;
+// The seconds an agent waits for a RunSpec after a coordinator
+// connects
+constexpr time_t RUN_SPEC_TIMEOUT = 10;
+} // namespace
+
+AgentResult::AgentResult(size_t precision)
+    : total_req(0), duration(0.), rtt_hist(precision),
+      corrected_rtt_hist(precision) {}
+
+void WireWriter::u32(uint32_t n) {
+    for (int i = 24; i >= 0; i -= 8) {
+        buf_ += static_cast<char>(n >> i);
+    }
+}
+
+void WireWriter::u64(uint64_t n) {
+    u32(n >> 32);
+    u32(n);
+}
+
+void WireWriter::f64(double v) {
+    uint64_t n;
+    static_assert(sizeof(n) == sizeof(v), "double is not 64 bits");
+    memcpy(&n, &v, sizeof(n));
+    u64(n);
+}
+
+void WireWriter::str(const std::string &s) {
+    u32(s.size());
+    buf_ += s;
+}
+
+void WireWriter::histogram(const Histogram &h) {
+    u32(h.precision());
+    u64(h.min());
+    u64(h.max());
+    uint32_t n = 0;
+    for (size_t i = 0; i < h.nbuckets(); ++i) {
+        n += h.bucket_count(i) != 0;
+    }
+    // Most buckets are empty.
+    u32(n);
+    for (size_t i = 0; i < h.nbuckets(); ++i) {
+        if (h.bucket_count(i)) {
+            u32(i);
+            u64(h.bucket_count(i));
+        }
+    }
+}
+
+void WireWriter::running_stat(const RunningStat &s) {
+    u64(s.count());
+    f64(s.mean());
+    f64(s.m2());
+    f64(s.min());
+    f64(s.max());
+    histogram(s.histogram());
+}
+
+WireReader::WireReader(const std::string &buf)
+    : pos_(reinterpret_cast<const uint8_t *>(buf.data())),
+      end_(pos_ + buf.size()), ok_(true) {}
+
+bool WireReader::has(size_t n) {
+    if (ok_ && static_cast<size_t>(end_ - pos_) >= n) {
+        return true;
+    }
+    ok_ = false;
+    return false;
+}
+
+uint32_t WireReader::u32() {
+    if (!has(4)) {
+        return 0;
+    }
+    auto n = util::get_uint32(pos_);
+    pos_ += 4;
+    return n;
+}
+
+uint64_t WireReader::u64() {
+    uint64_t hi = u32();
+    return hi << 32 | u32();
+}
+
+double WireReader::f64() {
+    auto n = u64();
+    double v;
+    memcpy(&v, &n, sizeof(v));
+    return v;
+}
+
+std::string WireReader::str() {
+    auto len = u32();
+    if (!has(len)) {
+        return {};
+    }
+    std::string s(reinterpret_cast<const char *>(pos_), len);
+    pos_ += len;
+    return s;
+}
+
+void WireReader::histogram(Histogram &h) {
+    auto precision = u32();
+    auto min = u64();
+    auto max = u64();
+    auto n = u32();
+    if (precision != h.precision()) {
+        ok_ = false;
+        return;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        auto idx = u32();
+        auto count = u64();
+        if (!ok_ || idx >= h.nbuckets()) {
+            ok_ = false;
+            return;
+        }
+        // min and max fall into the first and the last buckets.
+        h.record_bucket(idx, count, std::max(h.bucket_lowest(idx), min),
+                        std::min(h.bucket_highest(idx), max));
+    }
+}
+
+void WireReader::running_stat(RunningStat &s) {
+    auto n = u64();
+    auto mean = f64();
+    auto m2 = f64();
+    auto min = f64();
+    auto max = f64();
+    Histogram hist(s.histogram().precision());
+    histogram(hist);
+    if (ok_) {
+        s.merge(n, mean, m2, min, max, hist);
+    }
+}
+
+int parse_agent_addrs(std::vector<AgentAddr> &addrs, const std::string &spec) {
+    for (auto &ent : util::split_str(StringRef{spec}, ',')) {
+        AgentAddr addr;
+        StringRef port;
+        if (util::starts_with(ent, StringRef::from_lit("["))) {
+            auto rbracket = std::find(std::begin(ent), std::end(ent), ']');
+            if (rbracket == std::end(ent) || rbracket + 1 == std::end(ent) ||
+                rbracket[1] != ':') {
+                return -1;
+            }
+            addr.host.assign(std::begin(ent) + 1, rbracket);
+            port = StringRef{rbracket + 2, std::end(ent)};
+        } else {
+            auto colon = std::find(std::begin(ent), std::end(ent), ':');
+            if (colon == std::end(ent) ||
+                std::find(colon + 1, std::end(ent), ':') != std::end(ent)) {
+                return -1;
+            }
+            addr.host.assign(std::begin(ent), colon);
+            port = StringRef{colon + 1, std::end(ent)};
+        }
+        auto n = util::parse_uint(port);
+        if (addr.host.empty() || n < 1 ||
+            n > std::numeric_limits<uint16_t>::max()) {
+            return -1;
+        }
+        addr.port = n;
+        addrs.push_back(std::move(addr));
+    }
+
+    return addrs.empty() ? -1 : 0;
+}
+
+std::string format_agent_addr(const AgentAddr &addr) {
+    auto port = util::utos(addr.port);
+    if (addr.host.find(':') != std::string::npos) {
+        return "[" + addr.host + "]:" + port;
+    }
+    return addr.host + ":" + port;
+}
+
+void encode_run_spec(WireWriter &w, const RunSpec &spec) {
+    w.str(spec.token);
+    w.u32(spec.args.size());
+    for (auto &arg : spec.args) {
+        w.str(arg);
+    }
+    w.u64(spec.start_time);
+}
+
+int decode_run_spec(RunSpec &spec, const std::string &buf) {
+    WireReader r(buf);
+    spec.token = r.str();
+    auto n = r.u32();
+    for (size_t i = 0; i < n && r.ok(); ++i) {
+        spec.args.push_back(r.str());
+    }
+    spec.start_time = r.u64();
+    return r.ok() ? 0 : -1;
+}
+
+void encode_agent_result(WireWriter &w, const AgentResult &res,
+                         const Stats &stats) {
+    w.u64(res.total_req);
+    w.f64(res.duration);
+
+    for (auto n : {stats.req_started, stats.req_done, stats.req_success,
+                   stats.req_status_success, stats.req_failed, stats.req_error,
+                   stats.req_timedout}) {
+        w.u64(n);
+    }
+    for (auto n : {stats.bytes_total, stats.bytes_head, stats.bytes_head_decomp,
+                   stats.bytes_body, stats.bytes_sent}) {
+        w.u64(n);
+    }
+    for (auto n : stats.status) {
+        w.u64(n);
+    }
+    for (auto n : stats.sofarpcStatus) {
+        w.u64(n);
+    }
+    for (auto n : {stats.stream_stalls, stats.stream_stall_time,
+                   stats.conn_stalls, stats.conn_stall_time,
+                   stats.stream_messages, stats.write_blocks,
+                   stats.write_block_time, stats.churn_closes,
+                   stats.churn_lost}) {
+        w.u64(n);
+    }
+    w.u32(stats.max_stream_window);
+    w.u32(stats.max_conn_window);
+
+    w.running_stat(stats.request_times);
+    w.running_stat(stats.connect_times);
+    w.running_stat(stats.ttfb_times);
+    w.running_stat(stats.rps_values);
+
+    w.histogram(res.rtt_hist);
+    w.histogram(res.corrected_rtt_hist);
+}
+
+int decode_agent_result(AgentResult &res, Stats &stats,
+                        const std::string &buf) {
+    WireReader r(buf);
+    res.total_req = r.u64();
+    res.duration = r.f64();
+
+    for (auto p : {&stats.req_started, &stats.req_done, &stats.req_success,
+                   &stats.req_status_success, &stats.req_failed,
+                   &stats.req_error, &stats.req_timedout}) {
+        *p = r.u64();
+    }
+    for (auto p : {&stats.bytes_total, &stats.bytes_head,
+                   &stats.bytes_head_decomp, &stats.bytes_body,
+                   &stats.bytes_sent}) {
+        *p = r.u64();
+    }
+    for (auto &n : stats.status) {
+        n = r.u64();
+    }
+    for (auto &n : stats.sofarpcStatus) {
+        n = r.u64();
+    }
+    for (auto p : {&stats.stream_stalls, &stats.stream_stall_time,
+                   &stats.conn_stalls, &stats.conn_stall_time,
+                   &stats.stream_messages, &stats.write_blocks,
+                   &stats.write_block_time, &stats.churn_closes,
+                   &stats.churn_lost}) {
+        *p = r.u64();
+    }
+    stats.max_stream_window = r.u32();
+    stats.max_conn_window = r.u32();
+
+    r.running_stat(stats.request_times);
+    r.running_stat(stats.connect_times);
+    r.running_stat(stats.ttfb_times);
+    r.running_stat(stats.rps_values);
+
+    r.histogram(res.rtt_hist);
+    r.histogram(res.corrected_rtt_hist);
+
+    return r.ok() ? 0 : -1;
+}
+
+int write_message(int fd, const std::string &msg) {
+    WireWriter w;
+    w.u32(msg.size());
+    auto hd = w.buf();
+    for (auto &part : {std::cref(hd), std::cref(msg)}) {
+        auto &s = part.get();
+        for (size_t off = 0; off < s.size();) {
+            auto n = write(fd, s.data() + off, s.size() - off);
+            if (n == -1 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return -1;
+            }
+            off += n;
+        }
+    }
+    return 0;
+}
+
+namespace {
+// Reads exactly |len| bytes from |fd| into |buf|.  Returns 0 if it
+// succeeds, or -1.
+int read_full(int fd, char *buf, size_t len) {
+    for (size_t off = 0; off < len;) {
+        auto n = read(fd, buf + off, len - off);
+        if (n == -1 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return -1;
+        }
+        off += n;
+    }
+    return 0;
+}
+} // namespace
+
+int read_message(int fd, std::string &msg) {
+    std::array<char, 4> hd;
+    if (read_full(fd, hd.data(), hd.size()) != 0) {
+        return -1;
+    }
+    auto len = util::get_uint32(reinterpret_cast<const uint8_t *>(hd.data()));
+    if (len > MAX_MESSAGE_LEN) {
+        return -1;
+    }
+    msg.resize(len);
+    return read_full(fd, &msg[0], len);
+}
+
+namespace {
+// The long options an agent runs, and whether they take an argument
+// in the next word when it is not given with "="
+constexpr std::pair<const char *, bool> AGENT_LONG_OPTIONS[] = {
+    {"sofaRpcClassName", true},
+    {"sofaRpcHeader", true},
+    {"sofaRpcContent", true},
+    {"sofaRpcTimeout", true},
+    {"requests", true},
+    {"clients", true},
+    {"threads", true},
+    {"max-concurrent-streams", true},
+    {"header", true},
+    {"no-tls-proto", true},
+    {"verbose", false},
+    {"rate", true},
+    {"connection-active-timeout", true},
+    {"connection-inactivity-timeout", true},
+    {"duration", true},
+    {"rate-period", true},
+    {"h1", false},
+    {"header-table-size", true},
+    {"encoder-header-table-size", true},
+    {"warm-up-time", true},
+    {"qps", true},
+    {"latency-precision", true},
+    {"qps-arrival", true},
+    {"qps-burst", true},
+    {"timeline-interval", true},
+    {"percentiles", true},
+    {"slowest", true},
+    {"perf-counters", false},
+    {"io-uring", false},
+    {"batch-writes", false},
+    {"cpu-affinity", true},
+    {"busy-poll", false},
+    {"timestamping", false},
+    {"local-address", true},
+    {"local-ports", true},
+    {"endpoints", true},
+    {"endpoint-policy", true},
+    {"tls-resume", false},
+    {"handshake-bench", false},
+    {"ktls", false},
+    {"chunk-size", true},
+    {"hugepages", false},
+    {"pre-encode-headers", false},
+    {"ping-interval", true},
+    {"window-auto-tune", false},
+    {"connections-per-client", true},
+    {"h1-fast-parse", false},
+    {"bolt-version", true},
+    {"bolt-crc", false},
+    {"sofarpc-args", true},
+    {"mix", true},
+    {"oneway", false},
+    {"stream-messages", true},
+    {"stream-end-header", true},
+    {"aimd", false},
+    {"aimd-backoff", true},
+    {"request-timeout", true},
+    {"churn-requests", true},
+    {"churn-lifetime", true},
+    {"linger", true},
+    {"no-tcp-nodelay", false},
+    {"warm-up-auto", true},
+    {"warm-up-window", true},
+    {"warm-up-tolerance", true},
+    {"drain-time", true},
+    {"think-time", true},
+    {"ab", false},
+    {"response-sizes", false},
+    {"accept-encoding", true},
+    {"decode", false},
+    {"grpc", false},
+    {"reconnect", true},
+    {"reconnect-backoff", true},
+    {"stop-on", true},
+    {"stop-window", true},
+    {"imbalance", true},
+    {"sndbuf", true},
+    {"rcvbuf", true},
+    {"tcp-info", true},
+    {"ready", true},
+    {"ready-timeout", true},
+    {"hedge", true},
+    {"hedge-cancel", false},
+    {"retry", true},
+    {"slow-read", true},
+    {"slow-read-pause", true},
+    {"slow-readers", true},
+    {"slow-rcvbuf", true},
+    {"clock", true},
+    {"no-rfc7540-priorities", false},
+    {"shards", true},
+};
+
+// The short options an agent runs.  All of them take an argument.
+constexpr char AGENT_SHORT_OPTIONS[] = "nctmHprTNDeaokv";
+
+// The long options in AGENT_LONG_OPTIONS whose value names a file to
+// read if it starts with "@", which an agent refuses
+constexpr const char *AGENT_FILE_VALUE_OPTIONS[] = {"endpoints",
+                                                    "think-time"};
+} // namespace
+
+int check_run_args(const std::vector<std::string> &args, const char *opt) {
+    for (size_t i = 0; i < args.size(); ++i) {
+        auto &arg = args[i];
+        if (arg == "--") {
+            break;
+        }
+        if (arg.size() < 2 || arg[0] != '-') {
+            // A URI
+            continue;
+        }
+        if (arg[1] != '-') {
+            if (!strchr(AGENT_SHORT_OPTIONS, arg[1])) {
+                std::cerr << opt << ": option not allowed: " << arg
+                          << std::endl;
+                return -1;
+            }
+            if (arg.size() == 2) {
+                ++i;
+            }
+            continue;
+        }
+        auto eq = arg.find('=');
+        auto name = arg.substr(2, eq == std::string::npos ? eq : eq - 2);
+        auto it = std::find_if(
+            std::begin(AGENT_LONG_OPTIONS), std::end(AGENT_LONG_OPTIONS),
+            [&name](const std::pair<const char *, bool> &o) {
+                return name == o.first;
+            });
+        if (it == std::end(AGENT_LONG_OPTIONS)) {
+            std::cerr << opt << ": option not allowed: " << arg << std::endl;
+            return -1;
+        }
+        std::string value;
+        if (eq != std::string::npos) {
+            value = arg.substr(eq + 1);
+        } else if (it->second && i + 1 < args.size()) {
+            value = args[i + 1];
+        }
+        if (!value.empty() && value[0] == '@' &&
+            std::any_of(std::begin(AGENT_FILE_VALUE_OPTIONS),
+                        std::end(AGENT_FILE_VALUE_OPTIONS),
+                        [&name](const char *o) { return name == o; })) {
+            std::cerr << opt << ": file not allowed: " << arg << " " << value
+                      << std::endl;
+            return -1;
+        }
+        if (eq == std::string::npos && it->second) {
+            ++i;
+        }
+    }
+    return 0;
+}
+
+int connect_agent(const AgentAddr &addr) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *res;
+    auto service = util::utos(addr.port);
+    auto rv = getaddrinfo(addr.host.c_str(), service.c_str(), &hints, &res);
+    if (rv != 0) {
+        std::cerr << "--agents: cannot resolve " << addr.host << ": "
+                  << gai_strerror(rv) << std::endl;
+        return -1;
+    }
+
+    auto fd = -1;
+    for (auto ai = res; ai; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC,
+                    ai->ai_protocol);
+        if (fd == -1) {
+            continue;
+        }
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+            break;
+        }
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+
+    if (fd == -1) {
+        std::cerr << "--agents: cannot connect to " << format_agent_addr(addr)
+                  << ": " << strerror(errno) << std::endl;
+        return -1;
+    }
+
+    return fd;
+}
+
+pid_t spawn_run(const RunSpec &spec, int fd, bool quiet) {
+    auto agent_fd = "--agent-fd=" + util::utos(fd);
+    auto start_at = "--start-at=" + util::utos(spec.start_time);
+
+    std::vector<char *> argv;
+    argv.push_back(const_cast<char *>("sofaload"));
+    for (auto &arg : spec.args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    argv.push_back(&agent_fd[0]);
+    argv.push_back(&start_at[0]);
+    argv.push_back(nullptr);
+
+    auto pid = fork();
+    if (pid == -1) {
+        std::cerr << "cannot start a run: fork failed: " << strerror(errno)
+                  << std::endl;
+        return -1;
+    }
+    if (pid == 0) {
+        // |fd| may have been opened with SOCK_CLOEXEC.
+        fcntl(fd, F_SETFD, 0);
+        if (quiet) {
+            auto null = open("/dev/null", O_WRONLY);
+            if (null != -1) {
+                dup2(null, STDOUT_FILENO);
+                close(null);
+            }
+        }
+        execv("/proc/self/exe", argv.data());
+        std::cerr << "cannot start a run: exec failed: " << strerror(errno)
+                  << std::endl;
+        _exit(EXIT_FAILURE);
+    }
+
+    return pid;
+}
+
+namespace {
+// Returns true if |a| equals |b|, in a time which does not depend on
+// where they differ.
+bool token_equal(const std::string &a, const std::string &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    uint8_t d = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        d |= a[i] ^ b[i];
+    }
+    return d == 0;
+}
+} // namespace
+
+int run_agent(const std::string &bind_addr, uint16_t port,
+              const std::string &token) {
+    if (token.empty()) {
+        std::cerr << "--agent: needs --agent-token" << std::endl;
+        return -1;
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    addrinfo *res;
+    auto service = util::utos(port);
+    auto rv = getaddrinfo(bind_addr.c_str(), service.c_str(), &hints, &res);
+    if (rv != 0) {
+        std::cerr << "--agent-bind: cannot resolve " << bind_addr << ": "
+                  << gai_strerror(rv) << std::endl;
+        return -1;
+    }
+
+    auto lfd = socket(res->ai_family, res->ai_socktype | SOCK_CLOEXEC,
+                      res->ai_protocol);
+    if (lfd == -1) {
+        std::cerr << "--agent: cannot create socket: " << strerror(errno)
+                  << std::endl;
+        freeaddrinfo(res);
+        return -1;
+    }
+
+    int val = 1;
+    setsockopt(lfd, SOL_SOCKET, SO_REUSEADDR, &val, sizeof(val));
+    if (res->ai_family == AF_INET6) {
+        // Take IPv4 connections as well if bound to ::.
+        val = 0;
+        setsockopt(lfd, IPPROTO_IPV6, IPV6_V6ONLY, &val, sizeof(val));
+    }
+
+    if (bind(lfd, res->ai_addr, res->ai_addrlen) == -1 ||
+        listen(lfd, 16) == -1) {
+        std::cerr << "--agent: cannot listen on " << bind_addr << " port "
+                  << port << ": " << strerror(errno) << std::endl;
+        freeaddrinfo(res);
+        close(lfd);
+        return -1;
+    }
+    freeaddrinfo(res);
+
+    std::cout << "agent listening on " << bind_addr << " port " << port
+              << std::endl;
+
+    for (;;) {
+        sockaddr_storage peer;
+        socklen_t peerlen = sizeof(peer);
+        // Not SOCK_CLOEXEC, so that the run inherits it.
+        auto fd = accept(lfd, reinterpret_cast<sockaddr *>(&peer), &peerlen);
+        if (fd == -1) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            std::cerr << "--agent: accept failed: " << strerror(errno)
+                      << std::endl;
+            close(lfd);
+            return -1;
+        }
+
+        std::array<char, NI_MAXHOST> host;
+        if (getnameinfo(reinterpret_cast<sockaddr *>(&peer), peerlen,
+                        host.data(), host.size(), nullptr, 0,
+                        NI_NUMERICHOST) != 0) {
+            host[0] = '\0';
+        }
+
+        // Do not let a peer which sends nothing hold up the agent.
+        timeval tv{};
+        tv.tv_sec = RUN_SPEC_TIMEOUT;
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+        std::string msg;
+        RunSpec spec;
+        if (read_message(fd, msg) != 0 || decode_run_spec(spec, msg) != 0) {
+            std::cerr << "--agent: bad run spec from " << host.data()
+                      << std::endl;
+            close(fd);
+            continue;
+        }
+        if (!token_equal(spec.token, token)) {
+            std::cerr << "--agent: wrong token from " << host.data()
+                      << std::endl;
+            close(fd);
+            continue;
+        }
+        if (check_run_args(spec.args, "--agent") != 0) {
+            std::cerr << "--agent: run from " << host.data() << " refused"
+                      << std::endl;
+            close(fd);
+            continue;
+        }
+
+        std::cout << "run from " << host.data() << ":";
+        for (auto &arg : spec.args) {
+            std::cout << " " << arg;
+        }
+        std::cout << std::endl;
+
+        auto pid = spawn_run(spec, fd, false);
+        if (pid != -1) {
+            int status;
+            while (waitpid(pid, &status, 0) == -1 && errno == EINTR)
+                ;
+        }
+        close(fd);
+    }
+}
+
+} // namespace h2load
@@ -0,0 +1,176 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_DIST_H
+#define H2LOAD_DIST_H
+
+#include "nghttp2_config.h"
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "histogram.h"
+
+namespace h2load {
+
+struct Stats;
+
+// A coordinator and its agents talk over TCP in messages of a 4 byte
+// length followed by the payload, with integers in network byte
+// order.  The coordinator sends a RunSpec to each agent, and the agent
+// answers with an AgentResult once the run is over.  An agent only
+// runs a RunSpec which has its --agent-token, and whose arguments pass
+// check_run_args().
+
+// An agent given in --agents
+struct AgentAddr {
+    std::string host;
+    uint16_t port;
+};
+
+// The run a coordinator asks an agent for
+struct RunSpec {
+    // The secret shared by the coordinator and the agent
+    std::string token;
+    // The command line arguments to run sofaload with, without the
+    // program name
+    std::vector<std::string> args;
+    // The time in milliseconds since the epoch when the run starts
+    int64_t start_time;
+};
+
+// The result of a run, which an agent sends back.  The histograms
+// have the precision of --latency-precision, which the coordinator
+// passes on to the agents.
+struct AgentResult {
+    AgentResult(size_t precision);
+
+    // The requests the run was to make, as in the report
+    uint64_t total_req;
+    // The duration of the run in seconds
+    double duration;
+    nghttp2::Histogram rtt_hist;
+    nghttp2::Histogram corrected_rtt_hist;
+};
+
+// WireWriter serializes messages.
+class WireWriter {
+  public:
+    void u32(uint32_t n);
+    void u64(uint64_t n);
+    void f64(double v);
+    void str(const std::string &s);
+    void histogram(const nghttp2::Histogram &h);
+    void running_stat(const nghttp2::RunningStat &s);
+
+    const std::string &buf() const { return buf_; }
+
+  private:
+    std::string buf_;
+};
+
+// WireReader deserializes messages.  Reading past the end, or
+// anything malformed, makes ok() return false, and the reads return
+// 0 from then on.
+class WireReader {
+  public:
+    WireReader(const std::string &buf);
+    uint32_t u32();
+    uint64_t u64();
+    double f64();
+    std::string str();
+    // Reads into |h|, which must have the precision of the serialized
+    // one, and have nothing recorded.
+    void histogram(nghttp2::Histogram &h);
+    // Merges into |s|.
+    void running_stat(nghttp2::RunningStat &s);
+
+    bool ok() const { return ok_; }
+
+  private:
+    // Returns true if |n| more bytes can be read.
+    bool has(size_t n);
+
+    const uint8_t *pos_;
+    const uint8_t *end_;
+    bool ok_;
+};
+
+// Parses --agents, which is <HOST>:<PORT>[,<HOST>:<PORT>...], into
+// |addrs|.  IPv6 addresses must be enclosed in brackets.  Returns 0
+// if it succeeds, or -1.
+int parse_agent_addrs(std::vector<AgentAddr> &addrs, const std::string &spec);
+// Returns |addr| as it is written in --agents.
+std::string format_agent_addr(const AgentAddr &addr);
+
+void encode_run_spec(WireWriter &w, const RunSpec &spec);
+// Returns 0 if it succeeds, or -1.
+int decode_run_spec(RunSpec &spec, const std::string &buf);
+
+void encode_agent_result(WireWriter &w, const AgentResult &res,
+                         const Stats &stats);
+// Decodes an AgentResult into |res| and |stats|, which must be fresh.
+// Returns 0 if it succeeds, or -1.
+int decode_agent_result(AgentResult &res, Stats &stats,
+                        const std::string &buf);
+
+// Writes |msg| to |fd|, blocking.  Returns 0 if it succeeds, or -1.
+int write_message(int fd, const std::string &msg);
+// Reads a message from |fd| into |msg|, blocking.  Returns 0 if it
+// succeeds, or -1 if the connection failed or closed first.
+int read_message(int fd, std::string &msg);
+
+// Checks |args| of a RunSpec against the options an agent runs:
+// those which shape the load, and URIs.  Options which read or write
+// files, load code, listen or send elsewhere, or control agents are
+// rejected, and so is any option not known to be safe.  Returns 0 if
+// all are allowed, or -1 after printing the first which is not,
+// prefixed with |opt|.
+int check_run_args(const std::vector<std::string> &args, const char *opt);
+
+// Connects to |addr|, blocking.  Returns the socket, or -1 after
+// printing the error.
+int connect_agent(const AgentAddr &addr);
+
+// Starts |spec| in a child process of this executable, with the
+// arguments of the RunSpec, and --agent-fd and --start-at, which sends
+// the result to |fd| before it exits.  If |quiet| is true, the stdout
+// of the run is discarded.  Returns the process ID, or -1 after
+// printing the error.
+pid_t spawn_run(const RunSpec &spec, int fd, bool quiet);
+
+// Serves coordinators on |port| of |bind_addr| until it fails.  Each
+// RunSpec must carry |token|, which must not be empty, and pass
+// check_run_args().  A run is started with spawn_run(), and sends the
+// result over the connection.  Runs are served one at a time.  Returns
+// -1 after printing the error.
+int run_agent(const std::string &bind_addr, uint16_t port,
+              const std::string &token);
+
+} // namespace h2load
+
+#endif // H2LOAD_DIST_H
@@ -0,0 +1,171 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_dist_test.h"
+
+#include <cmath>
+
+#include <CUnit/CUnit.h>
+
+#include "h2load_dist.h"
+
+using namespace nghttp2;
+
+namespace h2load {
+
+void test_dist_run_spec(void) {
+    RunSpec spec;
+    spec.token = "s3cret";
+    spec.args = {"-c", "10", "", "http://localhost/"};
+    spec.start_time = 1700000000123;
+
+    WireWriter w;
+    encode_run_spec(w, spec);
+
+    RunSpec got;
+    CU_ASSERT(0 == decode_run_spec(got, w.buf()));
+    CU_ASSERT(spec.token == got.token);
+    CU_ASSERT(spec.args == got.args);
+    CU_ASSERT(spec.start_time == got.start_time);
+
+    // Truncated
+    RunSpec bad;
+    CU_ASSERT(-1 == decode_run_spec(bad, w.buf().substr(0, 10)));
+}
+
+void test_dist_check_run_args(void) {
+    CU_ASSERT(0 == check_run_args({"-c", "10", "-n10", "--qps=100", "--h1",
+                                   "--duration", "5", "http://localhost/"},
+                                  "--agent"));
+    // The argument of an allowed option is not an option.
+    CU_ASSERT(0 == check_run_args({"-H", "--plugin"}, "--agent"));
+    CU_ASSERT(0 == check_run_args({"--", "--plugin=x.so"}, "--agent"));
+
+    CU_ASSERT(-1 == check_run_args({"--plugin=x.so"}, "--agent"));
+    CU_ASSERT(-1 == check_run_args({"--plugin", "x.so"}, "--agent"));
+    CU_ASSERT(-1 == check_run_args({"--output=/etc/passwd"}, "--agent"));
+    CU_ASSERT(-1 == check_run_args({"-i", "/etc/passwd"}, "--agent"));
+    CU_ASSERT(-1 == check_run_args({"-d/etc/passwd"}, "--agent"));
+    CU_ASSERT(-1 == check_run_args({"--agent=7000"}, "--agent"));
+    // Values which name files are refused, and the others are not.
+    CU_ASSERT(-1 == check_run_args({"--endpoints=@/etc/passwd"}, "--agent"));
+    CU_ASSERT(-1 == check_run_args({"--endpoints", "@/etc/passwd"},
+                                   "--agent"));
+    CU_ASSERT(-1 == check_run_args({"--think-time=@/etc/passwd"}, "--agent"));
+    CU_ASSERT(-1 == check_run_args({"--think-time", "@/etc/passwd"},
+                                   "--agent"));
+    CU_ASSERT(0 == check_run_args({"--endpoints=a:80,b:80",
+                                   "--think-time", "100ms"},
+                                  "--agent"));
+    // Abbreviations are not known to be safe.
+    CU_ASSERT(-1 == check_run_args({"--out=x"}, "--agent"));
+}
+
+void test_dist_histogram(void) {
+    Histogram h(7);
+    for (uint64_t v : {1, 100, 100, 12345, 987654321}) {
+        h.record(v);
+    }
+
+    WireWriter w;
+    w.histogram(h);
+
+    {
+        Histogram got(7);
+        WireReader r(w.buf());
+        r.histogram(got);
+        CU_ASSERT(r.ok());
+        CU_ASSERT(h.count() == got.count());
+        CU_ASSERT(h.min() == got.min());
+        CU_ASSERT(h.max() == got.max());
+        for (auto p : {50., 90., 99.}) {
+            CU_ASSERT(h.value_at_percentile(p) ==
+                      got.value_at_percentile(p));
+        }
+    }
+
+    {
+        // Precision mismatch
+        Histogram got(6);
+        WireReader r(w.buf());
+        r.histogram(got);
+        CU_ASSERT(!r.ok());
+    }
+
+    {
+        // Empty
+        WireWriter w;
+        w.histogram(Histogram(7));
+        Histogram got(7);
+        WireReader r(w.buf());
+        r.histogram(got);
+        CU_ASSERT(r.ok());
+        CU_ASSERT(0 == got.count());
+    }
+}
+
+void test_dist_running_stat(void) {
+    RunningStat a(1e9), b(1e9), all(1e9);
+    for (auto v : {0.001, 0.002, 0.004}) {
+        a.add(v);
+        all.add(v);
+    }
+    for (auto v : {0.010, 0.020}) {
+        b.add(v);
+        all.add(v);
+    }
+
+    WireWriter w;
+    w.running_stat(b);
+
+    WireReader r(w.buf());
+    r.running_stat(a);
+    CU_ASSERT(r.ok());
+    CU_ASSERT(all.count() == a.count());
+    CU_ASSERT(all.min() == a.min());
+    CU_ASSERT(all.max() == a.max());
+    CU_ASSERT(std::abs(all.mean() - a.mean()) < 1e-12);
+    CU_ASSERT(std::abs(all.sd(false) - a.sd(false)) < 1e-12);
+}
+
+void test_dist_parse_agent_addrs(void) {
+    {
+        std::vector<AgentAddr> addrs;
+        CU_ASSERT(0 == parse_agent_addrs(addrs, "gen1:7000,[::1]:7001"));
+        CU_ASSERT(2 == addrs.size());
+        CU_ASSERT("gen1" == addrs[0].host);
+        CU_ASSERT(7000 == addrs[0].port);
+        CU_ASSERT("::1" == addrs[1].host);
+        CU_ASSERT(7001 == addrs[1].port);
+        CU_ASSERT("[::1]:7001" == format_agent_addr(addrs[1]));
+    }
+
+    for (auto bad : {"", "gen1", "gen1:", ":7000", "gen1:0", "gen1:65536",
+                     "::1:7000", "[::1]7000", "[::1]", "gen1:7000,"}) {
+        std::vector<AgentAddr> addrs;
+        CU_ASSERT(-1 == parse_agent_addrs(addrs, bad));
+    }
+}
+
+} // namespace h2load
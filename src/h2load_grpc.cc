@@ -0,0 +1,142 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_grpc.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include "util.h"
+
+using namespace nghttp2;
+
+namespace h2load {
+
+std::string make_grpc_message(const uint8_t *message, size_t len) {
+    std::string body(GRPC_PREFIX_LEN, '\0');
+    body[1] = static_cast<char>(len >> 24);
+    body[2] = static_cast<char>(len >> 16);
+    body[3] = static_cast<char>(len >> 8);
+    body[4] = static_cast<char>(len);
+    body.append(reinterpret_cast<const char *>(message), len);
+    return body;
+}
+
+int make_grpc_request(GrpcRequest &req, const SofaRpcSpec &spec) {
+    if (!spec.content_args.empty()) {
+        std::cerr << "--grpc: " << spec.method
+                  << ": args make Hessian content; give the serialized "
+                     "message in content, content-hex or content-file"
+                  << std::endl;
+        return -1;
+    }
+
+    std::string message;
+    if (spec.content_file.empty()) {
+        message = spec.content;
+    } else {
+        std::ifstream f(spec.content_file, std::ios::binary);
+        if (!f) {
+            std::cerr << "--grpc: cannot open " << spec.content_file
+                      << std::endl;
+            return -1;
+        }
+        message.assign(std::istreambuf_iterator<char>(f),
+                       std::istreambuf_iterator<char>());
+    }
+
+    if (message.size() > 0xffffffffu) {
+        std::cerr << "--grpc: " << spec.method << ": content is too large"
+                  << std::endl;
+        return -1;
+    }
+
+    auto colon = spec.service.find(':');
+    req.path = "/";
+    req.path += spec.service.substr(0, colon);
+    req.path += '/';
+    req.path += spec.method;
+    req.timeout = util::utos(spec.timeout) + "m";
+    req.metadata.clear();
+    if (colon != std::string::npos) {
+        req.metadata.emplace_back("tri-service-version",
+                                  spec.service.substr(colon + 1));
+    }
+    for (auto &kv : spec.headers) {
+        if (kv.first == "service" || kv.first == "sofa_head_target_service" ||
+            kv.first == "sofa_head_method_name") {
+            continue;
+        }
+        req.metadata.emplace_back(kv.first, kv.second);
+        util::inp_strlower(req.metadata.back().first);
+    }
+    req.body = make_grpc_message(
+        reinterpret_cast<const uint8_t *>(message.data()), message.size());
+
+    return 0;
+}
+
+size_t parse_grpc_status(const uint8_t *value, size_t len) {
+    if (len == 0 || len > 2) {
+        return GRPC_STATUS_MAX;
+    }
+    size_t code = 0;
+    for (size_t i = 0; i < len; ++i) {
+        if (!util::is_digit(value[i])) {
+            return GRPC_STATUS_MAX;
+        }
+        code = code * 10 + (value[i] - '0');
+    }
+    return std::min(code, GRPC_STATUS_MAX);
+}
+
+const char *grpc_status_name(size_t code) {
+    static constexpr const char *names[] = {
+        "ok",
+        "cancelled",
+        "unknown",
+        "invalid_argument",
+        "deadline_exceeded",
+        "not_found",
+        "already_exists",
+        "permission_denied",
+        "resource_exhausted",
+        "failed_precondition",
+        "aborted",
+        "out_of_range",
+        "unimplemented",
+        "internal",
+        "unavailable",
+        "data_loss",
+        "unauthenticated",
+    };
+    if (code < GRPC_STATUS_MAX) {
+        return names[code];
+    }
+    return "missing";
+}
+
+} // namespace h2load
@@ -0,0 +1,83 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_GRPC_H
+#define H2LOAD_GRPC_H
+
+#include "nghttp2_config.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "h2load_sofarpc_spec.h"
+
+namespace h2load {
+
+// The length of the prefix of a gRPC message: a compressed flag and
+// a 4 bytes length
+constexpr size_t GRPC_PREFIX_LEN = 5;
+
+// The gRPC status codes are in [0, GRPC_STATUS_MAX).  A response
+// without grpc-status, or with a value out of the range, is counted
+// as GRPC_STATUS_MAX.
+constexpr size_t GRPC_STATUS_MAX = 17;
+
+// A gRPC call of --grpc, made once at startup from a request of
+// --sofarpc-spec or from a URI.
+struct GrpcRequest {
+    // /<service>/<method>
+    std::string path;
+    // The value of grpc-timeout, or empty
+    std::string timeout;
+    // Custom metadata, with lower case keys
+    std::vector<std::pair<std::string, std::string>> metadata;
+    // The request message with its prefix
+    std::string body;
+};
+
+// Returns |message| of |len| bytes framed as an uncompressed gRPC
+// message.
+std::string make_grpc_message(const uint8_t *message, size_t len);
+
+// Makes |req| from |spec|.  The service version after ':' in the
+// service name goes to tri-service-version, as SOFARPC Triple clients
+// send it, and the header map entries other than those Bolt needs
+// become metadata.  The content must be a serialized message, not
+// argument shapes.  Returns 0 if it succeeds, or -1 after printing the
+// error.
+int make_grpc_request(GrpcRequest &req, const SofaRpcSpec &spec);
+
+// Returns the status code in grpc-status value |value| of |len|
+// bytes, or GRPC_STATUS_MAX if it is not a known code.
+size_t parse_grpc_status(const uint8_t *value, size_t len);
+
+// Returns the name of gRPC status code |code|.
+const char *grpc_status_name(size_t code);
+
+} // namespace h2load
+
+#endif // H2LOAD_GRPC_H
@@ -0,0 +1,89 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_grpc_test.h"
+
+#include <string>
+
+#include <CUnit/CUnit.h>
+
+#include "h2load_grpc.h"
+
+namespace h2load {
+
+void test_grpc_message(void) {
+    std::string msg(300, 'x');
+    auto body = make_grpc_message(
+        reinterpret_cast<const uint8_t *>(msg.data()), msg.size());
+    CU_ASSERT(GRPC_PREFIX_LEN + 300 == body.size());
+    CU_ASSERT(std::string("\x00\x00\x00\x01\x2c", 5) == body.substr(0, 5));
+    CU_ASSERT(msg == body.substr(5));
+
+    CU_ASSERT(std::string(5, '\0') == make_grpc_message(nullptr, 0));
+}
+
+void test_grpc_request(void) {
+    SofaRpcSpec spec;
+    spec.headers.clear();
+    spec.service = "com.alipay.test.TestService:1.0";
+    spec.method = "echo";
+    spec.headers.emplace_back("service", spec.service);
+    spec.headers.emplace_back("sofa_head_method_name", spec.method);
+    spec.headers.emplace_back("Rpc-Trace", "1");
+    spec.timeout = 300;
+    spec.content = "\x0a\x02hi";
+
+    GrpcRequest req;
+    CU_ASSERT(0 == make_grpc_request(req, spec));
+    CU_ASSERT("/com.alipay.test.TestService/echo" == req.path);
+    CU_ASSERT("300m" == req.timeout);
+    CU_ASSERT(2 == req.metadata.size());
+    CU_ASSERT("tri-service-version" == req.metadata[0].first);
+    CU_ASSERT("1.0" == req.metadata[0].second);
+    CU_ASSERT("rpc-trace" == req.metadata[1].first);
+    CU_ASSERT(std::string("\x00\x00\x00\x00\x04\x0a\x02hi", 9) == req.body);
+
+    spec.content_args = "s";
+    CU_ASSERT(-1 == make_grpc_request(req, spec));
+}
+
+namespace {
+size_t status(const std::string &s) {
+    return parse_grpc_status(reinterpret_cast<const uint8_t *>(s.data()),
+                             s.size());
+}
+} // namespace
+
+void test_grpc_status(void) {
+    CU_ASSERT(0 == status("0"));
+    CU_ASSERT(14 == status("14"));
+    CU_ASSERT(GRPC_STATUS_MAX == status("17"));
+    CU_ASSERT(GRPC_STATUS_MAX == status(""));
+    CU_ASSERT(GRPC_STATUS_MAX == status("1x"));
+    CU_ASSERT(GRPC_STATUS_MAX == status("100"));
+    CU_ASSERT(std::string("unavailable") == grpc_status_name(14));
+    CU_ASSERT(std::string("missing") == grpc_status_name(GRPC_STATUS_MAX));
+}
+
+} // namespace h2load
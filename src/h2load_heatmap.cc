@@ -0,0 +1,145 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_heatmap.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+using namespace nghttp2;
+
+namespace h2load {
+
+Heatmap::Heatmap(double slice, size_t precision, size_t max_slices)
+    : buckets_(precision), slice_(slice), max_slices_(max_slices) {
+    assert(slice > 0.);
+    assert(max_slices >= 2 && max_slices % 2 == 0);
+}
+
+void Heatmap::Row::add(size_t idx, uint64_t n) {
+    if (counts.empty()) {
+        first = idx;
+        counts.push_back(n);
+        return;
+    }
+    if (idx < first) {
+        counts.insert(std::begin(counts), first - idx, 0);
+        first = idx;
+    } else if (idx >= first + counts.size()) {
+        counts.resize(idx - first + 1);
+    }
+    counts[idx - first] += n;
+}
+
+void Heatmap::add(double t, const Histogram &hist) {
+    assert(hist.precision() >= buckets_.precision());
+
+    if (hist.count() == 0) {
+        return;
+    }
+
+    auto i = static_cast<size_t>(std::max(t, 0.) / slice_);
+    while (i >= max_slices_) {
+        coarsen();
+        i /= 2;
+    }
+    if (rows_.size() <= i) {
+        rows_.resize(i + 1);
+    }
+
+    auto &row = rows_[i];
+    // A bucket of |hist| lies within a single bucket of the heatmap,
+    // because each power of 2 range is divided into fewer buckets.
+    // Only the range between the smallest and the largest values
+    // recorded is visited.
+    auto last = hist.bucket_index(hist.max());
+    for (auto idx = hist.bucket_index(hist.min()); idx <= last; ++idx) {
+        auto n = hist.bucket_count(idx);
+        if (n) {
+            row.add(buckets_.bucket_index(hist.bucket_lowest(idx)), n);
+        }
+    }
+}
+
+void Heatmap::coarsen() {
+    std::vector<Row> rows((rows_.size() + 1) / 2);
+    for (size_t i = 0; i < rows_.size(); ++i) {
+        auto &src = rows_[i];
+        for (size_t j = 0; j < src.counts.size(); ++j) {
+            if (src.counts[j]) {
+                rows[i / 2].add(src.first + j, src.counts[j]);
+            }
+        }
+    }
+    rows_ = std::move(rows);
+    slice_ *= 2;
+}
+
+uint64_t Heatmap::count(size_t i, size_t idx) const {
+    if (i >= rows_.size()) {
+        return 0;
+    }
+    auto &row = rows_[i];
+    if (idx < row.first || idx >= row.first + row.counts.size()) {
+        return 0;
+    }
+    return row.counts[idx - row.first];
+}
+
+void Heatmap::write_json(std::ostream &out) const {
+    // The columns span the buckets any slice has counts in.
+    size_t lo = SIZE_MAX, hi = 0;
+    for (auto &row : rows_) {
+        if (!row.counts.empty()) {
+            lo = std::min(lo, row.first);
+            hi = std::max(hi, row.first + row.counts.size());
+        }
+    }
+
+    out << "{\n  \"unit\": \"ns\",\n  \"slice\": " << slice_
+        << ",\n  \"precision\": " << buckets_.precision()
+        << ",\n  \"bounds\": [";
+    if (lo < hi) {
+        for (auto idx = lo; idx < hi; ++idx) {
+            out << buckets_.bucket_lowest(idx) << ", ";
+        }
+        out << buckets_.bucket_highest(hi - 1) + 1;
+    }
+    out << "],\n  \"counts\": [";
+    for (size_t i = 0; i < rows_.size(); ++i) {
+        out << (i ? ",\n    [" : "\n    [");
+        for (auto idx = lo; idx < hi; ++idx) {
+            if (idx != lo) {
+                out << ", ";
+            }
+            out << count(i, idx);
+        }
+        out << "]";
+    }
+    out << (rows_.empty() ? "]\n}\n" : "\n  ]\n}\n");
+}
+
+} // namespace h2load
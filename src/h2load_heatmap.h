@@ -0,0 +1,90 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_HEATMAP_H
+#define H2LOAD_HEATMAP_H
+
+#include "nghttp2_config.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "histogram.h"
+
+namespace h2load {
+
+// Heatmap keeps the latency distribution of each time slice of the
+// run, for --heatmap: a matrix of slices by the log-linear buckets of
+// a Histogram of its own precision.  A slice only stores the range of
+// buckets which has counts.  Once the run outgrows |max_slices|
+// slices, adjacent slices are merged pairwise and the slice width
+// doubles, so that memory stays bounded however long the run is.
+class Heatmap {
+  public:
+    // |max_slices| must be even, and at least 2.
+    Heatmap(double slice, size_t precision, size_t max_slices);
+
+    // Adds the values in |hist|, measured at |t| seconds since the
+    // start of the run.  |hist| must have no less precision than the
+    // heatmap.
+    void add(double t, const nghttp2::Histogram &hist);
+
+    // Writes the matrix to |out| in JSON.  "bounds" has the lowest
+    // value of each bucket column, followed by the highest value of
+    // the last one plus 1, and "counts" has a row for each slice.
+    void write_json(std::ostream &out) const;
+
+    // Returns the current slice width in seconds.
+    double slice() const { return slice_; }
+    size_t precision() const { return buckets_.precision(); }
+    size_t nslices() const { return rows_.size(); }
+    // Returns the number of values in bucket |idx| of slice |i|.
+    uint64_t count(size_t i, size_t idx) const;
+
+  private:
+    struct Row {
+        Row() : first(0) {}
+        // Adds |n| to bucket |idx|.
+        void add(size_t idx, uint64_t n);
+        // The bucket of counts[0]
+        size_t first;
+        std::vector<uint64_t> counts;
+    };
+
+    // Merges the slices pairwise, and doubles the slice width.
+    void coarsen();
+
+    std::vector<Row> rows_;
+    // Maps values to the buckets of the heatmap.  Nothing is recorded
+    // in it.
+    nghttp2::Histogram buckets_;
+    double slice_;
+    size_t max_slices_;
+};
+
+} // namespace h2load
+
+#endif // H2LOAD_HEATMAP_H
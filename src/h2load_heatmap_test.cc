@@ -0,0 +1,125 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_heatmap_test.h"
+
+#include <sstream>
+#include <string>
+
+#include <CUnit/CUnit.h>
+
+#include "h2load_heatmap.h"
+
+using namespace nghttp2;
+
+namespace h2load {
+
+void test_heatmap_add(void) {
+    Heatmap hm(1., 2, 8);
+    Histogram h(7);
+
+    // Nothing is added for an empty histogram.
+    hm.add(0.5, h);
+    CU_ASSERT(0 == hm.nslices());
+
+    h.record(5);
+    h.record(1000, 3);
+    h.record(1100);
+    hm.add(2.5, h);
+
+    CU_ASSERT(3 == hm.nslices());
+    CU_ASSERT(1 == hm.count(2, 5));
+    // 1000 and 1100 fall into neighboring buckets of precision 2,
+    // [896, 1023] and [1024, 1279].
+    Histogram b(2);
+    CU_ASSERT(b.bucket_index(1000) != b.bucket_index(1100));
+    CU_ASSERT(3 == hm.count(2, b.bucket_index(1000)));
+    CU_ASSERT(1 == hm.count(2, b.bucket_index(1100)));
+    CU_ASSERT(0 == hm.count(0, 5));
+    CU_ASSERT(0 == hm.count(7, 5));
+
+    // Adding to the same slice accumulates.
+    hm.add(2.9, h);
+    CU_ASSERT(2 == hm.count(2, 5));
+    CU_ASSERT(6 == hm.count(2, b.bucket_index(1000)));
+}
+
+void test_heatmap_coarsen(void) {
+    Heatmap hm(1., 3, 4);
+    Histogram h(3);
+    h.record(10);
+
+    for (size_t i = 0; i < 4; ++i) {
+        hm.add(i + 0.5, h);
+    }
+    CU_ASSERT(4 == hm.nslices());
+    CU_ASSERT(1. == hm.slice());
+
+    // The 5th second does not fit in 4 slices of 1s, so they become
+    // 2 slices of 2s, and the new one goes into the 3rd.
+    hm.add(4.5, h);
+    CU_ASSERT(2. == hm.slice());
+    CU_ASSERT(3 == hm.nslices());
+    CU_ASSERT(2 == hm.count(0, 10));
+    CU_ASSERT(2 == hm.count(1, 10));
+    CU_ASSERT(1 == hm.count(2, 10));
+
+    // Far beyond the end, it coarsens as many times as needed.
+    hm.add(60., h);
+    CU_ASSERT(16. == hm.slice());
+    CU_ASSERT(4 == hm.nslices());
+    CU_ASSERT(5 == hm.count(0, 10));
+    CU_ASSERT(1 == hm.count(3, 10));
+}
+
+void test_heatmap_write_json(void) {
+    {
+        Heatmap hm(1., 1, 4);
+        std::stringstream ss;
+        hm.write_json(ss);
+        CU_ASSERT("{\n  \"unit\": \"ns\",\n  \"slice\": 1,\n"
+                  "  \"precision\": 1,\n  \"bounds\": [],\n"
+                  "  \"counts\": []\n}\n" == ss.str());
+    }
+    {
+        Heatmap hm(0.5, 1, 4);
+        Histogram h(1);
+        h.record(2);
+        hm.add(0., h);
+        h.reset();
+        h.record(3, 2);
+        h.record(4);
+        hm.add(1., h);
+        std::stringstream ss;
+        hm.write_json(ss);
+        // Slice 1 is empty, and the columns are buckets 2, 3 and 4,
+        // the last of which holds [4, 5].
+        CU_ASSERT("{\n  \"unit\": \"ns\",\n  \"slice\": 0.5,\n"
+                  "  \"precision\": 1,\n  \"bounds\": [2, 3, 4, 6],\n"
+                  "  \"counts\": [\n    [1, 0, 0],\n    [0, 0, 0],\n"
+                  "    [0, 2, 1]\n  ]\n}\n" == ss.str());
+    }
+}
+
+} // namespace h2load
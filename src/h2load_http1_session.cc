@@ -31,6 +31,7 @@
 #include "template.h"
 #include "util.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
@@ -47,6 +48,8 @@ int htp_msg_begincb(llhttp_t *htp) {
         return -1;
     }
 
+    session->htp_busy_ = true;
+
     return 0;
 }
 } // namespace
@@ -71,34 +74,14 @@ namespace {
 // HTTP response message complete
 int htp_msg_completecb(llhttp_t *htp) {
     auto session = static_cast<Http1Session *>(htp->data);
-    auto client = session->get_client();
+
+    session->htp_busy_ = false;
 
     if (htp->status_code / 100 == 1) {
         return 0;
     }
 
-    client->final = llhttp_should_keep_alive(htp) == 0;
-    auto req_stat = client->get_req_stat(session->stream_resp_counter_);
-
-    assert(req_stat);
-
-    auto config = client->worker->config;
-    if (req_stat->data_offset >= config->data_length) {
-        client->on_stream_close(session->stream_resp_counter_, true,
-                                client->final);
-    }
-
-    session->stream_resp_counter_ += 2;
-
-    if (client->final) {
-        session->stream_req_counter_ = session->stream_resp_counter_;
-
-        // Connection is going down.  If we have still request to do,
-        // create new connection and keep on doing the job.
-        // if (client->req_left) {
-            client->try_new_connection();
-        // }
-
+    if (session->on_response_complete(llhttp_should_keep_alive(htp)) != 0) {
         return HPE_PAUSED;
     }
 
@@ -113,6 +96,16 @@ int htp_hdr_keycb(llhttp_t *htp, const char *data, size_t len) {
 
     client->worker->stats.bytes_head += len;
     client->worker->stats.bytes_head_decomp += len;
+    if (client->worker->config->response_sizes) {
+        client->on_response_bytes(session->stream_resp_counter_, len, len, 0,
+                                  0);
+    }
+    if (client->worker->config->count_codings()) {
+        if (session->hdr_in_value_) {
+            session->on_header_end();
+        }
+        session->hdr_name_.append(data, len);
+    }
     return 0;
 }
 } // namespace
@@ -124,12 +117,28 @@ int htp_hdr_valcb(llhttp_t *htp, const char *data, size_t len) {
 
     client->worker->stats.bytes_head += len;
     client->worker->stats.bytes_head_decomp += len;
+    if (client->worker->config->response_sizes) {
+        client->on_response_bytes(session->stream_resp_counter_, len, len, 0,
+                                  0);
+    }
+    if (client->worker->config->count_codings()) {
+        session->hdr_in_value_ = true;
+        if (util::strieq_l("content-encoding", session->hdr_name_)) {
+            session->hdr_value_.append(data, len);
+        }
+    }
     return 0;
 }
 } // namespace
 
 namespace {
 int htp_hdrs_completecb(llhttp_t *htp) {
+    auto session = static_cast<Http1Session *>(htp->data);
+
+    if (session->hdr_in_value_) {
+        session->on_header_end();
+    }
+
     return !http2::expect_response_body(htp->status_code);
 }
 } // namespace
@@ -141,6 +150,16 @@ int htp_body_cb(llhttp_t *htp, const char *data, size_t len) {
 
     client->record_ttfb();
     client->worker->stats.bytes_body += len;
+    if (client->worker->config->response_sizes) {
+        // The bytes on the wire leave out the status line and the
+        // framing of chunks which llhttp parses.
+        client->on_response_bytes(session->stream_resp_counter_, len, 0, 0,
+                                  len);
+    }
+    if (client->worker->config->count_codings()) {
+        client->on_body(session->stream_resp_counter_,
+                        reinterpret_cast<const uint8_t *>(data), len);
+    }
 
     return 0;
 }
@@ -162,14 +181,28 @@ constexpr llhttp_settings_t htp_hooks = {
 } // namespace
 
 Http1Session::Http1Session(Client *client)
-    : stream_req_counter_(1), stream_resp_counter_(1), client_(client), htp_(),
-      complete_(false) {
+    : Session(SessionKind::HTTP1), stream_req_counter_(1),
+      stream_resp_counter_(1), htp_busy_(false), hdr_in_value_(false),
+      client_(client), htp_(),
+      body_left_(0), keep_alive_(true), complete_(false) {
     llhttp_init(&htp_, HTTP_RESPONSE, &htp_hooks);
     htp_.data = this;
 }
 
 Http1Session::~Http1Session() {}
 
+void Http1Session::on_header_end() {
+    if (!hdr_value_.empty()) {
+        client_->on_content_encoding(
+            stream_resp_counter_,
+            reinterpret_cast<const uint8_t *>(hdr_value_.data()),
+            hdr_value_.size());
+    }
+    hdr_name_.clear();
+    hdr_value_.clear();
+    hdr_in_value_ = false;
+}
+
 void Http1Session::on_connect() {
     // std::cout << "on_connect" << std::endl;
     client_->signal_write();
@@ -179,19 +212,25 @@ int Http1Session::submit_request() {
     // std::cout << "submit_request" << std::endl;
 
     auto config = client_->worker->config;
-    const auto &req = config->h1reqs[client_->reqidx];
-    client_->reqidx++;
+    auto tmpl = client_->next_template(config->h1reqs.size());
+    const auto &req = config->h1reqs[tmpl];
 
-    if (client_->reqidx == config->h1reqs.size()) {
-        client_->reqidx = 0;
-    }
-
-    client_->on_request(stream_req_counter_);
+    client_->on_request(stream_req_counter_, tmpl);
 
     auto req_stat = client_->get_req_stat(stream_req_counter_);
 
+    auto &slots = config->h1req_slots[tmpl];
+    if (slots.empty()) {
+        client_->wb.append(req);
+    } else {
+        client_->worker->subst.next();
+        client_->append_subst(reinterpret_cast<const uint8_t *>(req.c_str()),
+                              req.size(), slots);
+    }
+
+    // After the slots are filled, so that the time a --plugin takes
+    // is not counted.
     client_->record_request_time(req_stat);
-    client_->wb.append(req);
 
     if (config->data_fd == -1 || config->data_length == 0) {
         // increment for next request
@@ -203,8 +242,231 @@ int Http1Session::submit_request() {
     return on_write();
 }
 
-int Http1Session::on_read(const uint8_t *data, size_t len) {
-    // std::cout << "on_read" << std::endl;
+int Http1Session::on_response_complete(bool keep_alive) {
+    client_->final = !keep_alive;
+    auto req_stat = client_->get_req_stat(stream_resp_counter_);
+
+    assert(req_stat);
+
+    auto config = client_->worker->config;
+    if (req_stat->data_offset >= config->data_length) {
+        client_->on_stream_close(stream_resp_counter_, true, client_->final);
+    }
+
+    stream_resp_counter_ += 2;
+
+    if (client_->final) {
+        stream_req_counter_ = stream_resp_counter_;
+
+        // Connection is going down.  If we have still request to do,
+        // create new connection and keep on doing the job.
+        client_->try_new_connection();
+
+        return -1;
+    }
+
+    return 0;
+}
+
+namespace {
+// The longest header block --h1-fast-parse buffers when it arrives in
+// pieces.  A longer one goes to llhttp.
+constexpr size_t FAST_PARSE_MAX_HEADER = 8_k;
+} // namespace
+
+ssize_t Http1Session::fast_parse_header(const char *hd, size_t hdlen) {
+    // Only "HTTP/1.1 NNN" responses with Content-Length are handled.
+    // The others, such as chunked ones, go to llhttp.
+    if (hdlen < 16 || !util::starts_with(hd, hd + hdlen, "HTTP/1.1 ",
+                                         "HTTP/1.1 " + 9)) {
+        return 0;
+    }
+
+    int status = 0;
+    for (size_t i = 9; i < 12; ++i) {
+        if (!util::is_digit(hd[i])) {
+            return 0;
+        }
+        status = status * 10 + (hd[i] - '0');
+    }
+
+    if (status / 100 == 1 || (hd[12] != ' ' && hd[12] != '\r')) {
+        return 0;
+    }
+
+    auto last = hd + hdlen;
+    auto p = static_cast<const char *>(memchr(hd, '\n', hdlen)) + 1;
+    int64_t content_length = -1;
+    auto keep_alive = true;
+    int64_t header_bytes = 0;
+    StringRef encoding;
+
+    // |hd| ends with the empty line.
+    for (; last - p > 2;) {
+        auto eol = static_cast<const char *>(memchr(p, '\n', last - p));
+        if (eol == nullptr || eol[-1] != '\r' || *p == ' ' || *p == '\t') {
+            return 0;
+        }
+        auto colon = static_cast<const char *>(memchr(p, ':', eol - p));
+        if (colon == nullptr) {
+            return 0;
+        }
+        auto v = colon + 1;
+        for (; *v == ' ' || *v == '\t'; ++v)
+            ;
+        auto vend = eol - 1;
+        for (; vend > v && (vend[-1] == ' ' || vend[-1] == '\t'); --vend)
+            ;
+        auto namelen = static_cast<size_t>(colon - p);
+        header_bytes += namelen + (vend - v);
+
+        if (util::strieq_l("content-length", p, namelen)) {
+            if (content_length != -1 || v == vend) {
+                return 0;
+            }
+            content_length = 0;
+            for (; v != vend; ++v) {
+                if (!util::is_digit(*v) ||
+                    content_length > (std::numeric_limits<int64_t>::max() -
+                                      9) / 10) {
+                    return 0;
+                }
+                content_length = content_length * 10 + (*v - '0');
+            }
+        } else if (util::strieq_l("transfer-encoding", p, namelen)) {
+            return 0;
+        } else if (util::strieq_l("connection", p, namelen)) {
+            keep_alive =
+                !util::strifind(StringRef{v, vend}, StringRef::from_lit("close"));
+        } else if (util::strieq_l("content-encoding", p, namelen)) {
+            encoding = StringRef{v, vend};
+        }
+
+        p = eol + 1;
+    }
+
+    if (!http2::expect_response_body(status)) {
+        content_length = 0;
+    } else if (content_length == -1) {
+        return 0;
+    }
+
+    if (stream_resp_counter_ > stream_req_counter_) {
+        return -1;
+    }
+
+    client_->on_status_code(stream_resp_counter_, status);
+    client_->worker->stats.bytes_head += header_bytes;
+    client_->worker->stats.bytes_head_decomp += header_bytes;
+    if (client_->worker->config->response_sizes) {
+        client_->on_response_bytes(stream_resp_counter_,
+                                   hdlen + content_length, header_bytes, 0,
+                                   content_length);
+    }
+    if (client_->worker->config->count_codings() && !encoding.empty()) {
+        client_->on_content_encoding(stream_resp_counter_, encoding.byte(),
+                                     encoding.size());
+    }
+
+    body_left_ = content_length;
+    keep_alive_ = keep_alive;
+
+    return hdlen;
+}
+
+int Http1Session::fast_parse(const uint8_t *data, size_t len) {
+    auto first = reinterpret_cast<const char *>(data);
+    auto last = first + len;
+
+    // llhttp takes over whenever it is in the middle of a message, and
+    // gives the connection back at the next message boundary.
+    while (first != last && !htp_busy_) {
+        if (body_left_ > 0) {
+            auto n = std::min(body_left_, static_cast<int64_t>(last - first));
+            if (client_->worker->config->count_codings()) {
+                client_->on_body(stream_resp_counter_,
+                                 reinterpret_cast<const uint8_t *>(first), n);
+            }
+            first += n;
+            body_left_ -= n;
+            client_->record_ttfb();
+            client_->worker->stats.bytes_body += n;
+
+            if (body_left_ > 0) {
+                break;
+            }
+
+            if (on_response_complete(keep_alive_) != 0) {
+                return -1;
+            }
+
+            continue;
+        }
+
+        ssize_t rv;
+
+        auto end = hdbuf_.empty()
+                       ? std::search(first, last, "\r\n\r\n", "\r\n\r\n" + 4)
+                       : last;
+        if (end != last) {
+            rv = fast_parse_header(first, end + 4 - first);
+            if (rv < 0) {
+                return -1;
+            }
+            if (rv == 0) {
+                break;
+            }
+            first += rv;
+        } else {
+            // The header block is split across reads.  Keep the part
+            // we have got so far.
+            auto oldlen = hdbuf_.size();
+            auto n = std::min(static_cast<size_t>(last - first),
+                              FAST_PARSE_MAX_HEADER + 1 - oldlen);
+            hdbuf_.append(first, n);
+            auto pos = hdbuf_.find("\r\n\r\n", oldlen < 3 ? 0 : oldlen - 3);
+            if (pos == std::string::npos) {
+                first += n;
+                if (hdbuf_.size() <= FAST_PARSE_MAX_HEADER) {
+                    break;
+                }
+                rv = 0;
+            } else {
+                hdbuf_.resize(pos + 4);
+                first += hdbuf_.size() - oldlen;
+                rv = fast_parse_header(hdbuf_.data(), hdbuf_.size());
+                if (rv < 0) {
+                    return -1;
+                }
+            }
+
+            auto hb = std::move(hdbuf_);
+            hdbuf_.clear();
+
+            if (rv == 0 &&
+                parse(reinterpret_cast<const uint8_t *>(hb.data()),
+                      hb.size()) != 0) {
+                return -1;
+            }
+
+            if (rv == 0) {
+                continue;
+            }
+        }
+
+        if (body_left_ == 0 && on_response_complete(keep_alive_) != 0) {
+            return -1;
+        }
+    }
+
+    if (first == last) {
+        return 0;
+    }
+
+    return parse(reinterpret_cast<const uint8_t *>(first), last - first);
+}
+
+int Http1Session::parse(const uint8_t *data, size_t len) {
     auto htperr =
         llhttp_execute(&htp_, reinterpret_cast<const char *>(data), len);
     auto nread = htperr == HPE_OK
@@ -232,6 +494,14 @@ int Http1Session::on_read(const uint8_t *data, size_t len) {
     return 0;
 }
 
+int Http1Session::on_read(const uint8_t *data, size_t len) {
+    auto config = client_->worker->config;
+    if (config->h1_fast_parse && !config->verbose) {
+        return fast_parse(data, len);
+    }
+    return parse(data, len);
+}
+
 int Http1Session::on_write() {
     // std::cout << "on_write" << std::endl;
     if (complete_) {
@@ -245,27 +515,32 @@ int Http1Session::on_write() {
     }
 
     if (req_stat->data_offset < config->data_length) {
-        auto req_stat = client_->get_req_stat(stream_req_counter_);
         auto &wb = client_->wb;
 
-        // TODO unfortunately, wb has no interface to use with read(2)
-        // family functions.
-        std::array<uint8_t, 16_k> buf;
-
         ssize_t nread;
-        while ((nread = pread(config->data_fd, buf.data(), buf.size(),
-                              req_stat->data_offset)) == -1 &&
-               errno == EINTR)
-            ;
+        if (config->data_map) {
+            // The whole body is queued at once without copying.
+            nread = config->data_length - req_stat->data_offset;
+            wb.append_ref(config->data_map + req_stat->data_offset, nread);
+        } else {
+            // TODO unfortunately, wb has no interface to use with read(2)
+            // family functions.
+            std::array<uint8_t, 16_k> buf;
+
+            while ((nread = pread(config->data_fd, buf.data(), buf.size(),
+                                  req_stat->data_offset)) == -1 &&
+                   errno == EINTR)
+                ;
+
+            if (nread == -1) {
+                return -1;
+            }
 
-        if (nread == -1) {
-            return -1;
+            wb.append(buf.data(), nread);
         }
 
         req_stat->data_offset += nread;
 
-        wb.append(buf.data(), nread);
-
         if (client_->worker->config->verbose) {
             std::cout << "[send " << nread << " byte(s)]" << std::endl;
         }
@@ -292,7 +567,19 @@ Client *Http1Session::get_client() { return client_; }
 size_t Http1Session::max_concurrent_streams() {
     auto config = client_->worker->config;
 
-    return config->data_fd == -1 ? config->max_concurrent_streams : 1;
+    // The body is read into wb piece by piece unless it is mapped, so
+    // only one request can be in the middle of its upload.
+    if (config->data_fd != -1 && config->data_length > 0 &&
+        !config->data_map) {
+        return 1;
+    }
+
+    return config->max_concurrent_streams;
 }
 
+int Http1Session::submit_ping() { return -1; }
+
+// Responses come in the order of requests, so one cannot be skipped.
+int Http1Session::cancel_stream(int32_t stream_id) { return -1; }
+
 } // namespace h2load
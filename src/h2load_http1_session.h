@@ -27,6 +27,8 @@
 
 #include "h2load_session.h"
 
+#include <string>
+
 #include <nghttp2/nghttp2.h>
 
 #include "llhttp.h"
@@ -35,7 +37,7 @@ namespace h2load {
 
 struct Client;
 
-class Http1Session : public Session {
+class Http1Session final : public Session {
   public:
     Http1Session(Client *client);
     virtual ~Http1Session();
@@ -45,13 +47,45 @@ class Http1Session : public Session {
     virtual int on_write();
     virtual void terminate();
     virtual size_t max_concurrent_streams();
+    virtual int submit_ping();
+    virtual int cancel_stream(int32_t stream_id);
     Client *get_client();
+    // Accounts a complete response to the oldest outstanding request.
+    // Returns -1 if the connection is going down.
+    int on_response_complete(bool keep_alive);
     int32_t stream_req_counter_;
     int32_t stream_resp_counter_;
+    // true while llhttp is in the middle of a response
+    bool htp_busy_;
+    // With --accept-encoding or --decode, the name of the response
+    // header llhttp is parsing, and its value if it is
+    // Content-Encoding.  |hdr_in_value_| is true once the value has
+    // started.
+    std::string hdr_name_;
+    std::string hdr_value_;
+    bool hdr_in_value_;
+    // Takes the content coding from the header in |hdr_name_| and
+    // |hdr_value_|, and clears them for the next one.
+    void on_header_end();
 
   private:
+    int parse(const uint8_t *data, size_t len);
+    // --h1-fast-parse: counts the body of a fixed Content-Length
+    // response without looking at it, and falls back to llhttp for
+    // anything else.
+    int fast_parse(const uint8_t *data, size_t len);
+    // Parses the header block |hd| of |hdlen| bytes, which ends with
+    // the empty line.  Returns |hdlen| if the response can be handled
+    // by fast_parse, 0 if it should go to llhttp, or -1 on error.
+    ssize_t fast_parse_header(const char *hd, size_t hdlen);
+
     Client *client_;
     llhttp_t htp_;
+    // header block split across reads, for fast_parse
+    std::string hdbuf_;
+    // bytes of the current response body yet to be read, for fast_parse
+    int64_t body_left_;
+    bool keep_alive_;
     bool complete_;
 };
 
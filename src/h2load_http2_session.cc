@@ -24,6 +24,8 @@
  */
 #include "h2load_http2_session.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cerrno>
 #include <iostream>
@@ -37,7 +39,30 @@ using namespace nghttp2;
 namespace h2load {
 
 Http2Session::Http2Session(Client *client)
-    : client_(client), session_(nullptr) {}
+    : Session(SessionKind::HTTP2), client_(client), session_(nullptr),
+      stream_window_(NGHTTP2_INITIAL_WINDOW_SIZE),
+      conn_window_(NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE),
+      conn_credit_(NGHTTP2_INITIAL_CONNECTION_WINDOW_SIZE), conn_stall_time_{},
+      bdp_ping_time_{}, bdp_bytes_(0), bdp_max_bw_(0) {
+    auto config = client->worker->config;
+    if (std::all_of(std::begin(config->path_slots),
+                    std::end(config->path_slots),
+                    [](const std::vector<SubstSlot> &v) { return v.empty(); })) {
+        return;
+    }
+    paths_.resize(config->nva.size());
+    for (size_t i = 0; i < config->nva.size(); ++i) {
+        nva_.push_back(config->nva[i]);
+        if (config->path_slots[i].empty()) {
+            continue;
+        }
+        // :path comes first.
+        auto &nv = nva_.back()[0];
+        paths_[i].assign(reinterpret_cast<const char *>(nv.value),
+                         nv.valuelen);
+        nv.value = reinterpret_cast<uint8_t *>(&paths_[i][0]);
+    }
+}
 
 Http2Session::~Http2Session() { nghttp2_session_del(session_); }
 
@@ -47,12 +72,24 @@ int on_header_callback(nghttp2_session *session, const nghttp2_frame *frame,
                        const uint8_t *value, size_t valuelen, uint8_t flags,
                        void *user_data) {
     auto client = static_cast<Client *>(user_data);
-    if (frame->hd.type != NGHTTP2_HEADERS ||
-        frame->headers.cat != NGHTTP2_HCAT_RESPONSE) {
+    if (frame->hd.type != NGHTTP2_HEADERS) {
+        return 0;
+    }
+    // grpc-status comes in the trailers, or in the response headers if
+    // the call fails at once.
+    if (client->worker->config->grpc &&
+        util::streq_l("grpc-status", name, namelen)) {
+        client->on_grpc_status(frame->hd.stream_id, value, valuelen);
+    }
+    if (frame->headers.cat != NGHTTP2_HCAT_RESPONSE) {
         return 0;
     }
     client->on_header(frame->hd.stream_id, name, namelen, value, valuelen);
     client->worker->stats.bytes_head_decomp += namelen + valuelen;
+    if (client->worker->config->count_codings() &&
+        util::streq_l("content-encoding", name, namelen)) {
+        client->on_content_encoding(frame->hd.stream_id, value, valuelen);
+    }
 
     if (client->worker->config->verbose) {
         std::cout << "[stream_id=" << frame->hd.stream_id << "] ";
@@ -70,13 +107,40 @@ namespace {
 int on_frame_recv_callback(nghttp2_session *session, const nghttp2_frame *frame,
                            void *user_data) {
     auto client = static_cast<Client *>(user_data);
+    auto http2session = static_cast<Http2Session *>(client->session.get());
+    if (frame->hd.type == NGHTTP2_DATA) {
+        http2session->on_data(frame->hd);
+        if (client->worker->config->response_sizes) {
+            client->on_response_bytes(frame->hd.stream_id,
+                                      9 + frame->hd.length, 0, 0, 0);
+        }
+        return 0;
+    }
+    if (frame->hd.type == NGHTTP2_SETTINGS &&
+        !(frame->hd.flags & NGHTTP2_FLAG_ACK)) {
+        // The server may allow more streams than assumed so far.
+        client->fill_streams();
+        return 0;
+    }
+    if (frame->hd.type == NGHTTP2_PING &&
+        (frame->hd.flags & NGHTTP2_FLAG_ACK)) {
+        if (!http2session->on_bdp_ping_ack(frame->ping)) {
+            client->on_ping_ack();
+        }
+        return 0;
+    }
     if (frame->hd.type != NGHTTP2_HEADERS ||
         frame->headers.cat != NGHTTP2_HCAT_RESPONSE) {
         return 0;
     }
-    client->worker->stats.bytes_head +=
-        frame->hd.length - frame->headers.padlen -
-        ((frame->hd.flags & NGHTTP2_FLAG_PRIORITY) ? 5 : 0);
+    auto hdlen = frame->hd.length - frame->headers.padlen -
+                 ((frame->hd.flags & NGHTTP2_FLAG_PRIORITY) ? 5 : 0);
+    client->worker->stats.bytes_head += hdlen;
+    if (client->worker->config->response_sizes) {
+        // 9 bytes frame header
+        client->on_response_bytes(frame->hd.stream_id, 9 + frame->hd.length,
+                                  hdlen, 0, 0);
+    }
     if (frame->hd.flags & NGHTTP2_FLAG_END_STREAM) {
         client->record_ttfb();
     }
@@ -84,6 +148,18 @@ int on_frame_recv_callback(nghttp2_session *session, const nghttp2_frame *frame,
 }
 } // namespace
 
+namespace {
+int on_begin_frame_callback(nghttp2_session *session,
+                            const nghttp2_frame_hd *hd, void *user_data) {
+    if (hd->type != NGHTTP2_DATA) {
+        return 0;
+    }
+    auto client = static_cast<Client *>(user_data);
+    static_cast<Http2Session *>(client->session.get())->on_data_begin(*hd);
+    return 0;
+}
+} // namespace
+
 namespace {
 int on_data_chunk_recv_callback(nghttp2_session *session, uint8_t flags,
                                 int32_t stream_id, const uint8_t *data,
@@ -91,6 +167,12 @@ int on_data_chunk_recv_callback(nghttp2_session *session, uint8_t flags,
     auto client = static_cast<Client *>(user_data);
     client->record_ttfb();
     client->worker->stats.bytes_body += len;
+    if (client->worker->config->response_sizes) {
+        client->on_response_bytes(stream_id, 0, 0, 0, len);
+    }
+    if (client->worker->config->count_codings()) {
+        client->on_body(stream_id, data, len);
+    }
     return 0;
 }
 } // namespace
@@ -125,15 +207,24 @@ int on_frame_not_send_callback(nghttp2_session *session,
 namespace {
 int before_frame_send_callback(nghttp2_session *session,
                                const nghttp2_frame *frame, void *user_data) {
+    auto client = static_cast<Client *>(user_data);
+
+    if (frame->hd.type == NGHTTP2_WINDOW_UPDATE) {
+        static_cast<Http2Session *>(client->session.get())
+            ->on_window_update_send(frame->window_update);
+        return 0;
+    }
+
     if (frame->hd.type != NGHTTP2_HEADERS ||
         frame->headers.cat != NGHTTP2_HCAT_REQUEST) {
         return 0;
     }
 
-    auto client = static_cast<Client *>(user_data);
     auto req_stat = client->get_req_stat(frame->hd.stream_id);
     assert(req_stat);
     client->record_request_time(req_stat);
+    static_cast<Http2Session *>(client->session.get())
+        ->on_request_send(frame->hd.stream_id);
 
     return 0;
 }
@@ -147,6 +238,30 @@ ssize_t file_read_callback(nghttp2_session *session, int32_t stream_id,
     auto config = client->worker->config;
     auto req_stat = client->get_req_stat(stream_id);
     assert(req_stat);
+
+    if (!config->grpcreqs.empty()) {
+        // The message of each call is made at startup.
+        auto &body = config->grpcreqs[req_stat->tmpl].body;
+        auto n = std::min(length, body.size() - req_stat->data_offset);
+        std::copy_n(body.data() + req_stat->data_offset, n, buf);
+        req_stat->data_offset += n;
+        if (static_cast<size_t>(req_stat->data_offset) == body.size()) {
+            *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+        }
+        return n;
+    }
+
+    if (config->data_map) {
+        // send_data_callback queues the mapped data itself.
+        auto n = std::min(static_cast<int64_t>(length),
+                          config->data_length - req_stat->data_offset);
+        *data_flags |= NGHTTP2_DATA_FLAG_NO_COPY;
+        if (req_stat->data_offset + n == config->data_length) {
+            *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+        }
+        return n;
+    }
+
     ssize_t nread;
     while ((nread = pread(config->data_fd, buf, length,
                           req_stat->data_offset)) == -1 &&
@@ -174,16 +289,36 @@ ssize_t file_read_callback(nghttp2_session *session, int32_t stream_id,
 } // namespace
 
 namespace {
-ssize_t send_callback(nghttp2_session *session, const uint8_t *data,
-                      size_t length, int flags, void *user_data) {
+int send_data_callback(nghttp2_session *session, nghttp2_frame *frame,
+                       const uint8_t *framehd, size_t length,
+                       nghttp2_data_source *source, void *user_data) {
     auto client = static_cast<Client *>(user_data);
+    auto config = client->worker->config;
     auto &wb = client->wb;
 
     if (wb.rleft() >= BACKOFF_WRITE_BUFFER_THRES) {
         return NGHTTP2_ERR_WOULDBLOCK;
     }
 
-    return wb.append(data, length);
+    auto req_stat = client->get_req_stat(frame->hd.stream_id);
+    assert(req_stat);
+
+    auto padlen = frame->data.padlen;
+
+    // 9 bytes frame header
+    wb.append(framehd, 9);
+    if (padlen > 0) {
+        wb.append(static_cast<char>(padlen - 1));
+    }
+    wb.append_ref(config->data_map + req_stat->data_offset, length);
+    if (padlen > 1) {
+        static constexpr std::array<uint8_t, 255> padding{};
+        wb.append(padding.data(), padlen - 1);
+    }
+
+    req_stat->data_offset += length;
+
+    return 0;
 }
 } // namespace
 
@@ -193,6 +328,8 @@ void Http2Session::on_connect() {
     // This is required with --disable-assert.
     (void)rv;
 
+    auto config = client_->worker->config;
+
     nghttp2_session_callbacks *callbacks;
 
     nghttp2_session_callbacks_new(&callbacks);
@@ -202,6 +339,9 @@ void Http2Session::on_connect() {
     nghttp2_session_callbacks_set_on_frame_recv_callback(
         callbacks, on_frame_recv_callback);
 
+    nghttp2_session_callbacks_set_on_begin_frame_callback(
+        callbacks, on_begin_frame_callback);
+
     nghttp2_session_callbacks_set_on_data_chunk_recv_callback(
         callbacks, on_data_chunk_recv_callback);
 
@@ -217,31 +357,44 @@ void Http2Session::on_connect() {
     nghttp2_session_callbacks_set_before_frame_send_callback(
         callbacks, before_frame_send_callback);
 
-    nghttp2_session_callbacks_set_send_callback(callbacks, send_callback);
+    if (config->data_map) {
+        nghttp2_session_callbacks_set_send_data_callback(callbacks,
+                                                         send_data_callback);
+    }
 
     nghttp2_option *opt;
 
     rv = nghttp2_option_new(&opt);
     assert(rv == 0);
 
-    auto config = client_->worker->config;
-
     if (config->encoder_header_table_size !=
         NGHTTP2_DEFAULT_HEADER_TABLE_SIZE) {
         nghttp2_option_set_max_deflate_dynamic_table_size(
             opt, config->encoder_header_table_size);
     }
 
-    nghttp2_session_client_new2(&session_, callbacks, client_, opt);
+    if (config->no_rfc7540_priorities) {
+        nghttp2_option_set_no_rfc7540_priorities(opt, 1);
+    }
+
+    // Streams churn through the same few object sizes, which the
+    // worker's pool recycles without the global heap.
+    nghttp2_session_client_new3(&session_, callbacks, client_, opt,
+                                client_->worker->h2_mem.mem());
 
     nghttp2_option_del(opt);
 
-    std::array<nghttp2_settings_entry, 3> iv;
+    std::array<nghttp2_settings_entry, 4> iv;
     size_t niv = 2;
     iv[0].settings_id = NGHTTP2_SETTINGS_ENABLE_PUSH;
     iv[0].value = 0;
     iv[1].settings_id = NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE;
-    iv[1].value = (1 << config->window_bits) - 1;
+    if (!config->window_auto_tune) {
+        // Windows large enough never to hold the server back
+        stream_window_ = (1 << config->window_bits) - 1;
+        conn_window_ = (1 << config->connection_window_bits) - 1;
+    }
+    iv[1].value = stream_window_;
 
     if (config->header_table_size != NGHTTP2_DEFAULT_HEADER_TABLE_SIZE) {
         iv[niv].settings_id = NGHTTP2_SETTINGS_HEADER_TABLE_SIZE;
@@ -249,13 +402,25 @@ void Http2Session::on_connect() {
         ++niv;
     }
 
+    if (config->no_rfc7540_priorities) {
+        iv[niv].settings_id = NGHTTP2_SETTINGS_NO_RFC7540_PRIORITIES;
+        iv[niv].value = 1;
+        ++niv;
+    }
+
     rv = nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE, iv.data(), niv);
 
     assert(rv == 0);
 
-    auto connection_window = (1 << config->connection_window_bits) - 1;
     nghttp2_session_set_local_window_size(session_, NGHTTP2_FLAG_NONE, 0,
-                                          connection_window);
+                                          conn_window_);
+
+    if (config->window_auto_tune) {
+        auto &stats = client_->worker->stats;
+        stats.max_stream_window =
+            std::max(stats.max_stream_window, stream_window_);
+        stats.max_conn_window = std::max(stats.max_conn_window, conn_window_);
+    }
 
     client_->signal_write();
 }
@@ -266,22 +431,40 @@ int Http2Session::submit_request() {
     }
 
     auto config = client_->worker->config;
-    auto &nva = config->nva[client_->reqidx++];
-
-    if (client_->reqidx == config->nva.size()) {
-        client_->reqidx = 0;
+    auto reqidx = client_->next_template(config->nva.size());
+    auto &nva = nva_.empty() ? config->nva[reqidx] : nva_[reqidx];
+
+    auto &slots = config->path_slots[reqidx];
+    if (!slots.empty()) {
+        // nghttp2 copies :path, so the next request may fill it again.
+        auto &subst = client_->worker->subst;
+        subst.next();
+        auto path = reinterpret_cast<uint8_t *>(&paths_[reqidx][0]);
+        for (auto &slot : slots) {
+            subst.fill(path + slot.offset, slot);
+        }
     }
 
     nghttp2_data_provider prd{{0}, file_read_callback};
 
-    auto stream_id =
-        nghttp2_submit_request(session_, nullptr, nva.data(), nva.size(),
-                               config->data_fd == -1 ? nullptr : &prd, nullptr);
+    auto data_prd =
+        config->data_fd == -1 && config->grpcreqs.empty() ? nullptr : &prd;
+
+    int32_t stream_id;
+    if (config->nva_hd.empty()) {
+        stream_id = nghttp2_submit_request(session_, nullptr, nva.data(),
+                                           nva.size(), data_prd, nullptr);
+    } else {
+        auto &hd = config->nva_hd[reqidx];
+        stream_id = nghttp2_submit_request_hd(session_, nullptr, nva.data(),
+                                              nva.size(), hd.data(), hd.size(),
+                                              data_prd, nullptr);
+    }
     if (stream_id < 0) {
         return -1;
     }
 
-    client_->on_request(stream_id);
+    client_->on_request(stream_id, reqidx);
 
     return 0;
 }
@@ -305,9 +488,20 @@ int Http2Session::on_read(const uint8_t *data, size_t len) {
 }
 
 int Http2Session::on_write() {
-    auto rv = nghttp2_session_send(session_);
-    if (rv != 0) {
-        return -1;
+    auto &wb = client_->wb;
+
+    // Pull serialized frames until enough is queued, rather than
+    // having them pushed through a callback one at a time.
+    while (wb.rleft() < BACKOFF_WRITE_BUFFER_THRES) {
+        const uint8_t *data;
+        auto datalen = nghttp2_session_mem_send(session_, &data);
+        if (datalen < 0) {
+            return -1;
+        }
+        if (datalen == 0) {
+            break;
+        }
+        wb.append(data, datalen);
     }
 
     if (nghttp2_session_want_read(session_) == 0 &&
@@ -323,7 +517,191 @@ void Http2Session::terminate() {
 }
 
 size_t Http2Session::max_concurrent_streams() {
-    return (size_t)client_->worker->config->max_concurrent_streams;
+    // Until the server's SETTINGS arrive, the library assumes 100.
+    return std::min(
+        static_cast<size_t>(client_->worker->config->max_concurrent_streams),
+        static_cast<size_t>(nghttp2_session_get_remote_settings(
+            session_, NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS)));
+}
+
+namespace {
+// The opaque data of the PINGs which measure the bandwidth-delay
+// product.  Those of --ping-interval are all zeros.
+constexpr std::array<uint8_t, 8> BDP_PING_DATA{{'b', 'd', 'p'}};
+} // namespace
+
+void Http2Session::add_stall_time(std::chrono::steady_clock::time_point &t,
+                                  uint64_t &total) {
+    auto d = std::chrono::steady_clock::now() - t;
+    t = {};
+    total += std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+}
+
+void Http2Session::on_data_begin(const nghttp2_frame_hd &hd) {
+    auto &stats = client_->worker->stats;
+
+    // The server sent more, so that the window it waited for, if any,
+    // has arrived.
+    if (conn_stall_time_.time_since_epoch().count()) {
+        add_stall_time(conn_stall_time_, stats.conn_stall_time);
+    }
+    conn_credit_ -= hd.length;
+
+    auto stream = client_->streams.find(hd.stream_id);
+    if (stream) {
+        if (stream->stall_time.time_since_epoch().count()) {
+            add_stall_time(stream->stall_time, stats.stream_stall_time);
+        }
+        stream->window -= hd.length;
+    }
+
+    if (!client_->worker->config->window_auto_tune) {
+        return;
+    }
+
+    if (bdp_ping_time_.time_since_epoch().count()) {
+        bdp_bytes_ += hd.length;
+        return;
+    }
+
+    if (stream_window_ == NGHTTP2_MAX_WINDOW_SIZE &&
+        conn_window_ == NGHTTP2_MAX_WINDOW_SIZE) {
+        return;
+    }
+
+    if (nghttp2_submit_ping(session_, NGHTTP2_FLAG_NONE,
+                            BDP_PING_DATA.data()) != 0) {
+        return;
+    }
+
+    bdp_ping_time_ = std::chrono::steady_clock::now();
+    bdp_bytes_ = hd.length;
+}
+
+void Http2Session::on_data(const nghttp2_frame_hd &hd) {
+    if (client_->worker->current_phase != Phase::MAIN_DURATION) {
+        return;
+    }
+
+    auto &stats = client_->worker->stats;
+
+    // The connection is not held back if its last stream just ended.
+    if (conn_credit_ <= 0 && (!(hd.flags & NGHTTP2_FLAG_END_STREAM) ||
+                              client_->streams.size() > 1)) {
+        ++stats.conn_stalls;
+        conn_stall_time_ = std::chrono::steady_clock::now();
+    }
+
+    if (hd.flags & NGHTTP2_FLAG_END_STREAM) {
+        return;
+    }
+
+    auto stream = client_->streams.find(hd.stream_id);
+    if (stream && stream->window <= 0) {
+        ++stats.stream_stalls;
+        stream->stall_time = std::chrono::steady_clock::now();
+    }
+}
+
+void Http2Session::on_window_update_send(const nghttp2_window_update &frame) {
+    if (frame.hd.stream_id == 0) {
+        conn_credit_ += frame.window_size_increment;
+        return;
+    }
+
+    auto stream = client_->streams.find(frame.hd.stream_id);
+    if (stream) {
+        stream->window += frame.window_size_increment;
+    }
+}
+
+void Http2Session::on_request_send(int32_t stream_id) {
+    auto stream = client_->streams.find(stream_id);
+    if (stream) {
+        stream->window = stream_window_;
+    }
+}
+
+bool Http2Session::on_bdp_ping_ack(const nghttp2_ping &ping) {
+    if (!std::equal(std::begin(BDP_PING_DATA), std::end(BDP_PING_DATA),
+                    ping.opaque_data)) {
+        return false;
+    }
+
+    if (!bdp_ping_time_.time_since_epoch().count()) {
+        return true;
+    }
+
+    auto rtt = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             bdp_ping_time_)
+                   .count();
+    bdp_ping_time_ = {};
+
+    // bdp_bytes_ is the throughput times the round trip time.  If it
+    // comes close to the window, the window is likely the limit.  As
+    // long as the throughput keeps growing with the window, grow the
+    // window further to twice the bandwidth-delay product.
+    auto bw = rtt > 0 ? bdp_bytes_ / rtt : 0;
+    if (bw < bdp_max_bw_) {
+        return true;
+    }
+    bdp_max_bw_ = bw;
+
+    if (bdp_bytes_ <
+        static_cast<int64_t>(std::min(stream_window_, conn_window_)) * 2 / 3) {
+        return true;
+    }
+
+    grow_window(static_cast<int32_t>(std::min(
+        bdp_bytes_ * 2, static_cast<int64_t>(NGHTTP2_MAX_WINDOW_SIZE))));
+
+    return true;
+}
+
+void Http2Session::grow_window(int32_t window) {
+    auto &stats = client_->worker->stats;
+
+    if (window > conn_window_) {
+        // The library sends WINDOW_UPDATE for the difference.
+        if (nghttp2_session_set_local_window_size(session_, NGHTTP2_FLAG_NONE,
+                                                  0, window) == 0) {
+            conn_window_ = window;
+            stats.max_conn_window = std::max(stats.max_conn_window, window);
+        }
+    }
+
+    if (window > stream_window_) {
+        nghttp2_settings_entry iv{NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE,
+                                  static_cast<uint32_t>(window)};
+        if (nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE, &iv, 1) ==
+            0) {
+            // The server applies the difference to all streams when it
+            // gets SETTINGS.
+            auto delta = window - stream_window_;
+            client_->streams.for_each([delta](int32_t, Stream &stream) {
+                stream.window += delta;
+            });
+            stream_window_ = window;
+            stats.max_stream_window =
+                std::max(stats.max_stream_window, window);
+        }
+    }
+}
+
+int Http2Session::submit_ping() {
+    if (nghttp2_submit_ping(session_, NGHTTP2_FLAG_NONE, nullptr) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+int Http2Session::cancel_stream(int32_t stream_id) {
+    // on_stream_close_callback() is called once RST_STREAM is sent.
+    if (nghttp2_submit_rst_stream(session_, NGHTTP2_FLAG_NONE, stream_id,
+                                  NGHTTP2_CANCEL) != 0) {
+        return -1;
+    }
+    return 0;
 }
 
 } // namespace h2load
@@ -27,13 +27,16 @@
 
 #include "h2load_session.h"
 
+#include <string>
+#include <vector>
+
 #include <nghttp2/nghttp2.h>
 
 namespace h2load {
 
 struct Client;
 
-class Http2Session : public Session {
+class Http2Session final : public Session {
   public:
     Http2Session(Client *client);
     virtual ~Http2Session();
@@ -43,10 +46,54 @@ class Http2Session : public Session {
     virtual int on_write();
     virtual void terminate();
     virtual size_t max_concurrent_streams();
+    virtual int submit_ping();
+    virtual int cancel_stream(int32_t stream_id);
+
+    // Called when the header of a DATA frame has been received.
+    void on_data_begin(const nghttp2_frame_hd &hd);
+    // Called when a DATA frame has been received.
+    void on_data(const nghttp2_frame_hd &hd);
+    // Called when a WINDOW_UPDATE frame is about to be sent.
+    void on_window_update_send(const nghttp2_window_update &frame);
+    // Called when HEADERS frame of the request on |stream_id| is about
+    // to be sent.
+    void on_request_send(int32_t stream_id);
+    // Returns true if |ping| answers the PING which measures the
+    // bandwidth-delay product, and processes it.
+    bool on_bdp_ping_ack(const nghttp2_ping &ping);
 
   private:
+    // Adds the time from |t| to now to |total|, and resets |t|.
+    void add_stall_time(std::chrono::steady_clock::time_point &t,
+                        uint64_t &total);
+    // Grows both windows to |window| with --window-auto-tune.
+    void grow_window(int32_t window);
+
     Client *client_;
     nghttp2_session *session_;
+    // The initial stream window and the connection window which have
+    // been sent to the server
+    int32_t stream_window_;
+    int32_t conn_window_;
+    // The bytes the server may still send on the connection, as far as
+    // the windows sent so far go
+    int64_t conn_credit_;
+    // The time the server used up the connection window, or unset if
+    // it has not
+    std::chrono::steady_clock::time_point conn_stall_time_;
+    // With --window-auto-tune, the time the PING measuring the
+    // bandwidth-delay product was sent, or unset if none is
+    // outstanding, and the DATA bytes received since then
+    std::chrono::steady_clock::time_point bdp_ping_time_;
+    int64_t bdp_bytes_;
+    // The highest bandwidth in bytes per second seen in a PING round
+    // trip
+    double bdp_max_bw_;
+    // With substitution slots in URIs, the session's own copy of the
+    // :path of each request template, which is filled in place, and of
+    // the nva which refers to it
+    std::vector<std::string> paths_;
+    std::vector<std::vector<nghttp2_nv>> nva_;
 };
 
 } // namespace h2load
@@ -0,0 +1,109 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_imbalance.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace h2load {
+
+double jain_index(const std::vector<double> &xs) {
+    double sum = 0., sqsum = 0.;
+    for (auto x : xs) {
+        sum += x;
+        sqsum += x * x;
+    }
+    if (sqsum == 0.) {
+        return 1.;
+    }
+    return sum * sum / (xs.size() * sqsum);
+}
+
+double median(std::vector<double> xs) {
+    if (xs.empty()) {
+        return 0.;
+    }
+    auto mid = std::begin(xs) + xs.size() / 2;
+    std::nth_element(std::begin(xs), mid, std::end(xs));
+    if (xs.size() % 2) {
+        return *mid;
+    }
+    return (*mid + *std::max_element(std::begin(xs), mid)) / 2;
+}
+
+double skew_ratio(double v, double ref) {
+    if (v == ref) {
+        return 1.;
+    }
+    if (v == 0. || ref == 0.) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return v > ref ? v / ref : ref / v;
+}
+
+double conn_skew(const ConnSummary &conn, const ImbalanceStat &stat) {
+    auto skew = skew_ratio(conn.rps, stat.median_rps);
+    if (conn.req_done) {
+        skew = std::max(skew, skew_ratio(conn.mean, stat.median_mean));
+    }
+    return skew;
+}
+
+ImbalanceStat analyze_imbalance(const std::vector<ConnSummary> &conns,
+                                size_t n) {
+    ImbalanceStat stat{};
+
+    std::vector<double> rps, means;
+    for (auto &c : conns) {
+        rps.push_back(c.rps);
+        if (c.req_done) {
+            means.push_back(c.mean);
+        }
+    }
+    stat.rps_fairness = jain_index(rps);
+    stat.latency_fairness = jain_index(means);
+    stat.median_rps = median(std::move(rps));
+    stat.median_mean = median(std::move(means));
+
+    std::vector<double> skews;
+    for (auto &c : conns) {
+        skews.push_back(conn_skew(c, stat));
+    }
+    stat.skewed.resize(conns.size());
+    std::iota(std::begin(stat.skewed), std::end(stat.skewed), 0);
+    n = std::min(n, conns.size());
+    std::partial_sort(std::begin(stat.skewed), std::begin(stat.skewed) + n,
+                      std::end(stat.skewed), [&skews](size_t a, size_t b) {
+                          return skews[a] > skews[b] ||
+                                 (skews[a] == skews[b] && a < b);
+                      });
+    stat.skewed.resize(n);
+
+    return stat;
+}
+
+} // namespace h2load
@@ -0,0 +1,90 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_IMBALANCE_H
+#define H2LOAD_IMBALANCE_H
+
+#include "nghttp2_config.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace h2load {
+
+// The requests of a client's connections, for --imbalance
+struct ConnSummary {
+    uint32_t worker_id;
+    uint32_t client_id;
+    uint64_t req_done;
+    uint64_t req_failed;
+    double rps;
+    // The mean and p99 of the round trip times in nanoseconds
+    uint64_t mean;
+    uint64_t p99;
+    // The local port of the last connection, or 0, and the address it
+    // was made to
+    uint16_t local_port;
+    std::string address;
+};
+
+// How evenly the load spread over the connections of |conns| in
+// analyze_imbalance()
+struct ImbalanceStat {
+    // Jain's fairness index of req/s over all connections, and of the
+    // mean latency over those which finished a request
+    double rps_fairness;
+    double latency_fairness;
+    double median_rps;
+    double median_mean;
+    // The indexes of the connections which stray furthest from the
+    // medians, most skewed first
+    std::vector<size_t> skewed;
+};
+
+// Returns Jain's fairness index of |xs|, which is 1 if all values are
+// equal, and 1/n if one has all of it.  Returns 1 if |xs| is empty or
+// all 0.
+double jain_index(const std::vector<double> &xs);
+
+// Returns the median of |xs|, or 0 if it is empty.
+double median(std::vector<double> xs);
+
+// Returns how far |v| strays from |ref|, as the ratio of the larger to
+// the smaller.  This is 1 if they are equal, and infinity if only one
+// of them is 0.
+double skew_ratio(double v, double ref);
+
+// Returns the skew of |conn| from |stat|, the larger of the skew
+// ratios of its req/s and its mean latency.
+double conn_skew(const ConnSummary &conn, const ImbalanceStat &stat);
+
+// Analyzes |conns|, and picks at most |n| of the most skewed.
+ImbalanceStat analyze_imbalance(const std::vector<ConnSummary> &conns,
+                                size_t n);
+
+} // namespace h2load
+
+#endif // H2LOAD_IMBALANCE_H
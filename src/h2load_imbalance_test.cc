@@ -0,0 +1,88 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_imbalance_test.h"
+
+#include <cmath>
+#include <vector>
+
+#include <CUnit/CUnit.h>
+
+#include "h2load_imbalance.h"
+
+namespace h2load {
+
+void test_imbalance_jain_index(void) {
+    CU_ASSERT(1. == jain_index({}));
+    CU_ASSERT(1. == jain_index({0., 0.}));
+    CU_ASSERT(1. == jain_index({5., 5., 5., 5.}));
+    CU_ASSERT(0.25 == jain_index({8., 0., 0., 0.}));
+    CU_ASSERT(std::abs(jain_index({1., 2., 3.}) - 36. / 42.) < 1e-12);
+
+    CU_ASSERT(0. == median({}));
+    CU_ASSERT(3. == median({5., 1., 3.}));
+    CU_ASSERT(2.5 == median({4., 1., 3., 2.}));
+
+    CU_ASSERT(1. == skew_ratio(2., 2.));
+    CU_ASSERT(2. == skew_ratio(4., 2.));
+    CU_ASSERT(2. == skew_ratio(1., 2.));
+    CU_ASSERT(std::isinf(skew_ratio(0., 2.)));
+}
+
+void test_imbalance_analyze(void) {
+    std::vector<ConnSummary> conns;
+    for (uint32_t i = 0; i < 5; ++i) {
+        ConnSummary c{};
+        c.client_id = i;
+        c.req_done = 100;
+        c.rps = 100.;
+        c.mean = 1000000;
+        c.p99 = 2000000;
+        conns.push_back(c);
+    }
+    // A hot connection, twice as slow, and a stuck one
+    conns[1].rps = 50.;
+    conns[1].mean = 2000000;
+    conns[3].req_done = 0;
+    conns[3].rps = 0.;
+    conns[3].mean = 0;
+
+    auto stat = analyze_imbalance(conns, 2);
+    CU_ASSERT(100. == stat.median_rps);
+    CU_ASSERT(1000000. == stat.median_mean);
+    CU_ASSERT(stat.rps_fairness < 1.);
+    // The stuck connection has no latency to compare.
+    CU_ASSERT(std::abs(stat.latency_fairness - 25. / 28.) < 1e-12);
+    CU_ASSERT(2 == stat.skewed.size());
+    CU_ASSERT(3 == stat.skewed[0]);
+    CU_ASSERT(1 == stat.skewed[1]);
+    CU_ASSERT(2. == conn_skew(conns[1], stat));
+    CU_ASSERT(1. == conn_skew(conns[0], stat));
+
+    stat = analyze_imbalance(conns, 10);
+    CU_ASSERT(5 == stat.skewed.size());
+    CU_ASSERT(0 == stat.skewed[2]);
+}
+
+} // namespace h2load
@@ -0,0 +1,182 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_mem.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace h2load {
+
+// The header of each block, which keeps the blocks after it aligned
+// as malloc(3) does.
+struct alignas(16) SizeClassPool::Block {
+    union {
+        // The next free block of the class, while the block is free
+        Block *next;
+        // The size of a block larger than all classes
+        size_t size;
+    };
+    size_t cls;
+};
+
+namespace {
+void *mem_malloc(size_t size, void *mem_user_data) {
+    return static_cast<SizeClassPool *>(mem_user_data)->malloc(size);
+}
+} // namespace
+
+namespace {
+void mem_free(void *ptr, void *mem_user_data) {
+    static_cast<SizeClassPool *>(mem_user_data)->free(ptr);
+}
+} // namespace
+
+namespace {
+void *mem_calloc(size_t nmemb, size_t size, void *mem_user_data) {
+    return static_cast<SizeClassPool *>(mem_user_data)->calloc(nmemb, size);
+}
+} // namespace
+
+namespace {
+void *mem_realloc(void *ptr, size_t size, void *mem_user_data) {
+    return static_cast<SizeClassPool *>(mem_user_data)->realloc(ptr, size);
+}
+} // namespace
+
+SizeClassPool::SizeClassPool()
+    : freelists{}, slab_last{}, slab_end{},
+      nmem{this, mem_malloc, mem_free, mem_calloc, mem_realloc}, nalloc(0),
+      nreuse(0) {}
+
+SizeClassPool::~SizeClassPool() {
+    for (auto p : slabs) {
+        std::free(p);
+    }
+}
+
+size_t SizeClassPool::size_class(size_t size) {
+    if (size <= NSMALL * 16) {
+        return size == 0 ? 0 : (size - 1) / 16;
+    }
+    size_t cls = NSMALL;
+    for (size_t n = 1024; n < size; n <<= 1) {
+        if (++cls == NCLASSES) {
+            break;
+        }
+    }
+    return cls;
+}
+
+size_t SizeClassPool::class_size(size_t cls) {
+    if (cls < NSMALL) {
+        return (cls + 1) * 16;
+    }
+    return static_cast<size_t>(1024) << (cls - NSMALL);
+}
+
+void *SizeClassPool::malloc(size_t size) {
+    ++nalloc;
+
+    auto cls = size_class(size);
+    if (cls == NCLASSES) {
+        auto b = static_cast<Block *>(std::malloc(sizeof(Block) + size));
+        if (!b) {
+            return nullptr;
+        }
+        b->size = size;
+        b->cls = cls;
+        return b + 1;
+    }
+
+    auto &head = freelists[cls];
+    if (head) {
+        ++nreuse;
+        auto b = head;
+        head = b->next;
+        return b + 1;
+    }
+
+    auto unit = sizeof(Block) + class_size(cls);
+    if (static_cast<size_t>(slab_end[cls] - slab_last[cls]) < unit) {
+        auto len = std::max(SLAB_SIZE / unit, static_cast<size_t>(1)) * unit;
+        auto slab = static_cast<uint8_t *>(std::malloc(len));
+        if (!slab) {
+            return nullptr;
+        }
+        slabs.push_back(slab);
+        slab_last[cls] = slab;
+        slab_end[cls] = slab + len;
+    }
+    auto b = reinterpret_cast<Block *>(slab_last[cls]);
+    slab_last[cls] += unit;
+    b->cls = cls;
+    return b + 1;
+}
+
+void SizeClassPool::free(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    auto b = static_cast<Block *>(ptr) - 1;
+    if (b->cls == NCLASSES) {
+        std::free(b);
+        return;
+    }
+    auto &head = freelists[b->cls];
+    b->next = head;
+    head = b;
+}
+
+void *SizeClassPool::calloc(size_t nmemb, size_t size) {
+    if (size && nmemb > SIZE_MAX / size) {
+        return nullptr;
+    }
+    auto p = malloc(nmemb * size);
+    if (p) {
+        memset(p, 0, nmemb * size);
+    }
+    return p;
+}
+
+void *SizeClassPool::realloc(void *ptr, size_t size) {
+    if (!ptr) {
+        return malloc(size);
+    }
+    auto b = static_cast<Block *>(ptr) - 1;
+    auto cap = b->cls == NCLASSES ? b->size : class_size(b->cls);
+    if (size <= cap && size_class(size) == b->cls) {
+        return ptr;
+    }
+    auto p = malloc(size);
+    if (!p) {
+        return nullptr;
+    }
+    memcpy(p, ptr, std::min(cap, size));
+    free(ptr);
+    return p;
+}
+
+} // namespace h2load
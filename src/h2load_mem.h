@@ -0,0 +1,88 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_MEM_H
+#define H2LOAD_MEM_H
+
+#include "nghttp2_config.h"
+
+#include <cstddef>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <nghttp2/nghttp2.h>
+
+namespace h2load {
+
+// SizeClassPool serves the allocations of the HTTP/2 sessions of a
+// worker from free lists of fixed size classes.  Streams, outbound
+// items and header buffers freed when a stream closes are handed to
+// the next stream of the same size class, rather than going back to
+// the global heap, which the other workers contend for.  Memory is
+// carved from slabs which are kept until the pool is destroyed.
+// Blocks larger than the largest class come from malloc(3).  It is
+// not thread-safe; only the thread of the worker uses it.
+struct SizeClassPool {
+    // Classes are 16 bytes apart up to 512 bytes, where most objects
+    // of nghttp2 fall, and powers of two up to 64KiB above, which
+    // cover its frame and header table buffers.
+    static constexpr size_t NSMALL = 32;
+    static constexpr size_t NCLASSES = NSMALL + 7;
+    static constexpr size_t SLAB_SIZE = 64 * 1024;
+
+    SizeClassPool();
+    ~SizeClassPool();
+    SizeClassPool(const SizeClassPool &) = delete;
+    SizeClassPool &operator=(const SizeClassPool &) = delete;
+
+    void *malloc(size_t size);
+    void free(void *ptr);
+    void *calloc(size_t nmemb, size_t size);
+    void *realloc(void *ptr, size_t size);
+
+    // Returns the allocator functions for
+    // nghttp2_session_client_new3(), which allocate from this pool.
+    nghttp2_mem *mem() { return &nmem; }
+
+    // Returns the size class of |size|, or NCLASSES if it is larger
+    // than all of them.
+    static size_t size_class(size_t size);
+    // Returns the size of the blocks of class |cls|.
+    static size_t class_size(size_t cls);
+
+    struct Block;
+
+    std::array<Block *, NCLASSES> freelists;
+    // The part of the last slab of each class yet to be carved
+    std::array<uint8_t *, NCLASSES> slab_last, slab_end;
+    std::vector<void *> slabs;
+    nghttp2_mem nmem;
+    // The number of allocations, and of those served by free lists
+    uint64_t nalloc, nreuse;
+};
+
+} // namespace h2load
+
+#endif // H2LOAD_MEM_H
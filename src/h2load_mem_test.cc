@@ -0,0 +1,102 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_mem_test.h"
+
+#include <cstring>
+#include <string>
+
+#include <CUnit/CUnit.h>
+
+#include "h2load_mem.h"
+
+namespace h2load {
+
+void test_mem_size_class(void) {
+    CU_ASSERT(0 == SizeClassPool::size_class(0));
+    CU_ASSERT(0 == SizeClassPool::size_class(1));
+    CU_ASSERT(0 == SizeClassPool::size_class(16));
+    CU_ASSERT(1 == SizeClassPool::size_class(17));
+    CU_ASSERT(31 == SizeClassPool::size_class(512));
+    CU_ASSERT(32 == SizeClassPool::size_class(513));
+    CU_ASSERT(32 == SizeClassPool::size_class(1024));
+    CU_ASSERT(33 == SizeClassPool::size_class(1025));
+    CU_ASSERT(38 == SizeClassPool::size_class(65536));
+    CU_ASSERT(SizeClassPool::NCLASSES == SizeClassPool::size_class(65537));
+
+    CU_ASSERT(16 == SizeClassPool::class_size(0));
+    CU_ASSERT(512 == SizeClassPool::class_size(31));
+    CU_ASSERT(1024 == SizeClassPool::class_size(32));
+    CU_ASSERT(65536 == SizeClassPool::class_size(38));
+}
+
+void test_mem_size_class_pool(void) {
+    SizeClassPool pool;
+
+    auto a = static_cast<uint8_t *>(pool.malloc(100));
+    auto b = static_cast<uint8_t *>(pool.malloc(100));
+
+    CU_ASSERT(nullptr != a);
+    CU_ASSERT(a != b);
+    CU_ASSERT(0 == reinterpret_cast<uintptr_t>(a) % 16);
+    CU_ASSERT(1 == pool.slabs.size());
+
+    // A freed block goes to the next allocation of its class.
+    pool.free(a);
+    CU_ASSERT(a == pool.malloc(112));
+    CU_ASSERT(3 == pool.nalloc);
+    CU_ASSERT(1 == pool.nreuse);
+
+    auto c = static_cast<uint8_t *>(pool.calloc(10, 30));
+    CU_ASSERT(nullptr != c);
+    for (size_t i = 0; i < 300; ++i) {
+        CU_ASSERT(0 == c[i]);
+    }
+
+    // Growing within the class keeps the block, and beyond it moves
+    // the contents.
+    memset(b, 'x', 100);
+    CU_ASSERT(b == pool.realloc(b, 112));
+    auto d = static_cast<uint8_t *>(pool.realloc(b, 4000));
+    CU_ASSERT(b != d);
+    CU_ASSERT(0 == memcmp(d, std::string(100, 'x').c_str(), 100));
+
+    // Blocks larger than all classes come from malloc(3).
+    auto slabs = pool.slabs.size();
+    auto e = static_cast<uint8_t *>(pool.malloc(100000));
+    CU_ASSERT(nullptr != e);
+    CU_ASSERT(slabs == pool.slabs.size());
+    e = static_cast<uint8_t *>(pool.realloc(e, 200000));
+    e[199999] = 1;
+    pool.free(e);
+
+    pool.free(nullptr);
+
+    auto mem = pool.mem();
+    auto f = mem->malloc(10, mem->mem_user_data);
+    CU_ASSERT(nullptr != f);
+    mem->free(f, mem->mem_user_data);
+}
+
+} // namespace h2load
@@ -0,0 +1,349 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_metrics.h"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "util.h"
+
+using namespace nghttp2;
+
+namespace h2load {
+
+namespace {
+// The largest StatsD datagram, which fits in the MTU of most
+// networks
+constexpr size_t MAX_STATSD_DATAGRAM = 1432;
+// The longest request of a scrape which is read
+constexpr size_t MAX_SCRAPE_REQUEST = 8192;
+} // namespace
+
+MetricsSample::MetricsSample()
+    : interval(0.), req_done(0), req_status_success(0), req_failed(0),
+      req_error(0), bytes_total(0), req_inflight(0), nconns(0) {}
+
+MetricsExporter::MetricsExporter()
+    : req_done_(0), req_status_success_(0), req_failed_(0), req_error_(0),
+      bytes_total_(0), lfd_(-1), statsd_fd_(-1) {}
+
+MetricsExporter::~MetricsExporter() {
+    if (lfd_ != -1) {
+        close(lfd_);
+    }
+    if (statsd_fd_ != -1) {
+        close(statsd_fd_);
+    }
+}
+
+int MetricsExporter::listen(uint16_t port) {
+    auto fd = socket(AF_INET6, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+        std::cerr << "--metrics-port: cannot create socket: "
+                  << strerror(errno) << std::endl;
+        return -1;
+    }
+
+    int val = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &val, sizeof(val));
+    // Take IPv4 connections as well.
+    val = 0;
+    setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &val, sizeof(val));
+
+    sockaddr_in6 sa{};
+    sa.sin6_family = AF_INET6;
+    sa.sin6_addr = in6addr_any;
+    sa.sin6_port = htons(port);
+    if (bind(fd, reinterpret_cast<sockaddr *>(&sa), sizeof(sa)) == -1 ||
+        ::listen(fd, 16) == -1) {
+        std::cerr << "--metrics-port: cannot listen on port " << port << ": "
+                  << strerror(errno) << std::endl;
+        close(fd);
+        return -1;
+    }
+
+    lfd_ = fd;
+
+    return 0;
+}
+
+int MetricsExporter::connect_statsd(const std::string &host, uint16_t port) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo *res;
+    auto service = util::utos(port);
+    auto rv = getaddrinfo(host.c_str(), service.c_str(), &hints, &res);
+    if (rv != 0) {
+        std::cerr << "--statsd: cannot resolve " << host << ": "
+                  << gai_strerror(rv) << std::endl;
+        return -1;
+    }
+
+    auto fd = -1;
+    for (auto ai = res; ai; ai = ai->ai_next) {
+        fd = socket(ai->ai_family,
+                    ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                    ai->ai_protocol);
+        if (fd == -1) {
+            continue;
+        }
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+            break;
+        }
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+
+    if (fd == -1) {
+        std::cerr << "--statsd: cannot connect to " << host << ":" << port
+                  << ": " << strerror(errno) << std::endl;
+        return -1;
+    }
+
+    statsd_fd_ = fd;
+
+    return 0;
+}
+
+void MetricsExporter::update(const MetricsSample &s) {
+    req_done_ += s.req_done;
+    req_status_success_ += s.req_status_success;
+    req_failed_ += s.req_failed;
+    req_error_ += s.req_error;
+    bytes_total_ += s.bytes_total;
+    for (auto &st : s.sofarpc_status) {
+        sofarpc_status_[st.first] += st.second;
+    }
+    last_ = s;
+
+    if (statsd_fd_ == -1) {
+        return;
+    }
+
+    // Nobody may be listening, which UDP tells only by failing a later
+    // send.  The metrics of an interval are not worth retrying.
+    auto lines = format_statsd(s);
+    size_t pos = 0;
+    while (pos < lines.size()) {
+        auto end = pos + std::min(MAX_STATSD_DATAGRAM, lines.size() - pos);
+        if (end < lines.size()) {
+            auto nl = lines.rfind('\n', end - 1);
+            if (nl != std::string::npos && nl >= pos) {
+                end = nl + 1;
+            }
+        }
+        send(statsd_fd_, lines.data() + pos, end - pos, MSG_NOSIGNAL);
+        pos = end;
+    }
+}
+
+void MetricsExporter::serve(std::chrono::duration<double> timeout) {
+    if (lfd_ == -1) {
+        std::this_thread::sleep_for(timeout);
+        return;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(timeout);
+    for (;;) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (left.count() <= 0) {
+            return;
+        }
+        pollfd pfd{lfd_, POLLIN, 0};
+        if (poll(&pfd, 1, left.count()) <= 0) {
+            continue;
+        }
+        for (;;) {
+            auto fd = accept4(lfd_, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd == -1) {
+                break;
+            }
+            answer(fd);
+            close(fd);
+        }
+    }
+}
+
+void MetricsExporter::answer(int fd) {
+    // A slow scraper may hold up this thread for this long, but never
+    // the workers.
+    timeval tv{1, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    std::string req;
+    std::array<char, 1024> buf;
+    while (req.find("\r\n\r\n") == std::string::npos &&
+           req.size() < MAX_SCRAPE_REQUEST) {
+        auto n = read(fd, buf.data(), buf.size());
+        if (n <= 0) {
+            if (n == -1 && errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        req.append(buf.data(), n);
+    }
+
+    std::string status, body;
+    if (util::starts_with(req, StringRef::from_lit("GET /metrics ")) ||
+        util::starts_with(req, StringRef::from_lit("GET /metrics?"))) {
+        status = "200 OK";
+        body = prometheus_text();
+    } else {
+        status = "404 Not Found";
+        body = "Metrics are at /metrics\n";
+    }
+
+    auto resp = "HTTP/1.1 " + status +
+                "\r\nContent-Type: text/plain; version=0.0.4\r\n"
+                "Content-Length: " +
+                util::utos(body.size()) +
+                "\r\nConnection: close\r\n\r\n" + body;
+    for (size_t off = 0; off < resp.size();) {
+        auto n = write(fd, resp.data() + off, resp.size() - off);
+        if (n == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        off += n;
+    }
+}
+
+namespace {
+// Returns the successful req/s of the interval |s|.
+std::string format_rps(const MetricsSample &s) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2)
+        << (s.interval > 0 ? s.req_status_success / s.interval : 0.);
+    return out.str();
+}
+
+void write_metric(std::ostream &out, const char *name, const char *type,
+                  const char *help) {
+    out << "# HELP " << name << " " << help << "\n# TYPE " << name << " "
+        << type << "\n";
+}
+} // namespace
+
+std::string MetricsExporter::prometheus_text() const {
+    std::ostringstream out;
+
+    write_metric(out, "sofaload_requests_total", "counter",
+                 "Requests finished, by result.");
+    out << "sofaload_requests_total{result=\"done\"} " << req_done_ << "\n"
+        << "sofaload_requests_total{result=\"succeeded\"} "
+        << req_status_success_ << "\n"
+        << "sofaload_requests_total{result=\"failed\"} " << req_failed_
+        << "\n"
+        << "sofaload_requests_total{result=\"errored\"} " << req_error_
+        << "\n";
+
+    if (!sofarpc_status_.empty()) {
+        write_metric(out, "sofaload_sofarpc_responses_total", "counter",
+                     "SofaRPC responses, by status.");
+        for (auto &st : sofarpc_status_) {
+            out << "sofaload_sofarpc_responses_total{status=\"" << st.first
+                << "\"} " << st.second << "\n";
+        }
+    }
+
+    write_metric(out, "sofaload_received_bytes_total", "counter",
+                 "Bytes received.");
+    out << "sofaload_received_bytes_total " << bytes_total_ << "\n";
+
+    write_metric(out, "sofaload_requests_per_second", "gauge",
+                 "Successful requests per second in the last interval.");
+    out << "sofaload_requests_per_second " << format_rps(last_) << "\n";
+
+    write_metric(out, "sofaload_requests_in_flight", "gauge",
+                 "Requests in flight at the end of the last interval.");
+    out << "sofaload_requests_in_flight " << last_.req_inflight << "\n";
+
+    write_metric(out, "sofaload_connections", "gauge",
+                 "Connections at the end of the last interval.");
+    out << "sofaload_connections " << last_.nconns << "\n";
+
+    if (!last_.latency.empty()) {
+        write_metric(out, "sofaload_latency_seconds", "gauge",
+                     "Latency percentiles of the last interval.");
+        for (auto &p : last_.latency) {
+            out << "sofaload_latency_seconds{quantile=\"" << p.first / 100
+                << "\"} " << p.second / 1e9 << "\n";
+        }
+    }
+
+    return out.str();
+}
+
+std::string format_statsd(const MetricsSample &s) {
+    std::ostringstream out;
+
+    out << "sofaload.requests.done:" << s.req_done << "|c\n"
+        << "sofaload.requests.succeeded:" << s.req_status_success << "|c\n"
+        << "sofaload.requests.failed:" << s.req_failed << "|c\n"
+        << "sofaload.requests.errored:" << s.req_error << "|c\n"
+        << "sofaload.bytes:" << s.bytes_total << "|c\n";
+    for (auto &st : s.sofarpc_status) {
+        if (st.second) {
+            out << "sofaload.sofarpc_status." << st.first << ":" << st.second
+                << "|c\n";
+        }
+    }
+    out << "sofaload.rps:" << format_rps(s) << "|g\n"
+        << "sofaload.in_flight:" << s.req_inflight << "|g\n"
+        << "sofaload.connections:" << s.nconns << "|g\n";
+    for (auto &p : s.latency) {
+        std::ostringstream name;
+        name << p.first;
+        auto key = name.str();
+        std::replace(std::begin(key), std::end(key), '.', '_');
+        out << "sofaload.latency.p" << key << ":" << p.second / 1e6
+            << "|g\n";
+    }
+
+    return out.str();
+}
+
+} // namespace h2load
@@ -0,0 +1,115 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_METRICS_H
+#define H2LOAD_METRICS_H
+
+#include "nghttp2_config.h"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace h2load {
+
+// The statistics of one --timeline interval of all workers, which
+// MetricsExporter publishes while the benchmark runs.
+struct MetricsSample {
+    MetricsSample();
+    // The length of the interval in seconds
+    double interval;
+    uint64_t req_done;
+    uint64_t req_status_success;
+    uint64_t req_failed;
+    uint64_t req_error;
+    int64_t bytes_total;
+    // The number of responses of each SofaRPC status in the interval,
+    // keyed by the name of the status
+    std::vector<std::pair<std::string, uint64_t>> sofarpc_status;
+    // The requests in flight, and the connections, at the end of the
+    // interval
+    uint64_t req_inflight;
+    uint64_t nconns;
+    // The latency percentiles of the requests done in the interval, as
+    // pairs of the percentile and the latency in nanoseconds
+    std::vector<std::pair<double, uint64_t>> latency;
+};
+
+// MetricsExporter publishes the statistics of each interval while the
+// benchmark runs: it serves them to Prometheus over HTTP, and pushes
+// them to StatsD over UDP.  It is used by the thread which reports
+// --timeline, never by the workers.
+class MetricsExporter {
+  public:
+    MetricsExporter();
+    ~MetricsExporter();
+    MetricsExporter(const MetricsExporter &) = delete;
+    MetricsExporter &operator=(const MetricsExporter &) = delete;
+
+    // Serves the metrics in the Prometheus text format at /metrics on
+    // |port|.  Returns 0 if it succeeds, or -1 after printing the
+    // error.
+    int listen(uint16_t port);
+    // Pushes the metrics of each interval to StatsD at |host|:|port|.
+    // Returns 0 if it succeeds, or -1 after printing the error.
+    int connect_statsd(const std::string &host, uint16_t port);
+
+    // Adds the interval |s| to the counters, sets the gauges to it,
+    // and pushes it to StatsD.
+    void update(const MetricsSample &s);
+    // Answers the scrapes which arrive in |timeout|, or just waits for
+    // it if nothing is served.
+    void serve(std::chrono::duration<double> timeout);
+
+    // Returns the metrics in the Prometheus text format.
+    std::string prometheus_text() const;
+
+  private:
+    void answer(int fd);
+
+    // The counters since the start, and the gauges of the last
+    // interval
+    uint64_t req_done_;
+    uint64_t req_status_success_;
+    uint64_t req_failed_;
+    uint64_t req_error_;
+    int64_t bytes_total_;
+    std::map<std::string, uint64_t> sofarpc_status_;
+    MetricsSample last_;
+    // The listening socket, and the StatsD socket, or -1
+    int lfd_;
+    int statsd_fd_;
+};
+
+// Returns the StatsD lines of the interval |s|: counters for what
+// happened in it, and gauges for the rest.  Latencies are in
+// milliseconds.
+std::string format_statsd(const MetricsSample &s);
+
+} // namespace h2load
+
+#endif // H2LOAD_METRICS_H
@@ -0,0 +1,107 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_metrics_test.h"
+
+#include <string>
+
+#include <CUnit/CUnit.h>
+
+#include "h2load_metrics.h"
+
+namespace h2load {
+
+namespace {
+// Returns true if |text| has |line| as a whole line.
+bool has_line(const std::string &text, const std::string &line) {
+    return ("\n" + text).find("\n" + line + "\n") != std::string::npos;
+}
+
+MetricsSample make_sample() {
+    MetricsSample s;
+    s.interval = 0.5;
+    s.req_done = 110;
+    s.req_status_success = 100;
+    s.req_failed = 10;
+    s.req_error = 4;
+    s.bytes_total = 12345;
+    s.sofarpc_status = {{"success", 100}, {"timeout", 6}, {"error", 0}};
+    s.req_inflight = 7;
+    s.nconns = 3;
+    s.latency = {{50., 1500000}, {99.9, 20000000}};
+    return s;
+}
+} // namespace
+
+void test_metrics_format_statsd(void) {
+    auto text = format_statsd(make_sample());
+
+    CU_ASSERT(has_line(text, "sofaload.requests.done:110|c"));
+    CU_ASSERT(has_line(text, "sofaload.requests.succeeded:100|c"));
+    CU_ASSERT(has_line(text, "sofaload.requests.failed:10|c"));
+    CU_ASSERT(has_line(text, "sofaload.requests.errored:4|c"));
+    CU_ASSERT(has_line(text, "sofaload.bytes:12345|c"));
+    CU_ASSERT(has_line(text, "sofaload.sofarpc_status.timeout:6|c"));
+    // Statuses which did not occur are left out.
+    CU_ASSERT(text.find("sofarpc_status.error") == std::string::npos);
+    CU_ASSERT(has_line(text, "sofaload.rps:200.00|g"));
+    CU_ASSERT(has_line(text, "sofaload.in_flight:7|g"));
+    CU_ASSERT(has_line(text, "sofaload.connections:3|g"));
+    CU_ASSERT(has_line(text, "sofaload.latency.p50:1.5|g"));
+    CU_ASSERT(has_line(text, "sofaload.latency.p99_9:20|g"));
+}
+
+void test_metrics_prometheus_text(void) {
+    MetricsExporter m;
+
+    auto text = m.prometheus_text();
+    CU_ASSERT(has_line(text, "sofaload_requests_total{result=\"done\"} 0"));
+    CU_ASSERT(has_line(text, "sofaload_requests_per_second 0.00"));
+    CU_ASSERT(text.find("sofaload_latency_seconds") == std::string::npos);
+
+    auto s = make_sample();
+    m.update(s);
+    s.interval = 1.;
+    s.req_inflight = 2;
+    s.latency = {{99., 3000000}};
+    m.update(s);
+
+    text = m.prometheus_text();
+    // Counters add up over intervals, and gauges are of the last one.
+    CU_ASSERT(has_line(text, "sofaload_requests_total{result=\"done\"} 220"));
+    CU_ASSERT(
+        has_line(text, "sofaload_requests_total{result=\"errored\"} 8"));
+    CU_ASSERT(has_line(
+        text, "sofaload_sofarpc_responses_total{status=\"timeout\"} 12"));
+    CU_ASSERT(has_line(text, "sofaload_received_bytes_total 24690"));
+    CU_ASSERT(has_line(text, "sofaload_requests_per_second 100.00"));
+    CU_ASSERT(has_line(text, "sofaload_requests_in_flight 2"));
+    CU_ASSERT(has_line(text, "sofaload_connections 3"));
+    CU_ASSERT(
+        has_line(text, "sofaload_latency_seconds{quantile=\"0.99\"} 0.003"));
+    CU_ASSERT(text.find("quantile=\"0.5\"") == std::string::npos);
+    CU_ASSERT(has_line(text, "# TYPE sofaload_connections gauge"));
+}
+
+} // namespace h2load
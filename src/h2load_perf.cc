@@ -0,0 +1,157 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_perf.h"
+
+#ifdef HAVE_LINUX_PERF_EVENT_H
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // HAVE_LINUX_PERF_EVENT_H
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+namespace h2load {
+
+const char *const PERF_COUNTER_NAMES[PERF_NCOUNTERS] = {
+    "cycles",
+    "instructions",
+    "llc_misses",
+    "context_switches",
+};
+
+PerfCounters::PerfCounters() : user_only_(false) {
+    fds_.fill(-1);
+    values_.fill(0);
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef HAVE_LINUX_PERF_EVENT_H
+    for (auto fd : fds_) {
+        if (fd != -1) {
+            close(fd);
+        }
+    }
+#endif // HAVE_LINUX_PERF_EVENT_H
+}
+
+#ifdef HAVE_LINUX_PERF_EVENT_H
+namespace {
+int perf_event_open(uint32_t type, uint64_t config, bool user_only) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = user_only;
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+}
+} // namespace
+#endif // HAVE_LINUX_PERF_EVENT_H
+
+int PerfCounters::open() {
+#ifdef HAVE_LINUX_PERF_EVENT_H
+    static constexpr std::pair<uint32_t, uint64_t> events[PERF_NCOUNTERS] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+    };
+
+    auto navail = 0;
+    for (size_t i = 0; i < PERF_NCOUNTERS; ++i) {
+        auto &ev = events[i];
+        auto fd = perf_event_open(ev.first, ev.second, user_only_);
+        if (fd == -1 && !user_only_ && (errno == EACCES || errno == EPERM)) {
+            user_only_ = true;
+            for (size_t j = 0; j < i; ++j) {
+                if (fds_[j] != -1) {
+                    close(fds_[j]);
+                    fds_[j] = perf_event_open(events[j].first,
+                                              events[j].second, true);
+                }
+            }
+            fd = perf_event_open(ev.first, ev.second, true);
+        }
+        fds_[i] = fd;
+    }
+    for (auto fd : fds_) {
+        if (fd != -1) {
+            ++navail;
+        }
+    }
+    return navail ? 0 : -1;
+#else  // !HAVE_LINUX_PERF_EVENT_H
+    return -1;
+#endif // !HAVE_LINUX_PERF_EVENT_H
+}
+
+void PerfCounters::start() {
+#ifdef HAVE_LINUX_PERF_EVENT_H
+    for (auto fd : fds_) {
+        if (fd != -1) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif // HAVE_LINUX_PERF_EVENT_H
+}
+
+void PerfCounters::stop() {
+#ifdef HAVE_LINUX_PERF_EVENT_H
+    for (size_t i = 0; i < PERF_NCOUNTERS; ++i) {
+        auto fd = fds_[i];
+        if (fd == -1) {
+            continue;
+        }
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        // value, time enabled and time running
+        uint64_t buf[3];
+        if (read(fd, buf, sizeof(buf)) != sizeof(buf)) {
+            close(fd);
+            fds_[i] = -1;
+            continue;
+        }
+        if (buf[2] == 0) {
+            values_[i] = 0;
+        } else if (buf[2] < buf[1]) {
+            values_[i] =
+                static_cast<uint64_t>(static_cast<double>(buf[0]) * buf[1] /
+                                      buf[2]);
+        } else {
+            values_[i] = buf[0];
+        }
+    }
+#endif // HAVE_LINUX_PERF_EVENT_H
+}
+
+} // namespace h2load
@@ -0,0 +1,80 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_PERF_H
+#define H2LOAD_PERF_H
+
+#include "nghttp2_config.h"
+
+#include <array>
+#include <cstdint>
+
+namespace h2load {
+
+enum PerfCounter {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_LLC_MISSES,
+    PERF_CONTEXT_SWITCHES,
+    PERF_NCOUNTERS,
+};
+
+// The names of PerfCounter, in the same order
+extern const char *const PERF_COUNTER_NAMES[PERF_NCOUNTERS];
+
+// PerfCounters counts hardware events of the calling thread with
+// perf_event_open(2).  Counters the kernel or the CPU does not
+// support are left out, so that the rest still work, e.g. inside a
+// virtual machine.
+class PerfCounters {
+  public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    // Opens the counters for the calling thread, stopped.  Returns 0
+    // if at least one counter is available, or -1.
+    int open();
+    void start();
+    // Stops the counters and reads them.
+    void stop();
+
+    bool available(PerfCounter c) const { return fds_[c] != -1; }
+    // Returns the count of |c|, scaled up if the kernel had to share
+    // the hardware counter with others.
+    uint64_t value(PerfCounter c) const { return values_[c]; }
+    // True if events in the kernel are not counted because
+    // perf_event_paranoid does not allow it.
+    bool user_only() const { return user_only_; }
+
+  private:
+    std::array<int, PERF_NCOUNTERS> fds_;
+    std::array<uint64_t, PERF_NCOUNTERS> values_;
+    bool user_only_;
+};
+
+} // namespace h2load
+
+#endif // H2LOAD_PERF_H
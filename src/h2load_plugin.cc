@@ -0,0 +1,92 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_plugin.h"
+
+#include <dlfcn.h>
+
+#include <iostream>
+
+namespace h2load {
+
+namespace {
+// Looks up |name| in |handle|, or returns nullptr after printing the
+// error.
+void *lookup(void *handle, const char *name) {
+    auto sym = dlsym(handle, name);
+    if (sym == nullptr) {
+        std::cerr << "--plugin: " << name << " is not found" << std::endl;
+    }
+    return sym;
+}
+} // namespace
+
+Plugin::Plugin() : init_(nullptr), fill_(nullptr), free_(nullptr) {}
+
+int Plugin::load(const std::string &path) {
+    // RTLD_LOCAL keeps the symbols of the plugin from clashing with
+    // ours.
+    auto handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr) {
+        std::cerr << "--plugin: " << dlerror() << std::endl;
+        return -1;
+    }
+
+    auto version = reinterpret_cast<sofaload_plugin_version_func>(
+        lookup(handle, "sofaload_plugin_version"));
+    init_ = reinterpret_cast<sofaload_plugin_init_func>(
+        lookup(handle, "sofaload_plugin_init"));
+    fill_ = reinterpret_cast<sofaload_plugin_fill_func>(
+        lookup(handle, "sofaload_plugin_fill"));
+    free_ = reinterpret_cast<sofaload_plugin_free_func>(
+        lookup(handle, "sofaload_plugin_free"));
+    if (version == nullptr || init_ == nullptr || fill_ == nullptr ||
+        free_ == nullptr) {
+        return -1;
+    }
+
+    auto v = version();
+    if (v != SOFALOAD_PLUGIN_VERSION) {
+        std::cerr << "--plugin: " << path << " is built for interface version "
+                  << v << ", but sofaload has version "
+                  << SOFALOAD_PLUGIN_VERSION << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+void *Plugin::init(uint32_t worker_id, uint32_t nworkers,
+                   const std::string &arg) {
+    auto ctx = init_(worker_id, nworkers, arg.c_str());
+    if (ctx == nullptr) {
+        std::cerr << "--plugin: initialization failed for worker " << worker_id
+                  << std::endl;
+    }
+    return ctx;
+}
+
+void Plugin::free(void *ctx) { free_(ctx); }
+
+} // namespace h2load
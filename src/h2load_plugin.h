@@ -0,0 +1,62 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_PLUGIN_H
+#define H2LOAD_PLUGIN_H
+
+#include "nghttp2_config.h"
+
+#include <cstdint>
+#include <string>
+
+#include "sofaload/plugin.h"
+
+namespace h2load {
+
+// A --plugin library, loaded with dlopen(3).  It is never unloaded,
+// since the workers may still hold its functions when it goes away.
+class Plugin {
+  public:
+    Plugin();
+
+    // Loads the library at |path|, and looks up the functions of
+    // sofaload/plugin.h.  Returns 0 if it succeeds, or -1 after
+    // printing the error.
+    int load(const std::string &path);
+    // Returns the context of worker |worker_id| of |nworkers|, or
+    // nullptr after printing the error.
+    void *init(uint32_t worker_id, uint32_t nworkers, const std::string &arg);
+    void free(void *ctx);
+
+    sofaload_plugin_fill_func fill() const { return fill_; }
+
+  private:
+    sofaload_plugin_init_func init_;
+    sofaload_plugin_fill_func fill_;
+    sofaload_plugin_free_func free_;
+};
+
+} // namespace h2load
+
+#endif // H2LOAD_PLUGIN_H
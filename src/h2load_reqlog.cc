@@ -0,0 +1,175 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_reqlog.h"
+
+#include <chrono>
+#include <iostream>
+
+#include "h2load_sofarpc_spec.h"
+#include "util.h"
+
+using namespace nghttp2;
+
+namespace h2load {
+
+namespace {
+// How long the writer sleeps between drains
+constexpr auto DRAIN_INTERVAL = std::chrono::milliseconds(50);
+} // namespace
+
+namespace {
+const char *bolt_type_name(uint8_t type) {
+    switch (type) {
+    case RESPONSE:
+        return "response";
+    case REQUEST:
+        return "request";
+    case REQUEST_ONEWAY:
+        return "oneway";
+    default:
+        return "unknown";
+    }
+}
+
+const char *bolt_cmdcode_name(uint16_t cmdcode) {
+    switch (cmdcode) {
+    case HEARTBEAT:
+        return "heartbeat";
+    case RPC_REQUEST:
+        return "rpc_request";
+    case RPC_RESPONSE:
+        return "rpc_response";
+    default:
+        return "unknown";
+    }
+}
+} // namespace
+
+std::string format_reqlog_record(const ReqLogRecord &rec,
+                                 const std::vector<std::string> &names,
+                                 bool sofarpc) {
+    std::string s = util::iso8601_date(rec.send_time / 1000000);
+    s += " worker=";
+    s += util::utos(rec.worker_id);
+    s += " conn=";
+    s += util::utos(rec.conn_id);
+    s += " stream=";
+    s += util::utos(rec.stream_id);
+    s += " request=";
+    s += rec.tmpl < names.size() ? names[rec.tmpl] : util::utos(rec.tmpl);
+    s += " rtt=";
+    s += util::format_duration(rec.rtt / 1e9);
+    s += " status=";
+    if (rec.status == -1) {
+        s += "-";
+    } else if (sofarpc) {
+        s += sofarpc_status_name(rec.status);
+    } else {
+        s += util::utos(rec.status);
+    }
+    if (rec.timedout) {
+        s += " timedout";
+    } else if (!rec.completed) {
+        s += " reset";
+    } else if (!rec.status_success) {
+        s += " failed";
+    }
+    if (rec.has_bolt) {
+        auto &b = rec.bolt;
+        s += " bolt=[proto=";
+        s += util::utos(b.proto);
+        s += " type=";
+        s += bolt_type_name(b.type);
+        s += " cmdcode=";
+        s += bolt_cmdcode_name(b.cmdcode);
+        s += " codec=";
+        s += util::utos(b.codec);
+        if (b.proto == PROTOCOL_CODE_V2) {
+            s += " switch=";
+            s += util::utos(b.switches);
+        }
+        s += " respstatus=";
+        s += util::utos(b.respstatus);
+        s += " classlen=";
+        s += util::utos(b.classlen);
+        s += " headerlen=";
+        s += util::utos(b.headerlen);
+        s += " contentlen=";
+        s += util::utos(b.contentlen);
+        s += "]";
+    }
+    s += "\n";
+    return s;
+}
+
+RequestLogWriter::RequestLogWriter(const std::vector<std::string> &names,
+                                   bool sofarpc)
+    : names_(names), done_(false), sofarpc_(sofarpc) {}
+
+RequestLogWriter::~RequestLogWriter() {
+    if (thread_.joinable()) {
+        stop();
+    }
+}
+
+int RequestLogWriter::open(const std::string &path) {
+    out_.open(path);
+    if (!out_) {
+        std::cerr << "--request-log: cannot open " << path << std::endl;
+        return -1;
+    }
+    return 0;
+}
+
+void RequestLogWriter::add_queue(SpscQueue<ReqLogRecord> *q) {
+    queues_.push_back(q);
+}
+
+void RequestLogWriter::start() { thread_ = std::thread([this] { run(); }); }
+
+void RequestLogWriter::stop() {
+    done_.store(true);
+    thread_.join();
+}
+
+void RequestLogWriter::run() {
+    while (!done_.load()) {
+        std::this_thread::sleep_for(DRAIN_INTERVAL);
+        drain();
+    }
+    drain();
+    out_.flush();
+}
+
+void RequestLogWriter::drain() {
+    ReqLogRecord rec;
+    for (auto q : queues_) {
+        while (q->pop(rec)) {
+            out_ << format_reqlog_record(rec, names_, sofarpc_);
+        }
+    }
+}
+
+} // namespace h2load
@@ -0,0 +1,107 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_REQLOG_H
+#define H2LOAD_REQLOG_H
+
+#include "nghttp2_config.h"
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sofarpc.h"
+#include "spsc_queue.h"
+
+namespace h2load {
+
+// A request picked by --request-log.  Workers fill it in when the
+// request is done, and RequestLogWriter decodes it off the hot path.
+struct ReqLogRecord {
+    // The wall clock time the request was sent, in nanoseconds since
+    // the epoch
+    int64_t send_time;
+    // Nanoseconds from sending the request to the close of its stream
+    uint64_t rtt;
+    uint32_t worker_id;
+    uint32_t conn_id;
+    int32_t stream_id;
+    // The index of the request template which was sent
+    uint32_t tmpl;
+    // HTTP status code or SofaRPC response status, or -1 if no
+    // response arrived
+    int32_t status;
+    // true if the request was not reset
+    bool completed;
+    // true if the response status was a success
+    bool status_success;
+    bool timedout;
+    // true if |bolt| has the header of the SofaRPC response
+    bool has_bolt;
+    BoltResponseHeader bolt;
+};
+
+// Returns the line of --request-log for |rec|, which ends with a
+// newline.  |names| are the names of the request templates, and
+// |sofarpc| tells how to read the status.
+std::string format_reqlog_record(const ReqLogRecord &rec,
+                                 const std::vector<std::string> &names,
+                                 bool sofarpc);
+
+// RequestLogWriter drains the --request-log queues of the workers in
+// a thread of its own, and writes their records to a file.
+class RequestLogWriter {
+  public:
+    RequestLogWriter(const std::vector<std::string> &names, bool sofarpc);
+    ~RequestLogWriter();
+
+    // Creates |path|.  Returns 0 if it succeeds, or -1 after printing
+    // the error.
+    int open(const std::string &path);
+    // Adds the queue of a worker.  All queues must be added before
+    // start().
+    void add_queue(nghttp2::SpscQueue<ReqLogRecord> *q);
+    void start();
+    // Writes the records left in the queues, and stops the thread.
+    void stop();
+
+  private:
+    void run();
+    // Writes the records in the queues so far.
+    void drain();
+
+    std::vector<std::string> names_;
+    std::vector<nghttp2::SpscQueue<ReqLogRecord> *> queues_;
+    std::ofstream out_;
+    std::thread thread_;
+    std::atomic<bool> done_;
+    bool sofarpc_;
+};
+
+} // namespace h2load
+
+#endif // H2LOAD_REQLOG_H
@@ -0,0 +1,99 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_reqlog_test.h"
+
+#include <string>
+#include <vector>
+
+#include <CUnit/CUnit.h>
+
+#include "h2load_reqlog.h"
+
+namespace h2load {
+
+namespace {
+// Returns the line of |rec| without the send time.
+std::string format(const ReqLogRecord &rec, bool sofarpc) {
+    std::vector<std::string> names{"echoStr", "echoInt"};
+    auto s = format_reqlog_record(rec, names, sofarpc);
+    auto sp = s.find(' ');
+    return sp == std::string::npos ? s : s.substr(sp + 1);
+}
+} // namespace
+
+void test_reqlog_format_record(void) {
+    ReqLogRecord rec{};
+    rec.rtt = 2500000;
+    rec.worker_id = 1;
+    rec.conn_id = 7;
+    rec.stream_id = 42;
+    rec.tmpl = 1;
+    rec.status = RESPONSE_STATUS_SERVER_THREADPOOL_BUSY;
+    rec.completed = true;
+    rec.has_bolt = true;
+    rec.bolt.proto = PROTOCOL_CODE_V2;
+    rec.bolt.type = RESPONSE;
+    rec.bolt.cmdcode = RPC_RESPONSE;
+    rec.bolt.codec = HESSIAN2_SERIALIZE;
+    rec.bolt.switches = PROTOCOL_SWITCH_CRC;
+    rec.bolt.respstatus = RESPONSE_STATUS_SERVER_THREADPOOL_BUSY;
+    rec.bolt.headerlen = 16;
+    rec.bolt.contentlen = 3000;
+
+    CU_ASSERT("worker=1 conn=7 stream=42 request=echoInt rtt=2.50ms "
+              "status=server_threadpool_busy failed bolt=[proto=2 "
+              "type=response cmdcode=rpc_response codec=1 switch=1 "
+              "respstatus=4 classlen=0 headerlen=16 contentlen=3000]\n" ==
+              format(rec, true));
+
+    // V1 has no switch.
+    rec.bolt.proto = PROTOCOL_CODE_V1;
+    rec.status = RESPONSE_STATUS_SUCCESS;
+    rec.status_success = true;
+    rec.bolt.respstatus = RESPONSE_STATUS_SUCCESS;
+    CU_ASSERT("worker=1 conn=7 stream=42 request=echoInt rtt=2.50ms "
+              "status=success bolt=[proto=1 type=response "
+              "cmdcode=rpc_response codec=1 respstatus=0 classlen=0 "
+              "headerlen=16 contentlen=3000]\n" == format(rec, true));
+
+    // A request without response
+    ReqLogRecord reset{};
+    reset.rtt = 1000;
+    reset.tmpl = 5;
+    reset.status = -1;
+    reset.timedout = true;
+    CU_ASSERT("worker=0 conn=0 stream=0 request=5 rtt=1us status=- "
+              "timedout\n" == format(reset, true));
+
+    // HTTP status codes are written as they are.
+    ReqLogRecord http{};
+    http.rtt = 1500000000;
+    http.status = 503;
+    http.completed = true;
+    CU_ASSERT("worker=0 conn=0 stream=0 request=echoStr rtt=1.50s "
+              "status=503 failed\n" == format(http, false));
+}
+
+} // namespace h2load
@@ -0,0 +1,102 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_scenario.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "util.h"
+
+using namespace nghttp2;
+
+namespace h2load {
+
+int parse_scenario(std::vector<ScenarioStep> &steps, std::istream &in,
+                   const std::string &path,
+                   const std::vector<std::string> &names) {
+    size_t lineno = 0;
+    auto error = [&path, &lineno](const std::string &msg) {
+        std::cerr << "--scenario: " << path << ":" << lineno << ": " << msg
+                  << std::endl;
+        return -1;
+    };
+
+    for (std::string line; std::getline(in, line);) {
+        ++lineno;
+
+        std::istringstream words(line);
+        std::string name;
+        if (!(words >> name) || name[0] == '#') {
+            continue;
+        }
+
+        auto it = std::find(std::begin(names), std::end(names), name);
+        if (it == std::end(names)) {
+            return error("unknown request " + name);
+        }
+
+        ScenarioStep step{static_cast<size_t>(it - std::begin(names)), 1, 0.};
+        for (std::string word; words >> word;) {
+            if (word[0] == 'x') {
+                auto n = util::parse_uint(word.substr(1));
+                if (n < 1) {
+                    return error("bad count " + word);
+                }
+                step.count = n;
+            } else if (word.compare(0, 6, "think=") == 0) {
+                auto d = util::parse_duration_with_unit(word.c_str() + 6);
+                if (!std::isfinite(d) || d < 0.) {
+                    return error("bad think time " + word);
+                }
+                step.think = d;
+            } else {
+                return error("unknown field " + word);
+            }
+        }
+
+        steps.push_back(step);
+    }
+
+    if (steps.empty()) {
+        return error("no step is given");
+    }
+
+    return 0;
+}
+
+int read_scenario(std::vector<ScenarioStep> &steps, const std::string &path,
+                  const std::vector<std::string> &names) {
+    std::ifstream f(path);
+    if (!f) {
+        std::cerr << "--scenario: cannot open " << path << std::endl;
+        return -1;
+    }
+    return parse_scenario(steps, f, path, names);
+}
+
+} // namespace h2load
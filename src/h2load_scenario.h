@@ -0,0 +1,63 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_SCENARIO_H
+#define H2LOAD_SCENARIO_H
+
+#include "nghttp2_config.h"
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace h2load {
+
+// A step of --scenario: |count| requests of request template |tmpl|,
+// sent together, and the time in seconds waited after all of them
+// are answered.
+struct ScenarioStep {
+    size_t tmpl;
+    size_t count;
+    double think;
+};
+
+// Reads the steps of --scenario from |in| into |steps|.  Each line is
+// a step "<REQUEST> [x<N>] [think=<DURATION>]", where <REQUEST> is
+// one of |names|, the names the report gives the request templates.
+// Empty lines and lines starting with '#' are skipped.  |path| names
+// |in| in errors.  Returns 0 if it succeeds, or -1 after printing the
+// error.
+int parse_scenario(std::vector<ScenarioStep> &steps, std::istream &in,
+                   const std::string &path,
+                   const std::vector<std::string> &names);
+
+// Reads the steps of --scenario from the file at |path|, as
+// parse_scenario() does.
+int read_scenario(std::vector<ScenarioStep> &steps, const std::string &path,
+                  const std::vector<std::string> &names);
+
+} // namespace h2load
+
+#endif // H2LOAD_SCENARIO_H
@@ -0,0 +1,68 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_scenario_test.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <CUnit/CUnit.h>
+
+#include "h2load_scenario.h"
+
+namespace h2load {
+
+void test_scenario_parse(void) {
+    std::vector<std::string> names{"login", "getProfile", "query", "logout"};
+    {
+        std::istringstream in("# a session\n"
+                              "login think=100ms\n"
+                              "\n"
+                              "getProfile\n"
+                              "query x3 think=2s\n"
+                              "  logout  \n");
+        std::vector<ScenarioStep> steps;
+        CU_ASSERT(0 == parse_scenario(steps, in, "s", names));
+        CU_ASSERT(4 == steps.size());
+        CU_ASSERT(0 == steps[0].tmpl);
+        CU_ASSERT(1 == steps[0].count);
+        CU_ASSERT(0.1 == steps[0].think);
+        CU_ASSERT(1 == steps[1].tmpl);
+        CU_ASSERT(0. == steps[1].think);
+        CU_ASSERT(2 == steps[2].tmpl);
+        CU_ASSERT(3 == steps[2].count);
+        CU_ASSERT(2. == steps[2].think);
+        CU_ASSERT(3 == steps[3].tmpl);
+    }
+
+    for (auto bad : {"", "# nothing\n", "search\n", "query x0\n",
+                     "query 3\n", "query think=x\n"}) {
+        std::istringstream in(bad);
+        std::vector<ScenarioStep> steps;
+        CU_ASSERT(-1 == parse_scenario(steps, in, "s", names));
+    }
+}
+
+} // namespace h2load
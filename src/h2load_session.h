@@ -35,8 +35,14 @@
 
 namespace h2load {
 
+// The protocol of a Session.  Client dispatches the per-request
+// calls on it to the concrete class directly (see visit_session() in
+// h2load.cc), so that they can be inlined.
+enum class SessionKind { HTTP1, HTTP2, SOFARPC };
+
 class Session {
   public:
+    explicit Session(SessionKind kind) : kind(kind) {}
     virtual ~Session() {}
     // Called when the connection was made.
     virtual void on_connect() = 0;
@@ -52,6 +58,17 @@ class Session {
     virtual void terminate() = 0;
     // Return the maximum concurrency per connection
     virtual size_t max_concurrent_streams() = 0;
+    // Called when a PING must be sent.  Returns 0 on success, or -1 if
+    // the protocol has no PING.  The subclass calls
+    // Client::on_ping_ack() when the answer arrives.
+    virtual int submit_ping() = 0;
+    // Called when the request on |stream_id| passed its deadline.
+    // Returns 0 if the subclass closes the stream, now or later, with
+    // Client::on_stream_close(), or -1 if the protocol cannot give up
+    // a request without closing the connection.
+    virtual int cancel_stream(int32_t stream_id) = 0;
+
+    const SessionKind kind;
 };
 
 } // namespace h2load
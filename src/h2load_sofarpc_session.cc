@@ -24,14 +24,55 @@
  */
 #include "h2load_sofarpc_session.h"
 
+#include <algorithm>
 #include <iostream>
 
+#include "crc32.h"
+
 namespace h2load {
 
+namespace {
+// The number of oneway requests which can be queued unwritten on a
+// cleartext connection.  Together with BACKOFF_WRITE_BUFFER_THRES,
+// this keeps the socket buffer full with small requests.
+constexpr size_t ONEWAY_MAX_QUEUED = 128;
+} // namespace
+
 SofaRpcSession::SofaRpcSession(Client *client)
-    : client_(client), stream_req_counter_(1),
-      read_buffer_(&client->worker->mcpool), bytes_to_discard_(0),
-      last_stream_id_(-1), last_respstatus_(-1), terminate_(false) {}
+    : Session(SessionKind::SOFARPC), stream_req_counter_(1),
+      header_buflen_(0), bytes_to_discard_(0), hdmap_left_(0),
+      content_left_(0), crc_left_(0), resp_crc_(0), terminate_(false),
+      last_stream_id_(-1), last_respstatus_(-1), last_heartbeat_(false),
+      last_stream_end_(false), last_header_{},
+      use_template_(client->ssl == nullptr),
+      version_(client->worker->config->bolt_version),
+      req_hdlen_(bolt_request_header_len(version_)),
+      resp_hdlen_(bolt_response_header_len(version_)),
+      crc_(client->worker->config->bolt_crc), max_slots_(0),
+      oneway_(client->worker->config->oneway), qps_held_(false),
+      client_(client) {
+    for (auto &req : client->worker->config->sofarpcreqs) {
+        max_slots_ = std::max(max_slots_, req.head_slots.size() +
+                                              req.content_slots.size());
+    }
+    if (use_template_ && client_->wq.iovs.empty()) {
+        // Each request in flight takes a header, the shared class name
+        // and header map, and content entries, plus one for CRC32 with
+        // --bolt-crc, and a HEARTBEAT takes one more.  Oneway requests
+        // are not in flight, but only queued until they are written.
+        auto nreq = max_concurrent_streams();
+        if (oneway_) {
+            nreq = std::max(nreq, ONEWAY_MAX_QUEUED);
+        }
+        if (client_->worker->config->has_calls()) {
+            // Hedges and retries of other connections come on top, up
+            // to as many again, and users go on while the losers of
+            // their calls are still in flight.
+            nreq *= 4;
+        }
+        client_->wq.init(request_wq_entries() * nreq + 1);
+    }
+}
 
 SofaRpcSession::~SofaRpcSession() {}
 
@@ -39,31 +80,273 @@ void SofaRpcSession::on_connect() {
     client_->signal_write();
 }
 
+size_t SofaRpcSession::request_wq_entries() const {
+    // Each slot splits a shared entry in two, around its own.
+    return (crc_ ? 4 : 3) + 2 * max_slots_;
+}
+
+void SofaRpcSession::write_request_header(uint8_t *hd, const uint8_t *tmpl,
+                                          int32_t stream_id) {
+    std::copy_n(tmpl, req_hdlen_, hd);
+    // V2 has the protocol version before the request id.
+    util::putBigEndianI32(reinterpret_cast<char *>(hd + (version_ == 2 ? 6 : 5)),
+                          stream_id);
+}
+
 int SofaRpcSession::submit_request() {
     auto config = client_->worker->config;
-    const auto &req = config->sofarpcreqs[client_->reqidx];
 
-    client_->reqidx++;
-    if (client_->reqidx == config->sofarpcreqs.size()) {
-        client_->reqidx = 0;
+    if (use_template_ && client_->wq.wleft() < request_wq_entries()) {
+        return -1;
     }
 
+    auto reqidx = client_->next_template(config->sofarpcreqs.size());
+    const auto &req = config->sofarpcreqs[reqidx];
+
     int stream_id = stream_req_counter_++;
-    client_->on_request(stream_id);
+    qps_held_ = false;
+    RequestStat *req_stat = nullptr;
+    if (oneway_) {
+        client_->on_oneway_request(reqidx);
+    } else {
+        client_->on_request(stream_id, reqidx);
+
+        req_stat = client_->get_req_stat(stream_id);
+    }
+
+    if (!req.head_slots.empty() || !req.content_slots.empty()) {
+        client_->worker->subst.next();
+    }
 
-    auto req_stat = client_->get_req_stat(stream_id);
-    client_->record_request_time(req_stat);
+    // Only the request header and the substitution slots are written
+    // per request, so that the request id can be patched.  The rest of
+    // the serialized request is shared.
+    auto tmpl = reinterpret_cast<const uint8_t *>(req.head.c_str());
 
-    char *bytes = new char[req.size()];
-    std::memcpy(bytes, req.c_str(), req.size());
-    util::putBigEndianI32(&bytes[5], stream_id);
+    auto hd = use_template_ ? client_->wq.push_slot(req_hdlen_)
+                            : client_->wb.append_slot(req_hdlen_);
+    write_request_header(hd, tmpl, stream_id);
 
-    client_->wb.append(bytes, req.size());
-    delete[] bytes;
+    uint32_t crc = crc_ ? update_crc32(0, hd, req_hdlen_) : 0;
+    push_body(tmpl + req_hdlen_, req.head.size() - req_hdlen_, req_hdlen_,
+              req.head_slots, false, crc);
+    // The content may be large, and mapped from a file.
+    push_body(req.content(), req.contentlen, 0, req.content_slots, true, crc);
+
+    if (crc_) {
+        auto p = use_template_ ? client_->wq.push_slot(CRC32_LEN)
+                               : client_->wb.append_slot(CRC32_LEN);
+        util::putBigEndianI32(reinterpret_cast<char *>(p), crc);
+    }
+
+    // After the slots are filled, so that the time a --plugin takes
+    // is not counted.
+    if (req_stat) {
+        client_->record_request_time(req_stat);
+    }
 
     return 0;
 }
 
+void SofaRpcSession::push_body(const uint8_t *data, size_t len, size_t base,
+                               const std::vector<SubstSlot> &slots, bool ref,
+                               uint32_t &crc) {
+    auto push = [this, ref, &crc](const uint8_t *p, size_t n) {
+        if (n == 0) {
+            return;
+        }
+        if (crc_) {
+            crc = update_crc32(crc, p, n);
+        }
+        if (use_template_) {
+            client_->wq.push_ref(p, n);
+        } else if (ref) {
+            client_->wb.append_ref(p, n);
+        } else {
+            client_->wb.append(p, n);
+        }
+    };
+
+    auto &subst = client_->worker->subst;
+    size_t pos = 0;
+    for (auto &slot : slots) {
+        auto offset = slot.offset - base;
+        push(data + pos, offset - pos);
+        auto p = use_template_ ? client_->wq.push_slot(slot.width)
+                               : client_->wb.append_slot(slot.width);
+        subst.fill(p, slot);
+        if (crc_) {
+            crc = update_crc32(crc, p, slot.width);
+        }
+        pos = offset + slot.width;
+    }
+    push(data + pos, len - pos);
+}
+
+void SofaRpcSession::on_response_header(const uint8_t *hd) {
+    last_stream_id_ = version_ == 2
+                          ? parse_bolt_response_header<2>(last_header_, hd)
+                          : parse_bolt_response_header<1>(last_header_, hd);
+
+    auto switches = last_header_.switches;
+    auto classLen = last_header_.classlen;
+    auto headerLen = last_header_.headerlen;
+    auto contentLen = last_header_.contentlen;
+
+    last_respstatus_ = last_header_.respstatus;
+    last_heartbeat_ = last_header_.cmdcode == HEARTBEAT;
+    last_stream_end_ = false;
+
+    client_->worker->stats.bytes_head += resp_hdlen_;
+    client_->worker->stats.bytes_head_decomp += resp_hdlen_;
+
+    if (!client_->worker->config->stream_end_header.empty() &&
+        headerLen != 0 && !last_heartbeat_) {
+        // The header map tells whether the stream ends here.
+        bytes_to_discard_ = classLen;
+        hdmap_buf_.clear();
+        hdmap_left_ = headerLen;
+        content_left_ = contentLen;
+    } else {
+        bytes_to_discard_ =
+            static_cast<size_t>(classLen) + headerLen + contentLen;
+    }
+
+    if (switches & PROTOCOL_SWITCH_CRC) {
+        crc_left_ = CRC32_LEN;
+        resp_crc_ = update_crc32(0, hd, resp_hdlen_);
+    }
+}
+
+void SofaRpcSession::on_response_complete() {
+    if (last_heartbeat_) {
+        client_->on_ping_ack();
+        return;
+    }
+
+    if (!client_->streams.find(last_stream_id_)) {
+        // The stream has been closed already, by an error or by
+        // --request-timeout.
+        return;
+    }
+
+    auto success = last_respstatus_ == RESPONSE_STATUS_SUCCESS;
+    auto config = client_->worker->config;
+    if (config->response_sizes) {
+        auto &hd = last_header_;
+        auto body = static_cast<size_t>(hd.classlen) + hd.headerlen +
+                    hd.contentlen;
+        auto crc = (hd.switches & PROTOCOL_SWITCH_CRC) ? CRC32_LEN : 0;
+        client_->on_response_bytes(last_stream_id_, resp_hdlen_ + body + crc,
+                                   hd.headerlen, hd.classlen, hd.contentlen);
+    }
+    if (config->is_stream_mode()) {
+        auto n = client_->on_stream_message(last_stream_id_);
+        // An error ends a server stream wherever it is.
+        if (success && !last_stream_end_ &&
+            (config->stream_messages == 0 || n < config->stream_messages)) {
+            return;
+        }
+    }
+
+    client_->on_sofarpc_status(last_stream_id_, last_respstatus_);
+    client_->on_stream_close(last_stream_id_, success);
+}
+
+template <int Version>
+const uint8_t *SofaRpcSession::read_frames(const uint8_t *first,
+                                           const uint8_t *last) {
+    constexpr auto l = bolt_response_layout(Version);
+    auto &stats = client_->worker->stats;
+    auto hdmap = !client_->worker->config->stream_end_header.empty();
+    size_t head = 0, body = 0;
+
+    while (static_cast<size_t>(last - first) >= l.len) {
+        BoltResponseHeader hd;
+        auto stream_id = parse_bolt_response_header<Version>(hd, first);
+        auto bodylen =
+            static_cast<size_t>(hd.classlen) + hd.headerlen + hd.contentlen;
+        size_t crclen = (hd.switches & PROTOCOL_SWITCH_CRC) ? CRC32_LEN : 0;
+        // A response split over reads, or whose header map has to be
+        // looked up for --stream-end-header, is left to on_read().
+        if (static_cast<size_t>(last - first) < l.len + bodylen + crclen ||
+            (hdmap && hd.headerlen != 0 && hd.cmdcode != HEARTBEAT)) {
+            break;
+        }
+        if (crclen && bolt_load32(first + l.len + bodylen) !=
+                          update_crc32(0, first, l.len + bodylen)) {
+            std::cerr << "[ERROR] Bolt response CRC32 mismatch" << std::endl;
+            return nullptr;
+        }
+
+        last_header_ = hd;
+        last_stream_id_ = stream_id;
+        last_respstatus_ = hd.respstatus;
+        last_heartbeat_ = hd.cmdcode == HEARTBEAT;
+        last_stream_end_ = false;
+
+        first += l.len + bodylen + crclen;
+        head += l.len + crclen;
+        body += bodylen;
+
+        on_response_complete();
+    }
+
+    stats.bytes_head += head;
+    stats.bytes_head_decomp += head;
+    stats.bytes_body += body;
+
+    return first;
+}
+
+bool SofaRpcSession::body_left() const {
+    return bytes_to_discard_ != 0 || hdmap_left_ != 0;
+}
+
+const uint8_t *SofaRpcSession::read_body(const uint8_t *first,
+                                         const uint8_t *last) {
+    auto &stats = client_->worker->stats;
+    for (;;) {
+        if (bytes_to_discard_ != 0) {
+            auto n = std::min(bytes_to_discard_,
+                              static_cast<size_t>(last - first));
+            if (crc_left_) {
+                resp_crc_ = update_crc32(resp_crc_, first, n);
+            }
+            first += n;
+            bytes_to_discard_ -= n;
+            stats.bytes_body += n;
+
+            if (bytes_to_discard_ != 0) {
+                return first;
+            }
+        }
+
+        if (hdmap_left_ == 0) {
+            return first;
+        }
+
+        auto n = std::min(hdmap_left_, static_cast<size_t>(last - first));
+        if (crc_left_) {
+            resp_crc_ = update_crc32(resp_crc_, first, n);
+        }
+        hdmap_buf_.append(reinterpret_cast<const char *>(first), n);
+        first += n;
+        hdmap_left_ -= n;
+        stats.bytes_body += n;
+
+        if (hdmap_left_ != 0) {
+            return first;
+        }
+
+        last_stream_end_ = bolt_header_map_has(
+            reinterpret_cast<const uint8_t *>(hdmap_buf_.data()),
+            hdmap_buf_.size(), client_->worker->config->stream_end_header);
+        bytes_to_discard_ = content_left_;
+        content_left_ = 0;
+    }
+}
+
 int SofaRpcSession::on_read(const uint8_t *data, size_t len) {
 
     if (client_->worker->config->verbose) {
@@ -71,55 +354,135 @@ int SofaRpcSession::on_read(const uint8_t *data, size_t len) {
     }
     client_->record_ttfb();
 
-    read_buffer_.append(data, len);
+    auto first = data;
+    auto last = data + len;
 
     for (;;) {
-        if (bytes_to_discard_ != 0) {
-            size_t bytes_to_drain = std::min(bytes_to_discard_, read_buffer_.rleft());
-            read_buffer_.drain(bytes_to_drain);
-            client_->worker->stats.bytes_body += bytes_to_drain;
-            bytes_to_discard_ -= bytes_to_drain;
-
-            auto req_stat = client_->get_req_stat(last_stream_id_);
-            if (!req_stat || req_stat->data_offset >= client_->worker->config->data_length) {
-                client_->on_stream_close(last_stream_id_, last_respstatus_ == RESPONSE_STATUS_SUCCESS);
+        if (body_left()) {
+            first = read_body(first, last);
+
+            if (body_left()) {
+                break;
+            }
+
+            if (crc_left_ == 0) {
+                on_response_complete();
             }
         }
-        if (read_buffer_.rleft() >= RESPONSE_HEADER_LEN_V1) {
-            char bytes[RESPONSE_HEADER_LEN_V1];
-            read_buffer_.remove(bytes, RESPONSE_HEADER_LEN_V1);
 
-            int32_t requestId = util::getBigEndianI32(&bytes[5]);
-            uint16_t respstatus = util::getBigEndianI16(&bytes[10]);
-            uint16_t classLen = util::getBigEndianI16(&bytes[12]);
-            uint16_t headerLen = util::getBigEndianI16(&bytes[14]);
-            uint32_t contentLen = util::getBigEndianI32(&bytes[16]);
+        if (crc_left_ != 0) {
+            auto n = std::min(crc_left_, static_cast<size_t>(last - first));
+            std::copy_n(first, n, std::end(crc_buf_) - crc_left_);
+            first += n;
+            crc_left_ -= n;
+
+            if (crc_left_ != 0) {
+                break;
+            }
 
-            last_stream_id_ = requestId;
-            last_respstatus_ = respstatus;
+            client_->worker->stats.bytes_head += CRC32_LEN;
+            client_->worker->stats.bytes_head_decomp += CRC32_LEN;
 
-            client_->on_sofarpc_status(requestId, respstatus);
+            if (static_cast<uint32_t>(util::getBigEndianI32(
+                    reinterpret_cast<const char *>(crc_buf_.data()))) !=
+                resp_crc_) {
+                std::cerr << "[ERROR] Bolt response CRC32 mismatch"
+                          << std::endl;
+                return -1;
+            }
 
-            client_->worker->stats.bytes_head += RESPONSE_HEADER_LEN_V1;
-            client_->worker->stats.bytes_head_decomp += RESPONSE_HEADER_LEN_V1;
+            on_response_complete();
+        }
 
-            int bodyLen = classLen + headerLen + contentLen;
-            bytes_to_discard_ = bodyLen;
-        } else {
+        if (first == last) {
             break;
         }
+
+        if (header_buflen_ == 0) {
+            first = version_ == 2 ? read_frames<2>(first, last)
+                                  : read_frames<1>(first, last);
+            if (!first) {
+                return -1;
+            }
+            if (first == last) {
+                break;
+            }
+        }
+
+        const uint8_t *hd;
+
+        if (header_buflen_ == 0 &&
+            static_cast<size_t>(last - first) >= resp_hdlen_) {
+            // Fast path: the whole header is in |data|.
+            hd = first;
+            first += resp_hdlen_;
+        } else {
+            auto n = std::min(resp_hdlen_ - header_buflen_,
+                              static_cast<size_t>(last - first));
+            std::copy_n(first, n, std::begin(header_buf_) + header_buflen_);
+            first += n;
+            header_buflen_ += n;
+
+            if (header_buflen_ < resp_hdlen_) {
+                break;
+            }
+
+            header_buflen_ = 0;
+            hd = header_buf_.data();
+        }
+
+        on_response_header(hd);
+
+        if (!body_left() && crc_left_ == 0) {
+            on_response_complete();
+        }
     }
 
     return 0;
 }
 
 int SofaRpcSession::on_write() {
+    if (oneway_) {
+        submit_oneway();
+        // Let the requests queued go out before tearing the connection
+        // down.
+        if (terminate_ &&
+            client_->wb.rleft() + client_->wq.rleft() == 0) {
+            return -1;
+        }
+        return 0;
+    }
     if (terminate_) {
         return -1;
     }
     return 0;
 }
 
+void SofaRpcSession::submit_oneway() {
+    auto worker = client_->worker;
+    while (!terminate_ && !qps_held_ &&
+           client_->wb.rleft() + client_->wq.rleft() <
+               BACKOFF_WRITE_BUFFER_THRES) {
+        if (use_template_ && client_->wq.wleft() < request_wq_entries()) {
+            return;
+        }
+        if (worker->requests_exhausted()) {
+            terminate_ = true;
+            return;
+        }
+        auto counter = stream_req_counter_;
+        if (client_->submit_request() != 0) {
+            client_->process_request_failure();
+            return;
+        }
+        if (stream_req_counter_ == counter) {
+            // The worker has queued this connection for more quota.
+            qps_held_ = true;
+            return;
+        }
+    }
+}
+
 void SofaRpcSession::terminate() {
     terminate_ = true;
 }
@@ -128,4 +491,55 @@ size_t SofaRpcSession::max_concurrent_streams() {
     return (size_t)client_->worker->config->max_concurrent_streams;
 }
 
+int SofaRpcSession::submit_ping() {
+    if (use_template_ && client_->wq.wleft() < 1) {
+        return -1;
+    }
+
+    // A HEARTBEAT request is a bare header.  It takes a request id
+    // from the same counter as requests, so that its answer is never
+    // mistaken for that of a request.
+    std::array<uint8_t, REQUEST_HEADER_LEN_V2 + CRC32_LEN> hd{};
+    auto p = reinterpret_cast<char *>(hd.data());
+    if (version_ == 2) {
+        p[0] = PROTOCOL_CODE_V2;
+        p[1] = PROTOCOL_VERSION_1;
+        p[11] = crc_ ? PROTOCOL_SWITCH_CRC : 0;
+        ++p;
+    } else {
+        p[0] = PROTOCOL_CODE_V1;
+    }
+    p[1] = REQUEST;
+    util::putBigEndianI16(&p[2], HEARTBEAT);
+    p[4] = PROTOCOL_VERSION_1;
+    util::putBigEndianI32(&p[5], stream_req_counter_++);
+    p[9] = HESSIAN2_SERIALIZE;
+
+    auto len = req_hdlen_;
+    if (crc_) {
+        util::putBigEndianI32(reinterpret_cast<char *>(&hd[len]),
+                              update_crc32(0, hd.data(), len));
+        len += CRC32_LEN;
+    }
+
+    if (use_template_) {
+        // The header and CRC32 share a slot.
+        auto slot = client_->wq.push_slot(len);
+        std::copy_n(std::begin(hd), len, slot);
+
+        return 0;
+    }
+
+    client_->wb.append(hd.data(), len);
+
+    return 0;
+}
+
+int SofaRpcSession::cancel_stream(int32_t stream_id) {
+    // Requests are matched to responses by id, so the late response
+    // is just skipped.
+    client_->on_stream_close(stream_id, false);
+    return 0;
+}
+
 } // namespace h2load
@@ -26,13 +26,17 @@
 #define H2LOAD_SOFARPC_SESSION_H
 
 #include "h2load_session.h"
+
+#include <array>
+
+#include "h2load_sofarpc_spec.h"
 #include "sofarpc.h"
 
 namespace h2load {
 
 struct Client;
 
-class SofaRpcSession : public Session {
+class SofaRpcSession final : public Session {
   public:
     SofaRpcSession(Client *client);
     virtual ~SofaRpcSession();
@@ -42,17 +46,96 @@ class SofaRpcSession : public Session {
     virtual int on_write();
     virtual void terminate();
     virtual size_t max_concurrent_streams();
+    virtual int submit_ping();
+    virtual int cancel_stream(int32_t stream_id);
 
     int32_t stream_req_counter_;
-    DefaultMemchunks read_buffer_;
+    // Bolt response header which has been received partially.  Only
+    // the header is ever buffered; response bodies are skipped
+    // directly from the buffer passed to on_read().
+    std::array<uint8_t, RESPONSE_HEADER_LEN_V2> header_buf_;
+    size_t header_buflen_;
     size_t bytes_to_discard_;
+    // With --stream-end-header, the header map of the response being
+    // read, the number of its bytes yet to be read, and the length of
+    // the content which follows it.  Only the header map is buffered;
+    // the class name and content are skipped like other bodies.
+    std::string hdmap_buf_;
+    size_t hdmap_left_;
+    size_t content_left_;
+    // CRC32 trailer of the V2 response being read, which has been
+    // received partially
+    std::array<uint8_t, CRC32_LEN> crc_buf_;
+    // The number of bytes of CRC32 trailer yet to be read
+    size_t crc_left_;
+    // CRC32 of the V2 response being read so far, if it has a trailer
+    uint32_t resp_crc_;
 
     bool terminate_;
 
     int32_t last_stream_id_;
     short last_respstatus_;
+    // true if the response being read answers a HEARTBEAT
+    bool last_heartbeat_;
+    // true if the header map of the response being read has the key of
+    // --stream-end-header
+    bool last_stream_end_;
+    // The header of the response being read, for --request-log
+    BoltResponseHeader last_header_;
+
+    // true if requests are queued as a per-request header plus a
+    // reference to the shared request body (see Client::wq), rather
+    // than copied into Client::wb.  This is used for cleartext
+    // connections, because TLS writes one buffer at a time anyway.
+    bool use_template_;
 
   private:
+    void on_response_header(const uint8_t *hd);
+    void on_response_complete();
+    // Handles the responses which are complete in [|first|, |last|)
+    // in one pass, with the header layout of protocol version
+    // |Version| known at compile time.  Returns the position of the
+    // first response it left to the byte-wise path, or nullptr if a
+    // CRC32 check failed.
+    template <int Version>
+    const uint8_t *read_frames(const uint8_t *first, const uint8_t *last);
+    // Reads the response body in [|first|, |last|), and returns the
+    // position it stopped at.  The body is complete when
+    // body_left() returns false.
+    const uint8_t *read_body(const uint8_t *first, const uint8_t *last);
+    bool body_left() const;
+    // Writes the Bolt request header of |hdlen_| bytes for |stream_id|
+    // to |hd|, taking the other fields from |tmpl|.
+    void write_request_header(uint8_t *hd, const uint8_t *tmpl,
+                              int32_t stream_id);
+    // Returns the number of wq entries a request takes at most.
+    size_t request_wq_entries() const;
+    // Submits oneway requests until the socket pushes back, or --qps
+    // holds them.
+    void submit_oneway();
+    // Queues |len| bytes of the request at |data|, whose offset in the
+    // serialized request is |base|, with |slots| filled on the way.
+    // Unless they go to wq, they are copied to wb, or referred to if
+    // |ref| is true.  With --bolt-crc, |crc| is updated with them.
+    void push_body(const uint8_t *data, size_t len, size_t base,
+                   const std::vector<SubstSlot> &slots, bool ref,
+                   uint32_t &crc);
+
+    // Bolt protocol version, and the lengths of request and response
+    // headers
+    int version_;
+    size_t req_hdlen_;
+    size_t resp_hdlen_;
+    // true if CRC32 is appended to requests
+    bool crc_;
+    // The most substitution slots a request has
+    size_t max_slots_;
+    // true with --oneway
+    bool oneway_;
+    // true if --qps holds the next oneway request, until the worker
+    // submits it with more quota
+    bool qps_held_;
+
     Client *client_;
     //   nghttp2_session *session_;
 };
@@ -0,0 +1,562 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_sofarpc_spec.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+#include "hessian2.h"
+#include "sofarpc.h"
+#include "subst.h"
+#include "util.h"
+
+using namespace nghttp2;
+
+namespace h2load {
+
+namespace {
+// Hessian2 serialized SofaRequest of TestService.echoStr with a
+// string argument of 1098 digits
+const uint8_t DEFAULT_CONTENT[] = {
+    0x4f, 0xbc, 0x63, 0x6f, 0x6d, 0x2e, 0x61, 0x6c, 0x69, 0x70, 0x61,
+    0x79, 0x2e, 0x73, 0x6f, 0x66, 0x61, 0x2e, 0x72, 0x70, 0x63, 0x2e,
+    0x63, 0x6f, 0x72, 0x65, 0x2e, 0x72, 0x65, 0x71, 0x75, 0x65, 0x73,
+    0x74, 0x2e, 0x53, 0x6f, 0x66, 0x61, 0x52, 0x65, 0x71, 0x75, 0x65,
+    0x73, 0x74, 0x95, 0x0d, 0x74, 0x61, 0x72, 0x67, 0x65, 0x74, 0x41,
+    0x70, 0x70, 0x4e, 0x61, 0x6d, 0x65, 0x0a, 0x6d, 0x65, 0x74, 0x68,
+    0x6f, 0x64, 0x4e, 0x61, 0x6d, 0x65, 0x17, 0x74, 0x61, 0x72, 0x67,
+    0x65, 0x74, 0x53, 0x65, 0x72, 0x76, 0x69, 0x63, 0x65, 0x55, 0x6e,
+    0x69, 0x71, 0x75, 0x65, 0x4e, 0x61, 0x6d, 0x65, 0x0c, 0x72, 0x65,
+    0x71, 0x75, 0x65, 0x73, 0x74, 0x50, 0x72, 0x6f, 0x70, 0x73, 0x0d,
+    0x6d, 0x65, 0x74, 0x68, 0x6f, 0x64, 0x41, 0x72, 0x67, 0x53, 0x69,
+    0x67, 0x73, 0x6f, 0x90, 0x4e, 0x07, 0x65, 0x63, 0x68, 0x6f, 0x53,
+    0x74, 0x72, 0x1f, 0x63, 0x6f, 0x6d, 0x2e, 0x61, 0x6c, 0x69, 0x70,
+    0x61, 0x79, 0x2e, 0x74, 0x65, 0x73, 0x74, 0x2e, 0x54, 0x65, 0x73,
+    0x74, 0x53, 0x65, 0x72, 0x76, 0x69, 0x63, 0x65, 0x3a, 0x31, 0x2e,
+    0x30, 0x4d, 0x08, 0x70, 0x72, 0x6f, 0x74, 0x6f, 0x63, 0x6f, 0x6c,
+    0x04, 0x62, 0x6f, 0x6c, 0x74, 0x7a, 0x56, 0x74, 0x00, 0x07, 0x5b,
+    0x73, 0x74, 0x72, 0x69, 0x6e, 0x67, 0x6e, 0x01, 0x10, 0x6a, 0x61,
+    0x76, 0x61, 0x2e, 0x6c, 0x61, 0x6e, 0x67, 0x2e, 0x53, 0x74, 0x72,
+    0x69, 0x6e, 0x67, 0x7a, 0x53, 0x04, 0x4a, 0x31, 0x32, 0x33, 0x34,
+    0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
+    0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
+    0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+    0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+    0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
+    0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
+    0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
+    0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
+    0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
+    0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
+    0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+    0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+    0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
+    0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
+    0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
+    0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
+    0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
+    0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
+    0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+    0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+    0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
+    0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
+    0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
+    0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
+    0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
+    0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
+    0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+    0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+    0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
+    0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
+    0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
+    0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
+    0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
+    0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
+    0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+    0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+    0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
+    0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
+    0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
+    0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
+    0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
+    0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
+    0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+    0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+    0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
+    0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
+    0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
+    0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
+    0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
+    0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
+    0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+    0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+    0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
+    0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
+    0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
+    0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
+    0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
+    0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
+    0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+    0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+    0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
+    0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
+    0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
+    0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
+    0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
+    0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
+    0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+    0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+    0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30,
+    0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31,
+    0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32,
+    0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
+    0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
+    0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
+    0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x31, 0x32, 0x33,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34,
+    0x35, 0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
+    0x36, 0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
+    0x37, 0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+    0x38, 0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+    0x39, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x30, 0x31, 0x32, 0x33, 0x34};
+} // namespace
+
+SofaRpcSpec::SofaRpcSpec()
+    : classname("com.alipay.sofa.rpc.core.request.SofaRequest"),
+      headers{{"service", "com.alipay.test.TestService:1.0"}}, timeout(5000),
+      weight(0), service("com.alipay.test.TestService:1.0"), method("echoStr"),
+      content(reinterpret_cast<const char *>(DEFAULT_CONTENT),
+              sizeof(DEFAULT_CONTENT)) {}
+
+SofaRpcRequest::SofaRpcRequest() : content_map(nullptr), contentlen(0) {}
+
+SofaRpcRequest::SofaRpcRequest(SofaRpcRequest &&other) noexcept
+    : head(std::move(other.head)), content_buf(std::move(other.content_buf)),
+      content_map(other.content_map), contentlen(other.contentlen),
+      head_slots(std::move(other.head_slots)),
+      content_slots(std::move(other.content_slots)) {
+    other.content_map = nullptr;
+    other.contentlen = 0;
+}
+
+SofaRpcRequest::~SofaRpcRequest() {
+    if (content_map) {
+        munmap(const_cast<uint8_t *>(content_map), contentlen);
+    }
+}
+
+const uint8_t *SofaRpcRequest::content() const {
+    if (content_map) {
+        return content_map;
+    }
+    return reinterpret_cast<const uint8_t *>(content_buf.data());
+}
+
+namespace {
+bool is_space(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+} // namespace
+
+namespace {
+StringRef trim(const StringRef &s) {
+    auto first = std::begin(s);
+    auto last = std::end(s);
+    for (; first != last && is_space(*first); ++first)
+        ;
+    for (; last != first && is_space(*(last - 1)); --last)
+        ;
+    return StringRef{first, last};
+}
+} // namespace
+
+namespace {
+int decode_hex(std::string &dst, const StringRef &s) {
+    if (s.size() % 2 || !util::is_hex_string(s)) {
+        return -1;
+    }
+    dst.clear();
+    for (size_t i = 0; i < s.size(); i += 2) {
+        dst += static_cast<char>((util::hex_to_uint(s[i]) << 4) |
+                                 util::hex_to_uint(s[i + 1]));
+    }
+    return 0;
+}
+} // namespace
+
+int read_sofarpc_spec(std::vector<SofaRpcSpec> &specs,
+                      const std::string &path) {
+    std::ifstream f(path);
+    if (!f) {
+        std::cerr << "--sofarpc-spec: cannot open " << path << std::endl;
+        return -1;
+    }
+
+    size_t lineno = 0;
+    auto error = [&path, &lineno](const char *msg) {
+        std::cerr << "--sofarpc-spec: " << path << ":" << lineno << ": " << msg
+                  << std::endl;
+        return -1;
+    };
+
+    // true if the last line belongs to the request in specs.back()
+    auto in_block = false;
+
+    for (std::string line; std::getline(f, line);) {
+        ++lineno;
+
+        auto s = trim(StringRef{line});
+        if (s.empty()) {
+            in_block = false;
+            continue;
+        }
+        if (s[0] == '#') {
+            continue;
+        }
+
+        auto eq = std::find(std::begin(s), std::end(s), '=');
+        if (eq == std::end(s)) {
+            return error("missing '='");
+        }
+
+        auto key = trim(StringRef{std::begin(s), eq});
+        auto value = trim(StringRef{eq + 1, std::end(s)});
+
+        if (!in_block) {
+            // The class name and timeout default to those of the
+            // built-in request, but the rest does not.
+            specs.emplace_back();
+            specs.back().headers.clear();
+            specs.back().content.clear();
+            in_block = true;
+        }
+
+        auto &spec = specs.back();
+
+        if (util::streq_l("class", key)) {
+            spec.classname = value.str();
+        } else if (util::streq_l("service", key)) {
+            // SOFARPC clients send both.
+            spec.service = value.str();
+            spec.headers.emplace_back("service", spec.service);
+            spec.headers.emplace_back("sofa_head_target_service", spec.service);
+        } else if (util::streq_l("method", key)) {
+            spec.method = value.str();
+            spec.headers.emplace_back("sofa_head_method_name", spec.method);
+        } else if (util::streq_l("header", key)) {
+            auto colon = std::find(std::begin(value), std::end(value), ':');
+            if (colon == std::end(value)) {
+                return error("header must be <key>:<value>");
+            }
+            spec.headers.emplace_back(
+                trim(StringRef{std::begin(value), colon}).str(),
+                trim(StringRef{colon + 1, std::end(value)}).str());
+        } else if (util::streq_l("timeout", key)) {
+            auto n = util::parse_uint(value);
+            if (n == -1 || n > std::numeric_limits<int32_t>::max()) {
+                return error("bad timeout");
+            }
+            spec.timeout = n;
+        } else if (util::streq_l("weight", key)) {
+            auto n = util::parse_uint(value);
+            if (n < 0 || n > 1000) {
+                return error("weight must be in [0, 1000]");
+            }
+            spec.weight = n;
+        } else if (util::streq_l("content", key)) {
+            spec.content = value.str();
+            spec.content_file.clear();
+            spec.content_args.clear();
+        } else if (util::streq_l("content-hex", key)) {
+            if (decode_hex(spec.content, value) != 0) {
+                return error("bad content-hex");
+            }
+            spec.content_file.clear();
+            spec.content_args.clear();
+        } else if (util::streq_l("content-file", key)) {
+            if (value.empty()) {
+                return error("empty content-file");
+            }
+            spec.content.clear();
+            spec.content_file = value.str();
+            spec.content_args.clear();
+        } else if (util::streq_l("args", key)) {
+            if (value.empty()) {
+                return error("empty args");
+            }
+            spec.content.clear();
+            spec.content_file.clear();
+            spec.content_args = value.str();
+        } else {
+            return error("unknown key");
+        }
+    }
+
+    if (specs.empty()) {
+        std::cerr << "--sofarpc-spec: no request is defined in " << path
+                  << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+namespace {
+// Maps the content file of |spec| into |req|.
+int map_content(SofaRpcRequest &req, const SofaRpcSpec &spec) {
+    auto fd = open(spec.content_file.c_str(), O_RDONLY);
+    if (fd == -1) {
+        std::cerr << "--sofarpc-spec: cannot open " << spec.content_file
+                  << ": " << strerror(errno) << std::endl;
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        std::cerr << "--sofarpc-spec: cannot stat " << spec.content_file
+                  << ": " << strerror(errno) << std::endl;
+        close(fd);
+        return -1;
+    }
+
+    if (st.st_size > std::numeric_limits<int32_t>::max()) {
+        std::cerr << "--sofarpc-spec: " << spec.content_file
+                  << " is too large" << std::endl;
+        close(fd);
+        return -1;
+    }
+
+    if (st.st_size > 0) {
+        auto p = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            std::cerr << "--sofarpc-spec: cannot map " << spec.content_file
+                      << ": " << strerror(errno) << std::endl;
+            close(fd);
+            return -1;
+        }
+        req.content_map = static_cast<const uint8_t *>(p);
+        req.contentlen = st.st_size;
+    }
+
+    // The mapping stays after the file is closed.
+    close(fd);
+
+    return 0;
+}
+} // namespace
+
+int make_sofarpc_request(SofaRpcRequest &req, const SofaRpcSpec &spec,
+                         int version, bool crc, bool oneway,
+                         size_t keylen) {
+    if (!spec.content_args.empty()) {
+        if (make_sofarequest_content(req.content_buf, spec.service,
+                                     spec.method, spec.content_args,
+                                     keylen) != 0) {
+            std::cerr << "bad SofaRPC argument shapes: " << spec.content_args
+                      << std::endl;
+            return -1;
+        }
+    } else if (spec.content_file.empty()) {
+        req.content_buf = spec.content;
+    } else if (map_content(req, spec) != 0) {
+        return -1;
+    }
+
+    if (!req.content_map) {
+        // A mapped file is sent as it is.
+        if (parse_subst(req.content_buf, req.content_slots, 0, keylen) != 0) {
+            std::cerr << "--sofarpc-spec: bad substitution slot in content"
+                      << std::endl;
+            return -1;
+        }
+        req.contentlen = req.content_buf.size();
+    }
+
+    if (req.contentlen > static_cast<size_t>(
+                             std::numeric_limits<int32_t>::max())) {
+        std::cerr << "--sofarpc-spec: content is too large" << std::endl;
+        return -1;
+    }
+
+    // The slots in the header map are at their offsets in |hdmap| for
+    // now.
+    std::string hdmap;
+    std::vector<SubstSlot> hdmap_slots;
+    for (auto &kv : spec.headers) {
+        auto value = kv.second;
+        if (parse_subst(value, hdmap_slots,
+                        hdmap.size() + 8 + kv.first.size(), keylen) != 0) {
+            std::cerr << "--sofarpc-spec: bad substitution slot in header "
+                      << kv.first << std::endl;
+            return -1;
+        }
+        std::array<char, 4> len;
+        util::putBigEndianI32(len.data(), kv.first.size());
+        hdmap.append(len.data(), len.size());
+        hdmap += kv.first;
+        util::putBigEndianI32(len.data(), value.size());
+        hdmap.append(len.data(), len.size());
+        hdmap += value;
+    }
+
+    if (spec.classname.size() > std::numeric_limits<uint16_t>::max() ||
+        hdmap.size() > std::numeric_limits<uint16_t>::max()) {
+        std::cerr << "--sofarpc-spec: class name or header map is too long"
+                  << std::endl;
+        return -1;
+    }
+
+    auto &head = req.head;
+    head.assign(bolt_request_header_len(version), 0);
+    auto bytes = &head[0];
+    auto type = oneway ? REQUEST_ONEWAY : REQUEST;
+    if (version == 2) {
+        // V2 adds the protocol version after the protocol code, and the
+        // protocol switch after the codec.
+        bytes[0] = PROTOCOL_CODE_V2;                   // proto
+        bytes[1] = PROTOCOL_VERSION_1;                 // ver1
+        bytes[2] = type;                               // type
+        util::putBigEndianI16(&bytes[3], RPC_REQUEST); // cmdcode
+        bytes[5] = 1;                                  // ver2
+        bytes[10] = HESSIAN2_SERIALIZE;                // codec
+        bytes[11] = crc ? PROTOCOL_SWITCH_CRC : 0;     // switch
+        bytes += 2;
+    } else {
+        bytes[0] = PROTOCOL_CODE_V1;                   // proto
+        bytes[1] = type;                               // type
+        util::putBigEndianI16(&bytes[2], RPC_REQUEST); // cmdcode
+        bytes[4] = 1;                                  // version
+        bytes[9] = HESSIAN2_SERIALIZE;                 // codec
+    }
+    // The rest are at the same offsets from here.
+    util::putBigEndianI32(&bytes[10], spec.timeout);          // timeout
+    util::putBigEndianI16(&bytes[14], spec.classname.size()); // classLen
+    util::putBigEndianI16(&bytes[16], hdmap.size());          // headerLen
+    util::putBigEndianI32(&bytes[18], req.contentlen);        // contentLen
+
+    for (auto slot : hdmap_slots) {
+        slot.offset += head.size() + spec.classname.size();
+        req.head_slots.push_back(slot);
+    }
+
+    head += spec.classname;
+    head += hdmap;
+
+    return 0;
+}
+
+bool bolt_header_map_has(const uint8_t *data, size_t len,
+                         const std::string &key) {
+    auto p = reinterpret_cast<const char *>(data);
+    auto end = p + len;
+    // Each entry is the length of the key, the key, the length of the
+    // value and the value, with the lengths in 4 bytes.
+    while (p != end) {
+        if (end - p < 4) {
+            return false;
+        }
+        auto keylen = static_cast<uint32_t>(util::getBigEndianI32(p));
+        p += 4;
+        if (static_cast<size_t>(end - p) < keylen) {
+            return false;
+        }
+        if (keylen == key.size() && std::equal(p, p + keylen, key.c_str())) {
+            return true;
+        }
+        p += keylen;
+        if (end - p < 4) {
+            return false;
+        }
+        auto valuelen = static_cast<uint32_t>(util::getBigEndianI32(p));
+        p += 4;
+        if (static_cast<size_t>(end - p) < valuelen) {
+            return false;
+        }
+        p += valuelen;
+    }
+    return false;
+}
+
+std::string sofarpc_status_name(size_t status) {
+    switch (status) {
+    case RESPONSE_STATUS_SUCCESS:
+        return "success";
+    case RESPONSE_STATUS_ERROR:
+        return "error";
+    case RESPONSE_STATUS_SERVER_EXCEPTION:
+        return "server_exception";
+    case RESPONSE_STATUS_UNKNOWN:
+        return "unknown";
+    case RESPONSE_STATUS_SERVER_THREADPOOL_BUSY:
+        return "server_threadpool_busy";
+    case RESPONSE_STATUS_ERROR_COMM:
+        return "error_comm";
+    case RESPONSE_STATUS_NO_PROCESSOR:
+        return "no_processor";
+    case RESPONSE_STATUS_TIMEOUT:
+        return "timeout";
+    case RESPONSE_STATUS_CLIENT_SEND_ERROR:
+        return "client_send_error";
+    case RESPONSE_STATUS_CODEC_EXCEPTION:
+        return "codec_exception";
+    case RESPONSE_STATUS_CONNECTION_CLOSED:
+        return "connection_closed";
+    case RESPONSE_STATUS_SERVER_SERIAL_EXCEPTION:
+        return "server_serial_exception";
+    case RESPONSE_STATUS_SERVER_DESERIAL_EXCEPTION:
+        return "server_deserial_exception";
+    default:
+        return "status_" + util::utos(status);
+    }
+}
+
+} // namespace h2load
@@ -0,0 +1,116 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_SOFARPC_SPEC_H
+#define H2LOAD_SOFARPC_SPEC_H
+
+#include "nghttp2_config.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "subst.h"
+
+namespace h2load {
+
+// The definition of a SofaRPC request, given in --sofarpc-spec or by
+// the built-in defaults.
+struct SofaRpcSpec {
+    SofaRpcSpec();
+
+    std::string classname;
+    // Bolt header map entries, in the order they are serialized
+    std::vector<std::pair<std::string, std::string>> headers;
+    // Request timeout in milliseconds
+    uint32_t timeout;
+    // The weight of the request in the mix, or 0 if it is not given
+    uint32_t weight;
+    // The target service and method
+    std::string service;
+    std::string method;
+    // The content, unless |content_file| or |content_args| is not
+    // empty
+    std::string content;
+    // The file the content is read from
+    std::string content_file;
+    // The argument shapes the content is generated from with
+    // make_sofarequest_content()
+    std::string content_args;
+};
+
+// A SofaRPC request serialized once at startup, and shared by all
+// connections.
+struct SofaRpcRequest {
+    SofaRpcRequest();
+    SofaRpcRequest(SofaRpcRequest &&other) noexcept;
+    SofaRpcRequest(const SofaRpcRequest &) = delete;
+    SofaRpcRequest &operator=(const SofaRpcRequest &) = delete;
+    ~SofaRpcRequest();
+
+    const uint8_t *content() const;
+
+    // The Bolt request header, followed by the class name and the
+    // serialized header map
+    std::string head;
+    // The content, copied from SofaRpcSpec::content
+    std::string content_buf;
+    // The content mapped from SofaRpcSpec::content_file, or nullptr
+    const uint8_t *content_map;
+    size_t contentlen;
+    // The substitution slots in |head| and in the content, in the
+    // order of their offsets
+    std::vector<SubstSlot> head_slots;
+    std::vector<SubstSlot> content_slots;
+};
+
+// Reads the request definitions in |path| into |specs|.  Each block
+// of "key=value" lines, separated by empty lines, defines a request.
+// Returns 0 if it succeeds, or -1 after printing the error.
+int read_sofarpc_spec(std::vector<SofaRpcSpec> &specs,
+                      const std::string &path);
+
+// Serializes |spec| into |req| with Bolt protocol |version|.  If
+// |crc| is true, the CRC switch is set.  If |oneway| is true, the
+// request is typed REQUEST_ONEWAY.  A content file is mapped
+// into memory rather than copied.  The substitution slots in the
+// header values, and in the content unless it is mapped, are reserved
+// at their width, and |keylen| is as in parse_subst_marker().
+// Returns 0 if it succeeds, or -1 after printing the error.
+int make_sofarpc_request(SofaRpcRequest &req, const SofaRpcSpec &spec,
+                         int version, bool crc, bool oneway,
+                         size_t keylen);
+
+// Returns true if the serialized Bolt header map of |len| bytes at
+// |data| has an entry of |key|.
+bool bolt_header_map_has(const uint8_t *data, size_t len,
+                         const std::string &key);
+
+// Returns the name of SofaRPC response status |status|.
+std::string sofarpc_status_name(size_t status);
+
+} // namespace h2load
+
+#endif // H2LOAD_SOFARPC_SPEC_H
@@ -0,0 +1,152 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_stop.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+#include "util.h"
+
+using namespace nghttp2;
+
+namespace h2load {
+
+namespace {
+// Parses |s| as a number in [0, 100], or returns -1.
+double parse_percent(const std::string &s) {
+    if (s.empty()) {
+        return -1.;
+    }
+    char *end;
+    auto v = strtod(s.c_str(), &end);
+    if (end != s.c_str() + s.size() || !(v >= 0. && v <= 100.)) {
+        return -1.;
+    }
+    return v;
+}
+} // namespace
+
+int parse_stop_conditions(std::vector<StopCondition> &conds,
+                          const std::string &s) {
+    for (auto &f : util::split_str(StringRef{s}, ',')) {
+        auto cond = f.str();
+        auto eq = cond.find('=');
+        auto name = cond.substr(0, eq);
+        auto value = eq == std::string::npos ? "" : cond.substr(eq + 1);
+
+        if (cond == "saturated") {
+            conds.push_back(StopCondition{StopCondition::SATURATED, 0., 0.});
+            continue;
+        }
+        if (name == "errors") {
+            if (!value.empty() && value.back() == '%') {
+                value.pop_back();
+            }
+            auto pct = parse_percent(value);
+            if (pct < 0.) {
+                std::cerr << "--stop-on: bad error rate: " << cond
+                          << std::endl;
+                return -1;
+            }
+            conds.push_back(StopCondition{StopCondition::ERRORS, 0., pct});
+            continue;
+        }
+        if (name.size() > 1 && name[0] == 'p' && !value.empty()) {
+            auto pct = parse_percent(name.substr(1));
+            auto t = util::parse_duration_with_unit(value.c_str());
+            if (pct < 0. || !std::isfinite(t) || t <= 0.) {
+                std::cerr << "--stop-on: bad latency limit: " << cond
+                          << std::endl;
+                return -1;
+            }
+            conds.push_back(
+                StopCondition{StopCondition::LATENCY, pct, t * 1e9});
+            continue;
+        }
+        std::cerr << "--stop-on: unknown condition: " << cond << std::endl;
+        return -1;
+    }
+
+    if (conds.empty()) {
+        std::cerr << "--stop-on: no condition is given" << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+bool stop_condition_holds(const StopCondition &cond, const StopInterval &iv) {
+    switch (cond.kind) {
+    case StopCondition::ERRORS:
+        // Requests lost with their connections fail without being done.
+        return iv.req_failed * 100. >
+               cond.limit * std::max(iv.req_done, iv.req_failed);
+    case StopCondition::LATENCY:
+        return iv.rtt_hist->count() &&
+               iv.rtt_hist->value_at_percentile(cond.percentile) > cond.limit;
+    case StopCondition::SATURATED:
+        return iv.saturated;
+    }
+    return false;
+}
+
+std::string stop_condition_str(const StopCondition &cond) {
+    std::ostringstream os;
+    switch (cond.kind) {
+    case StopCondition::ERRORS:
+        os << "error rate over " << cond.limit << "%";
+        break;
+    case StopCondition::LATENCY:
+        os << "p" << cond.percentile << " latency over "
+           << util::format_duration(cond.limit / 1e9);
+        break;
+    case StopCondition::SATURATED:
+        os << "generator saturated";
+        break;
+    }
+    return os.str();
+}
+
+StopChecker::StopChecker(std::vector<StopCondition> conds, size_t window)
+    : conds_(std::move(conds)), runs_(conds_.size()), window_(window) {}
+
+const StopCondition *StopChecker::update(const StopInterval &iv) {
+    const StopCondition *met = nullptr;
+    for (size_t i = 0; i < conds_.size(); ++i) {
+        if (!stop_condition_holds(conds_[i], iv)) {
+            runs_[i] = 0;
+            continue;
+        }
+        if (++runs_[i] >= window_ && !met) {
+            met = &conds_[i];
+        }
+    }
+    return met;
+}
+
+} // namespace h2load
@@ -0,0 +1,96 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_STOP_H
+#define H2LOAD_STOP_H
+
+#include "nghttp2_config.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "histogram.h"
+
+namespace h2load {
+
+// A condition of --stop-on, which holds for an interval of the
+// timeline that went badly enough to end the run.
+struct StopCondition {
+    enum Kind {
+        // The failed requests exceed |limit| percent of those done.
+        ERRORS,
+        // The latency at |percentile| exceeds |limit| nanoseconds.
+        LATENCY,
+        // The event loop of a worker was saturated.
+        SATURATED,
+    } kind;
+    double percentile;
+    double limit;
+};
+
+// What an interval of the timeline is checked against
+struct StopInterval {
+    uint64_t req_done;
+    uint64_t req_failed;
+    // Round trip times of the requests done in the interval
+    const nghttp2::Histogram *rtt_hist;
+    // true if a worker was saturated in the interval
+    bool saturated;
+};
+
+// Parses the comma separated list of conditions |s| of --stop-on into
+// |conds|.  A condition is "errors=<PERCENT>", "p<PERCENTILE>=<TIME>"
+// or "saturated".  Returns 0 if it succeeds, or -1 after printing the
+// error.
+int parse_stop_conditions(std::vector<StopCondition> &conds,
+                          const std::string &s);
+
+// Returns true if |cond| holds for |iv|.
+bool stop_condition_holds(const StopCondition &cond, const StopInterval &iv);
+
+// Returns the description of |cond| for the report.
+std::string stop_condition_str(const StopCondition &cond);
+
+// StopChecker tells when one of the conditions has held for a number
+// of intervals in a row, so that a single bad interval does not end
+// the run.
+class StopChecker {
+  public:
+    StopChecker(std::vector<StopCondition> conds, size_t window);
+    // Checks the next interval |iv|.  Returns the first condition
+    // which has held for the last |window| intervals, or nullptr.
+    const StopCondition *update(const StopInterval &iv);
+
+  private:
+    std::vector<StopCondition> conds_;
+    // The intervals in a row each condition has held for
+    std::vector<size_t> runs_;
+    size_t window_;
+};
+
+} // namespace h2load
+
+#endif // H2LOAD_STOP_H
@@ -0,0 +1,91 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_stop_test.h"
+
+#include <string>
+#include <vector>
+
+#include <CUnit/CUnit.h>
+
+#include "h2load_stop.h"
+
+using namespace nghttp2;
+
+namespace h2load {
+
+void test_stop_parse(void) {
+    {
+        std::vector<StopCondition> conds;
+        CU_ASSERT(0 ==
+                  parse_stop_conditions(conds, "errors=50%,p99=2s,saturated"));
+        CU_ASSERT(3 == conds.size());
+        CU_ASSERT(StopCondition::ERRORS == conds[0].kind);
+        CU_ASSERT(50. == conds[0].limit);
+        CU_ASSERT(StopCondition::LATENCY == conds[1].kind);
+        CU_ASSERT(99. == conds[1].percentile);
+        CU_ASSERT(2e9 == conds[1].limit);
+        CU_ASSERT(StopCondition::SATURATED == conds[2].kind);
+        CU_ASSERT("error rate over 50%" == stop_condition_str(conds[0]));
+        CU_ASSERT("p99 latency over 2.00s" == stop_condition_str(conds[1]));
+    }
+    {
+        std::vector<StopCondition> conds;
+        CU_ASSERT(0 == parse_stop_conditions(conds, "p99.9=500ms"));
+        CU_ASSERT(99.9 == conds[0].percentile);
+        CU_ASSERT(5e8 == conds[0].limit);
+    }
+
+    for (auto bad : {"", "errors", "errors=101", "p99", "p101=1s", "p99=x",
+                     "busy"}) {
+        std::vector<StopCondition> conds;
+        CU_ASSERT(-1 == parse_stop_conditions(conds, bad));
+    }
+}
+
+void test_stop_checker(void) {
+    StopChecker checker(
+        {StopCondition{StopCondition::ERRORS, 0., 50.},
+         StopCondition{StopCondition::LATENCY, 99., 1e6}},
+        2);
+    Histogram fast, slow;
+    for (size_t i = 0; i < 100; ++i) {
+        fast.record(1000);
+        slow.record(2000000);
+    }
+
+    // Errors in one interval, then in two in a row
+    CU_ASSERT(nullptr == checker.update(StopInterval{100, 60, &fast, false}));
+    CU_ASSERT(nullptr == checker.update(StopInterval{100, 0, &fast, false}));
+    CU_ASSERT(nullptr == checker.update(StopInterval{100, 60, &fast, false}));
+    auto cond = checker.update(StopInterval{0, 10, &fast, false});
+    CU_ASSERT(nullptr != cond);
+    CU_ASSERT(StopCondition::ERRORS == cond->kind);
+
+    StopChecker latency({StopCondition{StopCondition::LATENCY, 99., 1e6}}, 1);
+    CU_ASSERT(nullptr == latency.update(StopInterval{100, 0, &fast, false}));
+    CU_ASSERT(nullptr != latency.update(StopInterval{100, 0, &slow, false}));
+}
+
+} // namespace h2load
@@ -0,0 +1,91 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_sweep.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "util.h"
+
+using namespace nghttp2;
+
+namespace h2load {
+
+int parse_sweep_counts(std::vector<size_t> &counts, const std::string &s,
+                       const char *opt, size_t max) {
+    for (auto &f : util::split_str(StringRef{s}, ',')) {
+        auto n = util::parse_uint(f);
+        if (n < 1) {
+            std::cerr << "--" << opt << ": bad count " << f << std::endl;
+            return -1;
+        }
+        if (static_cast<size_t>(n) > max) {
+            std::cerr << "--" << opt << ": " << n << " is more than " << max
+                      << std::endl;
+            return -1;
+        }
+        counts.push_back(n);
+    }
+    return 0;
+}
+
+int parse_sweep_requests(std::vector<size_t> &tmpls, const std::string &s,
+                         const std::vector<std::string> &names) {
+    for (auto &f : util::split_str(StringRef{s}, ',')) {
+        auto it = std::find(std::begin(names), std::end(names), f);
+        if (it == std::end(names)) {
+            std::cerr << "--sweep-requests: unknown request " << f
+                      << std::endl;
+            return -1;
+        }
+        tmpls.push_back(it - std::begin(names));
+    }
+    return 0;
+}
+
+std::vector<SweepCell> make_sweep_cells(const std::vector<size_t> &clients,
+                                        const std::vector<size_t> &streams,
+                                        const std::vector<size_t> &tmpls,
+                                        size_t max_clients,
+                                        size_t max_streams) {
+    auto or_default = [](const std::vector<size_t> &v, size_t def) {
+        return v.empty() ? std::vector<size_t>{def} : v;
+    };
+    std::vector<SweepCell> cells;
+    for (auto c : or_default(clients, max_clients)) {
+        for (auto m : or_default(streams, max_streams)) {
+            for (auto t : or_default(tmpls, SWEEP_ANY_REQUEST)) {
+                cells.push_back(SweepCell{c, m, t});
+            }
+        }
+    }
+    return cells;
+}
+
+size_t sweep_share(size_t n, size_t nthreads, size_t worker_id) {
+    return n / nthreads + (worker_id < n % nthreads);
+}
+
+} // namespace h2load
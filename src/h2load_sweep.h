@@ -0,0 +1,78 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_SWEEP_H
+#define H2LOAD_SWEEP_H
+
+#include "nghttp2_config.h"
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace h2load {
+
+// The request template of a --sweep cell which sends the requests
+// as without --sweep, because --sweep-requests is not given
+constexpr size_t SWEEP_ANY_REQUEST = std::numeric_limits<size_t>::max();
+
+// A cell of --sweep: |nclients| clients, each with up to |nstreams|
+// requests in flight, sending request template |tmpl|.
+struct SweepCell {
+    size_t nclients;
+    size_t nstreams;
+    size_t tmpl;
+};
+
+// Parses the comma separated list of positive integers |s| of
+// option |opt| into |counts|.  Each must not exceed |max|.  Returns 0
+// if it succeeds, or -1 after printing the error.
+int parse_sweep_counts(std::vector<size_t> &counts, const std::string &s,
+                       const char *opt, size_t max);
+
+// Parses the comma separated list of request names |s| of
+// --sweep-requests into the indexes of the request templates in
+// |tmpls|.  |names| are the names the report gives the templates.
+// Returns 0 if it succeeds, or -1 after printing the error.
+int parse_sweep_requests(std::vector<size_t> &tmpls, const std::string &s,
+                         const std::vector<std::string> &names);
+
+// Returns the cells of all combinations of |clients|, |streams| and
+// |tmpls|, in which the request template changes fastest, and the
+// number of clients slowest.  An empty list stands for |max_clients|,
+// |max_streams| or SWEEP_ANY_REQUEST.
+std::vector<SweepCell> make_sweep_cells(const std::vector<size_t> &clients,
+                                        const std::vector<size_t> &streams,
+                                        const std::vector<size_t> &tmpls,
+                                        size_t max_clients,
+                                        size_t max_streams);
+
+// Returns the share of |n| clients of worker |worker_id| of
+// |nthreads|, spread as -c is.
+size_t sweep_share(size_t n, size_t nthreads, size_t worker_id);
+
+} // namespace h2load
+
+#endif // H2LOAD_SWEEP_H
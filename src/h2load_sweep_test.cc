@@ -0,0 +1,84 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_sweep_test.h"
+
+#include <string>
+#include <vector>
+
+#include <CUnit/CUnit.h>
+
+#include "h2load_sweep.h"
+
+namespace h2load {
+
+void test_sweep_parse(void) {
+    {
+        std::vector<size_t> counts;
+        CU_ASSERT(0 == parse_sweep_counts(counts, "8,64,1024", "c", 1024));
+        CU_ASSERT((std::vector<size_t>{8, 64, 1024}) == counts);
+    }
+
+    for (auto bad : {"", "8,", "0", "8,x", "1025"}) {
+        std::vector<size_t> counts;
+        CU_ASSERT(-1 == parse_sweep_counts(counts, bad, "c", 1024));
+    }
+
+    std::vector<std::string> names{"small", "large"};
+    {
+        std::vector<size_t> tmpls;
+        CU_ASSERT(0 == parse_sweep_requests(tmpls, "large,small", names));
+        CU_ASSERT((std::vector<size_t>{1, 0}) == tmpls);
+    }
+    {
+        std::vector<size_t> tmpls;
+        CU_ASSERT(-1 == parse_sweep_requests(tmpls, "small,huge", names));
+    }
+}
+
+void test_sweep_cells(void) {
+    auto cells = make_sweep_cells({1, 4}, {}, {0, 1, 2}, 8, 16);
+    CU_ASSERT(6 == cells.size());
+    CU_ASSERT(1 == cells[0].nclients);
+    CU_ASSERT(16 == cells[0].nstreams);
+    CU_ASSERT(0 == cells[0].tmpl);
+    CU_ASSERT(2 == cells[2].tmpl);
+    CU_ASSERT(4 == cells[3].nclients);
+    CU_ASSERT(0 == cells[3].tmpl);
+
+    cells = make_sweep_cells({}, {1, 2}, {}, 8, 16);
+    CU_ASSERT(2 == cells.size());
+    CU_ASSERT(8 == cells[1].nclients);
+    CU_ASSERT(2 == cells[1].nstreams);
+    CU_ASSERT(SWEEP_ANY_REQUEST == cells[1].tmpl);
+
+    // 10 clients over 4 workers take 3, 3, 2 and 2.
+    CU_ASSERT(3 == sweep_share(10, 4, 0));
+    CU_ASSERT(3 == sweep_share(10, 4, 1));
+    CU_ASSERT(2 == sweep_share(10, 4, 2));
+    CU_ASSERT(2 == sweep_share(10, 4, 3));
+    CU_ASSERT(0 == sweep_share(1, 4, 1));
+}
+
+} // namespace h2load
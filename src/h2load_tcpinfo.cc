@@ -0,0 +1,132 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_tcpinfo.h"
+
+#ifdef HAVE_LINUX_TCP_H
+// <netinet/tcp.h> of older glibc lacks the fields added since Linux
+// 4.10, so the kernel's definition is used.  It clashes with
+// <netinet/tcp.h>, which is why this lives in a file of its own.
+#include <linux/tcp.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif // HAVE_LINUX_TCP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace h2load {
+
+int get_tcp_info(int fd, TcpInfo &info) {
+#ifdef HAVE_LINUX_TCP_H
+    tcp_info ti;
+    memset(&ti, 0, sizeof(ti));
+    socklen_t len = sizeof(ti);
+    if (getsockopt(fd, IPPROTO_TCP, TCP_INFO, &ti, &len) != 0) {
+        return -1;
+    }
+    info.rtt = ti.tcpi_rtt;
+    info.rttvar = ti.tcpi_rttvar;
+    info.snd_cwnd = ti.tcpi_snd_cwnd;
+    info.total_retrans = ti.tcpi_total_retrans;
+    info.busy_time = ti.tcpi_busy_time;
+    info.rwnd_limited = ti.tcpi_rwnd_limited;
+    info.sndbuf_limited = ti.tcpi_sndbuf_limited;
+    // The kernel copies no more than it knows of.
+    info.has_limited =
+        len >= offsetof(tcp_info, tcpi_sndbuf_limited) +
+                   sizeof(ti.tcpi_sndbuf_limited);
+    return 0;
+#else  // !HAVE_LINUX_TCP_H
+    return -1;
+#endif // !HAVE_LINUX_TCP_H
+}
+
+TcpInfoStat::TcpInfoStat()
+    : nsamples(0), rtt_sum(0), rtt_max(0), rttvar_sum(0), cwnd_sum(0),
+      cwnd_min(0), retrans(0), busy_time(0), rwnd_limited(0),
+      sndbuf_limited(0) {}
+
+namespace {
+// Returns how much the counter |cur| grew since |prev|.  A counter
+// which went back counts from 0.
+uint64_t grown(uint64_t cur, uint64_t prev) {
+    return cur >= prev ? cur - prev : cur;
+}
+} // namespace
+
+void TcpInfoStat::add(const TcpInfo &cur, const TcpInfo *prev) {
+    cwnd_min = nsamples ? std::min(cwnd_min, cur.snd_cwnd) : cur.snd_cwnd;
+    ++nsamples;
+    rtt_sum += cur.rtt;
+    rtt_max = std::max(rtt_max, cur.rtt);
+    rttvar_sum += cur.rttvar;
+    cwnd_sum += cur.snd_cwnd;
+    retrans += grown(cur.total_retrans, prev ? prev->total_retrans : 0);
+    if (cur.has_limited) {
+        busy_time += grown(cur.busy_time, prev ? prev->busy_time : 0);
+        rwnd_limited += grown(cur.rwnd_limited, prev ? prev->rwnd_limited : 0);
+        sndbuf_limited +=
+            grown(cur.sndbuf_limited, prev ? prev->sndbuf_limited : 0);
+    }
+}
+
+void TcpInfoStat::merge(const TcpInfoStat &other) {
+    if (other.nsamples == 0) {
+        return;
+    }
+    cwnd_min = nsamples ? std::min(cwnd_min, other.cwnd_min) : other.cwnd_min;
+    nsamples += other.nsamples;
+    rtt_sum += other.rtt_sum;
+    rtt_max = std::max(rtt_max, other.rtt_max);
+    rttvar_sum += other.rttvar_sum;
+    cwnd_sum += other.cwnd_sum;
+    retrans += other.retrans;
+    busy_time += other.busy_time;
+    rwnd_limited += other.rwnd_limited;
+    sndbuf_limited += other.sndbuf_limited;
+}
+
+double TcpInfoStat::mean_rtt() const {
+    return nsamples ? static_cast<double>(rtt_sum) / nsamples : 0.;
+}
+
+double TcpInfoStat::mean_rttvar() const {
+    return nsamples ? static_cast<double>(rttvar_sum) / nsamples : 0.;
+}
+
+double TcpInfoStat::mean_cwnd() const {
+    return nsamples ? static_cast<double>(cwnd_sum) / nsamples : 0.;
+}
+
+double TcpInfoStat::rwnd_limited_ratio() const {
+    return busy_time ? static_cast<double>(rwnd_limited) / busy_time : 0.;
+}
+
+double TcpInfoStat::sndbuf_limited_ratio() const {
+    return busy_time ? static_cast<double>(sndbuf_limited) / busy_time : 0.;
+}
+
+} // namespace h2load
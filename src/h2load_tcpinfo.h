@@ -0,0 +1,94 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_TCPINFO_H
+#define H2LOAD_TCPINFO_H
+
+#include "nghttp2_config.h"
+
+#include <cstdint>
+
+namespace h2load {
+
+// A sample of TCP_INFO of a connection.  Times are in microseconds.
+// The retransmits and the busy and limited times are counted since
+// the connection was made.
+struct TcpInfo {
+    // The smoothed round trip time, and its mean deviation
+    uint32_t rtt;
+    uint32_t rttvar;
+    // The congestion window in segments
+    uint32_t snd_cwnd;
+    uint32_t total_retrans;
+    // The time spent sending data, and how much of it was limited by
+    // the receive window of the peer, or by the send buffer
+    uint64_t busy_time;
+    uint64_t rwnd_limited;
+    uint64_t sndbuf_limited;
+    // false if the kernel is older than 4.10, and does not report the
+    // busy and limited times
+    bool has_limited;
+};
+
+// Reads TCP_INFO of the socket |fd| into |info|.  Returns 0 if it
+// succeeds, or -1 if |fd| is not a TCP socket, or the platform has no
+// TCP_INFO.
+int get_tcp_info(int fd, TcpInfo &info);
+
+// TcpInfoStat sums up TCP_INFO samples of connections, for
+// --tcp-info.
+struct TcpInfoStat {
+    TcpInfoStat();
+
+    // Adds |cur|, a sample of a connection whose previous sample is
+    // |prev|, or nullptr if |cur| is its first.  The counters since
+    // the connection was made are added as the difference from
+    // |prev|.
+    void add(const TcpInfo &cur, const TcpInfo *prev);
+    void merge(const TcpInfoStat &other);
+
+    double mean_rtt() const;
+    double mean_rttvar() const;
+    double mean_cwnd() const;
+    // Returns the fraction of the busy time limited by the receive
+    // window, or by the send buffer.
+    double rwnd_limited_ratio() const;
+    double sndbuf_limited_ratio() const;
+
+    uint64_t nsamples;
+    uint64_t rtt_sum;
+    uint32_t rtt_max;
+    uint64_t rttvar_sum;
+    uint64_t cwnd_sum;
+    // The smallest congestion window sampled, or 0 if none was
+    uint32_t cwnd_min;
+    uint64_t retrans;
+    uint64_t busy_time;
+    uint64_t rwnd_limited;
+    uint64_t sndbuf_limited;
+};
+
+} // namespace h2load
+
+#endif // H2LOAD_TCPINFO_H
@@ -0,0 +1,96 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_tcpinfo_test.h"
+
+#include <CUnit/CUnit.h>
+
+#include "h2load_tcpinfo.h"
+
+namespace h2load {
+
+void test_tcpinfo_stat(void) {
+    TcpInfoStat stat;
+
+    CU_ASSERT(0. == stat.mean_rtt());
+    CU_ASSERT(0. == stat.rwnd_limited_ratio());
+
+    TcpInfo a{};
+    a.rtt = 1000;
+    a.rttvar = 200;
+    a.snd_cwnd = 10;
+    a.total_retrans = 2;
+    a.busy_time = 1000;
+    a.rwnd_limited = 100;
+    a.has_limited = true;
+
+    // The first sample counts since the connection was made.
+    stat.add(a, nullptr);
+
+    TcpInfo b = a;
+    b.rtt = 3000;
+    b.rttvar = 400;
+    b.snd_cwnd = 4;
+    b.total_retrans = 5;
+    b.busy_time = 3000;
+    b.rwnd_limited = 900;
+    b.sndbuf_limited = 500;
+
+    stat.add(b, &a);
+
+    CU_ASSERT(2 == stat.nsamples);
+    CU_ASSERT(2000. == stat.mean_rtt());
+    CU_ASSERT(3000 == stat.rtt_max);
+    CU_ASSERT(300. == stat.mean_rttvar());
+    CU_ASSERT(7. == stat.mean_cwnd());
+    CU_ASSERT(4 == stat.cwnd_min);
+    CU_ASSERT(5 == stat.retrans);
+    CU_ASSERT(3000 == stat.busy_time);
+    CU_ASSERT(0.3 == stat.rwnd_limited_ratio());
+    CU_ASSERT(500 == stat.sndbuf_limited);
+
+    // Without the limited times, only the rest is counted.
+    TcpInfo c{};
+    c.rtt = 500;
+    c.snd_cwnd = 20;
+    c.total_retrans = 1;
+
+    TcpInfoStat other;
+    other.add(c, nullptr);
+
+    stat.merge(other);
+    stat.merge(TcpInfoStat());
+
+    CU_ASSERT(3 == stat.nsamples);
+    CU_ASSERT(4 == stat.cwnd_min);
+    CU_ASSERT(6 == stat.retrans);
+    CU_ASSERT(3000 == stat.busy_time);
+
+    // A counter which went back counts from 0.
+    TcpInfoStat reset;
+    reset.add(c, &b);
+    CU_ASSERT(1 == reset.retrans);
+}
+
+} // namespace h2load
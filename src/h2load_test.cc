@@ -0,0 +1,100 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_test.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <CUnit/CUnit.h>
+
+#include "h2load.h"
+
+namespace h2load {
+
+void test_h2load_stream_table(void) {
+    BlockAllocator balloc(1024, 1024);
+    StreamTable streams;
+    // Rounded up to 8 slots
+    streams.init(6, balloc);
+    CU_ASSERT(streams.empty());
+
+    auto s1 = streams.emplace(1);
+    s1->window = 1;
+    streams.emplace(3)->window = 3;
+    CU_ASSERT(2 == streams.size());
+    CU_ASSERT(s1 == streams.find(1));
+    CU_ASSERT(3 == streams.find(3)->window);
+    CU_ASSERT(nullptr == streams.find(5));
+    CU_ASSERT(nullptr == streams.find(9));
+
+    // Stream 9 wraps around to the slot of stream 1, which is still
+    // taken, so that it goes to the overflow.
+    streams.emplace(9)->window = 9;
+    CU_ASSERT(3 == streams.size());
+    CU_ASSERT(1 == streams.find(1)->window);
+    CU_ASSERT(9 == streams.find(9)->window);
+
+    // Once stream 1 is erased, stream 17 reuses its slot.
+    streams.erase(1);
+    CU_ASSERT(2 == streams.size());
+    CU_ASSERT(nullptr == streams.find(1));
+    auto s17 = streams.emplace(17);
+    CU_ASSERT(s1 == s17);
+    CU_ASSERT(0 == s17->window);
+    CU_ASSERT(3 == streams.size());
+
+    // Erasing an unknown stream changes nothing.
+    streams.erase(25);
+    CU_ASSERT(3 == streams.size());
+
+    // More streams than slots all stay reachable.
+    for (int32_t id = 19; id < 61; id += 2) {
+        streams.emplace(id)->window = id;
+    }
+    CU_ASSERT(24 == streams.size());
+    std::vector<int32_t> ids;
+    streams.for_each([&ids](int32_t stream_id, Stream &stream) {
+        CU_ASSERT(stream_id == stream.window || stream_id == 17);
+        ids.push_back(stream_id);
+    });
+    CU_ASSERT(24 == ids.size());
+    std::sort(std::begin(ids), std::end(ids));
+    CU_ASSERT(std::end(ids) == std::unique(std::begin(ids), std::end(ids)));
+    CU_ASSERT(3 == ids[0]);
+    CU_ASSERT(59 == ids.back());
+
+    for (auto id : ids) {
+        streams.erase(id);
+    }
+    CU_ASSERT(streams.empty());
+    CU_ASSERT(nullptr == streams.find(9));
+
+    streams.emplace(5);
+    streams.clear();
+    CU_ASSERT(streams.empty());
+    CU_ASSERT(nullptr == streams.find(5));
+}
+
+} // namespace h2load
@@ -0,0 +1,91 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_trace.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace h2load {
+
+TraceWriter::TraceWriter()
+    : hdr_(nullptr), records_(nullptr), maplen_(0), pos_(0) {}
+
+TraceWriter::~TraceWriter() {
+    if (hdr_) {
+        munmap(hdr_, maplen_);
+    }
+}
+
+int TraceWriter::open(const std::string &path, uint32_t worker_id,
+                      uint64_t capacity) {
+    auto fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        std::cerr << "--trace: could not open " << path << ": "
+                  << strerror(errno) << std::endl;
+        return -1;
+    }
+
+    maplen_ = sizeof(TraceHeader) + capacity * sizeof(TraceRecord);
+
+    if (ftruncate(fd, maplen_) != 0) {
+        std::cerr << "--trace: could not resize " << path << ": "
+                  << strerror(errno) << std::endl;
+        close(fd);
+        return -1;
+    }
+
+    int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+    // Take the page faults now rather than while sending requests.
+    flags |= MAP_POPULATE;
+#endif // MAP_POPULATE
+
+    auto p = mmap(nullptr, maplen_, PROT_READ | PROT_WRITE, flags, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        std::cerr << "--trace: could not map " << path << ": "
+                  << strerror(errno) << std::endl;
+        return -1;
+    }
+
+    hdr_ = static_cast<TraceHeader *>(p);
+    records_ = reinterpret_cast<TraceRecord *>(hdr_ + 1);
+
+    memcpy(hdr_->magic, TRACE_MAGIC, sizeof(hdr_->magic));
+    hdr_->version = TRACE_VERSION;
+    hdr_->record_size = sizeof(TraceRecord);
+    hdr_->worker_id = worker_id;
+    hdr_->capacity = capacity;
+    hdr_->nwritten = 0;
+
+    return 0;
+}
+
+} // namespace h2load
@@ -0,0 +1,119 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_TRACE_H
+#define H2LOAD_TRACE_H
+
+#include "nghttp2_config.h"
+
+#include <cstdint>
+#include <string>
+
+namespace h2load {
+
+// The layout of a --trace file.  The file starts with TraceHeader,
+// which is followed by TraceHeader::capacity TraceRecords used as a
+// ring.  Record i is at index i % capacity, so the file holds the
+// last capacity records written.  All integers are in host byte
+// order.
+
+constexpr char TRACE_MAGIC[8] = {'S', 'O', 'F', 'A', 'T', 'R', 'C', '\0'};
+constexpr uint32_t TRACE_VERSION = 1;
+
+struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    // sizeof(TraceRecord)
+    uint32_t record_size;
+    uint32_t worker_id;
+    uint32_t reserved0;
+    // The number of records the ring holds
+    uint64_t capacity;
+    // The number of records written so far
+    uint64_t nwritten;
+    uint8_t reserved[24];
+};
+
+static_assert(sizeof(TraceHeader) == 64, "TraceHeader must be 64 bytes");
+
+// The request was not reset
+constexpr uint8_t TRACE_FLAG_COMPLETED = 0x1;
+// The response status was a success
+constexpr uint8_t TRACE_FLAG_STATUS_SUCCESS = 0x2;
+
+struct TraceRecord {
+    // The wall clock time the request was sent, in nanoseconds since
+    // the epoch
+    int64_t send_time;
+    // Nanoseconds from sending the request to the close of its stream
+    uint64_t rtt;
+    // Nanoseconds the request was sent after it was due in --qps
+    // mode, and 0 otherwise
+    uint64_t send_delay;
+    // The connection, unique within the worker
+    uint32_t conn_id;
+    int32_t stream_id;
+    // HTTP status code or SofaRPC response status, or -1 if no
+    // response arrived
+    int32_t status;
+    uint8_t flags;
+    uint8_t reserved[3];
+};
+
+static_assert(sizeof(TraceRecord) == 40, "TraceRecord must be 40 bytes");
+
+// TraceWriter appends TraceRecords to a memory mapped --trace file.
+// Writing a record is a copy into the mapping, and takes no system
+// call.
+class TraceWriter {
+  public:
+    TraceWriter();
+    ~TraceWriter();
+    TraceWriter(const TraceWriter &) = delete;
+    TraceWriter &operator=(const TraceWriter &) = delete;
+
+    // Creates |path| with room for |capacity| records, and maps it.
+    // Returns 0 if it succeeds, or -1.
+    int open(const std::string &path, uint32_t worker_id, uint64_t capacity);
+
+    void write(const TraceRecord &rec) {
+        records_[pos_] = rec;
+        if (++pos_ == hdr_->capacity) {
+            pos_ = 0;
+        }
+        // Written last, so that a reader of a crashed run does not see
+        // a half written record as complete.
+        ++hdr_->nwritten;
+    }
+
+  private:
+    TraceHeader *hdr_;
+    TraceRecord *records_;
+    size_t maplen_;
+    uint64_t pos_;
+};
+
+} // namespace h2load
+
+#endif // H2LOAD_TRACE_H
@@ -0,0 +1,276 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "h2load_uring.h"
+
+#ifdef HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // HAVE_IO_URING
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace h2load {
+
+IoUring::IoUring()
+    : fd_(-1), sq_ring_(nullptr), cq_ring_(nullptr), sq_ring_len_(0),
+      cq_ring_len_(0), sqes_(nullptr), sqes_len_(0), sq_head_(nullptr),
+      sq_tail_(nullptr), sq_array_(nullptr), sq_mask_(0), sq_entries_(0),
+      cq_head_(nullptr), cq_tail_(nullptr), cq_mask_(0), cqes_(nullptr),
+      nqueued_(0), buf_ring_(nullptr), buf_ring_len_(0), buflen_(0) {}
+
+#ifdef HAVE_IO_URING
+
+IoUring::~IoUring() {
+    if (buf_ring_) {
+        munmap(buf_ring_, buf_ring_len_);
+    }
+    if (sqes_) {
+        munmap(sqes_, sqes_len_);
+    }
+    if (cq_ring_ && cq_ring_ != sq_ring_) {
+        munmap(cq_ring_, cq_ring_len_);
+    }
+    if (sq_ring_) {
+        munmap(sq_ring_, sq_ring_len_);
+    }
+    if (fd_ != -1) {
+        close(fd_);
+    }
+}
+
+int IoUring::init(uint32_t entries, const std::vector<uint8_t *> &bufs,
+                  uint32_t buflen) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    fd_ = syscall(__NR_io_uring_setup, entries, &params);
+    if (fd_ == -1) {
+        return -1;
+    }
+
+    sq_ring_len_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_ring_len_ =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        sq_ring_len_ = cq_ring_len_ = std::max(sq_ring_len_, cq_ring_len_);
+    }
+
+    sq_ring_ = mmap(nullptr, sq_ring_len_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+    if (sq_ring_ == MAP_FAILED) {
+        sq_ring_ = nullptr;
+        return -1;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        cq_ring_ = sq_ring_;
+    } else {
+        cq_ring_ = mmap(nullptr, cq_ring_len_, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+        if (cq_ring_ == MAP_FAILED) {
+            cq_ring_ = nullptr;
+            return -1;
+        }
+    }
+
+    sqes_len_ = params.sq_entries * sizeof(io_uring_sqe);
+    auto sqes = mmap(nullptr, sqes_len_, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        return -1;
+    }
+    sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+    auto sq = static_cast<uint8_t *>(sq_ring_);
+    sq_head_ = reinterpret_cast<uint32_t *>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<uint32_t *>(sq + params.sq_off.tail);
+    sq_array_ = reinterpret_cast<uint32_t *>(sq + params.sq_off.array);
+    sq_mask_ = *reinterpret_cast<uint32_t *>(sq + params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+
+    auto cq = static_cast<uint8_t *>(cq_ring_);
+    cq_head_ = reinterpret_cast<uint32_t *>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<uint32_t *>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<uint32_t *>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+    // The provided buffer ring must be page aligned, which mmap gives.
+    buf_ring_len_ = bufs.size() * sizeof(io_uring_buf);
+    auto buf_ring = mmap(nullptr, buf_ring_len_, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buf_ring == MAP_FAILED) {
+        return -1;
+    }
+    buf_ring_ = static_cast<io_uring_buf *>(buf_ring);
+
+    io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<uintptr_t>(buf_ring_);
+    reg.ring_entries = bufs.size();
+    reg.bgid = 0;
+    if (syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PBUF_RING, &reg,
+                1) != 0) {
+        return -1;
+    }
+
+    bufs_ = bufs;
+    buflen_ = buflen;
+    for (size_t i = 0; i < bufs_.size(); ++i) {
+        recycle_buffer(i);
+    }
+
+    return 0;
+}
+
+io_uring_sqe *IoUring::get_sqe() {
+    if (*sq_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) ==
+        sq_entries_) {
+        submit();
+    }
+    auto tail = *sq_tail_;
+    auto idx = tail & sq_mask_;
+    auto sqe = &sqes_[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    sq_array_[idx] = idx;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+    ++nqueued_;
+    return sqe;
+}
+
+void IoUring::recv_multishot(int fd, uint64_t user_data) {
+    auto sqe = get_sqe();
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = 0;
+    sqe->user_data = user_data;
+}
+
+void IoUring::writev(int fd, const struct iovec *iov, int iovcnt,
+                     uint64_t user_data) {
+    auto sqe = get_sqe();
+    sqe->opcode = IORING_OP_WRITEV;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uintptr_t>(iov);
+    sqe->len = iovcnt;
+    sqe->user_data = user_data;
+}
+
+void IoUring::cancel(uint64_t target, uint64_t user_data) {
+    auto sqe = get_sqe();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = target;
+    sqe->cancel_flags = IORING_ASYNC_CANCEL_ALL;
+    sqe->user_data = user_data;
+}
+
+int IoUring::submit() {
+    while (nqueued_) {
+        auto rv = syscall(__NR_io_uring_enter, fd_, nqueued_, 0, 0, nullptr, 0);
+        if (rv == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        if (rv == 0) {
+            break;
+        }
+        nqueued_ -= rv;
+    }
+    return 0;
+}
+
+bool IoUring::next_completion(uint64_t &user_data, int32_t &res,
+                              uint32_t &flags) {
+    auto head = *cq_head_;
+    if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    auto &cqe = cqes_[head & cq_mask_];
+    user_data = cqe.user_data;
+    res = cqe.res;
+    flags = cqe.flags;
+    __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+int IoUring::buffer_id(uint32_t flags) {
+    if (!(flags & IORING_CQE_F_BUFFER)) {
+        return -1;
+    }
+    return flags >> IORING_CQE_BUFFER_SHIFT;
+}
+
+bool IoUring::more(uint32_t flags) { return flags & IORING_CQE_F_MORE; }
+
+void IoUring::recycle_buffer(int bid) {
+    auto ptail = &buf_ring_[0].resv;
+    auto tail = *ptail;
+    auto &buf = buf_ring_[tail & (bufs_.size() - 1)];
+    buf.addr = reinterpret_cast<uintptr_t>(bufs_[bid]);
+    buf.len = buflen_;
+    buf.bid = bid;
+    __atomic_store_n(ptail, tail + 1, __ATOMIC_RELEASE);
+}
+
+#else // !HAVE_IO_URING
+
+IoUring::~IoUring() {}
+
+int IoUring::init(uint32_t entries, const std::vector<uint8_t *> &bufs,
+                  uint32_t buflen) {
+    errno = ENOSYS;
+    return -1;
+}
+
+void IoUring::recv_multishot(int fd, uint64_t user_data) {}
+
+void IoUring::writev(int fd, const struct iovec *iov, int iovcnt,
+                     uint64_t user_data) {}
+
+void IoUring::cancel(uint64_t target, uint64_t user_data) {}
+
+int IoUring::submit() { return 0; }
+
+bool IoUring::next_completion(uint64_t &user_data, int32_t &res,
+                              uint32_t &flags) {
+    return false;
+}
+
+int IoUring::buffer_id(uint32_t flags) { return -1; }
+
+bool IoUring::more(uint32_t flags) { return false; }
+
+void IoUring::recycle_buffer(int bid) {}
+
+#endif // !HAVE_IO_URING
+
+} // namespace h2load
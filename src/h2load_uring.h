@@ -0,0 +1,115 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef H2LOAD_URING_H
+#define H2LOAD_URING_H
+
+#include "nghttp2_config.h"
+
+#include <sys/uio.h>
+
+#include <cstdint>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct io_uring_buf;
+
+namespace h2load {
+
+// IoUring is a minimal io_uring(7) instance for the connections of a
+// worker, driven by raw system calls.  Reads use multishot recv with
+// buffers picked by the kernel from a provided buffer ring, so one
+// submission keeps reading a connection until it is canceled.  Queued
+// operations are only submitted by submit(), so that a loop iteration
+// takes one system call for all of them.
+class IoUring {
+  public:
+    IoUring();
+    ~IoUring();
+    IoUring(const IoUring &) = delete;
+    IoUring &operator=(const IoUring &) = delete;
+
+    // Sets up a ring of |entries| submission queue entries, and the
+    // buffer ring of |bufs|, each of which is |buflen| bytes long.
+    // The number of |bufs| must be a power of 2, and the buffers must
+    // outlive this object.  Returns 0 if it succeeds, or -1 with errno
+    // set, e.g. if the kernel does not support io_uring.
+    int init(uint32_t entries, const std::vector<uint8_t *> &bufs,
+             uint32_t buflen);
+    // Returns the file descriptor of the ring, which is readable when
+    // completions are waiting.
+    int fd() const { return fd_; }
+
+    // Queues a multishot recv on |fd|.
+    void recv_multishot(int fd, uint64_t user_data);
+    // Queues a writev of |iovcnt| buffers at |iov|, which must stay
+    // valid until it completes.
+    void writev(int fd, const struct iovec *iov, int iovcnt,
+                uint64_t user_data);
+    // Queues canceling the operation queued with |target|.
+    void cancel(uint64_t target, uint64_t user_data);
+    // Submits the queued operations.  Returns 0 if it succeeds, or -1.
+    int submit();
+
+    // Takes the next completion.  Returns false if there is none.
+    bool next_completion(uint64_t &user_data, int32_t &res, uint32_t &flags);
+
+    // Returns the buffer id picked by the kernel for a recv completion
+    // with |flags|, or -1 if there is none.
+    static int buffer_id(uint32_t flags);
+    // Returns true if a multishot operation goes on after a completion
+    // with |flags|.
+    static bool more(uint32_t flags);
+    uint8_t *buffer(int bid) const { return bufs_[bid]; }
+    // Returns buffer |bid| to the kernel.
+    void recycle_buffer(int bid);
+
+  private:
+    struct io_uring_sqe *get_sqe();
+
+    int fd_;
+    void *sq_ring_, *cq_ring_;
+    size_t sq_ring_len_, cq_ring_len_;
+    struct io_uring_sqe *sqes_;
+    size_t sqes_len_;
+    uint32_t *sq_head_, *sq_tail_, *sq_array_;
+    uint32_t sq_mask_, sq_entries_;
+    uint32_t *cq_head_, *cq_tail_;
+    uint32_t cq_mask_;
+    struct io_uring_cqe *cqes_;
+    // The number of entries queued since the last submit()
+    uint32_t nqueued_;
+    // The provided buffer ring.  struct io_uring_buf_ring is not used,
+    // because its flexible array member is laid out differently in
+    // C++.  The tail of the ring overlays buf_ring_[0].resv.
+    struct io_uring_buf *buf_ring_;
+    size_t buf_ring_len_;
+    std::vector<uint8_t *> bufs_;
+    uint32_t buflen_;
+};
+
+} // namespace h2load
+
+#endif // H2LOAD_URING_H
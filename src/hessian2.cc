@@ -0,0 +1,437 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "hessian2.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+#include "subst.h"
+#include "template.h"
+#include "util.h"
+
+using namespace nghttp2;
+
+namespace h2load {
+
+void Hessian2Writer::write_be(uint64_t v, size_t n) {
+    for (; n > 0; --n) {
+        out_ += static_cast<char>(v >> ((n - 1) * 8));
+    }
+}
+
+void Hessian2Writer::write_null() { out_ += 'N'; }
+
+void Hessian2Writer::write_bool(bool v) { out_ += v ? 'T' : 'F'; }
+
+void Hessian2Writer::write_int(int32_t v) {
+    if (-16 <= v && v <= 47) {
+        out_ += static_cast<char>(0x90 + v);
+    } else if (-2048 <= v && v <= 2047) {
+        out_ += static_cast<char>(0xc8 + (v >> 8));
+        write_be(v, 1);
+    } else if (-262144 <= v && v <= 262143) {
+        out_ += static_cast<char>(0xd4 + (v >> 16));
+        write_be(v, 2);
+    } else {
+        out_ += 'I';
+        write_be(static_cast<uint32_t>(v), 4);
+    }
+}
+
+void Hessian2Writer::write_long(int64_t v) {
+    // The 32 bit form is left out, because its code differs between
+    // the revisions of Hessian 2.0.
+    if (-8 <= v && v <= 15) {
+        out_ += static_cast<char>(0xe0 + v);
+    } else if (-2048 <= v && v <= 2047) {
+        out_ += static_cast<char>(0xf8 + (v >> 8));
+        write_be(v, 1);
+    } else if (-262144 <= v && v <= 262143) {
+        out_ += static_cast<char>(0x3c + (v >> 16));
+        write_be(v, 2);
+    } else {
+        out_ += 'L';
+        write_be(static_cast<uint64_t>(v), 8);
+    }
+}
+
+void Hessian2Writer::write_double(double v) {
+    uint64_t bits;
+    static_assert(sizeof(bits) == sizeof(v), "double must be 64 bits");
+    memcpy(&bits, &v, sizeof(bits));
+    out_ += 'D';
+    write_be(bits, 8);
+}
+
+namespace {
+constexpr size_t CHUNK_MAX = 0x8000;
+} // namespace
+
+void Hessian2Writer::write_string(const std::string &s) {
+    // The length of a string is in UTF-16 code units.  A chunk never
+    // splits a UTF-8 sequence.
+    auto p = std::begin(s);
+    auto end = std::end(s);
+    for (;;) {
+        size_t units = 0;
+        auto q = p;
+        while (q != end && units < CHUNK_MAX) {
+            auto c = static_cast<uint8_t>(*q);
+            size_t n = c < 0xe0 ? (c < 0x80 ? 1 : 2) : (c < 0xf0 ? 3 : 4);
+            auto u = n == 4 ? 2 : 1;
+            if (units + u > CHUNK_MAX) {
+                break;
+            }
+            units += u;
+            q += std::min(n, static_cast<size_t>(end - q));
+        }
+
+        if (q != end) {
+            out_ += 's';
+            write_be(units, 2);
+        } else if (p == std::begin(s) && units <= 31) {
+            out_ += static_cast<char>(units);
+        } else {
+            out_ += 'S';
+            write_be(units, 2);
+        }
+        out_.append(p, q);
+
+        if (q == end) {
+            return;
+        }
+        p = q;
+    }
+}
+
+void Hessian2Writer::write_binary(const std::string &s) {
+    if (s.size() <= 15) {
+        out_ += static_cast<char>(0x20 + s.size());
+        out_ += s;
+        return;
+    }
+
+    auto p = std::begin(s);
+    for (; static_cast<size_t>(std::end(s) - p) > CHUNK_MAX; p += CHUNK_MAX) {
+        out_ += 'b';
+        write_be(CHUNK_MAX, 2);
+        out_.append(p, p + CHUNK_MAX);
+    }
+    out_ += 'B';
+    write_be(std::end(s) - p, 2);
+    out_.append(p, std::end(s));
+}
+
+void Hessian2Writer::write_list_begin(const std::string &type, uint32_t len) {
+    out_ += 'V';
+    if (!type.empty()) {
+        out_ += 't';
+        write_be(type.size(), 2);
+        out_ += type;
+    }
+    if (len <= 0xff) {
+        out_ += 'n';
+        write_be(len, 1);
+    } else {
+        out_ += 'l';
+        write_be(len, 4);
+    }
+}
+
+void Hessian2Writer::write_string_marker(const std::string &marker,
+                                         size_t width) {
+    write_string(std::string(width, '0'));
+    out_.replace(out_.size() - width, width, marker);
+}
+
+void Hessian2Writer::write_map_begin() { out_ += 'M'; }
+
+void Hessian2Writer::write_end() { out_ += 'z'; }
+
+void Hessian2Writer::write_object_begin(
+    const std::string &classname, const std::vector<std::string> &fields) {
+    out_ += 'O';
+    write_int(classname.size());
+    out_ += classname;
+    write_int(fields.size());
+    for (auto &f : fields) {
+        write_string(f);
+    }
+    out_ += 'o';
+    write_int(nclasses_++);
+}
+
+namespace {
+struct Shape {
+    enum {
+        NUL,
+        BOOL,
+        INT,
+        LONG,
+        DOUBLE,
+        STRING,
+        BYTES,
+        LIST,
+        MAP,
+    } type;
+    // The length of a string or bytes, or the number of elements of a
+    // list or map
+    uint32_t n;
+    // The shape of the elements of a list or map
+    std::unique_ptr<Shape> elem;
+    // The marker of the slot which fills a string, or empty
+    std::string marker;
+};
+} // namespace
+
+namespace {
+// Parses a shape at |first|, and advances |first| past it.
+std::unique_ptr<Shape> parse_shape(const char *&first, const char *last,
+                                   size_t keylen, size_t depth) {
+    // Deep enough for any payload, and keeps the recursion bounded.
+    if (depth > 64) {
+        return nullptr;
+    }
+
+    if (last - first >= 2 && first[0] == '{' && first[1] == '{') {
+        // A marker may have ':' in it.
+        auto end = std::search(first, last, "}}", "}}" + 2);
+        if (end == last) {
+            return nullptr;
+        }
+        end += 2;
+        SubstSlot slot;
+        if (parse_subst_marker(slot, StringRef{first, end}, keylen) != 0) {
+            return nullptr;
+        }
+        auto shape = std::make_unique<Shape>();
+        shape->type = Shape::STRING;
+        shape->n = slot.width;
+        shape->marker.assign(first, end);
+        first = end;
+        return shape;
+    }
+
+    auto end = std::find_if(first, last,
+                            [](char c) { return c == ':' || c == ','; });
+    auto name = StringRef{first, end};
+    first = end;
+
+    auto shape = std::make_unique<Shape>();
+    shape->n = 0;
+
+    if (util::streq_l("null", name)) {
+        shape->type = Shape::NUL;
+    } else if (util::streq_l("bool", name)) {
+        shape->type = Shape::BOOL;
+    } else if (util::streq_l("int", name)) {
+        shape->type = Shape::INT;
+    } else if (util::streq_l("long", name)) {
+        shape->type = Shape::LONG;
+    } else if (util::streq_l("double", name)) {
+        shape->type = Shape::DOUBLE;
+    } else if (util::streq_l("string", name)) {
+        shape->type = Shape::STRING;
+    } else if (util::streq_l("bytes", name)) {
+        shape->type = Shape::BYTES;
+    } else if (util::streq_l("list", name)) {
+        shape->type = Shape::LIST;
+    } else if (util::streq_l("map", name)) {
+        shape->type = Shape::MAP;
+    } else {
+        return nullptr;
+    }
+
+    if (shape->type < Shape::STRING) {
+        return shape;
+    }
+
+    if (first == last || *first != ':') {
+        return nullptr;
+    }
+    ++first;
+
+    end = std::find_if(first, last,
+                       [](char c) { return c == ':' || c == ','; });
+    auto n = util::parse_uint(StringRef{first, end});
+    if (n == -1 || n > std::numeric_limits<int32_t>::max()) {
+        return nullptr;
+    }
+    shape->n = n;
+    first = end;
+
+    if (shape->type == Shape::STRING || shape->type == Shape::BYTES) {
+        return shape;
+    }
+
+    if (first == last || *first != ':') {
+        return nullptr;
+    }
+    ++first;
+
+    shape->elem = parse_shape(first, last, keylen, depth + 1);
+    if (!shape->elem) {
+        return nullptr;
+    }
+
+    return shape;
+}
+} // namespace
+
+namespace {
+const char *java_type(const Shape &shape) {
+    switch (shape.type) {
+    case Shape::NUL:
+        return "java.lang.Object";
+    case Shape::BOOL:
+        return "boolean";
+    case Shape::INT:
+        return "int";
+    case Shape::LONG:
+        return "long";
+    case Shape::DOUBLE:
+        return "double";
+    case Shape::STRING:
+        return "java.lang.String";
+    case Shape::BYTES:
+        return "[B";
+    case Shape::LIST:
+        return "java.util.List";
+    case Shape::MAP:
+        return "java.util.Map";
+    }
+    return "java.lang.Object";
+}
+} // namespace
+
+namespace {
+void write_value(Hessian2Writer &w, const Shape &shape) {
+    switch (shape.type) {
+    case Shape::NUL:
+        w.write_null();
+        return;
+    case Shape::BOOL:
+        w.write_bool(true);
+        return;
+    case Shape::INT:
+        w.write_int(1234567);
+        return;
+    case Shape::LONG:
+        w.write_long(1234567890123);
+        return;
+    case Shape::DOUBLE:
+        w.write_double(3.14159);
+        return;
+    case Shape::STRING: {
+        if (!shape.marker.empty()) {
+            w.write_string_marker(shape.marker, shape.n);
+            return;
+        }
+        std::string s(shape.n, 0);
+        for (size_t i = 0; i < s.size(); ++i) {
+            s[i] = '0' + (i + 1) % 10;
+        }
+        w.write_string(s);
+        return;
+    }
+    case Shape::BYTES: {
+        std::string s(shape.n, 0);
+        for (size_t i = 0; i < s.size(); ++i) {
+            s[i] = static_cast<char>(i);
+        }
+        w.write_binary(s);
+        return;
+    }
+    case Shape::LIST:
+        w.write_list_begin("java.util.ArrayList", shape.n);
+        for (size_t i = 0; i < shape.n; ++i) {
+            write_value(w, *shape.elem);
+        }
+        w.write_end();
+        return;
+    case Shape::MAP:
+        w.write_map_begin();
+        for (size_t i = 0; i < shape.n; ++i) {
+            w.write_string("key" + util::utos(i));
+            write_value(w, *shape.elem);
+        }
+        w.write_end();
+        return;
+    }
+}
+} // namespace
+
+int make_sofarequest_content(std::string &out, const std::string &service,
+                             const std::string &method,
+                             const std::string &args, size_t keylen) {
+    std::vector<std::unique_ptr<Shape>> shapes;
+
+    auto first = args.c_str();
+    auto last = first + args.size();
+    while (first != last) {
+        auto shape = parse_shape(first, last, keylen, 0);
+        if (!shape || (first != last && *first != ',')) {
+            return -1;
+        }
+        shapes.push_back(std::move(shape));
+        if (first != last) {
+            ++first;
+            if (first == last) {
+                return -1;
+            }
+        }
+    }
+
+    out.clear();
+    Hessian2Writer w(out);
+
+    // SOFARPC writes SofaRequest, and then the arguments one by one.
+    w.write_object_begin("com.alipay.sofa.rpc.core.request.SofaRequest",
+                         {"targetAppName", "methodName",
+                          "targetServiceUniqueName", "requestProps",
+                          "methodArgSigs"});
+    w.write_null();
+    w.write_string(method);
+    w.write_string(service);
+    w.write_map_begin();
+    w.write_string("protocol");
+    w.write_string("bolt");
+    w.write_end();
+    w.write_list_begin("[string", shapes.size());
+    for (auto &shape : shapes) {
+        w.write_string(java_type(*shape));
+    }
+    w.write_end();
+
+    for (auto &shape : shapes) {
+        write_value(w, *shape);
+    }
+
+    return 0;
+}
+
+} // namespace h2load
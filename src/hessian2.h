@@ -0,0 +1,94 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef HESSIAN2_H
+#define HESSIAN2_H
+
+#include "nghttp2_config.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace h2load {
+
+// Hessian2Writer appends values in the Hessian 2.0 encoding which
+// SOFARPC speaks over Bolt: objects start with an "O" class definition
+// and an "o" instance, and lists and maps end with "z".
+class Hessian2Writer {
+  public:
+    explicit Hessian2Writer(std::string &out) : out_(out), nclasses_(0) {}
+
+    void write_null();
+    void write_bool(bool v);
+    void write_int(int32_t v);
+    void write_long(int64_t v);
+    void write_double(double v);
+    void write_string(const std::string &s);
+    void write_binary(const std::string &s);
+    // Writes a string of |width| ASCII characters, of which |marker|
+    // stands in place.  parse_subst() replaces |marker| with the slot
+    // later, so that the length written here holds.
+    void write_string_marker(const std::string &marker, size_t width);
+    // Starts a list of |len| elements of |type|.  Call write_end()
+    // after the elements.
+    void write_list_begin(const std::string &type, uint32_t len);
+    // Starts an untyped map.  Call write_end() after the entries.
+    void write_map_begin();
+    void write_end();
+    // Writes the definition of |classname| with |fields|, followed by
+    // the start of an instance of it.  The field values follow.
+    void write_object_begin(const std::string &classname,
+                            const std::vector<std::string> &fields);
+
+  private:
+    void write_be(uint64_t v, size_t n);
+
+    std::string &out_;
+    // The number of classes defined so far
+    int32_t nclasses_;
+};
+
+// Generates the SofaRequest content calling |method| of |service| with
+// the arguments described by |args|.  |args| is a comma separated list
+// of argument shapes, each of which is one of:
+//
+//   null, bool, int, long, double
+//   string:<N>        a string of <N> characters
+//   bytes:<N>         a byte array of <N> bytes
+//   list:<N>:<SHAPE>  a list of <N> elements of <SHAPE>
+//   map:<N>:<SHAPE>   a map of <N> string keys to values of <SHAPE>
+//   {{<KIND>[:<W>]}}  a string filled by a substitution slot
+//
+// Lists and maps nest, as in "list:10:map:5:string:16".  The markers
+// of the slots are left in |out| for parse_subst(), and |keylen| is
+// as in parse_subst_marker().  Returns 0 if it succeeds, or -1 if
+// |args| is malformed.
+int make_sofarequest_content(std::string &out, const std::string &service,
+                             const std::string &method,
+                             const std::string &args, size_t keylen);
+
+} // namespace h2load
+
+#endif // HESSIAN2_H
@@ -0,0 +1,145 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "hessian2_test.h"
+
+#include <string>
+#include <vector>
+
+#include <CUnit/CUnit.h>
+
+#include "hessian2.h"
+#include "subst.h"
+#include "h2load_sofarpc_spec.h"
+
+namespace h2load {
+
+namespace {
+std::string encode_int(int32_t v) {
+    std::string out;
+    Hessian2Writer(out).write_int(v);
+    return out;
+}
+
+std::string encode_long(int64_t v) {
+    std::string out;
+    Hessian2Writer(out).write_long(v);
+    return out;
+}
+} // namespace
+
+void test_hessian2_writer(void) {
+    CU_ASSERT("\x90" == encode_int(0));
+    CU_ASSERT("\xbf" == encode_int(47));
+    CU_ASSERT("\x80" == encode_int(-16));
+    CU_ASSERT(std::string("\xc8\x30") == encode_int(48));
+    CU_ASSERT(std::string("\xd4\x08\x00", 3) == encode_int(2048));
+    CU_ASSERT(std::string("I\x00\x04\x00\x00", 5) == encode_int(262144));
+
+    CU_ASSERT("\xe0" == encode_long(0));
+    CU_ASSERT(std::string("\xf8\x10") == encode_long(16));
+    CU_ASSERT(std::string("L\x00\x00\x00\x01\x00\x00\x00\x00", 9) ==
+              encode_long(1LL << 32));
+
+    std::string out;
+    Hessian2Writer w(out);
+    w.write_string("bolt");
+    w.write_binary(std::string("\x01\x02", 2));
+    w.write_null();
+    w.write_bool(true);
+    CU_ASSERT(std::string("\x04"
+                          "bolt"
+                          "\x22\x01\x02NT") == out);
+
+    out.clear();
+    w.write_string(std::string(1098, 'x'));
+    CU_ASSERT(1101 == out.size());
+    CU_ASSERT(std::string("S\x04J") == out.substr(0, 3));
+
+    out.clear();
+    w.write_list_begin("[int", 2);
+    w.write_int(1);
+    w.write_end();
+    CU_ASSERT(std::string("Vt\x00\x04[intn\x02\x91z", 12) == out);
+}
+
+void test_hessian2_make_sofarequest_content(void) {
+    SofaRpcSpec spec;
+    std::string out;
+
+    // The built-in request is a string argument of 1098 characters;
+    // its content only differs in the digits of the string.
+    CU_ASSERT(0 == make_sofarequest_content(out, spec.service, spec.method,
+                                            "string:1098", 0));
+    CU_ASSERT(spec.content.size() == out.size());
+    CU_ASSERT(spec.content.substr(0, 1240) == out.substr(0, 1240));
+
+    out.clear();
+    CU_ASSERT(0 == make_sofarequest_content(
+                       out, spec.service, spec.method,
+                       "null,bool,int,long,double,bytes:100,"
+                       "list:3:map:2:string:8", 0));
+
+    // No arguments at all
+    out.clear();
+    CU_ASSERT(0 == make_sofarequest_content(out, spec.service, spec.method,
+                                            "", 0));
+
+    out.clear();
+    CU_ASSERT(-1 == make_sofarequest_content(out, spec.service, spec.method,
+                                             "string", 0));
+    CU_ASSERT(-1 == make_sofarequest_content(out, spec.service, spec.method,
+                                             "string:x", 0));
+    CU_ASSERT(-1 == make_sofarequest_content(out, spec.service, spec.method,
+                                             "int,", 0));
+    CU_ASSERT(-1 == make_sofarequest_content(out, spec.service, spec.method,
+                                             "list:1:float", 0));
+    CU_ASSERT(-1 == make_sofarequest_content(out, spec.service, spec.method,
+                                             "int:1", 0));
+
+    // A slot fills a string argument of its width.  The marker is left
+    // for parse_subst(), which makes the content a string of 8 digits.
+    out.clear();
+    CU_ASSERT(0 == make_sofarequest_content(out, spec.service, spec.method,
+                                            "{{seq:8}}", 0));
+    std::string digits;
+    CU_ASSERT(0 == make_sofarequest_content(digits, spec.service, spec.method,
+                                            "string:8", 0));
+    std::vector<SubstSlot> slots;
+    CU_ASSERT(0 == parse_subst(out, slots, 0, 0));
+    CU_ASSERT(1 == slots.size());
+    CU_ASSERT(digits.size() == out.size());
+    CU_ASSERT(digits.size() - 8 == slots[0].offset);
+    CU_ASSERT(digits.substr(0, slots[0].offset) ==
+              out.substr(0, slots[0].offset));
+
+    CU_ASSERT(0 == make_sofarequest_content(out, spec.service, spec.method,
+                                            "list:2:{{key}}", 16));
+    CU_ASSERT(-1 == make_sofarequest_content(out, spec.service, spec.method,
+                                             "{{key}}", 0));
+    CU_ASSERT(-1 == make_sofarequest_content(out, spec.service, spec.method,
+                                             "{{seq:8", 0));
+}
+
+} // namespace h2load
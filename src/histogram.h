@@ -0,0 +1,282 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include "nghttp2_config.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace nghttp2 {
+
+// Histogram counts non-negative integer values in log-linear buckets.
+// Values less than 2^(|precision| + 1) get a bucket of their own.
+// Above that, each power of 2 range is divided into 2^|precision|
+// equal sized buckets, so a value read back from the histogram is
+// within 2^-|precision| of the recorded one.  Memory usage only
+// depends on |precision|, not on the number of values recorded.
+class Histogram {
+  public:
+    static constexpr size_t MIN_PRECISION = 1;
+    static constexpr size_t MAX_PRECISION = 14;
+
+    explicit Histogram(size_t precision = 7)
+        : counts_((65 - precision) << precision), total_(0),
+          min_(std::numeric_limits<uint64_t>::max()), max_(0),
+          precision_(precision) {
+        assert(precision >= MIN_PRECISION && precision <= MAX_PRECISION);
+    }
+
+    void record(uint64_t v, uint64_t n = 1) {
+        counts_[bucket_index(v)] += n;
+        total_ += n;
+        min_ = std::min(min_, v);
+        max_ = std::max(max_, v);
+    }
+
+    // Adds all values recorded in |other|, which must have the same
+    // precision.
+    void merge(const Histogram &other) {
+        assert(precision_ == other.precision_);
+        if (other.total_ == 0) {
+            return;
+        }
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        total_ += other.total_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    // Adds |n| values which fall into bucket |idx|, the smallest and
+    // the largest of which are |lo| and |hi|.  This rebuilds a
+    // histogram from its buckets, such as one sent by an agent.
+    void record_bucket(size_t idx, uint64_t n, uint64_t lo, uint64_t hi) {
+        counts_[idx] += n;
+        total_ += n;
+        min_ = std::min(min_, lo);
+        max_ = std::max(max_, hi);
+    }
+
+    // Returns the value below which |percentile| percent of the
+    // recorded values fall.  The returned value is the largest one
+    // which shares the bucket, but never exceeds max().  Returns 0 if
+    // nothing has been recorded.
+    uint64_t value_at_percentile(double percentile) const {
+        if (total_ == 0) {
+            return 0;
+        }
+        auto rank = static_cast<uint64_t>(
+            std::ceil(std::min(percentile, 100.) / 100. * total_));
+        rank = std::max(rank, static_cast<uint64_t>(1));
+        uint64_t sum = 0;
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            sum += counts_[i];
+            if (sum >= rank) {
+                return std::min(bucket_highest(i), max_);
+            }
+        }
+        return max_;
+    }
+
+    // Returns the estimated number of recorded values in [|lo|,
+    // |hi|].  Values in a bucket which partially overlaps the range
+    // are assumed to be evenly spread over the bucket, narrowed by
+    // min() and max().
+    double count_between(uint64_t lo, uint64_t hi) const {
+        if (total_ == 0 || lo > hi || lo > max_ || hi < min_) {
+            return 0;
+        }
+        lo = std::max(lo, min_);
+        hi = std::min(hi, max_);
+        double n = 0;
+        auto last = bucket_index(hi);
+        for (auto i = bucket_index(lo); i <= last; ++i) {
+            if (counts_[i] == 0) {
+                continue;
+            }
+            auto first = std::max(bucket_lowest(i), min_);
+            auto end = std::min(bucket_highest(i), max_);
+            auto overlap = std::min(end, hi) - std::max(first, lo) + 1;
+            n += static_cast<double>(counts_[i]) * overlap / (end - first + 1);
+        }
+        return n;
+    }
+
+    void reset() {
+        std::fill(std::begin(counts_), std::end(counts_), 0);
+        total_ = 0;
+        min_ = std::numeric_limits<uint64_t>::max();
+        max_ = 0;
+    }
+
+    uint64_t count() const { return total_; }
+    // Returns the smallest value recorded, or 0 if nothing has been
+    // recorded.
+    uint64_t min() const { return total_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    size_t precision() const { return precision_; }
+    size_t nbuckets() const { return counts_.size(); }
+    // Returns the number of values recorded in bucket |idx|.
+    uint64_t bucket_count(size_t idx) const { return counts_[idx]; }
+
+    size_t bucket_index(uint64_t v) const {
+        if (v < (static_cast<uint64_t>(2) << precision_)) {
+            return v;
+        }
+        // The most significant bit of |v|
+        size_t msb = 63 - __builtin_clzll(v);
+        size_t shift = msb - precision_;
+        return (shift << precision_) + (v >> shift);
+    }
+
+    // Returns the smallest value which falls into bucket |idx|.
+    uint64_t bucket_lowest(size_t idx) const {
+        if (idx < (static_cast<size_t>(2) << precision_)) {
+            return idx;
+        }
+        size_t shift = (idx >> precision_) - 1;
+        return static_cast<uint64_t>(idx - (shift << precision_)) << shift;
+    }
+
+    // Returns the largest value which falls into bucket |idx|.
+    uint64_t bucket_highest(size_t idx) const {
+        if (idx < (static_cast<size_t>(2) << precision_)) {
+            return idx;
+        }
+        size_t shift = (idx >> precision_) - 1;
+        return bucket_lowest(idx) + ((static_cast<uint64_t>(1) << shift) - 1);
+    }
+
+  private:
+    std::vector<uint64_t> counts_;
+    uint64_t total_;
+    uint64_t min_;
+    uint64_t max_;
+    size_t precision_;
+};
+
+// RunningStat computes min, max, mean and standard deviation of a
+// series of values without keeping them, using Welford's online
+// algorithm.  Values are also recorded in Histogram, after being
+// multiplied by |scale|, so that the share of values within mean +/-
+// sd can be told afterwards.
+class RunningStat {
+  public:
+    RunningStat(double scale, size_t precision = 7)
+        : hist_(precision), n_(0), mean_(0), m2_(0),
+          min_(std::numeric_limits<double>::max()),
+          max_(std::numeric_limits<double>::min()), scale_(scale) {}
+
+    void add(double v) {
+        ++n_;
+        auto delta = v - mean_;
+        mean_ += delta / n_;
+        m2_ += delta * (v - mean_);
+        min_ = std::min(min_, v);
+        max_ = std::max(max_, v);
+        hist_.record(to_hist(v));
+    }
+
+    // Combines |other| into this object as if all values added to
+    // |other| had been added to this object.
+    void merge(const RunningStat &other) {
+        merge(other.n_, other.mean_, other.m2_, other.min_, other.max_,
+              other.hist_);
+    }
+    // Combines the |n| values summarized by |mean|, |m2|, |min|, |max|
+    // and |hist|, as another RunningStat of the same scale holds them,
+    // into this object.  This takes in one sent by an agent.
+    void merge(uint64_t n, double mean, double m2, double min, double max,
+               const Histogram &hist) {
+        if (n == 0) {
+            return;
+        }
+        auto total = n_ + n;
+        auto delta = mean - mean_;
+        mean_ += delta * n / total;
+        m2_ += m2 + delta * delta * n_ * n / total;
+        n_ = total;
+        min_ = std::min(min_, min);
+        max_ = std::max(max_, max);
+        hist_.merge(hist);
+    }
+
+    uint64_t count() const { return n_; }
+    double min() const { return min_; }
+    double max() const { return max_; }
+    double mean() const { return mean_; }
+    // Returns the sum of squared differences from the mean.
+    double m2() const { return m2_; }
+    // Returns standard deviation.  If |sampling| is true, this
+    // computes sample variance.  Otherwise, population variance.
+    double sd(bool sampling = false) const {
+        if (n_ == 0) {
+            return 0;
+        }
+        return std::sqrt(m2_ / (sampling && n_ > 1 ? n_ - 1 : n_));
+    }
+    // Returns percentage of number of values within mean +/- sd.
+    double within_sd(double sd) const {
+        if (n_ == 0) {
+            return 0;
+        }
+        auto lo = std::max(mean_ - sd, 0.);
+        auto n = hist_.count_between(to_hist(lo), to_hist(mean_ + sd));
+        return n / static_cast<double>(n_) * 100;
+    }
+
+    const Histogram &histogram() const { return hist_; }
+
+  private:
+    uint64_t to_hist(double v) const {
+        if (v <= 0) {
+            return 0;
+        }
+        auto x = v * scale_;
+        if (x >= static_cast<double>(std::numeric_limits<uint64_t>::max())) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        return static_cast<uint64_t>(std::llround(x));
+    }
+
+    Histogram hist_;
+    uint64_t n_;
+    double mean_;
+    // sum of squared differences from the current mean
+    double m2_;
+    double min_, max_;
+    double scale_;
+};
+
+} // namespace nghttp2
+
+#endif // HISTOGRAM_H
@@ -0,0 +1,188 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "histogram_test.h"
+
+#include <CUnit/CUnit.h>
+
+#include "histogram.h"
+
+namespace nghttp2 {
+
+void test_histogram_bucket(void) {
+    Histogram h(3);
+
+    // values less than 16 have a bucket of their own
+    for (uint64_t v = 0; v < 16; ++v) {
+        CU_ASSERT(v == h.bucket_index(v));
+        CU_ASSERT(v == h.bucket_lowest(v));
+        CU_ASSERT(v == h.bucket_highest(v));
+    }
+
+    CU_ASSERT(16 == h.bucket_index(16));
+    CU_ASSERT(16 == h.bucket_index(17));
+    CU_ASSERT(17 == h.bucket_index(18));
+    CU_ASSERT(23 == h.bucket_index(31));
+    CU_ASSERT(24 == h.bucket_index(32));
+    CU_ASSERT(24 == h.bucket_index(35));
+    CU_ASSERT(16 == h.bucket_lowest(16));
+    CU_ASSERT(17 == h.bucket_highest(16));
+    CU_ASSERT(32 == h.bucket_lowest(24));
+    CU_ASSERT(35 == h.bucket_highest(24));
+
+    auto last = h.bucket_index(std::numeric_limits<uint64_t>::max());
+
+    CU_ASSERT((65 - 3) * 8 - 1 == last);
+    CU_ASSERT(std::numeric_limits<uint64_t>::max() == h.bucket_highest(last));
+
+    // every value falls into the bucket which covers it
+    for (uint64_t v = 1; v < std::numeric_limits<uint64_t>::max() / 3;
+         v = v * 3 + 1) {
+        auto idx = h.bucket_index(v);
+
+        CU_ASSERT(h.bucket_lowest(idx) <= v);
+        CU_ASSERT(v <= h.bucket_highest(idx));
+        CU_ASSERT(h.bucket_highest(idx) + 1 == h.bucket_lowest(idx + 1));
+    }
+}
+
+void test_histogram_percentile(void) {
+    Histogram h(7);
+
+    CU_ASSERT(0 == h.value_at_percentile(50.));
+    CU_ASSERT(0 == h.min());
+    CU_ASSERT(0 == h.max());
+
+    for (uint64_t v = 1; v <= 10000; ++v) {
+        h.record(v);
+    }
+
+    CU_ASSERT(10000 == h.count());
+    CU_ASSERT(1 == h.min());
+    CU_ASSERT(10000 == h.max());
+    CU_ASSERT(100 == h.value_at_percentile(1.));
+    CU_ASSERT(10000 == h.value_at_percentile(100.));
+
+    auto p50 = h.value_at_percentile(50.);
+
+    CU_ASSERT(5000 <= p50 && p50 <= 5000 + 5000 / 128);
+
+    auto p99 = h.value_at_percentile(99.);
+
+    CU_ASSERT(9900 <= p99 && p99 <= 9900 + 9900 / 128);
+
+    // never reports more than the largest value recorded
+    h.reset();
+    h.record(1000001, 5);
+
+    CU_ASSERT(5 == h.count());
+    CU_ASSERT(1000001 == h.value_at_percentile(50.));
+}
+
+void test_histogram_merge(void) {
+    Histogram a(7), b(7);
+
+    a.record(10, 90);
+    b.record(2000000, 10);
+    b.record(3);
+
+    a.merge(b);
+
+    CU_ASSERT(101 == a.count());
+    CU_ASSERT(3 == a.min());
+    CU_ASSERT(2000000 == a.max());
+    CU_ASSERT(10 == a.value_at_percentile(90.));
+    CU_ASSERT(2000000 == a.value_at_percentile(99.));
+
+    // merging empty histogram changes nothing
+    a.merge(Histogram(7));
+
+    CU_ASSERT(101 == a.count());
+    CU_ASSERT(3 == a.min());
+}
+
+void test_histogram_count_between(void) {
+    Histogram h(7);
+
+    CU_ASSERT(0 == h.count_between(0, 100));
+
+    for (uint64_t v = 1; v <= 100; ++v) {
+        h.record(v);
+    }
+
+    CU_ASSERT(10 == h.count_between(11, 20));
+    CU_ASSERT(100 == h.count_between(0, 1000));
+    CU_ASSERT(0 == h.count_between(101, 1000));
+
+    // 1000 values evenly spread inside one bucket [32768, 33023]
+    h.reset();
+    for (uint64_t v = 0; v < 1000; ++v) {
+        h.record(32768 + v % 256);
+    }
+
+    auto n = h.count_between(32768, 32768 + 127);
+
+    CU_ASSERT(490 <= n && n <= 510);
+}
+
+void test_running_stat(void) {
+    RunningStat a(1e6), b(1e6), all(1e6);
+
+    CU_ASSERT(0 == a.count());
+    CU_ASSERT(0 == a.sd());
+    CU_ASSERT(0 == a.within_sd(a.sd()));
+
+    // 2, 4, 4, 4, 5, 5, 7, 9 in seconds; mean 5 and sd 2
+    for (auto v : {2., 4., 4., 4.}) {
+        a.add(v);
+        all.add(v);
+    }
+    for (auto v : {5., 5., 7., 9.}) {
+        b.add(v);
+        all.add(v);
+    }
+
+    CU_ASSERT(8 == all.count());
+    CU_ASSERT(2. == all.min());
+    CU_ASSERT(9. == all.max());
+    CU_ASSERT(std::abs(all.mean() - 5.) < 1e-9);
+    CU_ASSERT(std::abs(all.sd() - 2.) < 1e-9);
+    CU_ASSERT(std::abs(all.sd(true) - std::sqrt(32. / 7)) < 1e-9);
+    // 7 is right on mean + sd, and shares its bucket with larger
+    // values, so it may be counted only partially.
+    auto within = all.within_sd(all.sd());
+
+    CU_ASSERT(62.5 <= within && within <= 75.);
+
+    a.merge(b);
+
+    CU_ASSERT(8 == a.count());
+    CU_ASSERT(2. == a.min());
+    CU_ASSERT(9. == a.max());
+    CU_ASSERT(std::abs(a.mean() - 5.) < 1e-9);
+    CU_ASSERT(std::abs(a.sd() - 2.) < 1e-9);
+    CU_ASSERT(within == a.within_sd(a.sd()));
+}
+
+} // namespace nghttp2
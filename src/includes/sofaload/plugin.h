@@ -0,0 +1,90 @@
+/*
+ * sofaload
+ *
+ * Copyright (c) 2019 Ye Yongjie
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef SOFALOAD_PLUGIN_H
+#define SOFALOAD_PLUGIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*
+ * The interface of a --plugin library, which fills the {{plugin}}
+ * slots of requests.  sofaload loads the library with dlopen(3), and
+ * looks up the functions declared below.
+ *
+ * Each worker gets a context of its own from sofaload_plugin_init(),
+ * and only the worker's thread fills slots with it, so that a plugin
+ * needs no locking unless its contexts share state.
+ * sofaload_plugin_init() and sofaload_plugin_free() are called from
+ * the main thread, before the workers start and after they are done.
+ *
+ * The time sofaload_plugin_fill() takes is reported on its own, and
+ * is not counted in the latency of requests.
+ */
+
+/* The version of this interface */
+#define SOFALOAD_PLUGIN_VERSION 1
+
+/*
+ * Returns SOFALOAD_PLUGIN_VERSION the plugin was built with.
+ */
+int sofaload_plugin_version(void);
+
+/*
+ * Returns the context of worker |worker_id| of |nworkers|, or NULL
+ * if it fails.  |arg| is --plugin-arg, or "" if it is not given.
+ */
+void *sofaload_plugin_init(uint32_t worker_id, uint32_t nworkers,
+                           const char *arg);
+
+/*
+ * Fills the |len| bytes at |buf|, which is the slot of a marker
+ * {{plugin:<len>:<tag>}} in the write buffer of a request.  |seq| is
+ * the sequence number of the request, which all slots of it share, as
+ * {{seq}} does.  Returns 0 if it succeeds, or -1.  The request is
+ * sent either way, but failures are counted.
+ */
+int sofaload_plugin_fill(void *ctx, uint8_t *buf, size_t len, uint64_t seq,
+                         uint32_t tag);
+
+/*
+ * Frees |ctx|.
+ */
+void sofaload_plugin_free(void *ctx);
+
+typedef int (*sofaload_plugin_version_func)(void);
+typedef void *(*sofaload_plugin_init_func)(uint32_t, uint32_t, const char *);
+typedef int (*sofaload_plugin_fill_func)(void *, uint8_t *, size_t, uint64_t,
+                                         uint32_t);
+typedef void (*sofaload_plugin_free_func)(void *);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* SOFALOAD_PLUGIN_H */
@@ -36,6 +36,7 @@ struct iovec {
 };
 #else // !_WIN32
 #include <sys/uio.h>
+#include <sys/mman.h>
 #endif // !_WIN32
 
 #include <algorithm>
@@ -43,8 +44,10 @@ struct iovec {
 #include <cassert>
 #include <cstring>
 #include <memory>
+#include <new>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "template.h"
 
@@ -107,8 +110,212 @@ template <typename T> struct Pool {
     size_t poolsize;
 };
 
-template <typename Memchunk> struct Memchunks {
-    Memchunks(Pool<Memchunk> *pool)
+// SizedMemchunk is Memchunk whose size is chosen at runtime.  Its
+// buffer is [begin, end), outside of the object.
+struct SizedMemchunk {
+    SizedMemchunk(SizedMemchunk *next_chunk, uint8_t *begin, uint8_t *end)
+        : begin(begin), end(end), pos(begin), last(begin), knext(next_chunk),
+          next(nullptr), ref(false) {}
+    size_t len() const { return last - pos; }
+    size_t left() const { return end - last; }
+    void reset() { pos = last = begin; }
+    uint8_t *begin, *end;
+    uint8_t *pos, *last;
+    SizedMemchunk *knext;
+    SizedMemchunk *next;
+    // true if [begin, end) is memory owned by someone else, and not
+    // a buffer of the pool
+    bool ref;
+};
+
+// How SlabPool gets its memory
+enum class SlabBacking {
+    // Regular pages
+    PAGES,
+    // Transparent huge pages, which the kernel may or may not give
+    THP,
+    // Huge pages reserved in the hugetlb pool
+    HUGETLB,
+};
+
+// SlabPool is Pool for SizedMemchunk of |chunk_size| bytes.  Chunks
+// are cut from slabs of SLAB_SIZE bytes or more, which are mapped with
+// |backing| when it is available, and with regular pages otherwise.
+// Huge pages save TLB misses when many chunks are in use.  Slabs are
+// only returned to the system by clear().
+struct SlabPool {
+    // The size of huge pages on x86-64 and most arm64 systems
+    static constexpr size_t SLAB_SIZE = 2 * 1024 * 1024;
+
+    SlabPool(size_t chunk_size, SlabBacking backing = SlabBacking::PAGES)
+        : pool(nullptr), freelist(nullptr), reffreelist(nullptr),
+          slabs(nullptr), slab_last(nullptr),
+          slab_end(nullptr), poolsize(0), chunk_size(chunk_size),
+          unit_size(align64(sizeof(SizedMemchunk)) + align64(chunk_size)),
+          requested(backing), backing(backing), nget(0), nmiss(0), nused(0),
+          peak_used(0) {}
+    ~SlabPool() { clear(); }
+    SlabPool(const SlabPool &) = delete;
+    SlabPool &operator=(const SlabPool &) = delete;
+
+    SizedMemchunk *get() {
+        ++nget;
+        peak_used = std::max(peak_used, ++nused);
+        if (freelist) {
+            auto m = freelist;
+            freelist = freelist->next;
+            m->next = nullptr;
+            m->reset();
+            return m;
+        }
+
+        ++nmiss;
+        if (static_cast<size_t>(slab_end - slab_last) < unit_size) {
+            alloc_slab();
+        }
+        auto p = slab_last;
+        slab_last += unit_size;
+        auto begin = p + align64(sizeof(SizedMemchunk));
+        pool = new (p) SizedMemchunk(pool, begin, begin + chunk_size);
+        poolsize += chunk_size;
+        return pool;
+    }
+    // Returns a chunk which refers to |len| bytes at |data| instead of
+    // having its own buffer, so that the data is written without being
+    // copied.  The data must outlive the chunk.  Such chunks are full
+    // from the start, and are not counted in the stats.
+    SizedMemchunk *get_ref(const uint8_t *data, size_t len) {
+        SizedMemchunk *m;
+        if (reffreelist) {
+            m = reffreelist;
+            reffreelist = reffreelist->next;
+            m->next = nullptr;
+        } else {
+            auto hdlen = align64(sizeof(SizedMemchunk));
+            if (static_cast<size_t>(slab_end - slab_last) < hdlen) {
+                alloc_slab();
+            }
+            m = new (slab_last) SizedMemchunk(nullptr, nullptr, nullptr);
+            m->ref = true;
+            slab_last += hdlen;
+        }
+        m->begin = m->pos = const_cast<uint8_t *>(data);
+        m->end = m->last = m->begin + len;
+        return m;
+    }
+    void recycle(SizedMemchunk *m) {
+        if (m->ref) {
+            m->next = reffreelist;
+            reffreelist = m;
+            return;
+        }
+        --nused;
+        m->next = freelist;
+        freelist = m;
+    }
+    void clear() {
+        for (auto slab = slabs; slab;) {
+            auto next = slab->next;
+            unmap(slab, slab->size);
+            slab = next;
+        }
+        pool = nullptr;
+        freelist = nullptr;
+        reffreelist = nullptr;
+        slabs = nullptr;
+        slab_last = slab_end = nullptr;
+        poolsize = 0;
+        nused = 0;
+    }
+
+    using value_type = SizedMemchunk;
+    SizedMemchunk *pool;
+    SizedMemchunk *freelist;
+    SizedMemchunk *reffreelist;
+
+  private:
+    // Each slab starts with this
+    struct Slab {
+        Slab *next;
+        size_t size;
+    };
+
+    static size_t align64(size_t n) {
+        return (n + 63) & ~static_cast<size_t>(63);
+    }
+
+    void alloc_slab() {
+        auto size = (unit_size + 64 + SLAB_SIZE - 1) / SLAB_SIZE * SLAB_SIZE;
+        auto p = map(size);
+        auto slab = static_cast<Slab *>(p);
+        slab->next = slabs;
+        slab->size = size;
+        slabs = slab;
+        // Keep chunks cache line aligned.
+        slab_last = static_cast<uint8_t *>(p) + 64;
+        slab_end = static_cast<uint8_t *>(p) + size;
+    }
+
+    // Throws std::bad_alloc if no memory is left, like new does.
+    void *map(size_t size) {
+#ifndef _WIN32
+#  ifdef MAP_HUGETLB
+        if (backing == SlabBacking::HUGETLB) {
+            auto p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED) {
+                return p;
+            }
+            // No huge pages are reserved.  Ask for transparent ones
+            // instead.
+            backing = SlabBacking::THP;
+        }
+#  endif // MAP_HUGETLB
+        auto p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+#  ifdef MADV_HUGEPAGE
+        if (backing == SlabBacking::THP && madvise(p, size, MADV_HUGEPAGE)) {
+            backing = SlabBacking::PAGES;
+        }
+#  endif // MADV_HUGEPAGE
+        return p;
+#else  // _WIN32
+        return new uint8_t[size];
+#endif // _WIN32
+    }
+
+    void unmap(void *p, size_t size) {
+#ifndef _WIN32
+        munmap(p, size);
+#else  // _WIN32
+        delete[] static_cast<uint8_t *>(p);
+#endif // _WIN32
+    }
+
+    Slab *slabs;
+    // The part of the newest slab not cut into chunks yet
+    uint8_t *slab_last, *slab_end;
+
+  public:
+    // The total size of the chunks cut so far
+    size_t poolsize;
+    size_t chunk_size;
+    // The size of a chunk with its header
+    size_t unit_size;
+    // The backing asked for, and the one slabs got last
+    SlabBacking requested, backing;
+    // The number of get() calls, and those served by new chunks
+    uint64_t nget, nmiss;
+    // The number of chunks in use now, and at most
+    size_t nused, peak_used;
+};
+
+template <typename Memchunk, typename PoolType = Pool<Memchunk>>
+struct Memchunks {
+    Memchunks(PoolType *pool)
         : pool(pool), head(nullptr), tail(nullptr), len(0) {}
     Memchunks(const Memchunks &) = delete;
     Memchunks(Memchunks &&other) noexcept
@@ -179,6 +386,42 @@ template <typename Memchunk> struct Memchunks {
 
         return count;
     }
+    // Appends |count| bytes at |src| without copying them, with a chunk
+    // from PoolType::get_ref().  The data must outlive this object, or
+    // be drained first.  Later appends go to a new chunk.
+    size_t append_ref(const void *src, size_t count) {
+        if (count == 0) {
+            return 0;
+        }
+
+        auto m = pool->get_ref(static_cast<const uint8_t *>(src), count);
+        if (!tail) {
+            head = tail = m;
+        } else {
+            tail->next = m;
+            tail = m;
+        }
+        len += count;
+
+        return count;
+    }
+    // Appends |count| bytes for the caller to fill, and returns the
+    // pointer to them.  They are contiguous, so they start a new chunk
+    // if the last one has too little room left.  |count| must not
+    // exceed the size of a chunk.
+    uint8_t *append_slot(size_t count) {
+        if (!tail) {
+            head = tail = pool->get();
+        } else if (tail->left() < count) {
+            tail->next = pool->get();
+            tail = tail->next;
+        }
+        assert(tail->left() >= count);
+        auto p = tail->last;
+        tail->last += count;
+        len += count;
+        return p;
+    }
     template <size_t N> size_t append(const char (&s)[N]) {
         return append(s, N - 1);
     }
@@ -324,7 +567,7 @@ template <typename Memchunk> struct Memchunks {
         head = tail = nullptr;
     }
 
-    Pool<Memchunk> *pool;
+    PoolType *pool;
     Memchunk *head, *tail;
     size_t len;
 };
@@ -449,6 +692,7 @@ using Memchunk16K = Memchunk<16_k>;
 using MemchunkPool = Pool<Memchunk16K>;
 using DefaultMemchunks = Memchunks<Memchunk16K>;
 using DefaultPeekMemchunks = PeekMemchunks<Memchunk16K>;
+using SlabMemchunks = Memchunks<SizedMemchunk, SlabPool>;
 
 inline int limit_iovec(struct iovec *iov, int iovcnt, size_t max) {
     if (max == 0) {
@@ -562,6 +806,90 @@ template <typename Memchunk> struct MemchunkBuffer {
 
 using DefaultMemchunkBuffer = MemchunkBuffer<Memchunk16K>;
 
+// IovecQueue is a bounded FIFO of buffers which are written in order
+// with writev(2).  Unlike Memchunks, it does not copy data which is
+// shared by many writes: an entry either refers to memory owned by
+// someone else, which must outlive the entry, or to a small per-entry
+// slot of N bytes carrying data which differs per write.  It offers
+// the same riovec/drain/rleft interface as Memchunks.
+template <size_t N> struct IovecQueue {
+    IovecQueue() : mask(0), head(0), cnt(0), len(0) {}
+    IovecQueue(const IovecQueue &) = delete;
+    IovecQueue &operator=(const IovecQueue &) = delete;
+    // Allocates room for at least |n| entries.  This function must be
+    // called while the queue is empty.
+    void init(size_t n) {
+        assert(cnt == 0);
+        size_t cap = 1;
+        while (cap < n) {
+            cap <<= 1;
+        }
+        iovs.resize(cap);
+        slots.resize(cap);
+        mask = cap - 1;
+        head = 0;
+    }
+    // Returns the number of entries which can still be pushed.
+    size_t wleft() const { return iovs.size() - cnt; }
+    // Appends an entry of |count| bytes stored in its own slot, and
+    // returns the pointer to the slot so that the caller fills it.
+    // |count| must be less than or equal to N.
+    uint8_t *push_slot(size_t count) {
+        assert(count <= N);
+        assert(wleft() > 0);
+        auto i = (head + cnt++) & mask;
+        auto p = slots[i].data();
+        iovs[i].iov_base = p;
+        iovs[i].iov_len = count;
+        len += count;
+        return p;
+    }
+    // Appends an entry which refers to |count| bytes pointed by |src|.
+    void push_ref(const void *src, size_t count) {
+        assert(wleft() > 0);
+        auto i = (head + cnt++) & mask;
+        iovs[i].iov_base = const_cast<void *>(src);
+        iovs[i].iov_len = count;
+        len += count;
+    }
+    int riovec(struct iovec *iov, int iovcnt) const {
+        auto n = std::min(static_cast<size_t>(iovcnt), cnt);
+        for (size_t i = 0; i < n; ++i) {
+            iov[i] = iovs[(head + i) & mask];
+        }
+        return n;
+    }
+    size_t drain(size_t count) {
+        auto ndata = count;
+        while (cnt && count) {
+            auto &v = iovs[head];
+            auto n = std::min(count, v.iov_len);
+            v.iov_base = static_cast<uint8_t *>(v.iov_base) + n;
+            v.iov_len -= n;
+            count -= n;
+            len -= n;
+            if (v.iov_len > 0) {
+                break;
+            }
+            head = (head + 1) & mask;
+            --cnt;
+        }
+        return ndata - count;
+    }
+    size_t rleft() const { return len; }
+    void reset() { head = cnt = len = 0; }
+
+    std::vector<struct iovec> iovs;
+    std::vector<std::array<uint8_t, N>> slots;
+    size_t mask;
+    // index of the first entry
+    size_t head;
+    // The number of entries in the queue
+    size_t cnt;
+    // The number of bytes in the queue
+    size_t len;
+};
+
 } // namespace nghttp2
 
 #endif // MEMCHUNK_H
@@ -81,6 +81,111 @@ void test_pool_recycle(void) {
     CU_ASSERT(nullptr == m2->next);
 }
 
+void test_slab_pool(void) {
+    // A chunk does not fit in the rest of the first slab.
+    SlabPool pool(1_m);
+
+    auto m1 = pool.get();
+
+    CU_ASSERT(m1 == pool.pool);
+    CU_ASSERT(1_m == m1->left());
+    CU_ASSERT(0 == m1->len());
+    CU_ASSERT(0 == reinterpret_cast<uintptr_t>(m1->begin) % 64);
+    CU_ASSERT(1_m == pool.poolsize);
+
+    auto m2 = pool.get();
+
+    CU_ASSERT(m1 == m2->knext);
+    CU_ASSERT(m2->begin >= m1->end || m2->end <= m1->begin);
+    CU_ASSERT(2 == pool.nused);
+    CU_ASSERT(2 == pool.nmiss);
+
+    m2->last += 100;
+    pool.recycle(m2);
+
+    CU_ASSERT(1 == pool.nused);
+    CU_ASSERT(m2 == pool.freelist);
+
+    auto m3 = pool.get();
+
+    CU_ASSERT(m2 == m3);
+    CU_ASSERT(0 == m3->len());
+    CU_ASSERT(3 == pool.nget);
+    CU_ASSERT(2 == pool.nmiss);
+    CU_ASSERT(2 == pool.peak_used);
+    CU_ASSERT(SlabBacking::PAGES == pool.backing);
+
+    {
+        SlabMemchunks chunks(&pool);
+        std::string s(1_m + 10, 'a');
+        chunks.append(s);
+
+        CU_ASSERT(1_m + 10 == chunks.rleft());
+        CU_ASSERT(4 == pool.nused);
+
+        chunks.drain(1_m);
+
+        CU_ASSERT(3 == pool.nused);
+        CU_ASSERT(10 == chunks.rleft());
+    }
+
+    CU_ASSERT(2 == pool.nused);
+
+    pool.clear();
+
+    CU_ASSERT(0 == pool.poolsize);
+    CU_ASSERT(nullptr == pool.freelist);
+}
+
+void test_slab_memchunks_append_ref(void) {
+    SlabPool pool(16);
+    std::string data(100, 'x');
+    std::array<struct iovec, 4> iov;
+
+    {
+        SlabMemchunks chunks(&pool);
+
+        chunks.append("012");
+        chunks.append_ref(data.c_str(), data.size());
+        chunks.append("345");
+
+        CU_ASSERT(106 == chunks.rleft());
+        CU_ASSERT(2 == pool.nused);
+
+        auto iovcnt = chunks.riovec(iov.data(), iov.size());
+
+        CU_ASSERT(3 == iovcnt);
+        CU_ASSERT(3 == iov[0].iov_len);
+        CU_ASSERT(data.c_str() == iov[1].iov_base);
+        CU_ASSERT(100 == iov[1].iov_len);
+        CU_ASSERT(3 == iov[2].iov_len);
+        CU_ASSERT(0 == memcmp("345", iov[2].iov_base, 3));
+
+        chunks.drain(53);
+
+        CU_ASSERT(reinterpret_cast<const uint8_t *>(data.c_str()) + 50 ==
+                  chunks.head->pos);
+        CU_ASSERT(1 == pool.nused);
+
+        chunks.drain(50);
+
+        CU_ASSERT(3 == chunks.rleft());
+        CU_ASSERT(nullptr != pool.reffreelist);
+    }
+
+    // A recycled reference is reused for the next one.
+    auto m = pool.reffreelist;
+    auto ref = pool.get_ref(reinterpret_cast<const uint8_t *>(data.c_str()), 7);
+
+    CU_ASSERT(m == ref);
+    CU_ASSERT(ref->ref);
+    CU_ASSERT(7 == ref->len());
+    CU_ASSERT(0 == ref->left());
+    CU_ASSERT(0 == pool.nused);
+
+    pool.recycle(ref);
+}
+
 using Memchunk16 = Memchunk<16>;
 using MemchunkPool16 = Pool<Memchunk16>;
 using Memchunks16 = Memchunks<Memchunk16>;
@@ -151,7 +256,7 @@ void test_memchunks_riovec(void) {
     MemchunkPool16 pool;
     Memchunks16 chunks(&pool);
 
-    char buf[3 * 16];
+    char buf[3 * 16]{};
 
     chunks.append(buf, sizeof(buf));
 
@@ -184,7 +289,7 @@ void test_memchunks_recycle(void) {
     MemchunkPool16 pool;
     {
         Memchunks16 chunks(&pool);
-        char buf[32];
+        char buf[32]{};
         chunks.append(buf, sizeof(buf));
     }
     CU_ASSERT(32 == pool.poolsize);
@@ -337,4 +442,49 @@ void test_peek_memchunks_reset(void) {
     CU_ASSERT(pchunks.peeking);
 }
 
+void test_iovec_queue(void) {
+    IovecQueue<8> q;
+    std::array<uint8_t, 32> body{};
+
+    q.init(3);
+
+    CU_ASSERT(4 == q.wleft());
+
+    auto p = q.push_slot(5);
+    std::copy_n("hello", 5, p);
+    q.push_ref(body.data(), body.size());
+    q.push_ref(body.data(), body.size());
+
+    CU_ASSERT(1 == q.wleft());
+    CU_ASSERT(69 == q.rleft());
+
+    std::array<struct iovec, 2> iov;
+
+    CU_ASSERT(2 == q.riovec(iov.data(), iov.size()));
+    CU_ASSERT(p == iov[0].iov_base);
+    CU_ASSERT(5 == iov[0].iov_len);
+    CU_ASSERT(body.data() == iov[1].iov_base);
+    CU_ASSERT(32 == iov[1].iov_len);
+
+    CU_ASSERT(7 == q.drain(7));
+    CU_ASSERT(62 == q.rleft());
+    CU_ASSERT(2 == q.wleft());
+
+    CU_ASSERT(2 == q.riovec(iov.data(), iov.size()));
+    CU_ASSERT(body.data() + 2 == iov[0].iov_base);
+    CU_ASSERT(30 == iov[0].iov_len);
+
+    // wraps around
+    q.push_slot(8);
+    q.push_slot(8);
+
+    CU_ASSERT(0 == q.wleft());
+    CU_ASSERT(78 == q.rleft());
+
+    CU_ASSERT(78 == q.drain(100));
+    CU_ASSERT(0 == q.rleft());
+    CU_ASSERT(4 == q.wleft());
+    CU_ASSERT(0 == q.riovec(iov.data(), iov.size()));
+}
+
 } // namespace nghttp2
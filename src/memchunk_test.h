@@ -32,6 +32,8 @@
 namespace nghttp2 {
 
 void test_pool_recycle(void);
+void test_slab_pool(void);
+void test_slab_memchunks_append_ref(void);
 void test_memchunks_append(void);
 void test_memchunks_drain(void);
 void test_memchunks_riovec(void);
@@ -41,6 +43,7 @@ void test_peek_memchunks_append(void);
 void test_peek_memchunks_disable_peek_drain(void);
 void test_peek_memchunks_disable_peek_no_drain(void);
 void test_peek_memchunks_reset(void);
+void test_iovec_queue(void);
 
 } // namespace nghttp2
 
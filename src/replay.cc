@@ -0,0 +1,186 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "replay.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include "util.h"
+
+using namespace nghttp2;
+
+namespace h2load {
+
+namespace {
+uint64_t get_uint64(const uint8_t *data) {
+    return static_cast<uint64_t>(util::get_uint32(data)) << 32 |
+           util::get_uint32(data + 4);
+}
+} // namespace
+
+ReplayFile::ReplayFile()
+    : data_(nullptr), len_(0), mapped_(false), nrecords_(0), duration_(0) {}
+
+ReplayFile::~ReplayFile() {
+    if (mapped_) {
+        munmap(const_cast<uint8_t *>(data_), len_);
+    }
+}
+
+int ReplayFile::open(const std::string &path, size_t ntemplates) {
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        std::cerr << "--replay: cannot open " << path << ": "
+                  << strerror(errno) << std::endl;
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        std::cerr << "--replay: cannot stat " << path << ": "
+                  << strerror(errno) << std::endl;
+        close(fd);
+        return -1;
+    }
+
+    if (static_cast<size_t>(st.st_size) < REPLAY_HEADER_LEN) {
+        std::cerr << "--replay: " << path << " is not a capture" << std::endl;
+        close(fd);
+        return -1;
+    }
+
+    auto p = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        std::cerr << "--replay: cannot map " << path << ": "
+                  << strerror(errno) << std::endl;
+        return -1;
+    }
+
+    // The records are read once, in order, both here and by the
+    // workers.
+    madvise(p, st.st_size, MADV_SEQUENTIAL);
+
+    auto rv = load(static_cast<const uint8_t *>(p), st.st_size, ntemplates);
+    mapped_ = true;
+    if (rv != 0) {
+        std::cerr << "--replay: " << path << " is malformed" << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+int ReplayFile::load(const uint8_t *data, size_t len, size_t ntemplates) {
+    data_ = data;
+    len_ = len;
+    nrecords_ = 0;
+    duration_ = 0;
+
+    if (len < REPLAY_HEADER_LEN || memcmp(data, "SLRP", 4) != 0) {
+        std::cerr << "--replay: the magic SLRP is missing" << std::endl;
+        return -1;
+    }
+    if (util::get_uint32(data + 4) != REPLAY_VERSION) {
+        std::cerr << "--replay: version " << util::get_uint32(data + 4)
+                  << " is not supported" << std::endl;
+        return -1;
+    }
+
+    for (auto pos = begin(); pos != end();) {
+        if (static_cast<size_t>(end() - pos) < REPLAY_RECORD_HEADER_LEN ||
+            static_cast<size_t>(end() - pos) <
+                REPLAY_RECORD_HEADER_LEN + util::get_uint16(pos + 12)) {
+            std::cerr << "--replay: record " << nrecords_ << " is truncated"
+                      << std::endl;
+            return -1;
+        }
+        ReplayRecord rec;
+        pos = read_replay_record(rec, pos);
+        if (rec.time < duration_) {
+            std::cerr << "--replay: record " << nrecords_
+                      << " is earlier than the one before" << std::endl;
+            return -1;
+        }
+        if (rec.tmpl >= ntemplates) {
+            std::cerr << "--replay: record " << nrecords_ << " has template "
+                      << rec.tmpl << ", but only " << ntemplates
+                      << " are given" << std::endl;
+            return -1;
+        }
+        duration_ = rec.time;
+        ++nrecords_;
+    }
+
+    if (nrecords_ == 0) {
+        std::cerr << "--replay: no record is in the capture" << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+const uint8_t *read_replay_record(ReplayRecord &rec, const uint8_t *pos) {
+    rec.time = get_uint64(pos);
+    rec.tmpl = util::get_uint32(pos + 8);
+    rec.paramlen = util::get_uint16(pos + 12);
+    rec.param = pos + REPLAY_RECORD_HEADER_LEN;
+    return rec.param + rec.paramlen;
+}
+
+ReplayCursor::ReplayCursor()
+    : pos_(nullptr), end_(nullptr), step_(1), next_{}, done_(true) {}
+
+void ReplayCursor::init(const ReplayFile &file, size_t first, size_t step) {
+    pos_ = file.begin();
+    end_ = file.end();
+    step_ = step;
+    done_ = false;
+    for (size_t i = 0; i < first && pos_ != end_; ++i) {
+        pos_ = read_replay_record(next_, pos_);
+    }
+    advance();
+}
+
+void ReplayCursor::advance() {
+    if (pos_ == end_) {
+        done_ = true;
+        return;
+    }
+    pos_ = read_replay_record(next_, pos_);
+    // Skip the records of the other workers.
+    for (size_t i = 1; i < step_ && pos_ != end_; ++i) {
+        ReplayRecord rec;
+        pos_ = read_replay_record(rec, pos_);
+    }
+}
+
+} // namespace h2load
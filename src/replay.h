@@ -0,0 +1,123 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "nghttp2_config.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace h2load {
+
+// A capture of requests for --replay starts with the magic "SLRP" and
+// a version of 4 bytes, 1 for now.  Then come the records, each of:
+//
+//   the time since the start of the capture in microseconds: 8 bytes
+//   the index of the request template: 4 bytes
+//   the length of the parameter: 2 bytes
+//   the parameter
+//
+// The integers are in network byte order, and the records are in the
+// order of their times.
+constexpr size_t REPLAY_HEADER_LEN = 8;
+constexpr size_t REPLAY_RECORD_HEADER_LEN = 14;
+constexpr uint32_t REPLAY_VERSION = 1;
+
+struct ReplayRecord {
+    // The time since the start of the capture, in microseconds
+    uint64_t time;
+    // The index of the request template
+    uint32_t tmpl;
+    // The parameter, which fills the {{param}} slots of the request
+    const uint8_t *param;
+    uint16_t paramlen;
+};
+
+// ReplayFile is a capture of requests mapped into memory.  Its pages
+// are read as the records are, and are easy for the kernel to reclaim
+// once passed, so that a capture need not fit in memory.
+class ReplayFile {
+  public:
+    ReplayFile();
+    ReplayFile(const ReplayFile &) = delete;
+    ReplayFile &operator=(const ReplayFile &) = delete;
+    ~ReplayFile();
+
+    // Maps the capture in |path|, and checks it as load() does.
+    // Returns 0 if it succeeds, or -1 after printing the error.
+    int open(const std::string &path, size_t ntemplates);
+    // Checks that the capture of |len| bytes at |data| is well formed,
+    // and that its templates are less than |ntemplates|.  |data| must
+    // outlive this object.  Returns 0 if it succeeds, or -1 after
+    // printing the error.
+    int load(const uint8_t *data, size_t len, size_t ntemplates);
+
+    // The first record, and the end of the records
+    const uint8_t *begin() const { return data_ + REPLAY_HEADER_LEN; }
+    const uint8_t *end() const { return data_ + len_; }
+    // The number of records
+    size_t size() const { return nrecords_; }
+    // The time of the last record, in microseconds
+    uint64_t duration() const { return duration_; }
+
+  private:
+    const uint8_t *data_;
+    size_t len_;
+    // true if |data_| is mapped by open()
+    bool mapped_;
+    size_t nrecords_;
+    uint64_t duration_;
+};
+
+// Reads the record at |pos|, which is in a ReplayFile, into |rec|, and
+// returns the position of the next one.
+const uint8_t *read_replay_record(ReplayRecord &rec, const uint8_t *pos);
+
+// ReplayCursor walks the records of a ReplayFile one worker sends.
+class ReplayCursor {
+  public:
+    ReplayCursor();
+    // Takes every |step|-th record of |file| from the |first|-th one.
+    void init(const ReplayFile &file, size_t first, size_t step);
+    // Returns true if no record is left.
+    bool done() const { return done_; }
+    // The next record, unless done() returns true
+    const ReplayRecord &next() const { return next_; }
+    // Moves on to the record after next.
+    void advance();
+
+  private:
+    const uint8_t *pos_;
+    const uint8_t *end_;
+    size_t step_;
+    ReplayRecord next_;
+    bool done_;
+};
+
+} // namespace h2load
+
+#endif // REPLAY_H
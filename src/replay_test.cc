@@ -0,0 +1,166 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "replay_test.h"
+
+#include <string>
+
+#include <CUnit/CUnit.h>
+
+#include "replay.h"
+
+namespace h2load {
+
+namespace {
+void append_uint(std::string &s, uint64_t n, size_t len) {
+    for (size_t i = len; i > 0; --i) {
+        s += static_cast<char>(n >> ((i - 1) * 8));
+    }
+}
+
+void append_record(std::string &s, uint64_t time, uint32_t tmpl,
+                   const std::string &param) {
+    append_uint(s, time, 8);
+    append_uint(s, tmpl, 4);
+    append_uint(s, param.size(), 2);
+    s += param;
+}
+
+std::string make_capture() {
+    std::string s = "SLRP";
+    append_uint(s, REPLAY_VERSION, 4);
+    append_record(s, 0, 0, "alice");
+    append_record(s, 1500, 1, "");
+    append_record(s, 1500, 0, "bob");
+    append_record(s, 1ULL << 40, 1, "carol");
+    return s;
+}
+
+const uint8_t *bytes(const std::string &s) {
+    return reinterpret_cast<const uint8_t *>(s.data());
+}
+} // namespace
+
+void test_replay_file(void) {
+    auto s = make_capture();
+    {
+        ReplayFile f;
+        CU_ASSERT(0 == f.load(bytes(s), s.size(), 2));
+        CU_ASSERT(4 == f.size());
+        CU_ASSERT((1ULL << 40) == f.duration());
+
+        ReplayRecord rec;
+        auto pos = read_replay_record(rec, f.begin());
+        CU_ASSERT(0 == rec.time);
+        CU_ASSERT(0 == rec.tmpl);
+        CU_ASSERT("alice" == std::string(rec.param, rec.param + rec.paramlen));
+        pos = read_replay_record(rec, pos);
+        CU_ASSERT(1500 == rec.time);
+        CU_ASSERT(1 == rec.tmpl);
+        CU_ASSERT(0 == rec.paramlen);
+    }
+    {
+        // Only one template is given.
+        ReplayFile f;
+        CU_ASSERT(-1 == f.load(bytes(s), s.size(), 1));
+    }
+    {
+        // The last record is cut short.
+        ReplayFile f;
+        CU_ASSERT(-1 == f.load(bytes(s), s.size() - 1, 2));
+    }
+    {
+        auto bad = s;
+        bad[0] = 'X';
+        ReplayFile f;
+        CU_ASSERT(-1 == f.load(bytes(bad), bad.size(), 2));
+    }
+    {
+        std::string bad = "SLRP";
+        append_uint(bad, REPLAY_VERSION + 1, 4);
+        append_record(bad, 0, 0, "");
+        ReplayFile f;
+        CU_ASSERT(-1 == f.load(bytes(bad), bad.size(), 1));
+    }
+    {
+        std::string bad = "SLRP";
+        append_uint(bad, REPLAY_VERSION, 4);
+        append_record(bad, 10, 0, "");
+        append_record(bad, 9, 0, "");
+        ReplayFile f;
+        CU_ASSERT(-1 == f.load(bytes(bad), bad.size(), 1));
+    }
+    {
+        std::string bad = "SLRP";
+        append_uint(bad, REPLAY_VERSION, 4);
+        ReplayFile f;
+        CU_ASSERT(-1 == f.load(bytes(bad), bad.size(), 1));
+    }
+}
+
+void test_replay_cursor(void) {
+    auto s = make_capture();
+    ReplayFile f;
+    CU_ASSERT(0 == f.load(bytes(s), s.size(), 2));
+
+    {
+        ReplayCursor c;
+        c.init(f, 0, 1);
+        size_t n = 0;
+        for (; !c.done(); c.advance()) {
+            ++n;
+        }
+        CU_ASSERT(4 == n);
+    }
+    {
+        // The second of three workers
+        ReplayCursor c;
+        c.init(f, 1, 3);
+        CU_ASSERT(!c.done());
+        CU_ASSERT(1500 == c.next().time);
+        CU_ASSERT(1 == c.next().tmpl);
+        c.advance();
+        CU_ASSERT(c.done());
+    }
+    {
+        ReplayCursor c;
+        c.init(f, 0, 3);
+        CU_ASSERT(0 == c.next().time);
+        c.advance();
+        CU_ASSERT(!c.done());
+        CU_ASSERT((1ULL << 40) == c.next().time);
+        CU_ASSERT("carol" == std::string(c.next().param,
+                                         c.next().param + c.next().paramlen));
+        c.advance();
+        CU_ASSERT(c.done());
+    }
+    {
+        // More workers than records
+        ReplayCursor c;
+        c.init(f, 5, 8);
+        CU_ASSERT(c.done());
+    }
+}
+
+} // namespace h2load
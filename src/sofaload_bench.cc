@@ -0,0 +1,718 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+// sofaload-bench times the paths sofaload runs for every request and
+// every read, in isolation, so that a change to them can be measured
+// before and after.  Results go to stdout as a table, or with --json
+// as one JSON object per line.
+#include "h2load.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <nghttp2/nghttp2.h>
+
+#include "crc32.h"
+#include "h2load_sofarpc_spec.h"
+#include "memchunk.h"
+#include "sofarpc.h"
+#include "util.h"
+
+extern "C" {
+#include "nghttp2_map.h"
+#include "nghttp2_stream.h"
+}
+
+using namespace h2load;
+using namespace nghttp2;
+
+namespace {
+// Results are folded into |sink| so that the work is not optimized
+// away.
+volatile uint64_t sink;
+
+struct Benchmark {
+    std::string name;
+    // The bytes one iteration processes, or 0 if throughput does not
+    // apply
+    size_t bytes;
+    // Runs the given number of iterations
+    std::function<void(size_t)> run;
+};
+} // namespace
+
+namespace {
+void add_memchunks(std::vector<Benchmark> &benches) {
+    // A Bolt response header, a typical response, the read buffer and
+    // a large body.
+    for (size_t len : {20, 3000, 16384, 65536}) {
+        benches.push_back(
+            {"memchunks/append_remove/" + util::utos(len), len,
+             [len](size_t n) {
+                 MemchunkPool pool;
+                 DefaultMemchunks chunks(&pool);
+                 std::vector<uint8_t> src(len, 'x'), dst(len);
+                 for (size_t i = 0; i < n; ++i) {
+                     chunks.append(src.data(), len);
+                     sink += chunks.remove(dst.data(), len);
+                 }
+             }});
+    }
+
+    // The write buffer of a connection with requests queued: headers
+    // and bodies appended in turn, spanning several chunks.
+    for (size_t nreqs : {4, 64}) {
+        benches.push_back(
+            {"memchunks/riovec/" + util::utos(nreqs), 0, [nreqs](size_t n) {
+                 MemchunkPool pool;
+                 DefaultMemchunks chunks(&pool);
+                 std::vector<uint8_t> hd(REQUEST_HEADER_LEN_V1, 'h'),
+                     body(1000, 'b');
+                 for (size_t i = 0; i < nreqs; ++i) {
+                     chunks.append(hd.data(), hd.size());
+                     chunks.append(body.data(), body.size());
+                 }
+                 std::array<struct iovec, 16> iov;
+                 for (size_t i = 0; i < n; ++i) {
+                     sink += chunks.riovec(iov.data(), iov.size());
+                 }
+             }});
+    }
+}
+} // namespace
+
+namespace {
+void add_util(std::vector<Benchmark> &benches) {
+    benches.push_back({"util/getBigEndianI32/1024", 4096, [](size_t n) {
+                           std::vector<char> buf(4096 + 3);
+                           for (size_t i = 0; i < buf.size(); ++i) {
+                               buf[i] = static_cast<char>(i * 131);
+                           }
+                           for (size_t i = 0; i < n; ++i) {
+                               uint64_t sum = 0;
+                               for (size_t j = 0; j < 4096; j += 4) {
+                                   sum += util::getBigEndianI32(&buf[j]);
+                               }
+                               sink += sum;
+                           }
+                       }});
+
+    for (size_t len : {22, 3000, 65536}) {
+        benches.push_back({"crc32/" + util::utos(len), len, [len](size_t n) {
+                               std::vector<uint8_t> buf(len, 'c');
+                               for (size_t i = 0; i < n; ++i) {
+                                   sink += update_crc32(0, buf.data(), len);
+                               }
+                           }});
+    }
+}
+} // namespace
+
+namespace {
+// Appends a Bolt RPC response with |contentlen| bytes of content to
+// |buf|, with a CRC32 trailer if |version| is 2.
+void append_bolt_response(std::string &buf, int version, int32_t stream_id,
+                          size_t contentlen) {
+    auto first = buf.size();
+    auto put16 = [&buf](uint16_t v) {
+        buf += static_cast<char>(v >> 8);
+        buf += static_cast<char>(v);
+    };
+    auto put32 = [&buf](uint32_t v) {
+        buf += static_cast<char>(v >> 24);
+        buf += static_cast<char>(v >> 16);
+        buf += static_cast<char>(v >> 8);
+        buf += static_cast<char>(v);
+    };
+
+    buf += static_cast<char>(version == 2 ? PROTOCOL_CODE_V2 : PROTOCOL_CODE_V1);
+    if (version == 2) {
+        buf += PROTOCOL_VERSION_1;
+    }
+    buf += RESPONSE;
+    put16(RPC_RESPONSE);
+    buf += PROTOCOL_VERSION_1;
+    put32(stream_id);
+    buf += HESSIAN2_SERIALIZE;
+    if (version == 2) {
+        buf += PROTOCOL_SWITCH_CRC;
+    }
+    put16(RESPONSE_STATUS_SUCCESS);
+    put16(0);
+    put16(0);
+    put32(contentlen);
+    buf.append(contentlen, 'x');
+    if (version == 2) {
+        put32(update_crc32(
+            0, reinterpret_cast<const uint8_t *>(buf.data()) + first,
+            buf.size() - first));
+    }
+}
+
+// Handles the complete Bolt responses at the start of [|first|,
+// |last|) in one pass, the way SofaRpcSession::read_frames() does, and
+// counts them in |nresp|.  Returns where it stopped.
+template <int Version>
+const uint8_t *decode_bolt_frames(const uint8_t *first, const uint8_t *last,
+                                  size_t &nresp) {
+    constexpr auto l = bolt_response_layout(Version);
+    while (static_cast<size_t>(last - first) >= l.len) {
+        BoltResponseHeader hd;
+        sink += parse_bolt_response_header<Version>(hd, first);
+        auto bodylen =
+            static_cast<size_t>(hd.classlen) + hd.headerlen + hd.contentlen;
+        size_t crclen = (hd.switches & PROTOCOL_SWITCH_CRC) ? CRC32_LEN : 0;
+        if (static_cast<size_t>(last - first) < l.len + bodylen + crclen) {
+            break;
+        }
+        if (crclen && bolt_load32(first + l.len + bodylen) !=
+                          update_crc32(0, first, l.len + bodylen)) {
+            std::cerr << "CRC32 mismatch" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        first += l.len + bodylen + crclen;
+        ++nresp;
+    }
+    return first;
+}
+
+// Decodes the Bolt responses in |data| handed over |seglen| bytes at a
+// time, the way SofaRpcSession::on_read() does: the responses complete
+// in a read are handled in one pass, and of the rest, the header is
+// decoded in place unless it straddles two reads, the body is
+// skipped, and the CRC32 trailer of V2 responses is checked.  Returns
+// the number of responses.
+size_t decode_bolt(const std::string &data, int version, size_t seglen) {
+    auto hdlen = static_cast<size_t>(bolt_response_header_len(version));
+    std::array<uint8_t, RESPONSE_HEADER_LEN_V2> header_buf;
+    std::array<uint8_t, CRC32_LEN> crc_buf;
+    size_t header_buflen = 0, discard = 0, crc_left = 0, nresp = 0;
+    uint32_t crc = 0;
+
+    auto p = reinterpret_cast<const uint8_t *>(data.data());
+    auto end = p + data.size();
+    for (; p != end;) {
+        auto first = p;
+        auto last = std::min(end, p + seglen);
+        p = last;
+        for (;;) {
+            if (discard != 0) {
+                auto n = std::min(discard, static_cast<size_t>(last - first));
+                if (crc_left) {
+                    crc = update_crc32(crc, first, n);
+                }
+                first += n;
+                discard -= n;
+                if (discard != 0) {
+                    break;
+                }
+                if (crc_left == 0) {
+                    ++nresp;
+                }
+            }
+            if (crc_left != 0) {
+                auto n = std::min(crc_left, static_cast<size_t>(last - first));
+                std::copy_n(first, n, std::end(crc_buf) - crc_left);
+                first += n;
+                crc_left -= n;
+                if (crc_left != 0) {
+                    break;
+                }
+                if (static_cast<uint32_t>(util::getBigEndianI32(
+                        reinterpret_cast<const char *>(crc_buf.data()))) !=
+                    crc) {
+                    std::cerr << "CRC32 mismatch" << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                ++nresp;
+            }
+            if (first == last) {
+                break;
+            }
+
+            if (header_buflen == 0) {
+                first = version == 2
+                            ? decode_bolt_frames<2>(first, last, nresp)
+                            : decode_bolt_frames<1>(first, last, nresp);
+                if (first == last) {
+                    break;
+                }
+            }
+
+            const uint8_t *hd;
+            if (header_buflen == 0 &&
+                static_cast<size_t>(last - first) >= hdlen) {
+                hd = first;
+                first += hdlen;
+            } else {
+                auto n = std::min(hdlen - header_buflen,
+                                  static_cast<size_t>(last - first));
+                std::copy_n(first, n, std::begin(header_buf) + header_buflen);
+                first += n;
+                header_buflen += n;
+                if (header_buflen < hdlen) {
+                    break;
+                }
+                header_buflen = 0;
+                hd = header_buf.data();
+            }
+
+            BoltResponseHeader bh;
+            sink += version == 2 ? parse_bolt_response_header<2>(bh, hd)
+                                 : parse_bolt_response_header<1>(bh, hd);
+            discard = static_cast<size_t>(bh.classlen) + bh.headerlen +
+                      bh.contentlen;
+            if (bh.switches & PROTOCOL_SWITCH_CRC) {
+                crc_left = CRC32_LEN;
+                crc = update_crc32(0, hd, hdlen);
+            }
+            if (discard == 0 && crc_left == 0) {
+                ++nresp;
+            }
+        }
+    }
+    return nresp;
+}
+
+void add_bolt(std::vector<Benchmark> &benches) {
+    // Segments of a TCP MSS, of the read buffer, and the whole batch
+    // at once.  Bodies of a tiny one, such as an error or an echo, a
+    // small, a typical and a large response.
+    for (int version : {1, 2}) {
+        for (size_t contentlen : {16, 128, 3000, 65536}) {
+            for (size_t seglen : {1460, 16384, 0}) {
+                auto data = std::make_shared<std::string>();
+                size_t nresp = 0;
+                for (int32_t id = 1; data->size() < 256_k; ++id, ++nresp) {
+                    append_bolt_response(*data, version, id, contentlen);
+                }
+                auto seg = seglen ? seglen : data->size();
+                benches.push_back(
+                    {"bolt/decode/v" + util::utos(version) + "/" +
+                         util::utos(contentlen) + "/" +
+                         (seglen ? util::utos(seglen) : "all"),
+                     data->size(),
+                     [data, version, seg, nresp](size_t n) {
+                         for (size_t i = 0; i < n; ++i) {
+                             if (decode_bolt(*data, version, seg) != nresp) {
+                                 std::cerr << "Bolt responses lost"
+                                           << std::endl;
+                                 exit(EXIT_FAILURE);
+                             }
+                         }
+                     }});
+            }
+        }
+    }
+
+    // The header map of a server stream response, which --stream-end-
+    // header looks up; the key sought is the last entry.
+    auto hdmap = std::make_shared<std::string>();
+    for (auto &kv : std::vector<std::pair<std::string, std::string>>{
+             {"service", "com.alipay.test.TestService:1.0"},
+             {"sofa_head_method_name", "echo"},
+             {"rpc_trace_context.sofaTraceId", "0a0fe8a01583399318813100136"},
+             {"rpc_trace_context.sofaRpcId", "0"},
+             {"rpc_trace_context.sofaCallerApp", "sofaload"},
+             {"stream-end", "1"}}) {
+        for (auto &s : {kv.first, kv.second}) {
+            uint32_t len = s.size();
+            for (int shift = 24; shift >= 0; shift -= 8) {
+                *hdmap += static_cast<char>(len >> shift);
+            }
+            *hdmap += s;
+        }
+    }
+    benches.push_back(
+        {"bolt/header_map_has", hdmap->size(), [hdmap](size_t n) {
+             const std::string key = "stream-end";
+             for (size_t i = 0; i < n; ++i) {
+                 sink += bolt_header_map_has(
+                     reinterpret_cast<const uint8_t *>(hdmap->data()),
+                     hdmap->size(), key);
+             }
+         }});
+}
+} // namespace
+
+namespace {
+void add_stream_table(std::vector<Benchmark> &benches) {
+    // A window of |inflight| requests sliding along the stream IDs:
+    // each iteration answers and closes the oldest stream, and opens a
+    // new one.
+    for (size_t inflight : {1, 16, 256}) {
+        benches.push_back(
+            {"stream_table/" + util::utos(inflight), 0, [inflight](size_t n) {
+                 BlockAllocator balloc(1_k, 1_k);
+                 StreamTable streams;
+                 streams.init(inflight * 2, balloc);
+                 int32_t next = 1, oldest = 1;
+                 for (size_t i = 0; i < inflight; ++i, next += 2) {
+                     streams.emplace(next);
+                 }
+                 for (size_t i = 0; i < n; ++i) {
+                     sink += streams.find(oldest)->status_success;
+                     streams.erase(oldest);
+                     streams.emplace(next);
+                     next += 2;
+                     oldest += 2;
+                     if (next > (1 << 30)) {
+                         streams.clear();
+                         next = oldest = 1;
+                         for (size_t j = 0; j < inflight; ++j, next += 2) {
+                             streams.emplace(next);
+                         }
+                     }
+                 }
+             }});
+    }
+}
+} // namespace
+
+namespace {
+void add_nghttp2_map(std::vector<Benchmark> &benches) {
+    // The streams of an HTTP/2 session, keyed by their odd, ascending
+    // IDs.  The entries are kept in objects as large as nghttp2_stream,
+    // so that looking into them costs what it does in a session.
+    using Stream = std::array<uint8_t, sizeof(nghttp2_stream)>;
+    auto entry_of = [](Stream &stream) {
+        return reinterpret_cast<nghttp2_map_entry *>(stream.data());
+    };
+    for (size_t inflight : {100, 1000, 10000}) {
+        // A frame received for any stream in flight, in random order
+        benches.push_back(
+            {"nghttp2_map/find/" + util::utos(inflight), 0,
+             [inflight, entry_of](size_t n) {
+                 nghttp2_map map;
+                 nghttp2_map_init(&map, nghttp2_mem_default());
+                 std::vector<Stream> streams(inflight);
+                 std::vector<int32_t> keys(inflight);
+                 for (size_t i = 0; i < inflight; ++i) {
+                     keys[i] = i * 2 + 1;
+                     nghttp2_map_entry_init(entry_of(streams[i]), keys[i]);
+                     nghttp2_map_insert(&map, entry_of(streams[i]));
+                 }
+                 std::shuffle(std::begin(keys), std::end(keys),
+                              std::mt19937(inflight));
+                 for (size_t i = 0, j = 0; i < n; ++i) {
+                     sink += nghttp2_map_find(&map, keys[j])->key;
+                     if (++j == inflight) {
+                         j = 0;
+                     }
+                 }
+                 nghttp2_map_free(&map);
+             }});
+
+        // As stream_table: the oldest stream closes, and a new one
+        // takes its entry.
+        benches.push_back(
+            {"nghttp2_map/insert_remove/" + util::utos(inflight), 0,
+             [inflight, entry_of](size_t n) {
+                 nghttp2_map map;
+                 std::vector<Stream> streams(inflight);
+                 int32_t next, oldest;
+                 auto start = [&]() {
+                     nghttp2_map_init(&map, nghttp2_mem_default());
+                     next = oldest = 1;
+                     for (auto &stream : streams) {
+                         nghttp2_map_entry_init(entry_of(stream), next);
+                         nghttp2_map_insert(&map, entry_of(stream));
+                         next += 2;
+                     }
+                 };
+                 start();
+                 for (size_t i = 0, j = 0; i < n; ++i) {
+                     if (next > (1 << 30)) {
+                         // Starts over, as a new connection would.
+                         nghttp2_map_free(&map);
+                         start();
+                         j = 0;
+                     }
+                     sink += nghttp2_map_remove(&map, oldest);
+                     nghttp2_map_entry_init(entry_of(streams[j]), next);
+                     sink += nghttp2_map_insert(&map, entry_of(streams[j]));
+                     next += 2;
+                     oldest += 2;
+                     if (++j == inflight) {
+                         j = 0;
+                     }
+                 }
+                 nghttp2_map_free(&map);
+             }});
+    }
+}
+} // namespace
+
+namespace {
+nghttp2_nv make_nv(const std::string &name, const std::string &value) {
+    return {(uint8_t *)name.c_str(), (uint8_t *)value.c_str(), name.size(),
+            value.size(), NGHTTP2_NV_FLAG_NONE};
+}
+
+void add_hpack(std::vector<Benchmark> &benches) {
+    // The headers of a request as sofaload sends it, and of a typical
+    // response.
+    static const std::vector<std::pair<std::string, std::string>> request{
+        {":method", "GET"},
+        {":scheme", "https"},
+        {":authority", "backend.example.com:8443"},
+        {":path", "/api/v1/items?id=1024"},
+        {"user-agent", "sofaload"},
+        {"accept", "*/*"},
+        {"accept-encoding", "gzip, deflate"}};
+    static const std::vector<std::pair<std::string, std::string>> response{
+        {":status", "200"},
+        {"content-type", "application/json"},
+        {"content-length", "3000"},
+        {"date", "Thu, 15 Oct 2026 00:00:00 GMT"},
+        {"server", "nginx"},
+        {"cache-control", "no-cache"}};
+
+    for (auto hdrs : {&request, &response}) {
+        auto kind = std::string(hdrs == &request ? "request" : "response");
+        std::vector<nghttp2_nv> nva;
+        for (auto &kv : *hdrs) {
+            nva.push_back(make_nv(kv.first, kv.second));
+        }
+
+        benches.push_back(
+            {"hpack/deflate/" + kind, 0, [nva](size_t n) {
+                 nghttp2_hd_deflater *deflater;
+                 nghttp2_hd_deflate_new(&deflater, 4096);
+                 std::vector<uint8_t> buf(
+                     nghttp2_hd_deflate_bound(deflater, nva.data(), nva.size()));
+                 for (size_t i = 0; i < n; ++i) {
+                     sink += nghttp2_hd_deflate_hd(deflater, buf.data(),
+                                                   buf.size(), nva.data(),
+                                                   nva.size());
+                 }
+                 nghttp2_hd_deflate_del(deflater);
+             }});
+
+        // After the first block has filled the dynamic table, the same
+        // headers encode to the same block, which only refers to the
+        // table, so it can be decoded over and over.
+        benches.push_back(
+            {"hpack/inflate/" + kind, 0, [nva](size_t n) {
+                 nghttp2_hd_deflater *deflater;
+                 nghttp2_hd_inflater *inflater;
+                 nghttp2_hd_deflate_new(&deflater, 4096);
+                 nghttp2_hd_inflate_new(&inflater);
+                 std::vector<uint8_t> buf(
+                     nghttp2_hd_deflate_bound(deflater, nva.data(), nva.size()));
+
+                 auto inflate = [inflater](const uint8_t *in, size_t inlen) {
+                     for (;;) {
+                         nghttp2_nv nv;
+                         int inflate_flags = 0;
+                         auto rv = nghttp2_hd_inflate_hd2(
+                             inflater, &nv, &inflate_flags, in, inlen, 1);
+                         if (rv < 0) {
+                             std::cerr << "HPACK inflate failed" << std::endl;
+                             exit(EXIT_FAILURE);
+                         }
+                         in += rv;
+                         inlen -= rv;
+                         if (inflate_flags & NGHTTP2_HD_INFLATE_EMIT) {
+                             sink += nv.valuelen;
+                         }
+                         if (inflate_flags & NGHTTP2_HD_INFLATE_FINAL) {
+                             nghttp2_hd_inflate_end_headers(inflater);
+                             break;
+                         }
+                         if (inlen == 0) {
+                             break;
+                         }
+                     }
+                 };
+
+                 auto len = nghttp2_hd_deflate_hd(deflater, buf.data(),
+                                                  buf.size(), nva.data(),
+                                                  nva.size());
+                 inflate(buf.data(), len);
+                 len = nghttp2_hd_deflate_hd(deflater, buf.data(), buf.size(),
+                                             nva.data(), nva.size());
+                 for (size_t i = 0; i < n; ++i) {
+                     inflate(buf.data(), len);
+                 }
+                 nghttp2_hd_inflate_del(inflater);
+                 nghttp2_hd_deflate_del(deflater);
+             }});
+    }
+}
+} // namespace
+
+namespace {
+// Returns the seconds |n| iterations of |bench| take.
+double time_run(const Benchmark &bench, size_t n) {
+    auto start = std::chrono::steady_clock::now();
+    bench.run(n);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start)
+        .count();
+}
+
+struct Result {
+    size_t iterations;
+    // The median and the fastest of the repetitions, in nanoseconds
+    // per iteration
+    double ns_median;
+    double ns_min;
+};
+
+// Finds the iterations which take at least |min_time| seconds, and
+// times them |repetitions| times.
+Result measure(const Benchmark &bench, double min_time, size_t repetitions) {
+    size_t n = 1;
+    for (;;) {
+        auto t = time_run(bench, n);
+        if (t >= min_time) {
+            break;
+        }
+        // Aim a little past |min_time|, but grow at most 10 times, in
+        // case the short runs were dominated by setup.
+        auto grow = t > 0 ? min_time * 1.4 / t : 10.;
+        n = std::max(n + 1, static_cast<size_t>(n * std::min(grow, 10.)));
+    }
+
+    std::vector<double> ns;
+    for (size_t i = 0; i < repetitions; ++i) {
+        ns.push_back(time_run(bench, n) * 1e9 / n);
+    }
+    std::sort(std::begin(ns), std::end(ns));
+    return {n, ns[ns.size() / 2], ns[0]};
+}
+} // namespace
+
+namespace {
+void print_help(std::ostream &out) {
+    out << R"(Usage: sofaload-bench [OPTIONS]...
+Times the hot paths of sofaload in isolation: buffer management, Bolt
+response decoding, CRC32, the stream table and HPACK.
+Options:
+  --filter=<S>
+              Run only the benchmarks whose name contains <S>.
+  --min-time=<T>
+              The seconds each repetition runs for at least.
+              Default: 0.2
+  --repetitions=<N>
+              The number of times each benchmark is timed.  The
+              median is reported along with the fastest.
+              Default: 5
+  --json      Write one JSON object per benchmark, one per line,
+              instead of a table.
+  -h, --help  Display this help and exit.)"
+        << std::endl;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    std::string filter;
+    double min_time = 0.2;
+    size_t repetitions = 5;
+    bool json = false;
+
+    for (int i = 1; i < argc; ++i) {
+        auto arg = std::string(argv[i]);
+        if (arg == "-h" || arg == "--help") {
+            print_help(std::cout);
+            return EXIT_SUCCESS;
+        }
+        if (arg == "--json") {
+            json = true;
+        } else if (util::istarts_with_l(arg, "--filter=")) {
+            filter = arg.substr(str_size("--filter="));
+        } else if (util::istarts_with_l(arg, "--min-time=")) {
+            min_time = strtod(arg.c_str() + str_size("--min-time="), nullptr);
+            if (!(min_time > 0)) {
+                std::cerr << "--min-time: must be positive" << std::endl;
+                return EXIT_FAILURE;
+            }
+        } else if (util::istarts_with_l(arg, "--repetitions=")) {
+            auto n = util::parse_uint(arg.substr(str_size("--repetitions=")));
+            if (n < 1) {
+                std::cerr << "--repetitions: must be positive" << std::endl;
+                return EXIT_FAILURE;
+            }
+            repetitions = n;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            print_help(std::cerr);
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<Benchmark> benches;
+    add_memchunks(benches);
+    add_util(benches);
+    add_bolt(benches);
+    add_stream_table(benches);
+    add_nghttp2_map(benches);
+    add_hpack(benches);
+
+    if (!json) {
+        std::cout << std::left << std::setw(36) << "benchmark" << std::right
+                  << std::setw(12) << "iterations" << std::setw(14)
+                  << "ns/iter" << std::setw(14) << "min ns/iter"
+                  << std::setw(12) << "MB/s" << std::endl;
+    }
+
+    for (auto &bench : benches) {
+        if (bench.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        auto res = measure(bench, min_time, repetitions);
+        auto mbps = bench.bytes ? bench.bytes * 1e3 / res.ns_median : 0.;
+        if (json) {
+            std::cout << "{\"name\":\"" << bench.name
+                      << "\",\"iterations\":" << res.iterations
+                      << ",\"ns_per_iter\":" << res.ns_median
+                      << ",\"ns_per_iter_min\":" << res.ns_min
+                      << ",\"bytes_per_iter\":" << bench.bytes
+                      << ",\"mb_per_s\":" << mbps << "}" << std::endl;
+            continue;
+        }
+        std::cout << std::left << std::setw(36) << bench.name << std::right
+                  << std::setw(12) << res.iterations << std::fixed
+                  << std::setprecision(1) << std::setw(14) << res.ns_median
+                  << std::setw(14) << res.ns_min << std::setw(12);
+        if (bench.bytes) {
+            std::cout << mbps;
+        } else {
+            std::cout << "-";
+        }
+        std::cout << std::defaultfloat << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
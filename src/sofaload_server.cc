@@ -0,0 +1,669 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+// sofaload-server answers Bolt requests as fast as it can, so that the
+// ceiling of sofaload itself can be measured against it.  Each thread
+// runs its own event loop and listening socket, bound to the same
+// port with SO_REUSEPORT, so that the kernel spreads connections over
+// them.
+#include "nghttp2_config.h"
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <unistd.h>
+#include <getopt.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <ev.h>
+
+#include "crc32.h"
+#include "sofarpc.h"
+#include "template.h"
+#include "util.h"
+
+using namespace h2load;
+using namespace nghttp2;
+
+namespace {
+// The distribution of the latency injected before each response
+struct Latency {
+    enum { NONE, FIXED, UNIFORM, EXPONENTIAL } type;
+    // FIXED: the latency.  UNIFORM: the bounds.  EXPONENTIAL: the
+    // mean.  In seconds.
+    double a, b;
+
+    double sample(std::mt19937 &gen) const {
+        switch (type) {
+        case FIXED:
+            return a;
+        case UNIFORM:
+            return std::uniform_real_distribution<double>(a, b)(gen);
+        case EXPONENTIAL:
+            return std::exponential_distribution<double>(1. / a)(gen);
+        default:
+            return 0.;
+        }
+    }
+};
+
+struct ServerConfig {
+    ServerConfig()
+        : address("127.0.0.1"), port(12200), nthreads(1), response_size(-1),
+          latency{Latency::NONE, 0., 0.} {}
+    std::string address;
+    uint16_t port;
+    size_t nthreads;
+    // The content length of responses, or -1 to echo the request
+    // content
+    int64_t response_size;
+    Latency latency;
+};
+
+ServerConfig config;
+} // namespace
+
+namespace {
+// Reading stops while this many bytes of responses are waiting for
+// the socket.
+constexpr size_t WRITE_BUFFER_THRES = 1_m;
+
+struct Worker;
+
+struct Conn {
+    Conn(Worker *worker, int fd);
+    ~Conn();
+
+    Worker *worker;
+    int fd;
+    ev_io rev, wev;
+    // Bytes read which do not make a whole request yet
+    std::string rbuf;
+    // Responses yet to be written, from |woff|
+    std::string wbuf;
+    size_t woff;
+};
+
+// A response held back by --latency until |due|
+struct Delayed {
+    ev_tstamp due;
+    std::weak_ptr<Conn> conn;
+    std::string resp;
+
+    bool operator>(const Delayed &other) const { return due > other.due; }
+};
+
+struct Worker {
+    Worker() : loop(ev_loop_new(0)), fd(-1), gen(std::random_device()()) {}
+    ~Worker() { ev_loop_destroy(loop); }
+
+    struct ev_loop *loop;
+    int fd;
+    ev_io accept_watcher;
+    ev_timer delay_watcher;
+    std::unordered_map<Conn *, std::shared_ptr<Conn>> conns;
+    std::priority_queue<Delayed, std::vector<Delayed>, std::greater<Delayed>>
+        delayed;
+    std::mt19937 gen;
+};
+
+void readcb(struct ev_loop *loop, ev_io *w, int revents);
+void writecb(struct ev_loop *loop, ev_io *w, int revents);
+
+Conn::Conn(Worker *worker, int fd) : worker(worker), fd(fd), woff(0) {
+    ev_io_init(&rev, readcb, fd, EV_READ);
+    ev_io_init(&wev, writecb, fd, EV_WRITE);
+    rev.data = wev.data = this;
+    ev_io_start(worker->loop, &rev);
+}
+
+Conn::~Conn() {
+    ev_io_stop(worker->loop, &rev);
+    ev_io_stop(worker->loop, &wev);
+    close(fd);
+}
+
+void close_conn(Conn *conn) { conn->worker->conns.erase(conn); }
+} // namespace
+
+namespace {
+// Writes out |conn|->wbuf as far as the socket takes it.  Returns 0
+// if it succeeds, or -1 if the connection must be closed.
+int flush(Conn *conn) {
+    auto loop = conn->worker->loop;
+    while (conn->woff < conn->wbuf.size()) {
+        ssize_t nwrite;
+        while ((nwrite = send(conn->fd, conn->wbuf.data() + conn->woff,
+                              conn->wbuf.size() - conn->woff, MSG_NOSIGNAL)) ==
+                   -1 &&
+               errno == EINTR)
+            ;
+        if (nwrite == -1) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            return -1;
+        }
+        conn->woff += nwrite;
+    }
+
+    if (conn->woff == conn->wbuf.size()) {
+        conn->wbuf.clear();
+        conn->woff = 0;
+        ev_io_stop(loop, &conn->wev);
+    } else {
+        ev_io_start(loop, &conn->wev);
+    }
+
+    if (conn->wbuf.size() - conn->woff < WRITE_BUFFER_THRES) {
+        ev_io_start(loop, &conn->rev);
+    } else {
+        ev_io_stop(loop, &conn->rev);
+    }
+
+    return 0;
+}
+} // namespace
+
+namespace {
+// Appends the response to the Bolt request of |version| with header
+// |hd| to |out|.  |content| is echoed unless --response-size is
+// given.
+void make_response(std::string &out, int version, const uint8_t *hd,
+                   const uint8_t *content, size_t contentlen) {
+    auto bytes = reinterpret_cast<const char *>(hd);
+    auto switches = version == 2 ? bytes[11] & PROTOCOL_SWITCH_CRC : 0;
+    auto off = version == 2 ? 1 : 0;
+    auto cmdcode = util::getBigEndianI16(&bytes[2 + off]);
+    auto heartbeat = cmdcode == HEARTBEAT;
+
+    if (heartbeat) {
+        contentlen = 0;
+    } else if (config.response_size != -1) {
+        contentlen = config.response_size;
+        content = nullptr;
+    }
+
+    auto hdlen = static_cast<size_t>(bolt_response_header_len(version));
+    auto first = out.size();
+    out.resize(first + hdlen);
+    auto p = &out[first];
+    *p++ = version == 2 ? PROTOCOL_CODE_V2 : PROTOCOL_CODE_V1;
+    if (version == 2) {
+        *p++ = PROTOCOL_VERSION_1;
+    }
+    *p++ = RESPONSE;
+    util::putBigEndianI16(p, heartbeat ? HEARTBEAT : RPC_RESPONSE);
+    p += 2;
+    *p++ = bytes[4 + off];
+    // request ID and codec
+    std::copy_n(bytes + 5 + off, 5, p);
+    p += 5;
+    if (version == 2) {
+        *p++ = switches;
+    }
+    util::putBigEndianI16(p, RESPONSE_STATUS_SUCCESS);
+    p += 2;
+    util::putBigEndianI16(p, 0);
+    p += 2;
+    util::putBigEndianI16(p, 0);
+    p += 2;
+    util::putBigEndianI32(p, contentlen);
+
+    if (content) {
+        out.append(reinterpret_cast<const char *>(content), contentlen);
+    } else {
+        out.append(contentlen, 'x');
+    }
+
+    if (switches) {
+        auto crc = update_crc32(
+            0, reinterpret_cast<const uint8_t *>(out.data()) + first,
+            out.size() - first);
+        out.resize(out.size() + CRC32_LEN);
+        util::putBigEndianI32(&out[out.size() - CRC32_LEN], crc);
+    }
+}
+} // namespace
+
+namespace {
+void delaycb(struct ev_loop *loop, ev_timer *w, int revents);
+
+// Holds |resp| back for the connection |conn| until |delay| seconds
+// from now.
+void delay_response(const std::shared_ptr<Conn> &conn, std::string resp,
+                    double delay) {
+    auto worker = conn->worker;
+    auto due = ev_now(worker->loop) + delay;
+    auto earliest = worker->delayed.empty() || due < worker->delayed.top().due;
+    worker->delayed.push(Delayed{due, conn, std::move(resp)});
+    if (earliest) {
+        ev_timer_stop(worker->loop, &worker->delay_watcher);
+        ev_timer_set(&worker->delay_watcher, delay, 0.);
+        ev_timer_start(worker->loop, &worker->delay_watcher);
+    }
+}
+
+void delaycb(struct ev_loop *loop, ev_timer *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    auto now = ev_now(loop);
+    std::vector<Conn *> flushed;
+    while (!worker->delayed.empty() && worker->delayed.top().due <= now) {
+        auto &d = worker->delayed.top();
+        if (auto conn = d.conn.lock()) {
+            if (conn->wbuf.empty()) {
+                flushed.push_back(conn.get());
+            }
+            conn->wbuf += d.resp;
+        }
+        worker->delayed.pop();
+    }
+    for (auto conn : flushed) {
+        if (worker->conns.count(conn) && flush(conn) != 0) {
+            close_conn(conn);
+        }
+    }
+    if (!worker->delayed.empty()) {
+        ev_timer_set(w, worker->delayed.top().due - now, 0.);
+        ev_timer_start(loop, w);
+    }
+}
+} // namespace
+
+namespace {
+// Answers the whole requests in |conn|->rbuf.  Returns 0 if it
+// succeeds, or -1 if the connection must be closed.
+int process_requests(const std::shared_ptr<Conn> &conn) {
+    auto &rbuf = conn->rbuf;
+    auto data = reinterpret_cast<const uint8_t *>(rbuf.data());
+    size_t pos = 0;
+    std::string resp;
+
+    while (pos < rbuf.size()) {
+        auto hd = data + pos;
+        auto left = rbuf.size() - pos;
+        int version;
+        switch (hd[0]) {
+        case PROTOCOL_CODE_V1:
+            version = 1;
+            break;
+        case PROTOCOL_CODE_V2:
+            version = 2;
+            break;
+        default:
+            return -1;
+        }
+        auto hdlen = static_cast<size_t>(bolt_request_header_len(version));
+        if (left < hdlen) {
+            break;
+        }
+        auto bytes = reinterpret_cast<const char *>(hd);
+        auto off = version == 2 ? 2 : 0;
+        auto switches = version == 2 ? hd[11] : 0;
+        auto type = hd[version == 2 ? 2 : 1];
+        size_t classlen = util::getBigEndianI16(&bytes[14 + off]);
+        size_t headerlen = util::getBigEndianI16(&bytes[16 + off]);
+        size_t contentlen =
+            static_cast<uint32_t>(util::getBigEndianI32(&bytes[18 + off]));
+        auto len = hdlen + classlen + headerlen + contentlen;
+        if (switches & PROTOCOL_SWITCH_CRC) {
+            len += CRC32_LEN;
+        }
+        if (left < len) {
+            break;
+        }
+        pos += len;
+
+        if (type == REQUEST_ONEWAY) {
+            continue;
+        }
+
+        auto content = hd + hdlen + classlen + headerlen;
+        if (config.latency.type == Latency::NONE) {
+            make_response(conn->wbuf, version, hd, content, contentlen);
+            continue;
+        }
+        auto delay = config.latency.sample(conn->worker->gen);
+        if (delay <= 0.) {
+            make_response(conn->wbuf, version, hd, content, contentlen);
+            continue;
+        }
+        resp.clear();
+        make_response(resp, version, hd, content, contentlen);
+        delay_response(conn, resp, delay);
+    }
+
+    rbuf.erase(0, pos);
+    return 0;
+}
+
+void readcb(struct ev_loop *loop, ev_io *w, int revents) {
+    auto conn = static_cast<Conn *>(w->data);
+    auto worker = conn->worker;
+    // Keeps |conn| alive until this function returns.
+    auto ref = worker->conns[conn];
+
+    std::array<char, 16_k> buf;
+    for (;;) {
+        ssize_t nread;
+        while ((nread = read(conn->fd, buf.data(), buf.size())) == -1 &&
+               errno == EINTR)
+            ;
+        if (nread == -1) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            close_conn(conn);
+            return;
+        }
+        if (nread == 0) {
+            close_conn(conn);
+            return;
+        }
+        conn->rbuf.append(buf.data(), nread);
+        if (process_requests(ref) != 0) {
+            close_conn(conn);
+            return;
+        }
+        if (conn->wbuf.size() - conn->woff >= WRITE_BUFFER_THRES ||
+            static_cast<size_t>(nread) < buf.size()) {
+            break;
+        }
+    }
+
+    if (flush(conn) != 0) {
+        close_conn(conn);
+    }
+}
+
+void writecb(struct ev_loop *loop, ev_io *w, int revents) {
+    auto conn = static_cast<Conn *>(w->data);
+    if (flush(conn) != 0) {
+        close_conn(conn);
+    }
+}
+
+void acceptcb(struct ev_loop *loop, ev_io *w, int revents) {
+    auto worker = static_cast<Worker *>(w->data);
+    for (;;) {
+#ifdef HAVE_ACCEPT4
+        auto fd = accept4(worker->fd, nullptr, nullptr,
+                          SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else  // !HAVE_ACCEPT4
+        auto fd = accept(worker->fd, nullptr, nullptr);
+#endif // !HAVE_ACCEPT4
+        if (fd == -1) {
+            return;
+        }
+#ifndef HAVE_ACCEPT4
+        util::make_socket_nonblocking(fd);
+        util::make_socket_closeonexec(fd);
+#endif // !HAVE_ACCEPT4
+        util::make_socket_nodelay(fd);
+        auto conn = std::make_shared<Conn>(worker, fd);
+        worker->conns.emplace(conn.get(), conn);
+    }
+}
+} // namespace
+
+namespace {
+// Creates the listening socket of |worker|.  Returns 0 if it
+// succeeds, or -1 after printing the error.
+int listen_worker(Worker *worker) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    addrinfo *res;
+    auto service = util::utos(config.port);
+    auto rv = getaddrinfo(config.address.c_str(), service.c_str(), &hints,
+                          &res);
+    if (rv != 0) {
+        std::cerr << config.address << ": " << gai_strerror(rv) << std::endl;
+        return -1;
+    }
+
+    auto fd = util::create_nonblock_socket(res->ai_family);
+    if (fd == -1) {
+        freeaddrinfo(res);
+        std::cerr << "socket: " << strerror(errno) << std::endl;
+        return -1;
+    }
+    int val = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &val, sizeof(val));
+#ifdef SO_REUSEPORT
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &val, sizeof(val)) == -1 &&
+        config.nthreads > 1) {
+        std::cerr << "SO_REUSEPORT: " << strerror(errno) << std::endl;
+        close(fd);
+        freeaddrinfo(res);
+        return -1;
+    }
+#endif // SO_REUSEPORT
+    if (bind(fd, res->ai_addr, res->ai_addrlen) == -1 ||
+        listen(fd, 1024) == -1) {
+        std::cerr << config.address << ":" << config.port << ": "
+                  << strerror(errno) << std::endl;
+        close(fd);
+        freeaddrinfo(res);
+        return -1;
+    }
+    freeaddrinfo(res);
+
+    worker->fd = fd;
+    ev_io_init(&worker->accept_watcher, acceptcb, fd, EV_READ);
+    worker->accept_watcher.data = worker;
+    ev_io_start(worker->loop, &worker->accept_watcher);
+    ev_timer_init(&worker->delay_watcher, delaycb, 0., 0.);
+    worker->delay_watcher.data = worker;
+    return 0;
+}
+} // namespace
+
+namespace {
+// Parses the --latency argument |s| into |latency|.  Returns 0 if it
+// succeeds, or -1.
+int parse_latency(Latency &latency, const std::string &s) {
+    auto duration = [](const std::string &t) {
+        return util::parse_duration_with_unit(t.c_str());
+    };
+    auto colon = s.find(':');
+    if (colon == std::string::npos) {
+        latency = {Latency::FIXED, duration(s), 0.};
+        return std::isinf(latency.a) ? -1 : 0;
+    }
+    auto kind = s.substr(0, colon);
+    auto args = s.substr(colon + 1);
+    if (kind == "uniform") {
+        auto comma = args.find(',');
+        if (comma == std::string::npos) {
+            return -1;
+        }
+        latency = {Latency::UNIFORM, duration(args.substr(0, comma)),
+                   duration(args.substr(comma + 1))};
+        return std::isinf(latency.a) || std::isinf(latency.b) ||
+                       latency.a > latency.b
+                   ? -1
+                   : 0;
+    }
+    if (kind == "exp") {
+        latency = {Latency::EXPONENTIAL, duration(args), 0.};
+        return std::isinf(latency.a) || latency.a <= 0. ? -1 : 0;
+    }
+    return -1;
+}
+} // namespace
+
+namespace {
+void print_help(std::ostream &out) {
+    out << R"(Usage: sofaload-server [OPTIONS]...
+Answers SofaRPC (Bolt V1 and V2) requests with success, as fast as it
+can, to measure the ceiling of sofaload against.  Heartbeats are
+answered, and oneway requests are read and dropped.
+Options:
+  --address=<ADDR>
+              The address to listen on.
+              Default: 127.0.0.1
+  --port=<PORT>
+              The port to listen on.
+              Default: 12200
+  -t, --threads=<N>
+              The number of threads.  Each has its own listening
+              socket bound with SO_REUSEPORT.
+              Default: 1
+  --response-size=<SIZE>
+              The content length of responses.  By default, the
+              request content is echoed.
+  --latency=<SPEC>
+              Holds each response back for a latency drawn from
+              <SPEC> before sending it.  <SPEC> is one of:
+                <T>              the fixed latency <T>
+                uniform:<A>,<B>  uniform between <A> and <B>
+                exp:<MEAN>       exponential with mean <MEAN>
+              Durations take a unit (e.g. 2ms, 1s).
+  -h, --help  Display this help and exit.)"
+        << std::endl;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    for (;;) {
+        static int flag = 0;
+        constexpr static option long_options[] = {
+            {"threads", required_argument, nullptr, 't'},
+            {"help", no_argument, nullptr, 'h'},
+            {"address", required_argument, &flag, 1},
+            {"port", required_argument, &flag, 2},
+            {"response-size", required_argument, &flag, 3},
+            {"latency", required_argument, &flag, 4},
+            {nullptr, 0, nullptr, 0}};
+        int option_index = 0;
+        auto c = getopt_long(argc, argv, "ht:", long_options, &option_index);
+        if (c == -1) {
+            break;
+        }
+        switch (c) {
+        case 't': {
+            auto n = util::parse_uint(optarg);
+            if (n < 1) {
+                std::cerr << "-t: bad value: " << optarg << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            config.nthreads = n;
+            break;
+        }
+        case 'h':
+            print_help(std::cout);
+            exit(EXIT_SUCCESS);
+        case '?':
+            print_help(std::cerr);
+            exit(EXIT_FAILURE);
+        case 0:
+            switch (flag) {
+            case 1:
+                // --address
+                config.address = optarg;
+                break;
+            case 2: {
+                // --port
+                auto n = util::parse_uint(optarg);
+                if (n < 0 || n > 65535) {
+                    std::cerr << "--port: bad value: " << optarg << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.port = n;
+                break;
+            }
+            case 3: {
+                // --response-size
+                auto n = util::parse_uint_with_unit(optarg);
+                if (n < 0 || n > std::numeric_limits<uint32_t>::max()) {
+                    std::cerr << "--response-size: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                config.response_size = n;
+                break;
+            }
+            case 4:
+                // --latency
+                if (parse_latency(config.latency, optarg) != 0) {
+                    std::cerr << "--latency: bad value: " << optarg
+                              << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (optind < argc) {
+        std::cerr << "Unexpected argument: " << argv[optind] << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (size_t i = 0; i < config.nthreads; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+        if (listen_worker(workers.back().get()) != 0) {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    std::cerr << "listening on " << config.address << ":" << config.port
+              << " with " << config.nthreads << " thread(s)" << std::endl;
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < workers.size(); ++i) {
+        auto loop = workers[i]->loop;
+        threads.emplace_back([loop]() { ev_run(loop, 0); });
+    }
+    ev_run(workers[0]->loop, 0);
+
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    return EXIT_SUCCESS;
+}
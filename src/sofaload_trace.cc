@@ -0,0 +1,126 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+// sofaload-trace decodes the files written by sofaload --trace into
+// CSV, one row per request in the order they were sent.
+#include "h2load_trace.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+using namespace h2load;
+
+namespace {
+struct Row {
+    uint32_t worker_id;
+    TraceRecord rec;
+};
+} // namespace
+
+namespace {
+// Appends the records in |path| to |rows| in the order they were
+// written.  Returns 0 if it succeeds, or -1.
+int read_trace(std::vector<Row> &rows, const char *path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << path << ": could not open" << std::endl;
+        return -1;
+    }
+
+    TraceHeader hdr;
+    if (!in.read(reinterpret_cast<char *>(&hdr), sizeof(hdr)) ||
+        memcmp(hdr.magic, TRACE_MAGIC, sizeof(hdr.magic)) != 0) {
+        std::cerr << path << ": not a sofaload trace" << std::endl;
+        return -1;
+    }
+    if (hdr.version != TRACE_VERSION || hdr.record_size != sizeof(TraceRecord)) {
+        std::cerr << path << ": unsupported version " << hdr.version
+                  << std::endl;
+        return -1;
+    }
+
+    std::vector<TraceRecord> ring(hdr.capacity);
+    if (!in.read(reinterpret_cast<char *>(ring.data()),
+                 ring.size() * sizeof(TraceRecord))) {
+        std::cerr << path << ": truncated" << std::endl;
+        return -1;
+    }
+
+    // If the ring wrapped, the oldest record is the one which would
+    // have been written next.
+    auto n = std::min(hdr.nwritten, hdr.capacity);
+    auto first = hdr.nwritten > hdr.capacity ? hdr.nwritten % hdr.capacity : 0;
+    for (uint64_t i = 0; i < n; ++i) {
+        rows.push_back(Row{hdr.worker_id, ring[(first + i) % hdr.capacity]});
+    }
+    if (hdr.nwritten > hdr.capacity) {
+        std::cerr << path << ": " << hdr.nwritten - hdr.capacity
+                  << " oldest records were overwritten" << std::endl;
+    }
+
+    return 0;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 2 || strcmp(argv[1], "-h") == 0 ||
+        strcmp(argv[1], "--help") == 0) {
+        std::cerr << "Usage: " << argv[0] << " FILE..." << R"(
+Decodes the files written by sofaload --trace, and writes the requests
+in them as CSV to stdout in the order they were sent.  Times are in
+nanoseconds, send_time and close_time since the epoch.  status is -1
+if no response arrived.)" << std::endl;
+        return argc < 2 ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    std::vector<Row> rows;
+    for (int i = 1; i < argc; ++i) {
+        if (read_trace(rows, argv[i]) != 0) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::stable_sort(std::begin(rows), std::end(rows),
+                     [](const Row &a, const Row &b) {
+                         return a.rec.send_time < b.rec.send_time;
+                     });
+
+    std::cout << "worker,conn,stream,send_time,close_time,rtt,send_delay,"
+                 "status,completed,status_success\n";
+    for (auto &row : rows) {
+        auto &r = row.rec;
+        std::cout << row.worker_id << ',' << r.conn_id << ',' << r.stream_id
+                  << ',' << r.send_time << ','
+                  << r.send_time + static_cast<int64_t>(r.rtt) << ',' << r.rtt
+                  << ',' << r.send_delay << ',' << r.status << ','
+                  << ((r.flags & TRACE_FLAG_COMPLETED) != 0) << ','
+                  << ((r.flags & TRACE_FLAG_STATUS_SUCCESS) != 0) << '\n';
+    }
+
+    return EXIT_SUCCESS;
+}
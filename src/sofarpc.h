@@ -25,6 +25,9 @@
 #ifndef SOFARPC_H
 #define SOFARPC_H
 
+#include <cstddef>
+#include <cstdint>
+
 namespace h2load {
 
 // ~~ constans
@@ -43,6 +46,19 @@ const int RESPONSE_HEADER_LEN_V2 = 22;
 const int LESS_LEN_V1 = RESPONSE_HEADER_LEN_V1; // minimal length for decoding
 const int LESS_LEN_V2 = RESPONSE_HEADER_LEN_V2;
 
+// V2 protocol switch bits
+const char PROTOCOL_SWITCH_CRC = 0x01; // CRC32 of the frame follows it
+
+const int CRC32_LEN = 4;
+
+inline int bolt_request_header_len(int version) {
+    return version == 2 ? REQUEST_HEADER_LEN_V2 : REQUEST_HEADER_LEN_V1;
+}
+
+inline int bolt_response_header_len(int version) {
+    return version == 2 ? RESPONSE_HEADER_LEN_V2 : RESPONSE_HEADER_LEN_V1;
+}
+
 const char RESPONSE = 0; // cmd type
 const char REQUEST = 1;
 const char REQUEST_ONEWAY = 2;
@@ -67,6 +83,75 @@ const uint16_t RESPONSE_STATUS_CONNECTION_CLOSED = 16;     // 0x10
 const uint16_t RESPONSE_STATUS_SERVER_SERIAL_EXCEPTION = 17;   // 0x11
 const uint16_t RESPONSE_STATUS_SERVER_DESERIAL_EXCEPTION = 18; // 0x12
 
+// The fields of a Bolt response header
+struct BoltResponseHeader {
+    uint8_t proto;
+    uint8_t type;
+    uint16_t cmdcode;
+    uint8_t codec;
+    // V2 only
+    uint8_t switches;
+    uint16_t respstatus;
+    uint16_t classlen;
+    uint16_t headerlen;
+    uint32_t contentlen;
+};
+
+// The offsets of the fields of a Bolt response header.  V2 inserts
+// the protocol version after the protocol code, and the protocol
+// switch after the codec.  |switches| is 0 if there is none.
+struct BoltResponseLayout {
+    size_t type;
+    size_t cmdcode;
+    size_t reqid;
+    size_t codec;
+    size_t switches;
+    size_t respstatus;
+    size_t classlen;
+    size_t headerlen;
+    size_t contentlen;
+    size_t len;
+};
+
+constexpr BoltResponseLayout bolt_response_layout(int version) {
+    return version == 2
+               ? BoltResponseLayout{2, 3, 6, 10, 11, 12, 14, 16, 18,
+                                    RESPONSE_HEADER_LEN_V2}
+               : BoltResponseLayout{1, 2, 5, 9, 0, 10, 12, 14, 16,
+                                    RESPONSE_HEADER_LEN_V1};
+}
+
+// Loads big endian integers.  Unlike util::getBigEndianI16/I32, these
+// are inlined, and compile to a load and a byte swap.
+inline uint16_t bolt_load16(const uint8_t *p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+inline uint32_t bolt_load32(const uint8_t *p) {
+    return (static_cast<uint32_t>(p[0]) << 24) |
+           (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+// Decodes the Bolt response header of protocol version |Version| at
+// |p| into |hd|, and returns its request id.  The offsets are known at
+// compile time.
+template <int Version>
+inline int32_t parse_bolt_response_header(BoltResponseHeader &hd,
+                                          const uint8_t *p) {
+    constexpr auto l = bolt_response_layout(Version);
+    hd.proto = p[0];
+    hd.type = p[l.type];
+    hd.cmdcode = bolt_load16(p + l.cmdcode);
+    hd.codec = p[l.codec];
+    hd.switches = l.switches ? p[l.switches] : 0;
+    hd.respstatus = bolt_load16(p + l.respstatus);
+    hd.classlen = bolt_load16(p + l.classlen);
+    hd.headerlen = bolt_load16(p + l.headerlen);
+    hd.contentlen = bolt_load32(p + l.contentlen);
+    return static_cast<int32_t>(bolt_load32(p + l.reqid));
+}
+
 } // namespace h2load
 
 #endif // SOFARPC_H
\ No newline at end of file
@@ -0,0 +1,85 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include "nghttp2_config.h"
+
+#include <atomic>
+#include <cassert>
+#include <vector>
+
+namespace nghttp2 {
+
+// SpscQueue is a bounded lock-free queue for exactly one producer
+// thread and one consumer thread.  The capacity is rounded up to a
+// power of 2.
+template <typename T> class SpscQueue {
+  public:
+    explicit SpscQueue(size_t capacity) : head_(0), tail_(0) {
+        size_t n = 1;
+        while (n < capacity) {
+            n *= 2;
+        }
+        buf_.resize(n);
+        mask_ = n - 1;
+    }
+
+    // Called by the producer.  Returns false if the queue is full.
+    bool push(T v) {
+        auto tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == buf_.size()) {
+            return false;
+        }
+        buf_[tail & mask_] = std::move(v);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Called by the consumer.  Returns false if the queue is empty.
+    bool pop(T &v) {
+        auto head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        v = std::move(buf_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return buf_.size(); }
+
+  private:
+    std::vector<T> buf_;
+    size_t mask_;
+    // Keep the indices apart, so that the producer and the consumer
+    // do not write to the same cache line.
+    alignas(64) std::atomic<size_t> head_;
+    alignas(64) std::atomic<size_t> tail_;
+};
+
+} // namespace nghttp2
+
+#endif // SPSC_QUEUE_H
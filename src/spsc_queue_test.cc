@@ -0,0 +1,87 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "spsc_queue_test.h"
+
+#include <thread>
+
+#include <CUnit/CUnit.h>
+
+#include "spsc_queue.h"
+
+namespace nghttp2 {
+
+void test_spsc_queue(void) {
+    SpscQueue<int> q(3);
+    int v;
+
+    CU_ASSERT(4 == q.capacity());
+    CU_ASSERT(!q.pop(v));
+
+    for (int i = 0; i < 4; ++i) {
+        CU_ASSERT(q.push(i));
+    }
+    CU_ASSERT(!q.push(4));
+
+    CU_ASSERT(q.pop(v));
+    CU_ASSERT(0 == v);
+    CU_ASSERT(q.push(4));
+
+    for (int i = 1; i < 5; ++i) {
+        CU_ASSERT(q.pop(v));
+        CU_ASSERT(i == v);
+    }
+    CU_ASSERT(!q.pop(v));
+}
+
+void test_spsc_queue_threads(void) {
+    constexpr int N = 100000;
+    SpscQueue<int> q(16);
+
+    std::thread producer([&q] {
+        for (int i = 0; i < N;) {
+            if (q.push(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    auto ordered = true;
+    for (int i = 0; i < N;) {
+        int v;
+        if (!q.pop(v)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ordered = ordered && v == i;
+        ++i;
+    }
+    producer.join();
+
+    CU_ASSERT(ordered);
+}
+
+} // namespace nghttp2
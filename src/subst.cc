@@ -0,0 +1,266 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "subst.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+#include "alias_table.h"
+#include "util.h"
+
+using namespace nghttp2;
+
+namespace h2load {
+
+int parse_subst_marker(SubstSlot &slot, const StringRef &marker,
+                       size_t keylen) {
+    if (marker.size() < 4 || marker[0] != '{' || marker[1] != '{' ||
+        marker[marker.size() - 2] != '}' || marker[marker.size() - 1] != '}') {
+        return -1;
+    }
+
+    auto body = StringRef{std::begin(marker) + 2, std::end(marker) - 2};
+    auto colon = std::find(std::begin(body), std::end(body), ':');
+    auto kind = StringRef{std::begin(body), colon};
+
+    size_t width;
+    if (util::streq_l("seq", kind)) {
+        slot.kind = SubstSlot::SEQ;
+        width = 10;
+    } else if (util::streq_l("rand", kind)) {
+        slot.kind = SubstSlot::RAND;
+        width = 10;
+    } else if (util::streq_l("time", kind)) {
+        slot.kind = SubstSlot::TIME;
+        width = 13;
+    } else if (util::streq_l("param", kind)) {
+        slot.kind = SubstSlot::PARAM;
+        width = 10;
+    } else if (util::streq_l("plugin", kind)) {
+        slot.kind = SubstSlot::PLUGIN;
+        width = 16;
+    } else if (util::streq_l("key", kind) || util::streq_l("randkey", kind)) {
+        slot.kind = kind.size() == 3 ? SubstSlot::KEY : SubstSlot::RANDKEY;
+        // The keys decide the width.
+        if (keylen == 0 || colon != std::end(body)) {
+            return -1;
+        }
+        width = keylen;
+    } else {
+        return -1;
+    }
+
+    slot.tag = 0;
+    if (colon != std::end(body)) {
+        auto last = std::end(body);
+        if (slot.kind == SubstSlot::PLUGIN) {
+            last = std::find(colon + 1, std::end(body), ':');
+            if (last != std::end(body)) {
+                auto tag = util::parse_uint(StringRef{last + 1, std::end(body)});
+                if (tag < 0 || tag > std::numeric_limits<uint32_t>::max()) {
+                    return -1;
+                }
+                slot.tag = tag;
+            }
+        }
+        auto n = util::parse_uint(StringRef{colon + 1, last});
+        if (n < 1) {
+            return -1;
+        }
+        width = n;
+    }
+
+    if (width > SUBST_MAX_WIDTH) {
+        return -1;
+    }
+
+    slot.width = width;
+    slot.offset = 0;
+
+    return 0;
+}
+
+int parse_subst(std::string &s, std::vector<SubstSlot> &slots, size_t base,
+                size_t keylen) {
+    std::string dst;
+    dst.reserve(s.size());
+
+    for (size_t i = 0; i < s.size();) {
+        auto start = s.find("{{", i);
+        if (start == std::string::npos) {
+            dst.append(s, i, std::string::npos);
+            break;
+        }
+        dst.append(s, i, start - i);
+
+        auto end = s.find("}}", start + 2);
+        if (end == std::string::npos) {
+            return -1;
+        }
+        end += 2;
+
+        SubstSlot slot;
+        if (parse_subst_marker(slot, StringRef{&s[start], &s[0] + end},
+                               keylen) != 0) {
+            return -1;
+        }
+        slot.offset = base + dst.size();
+        slots.push_back(slot);
+
+        dst.append(slot.width, '0');
+        i = end;
+    }
+
+    s = std::move(dst);
+
+    return 0;
+}
+
+int read_subst_keys(std::vector<std::string> &keys, const std::string &path) {
+    std::ifstream f(path);
+    if (!f) {
+        std::cerr << "--subst-keys: cannot open " << path << std::endl;
+        return -1;
+    }
+
+    size_t lineno = 0;
+    for (std::string line; std::getline(f, line);) {
+        ++lineno;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty()) {
+            continue;
+        }
+        if (std::any_of(std::begin(line), std::end(line),
+                        [](char c) { return c < 0x20 || c > 0x7e; })) {
+            std::cerr << "--subst-keys: " << path << ":" << lineno
+                      << ": a key must be printable ASCII" << std::endl;
+            return -1;
+        }
+        if (!keys.empty() && line.size() != keys[0].size()) {
+            std::cerr << "--subst-keys: " << path << ":" << lineno
+                      << ": all keys must be " << keys[0].size()
+                      << " bytes long, as the first one is" << std::endl;
+            return -1;
+        }
+        if (line.size() > SUBST_MAX_WIDTH) {
+            std::cerr << "--subst-keys: " << path << ":" << lineno
+                      << ": a key must be at most " << SUBST_MAX_WIDTH
+                      << " bytes long" << std::endl;
+            return -1;
+        }
+        keys.push_back(std::move(line));
+    }
+
+    if (keys.empty()) {
+        std::cerr << "--subst-keys: no key is in " << path << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+SubstGen::SubstGen()
+    : seq_(0), step_(1), rand_state_(0), keys_(nullptr), param_(nullptr),
+      paramlen_(0), plugin_fill_(nullptr), plugin_ctx_(nullptr),
+      plugin_calls_(0), plugin_time_(0), plugin_errors_(0) {}
+
+void SubstGen::init(uint64_t first, uint64_t step, uint64_t seed,
+                    const std::vector<std::string> *keys) {
+    // next() is called before the first request.
+    seq_ = first - step;
+    step_ = step;
+    rand_state_ = seed;
+    keys_ = keys;
+}
+
+namespace {
+// Writes the lowest |width| decimal digits of |n| to |dst|, padded
+// with '0'.
+void write_decimal(uint8_t *dst, size_t width, uint64_t n) {
+    for (auto p = dst + width; p != dst; n /= 10) {
+        *--p = '0' + n % 10;
+    }
+}
+} // namespace
+
+void SubstGen::fill(uint8_t *dst, const SubstSlot &slot) {
+    switch (slot.kind) {
+    case SubstSlot::SEQ:
+        write_decimal(dst, slot.width, seq_);
+        return;
+    case SubstSlot::RAND:
+        // A 64 bit number has 19 uniformly distributed digits.
+        for (size_t i = 0; i < slot.width; i += 19) {
+            auto n = std::min(slot.width - i, static_cast<size_t>(19));
+            write_decimal(dst + i, n, splitmix64(rand_state_));
+        }
+        return;
+    case SubstSlot::KEY: {
+        auto &key = (*keys_)[seq_ % keys_->size()];
+        std::copy(std::begin(key), std::end(key), dst);
+        return;
+    }
+    case SubstSlot::RANDKEY: {
+        auto &key = (*keys_)[splitmix64(rand_state_) % keys_->size()];
+        std::copy(std::begin(key), std::end(key), dst);
+        return;
+    }
+    case SubstSlot::TIME:
+        write_decimal(
+            dst, slot.width,
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch())
+                .count());
+        return;
+    case SubstSlot::PARAM: {
+        auto n = std::min(paramlen_, static_cast<size_t>(slot.width));
+        std::fill_n(dst, slot.width - n, '0');
+        std::copy_n(param_ + paramlen_ - n, n, dst + slot.width - n);
+        return;
+    }
+    case SubstSlot::PLUGIN: {
+        if (!plugin_fill_) {
+            std::fill_n(dst, slot.width, '0');
+            return;
+        }
+        auto start = std::chrono::steady_clock::now();
+        if (plugin_fill_(plugin_ctx_, dst, slot.width, seq_, slot.tag) != 0) {
+            ++plugin_errors_;
+        }
+        plugin_time_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+        ++plugin_calls_;
+        return;
+    }
+    }
+}
+
+} // namespace h2load
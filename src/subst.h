@@ -0,0 +1,144 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef SUBST_H
+#define SUBST_H
+
+#include "nghttp2_config.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "sofaload/plugin.h"
+#include "template.h"
+
+namespace h2load {
+
+// The widest slot, which fits in a slot of Client::wq
+constexpr size_t SUBST_MAX_WIDTH = 64;
+
+// SubstSlot is a field of fixed width in a request serialized once at
+// startup, which is filled anew for each request.  It comes from a
+// marker "{{<KIND>[:<WIDTH>]}}" in the request, or
+// "{{plugin[:<WIDTH>[:<TAG>]]}}".
+struct SubstSlot {
+    enum Kind : uint8_t {
+        // The sequence number of the request, in decimal
+        SEQ,
+        // A random number, in decimal
+        RAND,
+        // The key of --subst-keys which the sequence number selects
+        KEY,
+        // A random key of --subst-keys
+        RANDKEY,
+        // The time in milliseconds since the epoch, in decimal
+        TIME,
+        // The parameter of the request replayed with --replay, padded
+        // with '0' in front, or cut to its last bytes
+        PARAM,
+        // Filled by the --plugin library
+        PLUGIN,
+    } kind;
+    // The width of the field in bytes
+    uint32_t width;
+    // The offset of the field in the serialized request
+    size_t offset;
+    // PLUGIN only.  The tag of the marker, which tells the plugin
+    // which field it fills.
+    uint32_t tag;
+};
+
+// Parses |marker|, which includes the enclosing braces, into |slot|
+// except for its offset.  |keylen| is the length of the keys of
+// --subst-keys, or 0 if there are none.  Returns 0 if it succeeds, or
+// -1.
+int parse_subst_marker(SubstSlot &slot, const nghttp2::StringRef &marker,
+                       size_t keylen);
+
+// Replaces each marker in |s| with as many '0's as its slot is wide,
+// and appends the slot to |slots|, at |base| plus its offset in the
+// replaced |s|.  Returns 0 if it succeeds, or -1 if a marker is
+// malformed.
+int parse_subst(std::string &s, std::vector<SubstSlot> &slots, size_t base,
+                size_t keylen);
+
+// Reads the keys in |path|, one per line, into |keys|.  The keys must
+// be printable ASCII, and of the same length, so that the slots they
+// fill have a fixed width.  Returns 0 if it succeeds, or -1 after
+// printing the error.
+int read_subst_keys(std::vector<std::string> &keys, const std::string &path);
+
+// SubstGen fills slots.  Each worker has its own, so that filling
+// takes no lock.
+class SubstGen {
+  public:
+    SubstGen();
+    // The sequence numbers are |first|, |first| + |step|, and so on,
+    // so that the workers never share one.  |seed| seeds the random
+    // numbers.  |keys| must outlive this object.
+    void init(uint64_t first, uint64_t step, uint64_t seed,
+              const std::vector<std::string> *keys);
+    // Starts a new request, which takes the next sequence number.  All
+    // slots of a request share it.
+    void next() { seq_ += step_; }
+    // Sets the parameter of the requests from now on to the |len|
+    // bytes at |param|, which must stay valid while they are filled.
+    void set_param(const uint8_t *param, size_t len) {
+        param_ = param;
+        paramlen_ = len;
+    }
+    // Fills PLUGIN slots with |fill| of the --plugin library, called
+    // with |ctx|.  Without a plugin, they are filled with '0'.
+    void set_plugin(sofaload_plugin_fill_func fill, void *ctx) {
+        plugin_fill_ = fill;
+        plugin_ctx_ = ctx;
+    }
+    // Fills |slot| at |dst|, which has room for its width.
+    void fill(uint8_t *dst, const SubstSlot &slot);
+
+    // The number of PLUGIN slots filled, the time the plugin took in
+    // nanoseconds, and the number of times it failed
+    uint64_t plugin_calls() const { return plugin_calls_; }
+    uint64_t plugin_time() const { return plugin_time_; }
+    uint64_t plugin_errors() const { return plugin_errors_; }
+
+  private:
+    uint64_t seq_;
+    uint64_t step_;
+    uint64_t rand_state_;
+    const std::vector<std::string> *keys_;
+    const uint8_t *param_;
+    size_t paramlen_;
+    sofaload_plugin_fill_func plugin_fill_;
+    void *plugin_ctx_;
+    uint64_t plugin_calls_;
+    uint64_t plugin_time_;
+    uint64_t plugin_errors_;
+};
+
+} // namespace h2load
+
+#endif // SUBST_H
@@ -0,0 +1,165 @@
+/*
+ * nghttp2 - HTTP/2 C Library
+ *
+ * Copyright (c) 2015 Tatsuhiro Tsujikawa
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ * WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "subst_test.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <CUnit/CUnit.h>
+
+#include "subst.h"
+
+namespace h2load {
+
+void test_subst_parse(void) {
+    {
+        std::string s = "/items/{{seq:6}}?k={{randkey}}&t={{time}}";
+        std::vector<SubstSlot> slots;
+        CU_ASSERT(0 == parse_subst(s, slots, 4, 3));
+        CU_ASSERT("/items/000000?k=000&t=0000000000000" == s);
+        CU_ASSERT(3 == slots.size());
+        CU_ASSERT(SubstSlot::SEQ == slots[0].kind);
+        CU_ASSERT(6 == slots[0].width);
+        CU_ASSERT(4 + 7 == slots[0].offset);
+        CU_ASSERT(SubstSlot::RANDKEY == slots[1].kind);
+        CU_ASSERT(3 == slots[1].width);
+        CU_ASSERT(4 + 16 == slots[1].offset);
+        CU_ASSERT(SubstSlot::TIME == slots[2].kind);
+        CU_ASSERT(13 == slots[2].width);
+        CU_ASSERT(4 + 22 == slots[2].offset);
+    }
+    {
+        // A slot may be wider than its marker.
+        std::string s = "{{rand:40}}";
+        std::vector<SubstSlot> slots;
+        CU_ASSERT(0 == parse_subst(s, slots, 0, 0));
+        CU_ASSERT(std::string(40, '0') == s);
+        CU_ASSERT(0 == slots[0].offset);
+    }
+    {
+        std::string s = "id={{param:6}}";
+        std::vector<SubstSlot> slots;
+        CU_ASSERT(0 == parse_subst(s, slots, 0, 0));
+        CU_ASSERT("id=000000" == s);
+        CU_ASSERT(SubstSlot::PARAM == slots[0].kind);
+        CU_ASSERT(6 == slots[0].width);
+    }
+    {
+        std::string s = "{{plugin}}/{{plugin:8:3}}";
+        std::vector<SubstSlot> slots;
+        CU_ASSERT(0 == parse_subst(s, slots, 0, 0));
+        CU_ASSERT(std::string(16, '0') + "/00000000" == s);
+        CU_ASSERT(SubstSlot::PLUGIN == slots[0].kind);
+        CU_ASSERT(16 == slots[0].width);
+        CU_ASSERT(0 == slots[0].tag);
+        CU_ASSERT(8 == slots[1].width);
+        CU_ASSERT(3 == slots[1].tag);
+    }
+    {
+        std::string s = "no slot { here }";
+        std::vector<SubstSlot> slots;
+        CU_ASSERT(0 == parse_subst(s, slots, 0, 0));
+        CU_ASSERT("no slot { here }" == s);
+        CU_ASSERT(slots.empty());
+    }
+
+    std::vector<SubstSlot> slots;
+    for (auto bad : {"{{seq", "{{seq:0}}", "{{seq:65}}", "{{seq:x}}",
+                     "{{key}}", "{{key:4}}", "{{foo}}", "{{}}", "{{seq:4:1}}",
+                     "{{plugin:8:}}", "{{plugin::1}}"}) {
+        std::string s = bad;
+        CU_ASSERT(-1 == parse_subst(s, slots, 0, 0));
+    }
+    std::string s = "{{key:4}}";
+    CU_ASSERT(-1 == parse_subst(s, slots, 0, 8));
+}
+
+void test_subst_gen(void) {
+    std::vector<std::string> keys{"aaa", "bbb", "ccc"};
+    SubstGen gen;
+    // The second of 4 workers
+    gen.init(1, 4, 1, &keys);
+
+    SubstSlot seq{SubstSlot::SEQ, 4, 0, 0};
+    SubstSlot key{SubstSlot::KEY, 3, 0, 0};
+    SubstSlot rand{SubstSlot::RAND, 30, 0, 0};
+    std::string buf(30, ' ');
+    auto p = reinterpret_cast<uint8_t *>(&buf[0]);
+
+    gen.next();
+    gen.fill(p, seq);
+    CU_ASSERT("0001" == buf.substr(0, 4));
+    gen.fill(p, key);
+    CU_ASSERT("bbb" == buf.substr(0, 3));
+
+    gen.next();
+    gen.fill(p, seq);
+    CU_ASSERT("0005" == buf.substr(0, 4));
+    gen.fill(p, key);
+    CU_ASSERT("ccc" == buf.substr(0, 3));
+
+    gen.fill(p, rand);
+    CU_ASSERT(std::string::npos == buf.find_first_not_of("0123456789"));
+    auto first = buf;
+    gen.fill(p, rand);
+    CU_ASSERT(first != buf);
+
+    // Only the lowest digits fit.
+    for (size_t i = 0; i < 250; ++i) {
+        gen.next();
+    }
+    gen.fill(p, SubstSlot{SubstSlot::SEQ, 3, 0, 0});
+    CU_ASSERT("005" == buf.substr(0, 3));
+
+    // A short parameter is padded, and a long one keeps its end.
+    std::string param = "4711";
+    gen.set_param(reinterpret_cast<const uint8_t *>(param.data()),
+                  param.size());
+    gen.fill(p, SubstSlot{SubstSlot::PARAM, 6, 0, 0});
+    CU_ASSERT("004711" == buf.substr(0, 6));
+    gen.fill(p, SubstSlot{SubstSlot::PARAM, 2, 0, 0});
+    CU_ASSERT("11" == buf.substr(0, 2));
+
+    // Without a plugin, its slots are zeros.
+    gen.fill(p, SubstSlot{SubstSlot::PLUGIN, 4, 0, 0});
+    CU_ASSERT("0000" == buf.substr(0, 4));
+    CU_ASSERT(0 == gen.plugin_calls());
+
+    gen.set_plugin(
+        [](void *, uint8_t *buf, size_t len, uint64_t seq, uint32_t tag) {
+            std::fill_n(buf, len, 'a' + tag);
+            buf[0] = '0' + seq % 10;
+            return tag == 2 ? -1 : 0;
+        },
+        nullptr);
+    gen.fill(p, SubstSlot{SubstSlot::PLUGIN, 4, 0, 1});
+    CU_ASSERT("5bbb" == buf.substr(0, 4));
+    gen.fill(p, SubstSlot{SubstSlot::PLUGIN, 4, 0, 2});
+    CU_ASSERT(2 == gen.plugin_calls());
+    CU_ASSERT(1 == gen.plugin_errors());
+}
+
+} // namespace h2load
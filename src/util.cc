@@ -1063,6 +1063,27 @@ int64_t parse_uint(const StringRef &s) {
     return parse_uint(s.byte(), s.size());
 }
 
+std::vector<uint32_t> parse_uint_ranges(const StringRef &s) {
+    std::vector<uint32_t> res;
+    for (const auto &item : split_str(s, ',')) {
+        auto dash = std::find(std::begin(item), std::end(item), '-');
+        auto first = parse_uint(StringRef{std::begin(item), dash});
+        auto last = first;
+        if (dash != std::end(item)) {
+            last = parse_uint(StringRef{dash + 1, std::end(item)});
+        }
+        if (first == -1 || last == -1 || first > last ||
+            last > std::numeric_limits<uint32_t>::max() ||
+            last - first >= 65536) {
+            return {};
+        }
+        for (auto i = first; i <= last; ++i) {
+            res.push_back(i);
+        }
+    }
+    return res;
+}
+
 int64_t parse_uint(const uint8_t *s, size_t len) {
     int64_t n;
     size_t i;
@@ -1603,14 +1624,14 @@ void putBigEndianI32(char *bytes, int32_t i) {
     bytes[3] = (char)((i >> 0) & 0xFF);
 }
 
-uint16_t getBigEndianI16(char *bytes) {
+uint16_t getBigEndianI16(const char *bytes) {
     int32_t res = 0;
     res |= ((bytes[0] & 0xFF) << 8);
     res |= (bytes[1] & 0xFF);
     return res;
 }
 
-int32_t getBigEndianI32(char *bytes) {
+int32_t getBigEndianI32(const char *bytes) {
     int64_t res = 0;
     res |= ((bytes[0] & 0xff) << 24);
     res |= ((bytes[1] & 0xff) << 16);
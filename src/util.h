@@ -660,6 +660,12 @@ int64_t parse_uint(const uint8_t *s, size_t len);
 int64_t parse_uint(const std::string &s);
 int64_t parse_uint(const StringRef &s);
 
+// Parses |s| as comma separated list of unsigned integers and
+// inclusive ranges of them, e.g., "0-3,8,10-11", and returns the
+// integers in the order they appear.  A range may span at most 65536
+// integers.  If there is an error, returns an empty vector.
+std::vector<uint32_t> parse_uint_ranges(const StringRef &s);
+
 // Parses NULL terminated string |s| as unsigned integer and returns
 // the parsed integer casted to double.  If |s| ends with "s", the
 // parsed value's unit is a second.  If |s| ends with "ms", the unit
@@ -786,8 +792,8 @@ int daemonize(int nochdir, int noclose);
 void putBigEndianI16(char *bytes, uint16_t s);
 void putBigEndianI32(char *bytes, int32_t s);
 
-uint16_t getBigEndianI16(char *bytes);
-int32_t getBigEndianI32(char *bytes);
+uint16_t getBigEndianI16(const char *bytes);
+int32_t getBigEndianI32(const char *bytes);
 
 size_t serializeMap(const std::unordered_map<std::string, std::string> & m, char * b);
 void deserializeMap(char * b, size_t totalLen, std::unordered_map<std::string, std::string> & m);
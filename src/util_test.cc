@@ -534,6 +534,26 @@ void test_util_parse_config_str_list(void) {
     CU_ASSERT("charlie" == res[2]);
 }
 
+void test_util_parse_uint_ranges(void) {
+    auto res = util::parse_uint_ranges(StringRef::from_lit("3"));
+    CU_ASSERT((std::vector<uint32_t>{3}) == res);
+
+    res = util::parse_uint_ranges(StringRef::from_lit("0-3,8,10-11"));
+    CU_ASSERT((std::vector<uint32_t>{0, 1, 2, 3, 8, 10, 11}) == res);
+
+    res = util::parse_uint_ranges(StringRef::from_lit("5-5,1"));
+    CU_ASSERT((std::vector<uint32_t>{5, 1}) == res);
+
+    CU_ASSERT(util::parse_uint_ranges(StringRef{}).empty());
+    CU_ASSERT(util::parse_uint_ranges(StringRef::from_lit("1,")).empty());
+    CU_ASSERT(util::parse_uint_ranges(StringRef::from_lit("3-1")).empty());
+    CU_ASSERT(util::parse_uint_ranges(StringRef::from_lit("1-")).empty());
+    CU_ASSERT(util::parse_uint_ranges(StringRef::from_lit("a")).empty());
+    CU_ASSERT(
+        util::parse_uint_ranges(StringRef::from_lit("4294967296")).empty());
+    CU_ASSERT(util::parse_uint_ranges(StringRef::from_lit("0-65536")).empty());
+}
+
 void test_util_make_http_hostport(void) {
     BlockAllocator balloc(4096, 4096);
 